@@ -1,7 +1,9 @@
 #include "benchmark_util/data_table_benchmark_util.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -68,6 +70,12 @@ void RandomDataTableTransaction::RandomSelect(Random *generator) {
 void RandomDataTableTransaction::Finish() {
     if (aborted_)
         test_object_->txn_manager_.Abort(txn_);
+    else if (test_object_->record_commit_latencies_)
+        commit_time_ = test_object_->txn_manager_.Commit(
+            txn_,
+            LargeDataTableBenchmarkObject::RecordCommitLatency,
+            new LargeDataTableBenchmarkObject::CommitLatencyProbe{test_object_,
+                                                                  std::chrono::high_resolution_clock::now()});
     else
         commit_time_ = test_object_->txn_manager_.Commit(txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
@@ -192,6 +200,17 @@ void LargeDataTableBenchmarkObject::SimulateOneTransaction(noisepage::RandomData
     txn->Finish();
 }
 
+void LargeDataTableBenchmarkObject::RecordCommitLatency(void *probe) {
+    auto *const commit_probe = reinterpret_cast<CommitLatencyProbe *>(probe);
+    const auto  latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - commit_probe->commit_start_);
+    {
+        std::lock_guard<std::mutex> guard(commit_probe->test_object_->commit_latencies_latch_);
+        commit_probe->test_object_->commit_latencies_.push_back(static_cast<uint64_t>(latency.count()));
+    }
+    delete commit_probe;
+}
+
 template <class Random>
 void LargeDataTableBenchmarkObject::PopulateInitialTable(uint32_t num_tuples, Random *generator) {
     initial_txn_ = txn_manager_.BeginTransaction();
@@ -0,0 +1,197 @@
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "benchmark_util/benchmark_config.h"
+#include "common/hash_util.h"
+#include "common/scoped_timer.h"
+#include "execution/exec/execution_context.h"
+#include "execution/exec/execution_settings.h"
+#include "execution/sql/join_hash_table.h"
+#include "execution/sql/thread_state_container.h"
+
+namespace noisepage {
+
+/**
+ * JoinHashTable Benchmarks
+ * Compares building and probing a join hash table serially, through a parallel merge into one global table, and
+ * through a parallel radix partitioned merge.
+ */
+class JoinHashTableBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State &state) final {
+        probe_keys_.resize(num_probes_);
+        std::uniform_int_distribution<uint64_t> dist(0, num_tuples_ - 1);
+        for (auto &key : probe_keys_) {
+            key = dist(generator_);
+        }
+    }
+
+    void TearDown(const benchmark::State &state) final {}
+
+    // Workload
+    const uint64_t num_tuples_ = 10000000;
+    const uint64_t num_probes_ = 10000000;
+
+    // Test infrastructure
+
+    struct Tuple {
+        uint64_t key_, val_;
+    };
+
+    using MergeMode = execution::sql::JoinHashTable::MergeMode;
+
+    static hash_t HashKey(const uint64_t key) {
+        return common::HashUtil::Hash(key);
+    }
+
+    std::unique_ptr<execution::exec::ExecutionContext> MakeExecCtx() {
+        return std::make_unique<execution::exec::ExecutionContext>(catalog::db_oid_t(0),
+                                                                   nullptr,
+                                                                   nullptr,
+                                                                   nullptr,
+                                                                   nullptr,
+                                                                   exec_settings_,
+                                                                   nullptr,
+                                                                   DISABLED,
+                                                                   DISABLED);
+    }
+
+    struct Context {
+        execution::exec::ExecutionContext  *exec_ctx_;
+        execution::exec::ExecutionSettings *settings_;
+    };
+
+    // Populate the thread-local tables in 'container', then merge them into 'jht' with the given merge mode.
+    void MergeParallel(execution::exec::ExecutionContext    *exec_ctx,
+                       execution::sql::ThreadStateContainer *container,
+                       execution::sql::JoinHashTable        *jht,
+                       MergeMode                             merge_mode,
+                       uint64_t                             *elapsed_ms) {
+        Context ctx{exec_ctx, &exec_settings_};
+        container->Reset(
+            sizeof(execution::sql::JoinHashTable),
+            [](auto *ctx, auto *s) {
+                auto *context = reinterpret_cast<Context *>(ctx);
+                new (s) execution::sql::JoinHashTable(*context->settings_, context->exec_ctx_, sizeof(Tuple));
+            },
+            [](auto *ctx, auto *s) {
+                reinterpret_cast<execution::sql::JoinHashTable *>(s)->~JoinHashTable();
+            },
+            &ctx);
+        tbb::task_arena arena(BenchmarkConfig::num_threads);
+        arena.execute([&] {
+            tbb::parallel_for(uint64_t{0}, num_tuples_, [&](const uint64_t key) {
+                auto *tl_jht = container->AccessCurrentThreadStateAs<execution::sql::JoinHashTable>();
+                auto *tuple = reinterpret_cast<Tuple *>(tl_jht->AllocInputTuple(HashKey(key)));
+                tuple->key_ = key;
+                tuple->val_ = key;
+            });
+
+            common::ScopedTimer<std::chrono::milliseconds> timer(elapsed_ms);
+            jht->SetMergeMode(merge_mode);
+            jht->MergeParallel(container, 0);
+        });
+    }
+
+    // Probe the built table with every probe key, returning the number of matches.
+    uint64_t Probe(const execution::sql::JoinHashTable &jht) const {
+        uint64_t matches = 0;
+        for (const auto key : probe_keys_) {
+            for (auto iter = jht.Lookup<false>(HashKey(key)); iter.HasNext();) {
+                auto *matched = reinterpret_cast<const Tuple *>(iter.GetMatchPayload());
+                matches += static_cast<uint64_t>(matched->key_ == key);
+            }
+        }
+        return matches;
+    }
+
+    execution::exec::ExecutionSettings exec_settings_{};
+    std::default_random_engine         generator_;
+    std::vector<uint64_t>              probe_keys_;
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(JoinHashTableBenchmark, SerialBuild)(benchmark::State &state) {
+    // NOLINTNEXTLINE
+    for (auto _ : state) {
+        auto exec_ctx = MakeExecCtx();
+        auto jht = std::make_unique<execution::sql::JoinHashTable>(exec_settings_, exec_ctx.get(), sizeof(Tuple));
+        for (uint64_t key = 0; key < num_tuples_; key++) {
+            auto *tuple = reinterpret_cast<Tuple *>(jht->AllocInputTuple(HashKey(key)));
+            tuple->key_ = key;
+            tuple->val_ = key;
+        }
+
+        uint64_t elapsed_ms;
+        {
+            common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+            jht->Build();
+            benchmark::DoNotOptimize(Probe(*jht));
+        }
+        state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+    }
+    state.SetItemsProcessed(state.iterations() * (num_tuples_ + num_probes_));
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(JoinHashTableBenchmark, GlobalParallelBuild)(benchmark::State &state) {
+    // NOLINTNEXTLINE
+    for (auto _ : state) {
+        auto exec_ctx = MakeExecCtx();
+        auto jht = std::make_unique<execution::sql::JoinHashTable>(exec_settings_, exec_ctx.get(), sizeof(Tuple));
+        execution::sql::ThreadStateContainer container(exec_ctx->GetMemoryPool());
+
+        uint64_t merge_ms, probe_ms;
+        MergeParallel(exec_ctx.get(), &container, jht.get(), MergeMode::Global, &merge_ms);
+        {
+            common::ScopedTimer<std::chrono::milliseconds> timer(&probe_ms);
+            benchmark::DoNotOptimize(Probe(*jht));
+        }
+        state.SetIterationTime(static_cast<double>(merge_ms + probe_ms) / 1000.0);
+    }
+    state.SetItemsProcessed(state.iterations() * (num_tuples_ + num_probes_));
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(JoinHashTableBenchmark, RadixPartitionedParallelBuild)(benchmark::State &state) {
+    // NOLINTNEXTLINE
+    for (auto _ : state) {
+        auto exec_ctx = MakeExecCtx();
+        auto jht = std::make_unique<execution::sql::JoinHashTable>(exec_settings_, exec_ctx.get(), sizeof(Tuple));
+        execution::sql::ThreadStateContainer container(exec_ctx->GetMemoryPool());
+
+        uint64_t merge_ms, probe_ms;
+        MergeParallel(exec_ctx.get(), &container, jht.get(), MergeMode::RadixPartitioned, &merge_ms);
+        {
+            common::ScopedTimer<std::chrono::milliseconds> timer(&probe_ms);
+            benchmark::DoNotOptimize(Probe(*jht));
+        }
+        state.SetIterationTime(static_cast<double>(merge_ms + probe_ms) / 1000.0);
+    }
+    state.SetItemsProcessed(state.iterations() * (num_tuples_ + num_probes_));
+}
+
+// ----------------------------------------------------------------------------
+// BENCHMARK REGISTRATION
+// ----------------------------------------------------------------------------
+// clang-format off
+BENCHMARK_REGISTER_F(JoinHashTableBenchmark, SerialBuild)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(3);
+BENCHMARK_REGISTER_F(JoinHashTableBenchmark, GlobalParallelBuild)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(3);
+BENCHMARK_REGISTER_F(JoinHashTableBenchmark, RadixPartitionedParallelBuild)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(3);
+// clang-format on
+
+} // namespace noisepage
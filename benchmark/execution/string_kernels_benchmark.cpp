@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "common/constants.h"
+#include "execution/exec/execution_settings.h"
+#include "execution/sql/constant_vector.h"
+#include "execution/sql/operators/like_operators.h"
+#include "execution/sql/tuple_id_list.h"
+#include "execution/sql/vector.h"
+#include "execution/sql/vector_operations/vector_operations.h"
+#include "execution/util/string_util.h"
+
+namespace noisepage {
+
+/**
+ * String kernel benchmarks
+ * Compares the SIMD string kernels in StringUtil, and the vectorized LIKE and equality selections built on them,
+ * against evaluating one string at a time with the general LIKE matcher, VarlenEntry comparisons and the standard
+ * library.
+ */
+class StringKernelsBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State &state) final {
+        // Random lower case words, with a few matching each pattern
+        std::uniform_int_distribution<uint32_t> letter('a', 'z');
+        std::uniform_int_distribution<uint32_t> length(8, 40);
+        strings_.resize(num_strings_);
+        for (auto &str : strings_) {
+            str.resize(length(generator_));
+            std::generate(str.begin(), str.end(), [&] {
+                return static_cast<char>(letter(generator_));
+            });
+        }
+        for (uint32_t i = 0; i < num_strings_; i += 16) {
+            strings_[i].replace(i % 32 == 0 ? 0 : strings_[i].size() / 2, 5, "promo");
+        }
+
+        strings_vec_ = std::make_unique<execution::sql::Vector>(execution::sql::TypeId::Varchar, true, true);
+        strings_vec_->Resize(num_strings_);
+        for (uint32_t i = 0; i < num_strings_; i++) {
+            strings_vec_->SetValue(i, execution::sql::GenericValue::CreateVarchar(strings_[i]));
+        }
+    }
+
+    void TearDown(const benchmark::State &state) final {
+        strings_vec_.reset();
+    }
+
+    // Select with the given vectorized selection, or one string at a time with the scalar predicate.
+    template <typename VectorizedSelect, typename ScalarPredicate>
+    void RunSelect(benchmark::State &state, VectorizedSelect select, ScalarPredicate predicate) {
+        const auto *entries = reinterpret_cast<const storage::VarlenEntry *>(strings_vec_->GetData());
+        execution::sql::TupleIdList tid_list(num_strings_);
+        // NOLINTNEXTLINE
+        for (auto _ : state) {
+            tid_list.AddAll();
+            if (state.range(0) != 0) {
+                select(*strings_vec_, &tid_list);
+            } else {
+                tid_list.Filter([&](uint64_t i) {
+                    return predicate(entries[i]);
+                });
+            }
+            benchmark::DoNotOptimize(tid_list.GetTupleCount());
+        }
+        state.SetItemsProcessed(state.iterations() * num_strings_);
+    }
+
+    // Select with LIKE against the given pattern, through VectorOps or through the general matcher.
+    void RunLike(benchmark::State &state, const std::string &pattern) {
+        const auto pattern_vec = execution::sql::ConstantVector(execution::sql::GenericValue::CreateVarchar(pattern));
+        const auto pattern_entry = storage::VarlenEntry::Create(pattern);
+        RunSelect(
+            state,
+            [&](const execution::sql::Vector &strings, execution::sql::TupleIdList *tid_list) {
+                execution::sql::VectorOps::SelectLike(exec_settings_, strings, pattern_vec, tid_list);
+            },
+            [&](const storage::VarlenEntry &str) {
+                return execution::sql::Like{}(str, pattern_entry);
+            });
+    }
+
+    // Select with = against the given constant, through VectorOps or with VarlenEntry comparisons.
+    void RunEqual(benchmark::State &state, const std::string &constant) {
+        const auto constant_vec = execution::sql::ConstantVector(execution::sql::GenericValue::CreateVarchar(constant));
+        const auto constant_entry = storage::VarlenEntry::Create(constant);
+        RunSelect(
+            state,
+            [&](const execution::sql::Vector &strings, execution::sql::TupleIdList *tid_list) {
+                execution::sql::VectorOps::SelectEqual(exec_settings_, strings, constant_vec, tid_list);
+            },
+            [&](const storage::VarlenEntry &str) {
+                return str == constant_entry;
+            });
+    }
+
+    // Workload
+    const uint32_t num_strings_ = common::Constants::K_DEFAULT_VECTOR_SIZE;
+
+    execution::exec::ExecutionSettings      exec_settings_{};
+    std::default_random_engine              generator_;
+    std::vector<std::string>                strings_;
+    std::unique_ptr<execution::sql::Vector> strings_vec_;
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(StringKernelsBenchmark, LikePrefix)(benchmark::State &state) {
+    RunLike(state, "promo%");
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(StringKernelsBenchmark, LikeContains)(benchmark::State &state) {
+    RunLike(state, "%promo%");
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(StringKernelsBenchmark, EqualShort)(benchmark::State &state) {
+    RunEqual(state, "abcd");
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(StringKernelsBenchmark, EqualLong)(benchmark::State &state) {
+    RunEqual(state, strings_[num_strings_ / 2]);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(StringKernelsBenchmark, Find)(benchmark::State &state) {
+    const std::string needle = "promo";
+    uint64_t          found = 0;
+    // NOLINTNEXTLINE
+    for (auto _ : state) {
+        for (const auto &str : strings_) {
+            if (state.range(0) != 0) {
+                found += execution::util::StringUtil::Find(str.data(), str.size(), needle.data(), needle.size())
+                         != nullptr;
+            } else {
+                found += str.find(needle) != std::string::npos;
+            }
+        }
+    }
+    benchmark::DoNotOptimize(found);
+    state.SetItemsProcessed(state.iterations() * num_strings_);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(StringKernelsBenchmark, ToUpper)(benchmark::State &state) {
+    std::string buffer;
+    // NOLINTNEXTLINE
+    for (auto _ : state) {
+        for (const auto &str : strings_) {
+            buffer.resize(str.size());
+            if (state.range(0) != 0) {
+                execution::util::StringUtil::ToUpper(str.data(), str.size(), buffer.data());
+            } else {
+                std::transform(str.begin(), str.end(), buffer.begin(), ::toupper);
+            }
+            benchmark::DoNotOptimize(buffer.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_strings_);
+}
+
+// ----------------------------------------------------------------------------
+// BENCHMARK REGISTRATION
+// ----------------------------------------------------------------------------
+// The argument selects the implementation: 0 is one string at a time, 1 is vectorized.
+// clang-format off
+BENCHMARK_REGISTER_F(StringKernelsBenchmark, LikePrefix)->Arg(0)->Arg(1);
+BENCHMARK_REGISTER_F(StringKernelsBenchmark, LikeContains)->Arg(0)->Arg(1);
+BENCHMARK_REGISTER_F(StringKernelsBenchmark, EqualShort)->Arg(0)->Arg(1);
+BENCHMARK_REGISTER_F(StringKernelsBenchmark, EqualLong)->Arg(0)->Arg(1);
+BENCHMARK_REGISTER_F(StringKernelsBenchmark, Find)->Arg(0)->Arg(1);
+BENCHMARK_REGISTER_F(StringKernelsBenchmark, ToUpper)->Arg(0)->Arg(1);
+// clang-format on
+
+} // namespace noisepage
@@ -0,0 +1,163 @@
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "common/constants.h"
+#include "execution/sql/operators/hash_operators.h"
+#include "execution/sql/tuple_id_list.h"
+#include "execution/sql/vector.h"
+#include "execution/sql/vector_operations/vector_operations.h"
+
+namespace noisepage {
+
+/**
+ * Vector hashing benchmarks
+ * Compares the batched hashing kernels in VectorOps::Hash() and VectorOps::HashCombine() against hashing one value at a
+ * time with the Hash and HashCombine functors, as the vectorized hash used to.
+ */
+class VectorHashBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State &state) final {
+        std::uniform_int_distribution<int64_t>  value;
+        std::uniform_int_distribution<uint32_t> short_length(0, storage::VarlenEntry::InlineThreshold());
+        std::uniform_int_distribution<uint32_t> long_length(storage::VarlenEntry::InlineThreshold() + 1, 64);
+
+        big_ints_ = MakeVector(execution::sql::TypeId::BigInt);
+        ints_ = MakeVector(execution::sql::TypeId::Integer);
+        short_strings_ = MakeVector(execution::sql::TypeId::Varchar);
+        long_strings_ = MakeVector(execution::sql::TypeId::Varchar);
+        for (uint32_t i = 0; i < num_rows_; i++) {
+            big_ints_->SetValue(i, execution::sql::GenericValue::CreateBigInt(value(generator_)));
+            ints_->SetValue(i, execution::sql::GenericValue::CreateInteger(static_cast<int32_t>(value(generator_))));
+            const auto letter = static_cast<char>('a' + i % 26);
+            short_strings_->SetValue(
+                i, execution::sql::GenericValue::CreateVarchar(std::string(short_length(generator_), letter)));
+            long_strings_->SetValue(
+                i, execution::sql::GenericValue::CreateVarchar(std::string(long_length(generator_), letter)));
+        }
+
+        // Every other row is selected
+        tid_list_ = std::make_unique<execution::sql::TupleIdList>(num_rows_);
+        for (uint32_t i = 0; i < num_rows_; i += 2) {
+            tid_list_->Add(i);
+        }
+
+        hashes_ = MakeVector(execution::sql::TypeId::Hash);
+    }
+
+    void TearDown(const benchmark::State &state) final {
+        big_ints_.reset();
+        ints_.reset();
+        short_strings_.reset();
+        long_strings_.reset();
+        tid_list_.reset();
+        hashes_.reset();
+    }
+
+    std::unique_ptr<execution::sql::Vector> MakeVector(execution::sql::TypeId type_id) const {
+        auto vec = std::make_unique<execution::sql::Vector>(type_id, true, true);
+        vec->Resize(num_rows_);
+        return vec;
+    }
+
+    // Hash the input into hashes_, one value at a time with the Hash functor.
+    template <typename T>
+    void HashOneAtATime(const execution::sql::Vector &input) {
+        auto *hashes = reinterpret_cast<hash_t *>(hashes_->GetData());
+        hashes_->Resize(input.GetSize());
+        hashes_->SetFilteredTupleIdList(input.GetFilteredTupleIdList(), input.GetCount());
+        execution::sql::VectorOps::Exec(input, [&](uint64_t i, uint64_t k) {
+            const auto *data = reinterpret_cast<const T *>(input.GetData());
+            hashes[i] = execution::sql::Hash<T>{}(data[i], input.GetNullMask()[i]);
+        });
+    }
+
+    // Combine the input into hashes_, one value at a time with the HashCombine functor.
+    template <typename T>
+    void HashCombineOneAtATime(const execution::sql::Vector &input) {
+        auto *hashes = reinterpret_cast<hash_t *>(hashes_->GetData());
+        execution::sql::VectorOps::Exec(input, [&](uint64_t i, uint64_t k) {
+            const auto *data = reinterpret_cast<const T *>(input.GetData());
+            hashes[i] = execution::sql::HashCombine<T>{}(data[i], input.GetNullMask()[i], hashes[i]);
+        });
+    }
+
+    // Hash a single column, one value at a time or batched depending on the benchmark argument.
+    template <typename T>
+    void RunSingle(benchmark::State &state, execution::sql::Vector *input) {
+        // NOLINTNEXTLINE
+        for (auto _ : state) {
+            if (state.range(0) != 0) {
+                execution::sql::VectorOps::Hash(*input, hashes_.get());
+            } else {
+                HashOneAtATime<T>(*input);
+            }
+            benchmark::DoNotOptimize(hashes_->GetData());
+        }
+        state.SetItemsProcessed(state.iterations() * input->GetCount());
+    }
+
+    // Workload
+    const uint32_t num_rows_ = common::Constants::K_DEFAULT_VECTOR_SIZE;
+
+    std::default_random_engine                   generator_;
+    std::unique_ptr<execution::sql::Vector>      big_ints_;
+    std::unique_ptr<execution::sql::Vector>      ints_;
+    std::unique_ptr<execution::sql::Vector>      short_strings_;
+    std::unique_ptr<execution::sql::Vector>      long_strings_;
+    std::unique_ptr<execution::sql::TupleIdList> tid_list_;
+    std::unique_ptr<execution::sql::Vector>      hashes_;
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(VectorHashBenchmark, BigInt)(benchmark::State &state) {
+    RunSingle<int64_t>(state, big_ints_.get());
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(VectorHashBenchmark, BigIntFiltered)(benchmark::State &state) {
+    big_ints_->SetFilteredTupleIdList(tid_list_.get(), tid_list_->GetTupleCount());
+    RunSingle<int64_t>(state, big_ints_.get());
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(VectorHashBenchmark, ShortStrings)(benchmark::State &state) {
+    RunSingle<storage::VarlenEntry>(state, short_strings_.get());
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(VectorHashBenchmark, LongStrings)(benchmark::State &state) {
+    RunSingle<storage::VarlenEntry>(state, long_strings_.get());
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(VectorHashBenchmark, MultiColumn)(benchmark::State &state) {
+    // NOLINTNEXTLINE
+    for (auto _ : state) {
+        if (state.range(0) != 0) {
+            execution::sql::VectorOps::Hash({big_ints_.get(), ints_.get(), big_ints_.get()}, hashes_.get());
+        } else {
+            HashOneAtATime<int64_t>(*big_ints_);
+            HashCombineOneAtATime<int32_t>(*ints_);
+            HashCombineOneAtATime<int64_t>(*big_ints_);
+        }
+        benchmark::DoNotOptimize(hashes_->GetData());
+    }
+    state.SetItemsProcessed(state.iterations() * num_rows_);
+}
+
+// ----------------------------------------------------------------------------
+// BENCHMARK REGISTRATION
+// ----------------------------------------------------------------------------
+// The argument selects the implementation: 0 is one value at a time, 1 is batched.
+// clang-format off
+BENCHMARK_REGISTER_F(VectorHashBenchmark, BigInt)->Arg(0)->Arg(1);
+BENCHMARK_REGISTER_F(VectorHashBenchmark, BigIntFiltered)->Arg(0)->Arg(1);
+BENCHMARK_REGISTER_F(VectorHashBenchmark, ShortStrings)->Arg(0)->Arg(1);
+BENCHMARK_REGISTER_F(VectorHashBenchmark, LongStrings)->Arg(0)->Arg(1);
+BENCHMARK_REGISTER_F(VectorHashBenchmark, MultiColumn)->Arg(0)->Arg(1);
+// clang-format on
+
+} // namespace noisepage
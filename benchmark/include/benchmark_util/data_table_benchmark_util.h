@@ -1,5 +1,7 @@
 #pragma once
 #include <algorithm>
+#include <chrono>
+#include <mutex>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -157,7 +159,33 @@ public:
         return layout_;
     }
 
+    /**
+     * Sets whether committing transactions record the time from their commit until their commit callback is invoked,
+     * which is when their commit is durable if logging is enabled
+     * @param record true to record commit latencies
+     */
+    void SetRecordCommitLatencies(bool record) {
+        record_commit_latencies_ = record;
+    }
+
+    /**
+     * @return recorded commit latencies in microseconds, in the order in which the commit callbacks were invoked
+     */
+    std::vector<uint64_t> GetCommitLatencies() {
+        std::lock_guard<std::mutex> guard(commit_latencies_latch_);
+        return commit_latencies_;
+    }
+
 private:
+    // Handed to the commit callback of a transaction whose commit latency is recorded
+    struct CommitLatencyProbe {
+        LargeDataTableBenchmarkObject                 *test_object_;
+        std::chrono::high_resolution_clock::time_point commit_start_;
+    };
+
+    // Commit callback that records the latency of the commit tracked by the given CommitLatencyProbe, and frees it
+    static void RecordCommitLatency(void *probe);
+
     void SimulateOneTransaction(RandomDataTableTransaction *txn, uint32_t txn_id);
 
     template <class Random>
@@ -182,5 +210,9 @@ private:
     transaction::TimestampManager timestamp_manager_;
     uint32_t                      txn_length_;
     bool                          gc_on_;
+
+    bool                  record_commit_latencies_ = false;
+    std::mutex            commit_latencies_latch_;
+    std::vector<uint64_t> commit_latencies_;
 };
 } // namespace noisepage
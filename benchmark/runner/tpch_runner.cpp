@@ -1,3 +1,6 @@
+#include <string>
+#include <vector>
+
 #include "benchmark/benchmark.h"
 #include "common/scoped_timer.h"
 #include "common/worker_pool.h"
@@ -26,6 +29,23 @@ public:
 
     tpch::Workload::BenchmarkType type_ = tpch::Workload::BenchmarkType::TPCH;
 
+    // A way of running the queries in adaptive mode for the tier latency benchmark
+    struct TierConfig {
+        const char                           *name_;
+        execution::vm::Module::TierThresholds thresholds_;
+        // Whether every query runs once, and its modules finish compiling, before the timed runs
+        bool warm_up_;
+    };
+
+    // The tier latency benchmark's argument picks one of these configurations
+    const std::vector<TierConfig> tier_configs_ = {
+        {        "interpreted",                       {UINT64_MAX, UINT64_MAX},  true},
+        {           "baseline",                                {0, UINT64_MAX},  true},
+        {          "optimized",                                         {0, 0},  true},
+        {"tiered (cold start)", execution::vm::Module::DEFAULT_TIER_THRESHOLDS, false},
+    };
+    const uint32_t tier_runs_per_query_ = 20;
+
     void SetUp(const benchmark::State &state) final {
         auto db_main_builder = DBMain::Builder()
                                    .SetUseGC(true)
@@ -106,5 +126,55 @@ BENCHMARK_DEFINE_F(TPCHRunner, Runner)(benchmark::State &state) {
     workload_.reset();
 }
 
+/**
+ * Run every TPC-H query repeatedly in adaptive mode with the modules pinned to one tier, or moving up tiers as they
+ * get hot, and report the end-to-end latency of each query
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(TPCHRunner, TierLatency)(benchmark::State &state) {
+    const TierConfig &config = tier_configs_[state.range(0)];
+    workload_ = std::make_unique<tpch::Workload>(common::ManagedPointer<DBMain>(db_main_),
+                                                 tpch_database_name_,
+                                                 tpch_table_root_,
+                                                 tpch::Workload::BenchmarkType::TPCH);
+    workload_->SetTierThresholds(config.thresholds_);
+    const uint32_t num_queries = workload_->GetQueryNum();
+    if (config.warm_up_) {
+        for (uint32_t query_idx = 0; query_idx < num_queries; query_idx++) {
+            workload_->ExecuteOnce(query_idx, execution::vm::ExecutionMode::Adaptive);
+        }
+        workload_->WaitForTierUp();
+    }
+
+    // NOLINTNEXTLINE
+    for (auto _ : state) {
+        uint64_t              total_us = 0;
+        std::vector<uint64_t> query_us(num_queries, 0);
+        for (uint32_t run = 0; run < tier_runs_per_query_; run++) {
+            for (uint32_t query_idx = 0; query_idx < num_queries; query_idx++) {
+                const uint64_t elapsed_us = workload_->ExecuteOnce(query_idx, execution::vm::ExecutionMode::Adaptive);
+                query_us[query_idx] += elapsed_us;
+                total_us += elapsed_us;
+            }
+        }
+        for (uint32_t query_idx = 0; query_idx < num_queries; query_idx++) {
+            state.counters["Q" + std::to_string(query_idx + 1) + "_avg_ms"]
+                = static_cast<double>(query_us[query_idx]) / tier_runs_per_query_ / 1000.0;
+        }
+        state.SetIterationTime(static_cast<double>(total_us) / 1000000.0);
+    }
+    state.SetLabel(config.name_);
+
+    workload_->WaitForTierUp();
+    workload_.reset();
+}
+
 BENCHMARK_REGISTER_F(TPCHRunner, Runner)->Unit(benchmark::kMillisecond)->UseManualTime()->Iterations(1);
+// clang-format off
+BENCHMARK_REGISTER_F(TPCHRunner, TierLatency)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->Iterations(1)
+    ->DenseRange(0, 3);
+// clang-format on
 } // namespace noisepage::runner
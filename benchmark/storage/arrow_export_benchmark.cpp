@@ -0,0 +1,221 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "common/scoped_timer.h"
+#include "execution/sql/value.h"
+#include "network/network_io_utils.h"
+#include "network/postgres/postgres_packet_writer.h"
+#include "storage/arrow_serializer.h"
+#include "storage/block_compactor.h"
+#include "storage/garbage_collector.h"
+#include "test_util/storage_test_util.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace noisepage {
+
+/**
+ * Exports a table of frozen blocks with four BIGINT columns, either as an Arrow stream whose buffers are sent straight
+ * from the blocks or tuple by tuple as Postgres DataRow messages.
+ */
+class ArrowExportBenchmark : public benchmark::Fixture {
+public:
+    // Hands every message of the stream to the connection's write queue as a CopyData message, dropping the queue
+    // contents once they would have been flushed to the socket
+    class CopyDataWriter : public storage::ArrowStreamWriter {
+    public:
+        void Write(const std::vector<iovec> &buffers) override {
+            writer_.WriteCopyData(buffers);
+            queue_.Reset();
+        }
+
+    private:
+        network::WriteQueue           queue_;
+        network::PostgresPacketWriter writer_{common::ManagedPointer(&queue_)};
+    };
+
+    const uint32_t                   num_blocks_ = 100;
+    const std::vector<uint16_t>      attr_sizes_{8, 8, 8, 8, 8};
+    storage::BlockStore              block_store_{1000, 1000};
+    storage::RecordBufferSegmentPool buffer_pool_{100000, 100000};
+    storage::BlockLayout             layout_{attr_sizes_};
+    std::vector<storage::col_id_t>   col_ids_ = StorageTestUtil::ProjectionListAllColumns(layout_);
+    std::vector<execution::sql::SqlTypeId> col_types_{4, execution::sql::SqlTypeId::BigInt};
+    std::vector<std::string>               col_names_{"a", "b", "c", "d"};
+
+    transaction::TimestampManager      timestamp_manager_;
+    transaction::DeferredActionManager deferred_action_manager_{common::ManagedPointer(&timestamp_manager_)};
+    transaction::TransactionManager    txn_manager_{common::ManagedPointer(&timestamp_manager_),
+                                                 common::ManagedPointer(&deferred_action_manager_),
+                                                 common::ManagedPointer(&buffer_pool_),
+                                                 true,
+                                                 false,
+                                                 DISABLED};
+    storage::GarbageCollector          gc_{common::ManagedPointer(&timestamp_manager_),
+                                  common::ManagedPointer(&deferred_action_manager_),
+                                  common::ManagedPointer(&txn_manager_),
+                                  DISABLED};
+    std::unique_ptr<storage::DataTable> table_;
+    uint64_t                            num_tuples_ = 0;
+
+    void SetUp(const benchmark::State &state) final {
+        table_ = std::make_unique<storage::DataTable>(common::ManagedPointer(&block_store_),
+                                                      layout_,
+                                                      storage::layout_version_t(0));
+        auto  initializer = storage::ProjectedRowInitializer::Create(layout_, col_ids_);
+        byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+        auto *txn = txn_manager_.BeginTransaction();
+        num_tuples_ = static_cast<uint64_t>(num_blocks_) * layout_.NumSlots();
+        for (uint64_t i = 0; i < num_tuples_; i++) {
+            auto *row = initializer.InitializeRow(buffer);
+            for (uint16_t j = 0; j < row->NumColumns(); j++) {
+                const auto value = static_cast<int64_t>(i * 4 + j);
+                std::memcpy(row->AccessForceNotNull(j), &value, sizeof(value));
+            }
+            table_->Insert(common::ManagedPointer(txn), *row);
+        }
+        txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+        delete[] buffer;
+
+        // Freeze every block: one pass to compact, one to gather
+        storage::BlockCompactor compactor;
+        gc_.PerformGarbageCollection();
+        gc_.PerformGarbageCollection();
+        for (uint32_t pass = 0; pass < 2; pass++) {
+            for (storage::RawBlock *block : table_->GetBlocks()) {
+                compactor.PutInQueue(block);
+            }
+            compactor.ProcessCompactionQueue(&deferred_action_manager_, &txn_manager_);
+            gc_.PerformGarbageCollection();
+            gc_.PerformGarbageCollection();
+        }
+    }
+
+    void TearDown(const benchmark::State &state) final {
+        table_.reset();
+        gc_.PerformGarbageCollection();
+        gc_.PerformGarbageCollection();
+    }
+
+    /**
+     * Streams the table to the writer and returns the elapsed time
+     */
+    uint64_t ExportStream(storage::ArrowStreamWriter *const writer) {
+        storage::ArrowSerializer serializer(*table_);
+        auto *const              txn = txn_manager_.BeginTransaction();
+        uint64_t                 elapsed_ms;
+        {
+            common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+            const uint64_t num_exported = serializer.ExportStream(common::ManagedPointer(txn),
+                                                                  col_ids_,
+                                                                  col_types_,
+                                                                  col_names_,
+                                                                  writer);
+            NOISEPAGE_ASSERT(num_exported == num_tuples_, "every tuple should be exported");
+        }
+        txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+        gc_.PerformGarbageCollection();
+        return elapsed_ms;
+    }
+};
+
+/**
+ * Stream the frozen blocks to /dev/null with scatter-gather writes, without copying them
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(ArrowExportBenchmark, ArrowStreamToFile)(benchmark::State &state) {
+    const int                    fd = ::open("/dev/null", O_WRONLY);
+    storage::FdArrowStreamWriter writer(fd);
+    // NOLINTNEXTLINE
+    for (auto _ : state) {
+        state.SetIterationTime(static_cast<double>(ExportStream(&writer)) / 1000.0);
+    }
+    ::close(fd);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * num_tuples_));
+}
+
+/**
+ * Stream the frozen blocks as CopyData messages, copying every buffer once into the write queue
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(ArrowExportBenchmark, ArrowStreamToWire)(benchmark::State &state) {
+    CopyDataWriter writer;
+    // NOLINTNEXTLINE
+    for (auto _ : state) {
+        state.SetIterationTime(static_cast<double>(ExportStream(&writer)) / 1000.0);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * num_tuples_));
+}
+
+/**
+ * Read every tuple and send it as a DataRow message in the binary format, as query results are sent
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(ArrowExportBenchmark, DataRowToWire)(benchmark::State &state) {
+    std::vector<planner::OutputSchema::Column> columns;
+    for (const auto &name : col_names_) {
+        columns.emplace_back(name, execution::sql::SqlTypeId::BigInt, nullptr);
+    }
+    auto                          initializer = storage::ProjectedRowInitializer::Create(layout_, col_ids_);
+    byte                         *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    auto                         *row = initializer.InitializeRow(buffer);
+    std::vector<byte>             tuple(columns.size() * sizeof(execution::sql::Integer));
+    network::WriteQueue           queue;
+    network::PostgresPacketWriter packet_writer{common::ManagedPointer(&queue)};
+    // NOLINTNEXTLINE
+    for (auto _ : state) {
+        auto *const txn = txn_manager_.BeginTransaction();
+        uint64_t    elapsed_ms;
+        {
+            common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+            uint32_t                                       num_buffered = 0;
+            for (auto it = table_->begin(); it != table_->end(); it++) {
+                if (!table_->Select(common::ManagedPointer(txn), *it, row)) {
+                    continue;
+                }
+                for (uint16_t j = 0; j < row->NumColumns(); j++) {
+                    execution::sql::Integer value(*reinterpret_cast<int64_t *>(row->AccessWithNullCheck(j)));
+                    std::memcpy(&tuple[j * sizeof(value)], &value, sizeof(value));
+                }
+                packet_writer.WriteDataRow(tuple.data(), columns, {network::FieldFormat::binary});
+                // Drop the rows once a block's worth would have been flushed to the socket
+                if (++num_buffered == layout_.NumSlots()) {
+                    queue.Reset();
+                    num_buffered = 0;
+                }
+            }
+            queue.Reset();
+        }
+        txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+        gc_.PerformGarbageCollection();
+        state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+    }
+    delete[] buffer;
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * num_tuples_));
+}
+
+// ----------------------------------------------------------------------------
+// BENCHMARK REGISTRATION
+// ----------------------------------------------------------------------------
+// clang-format off
+BENCHMARK_REGISTER_F(ArrowExportBenchmark, ArrowStreamToFile)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(2);
+BENCHMARK_REGISTER_F(ArrowExportBenchmark, ArrowStreamToWire)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(2);
+BENCHMARK_REGISTER_F(ArrowExportBenchmark, DataRowToWire)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(2);
+// clang-format on
+
+} // namespace noisepage
@@ -1,3 +1,5 @@
+#include <tbb/parallel_sort.h>
+
 #include <memory>
 #include <vector>
 
@@ -13,7 +15,7 @@ namespace noisepage {
 class BPlusTreeBenchmark : public benchmark::Fixture {
 public:
     void SetUp(const benchmark::State &state) final {
-        key_permutation_.reserve(num_keys_);
+        key_permutation_.resize(num_keys_);
         for (uint32_t i = 0; i < num_keys_; i++) {
             key_permutation_[i] = i;
         }
@@ -100,6 +102,35 @@ BENCHMARK_DEFINE_F(BPlusTreeBenchmark, SequentialInsert)(benchmark::State &state
     state.SetItemsProcessed(state.iterations() * num_keys_);
 }
 
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(BPlusTreeBenchmark, RandomBulkLoad)(benchmark::State &state) {
+    // NOLINTNEXTLINE
+    for (auto _ : state) {
+        {
+            auto tree = std::make_unique<storage::index::BPlusTree<int64_t, int64_t>>();
+
+            std::vector<storage::index::BPlusTree<int64_t, int64_t>::KeyElementPair> elements;
+            elements.reserve(num_keys_);
+            for (uint32_t i = 0; i < num_keys_; i++) {
+                elements.emplace_back(key_permutation_[i], key_permutation_[i]);
+            }
+
+            // Time the sort as well, to compare against inserting the same keys one by one
+            uint64_t elapsed_ms;
+            {
+                common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+                tbb::parallel_sort(elements.begin(), elements.end(), [](const auto &lhs, const auto &rhs) {
+                    return lhs.first < rhs.first;
+                });
+                tree->BulkLoad(elements);
+            }
+
+            state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_keys_);
+}
+
 // NOLINTNEXTLINE
 BENCHMARK_DEFINE_F(BPlusTreeBenchmark, RandomInsertRandomRead)(benchmark::State &state) {
     common::WorkerPool thread_pool(BenchmarkConfig::num_threads, {});
@@ -276,6 +307,10 @@ BENCHMARK_REGISTER_F(BPlusTreeBenchmark, SequentialInsert)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
     ->MinTime(3);
+BENCHMARK_REGISTER_F(BPlusTreeBenchmark, RandomBulkLoad)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(3);
 BENCHMARK_REGISTER_F(BPlusTreeBenchmark, RandomInsertRandomRead)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
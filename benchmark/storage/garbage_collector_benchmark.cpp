@@ -103,6 +103,53 @@ BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, UnlinkTime)(benchmark::State &stat
     state.SetItemsProcessed(state.iterations() * num_txns_);
 }
 
+// Create a table with 100,000 tuples, then run 100,000 txns running update statements. Then run GC with its work split
+// over the given number of workers and profile how long the unlinking and deallocation stages take for those txns
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, ParallelUnlinkReclaimTime)(benchmark::State &state) {
+    const auto num_workers = static_cast<uint32_t>(state.range(0));
+    // NOLINTNEXTLINE
+    for (auto _ : state) {
+        // generate our table and instantiate GC
+        LargeDataTableBenchmarkObject tested({8, 8, 8},
+                                             initial_table_size_,
+                                             txn_length_,
+                                             update_select_ratio_,
+                                             &block_store_,
+                                             &buffer_pool_,
+                                             &generator_,
+                                             true);
+        gc_ = new storage::GarbageCollector(common::ManagedPointer(tested.GetTimestampManager()),
+                                            DISABLED,
+                                            common::ManagedPointer(tested.GetTxnManager()),
+                                            DISABLED,
+                                            num_workers);
+
+        // clean up insert txn
+        gc_->PerformGarbageCollection();
+        gc_->PerformGarbageCollection();
+
+        // run all txns
+        tested.SimulateOltp(num_txns_, num_concurrent_txns_);
+
+        // time the unlinking pass followed by the deallocation pass
+        uint64_t                      elapsed_ms;
+        std::pair<uint32_t, uint32_t> unlink_result, reclaim_result;
+        {
+            common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+            unlink_result = gc_->PerformGarbageCollection();
+            reclaim_result = gc_->PerformGarbageCollection();
+        }
+        EXPECT_EQ(unlink_result.second, num_txns_);
+        EXPECT_EQ(reclaim_result.first, num_txns_);
+
+        delete gc_;
+
+        state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+    }
+    state.SetItemsProcessed(state.iterations() * num_txns_);
+}
+
 // Create a table with 100,000 tuples, then run 100,000 txns running update statements. Then run GC and profile how long
 // the deallocation stage takes for those txns
 // NOLINTNEXTLINE
@@ -179,6 +226,14 @@ BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, ReclaimTime)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
     ->MinTime(1);
+BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, ParallelUnlinkReclaimTime)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(1)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8);
 BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, HighContention)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
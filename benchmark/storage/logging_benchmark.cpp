@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <vector>
 
 #include "benchmark/benchmark.h"
@@ -318,6 +319,80 @@ BENCHMARK_DEFINE_F(LoggingBenchmark, SingleStatementSelect)(benchmark::State &st
     state.SetItemsProcessed(state.iterations() * num_txns_ - abort_count);
 }
 
+/**
+ * Latency of single statement updates from their commit until their commit is durable, with the log written
+ * synchronously (io depth 0) or through an AsyncLogWriter with the given io depth.
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(LoggingBenchmark, CommitLatency)(benchmark::State &state) {
+    uint64_t                  abort_count = 0;
+    const uint32_t            txn_length = 1;
+    const std::vector<double> insert_update_select_ratio = {0, 1, 0};
+    std::vector<uint64_t>     latencies;
+    // NOLINTNEXTLINE
+    for (auto _ : state) {
+        unlink(noisepage::BenchmarkConfig::logfile_path.data());
+        log_manager_
+            = new storage::LogManager(noisepage::BenchmarkConfig::logfile_path.data(),
+                                      num_log_buffers_,
+                                      log_serialization_interval_,
+                                      log_persist_interval_,
+                                      log_persist_threshold_,
+                                      common::ManagedPointer(&buffer_pool_),
+                                      common::ManagedPointer(&empty_buffer_queue_),
+                                      DISABLED,
+                                      common::ManagedPointer<common::DedicatedThreadRegistry>(&thread_registry_),
+                                      1,
+                                      static_cast<uint32_t>(state.range(0)));
+        log_manager_->Start();
+        LargeDataTableBenchmarkObject tested(attr_sizes_,
+                                             initial_table_size_,
+                                             txn_length,
+                                             insert_update_select_ratio,
+                                             &block_store_,
+                                             &buffer_pool_,
+                                             &generator_,
+                                             true,
+                                             log_manager_);
+        // log all of the Inserts from table creation
+        log_manager_->ForceFlush();
+        tested.SetRecordCommitLatencies(true);
+
+        gc_ = new storage::GarbageCollector(common::ManagedPointer(tested.GetTimestampManager()),
+                                            DISABLED,
+                                            common::ManagedPointer(tested.GetTxnManager()),
+                                            DISABLED);
+        gc_thread_ = new storage::GarbageCollectorThread(common::ManagedPointer(gc_), gc_period_, nullptr);
+        const auto result = tested.SimulateOltp(num_txns_, BenchmarkConfig::num_threads);
+        abort_count += result.first;
+        uint64_t elapsed_ms;
+        {
+            common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+            log_manager_->ForceFlush();
+        }
+        state.SetIterationTime(static_cast<double>(result.second + elapsed_ms) / 1000.0);
+        const auto iteration_latencies = tested.GetCommitLatencies();
+        latencies.insert(latencies.end(), iteration_latencies.begin(), iteration_latencies.end());
+        log_manager_->PersistAndStop();
+        delete log_manager_;
+        delete gc_thread_;
+        delete gc_;
+        unlink(noisepage::BenchmarkConfig::logfile_path.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_txns_ - abort_count);
+
+    if (!latencies.empty()) {
+        std::sort(latencies.begin(), latencies.end());
+        const auto percentile = [&](const double p) {
+            const auto index = static_cast<size_t>(p * static_cast<double>(latencies.size() - 1));
+            return static_cast<double>(latencies[index]);
+        };
+        state.counters["p50_us"] = percentile(0.5);
+        state.counters["p99_us"] = percentile(0.99);
+        state.counters["p999_us"] = percentile(0.999);
+    }
+}
+
 // ----------------------------------------------------------------------------
 // BENCHMARK REGISTRATION
 // ----------------------------------------------------------------------------
@@ -342,6 +417,13 @@ BENCHMARK_REGISTER_F(LoggingBenchmark, SingleStatementSelect)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
     ->MinTime(1);
+BENCHMARK_REGISTER_F(LoggingBenchmark, CommitLatency)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(3)
+    ->Arg(0)
+    ->Arg(4)
+    ->Arg(16);
 // clang-format on
 
 } // namespace noisepage
@@ -31,8 +31,11 @@ public:
      * Runs the recovery benchmark with the provided config
      * @param state benchmark state
      * @param config config to use for test object
+     * @param num_replay_threads number of threads that recovery replays transactions with
      */
-    void RunBenchmark(benchmark::State *state, const LargeSqlTableTestConfiguration &config) {
+    void RunBenchmark(benchmark::State                     *state,
+                      const LargeSqlTableTestConfiguration &config,
+                      const uint32_t                        num_replay_threads = 1) {
         // NOLINTNEXTLINE
         for (auto _ : *state) {
             // Blow away log file after every benchmark iteration
@@ -82,7 +85,9 @@ public:
                 recovery_deferred_action_manager,
                 recovery_replication_manager,
                 recovery_thread_registry,
-                recovery_block_store);
+                recovery_block_store,
+                nullptr,
+                num_replay_threads);
 
             uint64_t elapsed_ms;
             {
@@ -139,9 +144,30 @@ BENCHMARK_DEFINE_F(RecoveryBenchmark, HighStress)(benchmark::State &state) {
     RunBenchmark(&state, config);
 }
 
+/**
+ * Read-write workload over many tables (5 statements per txn, 40% inserts, 40% updates, 10% selects, 10% deletes),
+ * replayed with the number of replay threads given by the benchmark argument. Compare against the run with one thread
+ * for the speedup of parallel replay.
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(RecoveryBenchmark, ParallelReplay)(benchmark::State &state) {
+    LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                                .SetNumDatabases(1)
+                                                .SetNumTables(8)
+                                                .SetMaxColumns(5)
+                                                .SetInitialTableSize(initial_table_size_ / 8)
+                                                .SetTxnLength(5)
+                                                .SetInsertUpdateSelectDeleteRatio({0.4, 0.4, 0.1, 0.1})
+                                                .SetVarlenAllowed(true)
+                                                .Build();
+
+    RunBenchmark(&state, config, static_cast<uint32_t>(state.range(0)));
+}
+
 /**
  * Similar to high-stress workload, blast a narrow table with inserts (1 statements per txn, 100% inserts), but also
- * recovery indexes built on the table
+ * recovery indexes built on the table. The benchmark argument is the number of replay threads, which maintain the
+ * indexes concurrently.
  */
 // NOLINTNEXTLINE
 BENCHMARK_DEFINE_F(RecoveryBenchmark, IndexRecovery)(benchmark::State &state) {
@@ -248,7 +274,9 @@ BENCHMARK_DEFINE_F(RecoveryBenchmark, IndexRecovery)(benchmark::State &state) {
                                                   recovery_deferred_action_manager,
                                                   recovery_replication_manager,
                                                   recovery_thread_registry,
-                                                  recovery_block_store);
+                                                  recovery_block_store,
+                                                  nullptr,
+                                                  static_cast<uint32_t>(state.range(0)));
 
         uint64_t elapsed_ms;
         {
@@ -274,10 +302,23 @@ BENCHMARK_REGISTER_F(RecoveryBenchmark, HighStress)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
     ->MinTime(10);
+BENCHMARK_REGISTER_F(RecoveryBenchmark, ParallelReplay)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(10)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16)
+    ->Arg(32);
 BENCHMARK_REGISTER_F(RecoveryBenchmark, IndexRecovery)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
-    ->MinTime(4);
+    ->MinTime(4)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16);
 // clang-format on
 
 } // namespace noisepage
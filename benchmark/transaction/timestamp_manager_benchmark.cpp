@@ -0,0 +1,106 @@
+#include <atomic>
+#include <thread> // NOLINT
+
+#include "benchmark/benchmark.h"
+#include "benchmark_util/benchmark_config.h"
+#include "common/scoped_timer.h"
+#include "common/worker_pool.h"
+#include "storage/record_buffer.h"
+#include "test_util/multithread_test_util.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/timestamp_manager.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace noisepage {
+
+/**
+ * Contention on the tracking of running transactions: every thread begins and commits short read-only transactions,
+ * which is all that they contend on.
+ */
+class TimestampManagerBenchmark : public benchmark::Fixture {
+public:
+    const uint32_t                   num_txns_ = 1000000;
+    storage::RecordBufferSegmentPool buffer_pool_{100000, 100000};
+
+    /**
+     * Runs num_txns_ transactions split over the benchmark threads, and returns the elapsed time
+     * @param scan_oldest whether another thread computes the oldest running transaction meanwhile, as the GC does
+     */
+    uint64_t RunTransactions(const bool scan_oldest) {
+        transaction::TimestampManager      timestamp_manager;
+        transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+        transaction::TransactionManager    txn_manager{common::ManagedPointer(&timestamp_manager),
+                                                    common::ManagedPointer(&deferred_action_manager),
+                                                    common::ManagedPointer(&buffer_pool_),
+                                                    false,
+                                                    false,
+                                                    DISABLED};
+        common::WorkerPool                 thread_pool(BenchmarkConfig::num_threads, {});
+
+        auto workload = [&](uint32_t) {
+            for (uint32_t i = 0; i < num_txns_ / BenchmarkConfig::num_threads; i++) {
+                auto *const txn = txn_manager.BeginTransaction();
+                txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+                delete txn;
+            }
+        };
+
+        std::atomic<bool> done = false;
+        std::thread       scanner([&] {
+            while (scan_oldest && !done) {
+                benchmark::DoNotOptimize(timestamp_manager.OldestTransactionStartTime());
+            }
+        });
+
+        uint64_t elapsed_ms;
+        {
+            common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+            MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, BenchmarkConfig::num_threads, workload);
+        }
+        done = true;
+        scanner.join();
+        return elapsed_ms;
+    }
+};
+
+/**
+ * Begin and commit transactions
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(TimestampManagerBenchmark, BeginCommit)(benchmark::State &state) {
+    // NOLINTNEXTLINE
+    for (auto _ : state) {
+        state.SetIterationTime(static_cast<double>(RunTransactions(false)) / 1000.0);
+    }
+    state.SetItemsProcessed(state.iterations() * num_txns_);
+}
+
+/**
+ * Begin and commit transactions while the oldest running transaction is computed over and over
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(TimestampManagerBenchmark, BeginCommitWithOldestScan)(benchmark::State &state) {
+    // NOLINTNEXTLINE
+    for (auto _ : state) {
+        state.SetIterationTime(static_cast<double>(RunTransactions(true)) / 1000.0);
+    }
+    state.SetItemsProcessed(state.iterations() * num_txns_);
+}
+
+// ----------------------------------------------------------------------------
+// BENCHMARK REGISTRATION
+// ----------------------------------------------------------------------------
+// clang-format off
+BENCHMARK_REGISTER_F(TimestampManagerBenchmark, BeginCommit)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(2);
+BENCHMARK_REGISTER_F(TimestampManagerBenchmark, BeginCommitWithOldestScan)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(2);
+// clang-format on
+
+} // namespace noisepage
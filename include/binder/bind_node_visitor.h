@@ -21,6 +21,7 @@ namespace parser {
     class StarExpression;
     class TableStarExpression;
     class SQLStatement;
+    class WindowExpression;
 } // namespace parser
 
 namespace catalog {
@@ -87,6 +88,7 @@ namespace binder {
         void Visit(common::ManagedPointer<parser::TableStarExpression> expr) override;
         void Visit(common::ManagedPointer<parser::SubqueryExpression> expr) override;
         void Visit(common::ManagedPointer<parser::TypeCastExpression> expr) override;
+        void Visit(common::ManagedPointer<parser::WindowExpression> expr) override;
 
         void Visit(common::ManagedPointer<parser::GroupByDescription> node) override;
         void Visit(common::ManagedPointer<parser::JoinDefinition> node) override;
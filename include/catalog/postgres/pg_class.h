@@ -12,6 +12,7 @@ class Schema;
 } // namespace noisepage::catalog
 
 namespace noisepage::storage {
+class CheckpointManager;
 class RecoveryManager;
 class SqlTable;
 } // namespace noisepage::storage
@@ -37,6 +38,7 @@ public:
 
 private:
     friend class catalog::DatabaseCatalog;
+    friend class storage::CheckpointManager;
     friend class storage::RecoveryManager;
     friend class Builder;
     friend class PgCoreImpl;
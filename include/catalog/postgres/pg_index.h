@@ -6,6 +6,7 @@
 #include "catalog/catalog_defs.h"
 
 namespace noisepage::storage {
+class CheckpointManager;
 class RecoveryManager;
 } // namespace noisepage::storage
 
@@ -16,6 +17,7 @@ class PgCoreImpl;
 /** The OIDs used by the NoisePage version of pg_index. */
 class PgIndex {
 private:
+    friend class storage::CheckpointManager;
     friend class storage::RecoveryManager;
     friend class Builder;
     friend class PgCoreImpl;
@@ -28,6 +28,12 @@ struct Constants {
      */
     static const uint32_t LOG_BUFFER_SIZE = (1 << 12);
 
+    /**
+     * The alignment of writes to the log file when it is written with direct I/O (see storage::AsyncLogWriter). Must be
+     * a multiple of the logical block size of the device that holds the log.
+     */
+    static const uint32_t LOG_BLOCK_SIZE = (1 << 12);
+
     /**
      * The cache line size in bytes
      */
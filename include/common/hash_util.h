@@ -30,6 +30,12 @@ public:
     /** This class cannot be copied or moved. */
     DISALLOW_COPY_AND_MOVE(HashUtil);
 
+    /** The fixed CRC seed of the upper half of an integer CRC hash. */
+    static constexpr hash_t K_CRC_SEED = 0x04c11db7ULL;
+
+    /** The multiplier that mixes the two CRCs of an integer CRC hash. */
+    static constexpr hash_t K_CRC_MULTIPLIER = 0x2545f4914f6cdd1dULL;
+
     /**
      * Hashes length number of bytes.
      * Source:
@@ -196,11 +202,9 @@ public:
     template <typename T>
     static auto HashCrc(T val, hash_t seed) -> std::enable_if_t<std::is_fundamental_v<T>, hash_t> {
         // Thanks HyPer
-        static constexpr hash_t k_default_crc_seed = 0x04c11db7ULL;
-
         uint64_t result1 = _mm_crc32_u64(seed, static_cast<uint64_t>(val));
-        uint64_t result2 = _mm_crc32_u64(k_default_crc_seed, static_cast<uint64_t>(val));
-        return ((result2 << 32u) | result1) * 0x2545f4914f6cdd1dULL;
+        uint64_t result2 = _mm_crc32_u64(K_CRC_SEED, static_cast<uint64_t>(val));
+        return ((result2 << 32u) | result1) * K_CRC_MULTIPLIER;
     }
 
     /**
@@ -57,6 +57,7 @@ namespace noisepage::execution::ast {
     F(TableIterAdvance, tableIterAdvance)                                                                              \
     F(TableIterGetVPINumTuples, tableIterGetVPINumTuples)                                                              \
     F(TableIterGetVPI, tableIterGetVPI)                                                                                \
+    F(TableIterAddBlockFilter, tableIterAddBlockFilter)                                                                \
     F(TableIterClose, tableIterClose)                                                                                  \
     F(TableIterParallel, iterateTableParallel)                                                                         \
     F(TableIterCreateIndexParallel, iterateTableCreateIndexParallel)                                                   \
@@ -165,6 +166,7 @@ namespace noisepage::execution::ast {
     F(AggHashTableLookup, aggHTLookup)                                                                                 \
     F(AggHashTableProcessBatch, aggHTProcessBatch)                                                                     \
     F(AggHashTableMovePartitions, aggHTMoveParts)                                                                      \
+    F(AggHashTableMergeOverflowPartitions, aggHTMergeOverflowParts)                                                    \
     F(AggHashTableParallelPartitionedScan, aggHTParallelPartScan)                                                      \
     F(AggHashTableFree, aggHTFree)                                                                                     \
     F(AggHashTableIterInit, aggHTIterInit)                                                                             \
@@ -206,6 +208,7 @@ namespace noisepage::execution::ast {
     /* Sorting */                                                                                                      \
     F(SorterInit, sorterInit)                                                                                          \
     F(SorterGetTupleCount, sorterGetTupleCount)                                                                        \
+    F(SorterGetTupleAt, sorterGetTupleAt)                                                                              \
     F(SorterInsert, sorterInsert)                                                                                      \
     F(SorterInsertTopK, sorterInsertTopK)                                                                              \
     F(SorterInsertTopKFinish, sorterInsertTopKFinish)                                                                  \
@@ -301,6 +304,7 @@ namespace noisepage::execution::ast {
     F(IndexInsert, indexInsert)                                                                                        \
     F(IndexInsertUnique, indexInsertUnique)                                                                            \
     F(IndexInsertWithSlot, indexInsertWithSlot)                                                                        \
+    F(IndexBuildFinish, indexBuildFinish)                                                                              \
     F(IndexDelete, indexDelete)                                                                                        \
     F(StorageInterfaceFree, storageInterfaceFree)                                                                      \
     /* Trig */                                                                                                         \
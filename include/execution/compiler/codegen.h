@@ -647,6 +647,18 @@ public:
     [[nodiscard]]
     ast::Expr *TableIterGetVPI(ast::Expr *table_iter);
 
+    /**
+     * Call \@tableIterAddBlockFilter(). Let a table vector iterator skip blocks whose values in the given column all
+     * lie outside of [min, max].
+     * @param table_iter The table vector iterator.
+     * @param col_oid The OID of the column whose values are restricted.
+     * @param min The smallest value of the range, inclusive.
+     * @param max The largest value of the range, inclusive.
+     * @return The call expression.
+     */
+    [[nodiscard]]
+    ast::Expr *TableIterAddBlockFilter(ast::Expr *table_iter, catalog::col_oid_t col_oid, int64_t min, int64_t max);
+
     /**
      * Call \@tableIterClose(). Close and destroy a table vector iterator.
      * @param table_iter The table vector iterator.
@@ -1235,6 +1247,20 @@ public:
                                           ast::Expr      *tl_agg_ht_offset,
                                           ast::Identifier merge_partitions_fn_name);
 
+    /**
+     * Call \@aggHTMergeOverflowParts(). Merge the overflow partitions of a serial aggregation hash
+     * table that switched to partitioned mode to spill back into the table.
+     * @param agg_ht A pointer to the aggregation hash table.
+     * @param query_state A pointer to the query state.
+     * @param merge_partitions_fn_name The name of the merging function to merge partial aggregates
+     *                                 into the hash table.
+     * @return The call.
+     */
+    [[nodiscard]]
+    ast::Expr *AggHashTableMergeOverflowPartitions(ast::Expr      *agg_ht,
+                                                   ast::Expr      *query_state,
+                                                   ast::Identifier merge_partitions_fn_name);
+
     /**
      * Call \@aggHTParallelPartScan(). Performs a parallel partitioned scan over an aggregation hash
      * table, using the provided worker function as a callback.
@@ -1478,6 +1504,17 @@ public:
     [[nodiscard]]
     ast::Expr *SorterFree(ast::Expr *sorter);
 
+    /**
+     * Call \@sorterGetTupleAt(). Retrieves a pointer to the tuple at the given index of a sorted sorter, casted to
+     * the provided row type.
+     * @param sorter The sorter instance.
+     * @param idx The index of the tuple.
+     * @param row_type_name The name of the TPL type that is stored in the sorter.
+     * @return The call expression.
+     */
+    [[nodiscard]]
+    ast::Expr *SorterGetTupleAt(ast::Expr *sorter, ast::Expr *idx, ast::Identifier row_type_name);
+
     /**
      * Call \@sorterIterInit(). Initialize the provided sorter iterator over the given sorter.
      * @param iter The sorter iterator.
@@ -13,6 +13,10 @@ public:
     void SetShouldCaptureTBC(bool should_capture_tbc) {
         should_capture_tbc_ = should_capture_tbc;
     }
+    /** Set whether frequent bytecode pairs should be fused into superinstructions. */
+    void SetUseSuperinstructions(bool use_superinstructions) {
+        use_superinstructions_ = use_superinstructions;
+    }
 
     /** @return True if TPL should be captured. */
     [[nodiscard]]
@@ -24,10 +28,16 @@ public:
     bool ShouldCaptureTBC() const noexcept {
         return should_capture_tbc_;
     }
+    /** @return True if frequent bytecode pairs should be fused into superinstructions. */
+    [[nodiscard]]
+    bool ShouldUseSuperinstructions() const noexcept {
+        return use_superinstructions_;
+    }
 
 private:
     bool should_capture_tpl_{false};
     bool should_capture_tbc_{false};
+    bool use_superinstructions_{true};
 };
 
 } // namespace noisepage::execution::compiler
@@ -99,6 +99,14 @@ public:
         /** @return The metadata of this module. */
         const vm::ModuleMetadata &GetModuleMetadata() const;
 
+        /** @return The size (in bytes) of the bytecode of this module. */
+        std::size_t GetBytecodeSize() const;
+
+        /** @return The module that contains the functions. */
+        vm::Module *GetModule() const {
+            return module_.get();
+        }
+
     private:
         // The functions that must be run (in the provided order) to execute this
         // query fragment.
@@ -189,6 +197,9 @@ public:
         return fragments_;
     }
 
+    /** @return The size (in bytes) of the bytecode of all the fragments. */
+    std::size_t GetBytecodeSize() const;
+
 private:
     // The plan.
     const planner::AbstractPlanNode &plan_;
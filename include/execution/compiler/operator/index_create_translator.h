@@ -78,6 +78,13 @@ public:
      */
     void PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const override;
 
+    /**
+     * Build the index from the keys staged by all threads.
+     * @param pipeline The pipeline.
+     * @param function The pipeline generating function.
+     */
+    void FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
     /** @return This translator doesn't have a child */
     ast::Expr *GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const override {
         UNREACHABLE("index create doesn't have child");
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <vector>
+
+#include "execution/compiler/operator/operator_translator.h"
+#include "execution/compiler/pipeline.h"
+
+namespace noisepage::parser {
+class AbstractExpression;
+} // namespace noisepage::parser
+
+namespace noisepage::planner {
+class MergeJoinPlanNode;
+} // namespace noisepage::planner
+
+namespace noisepage::execution::compiler {
+
+class FunctionBuilder;
+
+/**
+ * A translator for sort-merge joins. Both children are sorted ascending on their merge keys. The left pipeline
+ * materializes the rows of the left child into a sorter, in the order they are produced. The sort issued at the end of
+ * the left pipeline finds the rows in order, unless the sorter spilled runs under memory pressure, which it merges. The
+ * right pipeline then merges every row of the right child with the materialized rows: left rows with smaller keys are
+ * skipped for good, and the run of left rows with equal keys is joined with the right row. Both pipelines are serial to
+ * keep the rows of the children in order, and the output is ordered on the right merge keys.
+ */
+class MergeJoinTranslator : public OperatorTranslator {
+public:
+    /**
+     * Create a new translator for the given merge join plan. The compilation occurs within the provided compilation
+     * context and the operator is participating in the provided pipeline.
+     * @param plan The plan.
+     * @param compilation_context The context of compilation this translation is occurring in.
+     * @param pipeline The pipeline this operator is participating in.
+     */
+    MergeJoinTranslator(const planner::MergeJoinPlanNode &plan,
+                        CompilationContext               *compilation_context,
+                        Pipeline                         *pipeline);
+
+    /**
+     * Declare the struct of the rows materialized from the left child, and the struct holding the merge keys of the
+     * current right row.
+     * @param decls The top-level declarations.
+     */
+    void DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) override;
+
+    /**
+     * Define the function comparing two left rows that the sorter is initialized with, and the function comparing a
+     * left row with the merge keys of a right row.
+     * @param decls The top-level declarations.
+     */
+    void DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) override;
+
+    /**
+     * Initialize the sorter the left rows are materialized into.
+     */
+    void InitializeQueryState(FunctionBuilder *function) const override;
+
+    /**
+     * Tear-down the sorter the left rows are materialized into.
+     */
+    void TearDownQueryState(FunctionBuilder *function) const override;
+
+    /**
+     * If the given pipeline is the right pipeline, start the merge at the first left row.
+     * @param pipeline The current pipeline.
+     * @param function The pipeline generating function.
+     */
+    void InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+    /**
+     * Implement main join logic. If the context is coming from the left pipeline, the input tuples are materialized
+     * into the sorter. If the context is coming from the right pipeline, the input tuples are merged with the
+     * materialized left rows.
+     * @param ctx The context of the work.
+     * @param function The pipeline generating function.
+     */
+    void PerformPipelineWork(WorkContext *ctx, FunctionBuilder *function) const override;
+
+    /**
+     * If the given pipeline is the left pipeline, sort the materialized left rows.
+     * @param pipeline The current pipeline.
+     * @param function The pipeline generating function.
+     */
+    void FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+    /**
+     * @return The value (vector) of the attribute at the given index (@em attr_idx) produced by the child at the given
+     *         index (@em child_idx).
+     */
+    ast::Expr *GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const override;
+
+    /**
+     * Merge-joins do not produce columns from base tables.
+     */
+    ast::Expr *GetTableColumn(catalog::col_oid_t col_oid) const override {
+        UNREACHABLE("Merge-joins do not produce columns from base tables.");
+    }
+
+private:
+    // Is the given pipeline this join's left pipeline?
+    bool IsLeftPipeline(const Pipeline &pipeline) const {
+        return &left_pipeline_ == &pipeline;
+    }
+
+    // Is the given pipeline this join's right pipeline?
+    bool IsRightPipeline(const Pipeline &pipeline) const {
+        return GetPipeline() == &pipeline;
+    }
+
+    // Access an attribute at the given index in the provided left row.
+    ast::Expr *GetLeftRowAttribute(ast::Identifier left_row, uint32_t attr_idx) const;
+
+    // Access the merge key at the given index in the provided right keys.
+    ast::Expr *GetRightKey(ast::Identifier right_keys, uint32_t key_idx) const;
+
+    // Generate the function comparing two left rows on the left merge keys.
+    ast::FunctionDecl *GenerateSortComparisonFunction();
+
+    // Generate the function comparing a left row with the merge keys of a right row.
+    ast::FunctionDecl *GenerateMergeComparisonFunction();
+
+    // Generate a check that none of the given merge key values is NULL.
+    ast::Expr *KeysNotNull(const std::vector<ast::Expr *> &keys) const;
+
+    // Input the tuple(s) in the provided context into the sorter.
+    void InsertIntoSorter(WorkContext *ctx, FunctionBuilder *function) const;
+
+    // Merge the input tuple(s) with the materialized left rows.
+    void MergeWithLeftRows(WorkContext *ctx, FunctionBuilder *function) const;
+
+    // Check the join predicate.
+    void CheckJoinPredicate(WorkContext *ctx, FunctionBuilder *function) const;
+
+private:
+    // The name of the materialized left row, when inserting into the sorter or merging with it.
+    ast::Identifier left_row_var_;
+    ast::Identifier left_row_type_;
+    // The name of the merge keys of the current right row.
+    ast::Identifier right_keys_var_;
+    ast::Identifier right_keys_type_;
+    // The parameters of the comparison functions.
+    ast::Identifier lhs_row_, rhs_row_;
+    ast::Identifier sort_compare_func_;
+    ast::Identifier merge_compare_func_;
+
+    // The left materialization pipeline.
+    Pipeline left_pipeline_;
+
+    // The sorter the left rows are materialized into.
+    StateDescriptor::Entry global_sorter_;
+    // The index of the first left row that may join with the current right row. It only moves forward.
+    StateDescriptor::Entry left_idx_;
+
+    // The row whose attributes are read as the output of the left child. It is changed while generating the comparison
+    // functions.
+    enum class CurrentRow { Child, Lhs, Rhs };
+    mutable CurrentRow current_row_;
+};
+
+} // namespace noisepage::execution::compiler
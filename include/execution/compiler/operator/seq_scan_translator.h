@@ -6,6 +6,7 @@
 #include "execution/compiler/operator/operator_translator.h"
 #include "execution/compiler/pipeline.h"
 #include "execution/compiler/pipeline_driver.h"
+#include "execution/sql/sql.h"
 
 namespace noisepage::catalog {
 class CatalogAccessor;
@@ -58,6 +59,21 @@ public:
     void InitializeCounters(const Pipeline &pipeline, FunctionBuilder *function) const override;
     void RecordCounters(const Pipeline &pipeline, FunctionBuilder *function) const override;
 
+    /**
+     * Compute the range of values of a column that can satisfy a "col <cmp> const" term, in the sign-extended integer
+     * form that zone maps keep. Only integer, date and timestamp columns compared to a constant of the same kind have
+     * such a range.
+     * @param term The comparison term, with the column as its first child and the constant as its second.
+     * @param col_type The type of the column.
+     * @param[out] min Smallest value of the range, inclusive.
+     * @param[out] max Largest value of the range, inclusive.
+     * @return False if the term does not restrict the column to such a range, in which case no block filter is added.
+     */
+    static bool GetBlockFilterRange(const parser::AbstractExpression &term,
+                                    sql::SqlTypeId                    col_type,
+                                    int64_t                          *min,
+                                    int64_t                          *max);
+
     /**
      * Generate the scan.
      * @param context The context of the work.
@@ -120,6 +136,10 @@ private:
                                        std::vector<ast::Identifier>                      *curr_clause,
                                        bool                                               seen_conjunction);
 
+    // Restrict the table vector iterator to the value ranges that the terms of a conjunctive predicate require, so that
+    // it can skip blocks by their zone maps.
+    void AddBlockFilters(FunctionBuilder *function, common::ManagedPointer<parser::AbstractExpression> predicate) const;
+
     // Perform a table scan using the provided table vector iterator pointer.
     void ScanTable(WorkContext *ctx, FunctionBuilder *function) const;
 
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <vector>
+
+#include "execution/compiler/operator/operator_translator.h"
+#include "execution/compiler/pipeline.h"
+#include "execution/compiler/pipeline_driver.h"
+
+namespace noisepage::planner {
+class WindowPlanNode;
+} // namespace noisepage::planner
+
+namespace noisepage::parser {
+class WindowExpression;
+} // namespace noisepage::parser
+
+namespace noisepage::execution::compiler {
+
+class FunctionBuilder;
+
+/**
+ * A translator for window plans. The build pipeline materializes the child's rows into a sorter, ordered on the
+ * PARTITION BY and then the ORDER BY of the window. After the sort, the produce pipeline scans the sorted rows in order
+ * and tracks the bounds of the current partition and of the current row's peers, from which the ranking functions and
+ * the frames of the window aggregates are computed. Aggregates whose frame starts at the beginning of the partition are
+ * advanced incrementally as the frame grows; other frames are re-aggregated for every row.
+ */
+class WindowTranslator : public OperatorTranslator, public PipelineDriver {
+public:
+    /**
+     * Create a translator for the given window plan node.
+     * @param plan The plan.
+     * @param compilation_context The context this translator belongs to.
+     * @param pipeline The pipeline this translator is participating in.
+     */
+    WindowTranslator(const planner::WindowPlanNode &plan, CompilationContext *compilation_context, Pipeline *pipeline);
+
+    /**
+     * Define the row structure that's materialized in the sorter.
+     * @param decls The top-level declarations.
+     */
+    void DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) override;
+
+    /**
+     * Define the sorting function, and the functions finding the end of a partition and of a group of peers.
+     * @param decls The top-level declarations.
+     */
+    void DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) override;
+
+    /**
+     * Initialize the sorter instance.
+     */
+    void InitializeQueryState(FunctionBuilder *function) const override;
+
+    /**
+     * Tear-down the sorter instance.
+     */
+    void TearDownQueryState(FunctionBuilder *function) const override;
+
+    /**
+     * If the given pipeline is for the build-size and is parallel, initialize the thread-local sorter instance we
+     * declared inside.
+     * @param pipeline The current pipeline.
+     * @param function The pipeline generating function.
+     */
+    void InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+    /**
+     * If the given pipeline is for the build-size and is parallel, destroy the thread-local sorter instance we declared
+     * inside.
+     * @param pipeline The current pipeline.
+     * @param function The pipeline generating function.
+     */
+    void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+    /**
+     * Implement either the build-side or the scan-side of the window depending on the pipeline this context contains.
+     * @param ctx The context of the work.
+     * @param function The pipeline function generator.
+     */
+    void PerformPipelineWork(WorkContext *ctx, FunctionBuilder *function) const override;
+
+    /**
+     * If the given pipeline is for the build-side, we'll need to issue a sort. If the pipeline is parallel, we'll issue
+     * a parallel sort.
+     * @param pipeline The current pipeline.
+     * @param function The pipeline generating function.
+     */
+    void FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+    /**
+     * The window scan is never launched in parallel, so this should never occur.
+     */
+    util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override {
+        UNREACHABLE("Impossible");
+    }
+
+    /**
+     * The window scan is never launched in parallel, so this should never occur.
+     */
+    void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override {
+        UNREACHABLE("Impossible");
+    }
+
+    /**
+     * @return The value (vector) of the attribute at the given index (@em attr_idx) produced by the child at the given
+     *         index (@em child_idx). Child index 1 refers to the values of the window terms of the plan.
+     */
+    ast::Expr *GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const override;
+
+    /**
+     * Window operators do not produce columns from base tables.
+     */
+    ast::Expr *GetTableColumn(catalog::col_oid_t col_oid) const override {
+        UNREACHABLE("Window operators do not produce columns from base tables");
+    }
+
+private:
+    // Check if the given pipelines are build or scan
+    bool IsBuildPipeline(const Pipeline &pipeline) const {
+        return &build_pipeline_ == &pipeline;
+    }
+    bool IsScanPipeline(const Pipeline &pipeline) const {
+        return GetPipeline() == &pipeline;
+    }
+
+    // Access the attribute at the given index within the provided window row.
+    ast::Expr *GetWindowRowAttribute(ast::Identifier window_row, uint32_t attr_idx) const;
+
+    // Insert the tuple in the context into the sorter instance.
+    void InsertIntoSorter(WorkContext *ctx, FunctionBuilder *function) const;
+
+    // Scan the sorted rows of the global sorter instance, computing the window terms for each of them.
+    void ScanSorter(WorkContext *ctx, FunctionBuilder *function) const;
+
+    // Compute the frame of the window term at the given index, and aggregate it.
+    void ComputeWindowAggregate(FunctionBuilder *function, ast::Expr *sorter_ptr, uint32_t term_idx) const;
+
+    // Advance the aggregate of the window term at the given index with the rows of the sorter in [start, end).
+    void AdvanceWindowAggregate(FunctionBuilder *function,
+                                ast::Expr       *sorter_ptr,
+                                uint32_t         term_idx,
+                                ast::Identifier  idx,
+                                ast::Expr       *end) const;
+
+    // Generate the comparison function used to sort the rows.
+    void GenerateComparisonFunction(FunctionBuilder *function);
+
+    // Generate a function returning the index of the first row in [start, end) that differs from the row at start on
+    // the PARTITION BY, and the ORDER BY if requested, or end if there is none.
+    ast::FunctionDecl *GenerateFindEndFunction(ast::Identifier name, bool include_order_by);
+
+    // Generate a check that the sort key is NULL in the lhs row but not in the rhs row, or the other way around if
+    // lhs_null is false. The comparison operators never hold for NULLs, so NULLs are checked for separately.
+    ast::Expr *KeyIsNullInOneRow(WorkContext *context, const parser::AbstractExpression &key, bool lhs_null);
+
+    // The window that all the window terms of the plan share.
+    const parser::WindowExpression &GetWindow() const;
+
+    // Aggregates whose frame starts at the beginning of the partition are computed incrementally.
+    static bool IsIncrementalAggregate(const parser::WindowExpression &term);
+
+private:
+    // The name of the materialized window row when inserting into the sorter or reading from it, and of the row of the
+    // frame being aggregated.
+    ast::Identifier window_row_var_;
+    ast::Identifier frame_row_var_;
+    ast::Identifier window_row_type_;
+    ast::Identifier lhs_row_, rhs_row_;
+    ast::Identifier compare_func_;
+    ast::Identifier find_partition_end_func_;
+    ast::Identifier find_peer_end_func_;
+
+    // The bounds of the current partition and of the peers of the current row in the scan.
+    ast::Identifier row_idx_;
+    ast::Identifier partition_start_, partition_end_;
+    ast::Identifier peer_start_, peer_end_;
+    ast::Identifier dense_rank_;
+
+    // The value of every window term, and their aggregates and how far the incremental ones have been advanced.
+    std::vector<ast::Identifier> window_values_;
+    std::vector<ast::Identifier> window_aggs_;
+    std::vector<ast::Identifier> window_agg_ends_;
+
+    // Build-side pipeline.
+    Pipeline build_pipeline_;
+
+    // Where the global and thread-local sorter instances are.
+    StateDescriptor::Entry global_sorter_;
+    StateDescriptor::Entry local_sorter_;
+
+    // The row whose attributes are read as the child's output. It is changed while generating code that reads rows
+    // other than the one in the context, i.e., when comparing rows or aggregating frames.
+    enum class CurrentRow { Child, Lhs, Rhs, Frame };
+    mutable CurrentRow current_row_;
+};
+
+} // namespace noisepage::execution::compiler
@@ -108,7 +108,9 @@ public:
         , accessor_(accessor)
         , metrics_manager_(metrics_manager)
         , replication_manager_(replication_manager)
-        , recovery_manager_(recovery_manager) {}
+        , recovery_manager_(recovery_manager) {
+        mem_tracker_->SetBudget(exec_settings.GetQueryMemoryBudget());
+    }
 
     /**
      * @return the transaction used by this query
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <utility>
 
 #include "common/constants.h"
@@ -110,6 +111,16 @@ public:
         return is_static_partitioner_enabled_;
     }
 
+    /** @return The number of bytes a query may allocate before spilling to disk, or 0 if there is no budget. */
+    uint64_t GetQueryMemoryBudget() const {
+        return query_memory_budget_;
+    }
+
+    /** @return The directory where queries spill their temporary files. */
+    const std::string &GetSpillDirectory() const {
+        return spill_directory_;
+    }
+
 private:
     double select_opt_threshold_{common::Constants::SELECT_OPT_THRESHOLD};
     double arithmetic_full_compute_opt_threshold_{common::Constants::ARITHMETIC_FULL_COMPUTE_THRESHOLD};
@@ -121,6 +132,9 @@ private:
     bool  is_pipeline_metrics_enabled_{common::Constants::IS_PIPELINE_METRICS_ENABLED};
     int   number_of_parallel_execution_threads_{common::Constants::NUM_PARALLEL_EXECUTION_THREADS};
     bool  is_static_partitioner_enabled_{common::Constants::IS_STATIC_PARTITIONER_ENABLED};
+
+    uint64_t    query_memory_budget_{0};
+    std::string spill_directory_{"/tmp/"};
     compiler::CompilerSettings compiler_settings_{}; ///< The settings for compiling the TPL input.
 
     // MiniRunners needs to set query_identifier and pipeline_operating_units_.
@@ -17,10 +17,17 @@ public:
 
     /**
      * Initialize all TPL subsystems
+     * @param bytecode_handlers_path The path to the bytecode handlers bitcode file
+     * @param jit_cache_directory The directory of the JIT object cache; empty to disable the cache
+     * @param jit_cache_size The maximum total size of the JIT object cache in bytes
      */
-    static void InitTPL(std::string_view bytecode_handlers_path) {
+    static void InitTPL(std::string_view bytecode_handlers_path,
+                        std::string_view jit_cache_directory = "",
+                        uint64_t         jit_cache_size = 0) {
         execution::CpuInfo::Instance();
-        auto settings = std::make_unique<const typename vm::LLVMEngine::Settings>(bytecode_handlers_path);
+        auto settings = std::make_unique<const typename vm::LLVMEngine::Settings>(bytecode_handlers_path,
+                                                                                  jit_cache_directory,
+                                                                                  jit_cache_size);
         execution::vm::LLVMEngine::Initialize(std::move(settings));
     }
 
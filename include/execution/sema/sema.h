@@ -140,6 +140,7 @@ namespace sema {
         void CheckBuiltinJoinHashTableIterCall(ast::CallExpr *call, ast::Builtin builtin);
         void CheckBuiltinSorterInit(ast::CallExpr *call);
         void CheckBuiltinSorterGetTupleCount(ast::CallExpr *call);
+        void CheckBuiltinSorterGetTupleAt(ast::CallExpr *call);
         void CheckBuiltinSorterInsert(ast::CallExpr *call, ast::Builtin builtin);
         void CheckBuiltinSorterSort(ast::CallExpr *call, ast::Builtin builtin);
         void CheckBuiltinSorterFree(ast::CallExpr *call);
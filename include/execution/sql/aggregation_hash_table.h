@@ -9,6 +9,7 @@
 #include "common/managed_pointer.h"
 #include "execution/sql/chaining_hash_table.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/spill_file.h"
 #include "execution/sql/vector.h"
 #include "execution/sql/vector_projection.h"
 #include "execution/util/chunked_vector.h"
@@ -41,6 +42,16 @@ class AHTOverflowPartitionIterator;
 
 /**
  * The hash table used when performing aggregations.
+ *
+ * In partitioned mode, the partial aggregates of a thread-local table are flushed into overflow
+ * partitions whenever its main table fills up. If the query is over its memory budget after a
+ * flush, the overflow partitions are spilled to a temporary file, partition by partition, and their
+ * memory is released. TransferMemoryAndPartitions() maps the spilled partitions back and links
+ * them into the global overflow partitions, so they are merged like the partitions in memory.
+ *
+ * A serial table that is over the budget when it has to grow switches to partitioned mode instead,
+ * so that it flushes and spills its partial aggregates the same way. MergeOverflowPartitions() then
+ * merges them back into its main table once the build is done.
  */
 class EXPORT AggregationHashTable {
 public:
@@ -115,6 +126,8 @@ public:
         uint64_t num_flushes_ = 0;
         /** Number of times that the hash table has been inserted into. */
         uint64_t num_inserts_ = 0;
+        /** Number of times that the overflow partitions have been spilled. */
+        uint64_t num_spills_ = 0;
     };
 
     // -------------------------------------------------------
@@ -157,7 +170,8 @@ public:
     ~AggregationHashTable();
 
     /**
-     * Insert a new element with hash value @em hash into the aggregation table.
+     * Insert a new element with hash value @em hash into the aggregation table. If the table is over
+     * the query's memory budget when it has to grow, it switches to partitioned mode.
      * @param hash The hash value of the element to insert.
      * @return A pointer to a memory area where the element can be written to.
      */
@@ -231,6 +245,17 @@ public:
      */
     void ExecutePartitionedScan(void *query_state, ScanPartitionFn scan_fn);
 
+    /**
+     * Merge the partial aggregates of a serial table that switched to partitioned mode, both those in
+     * its overflow partitions and those it spilled, back into its main table, so that it can be
+     * iterated with an AHTIterator. A no-op if the table never switched. It is called at the end of
+     * the build-portion of a serial aggregation.
+     *
+     * @param query_state The (opaque) query state.
+     * @param merge_partition_fn The function to use for merging partitions.
+     */
+    void MergeOverflowPartitions(void *query_state, MergePartitionFn merge_partition_fn);
+
     /**
      * Execute a parallel scan over this hash table. It is assumed that this aggregation table was
      * constructed in a partitioned manner. This function builds a hash table for any non-empty
@@ -315,6 +340,9 @@ private:
     // Internal entry allocation + hash table linkage. Does not resize!
     HashTableEntry *AllocateEntryInternal(hash_t hash);
 
+    // Allocate an entry, growing the table if need be.
+    byte *AllocInputTupleInternal(hash_t hash);
+
     // Lookup a hash table entry internally
     HashTableEntry *LookupEntryInternal(hash_t hash, KeyEqFn key_eq_fn, const void *probe_tuple) const;
 
@@ -330,6 +358,31 @@ private:
     // Allocate all overflow partition information if unallocated
     void AllocateOverflowPartitions();
 
+    // Should the overflow partitions be spilled? Only right after a flush, when
+    // no entry is left in the main table, and once enough entries are buffered.
+    bool NeedsToSpill() const {
+        return hash_table_.GetElementCount() == 0
+            && entries_.size() * entries_.ElementSize() >= SpillFile::MIN_SPILL_SIZE && memory_->IsOverBudget();
+    }
+
+    // Spill all overflow partitions, and release the memory of their entries.
+    void SpillOverflowPartitions();
+
+    // Should a serial table switch to partitioned mode? Only when it has to grow
+    // while the query is over its memory budget, and has enough entries to spill.
+    bool NeedsToSwitchToPartitionedMode() const {
+        return !partitioned_mode_ && NeedsToGrow()
+            && entries_.size() * entries_.ElementSize() >= SpillFile::MIN_SPILL_SIZE && memory_->IsOverBudget();
+    }
+
+    // Flush the main table into the overflow partitions, and keep flushing them
+    // from now on, so they can be spilled.
+    void SwitchToPartitionedMode();
+
+    // Map the spilled overflow partitions of the source table and link them into
+    // our overflow partitions, taking ownership of the spill file.
+    void LinkSpilledPartitions(AggregationHashTable *source);
+
     // Called from ProcessBatch() to compute hash values for tuples in batch.
     void ComputeHash(VectorProjectionIterator *input_batch, const std::vector<uint32_t> &key_indexes);
 
@@ -467,6 +520,14 @@ private:
     // The number of bits to shift the hash value to determine the overflow
     // partition an entry is linked into.
     uint64_t partition_shift_bits_;
+    // The file the overflow partitions are spilled to, if any, and the partition
+    // and number of entries of every group of entries in it, in file order.
+    std::unique_ptr<SpillFile>                spill_file_;
+    std::vector<std::pair<uint32_t, uint64_t>> spilled_partitions_;
+    // Spill files taken from other tables.
+    std::vector<std::unique_ptr<SpillFile>> owned_spill_files_;
+    // Whether this serial table switched to partitioned mode to spill.
+    bool partitioned_mode_;
 
     // Runtime stats.
     Stats stats_;
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex> // NOLINT
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/constants.h"
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+#include "execution/sql/sql.h"
+#include "storage/projected_row.h"
+
+namespace noisepage::catalog {
+class CatalogAccessor;
+} // namespace noisepage::catalog
+
+namespace noisepage::storage {
+class RawBlock;
+class SqlTable;
+} // namespace noisepage::storage
+
+namespace noisepage::transaction {
+class TransactionContext;
+} // namespace noisepage::transaction
+
+namespace noisepage::execution::util {
+class File;
+} // namespace noisepage::execution::util
+
+namespace noisepage::execution::sql {
+
+/**
+ * Loads the rows of a file into a table for COPY ... FROM, without going through per-tuple inserts. The file is read
+ * sequentially in chunks of about BulkLoader::CHUNK_SIZE bytes, which are parsed in parallel. Every parsing thread
+ * fills whole blocks that no other transaction can see, and hands each full block to the table in one go through
+ * storage::SqlTable::InsertBlock(). The table logs the tuples of a block in batches rather than with one redo record
+ * per tuple. The table's indexes are populated once all blocks are loaded.
+ *
+ * @code
+ * BulkLoader loader(accessor, db_oid, table_oid, txn);
+ * uint64_t num_rows = loader.LoadCsv("/data/orders.csv", ',', '"', '"');
+ * @endcode
+ *
+ * Two file formats are supported: CSV, and the binary format of PostgreSQL's COPY. An empty CSV value is read as NULL.
+ * CSV chunks are split at line breaks, so quoted values must not contain line breaks.
+ *
+ * All rows are inserted on behalf of the given transaction. If a load throws, the rows it inserted so far are still
+ * part of the transaction, so the transaction must be aborted.
+ */
+class EXPORT BulkLoader {
+public:
+    /** Number of bytes of the input file that are read and parsed as a unit. */
+    static constexpr uint32_t CHUNK_SIZE = 16 * common::Constants::MB;
+
+    /**
+     * Create a loader for the given table.
+     * @param accessor The catalog accessor of the loading transaction.
+     * @param db_oid The database of the table.
+     * @param table_oid The table to load into.
+     * @param txn The loading transaction.
+     * @throw ExecutionException if the table has a column of a type the loader cannot parse.
+     */
+    BulkLoader(common::ManagedPointer<catalog::CatalogAccessor>         accessor,
+               catalog::db_oid_t                                        db_oid,
+               catalog::table_oid_t                                     table_oid,
+               common::ManagedPointer<transaction::TransactionContext> txn);
+
+    /**
+     * This class cannot be copied or moved.
+     */
+    DISALLOW_COPY_AND_MOVE(BulkLoader);
+
+    /**
+     * Load the rows of a CSV file. Every row must hold a value for every column of the table, in column order.
+     * @param path The path to the file.
+     * @param delimiter The character that separates values within a row.
+     * @param quote The character used to quote values.
+     * @param escape The character escaping a quote character within a quoted value.
+     * @return The number of rows loaded.
+     * @throw ExecutionException if the file cannot be read, is malformed, or a row violates a constraint of the table.
+     */
+    uint64_t LoadCsv(const std::string &path, char delimiter, char quote, char escape);
+
+    /**
+     * Load the rows of a file in the binary format of PostgreSQL's COPY. Every row must hold a value for every column
+     * of the table, in column order.
+     * @param path The path to the file.
+     * @return The number of rows loaded.
+     * @throw ExecutionException if the file cannot be read, is malformed, or a row violates a constraint of the table.
+     */
+    uint64_t LoadBinary(const std::string &path);
+
+private:
+    // Fills blocks with the rows parsed by one thread.
+    class BlockWriter;
+
+    // What the loader needs to know about a column of the table.
+    struct ColumnInfo {
+        // Name of the column, for error messages.
+        std::string name_;
+        // SQL type of the column.
+        SqlTypeId type_;
+        // True if the column accepts NULLs.
+        bool nullable_;
+        // Offset of the column in the rows handed to the table.
+        uint16_t offset_;
+    };
+
+    // Given the data read but not yet parsed, and whether the end of the file was reached, returns the number of
+    // leading bytes that form complete rows and sets the flag to true if no more data should be read.
+    using SplitFn = std::function<std::size_t(const std::string &, bool, bool *)>;
+
+    // Parses the rows of a chunk.
+    using ParseFn = std::function<void(std::string &&, BlockWriter *)>;
+
+    // Read the file from the given offset on, and parse it in parallel.
+    uint64_t Load(const util::File &file, uint64_t offset, const SplitFn &split, const ParseFn &parse);
+
+    // Parse the rows of a chunk of a CSV file.
+    void ParseCsvChunk(std::string &&chunk, char delimiter, char quote, char escape, BlockWriter *writer) const;
+
+    // Parse the rows of a chunk of a binary file. The chunk must consist of complete rows.
+    void ParseBinaryChunk(const std::string &chunk, BlockWriter *writer) const;
+
+    // Store the value of a column given in text form.
+    void SetFromText(storage::ProjectedRow *row, uint16_t col_idx, std::string_view text) const;
+
+    // Store the value of a column given in binary form.
+    void SetFromBinary(storage::ProjectedRow *row, uint16_t col_idx, const char *data, int32_t size) const;
+
+    // Throw if a column does not accept NULLs.
+    void CheckNullable(uint16_t col_idx) const;
+
+    // Insert a full block into the table. Thread-safe.
+    void InsertBlock(storage::RawBlock *block);
+
+    // Insert the loaded tuples into the table's indexes.
+    void PopulateIndexes();
+
+    // The catalog accessor of the loading transaction.
+    common::ManagedPointer<catalog::CatalogAccessor> accessor_;
+    // The database of the table.
+    catalog::db_oid_t db_oid_;
+    // The table to load into.
+    catalog::table_oid_t table_oid_;
+    // The loading transaction.
+    common::ManagedPointer<transaction::TransactionContext> txn_;
+    // The table to load into.
+    common::ManagedPointer<storage::SqlTable> table_;
+    // The columns of the table, in schema order.
+    std::vector<ColumnInfo> columns_;
+    // Initializer for rows holding every column of the table.
+    storage::ProjectedRowInitializer row_initializer_;
+    // Protects the members below, and the transaction's redo buffer while a block is inserted.
+    std::mutex insert_latch_;
+    // The blocks inserted by the current load.
+    std::vector<storage::RawBlock *> loaded_blocks_;
+    // The number of rows inserted by the current load.
+    uint64_t num_rows_;
+};
+
+} // namespace noisepage::execution::sql
@@ -10,6 +10,7 @@
 #include "execution/sql/chaining_hash_table.h"
 #include "execution/sql/concise_hash_table.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/spill_file.h"
 #include "execution/util/chunked_vector.h"
 
 namespace libcount {
@@ -46,6 +47,17 @@ class Vector;
  * In parallel mode, thread-local join hash tables are lazily built and merged in parallel into a
  * global join hash table through a call to JoinHashTable::MergeParallel(). After this call, the
  * global table takes ownership of all thread-local allocated memory and hash index.
+ *
+ * When the estimated build side does not fit in the last-level cache, MergeParallel() radix
+ * partitions the thread-local entries on the high bits of their hash instead of inserting them
+ * into one global table. Each partition owns a cache-sized slice of the directory, so partitions
+ * are built independently, without atomics, and each build only touches a cache-resident slice.
+ *
+ * If the query goes over its memory budget while tuples are inserted, the buffered tuples are
+ * spilled to a SpillFile and their memory is released. Probes cannot be partitioned, so spilled
+ * tuples are not re-read partition-by-partition. Instead, the spill files are mapped back into
+ * memory at build time and linked into the hash table like any other entry, letting the OS page
+ * them in and out as the probe needs them. Tables that use a concise hash table never spill.
  */
 class EXPORT JoinHashTable {
 public:
@@ -63,6 +75,19 @@ public:
     /** Minimum number of expected elements to merge before triggering a parallel merge. */
     static constexpr uint32_t DEFAULT_MIN_SIZE_FOR_PARALLEL_MERGE = 1024;
 
+    /** Maximum number of radix bits partitioned on in a single pass, bounding the fan-out by the TLB size. */
+    static constexpr uint32_t MAX_RADIX_BITS_PER_PASS = 8;
+
+    /** How thread-local tables are merged in JoinHashTable::MergeParallel(). */
+    enum class MergeMode : uint8_t {
+        /** Radix partition if the estimated build side exceeds the last-level cache. */
+        Automatic,
+        /** Always insert into one global chaining hash table. */
+        Global,
+        /** Always radix partition. */
+        RadixPartitioned
+    };
+
     /**
      * Construct a join hash table. All memory allocations are sourced from the injected @em memory,
      * and thus, are ephemeral.
@@ -128,6 +153,14 @@ public:
      */
     void MergeParallel(ThreadStateContainer *thread_state_container, std::size_t jht_offset);
 
+    /**
+     * Override how the next call to MergeParallel() merges the thread-local tables.
+     * @param merge_mode The merge mode.
+     */
+    void SetMergeMode(MergeMode merge_mode) {
+        merge_mode_ = merge_mode;
+    }
+
     /**
      * @return The total number of bytes used to materialize tuples. This excludes space required for
      *         the join index.
@@ -141,6 +174,9 @@ public:
      *         as the hash table directory), excludes storage for materialized tuple contents.
      */
     uint64_t GetJoinIndexMemoryUsage() const {
+        if (UsingRadixPartitions()) {
+            return radix_directory_.size() * sizeof(HashTableEntry *);
+        }
         return UsingConciseHashTable() ? concise_hash_table_.GetTotalMemoryUsage()
                                        : chaining_hash_table_.GetTotalMemoryUsage();
     }
@@ -174,14 +210,14 @@ public:
         // performance critical function, so locking should be okay ...
         common::SpinLatch::ScopedSpinLatch latch(&owned_latch_);
         if (!owned_.empty()) {
-            uint64_t count = 0;
+            uint64_t count = num_spilled_;
             for (const auto &entries : owned_) {
                 count += entries.size();
             }
             return count;
         }
 
-        return entries_.size();
+        return entries_.size() + num_spilled_;
     }
 
     /**
@@ -198,6 +234,20 @@ public:
         return use_concise_ht_;
     }
 
+    /**
+     * @return True if this join hash table was merged into radix partitions.
+     */
+    bool UsingRadixPartitions() const {
+        return radix_bits_ != 0;
+    }
+
+    /**
+     * @return The number of radix partitions, or zero if the table is not partitioned.
+     */
+    uint64_t GetNumRadixPartitions() const {
+        return UsingRadixPartitions() ? uint64_t{1} << radix_bits_ : 0;
+    }
+
     /**
      * @return The underlying bloom filter.
      */
@@ -219,6 +269,15 @@ private:
         return reinterpret_cast<const HashTableEntry *>(entries_[idx]);
     }
 
+    // Should the buffered entries be spilled before allocating a new one?
+    bool NeedsToSpill() const;
+
+    // Spill all buffered entries to the spill file and release their memory.
+    void SpillEntries();
+
+    // Take ownership of the spill file of the source table, if it spilled.
+    void TakeSpillFile(JoinHashTable *source);
+
     // Dispatched from Build() to build either a chaining or concise hash table.
     void BuildChainingHashTable();
     void BuildConciseHashTable();
@@ -235,14 +294,26 @@ private:
     void VerifyOverflowEntryOrder();
 
     // Dispatched from LookupBatch() to lookup from either a chaining or concise
-    // hash table in batched manner.
+    // hash table, or from the radix partitioned directory, in batched manner.
     void LookupBatchInChainingHashTable(const Vector &hashes, Vector *results) const;
     void LookupBatchInConciseHashTable(const Vector &hashes, Vector *results) const;
+    void LookupBatchInRadixPartitions(const Vector &hashes, Vector *results) const;
 
     // Merge the source hash table (which isn't built yet) into this one
     template <bool Concurrent>
     void MergeIncomplete(JoinHashTable *source);
 
+    // Dispatched from MergeParallel() to radix partition the entries of the
+    // thread-local tables and build each partition's slice of the directory.
+    void MergeRadixPartitioned(ThreadStateContainer *thread_state_container, std::vector<JoinHashTable *> *sources);
+
+    // Find the head of the bucket chain for the given hash in the radix
+    // partitioned directory.
+    HashTableEntry *FindRadixChainHead(const hash_t hash) const {
+        const uint64_t partition = hash >> (sizeof(hash_t) * 8 - radix_bits_);
+        return radix_directory_[(partition << radix_bucket_bits_) | (hash & radix_bucket_mask_)];
+    }
+
 private:
     // The execution context to run with.
     const exec::ExecutionSettings &exec_settings_;
@@ -259,6 +330,18 @@ private:
     // Protected by 'owned_latch_'.
     MemPoolVector<decltype(entries_)> owned_;
 
+    // The file buffered entries are spilled to when the query is over its memory budget, if any.
+    std::unique_ptr<SpillFile> spill_file_;
+
+    // Spill files this hash table has taken ownership of, including its own once built. The files
+    // are mapped, and their entries are linked into the hash table.
+    // Protected by 'owned_latch_'.
+    std::vector<std::unique_ptr<SpillFile>> owned_spill_files_;
+
+    // The number of entries in spill files, whether owned or not.
+    // Protected by 'owned_latch_'.
+    uint64_t num_spilled_;
+
     // The chaining hash table.
     TaggedChainingHashTable chaining_hash_table_;
 
@@ -277,6 +360,17 @@ private:
     // Should we use a concise hash table?
     bool use_concise_ht_;
 
+    // How MergeParallel() merges thread-local tables.
+    MergeMode merge_mode_;
+
+    // The radix partitioned directory. Partition P (the top 'radix_bits_' bits
+    // of a hash) owns the slice [P << radix_bucket_bits_, (P+1) << radix_bucket_bits_).
+    // 'radix_bits_' is zero when the table is not partitioned.
+    MemPoolVector<HashTableEntry *> radix_directory_;
+    uint32_t                        radix_bits_;
+    uint32_t                        radix_bucket_bits_;
+    uint64_t                        radix_bucket_mask_;
+
     // MemoryTracker
     common::ManagedPointer<MemoryTracker> tracker_;
 };
@@ -288,7 +382,8 @@ private:
 /** Look up the specified hash, do not use the concise hash table. */
 template <>
 inline HashTableEntryIterator JoinHashTable::Lookup<false>(const hash_t hash) const {
-    HashTableEntry *entry = chaining_hash_table_.FindChainHead(hash);
+    HashTableEntry *entry
+        = UsingRadixPartitions() ? FindRadixChainHead(hash) : chaining_hash_table_.FindChainHead(hash);
     while (entry != nullptr && entry->hash_ != hash) {
         entry = entry->next_;
     }
@@ -336,16 +431,20 @@ public:
      * @return True if there is more data in the iterator; false otherwise.
      */
     bool HasNext() const noexcept {
-        return entry_iter_ != entry_end_;
+        return entry_iter_ != entry_end_ || spilled_entry_ != spilled_end_;
     }
     /**
      * Advance to the next tuple.
      */
     void Next() noexcept {
-        // Advance the entry iterator by one.
-        ++entry_iter_;
+        // Advance the entry iterator by one. Spilled entries come after all in-memory entries.
+        if (entry_iter_ != entry_end_) {
+            ++entry_iter_;
+        } else {
+            spilled_entry_ += entry_size_;
+        }
         // If we've exhausted the current entry list, find another.
-        if (entry_iter_ == entry_end_) {
+        if (entry_iter_ == entry_end_ && spilled_entry_ == spilled_end_) {
             FindNextNonEmptyList();
         }
     }
@@ -356,8 +455,8 @@ public:
      */
     const byte *GetCurrentRow() const noexcept {
         NOISEPAGE_ASSERT(HasNext(), "HasNext() indicates no more data!");
-        const auto entry = reinterpret_cast<const HashTableEntry *>(*entry_iter_);
-        return entry->payload_;
+        const byte *raw_entry = (entry_iter_ != entry_end_ ? *entry_iter_ : spilled_entry_);
+        return reinterpret_cast<const HashTableEntry *>(raw_entry)->payload_;
     }
 
     /**
@@ -372,16 +471,23 @@ public:
     }
 
 private:
-    // Advance past any empty entry lists.
+    // Advance past any empty entry lists, then past any empty spill files.
     void FindNextNonEmptyList();
 
 private:
     using EntryListIterator = decltype(JoinHashTable::owned_)::const_iterator;
     using EntryIterator = decltype(JoinHashTable::entries_)::Iterator;
+    using SpillFileIterator = decltype(JoinHashTable::owned_spill_files_)::const_iterator;
     // An iterator over the entry lists owned by the join hash table.
     EntryListIterator entry_list_iter_, entry_list_end_;
     // An iterator over the entries in a single entry list.
     EntryIterator entry_iter_, entry_end_;
+    // An iterator over the spill files owned by the join hash table.
+    SpillFileIterator spill_file_iter_, spill_file_end_;
+    // The range of entries in a single mapped spill file.
+    const byte *spilled_entry_, *spilled_end_;
+    // The size of each entry.
+    std::size_t entry_size_;
 };
 
 } // namespace noisepage::execution::sql
@@ -286,6 +286,12 @@ public:
         return tracker_;
     }
 
+    /**
+     * @return True if the tracked allocations exceed the memory budget of the tracker; false if they
+     *         don't, or if there is no tracker.
+     */
+    bool IsOverBudget() const;
+
 private:
     // Metadata tracker for memory allocations
     common::ManagedPointer<MemoryTracker> tracker_;
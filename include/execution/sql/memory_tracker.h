@@ -2,16 +2,19 @@
 
 #include <tbb/enumerable_thread_specific.h>
 
+#include <atomic>
+
 namespace noisepage::execution::sql {
 
 /**
  * Class for tracking memory on a per-thread granularity.
- * Currently tracks allocation size in bytes during thread's execution.
+ * Currently tracks allocation size in bytes during thread's execution, and the total across all threads that is
+ * checked against the memory budget.
  */
 class EXPORT MemoryTracker {
 public:
     /**
-     * Reset tracker
+     * Reset tracker of this thread. The total across all threads still counts the memory that is not freed yet.
      */
     void Reset() {
         stats_.local().allocated_bytes_ = 0;
@@ -30,6 +33,7 @@ public:
      */
     void Increment(size_t size) {
         stats_.local().allocated_bytes_ += size;
+        total_allocated_bytes_.fetch_add(size, std::memory_order_relaxed);
     }
 
     /**
@@ -38,6 +42,36 @@ public:
      */
     void Decrement(size_t size) {
         stats_.local().allocated_bytes_ -= size;
+        total_allocated_bytes_.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    /**
+     * Set the number of bytes that may be allocated across all threads before operators spill to disk
+     * @param budget memory budget in bytes, or 0 for no budget
+     */
+    void SetBudget(size_t budget) {
+        budget_ = budget;
+    }
+
+    /**
+     * @returns memory budget in bytes, or 0 if there is no budget
+     */
+    size_t GetBudget() const {
+        return budget_;
+    }
+
+    /**
+     * @returns number of allocated bytes across all threads
+     */
+    size_t GetTotalAllocatedSize() const {
+        return total_allocated_bytes_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @returns true if the allocations across all threads exceed the budget
+     */
+    bool IsOverBudget() const {
+        return budget_ != 0 && GetTotalAllocatedSize() > budget_;
     }
 
 private:
@@ -49,6 +83,12 @@ private:
         size_t allocated_bytes_ = 0;
     };
     tbb::enumerable_thread_specific<Stats> stats_;
+    // Number of bytes allocated across all threads. Operators check it on every allocation, so it is kept up to date
+    // instead of summing the thread-local stats while other threads modify them. Memory may be freed by a different
+    // thread than the one that allocated it, so only the total is meaningful.
+    std::atomic<size_t> total_allocated_bytes_{0};
+    // Memory budget in bytes, 0 if there is none
+    size_t budget_ = 0;
 };
 
 } // namespace noisepage::execution::sql
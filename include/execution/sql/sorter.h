@@ -7,6 +7,7 @@
 #include "catalog/schema.h"
 #include "common/macros.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/spill_file.h"
 #include "execution/util/chunked_vector.h"
 
 namespace noisepage::execution::exec {
@@ -67,6 +68,11 @@ class VectorProjectionIterator;
  * thread-local Sorter, but <b>without calling</b> Sorter::Sort(). When all insertions are complete
  * across all threads, the primary thread uses Sorter::SortParallel() or Sorter::SortTopKParallel()
  * for parallel sort and parallel Top-K, respectively.
+ *
+ * When the query is over its memory budget, the buffered tuples are sorted into a run that is
+ * spilled to a temporary file, and their memory is released. Sorting then becomes an external merge
+ * sort: the spilled runs are mapped back and merged, and the sorted order points into the mapped
+ * runs. Top-K sorts never spill since they only buffer K tuples.
  */
 class EXPORT Sorter {
 public:
@@ -169,7 +175,16 @@ public:
      * @return The number of tuples currently in this sorter.
      */
     uint64_t GetTupleCount() const noexcept {
-        return tuples_.size();
+        return tuples_.size() + num_spilled_tuples_;
+    }
+
+    /**
+     * @param idx The index of the tuple, in sorted order if the sorter has been sorted.
+     * @return A pointer to the tuple at the given index.
+     */
+    const byte *GetTupleAt(uint64_t idx) const noexcept {
+        NOISEPAGE_ASSERT(idx < tuples_.size(), "Tuple index out of bounds.");
+        return tuples_[idx];
     }
 
     /**
@@ -194,6 +209,26 @@ private:
     // property
     void HeapSiftDown();
 
+    // Should the buffered tuples be spilled? The memory budget is only checked when
+    // a new chunk of tuples is about to be allocated, and only once enough tuples
+    // are buffered to make the spilled run worth writing.
+    bool NeedsToSpill() const {
+        return (tuple_storage_.size() & decltype(tuple_storage_)::K_CHUNK_POSITION_MASK) == 0
+            && tuple_storage_.size() * tuple_storage_.ElementSize() >= SpillFile::MIN_SPILL_SIZE
+            && memory_->IsOverBudget();
+    }
+
+    // Does this sorter have spilled runs that haven't been merged yet?
+    bool HasSpilledRuns() const {
+        return !run_sizes_.empty();
+    }
+
+    // Sort the buffered tuples into a run, spill it, and release the memory of the tuples.
+    void SpillRun();
+
+    // Spill the buffered tuples as the last run and merge all the spilled runs.
+    void MergeSpilledRuns();
+
 private:
     friend class SorterIterator;
     friend class SorterVectorIterator;
@@ -216,6 +251,18 @@ private:
 
     // Flag indicating if the contents of the sorter have been sorted
     bool sorted_;
+
+    // The file sorted runs are spilled to when the query is over its memory budget, if any
+    std::unique_ptr<SpillFile> run_file_;
+
+    // The number of tuples in each spilled run that hasn't been merged yet, in file order
+    std::vector<uint64_t> run_sizes_;
+
+    // The total number of tuples in the spilled runs that haven't been merged yet
+    uint64_t num_spilled_tuples_;
+
+    // All spill files this sorter has taken ownership of from thread-local sorters, if any
+    std::vector<std::unique_ptr<SpillFile>> owned_run_files_;
 };
 
 /**
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "common/macros.h"
+#include "common/strong_typedef.h"
+#include "execution/util/execution_common.h"
+
+namespace noisepage::execution::sql {
+
+/**
+ * A temporary file that operators over the query's memory budget spill their data into. Data is
+ * appended sequentially through a write buffer. Once everything is appended, the file is mapped
+ * back into memory through SpillFile::Map(). The mapping is shared and file-backed, so the OS can
+ * write its pages back to the file and evict them under memory pressure, instead of the process
+ * running out of memory.
+ *
+ * @code
+ * SpillFile file(exec_settings.GetSpillDirectory());
+ * for (tuple in spilled tuples) {
+ *   file.Append(tuple, tuple_size);
+ * }
+ * byte *tuples = file.Map();
+ * @endcode
+ *
+ * The file is unlinked as soon as it's created, so it is removed when it's closed, even if the
+ * process crashes.
+ */
+class EXPORT SpillFile {
+public:
+    /** Size of the write buffer, and thus of the writes issued to the file. */
+    static constexpr uint64_t WRITE_BUFFER_SIZE = 1 << 20;
+
+    /** Minimum number of bytes an operator buffers before spilling them, to avoid tiny writes. */
+    static constexpr uint64_t MIN_SPILL_SIZE = 256 << 10;
+
+    /**
+     * Create an empty temporary file in the given directory.
+     * @param directory The directory to create the file in.
+     * @throw ExecutionException if the file cannot be created.
+     */
+    explicit SpillFile(const std::string &directory);
+
+    /**
+     * This class cannot be copied or moved.
+     */
+    DISALLOW_COPY_AND_MOVE(SpillFile);
+
+    /**
+     * Unmap and remove the file.
+     */
+    ~SpillFile();
+
+    /**
+     * Append the given bytes to the end of the file.
+     * @pre The file must not have been mapped.
+     * @param data The bytes to append.
+     * @param size The number of bytes to append.
+     * @throw ExecutionException if the write fails, e.g., because the disk is full.
+     */
+    void Append(const byte *data, std::size_t size);
+
+    /**
+     * Flush the write buffer and map the whole file into memory, for reading and writing. Further
+     * calls return the same mapping.
+     * @return The mapped file contents, or nullptr if the file is empty.
+     * @throw ExecutionException if the file cannot be mapped.
+     */
+    byte *Map();
+
+    /**
+     * @return The number of bytes appended to the file.
+     */
+    uint64_t GetSize() const noexcept {
+        return size_ + buffer_size_;
+    }
+
+    /**
+     * @return True if the file has been mapped into memory.
+     */
+    bool IsMapped() const noexcept {
+        return mapping_ != nullptr;
+    }
+
+private:
+    // Write out the contents of the write buffer.
+    void Flush();
+
+private:
+    // The file descriptor of the (unlinked) file.
+    int fd_;
+    // The buffer where appended bytes are gathered before being written out.
+    std::unique_ptr<byte[]> buffer_;
+    // The number of bytes in the write buffer.
+    uint64_t buffer_size_;
+    // The number of bytes written out to the file.
+    uint64_t size_;
+    // The mapping of the file, or nullptr if it's not mapped.
+    byte *mapping_;
+};
+
+} // namespace noisepage::execution::sql
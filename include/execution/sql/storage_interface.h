@@ -102,13 +102,20 @@ namespace sql {
         bool IndexInsertUnique();
 
         /**
-         * Insert into the current index given a tuple
+         * Stage the current index PR for a bulk build of the current index, used by CREATE INDEX. The staged keys
+         * become part of the index in IndexBuildFinish().
          * @param table_tuple_slot tuple slot
          * @param unique if this insertion is unique
          * @return Whether insertion was successful.
          */
         bool IndexInsertWithTuple(storage::TupleSlot table_tuple_slot, bool unique);
 
+        /**
+         * Build the current index from all keys staged through IndexInsertWithTuple().
+         * @return False if the index is unique and a key was staged twice, true otherwise.
+         */
+        bool IndexBuildFinish();
+
         /**
          * @returns index heap size
          */
@@ -90,6 +90,16 @@ public:
      */
     bool Advance();
 
+    /**
+     * Restrict the scan to tuples whose value in the given column lies in [min, max], letting the iterator skip blocks
+     * whose zone maps rule out every such tuple. This does not filter the tuples of the blocks that are read. It is a
+     * no-op unless the iterator is initialized and the column is a fixed-length integer, date or timestamp column.
+     * @param col_oid OID of the column whose values are restricted.
+     * @param min Smallest value of the range, inclusive.
+     * @param max Largest value of the range, inclusive.
+     */
+    void AddBlockFilter(uint32_t col_oid, int64_t min, int64_t max);
+
     /**
      * @return True if the iterator has been initialized; false otherwise.
      */
@@ -157,6 +167,9 @@ private:
 
     VectorProjection vector_projection_;
 
+    // Value ranges that blocks are skipped for if their zone maps do not overlap them.
+    std::vector<storage::ZoneMapFilter> block_filters_;
+
     // An iterator over the currently active projection.
     VectorProjectionIterator vector_projection_iterator_;
 
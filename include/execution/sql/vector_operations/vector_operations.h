@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <vector>
 
 #include "common/constants.h"
 #include "execution/sql/generic_value.h"
@@ -339,6 +340,16 @@ public:
      */
     static void HashCombine(const Vector &input, Vector *result);
 
+    /**
+     * Hash the elements of the first vector in @em inputs, and combine the result with the hashes of the elements of
+     * each remaining vector in turn, storing the final hashes in @em result. Equivalent to calling VectorOps::Hash()
+     * on the first vector and VectorOps::HashCombine() on the rest, but the elements to hash are only collected once.
+     * @pre All input vectors must have the same size and the same filtered TID list.
+     * @param inputs The vectors to hash, which must not be empty.
+     * @param[out] result The vector where hash results are stored.
+     */
+    static void Hash(const std::vector<const Vector *> &inputs, Vector *result);
+
     // -------------------------------------------------------
     //
     // Gather / Scatter
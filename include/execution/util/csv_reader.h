@@ -1,7 +1,6 @@
 #pragma once
 
-#if 0
-#include <charconv> // TODO(WAN): charconv missing on Ubuntu 18.04
+#include <charconv>
 #include <memory>
 #include <string>
 #include <vector>
@@ -358,4 +357,3 @@ class CSVReader {
 };
 
 }  // namespace noisepage::execution::util
-#endif
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common/macros.h"
+#include "storage/varlen_entry.h"
+
+namespace noisepage::execution::util {
+
+/**
+ * Utility class containing vectorized string kernels. Every kernel has a scalar implementation and one or more SIMD
+ * implementations (SSE4.2, AVX2, AVX-512). The widest implementation the CPU supports, as reported by CpuInfo, is
+ * picked on first use, so binaries stay correct on machines narrower than the one they were built on.
+ *
+ * Case conversions are ASCII-only: bytes outside 'A'-'Z' and 'a'-'z' are copied unchanged.
+ */
+class StringUtil {
+public:
+    /** This class cannot be instantiated. */
+    DISALLOW_INSTANTIATION(StringUtil);
+    /** This class cannot be copied or moved. */
+    DISALLOW_COPY_AND_MOVE(StringUtil);
+
+    /**
+     * Find the first occurrence of @em needle in @em haystack.
+     * @param haystack The string to search in.
+     * @param haystack_len The length of the string to search in, in bytes.
+     * @param needle The string to search for.
+     * @param needle_len The length of the string to search for, in bytes.
+     * @return A pointer to the first occurrence of @em needle in @em haystack, or nullptr if there is none. An empty
+     *         needle is found at the start of the haystack.
+     */
+    static const char *Find(const char *haystack, std::size_t haystack_len, const char *needle, std::size_t needle_len);
+
+    /**
+     * Convert the ASCII upper case letters in @em src to lower case, writing the result into @em dst.
+     * @param src The input string.
+     * @param len The length of the input string, in bytes.
+     * @param[out] dst The output buffer, which must hold at least @em len bytes. May alias @em src.
+     */
+    static void ToLower(const char *src, std::size_t len, char *dst);
+
+    /**
+     * Convert the ASCII lower case letters in @em src to upper case, writing the result into @em dst.
+     * @param src The input string.
+     * @param len The length of the input string, in bytes.
+     * @param[out] dst The output buffer, which must hold at least @em len bytes. May alias @em src.
+     */
+    static void ToUpper(const char *src, std::size_t len, char *dst);
+
+    /**
+     * Compare the size and the inlined prefix of each of the @em num_entries strings in @em entries with those of
+     * @em key, and set the corresponding bit in @em bit_vector when both match. Only the first eight bytes of each
+     * entry are read, so entries may be NULL or unselected.
+     *
+     * A set bit means the string may equal @em key; a clear bit means it definitely does not. When @em key is no
+     * longer than VarlenEntry::PrefixSize(), a set bit means the string equals @em key.
+     *
+     * @param entries The strings to compare.
+     * @param num_entries The number of strings to compare.
+     * @param key The string to compare against.
+     * @param[out] bit_vector The output bit vector, which must have room for @em num_entries bits. Bits past
+     *                        @em num_entries in the last word are cleared.
+     */
+    static void MatchSizeAndPrefix(const storage::VarlenEntry *entries,
+                                   uint32_t                    num_entries,
+                                   const storage::VarlenEntry &key,
+                                   uint64_t                   *bit_vector);
+};
+
+} // namespace noisepage::execution::util
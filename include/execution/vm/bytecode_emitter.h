@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
+#include <utility>
 #include <vector>
 
 #include "execution/vm/bytecode_function_info.h"
@@ -19,9 +21,11 @@ public:
      * Construct a bytecode emitter instance that encodes and writes bytecode instructions into the
      * provided bytecode vector.
      * @param bytecode The bytecode array to emit bytecode into.
+     * @param use_superinstructions Whether to fuse adjacent bytecodes into superinstructions.
      */
-    explicit BytecodeEmitter(std::vector<uint8_t> *bytecode)
-        : bytecode_(bytecode) {
+    explicit BytecodeEmitter(std::vector<uint8_t> *bytecode, bool use_superinstructions = true)
+        : bytecode_(bytecode)
+        , use_superinstructions_(use_superinstructions) {
         NOISEPAGE_ASSERT(bytecode_ != nullptr, "NULL bytecode pointer provided to emitter");
     }
 
@@ -399,6 +403,9 @@ public:
     /** Emit code to move thread-local data into main agg table. */
     void EmitAggHashTableMovePartitions(LocalVar agg_ht, LocalVar tls, LocalVar aht_offset, FunctionId merge_part_fn);
 
+    /** Emit code to merge the overflow partitions of a serial agg table back into it. */
+    void EmitAggHashTableMergeOverflowPartitions(LocalVar agg_ht, LocalVar context, FunctionId merge_part_fn);
+
     /** Emit code to scan an agg table in parallel. */
     void
     EmitAggHashTableParallelPartitionedScan(LocalVar agg_ht, LocalVar context, LocalVar tls, FunctionId scan_part_fn);
@@ -564,10 +571,8 @@ private:
         *reinterpret_cast<T *>(&*(bytecode_->end() - sizeof(T))) = val;
     }
 
-    /** Emit a bytecode */
-    void EmitImpl(const Bytecode bytecode) {
-        EmitScalarValue(Bytecodes::ToByte(bytecode));
-    }
+    /** Emit a bytecode, fusing it with the previous instruction if they form a superinstruction */
+    void EmitImpl(Bytecode bytecode);
 
     /** Emit a local variable reference by encoding it into the bytecode stream */
     void EmitImpl(const LocalVar local) {
@@ -591,6 +596,10 @@ private:
 
 private:
     std::vector<uint8_t> *bytecode_;
+    // Whether to fuse adjacent bytecodes into superinstructions
+    bool use_superinstructions_;
+    // The last bytecode emitted and its position, if the next bytecode may still be fused with it
+    std::optional<std::pair<Bytecode, std::size_t>> last_instruction_;
 };
 
 } // namespace noisepage::execution::vm
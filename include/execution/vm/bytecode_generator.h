@@ -49,9 +49,12 @@ public:
      * Main entry point to convert a valid (i.e., parsed and type-checked) AST into a bytecode module.
      * @param root The root of the AST.
      * @param name The (optional) name of the program.
+     * @param use_superinstructions Whether to fuse frequent bytecode pairs into superinstructions.
      * @return A compiled bytecode module.
      */
-    static std::unique_ptr<BytecodeModule> Compile(ast::AstNode *root, const std::string &name);
+    static std::unique_ptr<BytecodeModule> Compile(ast::AstNode      *root,
+                                                   const std::string &name,
+                                                   bool               use_superinstructions = true);
 
     /**
      * @return The emitter used by this generator to write bytecode.
@@ -62,7 +65,7 @@ public:
 
 private:
     // Private constructor to force users to call Compile()
-    BytecodeGenerator() noexcept;
+    explicit BytecodeGenerator(bool use_superinstructions) noexcept;
 
     class ExpressionResultScope;
     class LValueResultScope;
@@ -396,6 +396,13 @@ VM_OP_HOT void OpTableVectorIteratorGetVPI(noisepage::execution::sql::VectorProj
     *vpi = iter->GetVectorProjectionIterator();
 }
 
+VM_OP_HOT void OpTableVectorIteratorAddBlockFilter(noisepage::execution::sql::TableVectorIterator *iter,
+                                                   uint32_t                                        col_oid,
+                                                   int64_t                                         min,
+                                                   int64_t                                         max) {
+    iter->AddBlockFilter(col_oid, min, max);
+}
+
 VM_OP_HOT void OpParallelScanTable(uint32_t                                                     table_oid,
                                    uint32_t                                                    *col_oids,
                                    uint32_t                                                     num_oids,
@@ -1041,6 +1048,13 @@ VM_OP void OpAggregationHashTableMergePartitions(
     void                                                             *query_state,
     noisepage::execution::sql::AggregationHashTable::MergePartitionFn merge_partition_fn);
 
+VM_OP_HOT void OpAggregationHashTableMergeOverflowPartitions(
+    noisepage::execution::sql::AggregationHashTable *const                  agg_hash_table,
+    void *const                                                             query_state,
+    const noisepage::execution::sql::AggregationHashTable::MergePartitionFn merge_partition_fn) {
+    agg_hash_table->MergeOverflowPartitions(query_state, merge_partition_fn);
+}
+
 VM_OP_HOT void OpAggregationHashTableParallelPartitionedScan(
     noisepage::execution::sql::AggregationHashTable *const                 agg_hash_table,
     void *const                                                            query_state,
@@ -1600,6 +1614,11 @@ VM_OP_HOT void OpSorterGetTupleCount(uint32_t *result, noisepage::execution::sql
     *result = sorter->GetTupleCount();
 }
 
+VM_OP_HOT void
+OpSorterGetTupleAt(const noisepage::byte **result, noisepage::execution::sql::Sorter *sorter, const uint32_t idx) {
+    *result = sorter->GetTupleAt(idx);
+}
+
 VM_OP_HOT void OpSorterAllocTuple(noisepage::byte **result, noisepage::execution::sql::Sorter *sorter) {
     *result = sorter->AllocInputTuple();
 }
@@ -2400,6 +2419,9 @@ VM_OP void OpStorageInterfaceIndexInsertWithSlot(bool
                                                  noisepage::storage::TupleSlot               *tuple_slot,
                                                  bool                                         unique);
 
+VM_OP void OpStorageInterfaceIndexBuildFinish(bool                                        *result,
+                                              noisepage::execution::sql::StorageInterface *storage_interface);
+
 VM_OP void OpStorageInterfaceIndexDelete(noisepage::execution::sql::StorageInterface *storage_interface,
                                          noisepage::storage::TupleSlot               *tuple_slot);
 
@@ -87,6 +87,13 @@ public:
      */
     std::size_t GetInstructionCount() const;
 
+    /**
+     * @return The size (in bytes) of the bytecode and the static data of this module.
+     */
+    std::size_t GetBytecodeSize() const {
+        return code_.size() + data_.size();
+    }
+
     /**
      * @return The name of the module.
      */
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <type_traits>
+#include <vector>
+
+#include "execution/vm/bytecodes.h"
+
+namespace noisepage::execution::vm {
+
+/**
+ * Dynamic bytecode frequencies gathered by the interpreter. Every dispatch counts the bytecode dispatched and the pair
+ * it forms with the bytecode dispatched just before it in the same frame. Frequent pairs are candidates for new
+ * superinstructions (see SUPERINSTRUCTION_LIST).
+ *
+ * Counting costs two atomic increments per dispatch, so the VM only records dispatches when built with
+ * NOISEPAGE_PROFILE_BYTECODES. Counts are shared by all threads and accumulate until Reset() is called.
+ */
+class BytecodeProfile {
+public:
+    /** The encoded value to record as the previous bytecode when there is none, i.e., at function entry. */
+    static constexpr const std::underlying_type_t<Bytecode> NO_BYTECODE = Bytecodes::BYTECODE_COUNT;
+
+    /**
+     * A pair of bytecodes and how often the second was dispatched right after the first.
+     */
+    struct PairCount {
+        /** The bytecode dispatched first. */
+        Bytecode first_;
+        /** The bytecode dispatched right after. */
+        Bytecode second_;
+        /** The number of times the pair was dispatched. */
+        uint64_t count_;
+    };
+
+    /**
+     * @return True if the VM was built to record dispatches; false otherwise.
+     */
+    static constexpr bool IsEnabled() {
+#ifdef NOISEPAGE_PROFILE_BYTECODES
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Record the dispatch of the bytecode @em curr right after @em prev. Both are encoded bytecodes, as read from the
+     * instruction stream.
+     * @param prev The previously dispatched bytecode, or NO_BYTECODE if there is none.
+     * @param curr The bytecode being dispatched.
+     */
+    static void Record(std::underlying_type_t<Bytecode> prev, std::underlying_type_t<Bytecode> curr);
+
+    /**
+     * @return The number of times the bytecode @em bytecode was dispatched.
+     */
+    static uint64_t GetCount(Bytecode bytecode);
+
+    /**
+     * @return The number of times the bytecode @em second was dispatched right after @em first.
+     */
+    static uint64_t GetPairCount(Bytecode first, Bytecode second);
+
+    /**
+     * @return The total number of dispatches.
+     */
+    static uint64_t GetTotalCount();
+
+    /**
+     * Collect the most frequent pairs of bytecodes that could still be fused. Pairs that already have a
+     * superinstruction and pairs starting with a jump or a return are left out.
+     * @param limit The maximum number of pairs to return.
+     * @return The pairs, most frequent first.
+     */
+    static std::vector<PairCount> GetTopPairs(std::size_t limit);
+
+    /**
+     * Print the total dispatch count and the @em limit most frequent fusion candidates to @em os.
+     * @param os The stream to print to.
+     * @param limit The maximum number of pairs to print.
+     */
+    static void Dump(std::ostream &os, std::size_t limit);
+
+    /**
+     * Clear all counts.
+     */
+    static void Reset();
+};
+
+} // namespace noisepage::execution::vm
@@ -151,6 +151,11 @@ namespace noisepage::execution::vm {
     F(TableVectorIteratorFree, OperandType::Local)                                                                     \
     F(TableVectorIteratorGetVPINumTuples, OperandType::Local, OperandType::Local)                                      \
     F(TableVectorIteratorGetVPI, OperandType::Local, OperandType::Local)                                               \
+    F(TableVectorIteratorAddBlockFilter,                                                                               \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local)                                                                                              \
     F(ParallelScanTable,                                                                                               \
       OperandType::Local,                                                                                              \
       OperandType::Local,                                                                                              \
@@ -491,6 +496,10 @@ namespace noisepage::execution::vm {
       OperandType::Local,                                                                                              \
       OperandType::Local,                                                                                              \
       OperandType::FunctionId)                                                                                         \
+    F(AggregationHashTableMergeOverflowPartitions,                                                                     \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::FunctionId)                                                                                         \
     F(AggregationHashTableParallelPartitionedScan,                                                                     \
       OperandType::Local,                                                                                              \
       OperandType::Local,                                                                                              \
@@ -697,6 +706,7 @@ namespace noisepage::execution::vm {
     /* Sorting */                                                                                                      \
     F(SorterInit, OperandType::Local, OperandType::Local, OperandType::FunctionId, OperandType::Local)                 \
     F(SorterGetTupleCount, OperandType::Local, OperandType::Local)                                                     \
+    F(SorterGetTupleAt, OperandType::Local, OperandType::Local, OperandType::Local)                                    \
     F(SorterAllocTuple, OperandType::Local, OperandType::Local)                                                        \
     F(SorterAllocTupleTopK, OperandType::Local, OperandType::Local, OperandType::Local)                                \
     F(SorterAllocTupleTopKFinish, OperandType::Local, OperandType::Local)                                              \
@@ -814,6 +824,7 @@ namespace noisepage::execution::vm {
       OperandType::Local,                                                                                              \
       OperandType::Local,                                                                                              \
       OperandType::Local)                                                                                              \
+    F(StorageInterfaceIndexBuildFinish, OperandType::Local, OperandType::Local)                                        \
     F(StorageInterfaceIndexDelete, OperandType::Local, OperandType::Local)                                             \
     F(StorageInterfaceFree, OperandType::Local)                                                                        \
                                                                                                                        \
@@ -930,6 +941,131 @@ namespace noisepage::execution::vm {
     F(GetParamTimestampVal, OperandType::Local, OperandType::Local, OperandType::Local)                                \
     F(GetParamString, OperandType::Local, OperandType::Local, OperandType::Local)                                      \
                                                                                                                        \
+    /* Superinstructions, see SUPERINSTRUCTION_LIST */                                                                 \
+    CREATE_FOR_INT_TYPES(F,                                                                                            \
+                         GreaterThanJumpIfFalse,                                                                       \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::JumpOffset)                                                                      \
+    CREATE_FOR_INT_TYPES(F,                                                                                            \
+                         GreaterThanEqualJumpIfFalse,                                                                  \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::JumpOffset)                                                                      \
+    CREATE_FOR_INT_TYPES(F,                                                                                            \
+                         EqualJumpIfFalse,                                                                             \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::JumpOffset)                                                                      \
+    CREATE_FOR_INT_TYPES(F,                                                                                            \
+                         LessThanJumpIfFalse,                                                                          \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::JumpOffset)                                                                      \
+    CREATE_FOR_INT_TYPES(F,                                                                                            \
+                         LessThanEqualJumpIfFalse,                                                                     \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::JumpOffset)                                                                      \
+    CREATE_FOR_INT_TYPES(F,                                                                                            \
+                         NotEqualJumpIfFalse,                                                                          \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::Local,                                                                           \
+                         OperandType::JumpOffset)                                                                      \
+    F(VPIHasNextJumpIfFalse, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::JumpOffset)      \
+    F(VPIHasNextFilteredJumpIfFalse,                                                                                   \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::JumpOffset)                                                                                         \
+    F(AggregationHashTableIteratorHasNextJumpIfFalse,                                                                  \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::JumpOffset)                                                                                         \
+    F(HashTableEntryIteratorHasNextJumpIfFalse,                                                                        \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::JumpOffset)                                                                                         \
+    F(JoinHashTableIteratorHasNextJumpIfFalse,                                                                         \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::JumpOffset)                                                                                         \
+    F(ForceBoolTruthJumpIfFalse, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::JumpOffset)  \
+    F(VPIAdvanceJump, OperandType::Local, OperandType::JumpOffset)                                                     \
+    F(VPIAdvanceFilteredJump, OperandType::Local, OperandType::JumpOffset)                                             \
+    F(VPIGetIntegerHashInt,                                                                                            \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::UImm4,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local)                                                                                              \
+    F(VPIGetIntegerNullHashInt,                                                                                        \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::UImm4,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local)                                                                                              \
+    F(VPIGetBigIntHashInt,                                                                                             \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::UImm4,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local)                                                                                              \
+    F(VPIGetBigIntNullHashInt,                                                                                         \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::UImm4,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local)                                                                                              \
+    F(VPIGetDateHashDate,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::UImm4,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local)                                                                                              \
+    F(VPIGetDateNullHashDate,                                                                                          \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::UImm4,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local)                                                                                              \
+    F(VPIGetStringHashString,                                                                                          \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::UImm4,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local)                                                                                              \
+    F(VPIGetStringNullHashString,                                                                                      \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::UImm4,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local,                                                                                              \
+      OperandType::Local)                                                                                              \
+                                                                                                                       \
+                                                                                                                       \
     /* FOR TESTING ONLY */                                                                                             \
     F(TestCatalogLookup,                                                                                               \
       OperandType::Local,                                                                                              \
@@ -940,6 +1076,52 @@ namespace noisepage::execution::vm {
       OperandType::UImm4)                                                                                              \
     F(TestCatalogIndexLookup, OperandType::Local, OperandType::Local, OperandType::StaticLocal, OperandType::UImm4)
 
+// Creates superinstructions fusing an integer-typed opcode with the given second bytecode
+#define FUSE_FOR_INT_TYPES(F, op, second)                                                                              \
+    F(op##second##_int8_t, op##_int8_t, second)                                                                        \
+    F(op##second##_int16_t, op##_int16_t, second)                                                                      \
+    F(op##second##_int32_t, op##_int32_t, second)                                                                      \
+    F(op##second##_int64_t, op##_int64_t, second)                                                                      \
+    F(op##second##_uint8_t, op##_uint8_t, second)                                                                      \
+    F(op##second##_uint16_t, op##_uint16_t, second)                                                                    \
+    F(op##second##_uint32_t, op##_uint32_t, second)                                                                    \
+    F(op##second##_uint64_t, op##_uint64_t, second)
+
+/**
+ * The list of superinstructions. A superinstruction fuses a frequent pair of bytecodes into a single instruction,
+ * saving the dispatch in between. Each entry is F(superinstruction, first bytecode, second bytecode). The operands of
+ * a superinstruction are those of its first bytecode followed by those of its second, so it behaves exactly like the
+ * pair it replaces. The pairs cover the branches, loop headers, loop latches and hash chains the code generator emits
+ * for every pipeline. A bytecode may be the first of at most one pair. Use BytecodeProfile to find candidate pairs.
+ */
+#define SUPERINSTRUCTION_LIST(F)                                                                                       \
+    /* Compare and branch on the result */                                                                             \
+    FUSE_FOR_INT_TYPES(F, GreaterThan, JumpIfFalse)                                                                    \
+    FUSE_FOR_INT_TYPES(F, GreaterThanEqual, JumpIfFalse)                                                               \
+    FUSE_FOR_INT_TYPES(F, Equal, JumpIfFalse)                                                                          \
+    FUSE_FOR_INT_TYPES(F, LessThan, JumpIfFalse)                                                                       \
+    FUSE_FOR_INT_TYPES(F, LessThanEqual, JumpIfFalse)                                                                  \
+    FUSE_FOR_INT_TYPES(F, NotEqual, JumpIfFalse)                                                                       \
+    /* Loop headers: test the iterator and leave the loop when it is exhausted */                                      \
+    F(VPIHasNextJumpIfFalse, VPIHasNext, JumpIfFalse)                                                                  \
+    F(VPIHasNextFilteredJumpIfFalse, VPIHasNextFiltered, JumpIfFalse)                                                  \
+    F(AggregationHashTableIteratorHasNextJumpIfFalse, AggregationHashTableIteratorHasNext, JumpIfFalse)                \
+    F(HashTableEntryIteratorHasNextJumpIfFalse, HashTableEntryIteratorHasNext, JumpIfFalse)                            \
+    F(JoinHashTableIteratorHasNextJumpIfFalse, JoinHashTableIteratorHasNext, JumpIfFalse)                              \
+    F(ForceBoolTruthJumpIfFalse, ForceBoolTruth, JumpIfFalse)                                                          \
+    /* Loop latches: advance the iterator and jump back to the loop header */                                          \
+    F(VPIAdvanceJump, VPIAdvance, Jump)                                                                                \
+    F(VPIAdvanceFilteredJump, VPIAdvanceFiltered, Jump)                                                                \
+    /* Hash chains: read a column and fold it into the running hash */                                                 \
+    F(VPIGetIntegerHashInt, VPIGetInteger, HashInt)                                                                    \
+    F(VPIGetIntegerNullHashInt, VPIGetIntegerNull, HashInt)                                                            \
+    F(VPIGetBigIntHashInt, VPIGetBigInt, HashInt)                                                                      \
+    F(VPIGetBigIntNullHashInt, VPIGetBigIntNull, HashInt)                                                              \
+    F(VPIGetDateHashDate, VPIGetDate, HashDate)                                                                        \
+    F(VPIGetDateNullHashDate, VPIGetDateNull, HashDate)                                                                \
+    F(VPIGetStringHashString, VPIGetString, HashString)                                                                \
+    F(VPIGetStringNullHashString, VPIGetStringNull, HashString)
+
 /**
  * The enumeration listing all possible bytecode instructions.
  */
@@ -1054,6 +1236,9 @@ public:
      * @return True if the bytecode @em bytecode is an unconditional jump; false otherwise.
      */
     static constexpr bool IsUnconditionalJump(Bytecode bytecode) {
+        if (IsSuperinstruction(bytecode)) {
+            return IsUnconditionalJump(GetSuperinstructionSecond(bytecode));
+        }
         return bytecode == Bytecode::Jump;
     }
 
@@ -1061,6 +1246,9 @@ public:
      * @return True if the bytecode @em bytecode is a conditional jump; false otherwise.
      */
     static constexpr bool IsConditionalJump(Bytecode bytecode) {
+        if (IsSuperinstruction(bytecode)) {
+            return IsConditionalJump(GetSuperinstructionSecond(bytecode));
+        }
         return bytecode == Bytecode::JumpIfFalse || bytecode == Bytecode::JumpIfTrue;
     }
 
@@ -1087,6 +1275,70 @@ public:
         return IsJump(bytecode) || IsReturn(bytecode);
     }
 
+    /**
+     * @return The index of the jump offset operand of the jump instruction @em bytecode. Jump offsets are always the
+     *         last operand of an instruction.
+     */
+    static uint32_t GetJumpOffsetOperandIndex(Bytecode bytecode) {
+        NOISEPAGE_ASSERT(IsJump(bytecode), "Bytecode is not a jump");
+        return NumOperands(bytecode) - 1;
+    }
+
+    /**
+     * @return True if the bytecode @em bytecode is a superinstruction; false otherwise.
+     */
+    static constexpr bool IsSuperinstruction(Bytecode bytecode) {
+        switch (bytecode) {
+#define ENTRY(name, ...) case Bytecode::name:
+            SUPERINSTRUCTION_LIST(ENTRY)
+#undef ENTRY
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * @return The first of the two bytecodes fused into the superinstruction @em bytecode.
+     */
+    static constexpr Bytecode GetSuperinstructionFirst(Bytecode bytecode) {
+        switch (bytecode) {
+#define ENTRY(name, first, second)                                                                                     \
+    case Bytecode::name:                                                                                               \
+        return Bytecode::first;
+            SUPERINSTRUCTION_LIST(ENTRY)
+#undef ENTRY
+        default:
+            NOISEPAGE_ASSERT(false, "Bytecode is not a superinstruction");
+            return bytecode;
+        }
+    }
+
+    /**
+     * @return The second of the two bytecodes fused into the superinstruction @em bytecode.
+     */
+    static constexpr Bytecode GetSuperinstructionSecond(Bytecode bytecode) {
+        switch (bytecode) {
+#define ENTRY(name, first, second)                                                                                     \
+    case Bytecode::name:                                                                                               \
+        return Bytecode::second;
+            SUPERINSTRUCTION_LIST(ENTRY)
+#undef ENTRY
+        default:
+            NOISEPAGE_ASSERT(false, "Bytecode is not a superinstruction");
+            return bytecode;
+        }
+    }
+
+    /**
+     * Look up the superinstruction fusing the bytecode @em first followed by the bytecode @em second.
+     * @param first The first bytecode of the pair.
+     * @param second The second bytecode of the pair.
+     * @param[out] fused The superinstruction, if there is one.
+     * @return True if the pair has a superinstruction; false otherwise.
+     */
+    static bool Fuse(Bytecode first, Bytecode second, Bytecode *fused);
+
 private:
     static const char        *bytecode_names[];
     static uint32_t           bytecode_operand_counts[];
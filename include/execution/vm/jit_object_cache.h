@@ -0,0 +1,175 @@
+#pragma once
+
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex> // NOLINT
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/macros.h"
+
+namespace noisepage::execution::vm {
+
+/**
+ * A persistent cache of JIT-compiled object files.
+ *
+ * Every object is stored under a key that identifies everything its machine code depends on: the bytecode module it
+ * was compiled from and the environment it was compiled in (LLVM version, target, host CPU and its features, bytecode
+ * handlers). Objects are kept in memory and written to one file per key in the cache directory, so a restarted
+ * process can load them instead of compiling the same modules again. Warmup() loads the directory into memory.
+ *
+ * The total size of the cached objects is bounded. Once the bound is reached, the least recently used objects are
+ * evicted from memory and removed from the directory. The directory may be shared by several processes: files are
+ * written to a temporary name and renamed into place, and files that are damaged or of another format are removed.
+ */
+class JitObjectCache {
+public:
+    /** The version of the file format. Bump it whenever the format or the generated code changes. */
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    /** The extension of cached object files. */
+    static constexpr std::string_view FILE_EXTENSION = ".tplo";
+
+    /**
+     * A cached object, as returned by Lookup().
+     */
+    struct CachedObject {
+        /** The object code. */
+        std::unique_ptr<llvm::MemoryBuffer> object_;
+        /** The names of the object's symbols for the functions of the module, in function ID order. */
+        std::vector<std::string> symbols_;
+        /** The time it took to compile the object, in microseconds. */
+        uint64_t compile_us_;
+    };
+
+    /**
+     * Create a cache. No files are read until Warmup() is called.
+     * @param directory The directory in which to store the cached objects. It is created if it does not exist.
+     * @param max_size_bytes The maximum total size of the cached objects.
+     * @param environment Everything other than the bytecode module that the generated machine code depends on. It
+     *                    is mixed into every key.
+     */
+    JitObjectCache(std::string directory, uint64_t max_size_bytes, std::string environment);
+
+    /**
+     * This class cannot be copied or moved.
+     */
+    DISALLOW_COPY_AND_MOVE(JitObjectCache);
+
+    /**
+     * Load every valid object in the cache directory into memory, most recently used first, until the cache is full.
+     * Objects that do not fit and files that are damaged or of another format are removed.
+     * @return The number of objects loaded.
+     */
+    uint32_t Warmup();
+
+    /**
+     * @param module_fingerprint A description of the bytecode module that determines its machine code.
+     * @return The key under which the module's object is cached in this cache's environment.
+     */
+    std::string MakeKey(std::string_view module_fingerprint) const;
+
+    /**
+     * Look up an object.
+     * @param key The key of the object.
+     * @param[out] result A copy of the cached object, if there is one.
+     * @return True if the object is cached; false otherwise.
+     */
+    bool Lookup(const std::string &key, CachedObject *result);
+
+    /**
+     * Add an object to the cache and write it to the cache directory, evicting the least recently used objects if the
+     * cache is full. Objects larger than the cache are not cached.
+     * @param key The key of the object.
+     * @param object The object code.
+     * @param symbols The names of the object's symbols for the functions of the module, in function ID order.
+     * @param compile_us The time it took to compile the object, in microseconds.
+     */
+    void Store(const std::string              &key,
+               const llvm::MemoryBuffer       &object,
+               const std::vector<std::string> &symbols,
+               uint64_t                        compile_us);
+
+    /**
+     * Remove an object from the cache and the cache directory.
+     * @param key The key of the object.
+     */
+    void Erase(const std::string &key);
+
+    /** @return The directory in which the cached objects are stored. */
+    const std::string &GetDirectory() const {
+        return directory_;
+    }
+
+    /** @return The maximum total size of the cached objects. */
+    uint64_t GetMaxSizeInBytes() const {
+        return max_size_bytes_;
+    }
+
+    /** @return The total size of the cached objects. */
+    uint64_t GetSizeInBytes() {
+        std::lock_guard<std::mutex> guard(latch_);
+        return size_bytes_;
+    }
+
+    /** @return The number of cached objects. */
+    uint64_t GetNumObjects() {
+        std::lock_guard<std::mutex> guard(latch_);
+        return entries_.size();
+    }
+
+    /** @return The number of lookups that found an object. */
+    uint64_t GetNumHits() const {
+        return num_hits_.load(std::memory_order_relaxed);
+    }
+
+    /** @return The number of lookups that did not find an object. */
+    uint64_t GetNumMisses() const {
+        return num_misses_.load(std::memory_order_relaxed);
+    }
+
+    /** @return The total compile time of the objects returned by lookups, in microseconds. */
+    uint64_t GetCompileTimeSavedUs() const {
+        return compile_us_saved_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Entry {
+        // The object file contents: header, symbols and object code
+        std::string contents_;
+        // Where the object code starts in the contents
+        uint64_t object_offset_;
+        std::vector<std::string> symbols_;
+        uint64_t                 compile_us_;
+        // Position in the LRU list
+        std::list<std::string>::iterator lru_pos_;
+    };
+
+    // Path of the file of the object with the given key
+    std::string FilePath(const std::string &key) const;
+
+    // Remove the given files, ignoring errors
+    static void RemoveFiles(const std::vector<std::string> &files);
+
+    const std::string directory_;
+    const uint64_t    max_size_bytes_;
+    const std::string environment_;
+
+    std::mutex                             latch_;
+    std::unordered_map<std::string, Entry> entries_;
+    // Keys of the cached objects, most recently used first
+    std::list<std::string> lru_;
+    uint64_t               size_bytes_ = 0;
+
+    std::atomic<uint64_t> num_hits_{0};
+    std::atomic<uint64_t> num_misses_{0};
+    std::atomic<uint64_t> compile_us_saved_{0};
+    std::atomic<uint64_t> num_temp_files_{0};
+};
+
+} // namespace noisepage::execution::vm
@@ -6,9 +6,11 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "common/macros.h"
 #include "execution/util/execution_common.h"
+#include "execution/vm/jit_object_cache.h"
 
 namespace noisepage::execution::ast {
 class Type;
@@ -131,10 +133,28 @@ public:
             return output_file_name_;
         }
 
+        /**
+         * Set the optimization level
+         * @param opt_level the optimization level, from 0 (no optimizations) to 3 (all optimizations)
+         * @return the updated object
+         */
+        CompilerOptions &SetOptLevel(uint32_t opt_level) {
+            opt_level_ = opt_level;
+            return *this;
+        }
+
+        /**
+         * @return the optimization level
+         */
+        uint32_t GetOptLevel() const {
+            return opt_level_;
+        }
+
     private:
         bool        debug_{false};
         bool        write_obj_file_{false};
         std::string output_file_name_;
+        uint32_t    opt_level_{3};
     };
 
     // -------------------------------------------------------
@@ -161,6 +181,14 @@ public:
          */
         explicit CompiledModule(std::unique_ptr<llvm::MemoryBuffer> object_code);
 
+        /**
+         * Construct a compiled module using the provided shared object file, whose symbols for the functions of the
+         * module have the given names rather than the names of the functions.
+         * @param object_code The object file containing code for this module.
+         * @param symbols The names of the symbols for the functions of the module, in function ID order.
+         */
+        CompiledModule(std::unique_ptr<llvm::MemoryBuffer> object_code, std::vector<std::string> symbols);
+
         /**
          * This class cannot be copied or moved
          */
@@ -185,6 +213,13 @@ public:
             return object_code_->getBufferSize();
         }
 
+        /**
+         * @return The module's object code.
+         */
+        const llvm::MemoryBuffer &GetObjectCode() const {
+            return *object_code_;
+        }
+
         /**
          * Load the given module @em module into memory. If this module has already
          * been loaded, it will not be reloaded.
@@ -201,6 +236,7 @@ public:
     private:
         bool                                    loaded_;
         std::unique_ptr<llvm::MemoryBuffer>     object_code_;
+        std::vector<std::string>                symbols_;
         std::unique_ptr<TPLMemoryManager>       memory_manager_;
         std::unordered_map<std::string, void *> functions_;
     };
@@ -217,9 +253,15 @@ public:
         /**
          * Construct a settings instance from the relevant configuration parameters.
          * @param bytecode_handlers_path The path to the bytecode handlers bitcode file.
+         * @param jit_cache_directory The directory of the compiled object cache; empty to disable the cache.
+         * @param jit_cache_size The maximum total size of the compiled object cache in bytes.
          */
-        explicit Settings(std::string_view bytecode_handlers_path)
-            : bytecode_handlers_path_{bytecode_handlers_path} {}
+        explicit Settings(std::string_view bytecode_handlers_path,
+                          std::string_view jit_cache_directory = "",
+                          uint64_t         jit_cache_size = 0)
+            : bytecode_handlers_path_{bytecode_handlers_path}
+            , jit_cache_directory_{jit_cache_directory}
+            , jit_cache_size_{jit_cache_size} {}
 
         /**
          * @return The path to the bytecode handlers bitcode file.
@@ -228,8 +270,24 @@ public:
             return bytecode_handlers_path_;
         }
 
+        /**
+         * @return The directory of the compiled object cache; empty if the cache is disabled.
+         */
+        const std::string &GetJitCacheDirectory() const noexcept {
+            return jit_cache_directory_;
+        }
+
+        /**
+         * @return The maximum total size of the compiled object cache in bytes.
+         */
+        uint64_t GetJitCacheSize() const noexcept {
+            return jit_cache_size_;
+        }
+
     private:
         const std::string bytecode_handlers_path_;
+        const std::string jit_cache_directory_;
+        const uint64_t    jit_cache_size_;
     };
 
     // -------------------------------------------------------
@@ -260,6 +318,18 @@ public:
      *   the LLVMEngine because that is the natural ownership relationship
      */
     inline static std::unique_ptr<const Settings> engine_settings; // NOLINT
+
+    /**
+     * Process-wide cache of compiled objects, shared across restarts through the cache directory. Null if the cache
+     * is disabled in the engine settings.
+     */
+    inline static std::unique_ptr<JitObjectCache> object_cache; // NOLINT
+
+private:
+    // Describe everything in the bytecode module that its machine code depends on. The names of functions and locals
+    // are left out, since the compiler makes them unique per query. Compile() records the names of the function
+    // symbols alongside the cached object instead. The options that affect code generation are included.
+    static std::string ModuleFingerprint(const BytecodeModule &module, const CompilerOptions &options);
 };
 
 } // namespace noisepage::execution::vm
@@ -26,10 +26,46 @@ namespace test {
  * They also contain the generated TBC bytecode and their implementations, along with compiled
  * machine-code versions of TPL functions.
  *
+ * In adaptive mode, a module moves up through tiers of implementations as its functions get hot.
+ * It starts out interpreted. The VM profiles every function, counting its invocations and the loop
+ * iterations it interprets. Once a function's count reaches the baseline threshold, the module is
+ * compiled in the background with few optimizations; the baseline code counts invocations through a
+ * small stub in front of each function. Once a count reaches the optimized threshold, the module is
+ * compiled again with all optimizations. Each tier replaces the function pointers of the previous one
+ * atomically, so calls that are in flight finish in the implementation they started in.
+ *
  * Modules are thread-safe.
  */
 class Module {
 public:
+    /**
+     * The tiers of implementations a module moves through in adaptive mode.
+     */
+    enum class Tier : uint8_t {
+        /** Functions are interpreted by the VM. */
+        Interpreted = 0,
+        /** Functions are compiled quickly, with few optimizations. */
+        Baseline = 1,
+        /** Functions are compiled with all optimizations. */
+        Optimized = 2,
+    };
+
+    /**
+     * The profile counts at which a module moves up a tier in adaptive mode.
+     */
+    struct TierThresholds {
+        /** The count at which the module is compiled into the baseline tier. */
+        uint64_t baseline_;
+        /** The count at which the module is compiled into the optimized tier. */
+        uint64_t optimized_;
+    };
+
+    /** The thresholds modules are created with. */
+    static constexpr TierThresholds DEFAULT_TIER_THRESHOLDS{1000, 100000};
+
+    /** The optimization level of the baseline tier. */
+    static constexpr uint32_t BASELINE_OPT_LEVEL = 1;
+
     /**
      * Create a TPL module using the given bytecode module as the initial implementation.
      * @param bytecode_module The bytecode module implementation.
@@ -52,6 +88,39 @@ public:
      */
     DISALLOW_COPY_AND_MOVE(Module);
 
+    /**
+     * Destructor. Waits for background compilation to finish.
+     */
+    ~Module();
+
+    /**
+     * Set the profile counts at which the module moves up a tier in adaptive mode. Must be called before the module's
+     * functions are retrieved.
+     * @param thresholds The new thresholds.
+     */
+    void SetTierThresholds(const TierThresholds &thresholds) {
+        tier_thresholds_ = thresholds;
+    }
+
+    /** @return The tier the module's functions currently run in. */
+    auto GetTier() const -> Tier {
+        return tier_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @param func_id The ID of the function.
+     * @return The profile count of the function: its invocations, plus the loop iterations it interpreted.
+     */
+    auto GetProfileCount(const FunctionId func_id) const -> uint64_t {
+        NOISEPAGE_ASSERT(func_id < bytecode_module_->GetFunctionCount(), "Out-of-bounds function access");
+        return profile_counts_[func_id].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Block until the module is not being compiled in the background.
+     */
+    void WaitForTierUp() const;
+
     /**
      * Look up a TPL function in this module by its ID
      * @return A pointer to the function's info if it exists; null otherwise
@@ -72,7 +141,8 @@ public:
     /**
      * Retrieve and wrap a TPL function inside a C++ function object, thus making the TPL function
      * callable as a C++ function. Callers can request different versions of the TPL code including
-     * an interpreted version and a compiled version.
+     * an interpreted version and a compiled version. In adaptive mode, the module is profiled and
+     * moves up a tier when it gets hot; every retrieval checks whether it should.
      * @tparam Ret Ret The C/C++ return type of the function
      * @tparam ArgTypes ArgTypes The C/C++ argument types to the function
      * @param name The name of the function the caller wants.
@@ -118,6 +188,10 @@ private:
     // This class encapsulates the ability to asynchronously JIT compile a module.
     class AsyncCompileTask;
 
+    // Call the given function through the VM.
+    template <typename Ret, typename... ArgTypes>
+    static auto InvokeInterpreted(Module *module, const FunctionInfo *func_info, ArgTypes... args) -> Ret;
+
     // A trampoline is a stub function that serves as a landing point for all
     // functions executed in interpreted mode. The purpose of the trampoline is
     // to arrange and adjust call arguments from the C/C++ ABI to the TPL ABI.
@@ -163,9 +237,29 @@ private:
     // Compile this module into machine code. This is a blocking call.
     void CompileToMachineCode();
 
-    // Compile this module into machine code. This is a non-blocking call that
-    // triggers a compilation in the background.
-    void CompileToMachineCodeAsync();
+    // Compile this module into baseline machine code behind counting stubs. Only called by the tier-up task.
+    void CompileToBaselineCode();
+
+    // Point every function at the implementation returned by the given function, if the tier is above the current
+    // one.
+    template <typename F>
+    void InstallTier(Tier tier, F impl);
+
+    // Record an interpreted invocation of the function that ran the given number of loop iterations. Called by the VM.
+    void RecordInvocation(FunctionId func_id, uint64_t loop_iterations);
+
+    // The highest profile count of any function.
+    auto GetMaxProfileCount() const -> uint64_t;
+
+    // The tier the given profile count calls for, or the current tier if there is no higher one.
+    auto NextTier(uint64_t profile_count) const -> Tier;
+
+    // Start compiling the tier the given profile count calls for in the background, unless the module is already at
+    // that tier or being compiled. This is a non-blocking call.
+    void MaybeTierUp(uint64_t profile_count);
+
+    // Compile the given tier and any higher one the profile reached meanwhile. Runs in the background.
+    void TierUp(Tier tier);
 
 private:
     // The module containing all TBC (i.e., bytecode) for the TPL program.
@@ -186,6 +280,27 @@ private:
     // Flag to indicate if the JIT compilation has occurred.
     std::once_flag compiled_flag_;
 
+    // The baseline implementation, kept alive while the optimized one replaces it, since calls may still run in it.
+    std::unique_ptr<LLVMEngine::CompiledModule> baseline_module_;
+
+    // Counting stubs in front of the baseline implementations, one per function.
+    Trampoline profiling_stubs_;
+
+    // The profile count of every function.
+    std::unique_ptr<std::atomic<uint64_t>[]> profile_counts_;
+
+    // Whether the module is profiled and moves up tiers. Set once a function is retrieved in adaptive mode.
+    std::atomic<bool> tiering_enabled_{false};
+
+    // Whether a background task is compiling the next tier. Only one runs at a time.
+    std::atomic<bool> tier_up_pending_{false};
+
+    // The tier of the function pointers, only raised while holding the latch.
+    std::atomic<Tier> tier_{Tier::Interpreted};
+    std::mutex        tier_latch_;
+
+    TierThresholds tier_thresholds_{DEFAULT_TIER_THRESHOLDS};
+
     ModuleMetadata metadata_; ///< Non-essential metadata about the TPL module.
 };
 
@@ -208,6 +323,30 @@ namespace detail {
 
 } // namespace detail
 
+template <typename Ret, typename... ArgTypes>
+inline auto Module::InvokeInterpreted(Module *module, const FunctionInfo *func_info, ArgTypes... args) -> Ret {
+    if constexpr (std::is_void_v<Ret>) {
+        // Create a temporary on-stack buffer and copy all arguments
+        uint8_t arg_buffer[(0ul + ... + sizeof(args))];
+        detail::CopyAll(arg_buffer, args...);
+
+        // Invoke and finish
+        VM::InvokeFunction(module, func_info->GetId(), arg_buffer);
+        return;
+    } else { // NOLINT
+        // The return value
+        Ret rv{};
+
+        // Create a temporary on-stack buffer and copy all arguments
+        uint8_t arg_buffer[sizeof(Ret *) + (0ul + ... + sizeof(args))];
+        detail::CopyAll(arg_buffer, &rv, args...);
+
+        // Invoke and finish
+        VM::InvokeFunction(module, func_info->GetId(), arg_buffer);
+        return rv;
+    }
+}
+
 template <typename Ret, typename... ArgTypes>
 inline auto Module::GetFunction(const std::string               &name,
                                 const ExecutionMode              exec_mode,
@@ -228,31 +367,21 @@ inline auto Module::GetFunction(const std::string               &name,
 
     switch (exec_mode) {
     case ExecutionMode::Adaptive: {
-        CompileToMachineCodeAsync();
-        FALLTHROUGH;
+        tiering_enabled_.store(true, std::memory_order_relaxed);
+        MaybeTierUp(GetMaxProfileCount());
+        *func = [this, func_info](ArgTypes... args) -> Ret {
+            // Interpret until the module is compiled. After that, the function pointer leads to the current tier.
+            if (GetTier() == Tier::Interpreted) {
+                return InvokeInterpreted<Ret>(this, func_info, args...);
+            }
+            void *raw_func = functions_[func_info->GetId()].load(std::memory_order_relaxed);
+            return reinterpret_cast<Ret (*)(ArgTypes...)>(raw_func)(args...);
+        };
+        break;
     }
     case ExecutionMode::Interpret: {
         *func = [this, func_info](ArgTypes... args) -> Ret {
-            if constexpr (std::is_void_v<Ret>) {
-                // Create a temporary on-stack buffer and copy all arguments
-                uint8_t arg_buffer[(0ul + ... + sizeof(args))];
-                detail::CopyAll(arg_buffer, args...);
-
-                // Invoke and finish
-                VM::InvokeFunction(this, func_info->GetId(), arg_buffer);
-                return;
-            } else { // NOLINT
-                // The return value
-                Ret rv{};
-
-                // Create a temporary on-stack buffer and copy all arguments
-                uint8_t arg_buffer[sizeof(Ret *) + (0ul + ... + sizeof(args))];
-                detail::CopyAll(arg_buffer, &rv, args...);
-
-                // Invoke and finish
-                VM::InvokeFunction(this, func_info->GetId(), arg_buffer);
-                return rv;
-            }
+            return InvokeInterpreted<Ret>(this, func_info, args...);
         };
         break;
     }
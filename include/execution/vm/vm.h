@@ -13,13 +13,14 @@ class VM {
 public:
     /**
      * Invoke the function with ID @em func_id in the module @em module. @em args
-     * contains the output and input parameters stored contiguously.
+     * contains the output and input parameters stored contiguously. The invocation and the loop iterations it
+     * interpreted are recorded in the module's profile.
      */
-    static void InvokeFunction(const Module *module, FunctionId func_id, const uint8_t args[]);
+    static void InvokeFunction(Module *module, FunctionId func_id, const uint8_t args[]);
 
 private:
     // Private constructor to force users to use InvokeFunction
-    explicit VM(const Module *module);
+    explicit VM(Module *module);
 
     // This class cannot be copied or moved
     DISALLOW_COPY_AND_MOVE(VM);
@@ -35,7 +36,9 @@ private:
 
 private:
     // The module
-    const Module *module_;
+    Module *module_;
+    // The number of loop back edges taken by the function being interpreted
+    uint64_t loop_iterations_{0};
 };
 
 } // namespace noisepage::execution::vm
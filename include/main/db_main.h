@@ -20,6 +20,8 @@
 #include "settings/settings_manager.h"
 #include "settings/settings_param.h"
 #include "storage/garbage_collector_thread.h"
+#include "storage/recovery/checkpoint_manager.h"
+#include "storage/recovery/disk_log_provider.h"
 #include "storage/recovery/recovery_manager.h"
 #include "task/task_manager.h"
 #include "taskflow/taskflow.h"
@@ -27,6 +29,7 @@
 #include "transaction/transaction_manager.h"
 #include "util/query_exec_util.h"
 
+#include <filesystem>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -156,6 +159,7 @@ public:
          * @param block_store_size_limit argument to the BlockStore
          * @param block_store_reuse_limit argument to the BlockStore
          * @param use_gc enable GarbageCollector
+         * @param gc_num_workers argument to the GarbageCollector
          * @param log_manager needed for safe destruction of StorageLayer
          * @param empty_buffer_queue The common buffer queue that all empty buffers are pulled from and returned to.
          */
@@ -163,6 +167,7 @@ public:
                      const uint64_t                                    block_store_size_limit,
                      const uint64_t                                    block_store_reuse_limit,
                      const bool                                        use_gc,
+                     const uint32_t                                    gc_num_workers,
                      const common::ManagedPointer<storage::LogManager> log_manager,
                      std::unique_ptr<common::ConcurrentBlockingQueue<storage::BufferedLogWriter *>> empty_buffer_queue)
             : empty_buffer_queue_(std::move(empty_buffer_queue))
@@ -172,7 +177,8 @@ public:
                 garbage_collector_ = std::make_unique<storage::GarbageCollector>(txn_layer->GetTimestampManager(),
                                                                                  txn_layer->GetDeferredActionManager(),
                                                                                  txn_layer->GetTransactionManager(),
-                                                                                 DISABLED);
+                                                                                 DISABLED,
+                                                                                 gc_num_workers);
             }
 
             block_store_ = std::make_unique<storage::BlockStore>(block_store_size_limit, block_store_reuse_limit);
@@ -362,8 +368,12 @@ public:
     public:
         /**
          * @param bytecode_handlers_path path to the bytecode handlers bitcode file
+         * @param jit_cache_directory directory of the JIT object cache, empty to disable the cache
+         * @param jit_cache_size maximum total size of the JIT object cache in bytes
          */
-        explicit ExecutionLayer(const std::string &bytecode_handlers_path);
+        ExecutionLayer(const std::string &bytecode_handlers_path,
+                       const std::string &jit_cache_directory,
+                       uint64_t           jit_cache_size);
         ~ExecutionLayer();
     };
 
@@ -475,7 +485,11 @@ public:
                                                             common::ManagedPointer(buffer_segment_pool),
                                                             common::ManagedPointer(empty_buffer_queue),
                                                             rep_manager_ptr,
-                                                            common::ManagedPointer(thread_registry));
+                                                            common::ManagedPointer(thread_registry),
+                                                            wal_num_streams_,
+                                                            wal_async_io_depth_,
+                                                            std::chrono::microseconds{wal_group_commit_latency_},
+                                                            wal_compression_enable_);
                 log_manager->Start();
             }
 
@@ -488,9 +502,13 @@ public:
                                                                 block_store_size_,
                                                                 block_store_reuse_,
                                                                 use_gc_,
+                                                                gc_num_workers_,
                                                                 common::ManagedPointer(log_manager),
                                                                 std::move(empty_buffer_queue));
 
+            // With checkpoints enabled, the system is restored from the last checkpoint and the log written after it
+            const bool recover_from_checkpoint = use_checkpoints_ && std::filesystem::exists(checkpoint_file_path_);
+
             std::unique_ptr<CatalogLayer> catalog_layer = DISABLED;
             if (use_catalog_) {
                 NOISEPAGE_ASSERT(use_gc_ && storage_layer->GetGarbageCollector() != DISABLED,
@@ -498,7 +516,16 @@ public:
                 catalog_layer = std::make_unique<CatalogLayer>(common::ManagedPointer(txn_layer),
                                                                common::ManagedPointer(storage_layer),
                                                                common::ManagedPointer(log_manager),
-                                                               create_default_database_);
+                                                               create_default_database_ && !recover_from_checkpoint);
+            }
+
+            if (recover_from_checkpoint) {
+                NOISEPAGE_ASSERT(use_catalog_ && catalog_layer != DISABLED, "Recovery needs the CatalogLayer.");
+                RecoverFromCheckpoint(common::ManagedPointer(thread_registry),
+                                      common::ManagedPointer(txn_layer),
+                                      common::ManagedPointer(storage_layer),
+                                      common::ManagedPointer(catalog_layer),
+                                      common::ManagedPointer(log_manager));
             }
 
             // Instantiate the task manager
@@ -554,9 +581,29 @@ public:
                                                                               common::ManagedPointer(metrics_manager));
             }
 
+            std::unique_ptr<storage::CheckpointManager> checkpoint_manager = DISABLED;
+            if (use_checkpoints_) {
+                NOISEPAGE_ASSERT(use_logging_ && log_manager != DISABLED, "CheckpointManager needs LogManager.");
+                NOISEPAGE_ASSERT(use_catalog_ && catalog_layer->GetCatalog() != DISABLED,
+                                 "CheckpointManager needs the CatalogLayer.");
+                checkpoint_manager
+                    = std::make_unique<storage::CheckpointManager>(checkpoint_file_path_,
+                                                                   catalog_layer->GetCatalog(),
+                                                                   txn_layer->GetTransactionManager(),
+                                                                   txn_layer->GetTimestampManager(),
+                                                                   common::ManagedPointer(log_manager));
+                if (!recover_from_checkpoint) {
+                    // Until the first checkpoint is taken there is nothing to recover from on restart, so checkpoint
+                    // the freshly bootstrapped system right away
+                    checkpoint_manager->TakeCheckpoint();
+                }
+                checkpoint_manager->StartCheckpointThread(std::chrono::seconds{checkpoint_interval_});
+            }
+
             std::unique_ptr<ExecutionLayer> execution_layer = DISABLED;
             if (use_execution_) {
-                execution_layer = std::make_unique<ExecutionLayer>(bytecode_handlers_path_);
+                execution_layer
+                    = std::make_unique<ExecutionLayer>(bytecode_handlers_path_, jit_cache_directory_, jit_cache_size_);
             }
 
             std::unique_ptr<taskflow::Taskflow> taskflow = DISABLED;
@@ -573,7 +620,9 @@ public:
                                                                 common::ManagedPointer(stats_storage),
                                                                 optimizer_timeout_,
                                                                 use_query_cache_,
-                                                                execution_mode_);
+                                                                execution_mode_,
+                                                                cost_model_type_,
+                                                                shared_statement_cache_size_);
             }
 
             std::unique_ptr<NetworkLayer> network_layer = DISABLED;
@@ -664,6 +713,7 @@ public:
             db_main->catalog_layer_ = std::move(catalog_layer);
             db_main->recovery_manager_ = std::move(recovery_manager);
             db_main->gc_thread_ = std::move(gc_thread);
+            db_main->checkpoint_manager_ = std::move(checkpoint_manager);
             db_main->stats_storage_ = std::move(stats_storage);
             db_main->execution_layer_ = std::move(execution_layer);
             db_main->taskflow_ = std::move(taskflow);
@@ -742,6 +792,33 @@ public:
             return *this;
         }
 
+        /**
+         * @param value use component
+         * @return self reference for chaining
+         */
+        auto SetUseCheckpoints(const bool value) -> Builder & {
+            use_checkpoints_ = value;
+            return *this;
+        }
+
+        /**
+         * @param value CheckpointManager argument
+         * @return self reference for chaining
+         */
+        auto SetCheckpointFilePath(const std::string &value) -> Builder & {
+            checkpoint_file_path_ = value;
+            return *this;
+        }
+
+        /**
+         * @param value CheckpointManager argument, in seconds
+         * @return self reference for chaining
+         */
+        auto SetCheckpointInterval(const int32_t value) -> Builder & {
+            checkpoint_interval_ = value;
+            return *this;
+        }
+
         /**
          * @param value TransactionManager argument
          * @return self reference for chaining
@@ -778,6 +855,42 @@ public:
             return *this;
         }
 
+        /**
+         * @param value LogManager argument
+         * @return self reference for chaining
+         */
+        auto SetWalNumStreams(const uint32_t value) -> Builder & {
+            wal_num_streams_ = value;
+            return *this;
+        }
+
+        /**
+         * @param value LogManager argument
+         * @return self reference for chaining
+         */
+        auto SetWalAsyncIoDepth(const uint32_t value) -> Builder & {
+            wal_async_io_depth_ = value;
+            return *this;
+        }
+
+        /**
+         * @param value LogManager argument
+         * @return self reference for chaining
+         */
+        auto SetWalGroupCommitTargetLatency(const int32_t value) -> Builder & {
+            wal_group_commit_latency_ = value;
+            return *this;
+        }
+
+        /**
+         * @param value LogManager argument
+         * @return self reference for chaining
+         */
+        auto SetWalCompression(const bool value) -> Builder & {
+            wal_compression_enable_ = value;
+            return *this;
+        }
+
         /**
          * @param value LogManager argument
          * @return self reference for chaining
@@ -796,6 +909,15 @@ public:
             return *this;
         }
 
+        /**
+         * @param value GarbageCollector argument
+         * @return self reference for chaining
+         */
+        auto SetGCNumWorkers(const uint32_t value) -> Builder & {
+            gc_num_workers_ = value;
+            return *this;
+        }
+
         /**
          * @param value use component
          * @return self reference for chaining
@@ -931,6 +1053,24 @@ public:
             return *this;
         }
 
+        /**
+         * @param value Taskflow argument
+         * @return self reference for chaining
+         */
+        auto SetCostModelType(const optimizer::CostModelType value) -> Builder & {
+            cost_model_type_ = value;
+            return *this;
+        }
+
+        /**
+         * @param value Taskflow argument
+         * @return self reference for chaining
+         */
+        auto SetSharedStatementCacheSize(const uint64_t value) -> Builder & {
+            shared_statement_cache_size_ = value;
+            return *this;
+        }
+
         /**
          * @param value use component
          * @return self reference for chaining
@@ -994,6 +1134,24 @@ public:
             return *this;
         }
 
+        /**
+         * @param value directory of the JIT object cache, empty to disable the cache
+         * @return self reference for chaining
+         */
+        auto SetJitCacheDirectory(const std::string &value) -> Builder & {
+            jit_cache_directory_ = value;
+            return *this;
+        }
+
+        /**
+         * @param value maximum total size of the JIT object cache in bytes
+         * @return self reference for chaining
+         */
+        auto SetJitCacheSize(const uint64_t value) -> Builder & {
+            jit_cache_size_ = value;
+            return *this;
+        }
+
     private:
         std::unordered_map<settings::Param, settings::ParamInfo> param_map_;
 
@@ -1016,13 +1174,17 @@ public:
         uint64_t block_store_size_ = 1e5;
         uint64_t block_store_reuse_ = 1e3;
         uint64_t optimizer_timeout_ = 5000;
+        uint64_t shared_statement_cache_size_ = static_cast<uint64_t>(1 << 26);
         uint64_t forecast_sample_limit_ = 5;
+        uint64_t jit_cache_size_ = static_cast<uint64_t>(1 << 28);
 
         std::string wal_file_path_ = "wal.log";
+        std::string checkpoint_file_path_ = "checkpoint.dat";
         std::string ou_model_save_path_;
         std::string interference_model_save_path_;
         std::string forecast_model_save_path_;
         std::string bytecode_handlers_path_ = "./bytecode_handlers_ir.bc";
+        std::string jit_cache_directory_;
         std::string network_identity_ = "primary";
         std::string uds_file_directory_ = "/tmp/";
         std::string replication_hosts_path_ = "./replication.config";
@@ -1050,7 +1212,12 @@ public:
         bool                   execute_command_metrics_ = false;
         int32_t                wal_serialization_interval_ = 100;
         int32_t                wal_persist_interval_ = 100;
+        uint32_t               wal_num_streams_ = 1;
+        uint32_t               wal_async_io_depth_ = 0;
+        int32_t                wal_group_commit_latency_ = 0;
         int32_t                gc_interval_ = 1000;
+        uint32_t               gc_num_workers_ = 1;
+        int32_t                checkpoint_interval_ = 300;
         uint32_t               task_pool_size_ = 1;
 
         uint16_t connection_thread_count_ = 4;
@@ -1059,9 +1226,12 @@ public:
         uint16_t replication_port_ = 15445;
 
         execution::vm::ExecutionMode execution_mode_ = execution::vm::ExecutionMode::Interpret;
+        optimizer::CostModelType     cost_model_type_ = optimizer::CostModelType::TRIVIAL;
 
         bool use_logging_ = false;
         bool wal_async_commit_enable_ = false;
+        bool wal_compression_enable_ = false;
+        bool use_checkpoints_ = false;
         bool use_gc_ = false;
         bool use_catalog_ = false;
         bool create_default_database_ = true;
@@ -1103,8 +1273,17 @@ public:
                 wal_num_buffers_ = static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::wal_num_buffers));
                 wal_serialization_interval_ = settings_manager->GetInt(settings::Param::wal_serialization_interval);
                 wal_persist_interval_ = settings_manager->GetInt(settings::Param::wal_persist_interval);
+                wal_num_streams_ = settings_manager->GetInt(settings::Param::wal_num_streams);
+                wal_async_io_depth_ = settings_manager->GetInt(settings::Param::wal_async_io_depth);
+                wal_group_commit_latency_ = settings_manager->GetInt(settings::Param::wal_group_commit_target_latency);
+                wal_compression_enable_ = settings_manager->GetBool(settings::Param::wal_compression_enable);
                 wal_persist_threshold_
                     = static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::wal_persist_threshold));
+                use_checkpoints_ = settings_manager->GetBool(settings::Param::checkpoint_enable);
+                if (use_checkpoints_) {
+                    checkpoint_file_path_ = settings_manager->GetString(settings::Param::checkpoint_file_path);
+                    checkpoint_interval_ = settings_manager->GetInt(settings::Param::checkpoint_interval);
+                }
             }
 
             use_metrics_ = settings_manager->GetBool(settings::Param::metrics);
@@ -1113,6 +1292,7 @@ public:
             pilot_planning_ = settings_manager->GetBool(settings::Param::pilot_planning);
 
             gc_interval_ = settings_manager->GetInt(settings::Param::gc_interval);
+            gc_num_workers_ = settings_manager->GetInt(settings::Param::gc_num_workers);
             pilot_interval_ = settings_manager->GetInt64(settings::Param::pilot_interval);
             forecast_train_interval_ = settings_manager->GetInt64(settings::Param::forecast_train_interval);
             workload_forecast_interval_ = settings_manager->GetInt64(settings::Param::workload_forecast_interval);
@@ -1134,11 +1314,23 @@ public:
             optimizer_timeout_
                 = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::task_execution_timeout));
             use_query_cache_ = settings_manager->GetBool(settings::Param::use_query_cache);
+            shared_statement_cache_size_
+                = static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::shared_statement_cache_size));
+            const auto cost_model_name = settings_manager->GetString(settings::Param::optimizer_cost_model);
+            const auto cost_model_type = optimizer::CostModelUtil::FromCostModelString(cost_model_name);
+            if (cost_model_type == std::nullopt) {
+                throw SETTINGS_EXCEPTION(
+                    fmt::format("{} is not a valid value for parameter \"optimizer_cost_model\"", cost_model_name),
+                    common::ErrorCode::ERRCODE_INVALID_PARAMETER_VALUE);
+            }
+            cost_model_type_ = *cost_model_type;
 
             execution_mode_ = settings_manager->GetBool(settings::Param::compiled_query_execution)
                                   ? execution::vm::ExecutionMode::Compiled
                                   : execution::vm::ExecutionMode::Interpret;
             bytecode_handlers_path_ = settings_manager->GetString(settings::Param::bytecode_handlers_path);
+            jit_cache_directory_ = settings_manager->GetString(settings::Param::jit_cache_directory);
+            jit_cache_size_ = static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::jit_cache_size));
 
             query_trace_metrics_ = settings_manager->GetBool(settings::Param::query_trace_metrics_enable);
             query_trace_metrics_output_ = *metrics::MetricsUtil::FromMetricsOutputString(
@@ -1165,6 +1357,46 @@ public:
             return settings_manager;
         }
 
+        /**
+         * Recovers the system from the checkpoint at checkpoint_file_path_ and the log written after it. Replayed
+         * transactions are not logged again, since the checkpoint and the log tail that they come from are kept.
+         * @param thread_registry registry to run the recovery task on
+         * @param txn_layer transaction layer to replay transactions with
+         * @param storage_layer storage layer to create the recovered tables in
+         * @param catalog_layer catalog to recover, which must not have been bootstrapped
+         * @param log_manager log manager, to clean up after the replayed transactions
+         */
+        void RecoverFromCheckpoint(const common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
+                                   const common::ManagedPointer<TransactionLayer>                txn_layer,
+                                   const common::ManagedPointer<StorageLayer>                    storage_layer,
+                                   const common::ManagedPointer<CatalogLayer>                    catalog_layer,
+                                   const common::ManagedPointer<storage::LogManager>             log_manager) {
+            storage::CheckpointLogProvider checkpoint_provider(checkpoint_file_path_);
+            storage::DiskLogProvider       log_provider(
+                storage::CheckpointManager::LogFilesForCheckpoint(checkpoint_provider, wal_file_path_));
+
+            const auto txn_manager = txn_layer->GetTransactionManager();
+            const auto durability = txn_manager->GetDefaultTransactionPolicy().durability_;
+            txn_manager->SetDefaultTransactionDurabilityPolicy(transaction::DurabilityPolicy::DISABLE);
+            {
+                storage::RecoveryManager recovery_manager(
+                    common::ManagedPointer<storage::AbstractLogProvider>(&log_provider),
+                    catalog_layer->GetCatalog(),
+                    txn_manager,
+                    txn_layer->GetDeferredActionManager(),
+                    DISABLED,
+                    thread_registry,
+                    storage_layer->GetBlockStore(),
+                    common::ManagedPointer(&checkpoint_provider));
+                recovery_manager.StartRecovery();
+                recovery_manager.WaitForRecoveryToFinish();
+            }
+            txn_manager->SetDefaultTransactionDurabilityPolicy(durability);
+
+            // Clean up after the replayed transactions before the GC thread starts, as the GC is not thread-safe
+            txn_layer->GetDeferredActionManager()->FullyPerformGC(storage_layer->GetGarbageCollector(), log_manager);
+        }
+
         /**
          * Instantiate the MetricsManager and enable metrics for components arrocding to the Builder's settings.
          * @return
@@ -1247,6 +1479,13 @@ public:
         return common::ManagedPointer(log_manager_);
     }
 
+    /**
+     * @return ManagedPointer to the component, can be nullptr if disabled
+     */
+    auto GetCheckpointManager() const -> common::ManagedPointer<storage::CheckpointManager> {
+        return common::ManagedPointer(checkpoint_manager_);
+    }
+
     /**
      * @return ManagedPointer to the component
      */
@@ -1357,6 +1596,7 @@ private:
     std::unique_ptr<CatalogLayer>                     catalog_layer_;
     std::unique_ptr<storage::GarbageCollectorThread>
         gc_thread_; // thread needs to die before manual invocations of GC in CatalogLayer and others
+    std::unique_ptr<storage::CheckpointManager>      checkpoint_manager_; // Checkpoint thread must stop before catalog.
     std::unique_ptr<optimizer::StatsStorage>         stats_storage_;
     std::unique_ptr<ExecutionLayer>                  execution_layer_;
     std::unique_ptr<taskflow::Taskflow>              taskflow_;
@@ -26,6 +26,9 @@ public:
         if (!other_db_metric->execution_data_.empty()) {
             execution_data_.splice(execution_data_.cend(), other_db_metric->execution_data_);
         }
+        if (!other_db_metric->jit_cache_data_.empty()) {
+            jit_cache_data_.splice(jit_cache_data_.cend(), other_db_metric->jit_cache_data_);
+        }
     }
 
     /**
@@ -50,24 +53,33 @@ public:
                          "Not all files are open.");
 
         auto &outfile = (*outfiles)[0];
+        auto &jit_cache_outfile = (*outfiles)[1];
 
         for (const auto &data : execution_data_) {
             outfile << data.feature_ << ", " << static_cast<uint32_t>(data.execution_mode_) << ", ";
             data.resource_metrics_.ToCSV(outfile);
             outfile << std::endl;
         }
+        for (const auto &data : jit_cache_data_) {
+            jit_cache_outfile << data.module_name_ << ", " << static_cast<uint32_t>(data.cache_hit_) << ", "
+                              << data.compile_time_saved_us_ << ", ";
+            data.resource_metrics_.ToCSV(jit_cache_outfile);
+            jit_cache_outfile << std::endl;
+        }
         execution_data_.clear();
+        jit_cache_data_.clear();
     }
 
     /**
      * Files to use for writing to CSV.
      */
-    static constexpr std::array<std::string_view, 1> FILES = {"./execution.csv"};
+    static constexpr std::array<std::string_view, 2> FILES = {"./execution.csv", "./jit_cache.csv"};
     /**
      * Columns to use for writing to CSV.
      * Note: This includes the columns for the input feature, but not the output (resource counters)
      */
-    static constexpr std::array<std::string_view, 1> FEATURE_COLUMNS = {"feature"};
+    static constexpr std::array<std::string_view, 2> FEATURE_COLUMNS
+        = {"feature", "module_name, cache_hit, compile_time_saved_us"};
 
 private:
     friend class ExecutionMetric;
@@ -80,6 +92,13 @@ private:
         execution_data_.emplace_back(feature, len, execution_mode, resource_metrics);
     }
 
+    void RecordJitCacheData(const std::string                      &module_name,
+                            const bool                              cache_hit,
+                            const uint64_t                          compile_time_saved_us,
+                            const common::ResourceTracker::Metrics &resource_metrics) {
+        jit_cache_data_.emplace_back(module_name, cache_hit, compile_time_saved_us, resource_metrics);
+    }
+
     struct ExecutionData {
         ExecutionData(const char                             *name,
                       uint32_t                                len,
@@ -93,7 +112,23 @@ private:
         const common::ResourceTracker::Metrics resource_metrics_;
     };
 
+    struct JitCacheData {
+        JitCacheData(std::string                             module_name,
+                     const bool                              cache_hit,
+                     const uint64_t                          compile_time_saved_us,
+                     const common::ResourceTracker::Metrics &resource_metrics)
+            : module_name_(std::move(module_name))
+            , cache_hit_(cache_hit)
+            , compile_time_saved_us_(compile_time_saved_us)
+            , resource_metrics_(resource_metrics) {}
+        const std::string                      module_name_;
+        const bool                             cache_hit_;
+        const uint64_t                         compile_time_saved_us_;
+        const common::ResourceTracker::Metrics resource_metrics_;
+    };
+
     std::list<ExecutionData> execution_data_;
+    std::list<JitCacheData>  jit_cache_data_;
 };
 
 /**
@@ -109,5 +144,12 @@ private:
                              const common::ResourceTracker::Metrics &resource_metrics) {
         GetRawData()->RecordExecutionData(feature, len, execution_mode, resource_metrics);
     }
+
+    void RecordJitCacheData(const std::string                      &module_name,
+                            const bool                              cache_hit,
+                            const uint64_t                          compile_time_saved_us,
+                            const common::ResourceTracker::Metrics &resource_metrics) {
+        GetRawData()->RecordJitCacheData(module_name, cache_hit, compile_time_saved_us, resource_metrics);
+    }
 };
 } // namespace noisepage::metrics
@@ -25,6 +25,9 @@ public:
         if (!other_db_metric->gc_data_.empty()) {
             gc_data_.splice(gc_data_.cend(), other_db_metric->gc_data_);
         }
+        if (!other_db_metric->worker_data_.empty()) {
+            worker_data_.splice(worker_data_.cend(), other_db_metric->worker_data_);
+        }
     }
 
     /**
@@ -49,6 +52,7 @@ public:
                          "Not all files are open.");
 
         auto &outfile = (*outfiles)[0];
+        auto &worker_outfile = (*outfiles)[1];
 
         for (const auto &data : gc_data_) {
             outfile << data.txns_deallocated_ << ", " << data.txns_unlinked_ << ", " << data.buffer_unlinked_ << ", "
@@ -56,19 +60,27 @@ public:
             data.resource_metrics_.ToCSV(outfile);
             outfile << std::endl;
         }
+        for (const auto &data : worker_data_) {
+            worker_outfile << data.worker_id_ << ", " << data.txns_deallocated_ << ", " << data.undo_records_unlinked_
+                           << ", " << data.indexes_processed_ << ", " << data.elapsed_us_ << ", ";
+            data.resource_metrics_.ToCSV(worker_outfile);
+            worker_outfile << std::endl;
+        }
         gc_data_.clear();
+        worker_data_.clear();
     }
 
     /**
      * Files to use for writing to CSV.
      */
-    static constexpr std::array<std::string_view, 1> FILES = {"./gc.csv"};
+    static constexpr std::array<std::string_view, 2> FILES = {"./gc.csv", "./gc_workers.csv"};
     /**
      * Columns to use for writing to CSV.
      * Note: This includes the columns for the input feature, but not the output (resource counters)
      */
-    static constexpr std::array<std::string_view, 1> FEATURE_COLUMNS
-        = {"txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval"};
+    static constexpr std::array<std::string_view, 2> FEATURE_COLUMNS
+        = {"txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval",
+           "worker_id, txns_deallocated, undo_records_unlinked, indexes_processed, elapsed_us"};
 
 private:
     friend class GarbageCollectionMetric;
@@ -88,6 +100,20 @@ private:
                               resource_metrics);
     }
 
+    void RecordGCWorkerData(const uint32_t                          worker_id,
+                            const uint64_t                          txns_deallocated,
+                            const uint64_t                          undo_records_unlinked,
+                            const uint64_t                          indexes_processed,
+                            const uint64_t                          elapsed_us,
+                            const common::ResourceTracker::Metrics &resource_metrics) {
+        worker_data_.emplace_back(worker_id,
+                                  txns_deallocated,
+                                  undo_records_unlinked,
+                                  indexes_processed,
+                                  elapsed_us,
+                                  resource_metrics);
+    }
+
     struct GCData {
         GCData(uint64_t                                txns_deallocated,
                uint64_t                                txns_unlinked,
@@ -109,11 +135,34 @@ private:
         const common::ResourceTracker::Metrics resource_metrics_;
     };
 
-    std::list<GCData> gc_data_;
+    struct GCWorkerData {
+        GCWorkerData(const uint32_t                          worker_id,
+                     const uint64_t                          txns_deallocated,
+                     const uint64_t                          undo_records_unlinked,
+                     const uint64_t                          indexes_processed,
+                     const uint64_t                          elapsed_us,
+                     const common::ResourceTracker::Metrics &resource_metrics)
+            : worker_id_(worker_id)
+            , txns_deallocated_(txns_deallocated)
+            , undo_records_unlinked_(undo_records_unlinked)
+            , indexes_processed_(indexes_processed)
+            , elapsed_us_(elapsed_us)
+            , resource_metrics_(resource_metrics) {}
+        const uint32_t                         worker_id_;
+        const uint64_t                         txns_deallocated_;
+        const uint64_t                         undo_records_unlinked_;
+        const uint64_t                         indexes_processed_;
+        const uint64_t                         elapsed_us_;
+        const common::ResourceTracker::Metrics resource_metrics_;
+    };
+
+    std::list<GCData>       gc_data_;
+    std::list<GCWorkerData> worker_data_;
 };
 
 /**
- * Metrics for the garbage collection components of the system: currently deallocation and unlinking
+ * Metrics for the garbage collection components of the system: currently deallocation and unlinking, overall and by
+ * each of the workers of the GC
  */
 class GarbageCollectionMetric : public AbstractMetric<GarbageCollectionMetricRawData> {
 private:
@@ -132,5 +181,19 @@ private:
                                    interval,
                                    resource_metrics);
     }
+
+    void RecordGCWorkerData(const uint32_t                          worker_id,
+                            const uint64_t                          txns_deallocated,
+                            const uint64_t                          undo_records_unlinked,
+                            const uint64_t                          indexes_processed,
+                            const uint64_t                          elapsed_us,
+                            const common::ResourceTracker::Metrics &resource_metrics) {
+        GetRawData()->RecordGCWorkerData(worker_id,
+                                         txns_deallocated,
+                                         undo_records_unlinked,
+                                         indexes_processed,
+                                         elapsed_us,
+                                         resource_metrics);
+    }
 };
 } // namespace noisepage::metrics
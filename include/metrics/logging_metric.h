@@ -31,6 +31,12 @@ public:
         if (!other_db_metric->recovery_data_.empty()) {
             recovery_data_.splice(recovery_data_.cend(), other_db_metric->recovery_data_);
         }
+        if (!other_db_metric->group_commit_data_.empty()) {
+            group_commit_data_.splice(group_commit_data_.cend(), other_db_metric->group_commit_data_);
+        }
+        if (!other_db_metric->compression_data_.empty()) {
+            compression_data_.splice(compression_data_.cend(), other_db_metric->compression_data_);
+        }
     }
 
     /**
@@ -57,6 +63,8 @@ public:
         auto &serializer_outfile = (*outfiles)[0];
         auto &consumer_outfile = (*outfiles)[1];
         auto &recovery_outfile = (*outfiles)[2];
+        auto &group_commit_outfile = (*outfiles)[3];
+        auto &compression_outfile = (*outfiles)[4];
 
         for (const auto &data : serializer_data_) {
             serializer_outfile << data.num_bytes_ << ", " << data.num_records_ << ", " << data.num_txns_ << ", "
@@ -74,22 +82,43 @@ public:
             data.resource_metrics_.ToCSV(recovery_outfile);
             recovery_outfile << std::endl;
         }
+        for (const auto &data : group_commit_data_) {
+            group_commit_outfile << data.batch_size_ << ", " << data.target_batch_size_ << ", " << data.wait_budget_
+                                 << ", " << data.persist_latency_p99_ << ", " << data.arrival_rate_ << ", ";
+            data.resource_metrics_.ToCSV(group_commit_outfile);
+            group_commit_outfile << std::endl;
+        }
+        for (const auto &data : compression_data_) {
+            compression_outfile << data.num_bytes_ << ", " << data.num_compressed_bytes_ << ", " << data.elapsed_us_
+                                << ", ";
+            data.resource_metrics_.ToCSV(compression_outfile);
+            compression_outfile << std::endl;
+        }
         serializer_data_.clear();
         consumer_data_.clear();
         recovery_data_.clear();
+        group_commit_data_.clear();
+        compression_data_.clear();
     }
 
     /**
      * Files to use for writing to CSV.
      */
-    static constexpr std::array<std::string_view, 3> FILES
-        = {"./log_serializer_task.csv", "./disk_log_consumer_task.csv", "./recovery_manager.csv"};
+    static constexpr std::array<std::string_view, 5> FILES = {"./log_serializer_task.csv",
+                                                              "./disk_log_consumer_task.csv",
+                                                              "./recovery_manager.csv",
+                                                              "./group_commit_controller.csv",
+                                                              "./log_compression.csv"};
     /**
      * Columns to use for writing to CSV.
      * Note: This includes the columns for the input feature, but not the output (resource counters)
      */
-    static constexpr std::array<std::string_view, 3> FEATURE_COLUMNS
-        = {"num_bytes, num_records, num_txns, interval", "num_bytes, num_buffers, interval", "num_records, num_txns"};
+    static constexpr std::array<std::string_view, 5> FEATURE_COLUMNS
+        = {"num_bytes, num_records, num_txns, interval",
+           "num_bytes, num_buffers, interval",
+           "num_records, num_txns",
+           "batch_size, target_batch_size, wait_budget, persist_latency_p99, arrival_rate",
+           "num_bytes, num_compressed_bytes, elapsed_us"};
 
 private:
     friend class LoggingMetric;
@@ -116,6 +145,27 @@ private:
         recovery_data_.emplace_back(num_records, num_txns, resource_metrics);
     }
 
+    void RecordGroupCommitData(const uint64_t                          batch_size,
+                               const uint64_t                          target_batch_size,
+                               const uint64_t                          wait_budget,
+                               const uint64_t                          persist_latency_p99,
+                               const uint64_t                          arrival_rate,
+                               const common::ResourceTracker::Metrics &resource_metrics) {
+        group_commit_data_.emplace_back(batch_size,
+                                        target_batch_size,
+                                        wait_budget,
+                                        persist_latency_p99,
+                                        arrival_rate,
+                                        resource_metrics);
+    }
+
+    void RecordCompressionData(const uint64_t                          num_bytes,
+                               const uint64_t                          num_compressed_bytes,
+                               const uint64_t                          elapsed_us,
+                               const common::ResourceTracker::Metrics &resource_metrics) {
+        compression_data_.emplace_back(num_bytes, num_compressed_bytes, elapsed_us, resource_metrics);
+    }
+
     struct SerializerData {
         SerializerData(const uint64_t                          num_bytes,
                        const uint64_t                          num_records,
@@ -161,14 +211,52 @@ private:
         const common::ResourceTracker::Metrics resource_metrics_;
     };
 
-    std::list<SerializerData> serializer_data_;
-    std::list<ConsumerData>   consumer_data_;
-    std::list<RecoveryData>   recovery_data_;
+    struct GroupCommitData {
+        GroupCommitData(const uint64_t                          batch_size,
+                        const uint64_t                          target_batch_size,
+                        const uint64_t                          wait_budget,
+                        const uint64_t                          persist_latency_p99,
+                        const uint64_t                          arrival_rate,
+                        const common::ResourceTracker::Metrics &resource_metrics)
+            : batch_size_(batch_size)
+            , target_batch_size_(target_batch_size)
+            , wait_budget_(wait_budget)
+            , persist_latency_p99_(persist_latency_p99)
+            , arrival_rate_(arrival_rate)
+            , resource_metrics_(resource_metrics) {}
+        const uint64_t                         batch_size_;
+        const uint64_t                         target_batch_size_;
+        const uint64_t                         wait_budget_;
+        const uint64_t                         persist_latency_p99_;
+        const uint64_t                         arrival_rate_;
+        const common::ResourceTracker::Metrics resource_metrics_;
+    };
+
+    struct CompressionData {
+        CompressionData(const uint64_t                          num_bytes,
+                        const uint64_t                          num_compressed_bytes,
+                        const uint64_t                          elapsed_us,
+                        const common::ResourceTracker::Metrics &resource_metrics)
+            : num_bytes_(num_bytes)
+            , num_compressed_bytes_(num_compressed_bytes)
+            , elapsed_us_(elapsed_us)
+            , resource_metrics_(resource_metrics) {}
+        const uint64_t                         num_bytes_;
+        const uint64_t                         num_compressed_bytes_;
+        const uint64_t                         elapsed_us_;
+        const common::ResourceTracker::Metrics resource_metrics_;
+    };
+
+    std::list<SerializerData>  serializer_data_;
+    std::list<ConsumerData>    consumer_data_;
+    std::list<RecoveryData>    recovery_data_;
+    std::list<GroupCommitData> group_commit_data_;
+    std::list<CompressionData> compression_data_;
 };
 
 /**
- * Metrics for the logging components of the system: currently buffer consumer (writes to disk) and the record
- * serializer
+ * Metrics for the logging components of the system: currently buffer consumer (writes to disk), the record
+ * serializer, recovery, the group commit controller of the buffer consumer, and the compression of log buffers
  */
 class LoggingMetric : public AbstractMetric<LoggingMetricRawData> {
 private:
@@ -192,5 +280,24 @@ private:
                             const common::ResourceTracker::Metrics &resource_metrics) {
         GetRawData()->RecordRecoveryData(num_records, num_txns, resource_metrics);
     }
+    void RecordGroupCommitData(const uint64_t                          batch_size,
+                               const uint64_t                          target_batch_size,
+                               const uint64_t                          wait_budget,
+                               const uint64_t                          persist_latency_p99,
+                               const uint64_t                          arrival_rate,
+                               const common::ResourceTracker::Metrics &resource_metrics) {
+        GetRawData()->RecordGroupCommitData(batch_size,
+                                            target_batch_size,
+                                            wait_budget,
+                                            persist_latency_p99,
+                                            arrival_rate,
+                                            resource_metrics);
+    }
+    void RecordCompressionData(const uint64_t                          num_bytes,
+                               const uint64_t                          num_compressed_bytes,
+                               const uint64_t                          elapsed_us,
+                               const common::ResourceTracker::Metrics &resource_metrics) {
+        GetRawData()->RecordCompressionData(num_bytes, num_compressed_bytes, elapsed_us, resource_metrics);
+    }
 };
 } // namespace noisepage::metrics
@@ -95,6 +95,51 @@ public:
         logging_metric_->RecordRecoveryData(num_records, num_txns, resource_metrics);
     }
 
+    /**
+     * Record the state of the group commit controller of a DiskLogConsumerTask
+     * @param batch_size number of commits in the most recently persisted batch
+     * @param target_batch_size number of commits at which a batch is persisted early
+     * @param wait_budget how long, in microseconds, the oldest commit of a batch may wait for the batch to be persisted
+     * @param persist_latency_p99 estimated 99th percentile persist latency, in microseconds
+     * @param arrival_rate estimated commit arrival rate, in commits per second
+     * @param resource_metrics resource metrics of the DiskLogConsumerTask
+     */
+    void RecordGroupCommitData(const uint64_t                          batch_size,
+                               const uint64_t                          target_batch_size,
+                               const uint64_t                          wait_budget,
+                               const uint64_t                          persist_latency_p99,
+                               const uint64_t                          arrival_rate,
+                               const common::ResourceTracker::Metrics &resource_metrics) {
+        if (!ComponentEnabled(MetricsComponent::LOGGING))
+            METRICS_LOG_WARN("RecordGroupCommitData() called without logging metrics enabled. Was it recently "
+                             "disabled and the component is just lagging?");
+        NOISEPAGE_ASSERT(logging_metric_ != nullptr, "LoggingMetric not allocated. Check MetricsStore constructor.");
+        logging_metric_->RecordGroupCommitData(batch_size,
+                                               target_batch_size,
+                                               wait_budget,
+                                               persist_latency_p99,
+                                               arrival_rate,
+                                               resource_metrics);
+    }
+
+    /**
+     * Record the compression of log buffers by the LogSerializerTask
+     * @param num_bytes number of bytes in the buffers before compression
+     * @param num_compressed_bytes number of bytes in the frames that the buffers were compressed to
+     * @param elapsed_us time spent compressing, in microseconds
+     * @param resource_metrics resource metrics of the LogSerializerTask
+     */
+    void RecordCompressionData(const uint64_t                          num_bytes,
+                               const uint64_t                          num_compressed_bytes,
+                               const uint64_t                          elapsed_us,
+                               const common::ResourceTracker::Metrics &resource_metrics) {
+        if (!ComponentEnabled(MetricsComponent::LOGGING))
+            METRICS_LOG_WARN("RecordCompressionData() called without logging metrics enabled. Was it recently "
+                             "disabled and the component is just lagging?");
+        NOISEPAGE_ASSERT(logging_metric_ != nullptr, "LoggingMetric not allocated. Check MetricsStore constructor.");
+        logging_metric_->RecordCompressionData(num_bytes, num_compressed_bytes, elapsed_us, resource_metrics);
+    }
+
     /**
      * Record metrics from GC
      * @param txns_deallocated first entry of metrics datapoint
@@ -124,6 +169,34 @@ public:
                                  resource_metrics);
     }
 
+    /**
+     * Record the work done by one worker of the GC in an invocation
+     * @param worker_id id of the worker
+     * @param txns_deallocated number of transactions the worker deallocated
+     * @param undo_records_unlinked number of undo records the worker unlinked
+     * @param indexes_processed number of indexes the worker garbage collected
+     * @param elapsed_us time the worker spent on the invocation, in microseconds
+     * @param resource_metrics resource metrics of the invocation
+     */
+    void RecordGCWorkerData(const uint32_t                          worker_id,
+                            const uint64_t                          txns_deallocated,
+                            const uint64_t                          undo_records_unlinked,
+                            const uint64_t                          indexes_processed,
+                            const uint64_t                          elapsed_us,
+                            const common::ResourceTracker::Metrics &resource_metrics) {
+        if (!ComponentEnabled(MetricsComponent::GARBAGECOLLECTION))
+            METRICS_LOG_WARN("RecordGCWorkerData() called without GC metrics enabled. Was it recently disabled and the "
+                             "component is just lagging?");
+        NOISEPAGE_ASSERT(gc_metric_ != nullptr,
+                         "GarbageCollectionMetric not allocated. Check MetricsStore constructor.");
+        gc_metric_->RecordGCWorkerData(worker_id,
+                                       txns_deallocated,
+                                       undo_records_unlinked,
+                                       indexes_processed,
+                                       elapsed_us,
+                                       resource_metrics);
+    }
+
     /**
      * Record metrics for transaction manager when beginning transaction
      * @param resource_metrics first entry of txn datapoint
@@ -151,6 +224,24 @@ public:
         txn_metric_->RecordCommitData(is_readonly, resource_metrics);
     }
 
+    /**
+     * Record the work done on version chains by the reads of a committed transaction
+     * @param num_reads number of tuples the transaction read
+     * @param num_versions_walked number of versions the transaction walked to reconstruct the tuples it read
+     * @param num_chains_pruned number of version chains the transaction pruned of versions no one can see anymore
+     * @param resource_metrics resource metrics of the commit
+     */
+    void RecordVersionChainData(const uint64_t                          num_reads,
+                                const uint64_t                          num_versions_walked,
+                                const uint64_t                          num_chains_pruned,
+                                const common::ResourceTracker::Metrics &resource_metrics) {
+        if (!ComponentEnabled(MetricsComponent::TRANSACTION))
+            METRICS_LOG_WARN("RecordVersionChainData() called without transaction metrics enabled. Was it recently "
+                             "disabled and the component is just lagging?");
+        NOISEPAGE_ASSERT(txn_metric_ != nullptr, "TransactionMetric not allocated. Check MetricsStore constructor.");
+        txn_metric_->RecordVersionChainData(num_reads, num_versions_walked, num_chains_pruned, resource_metrics);
+    }
+
     /**
      * Record metrics for the execution engine when finish a pipeline
      * @param feature first entry of execution datapoint
@@ -169,6 +260,24 @@ public:
         execution_metric_->RecordExecutionData(feature, len, execution_mode, resource_metrics);
     }
 
+    /**
+     * Record metrics for the JIT compilation of a module
+     * @param module_name name of the module
+     * @param cache_hit whether the compiled module was loaded from the JIT object cache
+     * @param compile_time_saved_us compile time the object cache saved, in microseconds
+     * @param resource_metrics resource metrics of the compilation
+     */
+    void RecordJitCacheData(const std::string                      &module_name,
+                            const bool                              cache_hit,
+                            const uint64_t                          compile_time_saved_us,
+                            const common::ResourceTracker::Metrics &resource_metrics) {
+        if (!ComponentEnabled(MetricsComponent::EXECUTION))
+            METRICS_LOG_WARN("RecordJitCacheData() called without execution metrics enabled.");
+        NOISEPAGE_ASSERT(execution_metric_ != nullptr,
+                         "ExecutionMetric not allocated. Check MetricsStore constructor.");
+        execution_metric_->RecordJitCacheData(module_name, cache_hit, compile_time_saved_us, resource_metrics);
+    }
+
     /**
      * Record metrics for the execution engine when finish a pipeline
      * @param query_id Query Identifier
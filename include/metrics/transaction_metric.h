@@ -27,6 +27,9 @@ public:
         if (!other_db_metric->commit_data_.empty()) {
             commit_data_.splice(commit_data_.cend(), other_db_metric->commit_data_);
         }
+        if (!other_db_metric->version_chain_data_.empty()) {
+            version_chain_data_.splice(version_chain_data_.cend(), other_db_metric->version_chain_data_);
+        }
     }
 
     /**
@@ -52,6 +55,7 @@ public:
 
         auto &begin_outfile = (*outfiles)[0];
         auto &commit_outfile = (*outfiles)[1];
+        auto &version_chain_outfile = (*outfiles)[2];
 
         for (const auto &data : begin_data_) {
             data.resource_metrics_.ToCSV(begin_outfile);
@@ -62,19 +66,28 @@ public:
             data.resource_metrics_.ToCSV(commit_outfile);
             commit_outfile << std::endl;
         }
+        for (const auto &data : version_chain_data_) {
+            version_chain_outfile << data.num_reads_ << ", " << data.num_versions_walked_ << ", "
+                                  << data.num_chains_pruned_ << ", ";
+            data.resource_metrics_.ToCSV(version_chain_outfile);
+            version_chain_outfile << std::endl;
+        }
         begin_data_.clear();
         commit_data_.clear();
+        version_chain_data_.clear();
     }
 
     /**
      * Files to use for writing to CSV.
      */
-    static constexpr std::array<std::string_view, 2> FILES = {"./txn_begin.csv", "./txn_commit.csv"};
+    static constexpr std::array<std::string_view, 3> FILES
+        = {"./txn_begin.csv", "./txn_commit.csv", "./txn_version_chains.csv"};
 
     /**
      * Columns to use for writing to CSV.
      */
-    static constexpr std::array<std::string_view, 2> FEATURE_COLUMNS = {"", "is_readonly"};
+    static constexpr std::array<std::string_view, 3> FEATURE_COLUMNS
+        = {"", "is_readonly", "num_reads, num_versions_walked, num_chains_pruned"};
 
 private:
     friend class TransactionMetric;
@@ -88,6 +101,13 @@ private:
         commit_data_.emplace_back(is_readonly, resource_metrics);
     }
 
+    void RecordVersionChainData(const uint64_t                          num_reads,
+                                const uint64_t                          num_versions_walked,
+                                const uint64_t                          num_chains_pruned,
+                                const common::ResourceTracker::Metrics &resource_metrics) {
+        version_chain_data_.emplace_back(num_reads, num_versions_walked, num_chains_pruned, resource_metrics);
+    }
+
     struct BeginData {
         explicit BeginData(const common::ResourceTracker::Metrics &resource_metrics)
             : resource_metrics_(resource_metrics) {}
@@ -102,12 +122,29 @@ private:
         const common::ResourceTracker::Metrics resource_metrics_;
     };
 
-    std::list<BeginData>  begin_data_;
-    std::list<CommitData> commit_data_;
+    struct VersionChainData {
+        VersionChainData(const uint64_t                          num_reads,
+                         const uint64_t                          num_versions_walked,
+                         const uint64_t                          num_chains_pruned,
+                         const common::ResourceTracker::Metrics &resource_metrics)
+            : num_reads_(num_reads)
+            , num_versions_walked_(num_versions_walked)
+            , num_chains_pruned_(num_chains_pruned)
+            , resource_metrics_(resource_metrics) {}
+        const uint64_t                         num_reads_;
+        const uint64_t                         num_versions_walked_;
+        const uint64_t                         num_chains_pruned_;
+        const common::ResourceTracker::Metrics resource_metrics_;
+    };
+
+    std::list<BeginData>        begin_data_;
+    std::list<CommitData>       commit_data_;
+    std::list<VersionChainData> version_chain_data_;
 };
 
 /**
- * Metrics for the transaction components of the system: currently begin gate and table latch
+ * Metrics for the transaction components of the system: currently begin gate and table latch, and the version chains
+ * walked and pruned by the reads of each committed transaction
  */
 class TransactionMetric : public AbstractMetric<TransactionMetricRawData> {
 private:
@@ -119,5 +156,11 @@ private:
     void RecordCommitData(const uint64_t is_readonly, const common::ResourceTracker::Metrics &resource_metrics) {
         GetRawData()->RecordCommitData(is_readonly, resource_metrics);
     }
+    void RecordVersionChainData(const uint64_t                          num_reads,
+                                const uint64_t                          num_versions_walked,
+                                const uint64_t                          num_chains_pruned,
+                                const common::ResourceTracker::Metrics &resource_metrics) {
+        GetRawData()->RecordVersionChainData(num_reads, num_versions_walked, num_chains_pruned, resource_metrics);
+    }
 };
 } // namespace noisepage::metrics
@@ -36,6 +36,7 @@ public:
         catalog_accessor_ = nullptr;
         callback_ = nullptr;
         callback_arg_ = nullptr;
+        flush_callback_ = nullptr;
         catalog_cache_.Reset(transaction::INITIAL_TXN_TIMESTAMP);
     }
 
@@ -192,6 +193,25 @@ public:
         return callback_arg_;
     }
 
+    /**
+     * @param flush_callback static method in ConnectionHandle that writes out the connection's write queue, called with
+     * the callback arg
+     * @warning only to be used by ConnectionHandle
+     */
+    void SetFlushCallback(const network::NetworkFlushCallback flush_callback) {
+        flush_callback_ = flush_callback;
+    }
+
+    /**
+     * Writes out everything in the connection's write queue to the client, waiting for the socket if it is full. A
+     * command that streams a lot of output calls this between messages so that the output is not all held in memory.
+     * Without a ConnectionHandle, e.g. in tests, the output just stays in the write queue.
+     * @return false if the client went away
+     */
+    auto FlushWrites() const -> bool {
+        return flush_callback_ == nullptr || flush_callback_(callback_arg_);
+    }
+
     /**
      * @return CatalogCache to be injected into requests for CatalogAcessors
      */
@@ -246,6 +266,8 @@ private:
      */
     network::NetworkCallback callback_;
     void                    *callback_arg_;
+    // ConnectionHandle callback to write out the write queue while a command is still executing
+    network::NetworkFlushCallback flush_callback_ = nullptr;
 
     catalog::CatalogCache catalog_cache_;
 };
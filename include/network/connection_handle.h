@@ -112,6 +112,13 @@ public:
      */
     static void Callback(void *callback_args);
 
+    /**
+     * writes out the write queue of a ConnectionHandle while it is still processing a command
+     * @param callback_args this for a ConnectionHandle in PROCESS state
+     * @return false if the client went away
+     */
+    static bool FlushCallback(void *callback_args);
+
 private:
     /** Reset the state of this connection handle for reuse. This should only be called by ConnectionHandleFactory. */
     void ResetForReuse(connection_id_t                               connection_id,
@@ -40,6 +40,9 @@ using ByteBuf = std::vector<uchar>;
 
 using NetworkCallback = void (*)(void *);
 
+/* callback that writes out a connection's write queue, returns false if the client went away */
+using NetworkFlushCallback = bool (*)(void *);
+
 //===--------------------------------------------------------------------===//
 // Network Message Types
 //===--------------------------------------------------------------------===//
@@ -71,6 +74,9 @@ enum class NetworkMessageType : unsigned char {
     PG_PARAMETER_DESCRIPTION = 't',
     PG_ROW_DESCRIPTION = 'T',
     PG_DATA_ROW = 'D',
+    PG_COPY_OUT_RESPONSE = 'H',
+    PG_COPY_DATA = 'd',
+    PG_COPY_DONE = 'c',
     // Commands
     PG_EXECUTE_COMMAND = 'E',
     PG_SYNC_COMMAND = 'S',
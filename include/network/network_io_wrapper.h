@@ -53,6 +53,12 @@ public:
      */
     Transition FlushAllWrites();
 
+    /**
+     * @brief Flushes all writes to this IOWrapper, waiting for the socket whenever it cannot take more
+     * @return false if the client went away
+     */
+    bool FlushAllWritesBlocking();
+
     /**
      * @brief Closes this IOWrapper
      * @return The next transition for this client's state machine
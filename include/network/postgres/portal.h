@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "common/managed_pointer.h"
+#include "common/sanctioned_shared_pointer.h"
 #include "network/postgres/postgres_defs.h"
 #include "network/postgres/statement.h"
 #include "parser/expression/constant_value_expression.h"
@@ -20,6 +21,9 @@ namespace noisepage::network {
  * https://www.postgresql.org/docs/current/protocol-flow.html#PROTOCOL-FLOW-EXT-QUERY)
  * It encapsulates a reference to its originating statement, the parameters (if any), the output formats, and the
  * optimized physical plan. It represents a query ready to be executed.
+ *
+ * The Portal shares ownership of its Statement, which may be replaced in the connection's StatementCache or evicted
+ * from the SharedStatementCache while the Portal is still open.
  */
 class Portal {
 public:
@@ -28,8 +32,8 @@ public:
      * to text for Simple Query protocol per the spec.
      * @param statement statement that this Portal refers to
      */
-    explicit Portal(const common::ManagedPointer<Statement> statement)
-        : Portal(statement, {}, {FieldFormat::text}) {}
+    explicit Portal(common::SanctionedSharedPtr<Statement>::Ptr statement)
+        : Portal(std::move(statement), {}, {FieldFormat::text}) {}
 
     /**
      * Constructor that doesnt have params or result_formats, i.e. Extended Query protocol
@@ -37,10 +41,10 @@ public:
      * @param params params for this query
      * @param result_formats output formats for this query
      */
-    Portal(const common::ManagedPointer<Statement>        statement,
+    Portal(common::SanctionedSharedPtr<Statement>::Ptr    statement,
            std::vector<parser::ConstantValueExpression> &&params,
            std::vector<FieldFormat>                     &&result_formats)
-        : statement_(statement)
+        : statement_(std::move(statement))
         , params_(std::move(params))
         , result_formats_(std::move(result_formats)) {}
 
@@ -48,7 +52,7 @@ public:
      * @return Statement that this Portal references
      */
     common::ManagedPointer<Statement> GetStatement() const {
-        return statement_;
+        return common::ManagedPointer(statement_.get());
     }
 
     /**
@@ -81,9 +85,9 @@ public:
     }
 
 private:
-    const common::ManagedPointer<network::Statement> statement_;
-    std::vector<parser::ConstantValueExpression>     params_;
-    const std::vector<FieldFormat>                   result_formats_;
+    const common::SanctionedSharedPtr<network::Statement>::Ptr statement_;
+    std::vector<parser::ConstantValueExpression>               params_;
+    const std::vector<FieldFormat>                             result_formats_;
 };
 
 } // namespace noisepage::network
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <sys/uio.h>
+
 #include <string>
 #include <vector>
 
@@ -180,6 +182,23 @@ public:
                       const std::vector<planner::OutputSchema::Column> &columns,
                       const std::vector<FieldFormat>                   &field_formats);
 
+    /**
+     * Tells the client that a COPY ... TO STDOUT in binary format starts
+     * @param num_columns number of columns being copied
+     */
+    void WriteCopyOutResponse(uint16_t num_columns);
+
+    /**
+     * Writes a chunk of COPY data, gathered from the given buffers
+     * @param buffers buffers holding the chunk, in order
+     */
+    void WriteCopyData(const std::vector<iovec> &buffers);
+
+    /**
+     * Tells the client that all COPY data has been sent
+     */
+    void WriteCopyDone();
+
 private:
     template <class native_type, class val_type>
     void WriteBinaryVal(const execution::sql::Val *val, execution::sql::SqlTypeId type);
@@ -159,26 +159,29 @@ public:
      * @param name statement to look up
      * @return managed pointer to statement if it exists, nullptr otherwise
      */
-    auto GetStatement(const std::string &name) const -> common::ManagedPointer<network::Statement> {
+    auto GetStatement(const std::string &name) const -> common::SanctionedSharedPtr<network::Statement>::Ptr {
         const auto it = statements_.find(name);
         if (it != statements_.end()) {
-            return {it->second};
+            return it->second;
         }
         return nullptr;
     }
 
     /**
-     * @param statement statement to take ownership of
+     * @param query_text key to add the statement under
+     * @param statement statement to share ownership of
      */
-    void AddStatementToCache(std::unique_ptr<network::Statement> &&statement) {
-        cache_.Add(std::move(statement));
+    void AddStatementToCache(const std::string                                   &query_text,
+                             common::SanctionedSharedPtr<network::Statement>::Ptr statement) {
+        cache_.Add(query_text, std::move(statement));
     }
 
     /**
      * @param query_text key to look up
      * @return Statement if it exists in the cache, otherwise nullptr
      */
-    auto LookupStatementInCache(const std::string &query_text) const -> common::ManagedPointer<network::Statement> {
+    auto LookupStatementInCache(const std::string &query_text) const
+        -> common::SanctionedSharedPtr<network::Statement>::Ptr {
         return cache_.Lookup(query_text);
     }
 
@@ -186,8 +189,24 @@ public:
      * @param name key
      * @param statement statement to create a mapping to for this name
      */
-    void SetStatement(const std::string &name, const common::ManagedPointer<network::Statement> statement) {
-        statements_[name] = statement;
+    void SetStatement(const std::string &name, common::SanctionedSharedPtr<network::Statement>::Ptr statement) {
+        statements_[name] = std::move(statement);
+    }
+
+    /**
+     * Replace a statement with another one in the cache and under all of its names. Portals that were constructed from
+     * the statement keep it alive until they are closed.
+     * @param statement statement to be replaced
+     * @param replacement statement to replace it with
+     */
+    void ReplaceStatement(const common::ManagedPointer<network::Statement>            statement,
+                          const common::SanctionedSharedPtr<network::Statement>::Ptr &replacement) {
+        cache_.Replace(statement, replacement);
+        for (auto &it : statements_) {
+            if (it.second.get() == statement.Get()) {
+                it.second = replacement;
+            }
+        }
     }
 
     /**
@@ -198,7 +217,7 @@ public:
     void CloseStatement(const std::string &name) {
         const auto it = statements_.find(name);
         if (it != statements_.end()) {
-            ClosePortalsConstructedFromStatement(common::ManagedPointer(it->second));
+            ClosePortalsConstructedFromStatement(common::ManagedPointer(it->second.get()));
             statements_.erase(it);
         }
     }
@@ -254,7 +273,7 @@ private:
     StatementCache cache_;
 
     // name to statement
-    std::unordered_map<std::string, common::ManagedPointer<network::Statement>> statements_;
+    std::unordered_map<std::string, common::SanctionedSharedPtr<network::Statement>::Ptr> statements_;
 
     // name to portal
     std::unordered_map<std::string, std::unique_ptr<network::Portal>> portals_;
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/macros.h"
+#include "common/sanctioned_shared_pointer.h"
+#include "common/spin_latch.h"
+#include "execution/sql/sql.h"
+#include "transaction/transaction_defs.h"
+
+namespace noisepage::network {
+
+class Statement;
+
+/**
+ * Server-wide cache of prepared Statements, shared by all of the connections. A connection that executes a DML
+ * statement of the Extended Query protocol publishes the Statement once it is bound, optimized and compiled, and any
+ * connection that later parses the same query text with the same parameter types in the same database reuses its
+ * physical plan and ExecutableQuery instead of binding, optimizing and compiling it again.
+ *
+ * Published Statements are immutable (@see Statement::MarkShared). A connection that needs to change the cached
+ * objects of a shared Statement (e.g., because they are stale) replaces it with a private copy instead.
+ *
+ * The cache is keyed on the normalized query text, the parameter types and the database. Entries are invalidated as a
+ * whole when the catalog or the statistics change (@see Invalidate): entries generated by a transaction that started
+ * before the invalidation are never returned or added, which plays the role of the catalog version in the key. The
+ * cache is bounded by an estimate of the memory that its entries take, and evicts the least recently used entries.
+ *
+ * SanctionedSharedPtr:
+ *   1. The cache and every connection that uses a Statement own it. A Statement is created by the connection that
+ *      parses it, and freed when it has been evicted and all of the connections have released it (closed the portals
+ *      and named statements that refer to it, or replaced it in their own StatementCache).
+ *   2. Connections hold on to a Statement across network messages while the cache may evict it at any time, so
+ *      neither one outlives the other. Statements do not point back to the cache or to other Statements.
+ *   3. Copying the Statement for every connection would mean binding, optimizing and compiling it again, which is what
+ *      this cache avoids.
+ */
+class SharedStatementCache {
+public:
+    /**
+     * @param size_limit memory (in bytes) that the cached Statements may take before the cache starts evicting
+     */
+    explicit SharedStatementCache(uint64_t size_limit)
+        : size_limit_(size_limit) {}
+
+    DISALLOW_COPY_AND_MOVE(SharedStatementCache)
+
+    /**
+     * Look up a Statement that was published by any connection
+     * @param db_oid database of the connection
+     * @param query_text query text as it came across the wire
+     * @param param_types types of the parameters of the query
+     * @return the cached Statement if it exists, nullptr otherwise
+     */
+    auto Lookup(catalog::db_oid_t                             db_oid,
+                const std::string                            &query_text,
+                const std::vector<execution::sql::SqlTypeId> &param_types)
+        -> common::SanctionedSharedPtr<Statement>::Ptr;
+
+    /**
+     * Publish a Statement to the other connections, marking it shared. The Statement must have been compiled. If an
+     * equivalent Statement was published in the meantime, or the Statement is older than the last invalidation, it is
+     * not added.
+     * @param db_oid database of the connection
+     * @param statement Statement to publish
+     * @return true if the Statement was added to the cache
+     */
+    auto Add(catalog::db_oid_t db_oid, const common::SanctionedSharedPtr<Statement>::Ptr &statement) -> bool;
+
+    /**
+     * Evict all of the cached Statements, and reject Statements generated by transactions that started before the given
+     * timestamp from now on. Connections can still run the Statements they hold until they notice that they are stale.
+     * @param timestamp timestamp at which the catalog or the statistics changed
+     */
+    void Invalidate(transaction::timestamp_t timestamp);
+
+    /**
+     * @param size_limit memory (in bytes) that the cached Statements may take, evicting Statements right away if needed
+     */
+    void SetSizeLimit(uint64_t size_limit);
+
+    /** @return memory (in bytes) that the cached Statements take, as estimated by the cache */
+    auto GetSize() const -> uint64_t {
+        return size_.load();
+    }
+
+    /** @return number of cached Statements */
+    auto GetNumEntries() const -> uint64_t {
+        return num_entries_.load();
+    }
+
+    /** @return number of lookups that found a Statement */
+    auto GetNumHits() const -> uint64_t {
+        return num_hits_.load();
+    }
+
+    /** @return number of lookups that did not find a Statement */
+    auto GetNumMisses() const -> uint64_t {
+        return num_misses_.load();
+    }
+
+    /** @return number of Statements evicted to stay under the size limit */
+    auto GetNumEvictions() const -> uint64_t {
+        return num_evictions_.load();
+    }
+
+    /**
+     * Normalize query text so that queries that only differ in the whitespace between their tokens share a Statement.
+     * Query text that contains comments, dollar-quoted strings or escape strings is returned unchanged since we cannot
+     * tell tokens apart without parsing it.
+     * @param query_text query text as it came across the wire
+     * @return normalized query text
+     */
+    static auto NormalizeQueryText(const std::string &query_text) -> std::string;
+
+    /**
+     * @param statement compiled Statement
+     * @return estimate of the memory (in bytes) that the Statement takes
+     */
+    static auto EstimateSize(const Statement &statement) -> uint64_t;
+
+private:
+    struct Key {
+        catalog::db_oid_t                      db_oid_;
+        std::string                            query_text_;
+        std::vector<execution::sql::SqlTypeId> param_types_;
+
+        auto operator==(const Key &other) const -> bool {
+            return db_oid_ == other.db_oid_ && query_text_ == other.query_text_ && param_types_ == other.param_types_;
+        }
+    };
+
+    struct KeyHasher {
+        auto operator()(const Key &key) const -> std::size_t;
+    };
+
+    struct Entry {
+        common::SanctionedSharedPtr<Statement>::Ptr statement_;
+        uint64_t                                    size_;
+        std::list<Key>::iterator                    lru_position_;
+    };
+
+    // Evict the least recently used entries until the cache fits in the size limit, handing them to the caller so that
+    // the Statements are freed outside of the latch. Must hold the latch.
+    void EvictToSizeLimit(std::vector<common::SanctionedSharedPtr<Statement>::Ptr> *evicted);
+
+    // Must hold the latch
+    auto IsStale(const Statement &statement) const -> bool;
+
+    common::SpinLatch                         latch_;
+    std::unordered_map<Key, Entry, KeyHasher> entries_;
+    // Keys of the entries, from the most to the least recently used
+    std::list<Key>                            lru_;
+    uint64_t                                  size_limit_;
+    transaction::timestamp_t                  min_timestamp_ = transaction::INITIAL_TXN_TIMESTAMP;
+
+    std::atomic<uint64_t> size_ = 0;
+    std::atomic<uint64_t> num_entries_ = 0;
+    std::atomic<uint64_t> num_hits_ = 0;
+    std::atomic<uint64_t> num_misses_ = 0;
+    std::atomic<uint64_t> num_evictions_ = 0;
+};
+
+} // namespace noisepage::network
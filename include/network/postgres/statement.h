@@ -22,6 +22,9 @@ namespace noisepage::network {
  * For caching purposes, it also takes ownership of the physical plan and the ExecutableQuery after code generation.
  * This allows for a single fingerprint to reference this prepared statement be bound and executed with different
  * parameters multiple times.
+ *
+ * Once compiled, a Statement can be published to the other connections through the SharedStatementCache. From then
+ * on, the cached objects are shared and cannot be modified anymore.
  */
 class Statement {
 public:
@@ -113,6 +116,7 @@ public:
      * @param optimize_result optimize result to take ownership of
      */
     void SetOptimizeResult(std::unique_ptr<optimizer::OptimizeResult> &&optimize_result) {
+        NOISEPAGE_ASSERT(!shared_, "Shared Statements cannot be modified.");
         optimize_result_ = std::move(optimize_result);
     }
 
@@ -120,6 +124,7 @@ public:
      * @param executable_query executable query to take ownership of
      */
     void SetExecutableQuery(std::unique_ptr<execution::compiler::ExecutableQuery> &&executable_query) {
+        NOISEPAGE_ASSERT(!shared_, "Shared Statements cannot be modified.");
         executable_query_ = std::move(executable_query);
     }
 
@@ -129,6 +134,7 @@ public:
      * bindings
      */
     void SetDesiredParamTypes(std::vector<execution::sql::SqlTypeId> &&desired_param_types) {
+        NOISEPAGE_ASSERT(!shared_, "Shared Statements cannot be modified.");
         desired_param_types_ = std::move(desired_param_types);
         NOISEPAGE_ASSERT(desired_param_types_.size() == param_types_.size(), "");
     }
@@ -147,11 +153,28 @@ public:
      * DDL change related to this statement.
      */
     void ClearCachedObjects() {
+        NOISEPAGE_ASSERT(!shared_, "Shared Statements cannot be modified.");
         optimize_result_ = nullptr;
         executable_query_ = nullptr;
         desired_param_types_ = {};
     }
 
+    /**
+     * Mark the Statement as published to other connections. Its cached objects cannot be modified from now on, since
+     * other connections may be running them concurrently.
+     */
+    void MarkShared() {
+        NOISEPAGE_ASSERT(executable_query_ != nullptr, "Only compiled Statements should be shared.");
+        shared_ = true;
+    }
+
+    /**
+     * @return true if the Statement was published to other connections, false otherwise
+     */
+    auto IsShared() const -> bool {
+        return shared_;
+    }
+
 private:
     const std::string                            query_text_;
     const std::unique_ptr<parser::ParseResult>   parse_result_ = nullptr;
@@ -165,6 +188,7 @@ private:
     std::unique_ptr<optimizer::OptimizeResult>            optimize_result_ = nullptr;  // generated in the Bind phase
     std::unique_ptr<execution::compiler::ExecutableQuery> executable_query_ = nullptr; // generated in the Execute phase
     std::vector<execution::sql::SqlTypeId>                desired_param_types_;        // generated in the Bind phase
+    bool                                                  shared_ = false;             // set when published
 };
 
 } // namespace noisepage::network
@@ -6,6 +6,7 @@
 #include <utility>
 
 #include "common/managed_pointer.h"
+#include "common/sanctioned_shared_pointer.h"
 #include "network/postgres/statement.h"
 #include "xxHash/xxh3.h"
 
@@ -15,6 +16,9 @@ namespace noisepage::network {
  * Simple statement cache. It contains a map from query string to Statement objects, allowing for reuse of bound parser
  * result, physical plan, and codegen'd executable query if appropriate. Can be extended in the future to have a maximum
  * size, replacement policy, etc.
+ *
+ * There is one per connection. The Statements may also be owned by the SharedStatementCache and other connections
+ * (@see SharedStatementCache for the SanctionedSharedPtr rationale).
  */
 class StatementCache {
 public:
@@ -23,19 +27,35 @@ public:
      * @param query_text key to look up
      * @return pointer to Statement object if it already exists, nullptr otherwise
      */
-    common::ManagedPointer<Statement> Lookup(const std::string &query_text) const {
+    common::SanctionedSharedPtr<Statement>::Ptr Lookup(const std::string &query_text) const {
         const auto it = cache_.find(query_text);
         if (it != cache_.end())
-            return common::ManagedPointer(it->second);
+            return it->second;
         return nullptr;
     }
 
     /**
-     * Transfer ownership of a Statement to the cache
-     * @param statement object to take ownership of
+     * Share ownership of a Statement with the cache
+     * @param query_text key to add the Statement under, which may differ from the Statement's query text if it was
+     * found in the SharedStatementCache
+     * @param statement object to share ownership of
      */
-    void Add(std::unique_ptr<network::Statement> &&statement) {
-        cache_[statement->GetQueryText()] = std::move(statement);
+    void Add(const std::string &query_text, common::SanctionedSharedPtr<Statement>::Ptr statement) {
+        cache_[query_text] = std::move(statement);
+    }
+
+    /**
+     * Replace all of the mappings to a Statement with mappings to another Statement
+     * @param statement Statement to be replaced
+     * @param replacement Statement to replace it with
+     */
+    void Replace(const common::ManagedPointer<Statement>            statement,
+                 const common::SanctionedSharedPtr<Statement>::Ptr &replacement) {
+        for (auto &it : cache_) {
+            if (it.second.get() == statement.Get()) {
+                it.second = replacement;
+            }
+        }
     }
 
 private:
@@ -48,7 +68,7 @@ private:
         }
     };
 
-    std::unordered_map<std::string, std::unique_ptr<Statement>, FastStringHasher> cache_;
+    std::unordered_map<std::string, common::SanctionedSharedPtr<Statement>::Ptr, FastStringHasher> cache_;
 };
 
 } // namespace noisepage::network
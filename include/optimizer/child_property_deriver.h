@@ -153,6 +153,13 @@ namespace optimizer {
          * @param op LeftSemiHashJoin operator to visit
          */
         void Visit(const LeftSemiHashJoin *op) override;
+
+        /**
+         * Visitor function for InnerMergeJoin
+         * @param op InnerMergeJoin operator to visit
+         */
+        void Visit(const InnerMergeJoin *op) override;
+
         /**
          * Visitor function for Insert
          * @param op Insert operator to visit
@@ -195,6 +202,12 @@ namespace optimizer {
          */
         void Visit(const Aggregate *op) override;
 
+        /**
+         * Visitor function for Window
+         * @param op Window operator to visit
+         */
+        void Visit(const Window *op) override;
+
         /**
          * Visitor function for ExportExternalFile
          * @param op ExportExternalFile operator to visit
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+namespace noisepage::optimizer {
+
+class AbstractCostModel;
+
+/**
+ * The cost models that the optimizer can be configured to use
+ */
+enum class CostModelType : uint8_t {
+    TRIVIAL, ///< TrivialCostModel, which costs operators with fixed constants
+    STATS    ///< StatsCostModel, which costs operators with the cardinalities estimated from table statistics
+};
+
+/**
+ * Static utility functions for cost models
+ */
+class CostModelUtil {
+public:
+    CostModelUtil() = delete;
+
+    /**
+     * Converts a cost model string to the enum.
+     * Mainly used to convert a settings flag (string) to internal enum.
+     * @param cost_model cost model string
+     * @return CostModelType corresponding to it
+     */
+    static std::optional<CostModelType> FromCostModelString(const std::string_view &cost_model) {
+        std::optional<CostModelType> type{std::nullopt};
+        if (cost_model == "TRIVIAL") {
+            type = CostModelType::TRIVIAL;
+        } else if (cost_model == "STATS") {
+            type = CostModelType::STATS;
+        }
+        return type;
+    }
+
+    /**
+     * Instantiates a cost model for a single optimizer invocation
+     * @param type type of the cost model
+     * @return the cost model
+     */
+    static std::unique_ptr<AbstractCostModel> CreateCostModel(CostModelType type);
+};
+
+} // namespace noisepage::optimizer
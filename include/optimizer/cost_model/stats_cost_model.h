@@ -0,0 +1,253 @@
+#pragma once
+
+#include "common/macros.h"
+#include "optimizer/cost_model/abstract_cost_model.h"
+
+namespace noisepage::optimizer {
+
+class Group;
+class Memo;
+class GroupExpression;
+
+/**
+ * This cost model costs operators with the cardinalities that the StatsCalculator derives for the groups of the memo,
+ * which come from the table statistics collected by ANALYZE and the predicate selectivities of SelectivityUtil. The
+ * cost of an operator is the time spent by the operator itself in abstract units, excluding the cost of its children:
+ * - scans pay for every tuple they touch, and random accesses through an index are more expensive than sequential ones
+ * - nested loop joins pay for every pair of tuples, hash joins pay to build a hash table on their left (build) child
+ *   and to probe it with every tuple of their right (probe) child
+ * - sorts pay n log n comparisons, and every operator pays for the tuples that it outputs
+ * Groups whose cardinality is unknown are costed as if they were empty.
+ */
+class StatsCostModel : public AbstractCostModel {
+public:
+    /** Cost of producing a tuple for the parent operator */
+    static constexpr double CPU_TUPLE_COST = 0.01;
+
+    /** Cost of evaluating a predicate or comparing two tuples */
+    static constexpr double CPU_OPERATOR_COST = 0.0025;
+
+    /** Cost of reading a tuple during a sequential scan of a table */
+    static constexpr double SEQ_ACCESS_COST = 0.005;
+
+    /** Cost of reading a tuple of a table through an index, which is a random access */
+    static constexpr double RANDOM_ACCESS_COST = 0.02;
+
+    /** Cost of traversing an index down to the first tuple that matches a lookup */
+    static constexpr double INDEX_LOOKUP_COST = 0.05;
+
+    /** Cost of hashing a tuple and inserting it into a hash table, including the memory it takes */
+    static constexpr double HASH_BUILD_COST = 0.02;
+
+    /** Cost of hashing a tuple and probing a hash table with it */
+    static constexpr double HASH_PROBE_COST = 0.01;
+
+    /**
+     * Default constructor
+     */
+    StatsCostModel() = default;
+
+    /**
+     * Costs a GroupExpression
+     * @param txn TransactionContext that query is generated under
+     * @param accessor CatalogAccessor
+     * @param memo Memo object containing all relevant groups
+     * @param gexpr GroupExpression to calculate cost for
+     */
+    double CalculateCost(transaction::TransactionContext *txn,
+                         catalog::CatalogAccessor        *accessor,
+                         Memo                            *memo,
+                         GroupExpression                 *gexpr) override;
+
+    /**
+     * Visit a SeqScan operator
+     * @param op operator
+     */
+    void Visit(const SeqScan *op) override;
+
+    /**
+     * Visit a IndexScan operator
+     * @param op operator
+     */
+    void Visit(const IndexScan *op) override;
+
+    /**
+     * Visit a QueryDerivedScan operator
+     * @param op operator
+     */
+    void Visit(const QueryDerivedScan *op) override;
+
+    /**
+     * Visit a OrderBy operator
+     * @param op operator
+     */
+    void Visit(const OrderBy *op) override;
+
+    /**
+     * Visit a Limit operator
+     * @param op operator
+     */
+    void Visit(const Limit *op) override;
+
+    /**
+     * Visit a InnerIndexJoin operator
+     * @param op operator
+     */
+    void Visit(const InnerIndexJoin *op) override;
+
+    /**
+     * Visit a InnerNLJoin operator
+     * @param op operator
+     */
+    void Visit([[maybe_unused]] const InnerNLJoin *op) override {
+        CostNLJoin();
+    }
+
+    /**
+     * Visit a LeftNLJoin operator
+     * @param op operator
+     */
+    void Visit([[maybe_unused]] const LeftNLJoin *op) override {
+        CostNLJoin();
+    }
+
+    /**
+     * Visit a RightNLJoin operator
+     * @param op operator
+     */
+    void Visit([[maybe_unused]] const RightNLJoin *op) override {
+        CostNLJoin();
+    }
+
+    /**
+     * Visit a OuterNLJoin operator
+     * @param op operator
+     */
+    void Visit([[maybe_unused]] const OuterNLJoin *op) override {
+        CostNLJoin();
+    }
+
+    /**
+     * Visit a InnerHashJoin operator
+     * @param op operator
+     */
+    void Visit([[maybe_unused]] const InnerHashJoin *op) override {
+        CostHashJoin();
+    }
+
+    /**
+     * Visit a LeftHashJoin operator
+     * @param op operator
+     */
+    void Visit([[maybe_unused]] const LeftHashJoin *op) override {
+        CostHashJoin();
+    }
+
+    /**
+     * Visit a RightHashJoin operator
+     * @param op operator
+     */
+    void Visit([[maybe_unused]] const RightHashJoin *op) override {
+        CostHashJoin();
+    }
+
+    /**
+     * Visit a OuterHashJoin operator
+     * @param op operator
+     */
+    void Visit([[maybe_unused]] const OuterHashJoin *op) override {
+        CostHashJoin();
+    }
+
+    /**
+     * Visit a LeftSemiHashJoin operator
+     * @param op operator
+     */
+    void Visit([[maybe_unused]] const LeftSemiHashJoin *op) override {
+        CostHashJoin();
+    }
+
+    /**
+     * Visit a InnerMergeJoin operator
+     * @param op operator
+     */
+    void Visit([[maybe_unused]] const InnerMergeJoin *op) override {
+        CostMergeJoin();
+    }
+
+    /**
+     * Visit a HashGroupBy operator
+     * @param op operator
+     */
+    void Visit(const HashGroupBy *op) override;
+
+    /**
+     * Visit a SortGroupBy operator
+     * @param op operator
+     */
+    void Visit(const SortGroupBy *op) override;
+
+    /**
+     * Visit a Aggregate operator
+     * @param op operator
+     */
+    void Visit(const Aggregate *op) override;
+
+    /**
+     * Visit a Window operator
+     * @param op operator
+     */
+    void Visit(const Window *op) override;
+
+private:
+    /**
+     * @param group group of the memo
+     * @return estimated number of tuples output by the group, 0 if it is unknown
+     */
+    static double NumRows(Group *group);
+
+    /** @return estimated number of tuples output by the expression being costed */
+    double OutputRows() const;
+
+    /**
+     * @param child_idx index of the child
+     * @return estimated number of tuples output by a child of the expression being costed
+     */
+    double ChildRows(int child_idx) const;
+
+    /** Costs a nested loop join, which evaluates the join predicate on every pair of tuples of its children */
+    void CostNLJoin();
+
+    /** Costs a hash join, which builds a hash table on its left child and probes it with its right child */
+    void CostHashJoin();
+
+    /** Costs a merge join, which merges its children sorted on the join keys in a single pass over both of them */
+    void CostMergeJoin();
+
+    /**
+     * GroupExpression to cost
+     */
+    GroupExpression *gexpr_;
+
+    /**
+     * Memo table to use
+     */
+    Memo *memo_;
+
+    /**
+     * Transaction Context
+     */
+    transaction::TransactionContext *txn_;
+
+    /**
+     * Accessor
+     */
+    catalog::CatalogAccessor *accessor_;
+
+    /**
+     * Computed output cost
+     */
+    double output_cost_ = 0;
+};
+
+} // namespace noisepage::optimizer
@@ -148,6 +148,14 @@ public:
         output_cost_ = 1.f;
     }
 
+    /**
+     * Visit a InnerMergeJoin operator
+     * @param op operator
+     */
+    void Visit([[maybe_unused]] const InnerMergeJoin *op) override {
+        output_cost_ = NLJOIN_COST + 2.0f;
+    }
+
     /**
      * Visit a Insert operator
      * @param op operator
@@ -196,6 +204,14 @@ public:
         output_cost_ = 0.f;
     }
 
+    /**
+     * Visit a Window operator
+     * @param op operator
+     */
+    void Visit([[maybe_unused]] const Window *op) override {
+        output_cost_ = 0.f;
+    }
+
 private:
     /**
      * GroupExpression to cost
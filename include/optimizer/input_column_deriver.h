@@ -170,6 +170,12 @@ public:
      */
     void Visit(const LeftSemiHashJoin *op) override;
 
+    /**
+     * Visit function to derive input/output columns for InnerMergeJoin
+     * @param op InnerMergeJoin operator to visit
+     */
+    void Visit(const InnerMergeJoin *op) override;
+
     /**
      * Visit function to derive input/output columns for TableFreeScan
      * @param op TableFreeScan operator to visit
@@ -212,6 +218,12 @@ public:
      */
     void Visit(const Aggregate *op) override;
 
+    /**
+     * Visit function to derive input/output columns for Window
+     * @param op Window operator to visit
+     */
+    void Visit(const Window *op) override;
+
     /**
      * Visit function to derive input/output columns for ExportExternalFile
      * @param op ExportExternalFile operator to visit
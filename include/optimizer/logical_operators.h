@@ -755,6 +755,42 @@ private:
     std::vector<AnnotatedExpression> having_;
 };
 
+/**
+ * Logical operator that computes window functions over the same window (PARTITION BY and ORDER BY) and appends their
+ * values to the tuples of its child
+ */
+class LogicalWindow : public OperatorNodeContents<LogicalWindow> {
+public:
+    /**
+     * @param window_exprs window functions to compute, which should all have the same window
+     * @return a Window operator
+     */
+    static Operator Make(std::vector<common::ManagedPointer<parser::AbstractExpression>> &&window_exprs);
+
+    /**
+     * Copy
+     * @returns copy of this
+     */
+    BaseOperatorNodeContents *Copy() const override;
+
+    bool operator==(const BaseOperatorNodeContents &r) override;
+
+    common::hash_t Hash() const override;
+
+    /**
+     * @return window functions to compute
+     */
+    const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetWindowExprs() const {
+        return window_exprs_;
+    }
+
+private:
+    /**
+     * Window functions to compute
+     */
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> window_exprs_;
+};
+
 /**
  * Logical operation for an Insert
  */
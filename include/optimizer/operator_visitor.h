@@ -18,6 +18,7 @@ class OuterNLJoin;
 class InnerHashJoin;
 class LeftHashJoin;
 class LeftSemiHashJoin;
+class InnerMergeJoin;
 class RightHashJoin;
 class OuterHashJoin;
 class Insert;
@@ -28,6 +29,7 @@ class HashGroupBy;
 class SortGroupBy;
 class Aggregate;
 class CteScan;
+class Window;
 class ExportExternalFile;
 class CreateDatabase;
 class CreateFunction;
@@ -79,6 +81,7 @@ class LogicalDropTrigger;
 class LogicalDropView;
 class LogicalAnalyze;
 class LogicalCteScan;
+class LogicalWindow;
 
 /**
  * Utility class for visitor pattern
@@ -195,6 +198,12 @@ public:
      */
     virtual void Visit(const LeftSemiHashJoin *left_semi_hash_join) {}
 
+    /**
+     * Visit a InnerMergeJoin operator
+     * @param inner_merge_join operator
+     */
+    virtual void Visit(const InnerMergeJoin *inner_merge_join) {}
+
     /**
      * Visit a Insert operator
      * @param insert operator
@@ -332,6 +341,12 @@ public:
      */
     virtual void Visit(const CteScan *cte_scan) {}
 
+    /**
+     * Visit a Window operator
+     * @param window operator
+     */
+    virtual void Visit(const Window *window) {}
+
     /**
      * Visit a LogicalGet operator
      * @param logical_get operator
@@ -547,6 +562,12 @@ public:
      * @param logical_union a logicalunion operator
      */
     virtual void Visit(const LogicalUnion *logical_union) {}
+
+    /**
+     * Visit a LogicalWindow operator
+     * @param logical_window operator
+     */
+    virtual void Visit(const LogicalWindow *logical_window) {}
 };
 
 } // namespace noisepage::optimizer
@@ -82,6 +82,7 @@ enum class OpType {
     LOGICALANALYZE,
     LOGICALCTESCAN,
     LOGICALUNION,
+    LOGICALWINDOW,
     // Separation of logical and physical operators
     LOGICALPHYSICALDELIMITER,
 
@@ -103,6 +104,7 @@ enum class OpType {
     RIGHTHASHJOIN,
     OUTERHASHJOIN,
     LEFTSEMIHASHJOIN,
+    INNERMERGEJOIN,
     INSERT,
     INSERTSELECT,
     DELETE,
@@ -126,7 +128,8 @@ enum class OpType {
     DROPTRIGGER,
     DROPVIEW,
     ANALYZE,
-    CTESCAN
+    CTESCAN,
+    WINDOW
 };
 
 /**
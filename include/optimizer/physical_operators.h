@@ -1012,6 +1012,70 @@ namespace optimizer {
         common::ManagedPointer<parser::AbstractExpression> join_predicate_;
     };
 
+    /**
+     * Physical operator for inner sort-merge join. Both children are required to be sorted ascending on their join
+     * keys, and the output is sorted on the right join keys.
+     */
+    class InnerMergeJoin : public OperatorNodeContents<InnerMergeJoin> {
+    public:
+        /**
+         * @param join_predicates predicates for join
+         * @param left_keys left keys to join
+         * @param right_keys right keys to join
+         * @return an InnerMergeJoin operator
+         */
+        static Operator Make(std::vector<AnnotatedExpression>                                &&join_predicates,
+                             std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_keys,
+                             std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_keys);
+
+        /**
+         * Copy
+         * @returns copy of this
+         */
+        BaseOperatorNodeContents *Copy() const override;
+
+        bool operator==(const BaseOperatorNodeContents &r) override;
+
+        common::hash_t Hash() const override;
+
+        /**
+         * @return Left join keys
+         */
+        const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetLeftKeys() const {
+            return left_keys_;
+        }
+
+        /**
+         * @return Right join keys
+         */
+        const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetRightKeys() const {
+            return right_keys_;
+        }
+
+        /**
+         * @return Predicates for the Join
+         */
+        const std::vector<AnnotatedExpression> &GetJoinPredicates() const {
+            return join_predicates_;
+        }
+
+    private:
+        /**
+         * Left join keys
+         */
+        std::vector<common::ManagedPointer<parser::AbstractExpression>> left_keys_;
+
+        /**
+         * Right join keys
+         */
+        std::vector<common::ManagedPointer<parser::AbstractExpression>> right_keys_;
+
+        /**
+         * Predicate for join
+         */
+        std::vector<AnnotatedExpression> join_predicates_;
+    };
+
     /**
      * Physical operator for INSERT
      */
@@ -1466,6 +1530,41 @@ namespace optimizer {
         std::vector<AnnotatedExpression> having_;
     };
 
+    /**
+     * Physical operator for window functions that share the same window, using sorting
+     */
+    class Window : public OperatorNodeContents<Window> {
+    public:
+        /**
+         * @param window_exprs window functions to compute, all over the same PARTITION BY and ORDER BY
+         * @return a Window operator
+         */
+        static Operator Make(std::vector<common::ManagedPointer<parser::AbstractExpression>> &&window_exprs);
+
+        /**
+         * Copy
+         * @returns copy of this
+         */
+        BaseOperatorNodeContents *Copy() const override;
+
+        bool operator==(const BaseOperatorNodeContents &r) override;
+
+        common::hash_t Hash() const override;
+
+        /**
+         * @return vector of window functions
+         */
+        const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetWindowExprs() const {
+            return window_exprs_;
+        }
+
+    private:
+        /**
+         * Window functions to compute
+         */
+        std::vector<common::ManagedPointer<parser::AbstractExpression>> window_exprs_;
+    };
+
     /**
      * Physical operator for aggregate functions
      */
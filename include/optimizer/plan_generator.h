@@ -182,6 +182,12 @@ namespace optimizer {
          */
         void Visit(const LeftSemiHashJoin *op) override;
 
+        /**
+         * Visitor function for a InnerMergeJoin operator
+         * @param op InnerMergeJoin operator being visited
+         */
+        void Visit(const InnerMergeJoin *op) override;
+
         /**
          * Visitor function for a Insert operator
          * @param op Insert operator being visited
@@ -224,6 +230,12 @@ namespace optimizer {
          */
         void Visit(const Aggregate *op) override;
 
+        /**
+         * Visitor function for a Window operator
+         * @param op Window operator being visited
+         */
+        void Visit(const Window *op) override;
+
         /**
          * Visitor function for a ExportExternalFile operator
          * @param op ExportExternalFile operator being visited
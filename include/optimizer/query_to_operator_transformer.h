@@ -135,6 +135,15 @@ namespace optimizer {
          */
         static auto RequireAggregation(common::ManagedPointer<parser::SelectStatement> op) -> bool;
 
+        /**
+         * Collect the window functions of the select statement, grouped by window. Window functions over the same
+         * PARTITION BY and ORDER BY are computed by the same window operator.
+         * @param op The select statement
+         * @return window functions of each window, in the order the windows appear in the select list
+         */
+        static auto CollectWindows(common::ManagedPointer<parser::SelectStatement> op)
+            -> std::vector<std::vector<common::ManagedPointer<parser::AbstractExpression>>>;
+
         /**
          * Extract single table precates and multi-table predicates from the expr
          * @param expr The original predicate
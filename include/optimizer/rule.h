@@ -33,10 +33,12 @@ enum class RuleType : uint32_t {
     INSERT_SELECT_TO_PHYSICAL,
     AGGREGATE_TO_HASH_AGGREGATE,
     AGGREGATE_TO_PLAIN_AGGREGATE,
+    WINDOW_TO_PHYSICAL,
     INNER_JOIN_TO_INDEX_JOIN,
     INNER_JOIN_TO_NL_JOIN,
     SEMI_JOIN_TO_HASH_JOIN,
     INNER_JOIN_TO_HASH_JOIN,
+    INNER_JOIN_TO_MERGE_JOIN,
     LEFT_JOIN_TO_HASH_JOIN,
     IMPLEMENT_DISTINCT,
     IMPLEMENT_LIMIT,
@@ -345,6 +345,35 @@ public:
                    OptimizationContext                                 *context) const override;
 };
 
+/**
+ * Rule transforms LogicalWindow -> Window
+ */
+class LogicalWindowToPhysicalWindow : public Rule {
+public:
+    /**
+     * Constructor
+     */
+    LogicalWindowToPhysicalWindow();
+
+    /**
+     * Checks whether the given rule can be applied
+     * @param plan AbstractOptimizerNode to check
+     * @param context Current OptimizationContext executing under
+     * @returns Whether the input AbstractOptimizerNode passes the check
+     */
+    bool Check(common::ManagedPointer<AbstractOptimizerNode> plan, OptimizationContext *context) const override;
+
+    /**
+     * Transforms the input expression using the given rule
+     * @param input Input AbstractOptimizerNode to transform
+     * @param transformed Vector of transformed AbstractOptimizerNodes
+     * @param context Current OptimizationContext executing under
+     */
+    void Transform(common::ManagedPointer<AbstractOptimizerNode>        input,
+                   std::vector<std::unique_ptr<AbstractOptimizerNode>> *transformed,
+                   OptimizationContext                                 *context) const override;
+};
+
 /**
  * Rule transforms Logical Inner Join to InnerIndexJoin
  */
@@ -461,6 +490,35 @@ public:
                    OptimizationContext                                 *context) const override;
 };
 
+/**
+ * Rule transforms Logical Inner Join to InnerMergeJoin
+ */
+class LogicalInnerJoinToPhysicalInnerMergeJoin : public Rule {
+public:
+    /**
+     * Constructor
+     */
+    LogicalInnerJoinToPhysicalInnerMergeJoin();
+
+    /**
+     * Checks whether the given rule can be applied
+     * @param plan AbstractOptimizerNode to check
+     * @param context Current OptimizationContext executing under
+     * @returns Whether the input AbstractOptimizerNode passes the check
+     */
+    bool Check(common::ManagedPointer<AbstractOptimizerNode> plan, OptimizationContext *context) const override;
+
+    /**
+     * Transforms the input expression using the given rule
+     * @param input Input AbstractOptimizerNode to transform
+     * @param transformed Vector of transformed AbstractOptimizerNodes
+     * @param context Current OptimizationContext executing under
+     */
+    void Transform(common::ManagedPointer<AbstractOptimizerNode>        input,
+                   std::vector<std::unique_ptr<AbstractOptimizerNode>> *transformed,
+                   OptimizationContext                                 *context) const override;
+};
+
 /**
  * Rule transforms Logical Left Join to LeftHashJoin
  */
@@ -62,6 +62,12 @@ public:
      */
     void Visit(const LogicalAggregateAndGroupBy *op) override;
 
+    /**
+     * Visit a LogicalWindow
+     * @param op Operator being visited
+     */
+    void Visit(const LogicalWindow *op) override;
+
     /**
      * Visit a LogicalLimit
      * @param op Operator being visited
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "common/error/exception.h"
+#include "parser/expression/abstract_expression.h"
+#include "parser/expression_defs.h"
+#include "parser/select_statement.h"
+
+namespace noisepage::parser {
+
+/** Unit of the frame of a window function. */
+enum class WindowFrameType : uint8_t { ROWS, RANGE };
+
+/** Bound of the frame of a window function. */
+enum class WindowFrameBoundType : uint8_t {
+    UNBOUNDED_PRECEDING,
+    PRECEDING,
+    CURRENT_ROW,
+    FOLLOWING,
+    UNBOUNDED_FOLLOWING
+};
+
+/**
+ * Frame of a window function, relative to the row being computed. PRECEDING and FOLLOWING bounds count rows and are
+ * only allowed in ROWS mode. In RANGE mode, CURRENT_ROW includes all of the peers of the row (the rows that are equal
+ * on the ORDER BY of the window).
+ */
+struct WindowFrame {
+    /** Unit of the frame */
+    WindowFrameType type_ = WindowFrameType::RANGE;
+    /** Start of the frame */
+    WindowFrameBoundType start_ = WindowFrameBoundType::UNBOUNDED_PRECEDING;
+    /** Number of rows before or after the row at which the frame starts, if start_ is PRECEDING or FOLLOWING */
+    int64_t start_offset_ = 0;
+    /** End of the frame */
+    WindowFrameBoundType end_ = WindowFrameBoundType::CURRENT_ROW;
+    /** Number of rows before or after the row at which the frame ends, if end_ is PRECEDING or FOLLOWING */
+    int64_t end_offset_ = 0;
+
+    /** @return true if the two frames are the same */
+    bool operator==(const WindowFrame &other) const {
+        return type_ == other.type_ && start_ == other.start_ && start_offset_ == other.start_offset_
+            && end_ == other.end_ && end_offset_ == other.end_offset_;
+    }
+
+    /** @return true if the two frames are different */
+    bool operator!=(const WindowFrame &other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * WindowExpression represents a call to a window function, i.e., a ranking function or an aggregate with an OVER
+ * clause. The children are the arguments of the function, followed by the PARTITION BY and the ORDER BY expressions of
+ * the window. Window functions are evaluated by a window operator on top of the rest of the query, after aggregation.
+ */
+class WindowExpression : public AbstractExpression {
+public:
+    /**
+     * Instantiates a new window expression.
+     * @param type type of the window function, one of the WINDOW_* expression types
+     * @param args arguments of the function
+     * @param partition_by PARTITION BY expressions of the window
+     * @param order_by ORDER BY expressions of the window
+     * @param order_types directions of the ORDER BY expressions
+     * @param frame frame of the window
+     */
+    WindowExpression(ExpressionType                                     type,
+                     std::vector<std::unique_ptr<AbstractExpression>> &&args,
+                     std::vector<std::unique_ptr<AbstractExpression>> &&partition_by,
+                     std::vector<std::unique_ptr<AbstractExpression>> &&order_by,
+                     std::vector<OrderType>                             order_types,
+                     WindowFrame                                        frame);
+
+    /** Default constructor for deserialization. */
+    WindowExpression() = default;
+
+    /**
+     * Creates a copy of the current AbstractExpression
+     * @returns Copy of this
+     */
+    std::unique_ptr<AbstractExpression> Copy() const override;
+
+    /**
+     * Creates a copy of the current AbstractExpression with new children implanted.
+     * The children should not be owned by any other AbstractExpression.
+     * @param children New children to be owned by the copy, laid out as the children of this expression
+     * @returns copy of this with new children
+     */
+    std::unique_ptr<AbstractExpression>
+    CopyWithChildren(std::vector<std::unique_ptr<AbstractExpression>> &&children) const override;
+
+    common::hash_t Hash() const override;
+
+    bool operator==(const AbstractExpression &rhs) const override {
+        if (!AbstractExpression::operator==(rhs))
+            return false;
+        auto const &other = dynamic_cast<const WindowExpression &>(rhs);
+        return num_args_ == other.num_args_ && num_partition_by_ == other.num_partition_by_
+            && order_types_ == other.order_types_ && frame_ == other.frame_;
+    }
+
+    /** @return number of arguments of the function */
+    size_t GetNumArgs() const {
+        return num_args_;
+    }
+
+    /** @return argument of the function at the given index */
+    common::ManagedPointer<AbstractExpression> GetArg(size_t idx) const {
+        NOISEPAGE_ASSERT(idx < num_args_, "Argument index out of bounds.");
+        return GetChild(idx);
+    }
+
+    /** @return number of PARTITION BY expressions */
+    size_t GetNumPartitionBy() const {
+        return num_partition_by_;
+    }
+
+    /** @return PARTITION BY expression at the given index */
+    common::ManagedPointer<AbstractExpression> GetPartitionBy(size_t idx) const {
+        NOISEPAGE_ASSERT(idx < num_partition_by_, "PARTITION BY index out of bounds.");
+        return GetChild(num_args_ + idx);
+    }
+
+    /** @return number of ORDER BY expressions */
+    size_t GetNumOrderBy() const {
+        return order_types_.size();
+    }
+
+    /** @return ORDER BY expression at the given index */
+    common::ManagedPointer<AbstractExpression> GetOrderBy(size_t idx) const {
+        NOISEPAGE_ASSERT(idx < order_types_.size(), "ORDER BY index out of bounds.");
+        return GetChild(num_args_ + num_partition_by_ + idx);
+    }
+
+    /** @return direction of the ORDER BY expression at the given index */
+    OrderType GetOrderByType(size_t idx) const {
+        NOISEPAGE_ASSERT(idx < order_types_.size(), "ORDER BY index out of bounds.");
+        return order_types_[idx];
+    }
+
+    /** @return frame of the window */
+    const WindowFrame &GetFrame() const {
+        return frame_;
+    }
+
+    /** @return true if the function is ROW_NUMBER, RANK or DENSE_RANK, which ignore the frame */
+    bool IsRankingFunction() const;
+
+    /**
+     * Window functions over the same window are evaluated by the same window operator, from a single sort.
+     * @param other window expression to compare to
+     * @return true if both expressions have the same PARTITION BY and ORDER BY
+     */
+    bool HasSameWindow(const WindowExpression &other) const;
+
+    /**
+     * Derive the expression type of the current expression.
+     */
+    void DeriveReturnValueType() override;
+
+    void Accept(common::ManagedPointer<binder::SqlNodeVisitor> v) override;
+
+    /** @return expression serialized to json */
+    nlohmann::json ToJson() const override;
+
+    /**
+     * @param j json to deserialize
+     */
+    std::vector<std::unique_ptr<AbstractExpression>> FromJson(const nlohmann::json &j) override;
+
+private:
+    /** Number of arguments of the function, which are the first children. */
+    size_t num_args_ = 0;
+    /** Number of PARTITION BY expressions, which follow the arguments in the children. */
+    size_t num_partition_by_ = 0;
+    /** Directions of the ORDER BY expressions, which are the last children. */
+    std::vector<OrderType> order_types_;
+    /** Frame of the window. */
+    WindowFrame frame_;
+};
+
+DEFINE_JSON_HEADER_DECLARATIONS(WindowExpression);
+
+} // namespace noisepage::parser
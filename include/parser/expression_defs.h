@@ -59,6 +59,15 @@ STRONG_TYPEDEF_HEADER(alias_oid_t, std::size_t);
     T(ExpressionType, AGGREGATE_TOP_K)                                                                                 \
     T(ExpressionType, AGGREGATE_HISTOGRAM)                                                                             \
                                                                                                                        \
+    T(ExpressionType, WINDOW_ROW_NUMBER)                                                                               \
+    T(ExpressionType, WINDOW_RANK)                                                                                     \
+    T(ExpressionType, WINDOW_DENSE_RANK)                                                                               \
+    T(ExpressionType, WINDOW_COUNT)                                                                                    \
+    T(ExpressionType, WINDOW_SUM)                                                                                      \
+    T(ExpressionType, WINDOW_MIN)                                                                                      \
+    T(ExpressionType, WINDOW_MAX)                                                                                      \
+    T(ExpressionType, WINDOW_AVG)                                                                                      \
+                                                                                                                       \
     T(ExpressionType, FUNCTION)                                                                                        \
                                                                                                                        \
     T(ExpressionType, HASH_RANGE)                                                                                      \
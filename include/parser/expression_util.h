@@ -21,6 +21,7 @@
 #include "parser/expression/operator_expression.h"
 #include "parser/expression/parameter_value_expression.h"
 #include "parser/expression/type_cast_expression.h"
+#include "parser/expression/window_expression.h"
 
 namespace noisepage::parser {
 
@@ -96,6 +97,51 @@ public:
         }
     }
 
+    /**
+     * Checks whether the AbstractExpression represents a window function
+     * @param expr expression to check
+     * @returns whether expr is a window function
+     */
+    static bool IsWindowExpression(common::ManagedPointer<AbstractExpression> expr) {
+        return IsWindowExpression(expr->GetExpressionType());
+    }
+
+    /**
+     * Checks whether the ExpressionType represents a window function
+     * @param type ExpressionType to check
+     * @returns whether type is a window function
+     */
+    static bool IsWindowExpression(ExpressionType type) {
+        switch (type) {
+        case ExpressionType::WINDOW_ROW_NUMBER:
+        case ExpressionType::WINDOW_RANK:
+        case ExpressionType::WINDOW_DENSE_RANK:
+        case ExpressionType::WINDOW_COUNT:
+        case ExpressionType::WINDOW_SUM:
+        case ExpressionType::WINDOW_MIN:
+        case ExpressionType::WINDOW_MAX:
+        case ExpressionType::WINDOW_AVG:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * Walks an expression tree and finds all WindowExpression subtrees.
+     * @param window_exprs List of window expressions found, in the order they were found in
+     * @param expr The abstract expression tree to be traversed
+     */
+    static void GetWindowExprs(std::vector<common::ManagedPointer<WindowExpression>> *window_exprs,
+                               common::ManagedPointer<AbstractExpression>             expr) {
+        if (ExpressionUtil::IsWindowExpression(expr->GetExpressionType())) {
+            window_exprs->push_back(expr.CastTo<WindowExpression>());
+        } else {
+            for (const auto &child : expr->GetChildren())
+                GetWindowExprs(window_exprs, child);
+        }
+    }
+
     /**
      * Checks whether the ExpressionType represents an operation
      * @param type ExpressionType to check
@@ -327,9 +373,10 @@ public:
     /**
      * Walks an expression trees and find all AggregateExpression and ColumnValueExpressions.
      * AggregateExpression and ColumnValueExpression are appended to the respective vectors in
-     * the order that each are found in.
+     * the order that each are found in. WindowExpressions are computed by the window operator
+     * like aggregates are computed by the aggregation, so they are treated as aggregates.
      *
-     * @param aggr_exprs vector of AggregateExpressions in expression
+     * @param aggr_exprs vector of AggregateExpressions and WindowExpressions in expression
      * @param tv_exprs vector of ColumnValueExpressions in expression
      * @param expr Expression to walk
      */
@@ -337,7 +384,7 @@ public:
                                           std::vector<common::ManagedPointer<AbstractExpression>> *tv_exprs,
                                           common::ManagedPointer<AbstractExpression>               expr) {
         size_t children_size = expr->GetChildrenSize();
-        if (IsAggregateExpression(expr->GetExpressionType())) {
+        if (IsAggregateExpression(expr->GetExpressionType()) || IsWindowExpression(expr->GetExpressionType())) {
             aggr_exprs->push_back(expr);
         } else if (expr->GetExpressionType() == ExpressionType::COLUMN_VALUE) {
             tv_exprs->push_back(expr);
@@ -453,6 +500,18 @@ public:
                 ++tuple_idx;
             }
 
+        } else if (IsWindowExpression(expr->GetExpressionType())) {
+            // The window function is computed by a window operator below, which outputs its value
+            int tuple_idx = 0;
+            for (auto &expr_map : expr_maps) {
+                auto iter = expr_map.find(expr);
+                if (iter != expr_map.end()) {
+                    auto type = expr->GetReturnValueType();
+                    return std::make_unique<DerivedValueExpression>(type, tuple_idx, iter->second);
+                }
+                ++tuple_idx;
+            }
+
         } else if (expr->GetExpressionType() == ExpressionType::FUNCTION) {
             /*
             TODO(wz2): Uncomment and fix this when Functions exist
@@ -66,7 +66,7 @@ enum class IndexType {
 
 enum class InsertType { INVALID = INVALID_TYPE_ID, VALUES = 1, SELECT = 2 };
 
-enum class ExternalFileFormat { CSV, BINARY };
+enum class ExternalFileFormat { CSV, BINARY, ARROW };
 
 // CREATE FUNCTION helpers
 
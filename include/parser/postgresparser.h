@@ -111,6 +111,7 @@ private:
     static std::unique_ptr<AbstractExpression> SubqueryExprTransform(ParseResult *parse_result, SubLink *node);
     static std::unique_ptr<AbstractExpression> TypeCastTransform(ParseResult *parse_result, TypeCast *root);
     static std::unique_ptr<AbstractExpression> ValueTransform(ParseResult *parse_result, value val);
+    static std::unique_ptr<AbstractExpression> WindowTransform(ParseResult *parse_result, FuncCall *root);
 
     // SELECT statements
     static std::unique_ptr<SelectStatement> SelectTransform(ParseResult *parse_result, SelectStmt *root);
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "planner/plannodes/abstract_join_plan_node.h"
+#include "planner/plannodes/plan_visitor.h"
+
+namespace noisepage::planner {
+
+/**
+ * Plan node for sort-merge join. Both children are sorted ascending on their merge keys, the left is materialized, and
+ * the right is merged with it in order.
+ */
+class MergeJoinPlanNode : public AbstractJoinPlanNode {
+public:
+    /**
+     * Builder for merge join plan node
+     */
+    class Builder : public AbstractJoinPlanNode::Builder<Builder> {
+    public:
+        Builder() = default;
+
+        /**
+         * Don't allow builder to be copied or moved
+         */
+        DISALLOW_COPY_AND_MOVE(Builder);
+
+        /**
+         * @param key key to add to left merge keys
+         * @return builder object
+         */
+        Builder &AddLeftMergeKey(common::ManagedPointer<parser::AbstractExpression> key) {
+            left_merge_keys_.emplace_back(key);
+            return *this;
+        }
+
+        /**
+         * @param key key to add to right merge keys
+         * @return builder object
+         */
+        Builder &AddRightMergeKey(common::ManagedPointer<parser::AbstractExpression> key) {
+            right_merge_keys_.emplace_back(key);
+            return *this;
+        }
+
+        // TODO(WAN) do we want to invalidate the builder after build?
+        /**
+         * Build the merge join plan node
+         * @return plan node
+         */
+        std::unique_ptr<MergeJoinPlanNode> Build();
+
+    protected:
+        /**
+         * left side merge keys
+         */
+        std::vector<common::ManagedPointer<parser::AbstractExpression>> left_merge_keys_;
+        /**
+         * right side merge keys
+         */
+        std::vector<common::ManagedPointer<parser::AbstractExpression>> right_merge_keys_;
+    };
+
+private:
+    /**
+     * @param children child plan nodes
+     * @param output_schema Schema representing the structure of the output of this plan node
+     * @param join_type logical join type
+     * @param predicate join predicate
+     * @param left_merge_keys left side keys the child is sorted on
+     * @param right_merge_keys right side keys the child is sorted on
+     * @param plan_node_id Plan node id
+     */
+    MergeJoinPlanNode(std::vector<std::unique_ptr<AbstractPlanNode>>                  &&children,
+                     std::unique_ptr<OutputSchema>                                     output_schema,
+                     LogicalJoinType                                                   join_type,
+                     common::ManagedPointer<parser::AbstractExpression>                predicate,
+                     std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_merge_keys,
+                     std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_merge_keys,
+                     plan_node_id_t                                                    plan_node_id);
+
+public:
+    /**
+     * Default constructor used for deserialization
+     */
+    MergeJoinPlanNode() = default;
+
+    DISALLOW_COPY_AND_MOVE(MergeJoinPlanNode)
+
+    /**
+     * @return the type of this plan node
+     */
+    PlanNodeType GetPlanNodeType() const override {
+        return PlanNodeType::MERGEJOIN;
+    }
+
+    /**
+     * @return left side merge keys
+     */
+    const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetLeftMergeKeys() const {
+        return left_merge_keys_;
+    }
+
+    /**
+     * @return right side merge keys
+     */
+    const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetRightMergeKeys() const {
+        return right_merge_keys_;
+    }
+
+    /**
+     * @return the hashed value of this plan node
+     */
+    common::hash_t Hash() const override;
+
+    bool operator==(const AbstractPlanNode &rhs) const override;
+
+    void Accept(common::ManagedPointer<PlanVisitor> v) const override {
+        v->Visit(this);
+    }
+
+    nlohmann::json                                           ToJson() const override;
+    std::vector<std::unique_ptr<parser::AbstractExpression>> FromJson(const nlohmann::json &j) override;
+
+private:
+    // The left and right expressions that constitute the join keys
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> left_merge_keys_;
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> right_merge_keys_;
+};
+
+DEFINE_JSON_HEADER_DECLARATIONS(MergeJoinPlanNode);
+
+} // namespace noisepage::planner
@@ -44,6 +44,7 @@ enum class PlanNodeType {
     NESTLOOP,
     HASHJOIN,
     INDEXNLJOIN,
+    MERGEJOIN,
 
     // Mutator Nodes
     UPDATE,
@@ -76,6 +77,7 @@ enum class PlanNodeType {
     DISTINCT,
     HASH,
     SETOP,
+    WINDOW,
 
     // Utility
     EXPORT_EXTERNAL_FILE,
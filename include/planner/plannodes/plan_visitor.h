@@ -26,11 +26,13 @@ class IndexScanPlanNode;
 class InsertPlanNode;
 class LimitPlanNode;
 class CteScanPlanNode;
+class MergeJoinPlanNode;
 class NestedLoopJoinPlanNode;
 class OrderByPlanNode;
 class ProjectionPlanNode;
 class SeqScanPlanNode;
 class UpdatePlanNode;
+class WindowPlanNode;
 class SetOpPlanNode;
 class ResultPlanNode;
 
@@ -185,6 +187,12 @@ public:
      */
     virtual void Visit([[maybe_unused]] const CteScanPlanNode *plan) {}
 
+    /**
+     * Visit an MergeJoinPlanNode
+     * @param plan MergeJoinPlanNode
+     */
+    virtual void Visit([[maybe_unused]] const MergeJoinPlanNode *plan) {}
+
     /**
      * Visit an NestedLoopJoinPlanNode
      * @param plan NestedLoopJoinPlanNode
@@ -215,6 +223,12 @@ public:
      */
     virtual void Visit([[maybe_unused]] const UpdatePlanNode *plan) {}
 
+    /**
+     * Visit a WindowPlanNode
+     * @param plan WindowPlanNode
+     */
+    virtual void Visit([[maybe_unused]] const WindowPlanNode *plan) {}
+
     /**
      * Visit an SetOpPlanNode
      * @param plan SetOpPlanNode
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "parser/expression/window_expression.h"
+#include "planner/plannodes/abstract_plan_node.h"
+#include "planner/plannodes/plan_visitor.h"
+
+namespace noisepage::planner {
+
+using WindowTerm = common::ManagedPointer<parser::WindowExpression>;
+
+/**
+ * Plan node for a window operator. All of its window functions are over the same window, i.e., have the same PARTITION
+ * BY and ORDER BY. The output schema refers to the columns of the child with tuple index 0 and to the values of the
+ * window functions with tuple index 1, in the order of the window terms.
+ */
+class WindowPlanNode : public AbstractPlanNode {
+public:
+    /**
+     * Builder for a window plan node
+     */
+    class Builder : public AbstractPlanNode::Builder<Builder> {
+    public:
+        Builder() = default;
+
+        /**
+         * Don't allow builder to be copied or moved
+         */
+        DISALLOW_COPY_AND_MOVE(Builder);
+
+        /**
+         * @param term window function to compute, with its children referring to the output of the child plan
+         * @return builder object
+         */
+        Builder &AddWindowTerm(WindowTerm term) {
+            window_terms_.emplace_back(term);
+            return *this;
+        }
+
+        /**
+         * Build the window plan node
+         * @return plan node
+         */
+        std::unique_ptr<WindowPlanNode> Build();
+
+    protected:
+        /**
+         * Window functions to compute
+         */
+        std::vector<WindowTerm> window_terms_;
+    };
+
+private:
+    /**
+     * @param children child plan nodes
+     * @param output_schema Schema representing the structure of the output of this plan node
+     * @param window_terms window functions to compute
+     * @param plan_node_id Plan node id
+     */
+    WindowPlanNode(std::vector<std::unique_ptr<AbstractPlanNode>> &&children,
+                   std::unique_ptr<OutputSchema>                    output_schema,
+                   std::vector<WindowTerm>                          window_terms,
+                   plan_node_id_t                                   plan_node_id);
+
+public:
+    /**
+     * Default constructor used for deserialization
+     */
+    WindowPlanNode() = default;
+
+    DISALLOW_COPY_AND_MOVE(WindowPlanNode)
+
+    /**
+     * @return window functions to compute
+     */
+    const std::vector<WindowTerm> &GetWindowTerms() const {
+        return window_terms_;
+    }
+
+    /**
+     * @return the type of this plan node
+     */
+    PlanNodeType GetPlanNodeType() const override {
+        return PlanNodeType::WINDOW;
+    }
+
+    /**
+     * @return the hashed value of this plan node
+     */
+    common::hash_t Hash() const override;
+
+    bool operator==(const AbstractPlanNode &rhs) const override;
+
+    void Accept(common::ManagedPointer<PlanVisitor> v) const override {
+        v->Visit(this);
+    }
+
+    nlohmann::json                                           ToJson() const override;
+    std::vector<std::unique_ptr<parser::AbstractExpression>> FromJson(const nlohmann::json &j) override;
+
+private:
+    /* Window functions to compute */
+    std::vector<WindowTerm> window_terms_;
+};
+
+DEFINE_JSON_HEADER_DECLARATIONS(WindowPlanNode);
+
+} // namespace noisepage::planner
@@ -230,11 +230,16 @@ public:
         return batch_id_;
     }
 
-    /** @return The contents of this batch of log records. */
+    /** @return The contents of this batch of log records, which are a log frame if IsFramed(). */
     std::string GetContents() const {
         return contents_;
     }
 
+    /** @return True if the contents are a log frame (see storage::LogFrameHeader). False if they are raw records. */
+    bool IsFramed() const {
+        return framed_;
+    }
+
     /** @return The batch ID that should appear after the given batch ID. */
     static record_batch_id_t NextBatchId(record_batch_id_t batch_id) {
         if (batch_id.UnderlyingValue() == std::numeric_limits<uint64_t>::max()) {
@@ -249,9 +254,11 @@ protected:
 private:
     static const char *key_batch_id; ///< JSON key for the batch ID.
     static const char *key_contents; ///< JSON key for the contents.
+    static const char *key_framed;   ///< JSON key for whether the contents are a log frame.
 
     record_batch_id_t batch_id_; ///< The batch ID identifies the order of records sent by the remote origin.
     std::string       contents_; ///< The actual contents of the buffer.
+    bool              framed_;   ///< True if the contents were compressed into a log frame.
 };
 
 /** TxnAppliedMsg is sent from replica -> primary, indicating that a given transaction has been successfully applied. */
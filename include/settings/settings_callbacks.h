@@ -138,12 +138,24 @@ public:
                                        DBMain                                       *db_main,
                                        common::ManagedPointer<common::ActionContext> action_context);
 
+    /** Update the cost model used by the optimizer in Taskflow */
+    static void OptimizerCostModel(void                                         *old_value,
+                                   void                                         *new_value,
+                                   DBMain                                       *db_main,
+                                   common::ManagedPointer<common::ActionContext> action_context);
+
     /** Clear all cached ExecutableQuery in Taskflow */
     static void ClearQueryCache(void                                         *old_value,
                                 void                                         *new_value,
                                 DBMain                                       *db_main,
                                 common::ManagedPointer<common::ActionContext> action_context);
 
+    /** Update the memory limit of the Statements shared across connections in Taskflow */
+    static void SharedStatementCacheSize(void                                         *old_value,
+                                         void                                         *new_value,
+                                         DBMain                                       *db_main,
+                                         common::ManagedPointer<common::ActionContext> action_context);
+
     /** Set the forecast sample limit. */
     static void ForecastSampleLimit(void                                         *old_value,
                                     void                                         *new_value,
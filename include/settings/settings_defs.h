@@ -97,6 +97,17 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Garbage collector workers
+SETTING_int(
+    gc_num_workers,
+    "The number of threads that each invocation of the garbage collector spreads its work over (default: 1)",
+    1,
+    1,
+    64,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Write ahead logging
 SETTING_bool(
     wal_enable,
@@ -166,12 +177,66 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Number of log streams
+SETTING_int(
+    wal_num_streams,
+    "The number of streams the log is split into, each written to its own file by its own threads (default: 1)",
+    1,
+    1,
+    64,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Asynchronous log writes
+SETTING_int(
+    wal_async_io_depth,
+    "The number of log writes kept in flight through io_uring on a preallocated O_DIRECT log file. 0 writes and fsyncs "
+    "the log synchronously (default: 0)",
+    0,
+    0,
+    64,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Group commit target latency
+SETTING_int(
+    wal_group_commit_target_latency,
+    "Target for the 99th percentile commit latency (in us). If set, the log is persisted in batches sized from the "
+    "observed persist latency and commit rate to meet it, instead of at the persist interval. 0 disables it "
+    "(default: 0)",
+    0,
+    0,
+    1000000,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Compression of log buffers
+SETTING_bool(
+    wal_compression_enable,
+    "Compress serialized log buffers before they are written to the log and shipped to replicas (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Optimizer timeout
 SETTING_int(task_execution_timeout,
             "Maximum allowed length of time (in ms) for task execution step of optimizer, "
             "assuming one plan has been found (default 5000)",
             5000, 1000, 60000, false, noisepage::settings::Callbacks::NoOp)
 
+// Optimizer cost model
+SETTING_string(
+    optimizer_cost_model,
+    "Cost model used by the optimizer to choose plans (default: TRIVIAL, values: TRIVIAL, STATS)",
+    "TRIVIAL",
+    true,
+    noisepage::settings::Callbacks::OptimizerCostModel
+)
+
 // Parallel Execution
 SETTING_bool(
     parallel_execution,
@@ -192,6 +257,36 @@ SETTING_int64(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Checkpointing
+SETTING_bool(
+    checkpoint_enable,
+    "Whether to checkpoint the database and truncate the WAL periodically, and recover from the checkpoint on startup "
+    "(default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Checkpoint file path
+SETTING_string(
+    checkpoint_file_path,
+    "The path to the checkpoint file (default: checkpoint.dat)",
+    "checkpoint.dat",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Checkpoint interval
+SETTING_int(
+    checkpoint_interval,
+    "Checkpoint interval (sec) (default: 300)",
+    300,
+    1,
+    86400,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_int(
     extra_float_digits,
     "Sets the number of digits displayed for floating-point values. (default : 1)",
@@ -421,6 +516,16 @@ SETTING_bool(
     noisepage::settings::Callbacks::ClearQueryCache
 )
 
+SETTING_int64(
+    shared_statement_cache_size,
+    "Memory limit (bytes) of the physical plans and generated code shared across connections (default: 64MB)",
+    (1 << 26) /* 64MB */,
+    0,
+    (1LL << 34) /* 16GB */,
+    true,
+    noisepage::settings::Callbacks::SharedStatementCacheSize
+)
+
 
 SETTING_string(
     application_name,
@@ -448,6 +553,26 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Memory budget of a single query
+SETTING_int64(
+    query_memory_budget,
+    "Bytes a query may allocate before its sorts, joins and aggregations spill to disk, 0 for none. (default: 0)",
+    0,
+    0,
+    1000000000000,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Directory of the temporary files of spilling queries
+SETTING_string(
+    query_spill_directory,
+    "The directory where queries over their memory budget spill to (default: /tmp/)",
+    "/tmp/",
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_bool(
     counters_enable,
     "Whether to use counters (default: false)",
@@ -578,6 +703,24 @@ SETTING_string(
     noisepage::settings::Callbacks::NoOp
 )
 
+SETTING_string(
+    jit_cache_directory,
+    "The directory in which JIT-compiled queries are cached across restarts; empty to disable the cache (default: '')",
+    "",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    jit_cache_size,
+    "The maximum total size of the JIT-compiled queries in the cache directory (bytes) (default: 256MB)",
+    (1 << 28) /* 256MB */,
+    (1 << 20) /* 1MB */,
+    (1LL << 36) /* 64GB */,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_bool(
     train_forecast_model,
     "Train the forecast model (the value is not relevant and has no effect during startup).",
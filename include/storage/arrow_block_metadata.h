@@ -4,9 +4,11 @@
 #include <unordered_set>
 #include <utility>
 
+#include "storage/block_compression.h"
 #include "storage/block_layout.h"
 #include "storage/storage_defs.h"
 #include "storage/storage_util.h"
+#include "storage/zone_map.h"
 
 namespace noisepage::storage {
 
@@ -134,6 +136,10 @@ private:
  * is dictionary-compressed, it has an ArrowVarlenColumn that is the dictionary, and an indices array that encodes
  * the values. Notice here that the meaning of the ArrowVarlenColumn is different for dictionary-encoded columns
  * and simple gathered columns.
+ *
+ * Fixed-length columns, and the indices of dictionary-compressed columns, can also have a compressed copy that scans of
+ * the frozen block decode instead of reading the column itself. The copy is only built if the BlockCompactor is asked
+ * to, and does not replace the column in the block.
  */
 class ArrowColumnInfo {
 public:
@@ -149,7 +155,8 @@ public:
     ArrowColumnInfo(ArrowColumnInfo &&other) noexcept
         : type_(other.type_)
         , varlen_column_(std::move(other.varlen_column_))
-        , indices_(other.indices_) {
+        , indices_(other.indices_)
+        , compressed_(std::move(other.compressed_)) {
         other.indices_ = nullptr;
     }
 
@@ -172,6 +179,7 @@ public:
             delete[] indices_;
             indices_ = other.indices_;
             other.indices_ = nullptr;
+            compressed_ = std::move(other.compressed_);
         }
         return *this;
     }
@@ -200,12 +208,23 @@ public:
         return indices_;
     }
 
+    /**
+     * Returns the compressed copy of the column, or of its indices if the column is dictionary compressed. This is
+     * UNCOMPRESSED if the column has none.
+     * @return the compressed column
+     */
+    CompressedColumn &Compressed() {
+        return compressed_;
+    }
+
     /**
      * Deallocates all associated buffers in the ArrowVarlenColumn
      */
     void Deallocate() {
         delete[] indices_;
+        indices_ = nullptr;
         varlen_column_.Deallocate();
+        compressed_.Deallocate();
     }
 
 private:
@@ -215,7 +234,8 @@ private:
     ArrowColumnType   type_;
     ArrowVarlenColumn varlen_column_; // For varlen and dictionary
     // TODO(Tianyu): Add null bitmap
-    uint64_t *indices_ = nullptr; // for dictionary
+    uint64_t        *indices_ = nullptr; // for dictionary
+    CompressedColumn compressed_;        // for fixed-length columns and dictionary indices
 };
 
 /**
@@ -237,16 +257,19 @@ public:
      */
     static uint32_t Size(uint16_t num_cols) {
         return StorageUtil::PadUpToSize(sizeof(uint64_t), static_cast<uint32_t>(sizeof(uint32_t)) * (num_cols + 1))
-               + num_cols * static_cast<uint32_t>(sizeof(ArrowColumnInfo));
+               + num_cols * static_cast<uint32_t>(sizeof(ArrowColumnInfo) + sizeof(ColumnZoneMap));
     }
 
     /**
-     * Zeroes out the memory chunk for block metadata
+     * Zeroes out the memory chunk for block metadata and empties the zone maps
      * @param num_cols number of columsn stored in the block
      */
     void Initialize(uint16_t num_cols) {
         // Need to 0 out this block to make sure all the counts are 0 and all the pointers are nullptrs
         memset(this, 0, Size(num_cols));
+        for (uint16_t i = 0; i < num_cols; i++) {
+            ZoneMaps(num_cols)[i].Reset();
+        }
     }
 
     /**
@@ -304,9 +327,34 @@ public:
         return reinterpret_cast<ArrowColumnInfo *>(null_count_end)[col_id.UnderlyingValue()];
     }
 
+    /**
+     * @param layout layout object of the Block
+     * @param col_id the column of interest
+     * @return zone map of the given column, which is only maintained for fixed-length columns
+     */
+    ColumnZoneMap &GetZoneMap(const BlockLayout &layout, col_id_t col_id) {
+        return ZoneMaps(layout.NumColumns())[col_id.UnderlyingValue()];
+    }
+
+    /**
+     * @param layout layout object of the Block
+     * @param col_id the column of interest
+     * @return zone map of the given column, which is only maintained for fixed-length columns
+     */
+    const ColumnZoneMap &GetZoneMap(const BlockLayout &layout, col_id_t col_id) const {
+        return const_cast<ArrowBlockMetadata *>(this)->ZoneMaps(layout.NumColumns())[col_id.UnderlyingValue()];
+    }
+
 private:
+    ColumnZoneMap *ZoneMaps(uint16_t num_cols) {
+        byte *null_count_end
+            = storage::StorageUtil::AlignedPtr(sizeof(uint64_t), varlen_content_ + sizeof(uint32_t) * num_cols);
+        return reinterpret_cast<ColumnZoneMap *>(null_count_end + num_cols * sizeof(ArrowColumnInfo));
+    }
+
     uint32_t num_records_; // number of actual records
     // null_count[num_cols] (32-bit) | padding up to 8 byte-aligned | arrow_varlen_buffers[num_cols] |
+    // zone_maps[num_cols] |
     byte varlen_content_[];
 };
 } // namespace noisepage::storage
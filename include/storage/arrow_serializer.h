@@ -2,6 +2,7 @@
 #include <flatbuffers/flatbuffers.h>
 #include <flatbuffers/generated/Message_generated.h>
 #include <flatbuffers/generated/Schema_generated.h>
+#include <sys/uio.h>
 
 #include <string>
 #include <unordered_map>
@@ -14,6 +15,39 @@ namespace flatbuf = org::apache::arrow::flatbuf;
 
 namespace noisepage::storage {
 
+/**
+ * Destination of an Arrow IPC stream. Every call to Write hands over the buffers of one message, which may point
+ * straight into blocks that are only guaranteed to stay unchanged until Write returns.
+ */
+class ArrowStreamWriter {
+public:
+    virtual ~ArrowStreamWriter() = default;
+
+    /**
+     * Writes the buffers out in order, as if they were one contiguous buffer
+     * @param buffers buffers to write
+     */
+    virtual void Write(const std::vector<iovec> &buffers) = 0;
+};
+
+/**
+ * Writes an Arrow IPC stream to a file descriptor with scatter-gather writes, so that frozen blocks are handed to the
+ * kernel without being copied first. The file descriptor must be blocking, and is not closed by the writer.
+ */
+class FdArrowStreamWriter : public ArrowStreamWriter {
+public:
+    /**
+     * @param fd file descriptor to write to
+     */
+    explicit FdArrowStreamWriter(const int fd)
+        : fd_(fd) {}
+
+    void Write(const std::vector<iovec> &buffers) override;
+
+private:
+    int fd_;
+};
+
 /**
  * An Arrow Serializer is an auxiliary object bound to a data table so that the in-memory blocks
  * which are organized in arrow format can be exported to external storage in arrow IPC format.
@@ -62,6 +96,29 @@ public:
      */
     void ExportTable(const std::string &file_name, std::vector<noisepage::execution::sql::SqlTypeId> *col_types);
 
+    /**
+     * Streams the tuples of a table that are visible to the transaction in the Arrow IPC streaming format: a schema
+     * message, one RecordBatch message per block and the end-of-stream marker. The buffers of frozen blocks are handed
+     * to the writer in place, holding an in-place read on the block until the writer returns. Only hot blocks, as well
+     * as dictionary-compressed columns and dates and timestamps (which Arrow counts from the Unix epoch), are
+     * materialized first.
+     *
+     * Unlike ExportTable, no dictionaries are sent and all columns are nullable, so that every batch has the same
+     * schema whether or not its block is frozen. Booleans are sent as unsigned 8-bit integers rather than as bits.
+     *
+     * @param txn the transaction to read the table as
+     * @param col_ids columns to export, in order
+     * @param col_types types of the exported columns
+     * @param col_names names of the exported columns
+     * @param writer destination of the stream
+     * @return number of exported tuples
+     */
+    uint64_t ExportStream(common::ManagedPointer<transaction::TransactionContext> txn,
+                          const std::vector<col_id_t>                            &col_ids,
+                          const std::vector<execution::sql::SqlTypeId>           &col_types,
+                          const std::vector<std::string>                         &col_names,
+                          ArrowStreamWriter                                      *writer);
+
 private:
     const DataTable &data_table_;
     /**
@@ -97,6 +154,42 @@ private:
                                 int64_t                         body_len,
                                 flatbuffers::FlatBufferBuilder *flatbuf_builder);
 
+    /**
+     * Build the metadata_flatbuffer from all its components, prefixed with the continuation marker and its length
+     * and padded to arrow alignment, as it is written ahead of the message body.
+     * @param header_type one of MessageHeader_Schema, MessageHeader_RecordBatch, or MessageHeader_DictionaryBatch
+     * @param header the auto-generated offset of the header
+     * @param body_len the length of follwoing message body (not the length of this metadata_flatbuffer)
+     * @param flatbuf_builder flatbuffer builder
+     * @return the encoded metadata
+     */
+    std::string EncodeMetadataBuffer(flatbuf::MessageHeader          header_type,
+                                     flatbuffers::Offset<void>       header,
+                                     int64_t                         body_len,
+                                     flatbuffers::FlatBufferBuilder *flatbuf_builder);
+
+    /**
+     * Builds the Schema message of a stream exported by ExportStream
+     * @param col_types types of the exported columns
+     * @param col_names names of the exported columns
+     * @param flatbuf_builder flatbuffer builder
+     * @return the encoded message, which has no body
+     */
+    std::string EncodeStreamSchema(const std::vector<execution::sql::SqlTypeId> &col_types,
+                                   const std::vector<std::string>               &col_names,
+                                   flatbuffers::FlatBufferBuilder               *flatbuf_builder);
+
+    /**
+     * Streams the tuples of one block as a RecordBatch message
+     * @return number of exported tuples
+     */
+    uint32_t ExportStreamBlock(common::ManagedPointer<transaction::TransactionContext> txn,
+                               RawBlock                                               *block,
+                               const std::vector<col_id_t>                            &col_ids,
+                               const std::vector<execution::sql::SqlTypeId>           &col_types,
+                               flatbuffers::FlatBufferBuilder                         *flatbuf_builder,
+                               ArrowStreamWriter                                      *writer);
+
     /**
      * This function write a Schema message. The Schema message provides metadata describing the following RecordBatch
      * messages (you may think of it as a batch of rows), which includes but not limited to the logical type of each
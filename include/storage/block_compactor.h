@@ -50,6 +50,16 @@ private:
     };
 
 public:
+    /**
+     * Constructs a new block compactor
+     * @param compress_frozen_blocks whether to build a compressed copy of the integer columns of every block it
+     *                               freezes. The copy is only read by sequential scans, and is kept in addition to
+     *                               the raw columns of the block, so it costs memory rather than saving it. Off by
+     *                               default.
+     */
+    explicit BlockCompactor(bool compress_frozen_blocks = false)
+        : compress_frozen_blocks_(compress_frozen_blocks) {}
+
     FAKED_IN_TEST ~BlockCompactor() = default;
 
     /**
@@ -92,6 +102,21 @@ private:
                          ArrowColumnInfo             *col,
                          VarlenEntry                 *values);
 
+    // Sets the zone map of a fixed-length column to the exact range and null count of its values
+    void SummarizeColumn(ColumnZoneMap                     *zone_map,
+                         const byte                        *values,
+                         const common::RawConcurrentBitmap *column_bitmap,
+                         uint16_t                           attr_size,
+                         uint32_t                           num_records);
+
+    // Builds the compressed copy of a column that scans of the frozen block decode, if compression of frozen blocks is
+    // on and makes the column smaller
+    void CompressColumn(ArrowColumnInfo                   *col,
+                        const byte                        *values,
+                        const common::RawConcurrentBitmap *column_bitmap,
+                        uint8_t                            value_size,
+                        uint32_t                           num_records);
+
     void ComputeFilled(const BlockLayout &layout, std::vector<uint32_t> *filled, const std::vector<uint32_t> &empty) {
         // Reconstruct the list of filled slots
         // Since the list of empty slots is sorted, we can use a counter j to keep track of the next empty slot that
@@ -105,6 +130,7 @@ private:
         }
     }
 
+    bool                   compress_frozen_blocks_;
     std::queue<RawBlock *> compaction_queue_;
 };
 } // namespace noisepage::storage
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+
+#include "common/macros.h"
+#include "common/strong_typedef.h"
+
+namespace noisepage::common {
+class RawConcurrentBitmap;
+} // namespace noisepage::common
+
+namespace noisepage::storage {
+
+/**
+ * Encoding of a compressed column in a frozen block. Frame-of-reference and dictionary encodings store their codes
+ * bit-packed, so plain bit-packing is frame-of-reference with a base of 0.
+ */
+enum class ColumnEncoding : uint8_t { UNCOMPRESSED = 0, FRAME_OF_REFERENCE, RUN_LENGTH, DICTIONARY };
+
+/**
+ * A lightweight, read-only compressed copy of a fixed-length integer column (or of the dictionary codes of a
+ * dictionary-compressed varlen column) in a frozen block. Values are 1, 2, 4 or 8 bytes wide and compressed losslessly
+ * as their bit patterns:
+ *  - FRAME_OF_REFERENCE: the difference of every value to the smallest value, bit-packed
+ *  - RUN_LENGTH: the value and end of every run of equal values
+ *  - DICTIONARY: the sorted distinct values, and the index of every value into them, bit-packed. Codes compare in the
+ *    same order as the values.
+ * Null values are stored as the value before them, so that they do not break runs or widen the frame, and their
+ * decoded values are meaningless. The null bitmap itself stays in the block.
+ *
+ * Like the other Arrow buffers of a block, this is built when the block is frozen and becomes stale once the block is
+ * written to again. It is scan-only: the raw column stays in the block for point reads, updates and exports, so the
+ * copy adds to the memory of the block instead of shrinking it. Readers can only use it while they hold an in-place
+ * read on the block.
+ */
+class CompressedColumn {
+public:
+    /**
+     * Constructs an empty, uncompressed column
+     */
+    CompressedColumn() = default;
+
+    DISALLOW_COPY(CompressedColumn)
+
+    /**
+     * Move constructor
+     * @param other object to move from
+     */
+    CompressedColumn(CompressedColumn &&other) noexcept;
+
+    /**
+     * Move-assignment operator
+     * @param other object to move from
+     * @return self-reference
+     */
+    CompressedColumn &operator=(CompressedColumn &&other) noexcept;
+
+    /**
+     * Destructs a CompressedColumn
+     */
+    ~CompressedColumn() {
+        Deallocate();
+    }
+
+    /**
+     * Compresses the given values with whichever encoding stores them in the fewest bytes. The result is UNCOMPRESSED
+     * if no encoding is smaller than the values themselves.
+     * @param values array of num_values values of value_size bytes each
+     * @param null_bitmap bitmap with the bit of every non-null value set, or nullptr if no value is null
+     * @param value_size size of a value in bytes, which must be 1, 2, 4 or 8
+     * @param num_values number of values
+     * @return the compressed column
+     */
+    static CompressedColumn Compress(const byte                        *values,
+                                     const common::RawConcurrentBitmap *null_bitmap,
+                                     uint8_t                            value_size,
+                                     uint32_t                           num_values);
+
+    /**
+     * Decodes a range of values
+     * @param start index of the first value to decode
+     * @param count number of values to decode
+     * @param[out] out location to write count values of ValueSize() bytes each to
+     */
+    void Decode(uint32_t start, uint32_t count, byte *out) const;
+
+    /**
+     * @return encoding of the column
+     */
+    ColumnEncoding Encoding() const {
+        return encoding_;
+    }
+
+    /**
+     * @return size of a value in bytes
+     */
+    uint8_t ValueSize() const {
+        return value_size_;
+    }
+
+    /**
+     * @return number of bits of every bit-packed code
+     */
+    uint8_t BitWidth() const {
+        return bit_width_;
+    }
+
+    /**
+     * @return number of values in the column
+     */
+    uint32_t NumValues() const {
+        return num_values_;
+    }
+
+    /**
+     * @return number of bytes that the compressed values take up
+     */
+    uint32_t CompressedSize() const;
+
+    /**
+     * Deallocates all associated buffers in the CompressedColumn, leaving it empty and uncompressed
+     */
+    void Deallocate();
+
+private:
+    template <class T>
+    void DecodeAs(uint32_t start, uint32_t count, T *out) const;
+
+    uint64_t Code(uint32_t index) const;
+
+    ColumnEncoding encoding_ = ColumnEncoding::UNCOMPRESSED;
+    uint8_t        value_size_ = 0, bit_width_ = 0;
+    uint32_t       num_values_ = 0;
+    // Number of runs or dictionary entries
+    uint32_t num_entries_ = 0;
+    // Smallest value for frame-of-reference
+    uint64_t base_ = 0;
+    // Bit-packed codes for frame-of-reference and dictionary
+    uint64_t *codes_ = nullptr;
+    // Run values or dictionary entries
+    uint64_t *entries_ = nullptr;
+    // Exclusive end index of every run
+    uint32_t *run_ends_ = nullptr;
+};
+
+} // namespace noisepage::storage
@@ -13,6 +13,7 @@
 #include "storage/storage_defs.h"
 #include "storage/tuple_access_strategy.h"
 #include "storage/undo_record.h"
+#include "storage/zone_map.h"
 
 namespace noisepage::execution::sql {
 class VectorProjection;
@@ -209,13 +210,18 @@ public:
      * to fill the buffer, unless there are no more tuples. The given iterator is mutated to point to one slot passed
      * the last slot scanned in the invocation.
      *
+     * Blocks, or what is left of them past the iterator, are skipped without reading any tuple if their zone maps rule
+     * out any of the given filters.
+     *
      * @param txn The calling transaction.
      * @param start_pos Iterator to the starting location for the sequential scan.
      * @param out_buffer Output buffer. This buffer is always cleared of old values.
+     * @param block_filters Value ranges that the caller discards every tuple outside of.
      */
     void Scan(common::ManagedPointer<transaction::TransactionContext> txn,
               SlotIterator                                           *start_pos,
-              execution::sql::VectorProjection                       *out_buffer) const;
+              execution::sql::VectorProjection                       *out_buffer,
+              const std::vector<ZoneMapFilter>                       &block_filters = {}) const;
 
     /**
      * @return the first tuple slot contained in the data table
@@ -288,6 +294,55 @@ public:
      */
     bool Delete(common::ManagedPointer<transaction::TransactionContext> txn, TupleSlot slot);
 
+    /**
+     * Allocates an empty block for bulk loading. The block is private to the caller and invisible to every
+     * transaction until it is handed back through InsertBlock, so it can be filled without any synchronization.
+     * @return the new block
+     */
+    RawBlock *NewBulkLoadBlock();
+
+    /**
+     * Copies a tuple into the next free slot of a block obtained from NewBulkLoadBlock. No version information is
+     * written, the tuple stays logically deleted until the block is inserted.
+     * @param block the private block to fill
+     * @param redo after-image of the tuple. Should not reference col_id 0
+     * @return false if the block is full, true otherwise
+     */
+    bool BulkLoadInto(RawBlock *block, const ProjectedRow &redo);
+
+    /**
+     * Makes all tuples bulk loaded into the given block part of the table, on behalf of the calling transaction. A
+     * single undo record covers every tuple in the block, so the tuples become visible atomically when txn commits
+     * and are rolled back together if it aborts.
+     * @param txn the calling transaction
+     * @param block a block obtained from NewBulkLoadBlock, must hold at least one tuple
+     * @return the undo record installed for the block's tuples
+     */
+    UndoRecord *InsertBlock(common::ManagedPointer<transaction::TransactionContext> txn, RawBlock *block);
+
+    /**
+     * Copies the bulk loaded tuples of a block, starting at the given offset, into out_buffer along with their slots.
+     * Visibility is not checked, so this should only be used by the transaction that loaded the block. Once the block
+     * is inserted, concurrent inserts may fill its remaining slots, so the number of loaded tuples must be passed in
+     * rather than read from the block.
+     * @param block a block obtained from NewBulkLoadBlock
+     * @param start_offset offset of the first tuple to copy
+     * @param end_offset number of tuples loaded into the block, before it was inserted
+     * @param out_buffer output buffer, its contents are overwritten
+     * @return offset of the first tuple that was not copied
+     */
+    uint32_t CopyLoadedTuples(RawBlock         *block,
+                              uint32_t          start_offset,
+                              uint32_t          end_offset,
+                              ProjectedColumns *out_buffer) const;
+
+    /**
+     * Returns a block obtained from NewBulkLoadBlock that was never inserted into the table, along with any varlens
+     * that were loaded into it.
+     * @param block the private block to release
+     */
+    void ReleaseBulkLoadBlock(RawBlock *block);
+
     /**
      * @return pointer to underlying vector of blocks
      */
@@ -410,6 +465,32 @@ private:
                                   UndoRecord                *expected,
                                   UndoRecord                *desired);
 
+    // Checks whether the given version, which is the first one in its chain that the txn did not apply, is too old for
+    // any running transaction to apply, which makes it and every version after it garbage. The GC unlinks these as
+    // well, but every transaction that reads or writes a version chain also prunes it, rather than leave readers to
+    // walk past garbage until the next GC run.
+    bool IsPrunable(const transaction::TransactionContext &txn, const UndoRecord *version) const;
+
+    // Cuts the version and every version after it off the version chain of the slot. newer_version is the version
+    // right before it in the chain, or nullptr if the version is the head. Returns false if the head changed before it
+    // could be cut.
+    bool PruneVersionChain(TupleSlot slot, UndoRecord *newer_version, UndoRecord *version) const;
+
+    // Checks the zone maps of the block against every filter, returning false if some filter rules out all its tuples.
+    bool MayPassFilters(RawBlock *block, const std::vector<ZoneMapFilter> &block_filters) const;
+
+    // Widens the zone maps of the block to cover the values that the redo wrote to it.
+    void WidenZoneMaps(RawBlock *block, const ProjectedRow &redo);
+
+    // Fills the buffer, from its filled-th row on, with the tuples of a frozen block that the caller holds an in-place
+    // read on, starting at the slot that the iterator points to, and advances the iterator past them. Compressed
+    // columns are decoded straight into the buffer. Returns the new number of filled rows, which is unchanged if the
+    // tuples cannot be read in place.
+    uint32_t ScanFrozenBlock(common::ManagedPointer<transaction::TransactionContext> txn,
+                             SlotIterator                                           *start_pos,
+                             execution::sql::VectorProjection                       *out_buffer,
+                             uint32_t                                                filled) const;
+
     // Allocates a new block to be used as insertion head.
     RawBlock *NewBlock();
 
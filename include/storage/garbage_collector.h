@@ -1,11 +1,15 @@
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <queue>
 #include <tuple>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/shared_latch.h"
+#include "common/worker_pool.h"
 #include "storage/storage_defs.h"
 #include "transaction/transaction_defs.h"
 
@@ -31,6 +35,11 @@ namespace index {
  * Based on the contents of this queue, it unlinks the UndoRecords from their version chains when no running
  * transactions can view those versions anymore. It then stores those transactions to attempt to deallocate on the next
  * iteration if no running transactions can still hold references to them.
+ *
+ * With more than one worker, an invocation of the GC still runs on a single thread, but hands the unlinking and
+ * deallocation of transactions and the garbage collection of indexes to a pool of worker threads. Undo records are
+ * partitioned across workers by the block that they point into, so that every version chain is still only ever
+ * truncated by one thread, and indexes are handed out one at a time to whichever worker is free.
  */
 class GarbageCollector {
 public:
@@ -44,13 +53,16 @@ public:
      *                 it is not null. The observer can then gain insight invoke other components to perform actions.
      *                 The observer's function implementation needs to be lightweight because it is called on the GC
      *                 thread.
+     * @param num_workers number of threads to spread the work of each invocation over. The GC runs on the invoking
+     *                    thread alone if this is 1.
      */
     // TODO(Tianyu): Eventually the GC will be re-written to be purely on the deferred action manager. which will
     //  eliminate this perceived redundancy of taking in a transaction manager.
     GarbageCollector(common::ManagedPointer<transaction::TimestampManager>      timestamp_manager,
                      common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
                      common::ManagedPointer<transaction::TransactionManager>    txn_manager,
-                     AccessObserver                                            *observer);
+                     AccessObserver                                            *observer,
+                     uint32_t                                                   num_workers = 1);
 
     ~GarbageCollector() {
         NOISEPAGE_ASSERT(txns_to_deallocate_.empty(), "Not all txns have been deallocated");
@@ -89,7 +101,55 @@ public:
         gc_interval_ = gc_interval;
     }
 
+    /**
+     * @return number of threads that the work of each invocation is spread over
+     */
+    uint32_t NumWorkers() const {
+        return num_workers_;
+    }
+
 private:
+    /**
+     * Work done by one worker during an invocation, which is reported to the GarbageCollectionMetric
+     */
+    struct WorkerStats {
+        uint64_t txns_deallocated_ = 0;
+        uint64_t undo_records_unlinked_ = 0;
+        uint64_t indexes_processed_ = 0;
+        uint64_t elapsed_us_ = 0;
+    };
+
+    /**
+     * State that a worker builds while it unlinks its partition of the undo records, which is merged on the invoking
+     * thread afterwards because transactions and the observer are shared between partitions
+     */
+    struct UnlinkPartition {
+        // varlen entries to free along with the transaction that owns them
+        std::vector<std::pair<transaction::TransactionContext *, const byte *>> loose_ptrs_;
+        // blocks that were written to, to report to the observer
+        std::vector<RawBlock *> written_blocks_;
+    };
+
+    /**
+     * Runs the task once for every worker and waits for all of them to finish. The task is given the id of the
+     * worker, and its run time is added to the stats of that worker.
+     */
+    void RunOnWorkers(const std::function<void(uint32_t)> &task);
+
+    /**
+     * @return worker whose partition the given block belongs to
+     */
+    uint32_t PartitionOf(const RawBlock *block) const;
+
+    /**
+     * Unlinks the undo records of the given transactions that fall into the partition of the given worker
+     * @return number of undo records processed
+     */
+    uint32_t UnlinkRecords(const std::vector<transaction::TransactionContext *> &txns,
+                           transaction::timestamp_t                              oldest_txn,
+                           uint32_t                                              worker,
+                           UnlinkPartition                                      *partition);
+
     /**
      * Process the deallocate queue
      * @return number of txns (not UndoRecords) processed for debugging/testing
@@ -112,7 +172,9 @@ private:
 
     void ReclaimSlotIfDeleted(UndoRecord *undo_record) const;
 
-    void ReclaimBufferIfVarlen(transaction::TransactionContext *txn, UndoRecord *undo_record) const;
+    void ReclaimBufferIfVarlen(transaction::TransactionContext *txn,
+                               UndoRecord                      *undo_record,
+                               UnlinkPartition                 *partition) const;
 
     void TruncateVersionChain(DataTable *table, TupleSlot slot, transaction::timestamp_t oldest) const;
 
@@ -134,6 +196,11 @@ private:
     common::SharedLatch                                      indexes_latch_;
 
     uint64_t gc_interval_{0};
+
+    const uint32_t num_workers_;
+    // nullptr if the GC runs on the invoking thread alone
+    std::unique_ptr<common::WorkerPool> worker_pool_;
+    std::vector<WorkerStats>            worker_stats_;
 };
 
 } // namespace noisepage::storage
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <cstring>
 #include <functional>
 #include <iostream>
@@ -2917,6 +2920,112 @@ public:
         return false;
     }
 
+    /**
+     * BulkLoad - Builds the tree bottom-up from elements sorted by key, instead of inserting them one at a time. All
+     * values of a key end up in the value list of that key. Every level is packed up to the upper size threshold of its
+     * nodes, and the entries of a level are spread evenly over its nodes so that none falls below the lower threshold.
+     * The leaves, which hold most of the data, are built in parallel.
+     *
+     * NOTE: This function does not acquire any latches, and the tree must be empty. It should only be called while no
+     * other thread can access the tree, e.g. while populating a new index.
+     *
+     * @param elements key-value pairs sorted by key
+     */
+    void BulkLoad(const std::vector<KeyElementPair> &elements) {
+        NOISEPAGE_ASSERT(root_ == nullptr, "Bulk loading requires an empty tree.");
+        if (elements.empty()) {
+            return;
+        }
+
+        // Every run of equal keys becomes one entry of a leaf
+        std::vector<uint64_t> key_starts;
+        for (uint64_t i = 0; i < elements.size(); i++) {
+            if (i == 0 || !KeyCmpEqual(elements[i - 1].first, elements[i].first)) {
+                key_starts.push_back(i);
+            }
+        }
+        const uint64_t num_keys = key_starts.size();
+        key_starts.push_back(elements.size());
+
+        // Build the leaves. The low key of every node holds the smallest key of its subtree, which the level above
+        // uses as the separator key.
+        const auto     leaf_capacity = static_cast<uint64_t>(leaf_node_size_upper_threshold_);
+        const uint64_t num_leaves = (num_keys + leaf_capacity - 1) / leaf_capacity;
+        std::vector<BaseNode *> level(num_leaves);
+        tbb::parallel_for(tbb::blocked_range<uint64_t>(0, num_leaves), [&](const tbb::blocked_range<uint64_t> &range) {
+            for (uint64_t leaf = range.begin(); leaf != range.end(); leaf++) {
+                const uint64_t     begin = leaf * num_keys / num_leaves;
+                const uint64_t     end = (leaf + 1) * num_keys / num_leaves;
+                KeyNodePointerPair low_key{elements[key_starts[begin]].first, nullptr};
+                auto              *node = ElasticNode<KeyValuePair>::Get(leaf_node_size_upper_threshold_,
+                                                                         NodeType::LeafType,
+                                                                         0,
+                                                                         leaf_node_size_upper_threshold_,
+                                                                         low_key,
+                                                                         low_key);
+                for (uint64_t key = begin; key < end; key++) {
+                    auto *value_list = new ValueList();
+                    for (uint64_t i = key_starts[key]; i < key_starts[key + 1]; i++) {
+                        value_list->push_back(elements[i].second);
+                    }
+                    node->PushBack(KeyValuePair{elements[key_starts[key]].first, value_list});
+                }
+                level[leaf] = node;
+            }
+        });
+
+        // Link the leaves to their siblings
+        for (uint64_t leaf = 0; leaf < num_leaves; leaf++) {
+            auto *node = reinterpret_cast<ElasticNode<KeyValuePair> *>(level[leaf]);
+            node->GetElasticLowKeyPair()->second = leaf > 0 ? level[leaf - 1] : nullptr;
+            node->GetElasticHighKeyPair()->second = leaf + 1 < num_leaves ? level[leaf + 1] : nullptr;
+        }
+
+        // Build inner levels until a single root remains. An inner node with n entries has n + 1 children: the first
+        // child hangs off its low key, every other child is an entry keyed by the smallest key of the child's subtree.
+        const auto max_children = static_cast<uint64_t>(inner_node_size_upper_threshold_) + 1;
+        int        depth = 0;
+        while (level.size() > 1) {
+            depth++;
+            const uint64_t          num_children = level.size();
+            const uint64_t          num_nodes = (num_children + max_children - 1) / max_children;
+            std::vector<BaseNode *> parents(num_nodes);
+            for (uint64_t parent = 0; parent < num_nodes; parent++) {
+                const uint64_t     begin = parent * num_children / num_nodes;
+                const uint64_t     end = (parent + 1) * num_children / num_nodes;
+                KeyNodePointerPair low_key{level[begin]->GetLowKeyPair().first, level[begin]};
+                KeyNodePointerPair high_key{low_key.first, nullptr};
+                auto              *node = ElasticNode<KeyNodePointerPair>::Get(inner_node_size_upper_threshold_,
+                                                                               NodeType::InnerType,
+                                                                               depth,
+                                                                               inner_node_size_upper_threshold_,
+                                                                               low_key,
+                                                                               high_key);
+                for (uint64_t child = begin + 1; child < end; child++) {
+                    node->PushBack(KeyNodePointerPair{level[child]->GetLowKeyPair().first, level[child]});
+                }
+                parents[parent] = node;
+            }
+            level = std::move(parents);
+        }
+
+        root_ = level.front();
+        num_keys_ = num_keys;
+        num_values_ = elements.size();
+    }
+
+    /**
+     * Clear - Frees all nodes and values, leaving the tree empty.
+     *
+     * NOTE: This function does not acquire any latches, should be called only when safe
+     */
+    void Clear() {
+        FreeTree();
+        root_ = nullptr;
+        num_keys_ = 0;
+        num_values_ = 0;
+    }
+
     /**
      * Returns the size of the B+ Tree (number of keys stored)
      * @return The size of the tree
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <tbb/enumerable_thread_specific.h>
+
 #include <functional>
 #include <memory>
 #include <utility>
@@ -39,6 +41,8 @@ private:
                                     std::equal_to<TupleSlot>>>
                               bplustree_;
     mutable common::SpinLatch transaction_context_latch_; // latch used to protect transaction context
+    // key-value pairs staged for a bulk build, by the thread that staged them
+    tbb::enumerable_thread_specific<std::vector<std::pair<KeyType, TupleSlot>>> bulk_build_elements_;
 
 public:
     /**
@@ -106,6 +110,26 @@ public:
                 const ProjectedRow                                     &tuple,
                 TupleSlot                                               location) final;
 
+    /**
+     * Stages a key-value pair for a bulk build, used to populate a new index from its table. Staged pairs only become
+     * part of the index when BulkBuildFinish() is called. Thread-safe.
+     * @param txn txn context for the calling txn
+     * @param tuple key
+     * @param location value
+     * @return true
+     */
+    auto BulkBuildInsert(common::ManagedPointer<transaction::TransactionContext> txn,
+                         const ProjectedRow                                     &tuple,
+                         TupleSlot                                               location) -> bool final;
+
+    /**
+     * Sorts all staged pairs in parallel and builds the B+ Tree bottom-up from them. The index must have been empty
+     * when the first pair was staged, and must not be accessed concurrently.
+     * @param txn txn context for the calling txn, used to register an abort action
+     * @return false if the index is unique and two staged pairs have the same key, true otherwise
+     */
+    auto BulkBuildFinish(common::ManagedPointer<transaction::TransactionContext> txn) -> bool final;
+
     /**
      * Finds all the values associated with the given key in our index.
      * @param txn txn context for the calling txn, used for visibility checks
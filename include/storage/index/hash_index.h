@@ -1,5 +1,7 @@
 #pragma once
 
+#include <tbb/enumerable_thread_specific.h>
+
 #include <functional>
 #include <memory>
 #include <unordered_set>
@@ -41,6 +43,9 @@ private:
     // TODO(Matt): unclear at the moment if we would want this to be tunable via the SettingsManager. Alternatively, it
     // might be something that is a per-index hint based on the table size (cardinality?), rather than a global setting
     static constexpr uint16_t INITIAL_CUCKOOHASH_MAP_SIZE = 256;
+    // Number of partitions the staged key-value pairs of a bulk build are split into by the hash of their key. Each
+    // partition holds all values of its keys, so partitions are inserted into the map in parallel without conflicts.
+    static constexpr uint16_t BULK_BUILD_PARTITIONS = 256;
     struct TupleSlotHash;
 
     using ValueMap = std::unordered_set<TupleSlot, TupleSlotHash>;
@@ -57,6 +62,8 @@ private:
                                          LIBCUCKOO_DEFAULT_SLOT_PER_BUCKET>>
                               hash_map_;
     mutable common::SpinLatch transaction_context_latch_; // latch used to protect transaction context
+    // key-value pairs staged for a bulk build, by the thread that staged them
+    tbb::enumerable_thread_specific<std::vector<std::pair<KeyType, TupleSlot>>> bulk_build_elements_;
 
 public:
     /**
@@ -106,6 +113,26 @@ public:
                 const ProjectedRow                                     &tuple,
                 TupleSlot                                               location) final;
 
+    /**
+     * Stages a key-value pair for a bulk build, used to populate a new index from its table. Staged pairs only become
+     * part of the index when BulkBuildFinish() is called. Thread-safe.
+     * @param txn txn context for the calling txn
+     * @param tuple key
+     * @param location value
+     * @return true
+     */
+    auto BulkBuildInsert(common::ManagedPointer<transaction::TransactionContext> txn,
+                         const ProjectedRow                                     &tuple,
+                         TupleSlot                                               location) -> bool final;
+
+    /**
+     * Partitions all staged pairs by the hash of their key and fills the map from the partitions in parallel. The index
+     * must have been empty when the first pair was staged, and must not be accessed concurrently.
+     * @param txn txn context for the calling txn, used to register an abort action
+     * @return false if the index is unique and two staged pairs have the same key, true otherwise
+     */
+    auto BulkBuildFinish(common::ManagedPointer<transaction::TransactionContext> txn) -> bool final;
+
     /**
      * Finds all the values associated with the given key in our index.
      * @param txn txn context for the calling txn, used for visibility checks
@@ -111,6 +111,31 @@ public:
     Delete(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple, TupleSlot location)
         = 0;
 
+    /**
+     * Stages a key-value pair for a bulk build, used to populate a new index from its table. Staged pairs only become
+     * part of the index when BulkBuildFinish() is called. Index types without a bulk build path insert the pair right
+     * away. Thread-safe.
+     * @param txn txn context for the calling txn, used to register abort actions
+     * @param tuple key
+     * @param location value
+     * @return false if the pair could not be inserted, true otherwise
+     */
+    virtual bool BulkBuildInsert(common::ManagedPointer<transaction::TransactionContext> txn,
+                                 const ProjectedRow                                     &tuple,
+                                 TupleSlot                                               location) {
+        return metadata_.GetSchema().Unique() ? InsertUnique(txn, tuple, location) : Insert(txn, tuple, location);
+    }
+
+    /**
+     * Builds the index from all pairs staged by BulkBuildInsert(). The index must have been empty when the first pair
+     * was staged, and must not be accessed concurrently. Registers a single abort action that empties the index again.
+     * @param txn txn context for the calling txn, used to register abort actions
+     * @return false if the index is unique and two staged pairs have the same key, true otherwise
+     */
+    virtual bool BulkBuildFinish(common::ManagedPointer<transaction::TransactionContext> txn) {
+        return true;
+    }
+
     /**
      * Finds all the values associated with the given key in our index.
      * @param txn txn context for the calling txn, used for visibility checks
@@ -171,7 +171,7 @@ public:
      * @return the actual number of tuples this ProjectedColumns holds. These tuples are guaranteed to be laid out in
      * offsets 0 to NumTuples() - 1
      */
-    uint32_t NumTuples() {
+    auto NumTuples() const -> uint32_t {
         return num_tuples_;
     }
 
@@ -213,6 +213,14 @@ public:
         return StorageUtil::AlignedPtr<storage::TupleSlot>(AttrValueOffsets() + num_cols_);
     }
 
+    /**
+     * @return const head of the array that holds the tuple slots of the tuples currently materialized in the
+     * ProjectedColumns
+     */
+    auto TupleSlots() const -> const storage::TupleSlot * {
+        return StorageUtil::AlignedPtr<const storage::TupleSlot>(AttrValueOffsets() + num_cols_);
+    }
+
     /**
      * @param projection_list_index index of the desired column in the projection list
      * @return pointer to the column presence bitmap for the given projection list column
@@ -232,6 +240,14 @@ public:
         return {this, row_offset};
     }
 
+    /**
+     * @param row_offset the row offset within the ProjectedColumns to look at
+     * @return a read-only view into the desired row within the ProjectedColumns
+     */
+    auto InterpretAsRow(uint32_t row_offset) const -> const RowView {
+        return {const_cast<ProjectedColumns *>(this), row_offset};
+    }
+
     /**
      * @param projection_list_index index of the desired column in the projection list
      * @return pointer to the column value array for the given projection list column
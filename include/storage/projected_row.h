@@ -224,6 +224,7 @@ public:
 private:
     friend class ProjectedRowInitializer;
     friend class LogSerializerTask;
+    friend class LogRecordSerializer;
     uint32_t size_;
     uint16_t num_cols_;
     byte     varlen_contents_[0];
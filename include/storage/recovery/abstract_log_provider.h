@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stdexcept>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -18,7 +19,7 @@ namespace noisepage::storage {
 class AbstractLogProvider {
 public:
     /** The type of log provider that this is. */
-    enum class LogProviderType : uint8_t { RESERVED = 0, DISK, REPLICATION };
+    enum class LogProviderType : uint8_t { RESERVED = 0, DISK, REPLICATION, CHECKPOINT };
 
     /** @return The type of this log provider. */
     virtual LogProviderType GetType() const = 0;
@@ -29,7 +30,11 @@ public:
      * @return next log record along with vector of varlen entry pointers. nullptr log record if no more logs will be
      * provided.
      */
-    std::pair<LogRecord *, std::vector<byte *>> GetNextRecord() {
+    virtual std::pair<LogRecord *, std::vector<byte *>> GetNextRecord() {
+        // Tuples of a partially handed out block insert record come before anything else in the log
+        if (block_insert_tuples_left_ > 0) {
+            return ReadBlockInsertTuple();
+        }
         return HasMoreRecords() ? ReadNextRecord() : std::make_pair(nullptr, std::vector<byte *>());
     }
 
@@ -52,6 +57,15 @@ protected:
      */
     virtual bool Read(void *dest, uint32_t size) = 0;
 
+    /**
+     * Continue reading the log from frames, starting with the frame whose marker was just read in place of a record
+     * size (see LogFrameHeader). Only providers that read logs written with compression or by an AsyncLogWriter see
+     * frames.
+     */
+    virtual void BeginFrame() {
+        throw std::runtime_error("Log provider does not support log frames");
+    }
+
 private:
     // TODO(Gus): Support a more fail-safe way than just throwing an exception
     /**
@@ -73,5 +87,35 @@ private:
      * @return next log record, along with vector of varlen entry pointers
      */
     std::pair<LogRecord *, std::vector<byte *>> ReadNextRecord();
+
+    /**
+     * Reads in the column ids and attribute sizes that precede the values of REDO and BLOCK_INSERT records
+     * @param[out] col_ids column ids of the record
+     * @param[out] attr_sizes attribute sizes of the columns in col_ids
+     */
+    void ReadColumns(std::vector<col_id_t> *col_ids, std::vector<uint16_t> *attr_sizes);
+
+    /**
+     * Reads in the null bitmap and attribute values of a single tuple into delta
+     * @param delta initialized delta to populate
+     * @param attr_sizes attribute sizes of the columns in delta
+     * @param[out] varlen_contents buffers allocated for varlen entries that are not inlined
+     */
+    void ReadDelta(ProjectedRow *delta, const std::vector<uint16_t> &attr_sizes, std::vector<byte *> *varlen_contents);
+
+    /**
+     * Reads in the next tuple of the current block insert record. Recovery replays bulk loaded tuples just like any
+     * other insert, so each tuple of the batch is handed out as its own REDO record.
+     * @return REDO record of the tuple, along with vector of varlen entry pointers
+     */
+    std::pair<LogRecord *, std::vector<byte *>> ReadBlockInsertTuple();
+
+    // State of the block insert record currently being handed out, one tuple at a time
+    uint32_t                 block_insert_tuples_left_ = 0;
+    transaction::timestamp_t block_insert_txn_begin_;
+    catalog::db_oid_t        block_insert_db_oid_;
+    catalog::table_oid_t     block_insert_table_oid_;
+    std::vector<col_id_t>    block_insert_col_ids_;
+    std::vector<uint16_t>    block_insert_attr_sizes_;
 };
 } // namespace noisepage::storage
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <string>
+
+#include "storage/recovery/abstract_log_provider.h"
+#include "storage/write_ahead_log/log_io.h"
+#include "transaction/transaction_defs.h"
+
+namespace noisepage::storage {
+
+/**
+ * Header at the start of every checkpoint file. It is followed by the checkpointed tuples in the log format.
+ */
+struct CheckpointHeader {
+    /** Identifies checkpoint files, and the version of their format. */
+    static constexpr uint64_t CHECKPOINT_MAGIC = 0x4e50434b50540001;
+
+    uint64_t                 magic_;                ///< Always CHECKPOINT_MAGIC.
+    transaction::timestamp_t checkpoint_timestamp_; ///< Snapshot timestamp that the checkpoint was taken at.
+    uint64_t                 first_log_segment_;    ///< Oldest log segment that must be replayed after the checkpoint.
+};
+
+/**
+ * @brief Log provider for checkpoints stored on disk
+ * A checkpoint is a snapshot of every table in the system, serialized as redo records in the log format. Replaying it
+ * through the recovery manager reconstructs the state of the system as of the checkpoint timestamp, after which only
+ * the log written since the checkpoint began has to be replayed.
+ */
+class CheckpointLogProvider : public AbstractLogProvider {
+public:
+    /**
+     * @param checkpoint_file_path path to the checkpoint file to read
+     * @throw std::runtime_error if the file is not a valid checkpoint
+     */
+    explicit CheckpointLogProvider(const std::string &checkpoint_file_path)
+        : in_(checkpoint_file_path.c_str()) {
+        if (!in_.Read(&header_, sizeof(CheckpointHeader)) || header_.magic_ != CheckpointHeader::CHECKPOINT_MAGIC) {
+            throw std::runtime_error("Invalid checkpoint file " + checkpoint_file_path);
+        }
+    }
+
+    LogProviderType GetType() const override {
+        return LogProviderType::CHECKPOINT;
+    }
+
+    /** @return the snapshot timestamp that the checkpoint was taken at */
+    transaction::timestamp_t GetCheckpointTimestamp() const {
+        return header_.checkpoint_timestamp_;
+    }
+
+    /** @return id of the oldest log segment that must be replayed after the checkpoint */
+    uint64_t GetFirstLogSegment() const {
+        return header_.first_log_segment_;
+    }
+
+private:
+    // Buffered checkpoint file reader
+    storage::BufferedLogReader in_;
+    // Header of the checkpoint file
+    CheckpointHeader header_;
+
+    /**
+     * @return true if checkpoint file contains more records, false otherwise
+     */
+    bool HasMoreRecords() override {
+        return in_.HasMore();
+    }
+
+    /**
+     * Read data from the checkpoint file into the destination provided
+     * @param dest pointer to location to read into
+     * @param size number of bytes to read
+     * @return true if we read the given number of bytes
+     */
+    bool Read(void *dest, uint32_t size) override {
+        return in_.Read(dest, size);
+    }
+};
+
+} // namespace noisepage::storage
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <chrono>             // NOLINT
+#include <condition_variable> // NOLINT
+#include <memory>
+#include <mutex> // NOLINT
+#include <string>
+#include <thread> // NOLINT
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/managed_pointer.h"
+#include "storage/recovery/checkpoint_log_provider.h"
+#include "storage/storage_defs.h"
+#include "transaction/transaction_defs.h"
+
+namespace noisepage::catalog {
+class Catalog;
+class DatabaseCatalog;
+} // namespace noisepage::catalog
+
+namespace noisepage::transaction {
+class TimestampManager;
+class TransactionContext;
+class TransactionManager;
+} // namespace noisepage::transaction
+
+namespace noisepage::storage {
+
+class LogManager;
+class SqlTable;
+
+/**
+ * The CheckpointManager takes fuzzy checkpoints of the system, which bound the amount of log that has to be replayed on
+ * recovery. A checkpoint is taken as follows:
+ *      1. The active log file is rotated into an archived log segment. Every log record serialized from here on goes
+ * to newer segments.
+ *      2. We wait until every transaction that began before the rotation has finished. Any transaction that commits
+ * after this point began after the rotation, so all of its log records are in the newer segments.
+ *      3. A read-only transaction scans every table, catalog tables included, and serializes its snapshot as redo
+ * records in the log format. Transactions are not blocked while this happens.
+ *      4. The checkpoint is persisted and atomically replaces the previous one. The archived log segments that are
+ * covered by the checkpoint are deleted.
+ * Recovery replays the checkpoint, followed by the records of transactions that committed at or after the checkpoint's
+ * snapshot timestamp from the log segments written since the rotation. See RecoveryManager.
+ */
+class CheckpointManager {
+public:
+    /** Number of records to serialize into a checkpoint before ending the transaction that replays them. */
+    static constexpr uint32_t CHECKPOINT_TXN_NUM_RECORDS = 1 << 12;
+
+    /**
+     * @param checkpoint_file_path path to write the checkpoint file to
+     * @param catalog catalog of the tables to checkpoint
+     * @param txn_manager transaction manager used to scan the tables
+     * @param timestamp_manager timestamp manager used to wait for transactions to finish
+     * @param log_manager log manager whose log is truncated by checkpoints
+     */
+    CheckpointManager(std::string                                             checkpoint_file_path,
+                      common::ManagedPointer<catalog::Catalog>                catalog,
+                      common::ManagedPointer<transaction::TransactionManager> txn_manager,
+                      common::ManagedPointer<transaction::TimestampManager>   timestamp_manager,
+                      common::ManagedPointer<LogManager>                      log_manager);
+
+    ~CheckpointManager() {
+        if (run_checkpoint_thread_) {
+            StopCheckpointThread();
+        }
+    }
+
+    /**
+     * Takes a checkpoint and truncates the log segments that it covers. Blocks until the checkpoint is persisted.
+     * @return the snapshot timestamp of the checkpoint
+     * @throw std::runtime_error if the checkpoint could not be written, in which case the previous checkpoint and the
+     * log segments that it needs are kept
+     */
+    transaction::timestamp_t TakeCheckpoint();
+
+    /**
+     * Spawn a thread that takes a checkpoint at a fixed interval. Checkpoints that fail are logged and skipped.
+     * @param checkpoint_interval time between checkpoints
+     */
+    void StartCheckpointThread(std::chrono::seconds checkpoint_interval);
+
+    /**
+     * Kill the checkpoint thread. A checkpoint that is in progress is completed first.
+     */
+    void StopCheckpointThread();
+
+    /** @return path of the checkpoint file */
+    const std::string &GetCheckpointFilePath() const {
+        return checkpoint_file_path_;
+    }
+
+    /** @return snapshot timestamp of the last checkpoint taken by this manager */
+    transaction::timestamp_t GetLastCheckpointTimestamp() const {
+        return last_checkpoint_timestamp_;
+    }
+
+    /**
+     * Lists the log files that have to be replayed after the given checkpoint, in order
+     * @param checkpoint checkpoint that is recovered from
+     * @param log_file_path path of the active log file
+     * @return for every stream of the log, the paths of its log files to replay
+     */
+    static std::vector<std::vector<std::string>> LogFilesForCheckpoint(const CheckpointLogProvider &checkpoint,
+                                                                       const std::string           &log_file_path);
+
+private:
+    class CheckpointWriter;
+
+    /** A pg_class entry of a table or index, which is recreated on recovery. */
+    struct ClassEntry {
+        TupleSlot                        slot_;      ///< Slot of the entry in pg_class.
+        uint32_t                         class_oid_; ///< Oid of the table or index.
+        bool                             is_table_;  ///< True for a table, false for an index.
+        common::ManagedPointer<SqlTable> object_;    ///< The table, or the index reinterpreted as in pg_class.
+    };
+
+    const std::string                                             checkpoint_file_path_;
+    const common::ManagedPointer<catalog::Catalog>                catalog_;
+    const common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+    const common::ManagedPointer<transaction::TimestampManager>   timestamp_manager_;
+    const common::ManagedPointer<LogManager>                      log_manager_;
+
+    std::mutex               checkpoint_latch_; ///< Ensures that only one checkpoint is taken at a time.
+    transaction::timestamp_t last_checkpoint_timestamp_ = transaction::INITIAL_TXN_TIMESTAMP;
+
+    volatile bool           run_checkpoint_thread_ = false;
+    std::chrono::seconds    checkpoint_interval_{0};
+    std::thread             checkpoint_thread_;
+    std::mutex              checkpoint_thread_latch_;
+    std::condition_variable checkpoint_thread_cv_;
+
+    /** Takes a checkpoint every checkpoint_interval_ until the thread is stopped. */
+    void CheckpointThreadLoop();
+
+    /**
+     * Serializes the snapshot of txn of every database into the checkpoint
+     * @param txn transaction whose snapshot is checkpointed
+     * @param writer writer for the checkpoint file
+     */
+    void WriteCheckpoint(transaction::TransactionContext *txn, CheckpointWriter *writer);
+
+    /**
+     * Serializes the snapshot of txn of a database into the checkpoint. The catalog tables that recovery needs to
+     * recreate tables and indexes are written first, followed by the pg_class updates that make recovery recreate them,
+     * the remaining catalog tables, and finally the user tables.
+     * @param txn transaction whose snapshot is checkpointed
+     * @param writer writer for the checkpoint file
+     * @param db_oid database to checkpoint
+     */
+    void WriteDatabase(transaction::TransactionContext *txn, CheckpointWriter *writer, catalog::db_oid_t db_oid);
+
+    /**
+     * Serializes every tuple of a table visible to txn as an insert
+     * @param txn transaction whose snapshot is checkpointed
+     * @param writer writer for the checkpoint file
+     * @param db_oid database of the table
+     * @param table_oid oid of the table
+     * @param table the table to checkpoint
+     * @param col_oids all columns of the table
+     */
+    void WriteTable(transaction::TransactionContext       *txn,
+                    CheckpointWriter                      *writer,
+                    catalog::db_oid_t                      db_oid,
+                    catalog::table_oid_t                   table_oid,
+                    common::ManagedPointer<SqlTable>       table,
+                    const std::vector<catalog::col_oid_t> &col_oids);
+
+    /**
+     * Serializes pg_class as inserts of fresh entries, i.e. without pointers to schemas and objects
+     * @param txn transaction whose snapshot is checkpointed
+     * @param writer writer for the checkpoint file
+     * @param db_oid database of pg_class
+     * @param db_catalog catalog of the database
+     * @param[out] entries the tables and indexes found in pg_class
+     */
+    void WriteClassTable(transaction::TransactionContext                 *txn,
+                         CheckpointWriter                                *writer,
+                         catalog::db_oid_t                                db_oid,
+                         common::ManagedPointer<catalog::DatabaseCatalog> db_catalog,
+                         std::vector<ClassEntry>                         *entries);
+
+    /**
+     * Serializes an update of the object pointer of a pg_class entry, which makes recovery recreate the object
+     * @param writer writer for the checkpoint file
+     * @param db_oid database of pg_class
+     * @param pg_class the pg_class table
+     * @param entry the pg_class entry
+     */
+    void WriteClassPointer(CheckpointWriter                *writer,
+                           catalog::db_oid_t                db_oid,
+                           common::ManagedPointer<SqlTable> pg_class,
+                           const ClassEntry                &entry);
+};
+
+} // namespace noisepage::storage
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <deque>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "storage/recovery/abstract_log_provider.h"
 #include "storage/write_ahead_log/log_io.h"
@@ -9,8 +13,18 @@ namespace noisepage::storage {
 
 /**
  * @brief Log provider for logs stored on disk
- * Provides logs to the recovery manager from logs persisted on disk. The log file is read in using the
- * BufferedLogReader.
+ * Provides logs to the recovery manager from logs persisted on disk. The log files are read in using the
+ * BufferedLogReader. If the log is spread over several files (e.g. archived log segments followed by the active log
+ * file), they are read one after the other as if they were a single log.
+ *
+ * A log written as several streams (see LogManager) is read from all streams at once. Records of different streams are
+ * merged by the commit timestamps of the commit records they precede: every stream is read up to its next commit or
+ * abort record, and the stream whose next commit is oldest goes first. The records of a stream stay in order, so the
+ * records of a transaction precede its commit record, like in a single log.
+ *
+ * A transaction may depend on one that committed before it in another stream, so once a stream ends, no commit after
+ * its last one is replayed: the stream may have lost a commit that it depends on. Streams log watermark records (see
+ * CommitWatermark) to advance without new commits. They are only used to merge the streams and are never provided.
  */
 class DiskLogProvider : public AbstractLogProvider {
 public:
@@ -18,21 +32,82 @@ public:
      * @param log_file_path path to log file to read logs from
      */
     explicit DiskLogProvider(const std::string &log_file_path)
-        : in_(BufferedLogReader(log_file_path.c_str())) {}
+        : DiskLogProvider(std::vector<std::string>{log_file_path}) {}
+
+    /**
+     * @param log_file_paths paths to log files to read logs from, in the order they should be replayed. Log records
+     * must not straddle two files, which is guaranteed for files produced by LogManager::RotateLogFile.
+     */
+    explicit DiskLogProvider(std::vector<std::string> log_file_paths)
+        : log_file_paths_(std::move(log_file_paths)) {
+        if (!log_file_paths_.empty()) {
+            in_ = std::make_unique<BufferedLogReader>(log_file_paths_[0].c_str());
+        }
+    }
+
+    /**
+     * @param log_stream_file_paths for every stream of the log, the paths to its log files in the order they should be
+     * replayed, e.g. as given by LogManager::LogStreamFilesForRecovery
+     */
+    explicit DiskLogProvider(const std::vector<std::vector<std::string>> &log_stream_file_paths);
 
     LogProviderType GetType() const override {
         return LogProviderType::DISK;
     }
 
+    /**
+     * Provide next available log record, merging the streams of the log if there are several
+     * @return next log record along with vector of varlen entry pointers. nullptr log record if there are no more logs.
+     */
+    std::pair<LogRecord *, std::vector<byte *>> GetNextRecord() override;
+
 private:
-    // Buffered log file reader
-    storage::BufferedLogReader in_;
+    // A stream of the log, while it is merged with the other streams
+    struct LogStream {
+        // Reads the records of the stream
+        std::unique_ptr<DiskLogProvider> provider_;
+        // The records read ahead from the stream, up to and including the next commit or abort record
+        std::deque<std::pair<LogRecord *, std::vector<byte *>>> records_;
+        // Whether all records of the stream have been read ahead
+        bool exhausted_ = false;
+        // Commit timestamp of the newest commit record read from the stream, including watermark records
+        int64_t last_commit_ = 0;
+    };
+
+    // Paths of the log files to read, in order
+    std::vector<std::string> log_file_paths_;
+    // Index of the log file that is currently being read
+    uint32_t curr_file_idx_ = 0;
+    // Buffered log file reader for the current log file
+    std::unique_ptr<storage::BufferedLogReader> in_;
+
+    // The streams of the log, if there are several
+    std::vector<LogStream> streams_;
+    // The stream whose read ahead records are currently handed out, if any
+    LogStream *curr_stream_ = nullptr;
+
+    /**
+     * Reads ahead in every stream without read ahead records, and picks the stream whose read ahead records go next
+     * @return the stream, or nullptr if all streams are exhausted or the remaining records are cut off
+     */
+    LogStream *NextStream();
+
+    /**
+     * Frees the read ahead records of all streams, and stops reading them
+     */
+    void DropRemainingRecords();
 
     /**
      * @return true if log file contains more records, false otherwise
      */
     bool HasMoreRecords() override {
-        return in_.HasMore();
+        while (in_ != nullptr && !in_->HasMore()) {
+            // Move on to the next log file, if any
+            in_ = (++curr_file_idx_ < log_file_paths_.size())
+                      ? std::make_unique<BufferedLogReader>(log_file_paths_[curr_file_idx_].c_str())
+                      : nullptr;
+        }
+        return in_ != nullptr;
     }
 
     /**
@@ -42,7 +117,13 @@ private:
      * @return true if we read the given number of bytes
      */
     bool Read(void *dest, uint32_t size) override {
-        return in_.Read(dest, size);
+        return in_ != nullptr && in_->Read(dest, size);
+    }
+
+    void BeginFrame() override {
+        if (in_ != nullptr) {
+            in_->BeginFrame();
+        }
     }
 };
 
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -18,7 +20,10 @@
 #include "catalog/postgres/pg_namespace.h"
 #include "catalog/postgres/pg_type.h"
 #include "common/dedicated_thread_owner.h"
+#include "common/spin_latch.h"
+#include "common/worker_pool.h"
 #include "storage/recovery/abstract_log_provider.h"
+#include "storage/recovery/checkpoint_log_provider.h"
 #include "storage/sql_table.h"
 
 namespace noisepage {
@@ -78,6 +83,9 @@ class RecoveryManager : public common::DedicatedThreadOwner {
     };
 
 public:
+    /** Number of deferred transactions per replay thread to accumulate before replaying them concurrently. */
+    static constexpr uint32_t REPLAY_BATCH_SIZE_PER_THREAD = 64;
+
     /**
      * @param log_provider arbitrary provider to receive logs from
      * @param catalog system catalog to interface with sql tables
@@ -86,6 +94,10 @@ public:
      * @param replication_manager replication manager to acknowledge applied changes
      * @param thread_registry thread registry to register tasks
      * @param store block store used for SQLTable creation during recovery
+     * @param checkpoint_provider checkpoint to recover from before replaying the logs, if any. Only log records of
+     * transactions that committed after the checkpoint timestamp are replayed from the log provider.
+     * @param num_replay_threads number of threads that replay committed transactions. With more than one thread,
+     * transactions that do not touch the same tuples are replayed concurrently, see ProcessDeferredTransactions.
      */
     explicit RecoveryManager(const common::ManagedPointer<AbstractLogProvider>                log_provider,
                              const common::ManagedPointer<catalog::Catalog>                   catalog,
@@ -93,14 +105,22 @@ public:
                              const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
                              const common::ManagedPointer<replication::ReplicationManager>    replication_manager,
                              const common::ManagedPointer<noisepage::common::DedicatedThreadRegistry> thread_registry,
-                             const common::ManagedPointer<BlockStore>                                 store)
+                             const common::ManagedPointer<BlockStore>                                 store,
+                             const common::ManagedPointer<CheckpointLogProvider> checkpoint_provider = nullptr,
+                             const uint32_t                                      num_replay_threads = 1)
         : DedicatedThreadOwner(thread_registry)
         , log_provider_(log_provider)
+        , checkpoint_provider_(checkpoint_provider)
         , catalog_(catalog)
         , txn_manager_(txn_manager)
         , deferred_action_manager_(deferred_action_manager)
         , replication_manager_(replication_manager)
         , block_store_(store) {
+        NOISEPAGE_ASSERT(num_replay_threads > 0, "Recovery needs at least one replay thread");
+        if (num_replay_threads > 1) {
+            replay_pool_ = std::make_unique<common::WorkerPool>(num_replay_threads, common::TaskQueue{});
+            replay_pool_->Startup();
+        }
         // Initialize catalog_table_schemas_ map
         catalog_table_schemas_[catalog::postgres::PgClass::CLASS_TABLE_OID]
             = catalog::postgres::Builder::GetClassTableSchema();
@@ -132,14 +152,53 @@ public:
         return last_applied_txn_id_;
     }
 
+    /** @return The number of threads that replay committed transactions. */
+    uint32_t GetNumReplayThreads() const {
+        return replay_pool_ == nullptr ? 1 : replay_pool_->NumWorkers();
+    }
+
 private:
     FRIEND_TEST(RecoveryTests, DoubleRecoveryTest);
     friend class RecoveryTests;
+    friend class CheckpointTests;
     friend class noisepage::RecoveryBenchmark;
 
+    /** The log records of a transaction, along with the varlens they own. */
+    using BufferedChanges = std::vector<std::pair<LogRecord *, std::vector<byte *>>>;
+
+    /**
+     * The tuples and tables that a batch of concurrently replayed transactions touch. Transactions can be replayed
+     * concurrently as long as none of them touch the same tuple. In addition, a transaction that inserts into a table
+     * cannot be replayed concurrently with an earlier one that deleted from it, as the insert may reuse a unique key
+     * freed by the delete.
+     */
+    class ReplayBatchFootprint {
+    public:
+        /**
+         * Adds a transaction to the batch, if it does not conflict with any transaction already in it
+         * @param recovery_manager recovery manager used to tell inserts from updates
+         * @param buffered_changes changes of the transaction
+         * @return true if the transaction was added, false if it conflicts with the batch
+         */
+        bool TryAdd(const RecoveryManager &recovery_manager, const BufferedChanges &buffered_changes);
+
+        /** Empties the batch */
+        void Clear() {
+            tuple_slots_.clear();
+            deleted_tables_.clear();
+        }
+
+    private:
+        std::unordered_set<TupleSlot> tuple_slots_;
+        std::unordered_set<uint64_t>  deleted_tables_;
+    };
+
     // Log provider for reading in logs
     const common::ManagedPointer<AbstractLogProvider> log_provider_;
 
+    // Checkpoint to recover from before replaying the logs, may be nullptr
+    const common::ManagedPointer<CheckpointLogProvider> checkpoint_provider_;
+
     // Catalog to fetch table pointers
     const common::ManagedPointer<catalog::Catalog> catalog_;
 
@@ -161,6 +220,13 @@ private:
     // TODO(Gus): This map may get huge, benchmark whether this becomes a problem and if we need a more sophisticated
     // data structure
     std::unordered_map<TupleSlot, TupleSlot> tuple_slot_map_;
+    // Protects tuple_slot_map_ while transactions are replayed concurrently
+    mutable common::SpinLatch tuple_slot_map_latch_;
+
+    // Threads that replay batches of non-conflicting transactions, nullptr if transactions are replayed serially
+    std::unique_ptr<common::WorkerPool> replay_pool_;
+    // Largest oldest active txn of the commit records seen since deferred transactions were last processed
+    transaction::timestamp_t replay_upper_bound_ = transaction::INVALID_TXN_TIMESTAMP;
 
     // Used during recovery from log. Stores deferred transactions in sorted sorted order to be able to execute them in
     // serial order. Transactions are defered when there is an older active transaction at the time it committed. Even
@@ -170,8 +236,7 @@ private:
 
     // Used during recovery from log. Maps a the txn id from the persisted txn to its changes we have buffered. We
     // buffer changes until commit time. This ensures serializability, and allows us to skip changes from aborted txns.
-    std::unordered_map<transaction::timestamp_t, std::vector<std::pair<LogRecord *, std::vector<byte *>>>>
-        buffered_changes_map_;
+    std::unordered_map<transaction::timestamp_t, BufferedChanges> buffered_changes_map_;
 
     // Background recovery task
     common::ManagedPointer<RecoveryTask> recovery_task_ = nullptr;
@@ -191,21 +256,34 @@ private:
 
     transaction::timestamp_t last_applied_txn_id_ = transaction::INITIAL_TXN_TIMESTAMP; ///< The last applied txn's ID.
     uint32_t                 recovered_txns_ = 0; ///< The number of recovered committed txns.
+    /** Transactions that committed before this timestamp are contained in the recovered checkpoint. */
+    transaction::timestamp_t checkpoint_timestamp_ = transaction::INITIAL_TXN_TIMESTAMP;
+    bool                     checkpoint_recovered_ = false; ///< True if the checkpoint has already been replayed.
+    /** Newest begin or commit timestamp of any recovered record. */
+    transaction::timestamp_t max_recovered_timestamp_ = transaction::INITIAL_TXN_TIMESTAMP;
 
     /**
-     * Recovers the databases using the provided log provider
+     * Recovers the databases using the provided checkpoint and log provider
      */
     void Recover() {
+        if (checkpoint_provider_ != nullptr && !checkpoint_recovered_)
+            RecoverFromCheckpoint(checkpoint_provider_);
         if (log_provider_ != nullptr)
             RecoverFromLogs(log_provider_);
     }
 
     /**
      * Recovers the databases from the logs.
-     * @note this is a separate method so in the future, we can also have a RecoverFromCheckpoint method
      */
     void RecoverFromLogs(common::ManagedPointer<AbstractLogProvider> log_provider_);
 
+    /**
+     * Recovers the databases from a checkpoint. Checkpoints are serialized in the log format, so they are replayed the
+     * same way as logs. Afterwards, log records of transactions that committed before the checkpoint are skipped.
+     * @param checkpoint_provider provider for the checkpoint to recover from
+     */
+    void RecoverFromCheckpoint(common::ManagedPointer<CheckpointLogProvider> checkpoint_provider);
+
     /**
      * @brief Replay a committed transaction corresponding to txn_id.
      * @param txn_id start timestamp for committed transaction
@@ -213,46 +291,116 @@ private:
      */
     uint32_t ProcessCommittedTransaction(transaction::timestamp_t txn_id);
 
+    /**
+     * Replays the buffered changes of a committed transaction in a new transaction. Safe to call concurrently for
+     * transactions that do not conflict, see ReplayBatchFootprint.
+     * @param buffered_changes changes to replay, their log records are deferred for deletion
+     * @return number of records replayed
+     */
+    uint32_t ReplayCommittedTransaction(BufferedChanges *buffered_changes);
+
+    /**
+     * Replays a batch of non-conflicting committed transactions concurrently, and clears the batch
+     * @param batch txn ids of the transactions to replay, in commit order
+     * @return number of records replayed
+     */
+    uint32_t ProcessCommittedTransactionBatch(std::vector<transaction::timestamp_t> *batch);
+
+    /**
+     * Marks a transaction as applied, and acknowledges it to the primary if we are a replica
+     * @param txn_id start timestamp of the applied transaction
+     */
+    void FinishCommittedTransaction(transaction::timestamp_t txn_id);
+
     /**
      * Defers log records deletes with the transaction manager
      * @param txn_id txn_id for txn who's records to delete
      * @param delete_varlens true if we should delete varlens allocated for txn
      */
-    void DeferRecordDeletes(transaction::timestamp_t txn_id, bool delete_varlens);
+    void DeferRecordDeletes(transaction::timestamp_t txn_id, bool delete_varlens) {
+        DeferRecordDeletes(std::move(buffered_changes_map_[txn_id]), delete_varlens);
+    }
+
+    /**
+     * Defers log records deletes with the transaction manager
+     * @param buffered_changes records to delete
+     * @param delete_varlens true if we should delete varlens allocated for txn
+     */
+    void DeferRecordDeletes(BufferedChanges &&buffered_changes, bool delete_varlens);
 
     /**
      * Replay any transaction who's txn start time is less than upper_bound. If upper_bound ==
-     * transaction::NO_ACTIVE_TXN, it will replay all deferred transactions
+     * transaction::NO_ACTIVE_TXN, it will replay all deferred transactions. With multiple replay threads, the
+     * transactions are split into batches of non-conflicting transactions that are replayed concurrently. Transactions
+     * that modify the catalog are replayed alone.
      * @param upper_bound upper bound for replaying
      * @return number of transactions and records replayed
      */
     std::pair<uint32_t, uint32_t> ProcessDeferredTransactions(transaction::timestamp_t upper_bound);
 
+    /**
+     * @param buffered_changes changes of a transaction
+     * @return true if the transaction modifies the catalog, and thus cannot be replayed concurrently with others
+     */
+    static bool RequiresSerialReplay(const BufferedChanges &buffered_changes);
+
     /**
      * Handles mapping of old tuple slot (before recovery) to new tuple slot (after recovery)
      * @param slot old tuple slot
      * @return new tuple slot
      */
     TupleSlot GetTupleSlotMapping(TupleSlot slot) {
+        common::SpinLatch::ScopedSpinLatch guard(&tuple_slot_map_latch_);
         NOISEPAGE_ASSERT(tuple_slot_map_.find(slot) != tuple_slot_map_.end(), "No tuple slot mapping exists");
         return tuple_slot_map_[slot];
     }
 
+    /**
+     * Maps an old tuple slot (before recovery) to the new tuple slot (after recovery) of an inserted tuple
+     * @param old_slot old tuple slot
+     * @param new_slot new tuple slot
+     */
+    void SetTupleSlotMapping(TupleSlot old_slot, TupleSlot new_slot) {
+        common::SpinLatch::ScopedSpinLatch guard(&tuple_slot_map_latch_);
+        tuple_slot_map_[old_slot] = new_slot;
+    }
+
+    /**
+     * Removes the mapping of a deleted tuple
+     * @param old_slot old tuple slot
+     */
+    void EraseTupleSlotMapping(TupleSlot old_slot) {
+        common::SpinLatch::ScopedSpinLatch guard(&tuple_slot_map_latch_);
+        tuple_slot_map_.erase(old_slot);
+    }
+
     /**
      * Wrapper over GetDatabaseCatalog method that asserts the database exists
      * @param txn txn for catalog lookup
      * @param database oid for database we want
+     * @param ddl_lock true if txn modifies the catalog and should take the DDL lock of the database. Transactions that
+     * only modify user tables are replayed concurrently, so they must not take it.
      * @return pointer to database catalog
      */
-    common::ManagedPointer<catalog::DatabaseCatalog> GetDatabaseCatalog(transaction::TransactionContext *txn,
-                                                                        catalog::db_oid_t                db_oid) {
+    common::ManagedPointer<catalog::DatabaseCatalog>
+    GetDatabaseCatalog(transaction::TransactionContext *txn, catalog::db_oid_t db_oid, const bool ddl_lock = true) {
         auto db_catalog_ptr = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
         NOISEPAGE_ASSERT(db_catalog_ptr != nullptr, "No catalog for given database oid");
-        auto result [[maybe_unused]] = db_catalog_ptr->TryLock(common::ManagedPointer(txn));
-        NOISEPAGE_ASSERT(result, "There should not be concurrent DDL changes during recovery.");
+        if (ddl_lock) {
+            auto result [[maybe_unused]] = db_catalog_ptr->TryLock(common::ManagedPointer(txn));
+            NOISEPAGE_ASSERT(result, "There should not be concurrent DDL changes during recovery.");
+        }
         return db_catalog_ptr;
     }
 
+    /**
+     * @param table_oid oid of a table
+     * @return true if the table is a catalog table
+     */
+    static bool IsCatalogTable(const catalog::table_oid_t table_oid) {
+        return table_oid.UnderlyingValue() < catalog::START_OID;
+    }
+
     /**
      * @param txn transaction to use for catalog lookup
      * @param db_oid database oid for requested table
@@ -328,6 +476,7 @@ private:
      * @return true if record is an insert redo, false if it is an update redo
      */
     bool IsInsertRecord(const RedoRecord *record) const {
+        common::SpinLatch::ScopedSpinLatch guard(&tuple_slot_map_latch_);
         return tuple_slot_map_.find(record->GetTupleSlot()) == tuple_slot_map_.end();
     }
 
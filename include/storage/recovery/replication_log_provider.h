@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstring>
 #include <memory>
 #include <queue>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -9,6 +11,7 @@
 #include "network/network_io_utils.h"
 #include "replication/replication_messages.h"
 #include "storage/recovery/abstract_log_provider.h"
+#include "storage/write_ahead_log/log_compression.h"
 #include "storage/write_ahead_log/log_io.h"
 
 namespace noisepage::storage {
@@ -173,9 +176,12 @@ private:
             {
                 const replication::RecordsBatchMsg &msg = received_batch_queue_.top();
                 std::string                         contents = msg.GetContents();
-                std::vector<unsigned char>          bytes(contents.begin(), contents.end());
-                network::ReadBufferView             view(bytes.size(), bytes.begin());
-                auto                                buffer = std::make_unique<network::ReadBuffer>();
+                if (msg.IsFramed()) {
+                    contents = DecodeFrame(contents);
+                }
+                std::vector<unsigned char> bytes(contents.begin(), contents.end());
+                network::ReadBufferView    view(bytes.size(), bytes.begin());
+                auto                       buffer = std::make_unique<network::ReadBuffer>();
                 buffer->FillBufferFrom(view, bytes.size());
 
                 NOISEPAGE_ASSERT(
@@ -198,6 +204,21 @@ private:
         return (readable_size < size) ? Read(static_cast<char *>(dest) + readable_size, size - readable_size) : true;
     }
 
+    /** @return The buffer contents of a log frame that was shipped as a whole. Throws if the frame is malformed. */
+    static std::string DecodeFrame(const std::string &frame) {
+        LogFrameHeader header;
+        if (frame.size() < sizeof(header)) {
+            throw std::runtime_error("Replicated log frame is too short");
+        }
+        std::memcpy(&header, frame.data(), sizeof(header));
+        if (frame.size() - sizeof(header) != header.stored_size_) {
+            throw std::runtime_error("Replicated log frame has the wrong size");
+        }
+        std::string contents(header.raw_size_, '\0');
+        LogCompression::DecodeFrame(header, frame.data() + sizeof(header), contents.data());
+        return contents;
+    }
+
     bool replication_active_ = true; ///< True if replication is currently active. False otherwise.
     std::unique_ptr<network::ReadBuffer> curr_buffer_ = nullptr; ///< Current buffer to read logs from.
 
@@ -30,6 +30,8 @@ class Schema;
 
 namespace noisepage::storage {
 
+class ArrowStreamWriter;
+
 /**
  * A SqlTable is a thin layer above DataTable that replaces storage layer concepts like BlockLayout with SQL layer
  * concepts like Schema. The goal is to hide concepts like col_id_t and BlockLayout above the SqlTable level.
@@ -134,6 +136,47 @@ public:
         return slot;
     }
 
+    /**
+     * Allocates an empty block for bulk loading, @see DataTable::NewBulkLoadBlock
+     * @return the new block, private to the caller until it is passed to InsertBlock or ReleaseBulkLoadBlock
+     */
+    auto NewBulkLoadBlock() const -> RawBlock * {
+        return table_.data_table_->NewBulkLoadBlock();
+    }
+
+    /**
+     * Copies a tuple into the next free slot of a bulk load block, @see DataTable::BulkLoadInto
+     * @param block the private block to fill
+     * @param row after-image of the tuple, must contain every column of the table
+     * @return false if the block is full, true otherwise
+     */
+    auto BulkLoadInto(RawBlock *const block, const ProjectedRow &row) const -> bool {
+        return table_.data_table_->BulkLoadInto(block, row);
+    }
+
+    /**
+     * Inserts every tuple of a bulk load block into the table on behalf of txn, @see DataTable::InsertBlock. The tuples
+     * are logged here in batches of block insert records, so unlike Insert there is no StageWrite to call beforehand.
+     * @param txn the calling transaction
+     * @param db_oid the database oid of this table
+     * @param table_oid the oid of this table
+     * @param block a block filled through BulkLoadInto, must hold at least one tuple
+     * @return number of tuples inserted
+     * @warning not thread-safe, concurrent loaders into the same transaction must serialize their calls
+     */
+    auto InsertBlock(common::ManagedPointer<transaction::TransactionContext> txn,
+                     catalog::db_oid_t                                       db_oid,
+                     catalog::table_oid_t                                    table_oid,
+                     RawBlock                                               *block) const -> uint32_t;
+
+    /**
+     * Releases a bulk load block that will not be inserted, @see DataTable::ReleaseBulkLoadBlock
+     * @param block the private block to release
+     */
+    void ReleaseBulkLoadBlock(RawBlock *const block) const {
+        table_.data_table_->ReleaseBulkLoadBlock(block);
+    }
+
     /**
      * Deletes the given TupleSlot. StageDelete must have been called as well in order for the operation to be logged.
      * @param txn the calling transaction
@@ -187,13 +230,31 @@ public:
      * @param txn The calling transaction.
      * @param start_pos Iterator to the starting location for the sequential scan.
      * @param out_buffer Output buffer. This buffer is always cleared of old values.
+     * @param block_filters Value ranges that the caller discards every tuple outside of, used to skip whole blocks.
      */
     void Scan(const common::ManagedPointer<transaction::TransactionContext> txn,
               DataTable::SlotIterator *const                                start_pos,
-              execution::sql::VectorProjection *const                       out_buffer) const {
-        return table_.data_table_->Scan(txn, start_pos, out_buffer);
+              execution::sql::VectorProjection *const                       out_buffer,
+              const std::vector<ZoneMapFilter>                             &block_filters = {}) const {
+        return table_.data_table_->Scan(txn, start_pos, out_buffer, block_filters);
     }
 
+    /**
+     * Streams the tuples visible to the transaction in the Arrow IPC streaming format, sending the buffers of frozen
+     * blocks without copying them. See ArrowSerializer::ExportStream.
+     * @param txn the calling transaction
+     * @param col_oids columns to export, in order
+     * @param col_types types of the exported columns
+     * @param col_names names of the exported columns
+     * @param writer destination of the stream
+     * @return number of exported tuples
+     */
+    auto ExportArrowStream(common::ManagedPointer<transaction::TransactionContext> txn,
+                           const std::vector<catalog::col_oid_t>                  &col_oids,
+                           const std::vector<execution::sql::SqlTypeId>           &col_types,
+                           const std::vector<std::string>                         &col_names,
+                           ArrowStreamWriter *writer) const -> uint64_t;
+
     /**
      * @return the first tuple slot contained in the underlying DataTable
      */
@@ -275,6 +336,7 @@ private:
     friend class noisepage::RandomSqlTableTransaction;
     friend class noisepage::LargeSqlTableTestObject;
     friend class RecoveryTests;
+    friend class CheckpointTests;
 
     /**
      * Internals are exposed to execution::sql::IndCteScanIterator to be able to call Reset and CopyTable,
@@ -218,12 +218,12 @@ using ProjectionMap = std::unordered_map<catalog::col_oid_t, uint16_t>;
 /**
  * Denote whether a record modifies the logical delete column, used when DataTable inspects deltas
  */
-enum class DeltaRecordType : uint8_t { UPDATE = 0, INSERT, DELETE };
+enum class DeltaRecordType : uint8_t { UPDATE = 0, INSERT, DELETE, BLOCK_INSERT };
 
 /**
  * Types of LogRecords
  */
-enum class LogRecordType : uint8_t { REDO = 1, DELETE, COMMIT, ABORT };
+enum class LogRecordType : uint8_t { REDO = 1, DELETE, COMMIT, ABORT, BLOCK_INSERT };
 
 } // namespace noisepage::storage
 
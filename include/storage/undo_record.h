@@ -91,11 +91,33 @@ public:
         return reinterpret_cast<const ProjectedRow *>(varlen_contents_);
     }
 
+    /**
+     * @return number of consecutive slots, starting at Slot(), covered by this record
+     * @warning only meaningful for BLOCK_INSERT records, every other record covers exactly one slot
+     */
+    uint32_t NumSlots() const {
+        return type_ == DeltaRecordType::BLOCK_INSERT ? *reinterpret_cast<const uint32_t *>(varlen_contents_) : 1;
+    }
+
     /**
      * @return size of this UndoRecord in memory, in bytes.
      */
     uint32_t Size() const {
-        return static_cast<uint32_t>(sizeof(UndoRecord) + (type_ == DeltaRecordType::UPDATE ? Delta()->Size() : 0));
+        switch (type_) {
+        case DeltaRecordType::UPDATE:
+            return static_cast<uint32_t>(sizeof(UndoRecord)) + Delta()->Size();
+        case DeltaRecordType::BLOCK_INSERT:
+            return BlockInsertSize();
+        default:
+            return static_cast<uint32_t>(sizeof(UndoRecord));
+        }
+    }
+
+    /**
+     * @return size of an UndoRecord for a block insert, in bytes
+     */
+    static constexpr uint32_t BlockInsertSize() {
+        return static_cast<uint32_t>(sizeof(UndoRecord) + sizeof(uint64_t));
     }
 
     /**
@@ -138,6 +160,32 @@ public:
         return result;
     }
 
+    /**
+     * Populates the UndoRecord to hold a bulk insert of num_slots consecutive slots of a block. A single record is
+     * shared by the version chains of all of those slots, so that bulk loading does not pay for one record per tuple.
+     *
+     * @param head pointer to the byte buffer to initialize as a UndoRecord, must be at least BlockInsertSize() bytes
+     * @param timestamp timestamp of the transaction that generated this UndoRecord
+     * @param first_slot the first TupleSlot this UndoRecord points to
+     * @param num_slots number of consecutive slots, starting at first_slot, that this UndoRecord points to
+     * @param table the DataTable this UndoRecord points to
+     * @return pointer to the initialized UndoRecord
+     */
+    static UndoRecord *InitializeBlockInsert(byte *const                    head,
+                                             const transaction::timestamp_t timestamp,
+                                             const TupleSlot                first_slot,
+                                             const uint32_t                 num_slots,
+                                             DataTable *const               table) {
+        auto *result = reinterpret_cast<UndoRecord *>(head);
+        result->type_ = DeltaRecordType::BLOCK_INSERT;
+        result->next_ = nullptr;
+        result->timestamp_.store(timestamp);
+        result->table_ = table;
+        result->slot_ = first_slot;
+        *reinterpret_cast<uint32_t *>(result->varlen_contents_) = num_slots;
+        return result;
+    }
+
     /**
      * Populates the UndoRecord to hold a delete.
      *
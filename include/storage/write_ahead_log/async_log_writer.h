@@ -0,0 +1,214 @@
+#pragma once
+
+#include <chrono> // NOLINT
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/constants.h"
+#include "common/macros.h"
+#include "storage/write_ahead_log/log_io.h"
+
+namespace noisepage::storage {
+
+class AsyncIoBackend;
+
+/**
+ * Writes the log file asynchronously, as an alternative to writing and persisting it through BufferedLogWriter. The
+ * file is opened with O_DIRECT and preallocated in chunks of PREALLOCATION_SIZE, so that persisting it does not have to
+ * allocate space on the device. Writes and fdatasyncs are submitted through io_uring, or handed to a small pool of
+ * threads if io_uring is not available, and the caller carries on while they are in flight.
+ *
+ * Appended data is staged in block-aligned write buffers. Every call to Flush() closes a flush group: the writes of a
+ * group are submitted right away, and the group is synced as soon as all of them are done. Up to io_depth writes and
+ * io_depth groups can be in flight. The commit callbacks of a group are invoked once the group and all groups before
+ * it are persisted, so commits are acknowledged in the order in which they became durable.
+ *
+ * Writes always cover whole blocks of common::Constants::LOG_BLOCK_SIZE bytes. Flush() pads the last block of a group
+ * with at least four zero bytes, which a reader sees as a frame marker of 0 (see LogFrameHeader), and the next group
+ * starts on the next block. Data must therefore be appended in frames, which BufferedLogWriter::FlushBuffer() does.
+ * No block is ever written twice, so writes in flight never need to be ordered.
+ */
+class AsyncLogWriter {
+public:
+    /** Size of the chunks in which the log file is preallocated */
+    static constexpr uint64_t PREALLOCATION_SIZE = 16 * common::Constants::MB;
+    /** Size of the buffers that appended data is staged in, each of which is written with a single write */
+    static constexpr uint32_t WRITE_BUFFER_SIZE = 64 * common::Constants::KB;
+
+    /**
+     * Opens the given log file for asynchronous writes. New data is appended to the end of the file if it exists;
+     * otherwise, the file is created.
+     * @param log_file_path path to the log file to write to
+     * @param io_depth maximum number of writes, and of flush groups, in flight at a time
+     */
+    AsyncLogWriter(const std::string &log_file_path, uint32_t io_depth);
+
+    /**
+     * Waits for all writes in flight and closes the log file, if it is still open
+     */
+    ~AsyncLogWriter();
+
+    DISALLOW_COPY_AND_MOVE(AsyncLogWriter);
+
+    /**
+     * Appends the given bytes to the log. Blocks only if all write buffers are in flight.
+     * @param data memory location of the bytes to write
+     * @param size number of bytes to write
+     */
+    void Append(const void *data, uint32_t size);
+
+    /**
+     * Submits everything appended since the last flush, and has it persisted once it is written
+     * @param callbacks commit callbacks to invoke once everything appended so far is persisted
+     */
+    void Flush(std::vector<CommitCallback> &&callbacks);
+
+    /**
+     * Processes the completed writes and syncs, and invokes the commit callbacks of all persisted flush groups
+     * @param wait true to wait until every group flushed so far is persisted
+     * @return number of commit callbacks invoked since the last call
+     */
+    uint64_t ProcessCompletions(bool wait);
+
+    /**
+     * Has the commit callbacks of persisted flush groups handed to the given function instead of invoked, e.g. to hold
+     * them back until the other streams of the log have caught up (see CommitWatermark)
+     * @param persisted function that takes the callbacks of a persisted group
+     */
+    void SetPersistedCallbackHandler(std::function<void(std::vector<CommitCallback> *)> persisted) {
+        persisted_callback_handler_ = std::move(persisted);
+    }
+
+    /** @return true if there are flushed groups that are not persisted yet */
+    bool HasPendingFlushes() const {
+        return groups_.size() > 1;
+    }
+
+    /**
+     * Moves the latencies of the flush groups persisted since the last call, from their flush until they were
+     * persisted, to the given vector. Groups without any writes are left out.
+     * @param[out] latencies vector to append the latencies to
+     */
+    void TakePersistLatencies(std::vector<std::chrono::microseconds> *latencies) {
+        latencies->insert(latencies->end(), persist_latencies_.begin(), persist_latencies_.end());
+        persist_latencies_.clear();
+    }
+
+    /** @return true if writes go through io_uring, false if they go through the thread pool */
+    bool UsesIoUring() const {
+        return uses_io_uring_;
+    }
+
+    /**
+     * Flushes and persists everything appended so far, and closes the log file. Must be called before the log file is
+     * moved.
+     */
+    void Close();
+
+    /**
+     * Reopens the writer on the given log file. The writer must have been closed.
+     * @param log_file_path path to the log file to write to. Created if it does not exist.
+     */
+    void Reopen(const std::string &log_file_path);
+
+private:
+    // A block-aligned buffer that appended data is staged in, and that is written with a single write
+    struct WriteBuffer {
+        // The staged data, aligned to a block. Has room for one block of padding beyond WRITE_BUFFER_SIZE.
+        char *data_ = nullptr;
+        // Number of bytes staged, including the padding once the buffer is submitted
+        uint32_t size_ = 0;
+        // Number of bytes written so far, if the write was split up
+        uint32_t written_ = 0;
+        // Offset in the log file that the buffer is written to
+        uint64_t offset_ = 0;
+        // Id of the flush group that the buffer belongs to
+        uint64_t group_id_ = 0;
+    };
+
+    // The writes of the data flushed by one call to Flush(), and the commit callbacks to invoke once it is persisted
+    struct FlushGroup {
+        // Commit callbacks to invoke once the group is persisted
+        std::vector<CommitCallback> callbacks_;
+        // Number of writes of the group that are in flight
+        uint32_t writes_in_flight_ = 0;
+        // Whether any data of the group was written
+        bool has_writes_ = false;
+        // Whether Flush() closed the group, so that no writes are added anymore
+        bool flushed_ = false;
+        // Whether the sync of the group was submitted
+        bool sync_submitted_ = false;
+        // Whether the group is persisted
+        bool persisted_ = false;
+        // When Flush() closed the group
+        std::chrono::high_resolution_clock::time_point flush_time_;
+    };
+
+    // Opens the log file and picks up where the data in it ends
+    void Open(const std::string &log_file_path);
+
+    // Returns a free write buffer, waiting for a write to complete if there is none
+    WriteBuffer *AcquireBuffer();
+
+    // Submits the write of the staged buffer, padding its last block if it is partially filled
+    void SubmitStaged(bool pad);
+
+    // Submits the remaining part of the write of the given buffer
+    void SubmitWrite(uint32_t buffer_id);
+
+    // Submits the sync of the given group if all its writes are done
+    void MaybeSubmitSync(uint64_t group_id);
+
+    // Reaps completed writes and syncs, and invokes the callbacks of persisted groups. Waits for at least one
+    // completion if wait is set and anything is in flight.
+    void Reap(bool wait);
+
+    // Makes sure that the log file is preallocated up to the given offset
+    void Preallocate(uint64_t end);
+
+    // Maximum number of writes, and of flush groups, in flight at a time
+    const uint32_t io_depth_;
+    // Submits writes and syncs, and reports their completion
+    std::unique_ptr<AsyncIoBackend> backend_;
+    // Whether the backend is io_uring
+    bool uses_io_uring_;
+    // Number of writes and syncs submitted to the backend that did not complete yet
+    uint32_t in_flight_ = 0;
+
+    // fd of the log file, or -1 if closed
+    int fd_ = -1;
+    // Offset in the log file where the next write buffer goes
+    uint64_t next_offset_ = 0;
+    // Offset up to which the log file is preallocated, or 0 if the file system does not support preallocation
+    uint64_t preallocated_end_ = 0;
+    // Whether the file system supports preallocation
+    bool can_preallocate_ = true;
+
+    // Backing memory of the write buffers
+    std::unique_ptr<char[]> buffer_memory_;
+    // The write buffers, by id
+    std::vector<WriteBuffer> buffers_;
+    // Ids of the write buffers that are neither staged nor in flight
+    std::vector<uint32_t> free_buffers_;
+    // The buffer that appended data is staged in, if any
+    WriteBuffer *staged_ = nullptr;
+
+    // Flush groups that are not persisted yet, from oldest to newest. The newest group is the one that appended data
+    // goes to, it is flushed by the next call to Flush().
+    std::deque<FlushGroup> groups_;
+    // Id of the oldest group in groups_
+    uint64_t first_group_id_ = 0;
+    // Number of commit callbacks invoked since the last call to ProcessCompletions()
+    uint64_t callbacks_invoked_ = 0;
+    // Takes the commit callbacks of persisted groups in place of invoking them, if set
+    std::function<void(std::vector<CommitCallback> *)> persisted_callback_handler_;
+    // Latencies of the groups with writes that were persisted since the last call to TakePersistLatencies()
+    std::vector<std::chrono::microseconds> persist_latencies_;
+};
+
+} // namespace noisepage::storage
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <condition_variable> // NOLINT
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "common/spin_latch.h"
+#include "storage/write_ahead_log/log_io.h"
+#include "storage/write_ahead_log/log_record.h"
+#include "transaction/transaction_defs.h"
+
+namespace noisepage::storage {
+
+/**
+ * Orders the commit callbacks of a log that is split into several streams (see LogManager). A transaction may depend on
+ * one that committed before it in another stream, so recovery stops at the oldest commit that every stream reached (see
+ * DiskLogProvider), and a commit is only acknowledged once it is within that bound. The watermark is the smallest of
+ * the newest commit timestamps persisted by each stream, and the callback of a persisted commit is held until the
+ * watermark reaches it. A read-only transaction is never replayed and only depends on commits older than its start, so
+ * its callback is held until the watermark reaches its start timestamp.
+ *
+ * A stream without new commits would hold back the others forever. A stream that lags behind a held callback is
+ * therefore woken up to log a watermark record: a commit record whose start and commit timestamps are both the
+ * timestamp to catch up to, which no transaction can write, and which recovery only uses to advance the stream.
+ */
+class CommitWatermark {
+public:
+    /**
+     * @param num_streams number of streams of the log
+     */
+    explicit CommitWatermark(uint32_t num_streams)
+        : persisted_(num_streams, transaction::INITIAL_TXN_TIMESTAMP)
+        , wakeups_(num_streams, nullptr) {}
+
+    /**
+     * Registers the condition variable that the disk log consumer task of a stream waits on, which is notified when
+     * the stream lags behind a held callback
+     * @param stream_id id of the stream
+     * @param wakeup condition variable to notify
+     */
+    void RegisterStream(const uint32_t stream_id, std::condition_variable *const wakeup) {
+        common::SpinLatch::ScopedSpinLatch guard(&latch_);
+        wakeups_[stream_id] = wakeup;
+    }
+
+    /**
+     * Advances the stream past the commits of the given callbacks, which the stream has persisted, and invokes all held
+     * callbacks that the watermark has reached, including those of other streams
+     * @param stream_id id of the stream that persisted the commits
+     * @param callbacks commit callbacks of the persisted commits, cleared by the call
+     */
+    void Persisted(uint32_t stream_id, std::vector<CommitCallback> *callbacks);
+
+    /**
+     * @param stream_id id of the stream
+     * @return the commit timestamp that the stream has to log a watermark record for to release the held callbacks, or
+     * INVALID_TXN_TIMESTAMP if the stream does not hold back any callback
+     */
+    transaction::timestamp_t LagTarget(uint32_t stream_id);
+
+    /** @return true if any persisted commit waits for the watermark */
+    bool HasHeldCallbacks() {
+        common::SpinLatch::ScopedSpinLatch guard(&latch_);
+        return !held_.empty();
+    }
+
+    /**
+     * @param record a commit record
+     * @param txn_begin start timestamp of the log record
+     * @return true if the record is a watermark record rather than the commit of a transaction
+     */
+    static bool IsWatermarkRecord(const CommitRecord &record, const transaction::timestamp_t txn_begin) {
+        return record.CommitTime() == txn_begin;
+    }
+
+private:
+    // A persisted commit whose callback is held until the watermark reaches its key
+    struct HeldCallback {
+        transaction::timestamp_t key_;
+        CommitCallback           callback_;
+
+        bool operator>(const HeldCallback &other) const {
+            return key_ > other.key_;
+        }
+    };
+
+    common::SpinLatch latch_;
+    // Newest commit timestamp persisted by each stream
+    std::vector<transaction::timestamp_t> persisted_;
+    // Condition variables to notify streams that lag behind, by stream id
+    std::vector<std::condition_variable *> wakeups_;
+    // Held callbacks, oldest key first
+    std::priority_queue<HeldCallback, std::vector<HeldCallback>, std::greater<>> held_;
+    // Largest key of any held callback, not reset when callbacks are released
+    transaction::timestamp_t max_held_key_ = transaction::INITIAL_TXN_TIMESTAMP;
+};
+
+} // namespace noisepage::storage
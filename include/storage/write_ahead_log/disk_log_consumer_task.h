@@ -1,6 +1,9 @@
 #pragma once
 
 #include <condition_variable> // NOLINT
+#include <deque>
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -8,36 +11,81 @@
 #include "common/container/concurrent_queue.h"
 #include "common/dedicated_thread_task.h"
 #include "storage/storage_defs.h"
+#include "storage/write_ahead_log/async_log_writer.h"
+#include "storage/write_ahead_log/commit_watermark.h"
+#include "storage/write_ahead_log/group_commit_controller.h"
 #include "storage/write_ahead_log/log_io.h"
 
 namespace noisepage::storage {
 
 /**
  * A DiskLogConsumerTask is responsible for writing serialized log records out to disk by processing buffers in the log
- * manager's filled buffer queue
+ * manager's filled buffer queue. By default, every persist writes out the buffers and fsyncs the log file before the
+ * task moves on. With an async io depth, the buffers are handed to an AsyncLogWriter instead, so that the task keeps
+ * draining buffers while writes and syncs are in flight, and commit callbacks are invoked as the writes complete.
+ *
+ * The log file is persisted at the persist interval, unless a group commit target latency is given. In that case, a
+ * GroupCommitController decides when to persist, from the observed persist latencies and commit arrival rate.
+ *
+ * If the log is split into several streams, the commit callbacks are handed to a CommitWatermark once they are
+ * persisted, which holds them until every stream has caught up. The task logs a watermark record whenever its stream
+ * holds back the callbacks of the others.
  */
 class DiskLogConsumerTask : public common::DedicatedThreadTask {
 public:
     /**
      * Constructs a new DiskLogConsumerTask
+     * @param log_file_path path of the log file that the buffers write to, used when rotating the log file
      * @param persist_interval Interval time for when to persist log file
      * @param persist_threshold threshold of data written since the last persist to trigger another persist
      * @param buffers pointer to list of all buffers used by log manager, used to persist log file
      * @param empty_buffer_queue pointer to queue to push empty buffers to
      * @param filled_buffer_queue pointer to queue to pop filled buffers from
+     * @param async_io_depth number of writes to keep in flight through an AsyncLogWriter, or 0 to write synchronously
+     * @param group_commit_target_latency target for the 99th percentile commit latency that persists are batched for,
+     * or 0 to persist at the persist interval
+     * @param commit_watermark watermark of the streams of the log, or nullptr if the log is a single stream
+     * @param stream_id id of the stream that the task writes
+     * @param compress_records true if the buffers of the stream are compressed into log frames
      */
-    explicit DiskLogConsumerTask(const std::chrono::microseconds                       persist_interval,
+    explicit DiskLogConsumerTask(std::string                                           log_file_path,
+                                 const std::chrono::microseconds                       persist_interval,
                                  uint64_t                                              persist_threshold,
-                                 std::vector<BufferedLogWriter>                       *buffers,
+                                 std::deque<BufferedLogWriter>                        *buffers,
                                  common::ConcurrentBlockingQueue<BufferedLogWriter *> *empty_buffer_queue,
-                                 common::ConcurrentQueue<storage::SerializedLogs>     *filled_buffer_queue)
+                                 common::ConcurrentQueue<storage::SerializedLogs>     *filled_buffer_queue,
+                                 uint32_t                                              async_io_depth = 0,
+                                 std::chrono::microseconds group_commit_target_latency = std::chrono::microseconds(0),
+                                 CommitWatermark          *commit_watermark = nullptr,
+                                 uint32_t                  stream_id = 0,
+                                 bool                      compress_records = false)
         : run_task_(false)
+        , log_file_path_(std::move(log_file_path))
         , persist_interval_(persist_interval)
         , persist_threshold_(persist_threshold)
         , current_data_written_(0)
         , buffers_(buffers)
         , empty_buffer_queue_(empty_buffer_queue)
-        , filled_buffer_queue_(filled_buffer_queue) {}
+        , filled_buffer_queue_(filled_buffer_queue)
+        , async_writer_(async_io_depth > 0 ? std::make_unique<AsyncLogWriter>(log_file_path_, async_io_depth)
+                                           : nullptr)
+        , group_commit_(group_commit_target_latency.count() > 0
+                            ? std::make_unique<GroupCommitController>(group_commit_target_latency)
+                            : nullptr)
+        , commit_watermark_(commit_watermark)
+        , stream_id_(stream_id)
+        , compress_records_(compress_records)
+        , watermark_buffer_(commit_watermark != nullptr ? std::make_unique<BufferedLogWriter>(log_file_path_.c_str())
+                                                        : nullptr) {
+        if (commit_watermark_ != nullptr) {
+            commit_watermark_->RegisterStream(stream_id_, &disk_log_writer_thread_cv_);
+            if (async_writer_ != nullptr) {
+                async_writer_->SetPersistedCallbackHandler([this](std::vector<CommitCallback> *callbacks) {
+                    commit_watermark_->Persisted(stream_id_, callbacks);
+                });
+            }
+        }
+    }
 
     /**
      * Runs main disk log writer loop. Called by thread registry upon initialization of thread
@@ -56,6 +104,12 @@ private:
     // Stores callbacks for commit records written to disk but not yet persisted
     std::vector<storage::CommitCallback> commit_callbacks_;
 
+    // System path for the active log file
+    const std::string log_file_path_;
+    // If non-empty, the path that the active log file should be archived to on the next forced persist. Protected by
+    // persist_lock_.
+    std::string rotate_segment_path_;
+
     // Interval time for when to persist log file
     const std::chrono::microseconds persist_interval_;
     // Threshold of data written since the last persist to trigger another persist
@@ -64,11 +118,28 @@ private:
     uint64_t current_data_written_;
 
     // This stores a reference to all the buffers the log manager has created. Used for persisting
-    std::vector<BufferedLogWriter> *buffers_;
+    std::deque<BufferedLogWriter> *buffers_;
     // The queue containing empty buffers. Task will enqueue a buffer into this queue when it has flushed its logs
     common::ConcurrentBlockingQueue<BufferedLogWriter *> *empty_buffer_queue_;
     // The queue containing filled buffers. Task should dequeue filled buffers from this queue to flush
     common::ConcurrentQueue<SerializedLogs> *filled_buffer_queue_;
+    // Writes the log file asynchronously, if enabled. Otherwise the buffers write to the log file themselves.
+    std::unique_ptr<AsyncLogWriter> async_writer_;
+    // Decides when to persist the log file, if enabled. Otherwise it is persisted at the persist interval.
+    std::unique_ptr<GroupCommitController> group_commit_;
+    // Persist latencies reported by the AsyncLogWriter
+    std::vector<std::chrono::microseconds> persist_latencies_;
+    // Watermark that persisted commit callbacks are handed to, if the log is split into several streams
+    CommitWatermark *commit_watermark_;
+    // Id of the stream that the task writes
+    const uint32_t stream_id_;
+    // Whether the buffers of the stream are compressed into log frames, which watermark records have to be as well
+    const bool compress_records_;
+    // Buffer that watermark records are written through, if there is a watermark. The buffers in buffers_ belong to
+    // the serializer until it hands them over, so the task cannot borrow one of them without waiting for it.
+    std::unique_ptr<BufferedLogWriter> watermark_buffer_;
+    // Commit timestamp of the last watermark record written
+    transaction::timestamp_t logged_watermark_ = transaction::INVALID_TXN_TIMESTAMP;
 
     // Flag used by the serializer thread to signal the disk log consumer task thread to persist the data on disk
     volatile bool force_flush_;
@@ -93,9 +164,55 @@ private:
 
     /*
      * Persists the log file on disk by calling fsync, as well as calling callbacks for all committed transactions that
-     * were persisted
+     * were persisted. With an AsyncLogWriter, the persist is only started, and the callbacks are invoked once it is
+     * done, unless the caller waits for it.
+     * @param wait true to wait until everything written so far is persisted, only relevant for an AsyncLogWriter
+     * @return number of buffers persisted, used for metrics
+     */
+    uint64_t PersistLogFile(bool wait = true);
+
+    /**
+     * Invokes the callbacks of the persists of the AsyncLogWriter that completed, and hands their latencies to the
+     * GroupCommitController
+     * @param wait true to wait until everything written so far is persisted
      * @return number of buffers persisted, used for metrics
      */
-    uint64_t PersistLogFile();
+    uint64_t ProcessAsyncCompletions(bool wait);
+
+    /**
+     * @return the commit timestamp to log a watermark record for if the stream holds back the commit callbacks of other
+     * streams, and has no watermark record to catch up with them in flight yet, INVALID_TXN_TIMESTAMP otherwise
+     */
+    transaction::timestamp_t WatermarkTarget() {
+        if (commit_watermark_ == nullptr) {
+            return transaction::INVALID_TXN_TIMESTAMP;
+        }
+        const transaction::timestamp_t target = commit_watermark_->LagTarget(stream_id_);
+        return target == logged_watermark_ ? transaction::INVALID_TXN_TIMESTAMP : target;
+    }
+
+    /** @return true if the stream has to log a watermark record */
+    bool IsLagging() {
+        return WatermarkTarget() != transaction::INVALID_TXN_TIMESTAMP;
+    }
+
+    /**
+     * Writes a watermark record to the log file if the stream holds back the commit callbacks of other streams, and
+     * adds a callback for it that advances the stream once it is persisted
+     * @return true if a record was written
+     */
+    bool WriteWatermarkRecord();
+
+    /**
+     * Invokes the given callbacks of persisted commits, or hands them to the watermark
+     * @param callbacks commit callbacks, cleared by the call
+     */
+    void InvokeCommitCallbacks(std::vector<CommitCallback> *callbacks);
+
+    /**
+     * Archives the active log file under rotate_segment_path_ and reopens all buffers on a fresh log file. Must be
+     * called right after the log file was persisted, while holding persist_lock_.
+     */
+    void RotateLogFile();
 };
 } // namespace noisepage::storage
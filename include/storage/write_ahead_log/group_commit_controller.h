@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <chrono> // NOLINT
+#include <cstdint>
+
+namespace noisepage::storage {
+
+/**
+ * Decides when a DiskLogConsumerTask persists the log file, so that commits are batched into as few persists as
+ * possible while the 99th percentile commit latency stays within a target.
+ *
+ * A commit waits for its batch to be closed, and then for the persist of the batch. The oldest commit of a batch may
+ * therefore wait for as long as the target leaves after the 99th percentile of the recently observed persist latencies,
+ * which is the wait budget. A batch is closed before the budget runs out once it holds as many commits as are expected
+ * to arrive during one persist at the observed arrival rate: persisting less often than that saves no persists, it
+ * only delays commits. At low load the target batch is a single commit, so commits are persisted as soon as they
+ * arrive instead of waiting for a timer, and at high load batches grow with the arrival rate and the persist latency.
+ */
+class GroupCommitController {
+public:
+    /** Clock that all times passed to the controller are taken from */
+    using Clock = std::chrono::high_resolution_clock;
+
+    /** Number of most recent persist latencies that the 99th percentile is estimated from */
+    static constexpr uint32_t NUM_LATENCY_SAMPLES = 128;
+
+    /** Weight of the arrival rate during the most recent batch in the estimated arrival rate */
+    static constexpr double ARRIVAL_RATE_WEIGHT = 0.25;
+
+    /**
+     * @param target_latency target for the 99th percentile latency from the arrival of a commit until it is persisted
+     */
+    explicit GroupCommitController(std::chrono::microseconds target_latency);
+
+    /**
+     * Adds commits to the current batch
+     * @param num_commits number of commits that arrived
+     * @param now time of arrival
+     */
+    void OnCommitsArrived(uint64_t num_commits, Clock::time_point now);
+
+    /** @return true if the current batch holds any commits */
+    bool HasPendingCommits() const {
+        return pending_commits_ > 0;
+    }
+
+    /**
+     * @param now current time
+     * @return true if the current batch should be closed and persisted now
+     */
+    bool ShouldPersist(Clock::time_point now) const;
+
+    /**
+     * @param now current time
+     * @return time until the current batch has to be closed at the latest, or microseconds::max() if it is empty
+     */
+    std::chrono::microseconds TimeUntilPersist(Clock::time_point now) const;
+
+    /**
+     * Closes the current batch, because it is being persisted, and updates the estimated arrival rate
+     * @param now time at which the batch was closed
+     */
+    void OnBatchClosed(Clock::time_point now);
+
+    /**
+     * Adds the latency of a persist to the samples that the wait budget and the target batch size are derived from
+     * @param latency time from the start of a persist until it was done
+     */
+    void RecordPersistLatency(std::chrono::microseconds latency);
+
+    /** @return target for the 99th percentile commit latency */
+    std::chrono::microseconds TargetLatency() const {
+        return target_latency_;
+    }
+
+    /** @return how long the oldest commit of a batch may wait for the batch to be closed */
+    std::chrono::microseconds WaitBudget() const {
+        return wait_budget_;
+    }
+
+    /** @return number of commits at which a batch is closed before the wait budget runs out */
+    uint64_t TargetBatchSize() const {
+        return target_batch_size_;
+    }
+
+    /** @return estimated 99th percentile persist latency */
+    std::chrono::microseconds PersistLatencyP99() const {
+        return persist_latency_p99_;
+    }
+
+    /** @return estimated commit arrival rate, in commits per second */
+    double ArrivalRate() const {
+        return arrival_rate_;
+    }
+
+    /** @return number of commits in the most recently closed batch */
+    uint64_t LastBatchSize() const {
+        return last_batch_size_;
+    }
+
+private:
+    // Re-derives the wait budget and the target batch size from the current estimates
+    void UpdateTargets();
+
+    const std::chrono::microseconds target_latency_;
+
+    // Number of commits in the current batch, and the arrival time of the oldest of them
+    uint64_t          pending_commits_ = 0;
+    Clock::time_point oldest_pending_;
+
+    // Number of commits in the most recently closed batch, and when it was closed
+    uint64_t          last_batch_size_ = 0;
+    Clock::time_point last_batch_closed_;
+    bool              any_batch_closed_ = false;
+    double            arrival_rate_ = 0.0;
+
+    // Ring of the most recent persist latencies in microseconds
+    std::array<uint64_t, NUM_LATENCY_SAMPLES> latency_samples_{};
+    uint32_t                                  num_latency_samples_ = 0;
+    uint32_t                                  next_latency_sample_ = 0;
+    std::chrono::microseconds                 persist_latency_p99_{0};
+    std::chrono::microseconds                 persist_latency_mean_{0};
+
+    std::chrono::microseconds wait_budget_;
+    uint64_t                  target_batch_size_ = 1;
+};
+
+} // namespace noisepage::storage
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+#include "storage/write_ahead_log/log_frame.h"
+
+namespace noisepage::storage {
+
+/**
+ * Fast block compression of serialized log buffers. The format is that of LZ4 blocks: a sequence of literal runs, each
+ * followed by a copy of earlier output, found with a single-probe hash table. Serialized records repeat their oids,
+ * column ids and null bitmaps, which this catches at little CPU cost.
+ */
+class LogCompression {
+public:
+    LogCompression() = delete;
+
+    /**
+     * Compresses the given bytes
+     * @param src bytes to compress
+     * @param src_size number of bytes to compress
+     * @param[out] dst location to write the compressed bytes to
+     * @param dst_capacity maximum number of compressed bytes to write
+     * @return number of compressed bytes, or 0 if they do not fit in dst_capacity
+     */
+    static uint32_t Compress(const char *src, uint32_t src_size, char *dst, uint32_t dst_capacity);
+
+    /**
+     * Decompresses the given bytes, which must decompress to exactly dst_size bytes
+     * @param src bytes to decompress
+     * @param src_size number of bytes to decompress
+     * @param[out] dst location to write the decompressed bytes to
+     * @param dst_size number of bytes that src decompresses to
+     * @return false if src is malformed or does not decompress to dst_size bytes
+     */
+    static bool Decompress(const char *src, uint32_t src_size, char *dst, uint32_t dst_size);
+
+    /**
+     * Writes the given buffer contents as a frame. The contents are stored uncompressed if compression does not make
+     * them smaller, or if compress is false.
+     * @param src buffer contents
+     * @param size size of the buffer contents
+     * @param compress whether to compress the contents
+     * @param[out] frame location to write the frame to, with room for a LogFrameHeader and size bytes
+     * @return size of the frame
+     */
+    static uint32_t EncodeFrame(const char *src, uint32_t size, bool compress, char *frame);
+
+    /**
+     * Restores the buffer contents of a frame. Throws if the frame is malformed.
+     * @param header header of the frame
+     * @param payload the stored_size_ bytes that follow the header
+     * @param[out] dst location to write the raw_size_ bytes of buffer contents to
+     */
+    static void DecodeFrame(const LogFrameHeader &header, const char *payload, char *dst);
+};
+
+} // namespace noisepage::storage
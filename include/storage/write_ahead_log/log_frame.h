@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+namespace noisepage::storage {
+
+/**
+ * Header of a log frame. A frame holds the contents of one serialized log buffer, either compressed with
+ * LogCompression or stored as is, and the header is followed by stored_size_ bytes of them. Frames are written in
+ * place of the buffer contents, to the log file and to replicas, if log compression is enabled. An AsyncLogWriter
+ * always writes frames, because it pads the log to a block boundary at every flush and a record may span two buffers:
+ * only frame boundaries tell a reader where padding may start.
+ *
+ * A log switches to frames where a record size would be read, and MARKER is not a valid record size. Once in frames, a
+ * reader expects another frame after every frame, and skips a marker of 0 as padding up to the next block of the log.
+ * Any other value means that the log continues without frames. Records may span frames, so a log switches in or out of
+ * frames only where a record starts, i.e. when it is reopened: while it is written, either every buffer is a frame or
+ * none is.
+ */
+struct LogFrameHeader {
+    /** Value in place of a record size that marks the start of a frame */
+    static constexpr uint32_t MARKER = 0xFFFFFFFF;
+
+    /** Always MARKER */
+    uint32_t marker_ = MARKER;
+    /** Size of the buffer contents */
+    uint32_t raw_size_ = 0;
+    /** Number of bytes that follow the header. Equal to raw_size_ if the contents are stored uncompressed. */
+    uint32_t stored_size_ = 0;
+};
+
+} // namespace noisepage::storage
@@ -17,6 +17,7 @@
 #include "common/macros.h"
 #include "common/posix_io_wrappers.h"
 #include "loggers/storage_logger.h"
+#include "storage/write_ahead_log/log_compression.h"
 #include "transaction/transaction_defs.h"
 
 namespace noisepage::replication {
@@ -25,6 +26,8 @@ class RecordsBatchMsg;
 
 namespace noisepage::storage {
 
+class AsyncLogWriter;
+
 // TODO(Tianyu):  we need control over when and what to flush as the log manager. Thus, we need to write our
 // own wrapper around lower level I/O functions. I could be wrong, and in that case we should
 // revert to using STL.
@@ -54,6 +57,8 @@ public:
         : out_(other.out_) {
         memcpy(buffer_, other.buffer_, common::Constants::LOG_BUFFER_SIZE);
         buffer_size_ = other.buffer_size_;
+        memcpy(frame_, other.frame_, other.frame_size_);
+        frame_size_ = other.frame_size_;
         serialize_refcount_.store(other.serialize_refcount_.load());
     }
 
@@ -64,6 +69,16 @@ public:
         PosixIoWrappers::Close(out_);
     }
 
+    /**
+     * Reopens the writer on the specified log file. Used when the log file is rotated, the writer must have been closed
+     * and its buffer must be empty.
+     * @param log_file_path path to the the log file to write to. Created if it does not exist.
+     */
+    void Reopen(const char *const log_file_path) {
+        NOISEPAGE_ASSERT(buffer_size_ == 0, "Reopening a writer with buffered writes would lose data");
+        out_ = PosixIoWrappers::Open(log_file_path, O_WRONLY | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR);
+    }
+
     /**
      * Write to the log file the given amount of bytes from the given location in memory, but buffer the write so the
      * update is only written out when the BufferedLogWriter is persisted. Note that this function writes to the buffer
@@ -102,16 +117,47 @@ public:
     }
 
     /**
-     * Flush any buffered writes.
+     * Flush any buffered writes, as a frame if EncodeFrame() was called.
      * @return amount of data flushed
      */
     uint64_t FlushBuffer() {
-        const auto size = buffer_size_;
-        WriteUnsynced(buffer_, buffer_size_);
+        uint64_t size;
+        if (frame_size_ > 0) {
+            size = frame_size_;
+            WriteUnsynced(frame_, frame_size_);
+        } else {
+            size = buffer_size_;
+            WriteUnsynced(buffer_, buffer_size_);
+        }
         buffer_size_ = 0;
+        frame_size_ = 0;
         return size;
     }
 
+    /**
+     * Hand any buffered writes to the given writer instead of writing them to the log file. They are always handed over
+     * as a frame, which is stored uncompressed if EncodeFrame() was not called.
+     * @param writer the writer that writes out the log file
+     * @return amount of data flushed
+     */
+    uint64_t FlushBuffer(AsyncLogWriter *writer);
+
+    /**
+     * Compresses the buffered writes into a log frame (see LogFrameHeader), which is flushed and replicated in their
+     * place. The writes are stored uncompressed in the frame if they do not compress. Must be called after
+     * PrepareForSerialization(), before the buffer is handed to any serializer.
+     * @return size of the frame
+     */
+    uint32_t EncodeFrame() {
+        frame_size_ = LogCompression::EncodeFrame(buffer_, buffer_size_, true, frame_);
+        return frame_size_;
+    }
+
+    /** @return size of the buffered writes */
+    uint32_t GetBufferSize() const {
+        return buffer_size_;
+    }
+
     /**
      * @return if the buffer is full
      */
@@ -135,6 +181,7 @@ public:
     void PrepareForSerialization(const transaction::TransactionPolicy &policy) {
         NOISEPAGE_ASSERT(serialize_refcount_.load() == 0, "This buffer is already being serialized.");
         serialize_refcount_ = 0;
+        frame_size_ = 0;
         if (policy.durability_ != transaction::DurabilityPolicy::DISABLE) {
             NOISEPAGE_ASSERT(policy.durability_ == transaction::DurabilityPolicy::SYNC
                                  || policy.durability_ == transaction::DurabilityPolicy::ASYNC,
@@ -165,12 +212,16 @@ public:
 private:
     friend class replication::RecordsBatchMsg;
 
-    const int out_; // fd of the output files
+    int       out_; // fd of the output files
     char      buffer_[common::Constants::LOG_BUFFER_SIZE];
 
     uint32_t            buffer_size_ = 0;
     std::atomic<int8_t> serialize_refcount_ = 0; ///< The number of would-be serializers that haven't serialized yet.
 
+    // The buffered writes as a log frame, if EncodeFrame() was called since the buffer was last prepared or flushed
+    char     frame_[sizeof(LogFrameHeader) + common::Constants::LOG_BUFFER_SIZE];
+    uint32_t frame_size_ = 0;
+
     bool CanBuffer(uint32_t size) {
         return common::Constants::LOG_BUFFER_SIZE - buffer_size_ >= size;
     }
@@ -205,13 +256,16 @@ public:
      * @return if there are contents left in the write ahead log
      */
     bool HasMore() {
-        return filled_size_ > read_head_ || in_ != -1;
+        if (framed_ && frame_head_ == frame_size_) {
+            NextFrame();
+        }
+        return frame_size_ > frame_head_ || HasMoreRaw();
     }
 
     /**
      * Read the specified number of bytes into the target location from the write ahead log. The method reads as many as
      * possible if there are not enough bytes in the log and returns false. The underlying log file fd is automatically
-     * closed when all remaining bytes are buffered.
+     * closed when all remaining bytes are buffered. If the log is in frames, the bytes are read from their contents.
      *
      * @param dest pointer location to read into
      * @param size number of bytes to read
@@ -219,6 +273,12 @@ public:
      */
     bool Read(void *dest, uint32_t size);
 
+    /**
+     * Switch to reading the log from frames, starting with the frame whose marker was just read in place of a record
+     * size (see LogFrameHeader). The log is read from frames until it continues without them.
+     */
+    void BeginFrame();
+
     /**
      * Read a value of the specified type from the log. An exception is thrown if the log file does not
      * have enough bytes left for a well formed value
@@ -236,14 +296,42 @@ public:
 private:
     int      in_; // or -1 if closed
     uint32_t read_head_ = 0, filled_size_ = 0;
+    // Offset in the log file of the first byte in the buffer
+    uint64_t buffer_offset_ = 0;
     char     buffer_[common::Constants::LOG_BUFFER_SIZE];
 
+    // Whether the log is read from frames
+    bool framed_ = false;
+    // Contents of the current frame, and how much of them was read
+    uint32_t frame_head_ = 0, frame_size_ = 0;
+    char     frame_contents_[common::Constants::LOG_BUFFER_SIZE];
+    // Compressed payload of the current frame
+    char frame_payload_[common::Constants::LOG_BUFFER_SIZE];
+
     void ReadFromBuffer(void *dest, uint32_t size) {
         NOISEPAGE_ASSERT(read_head_ + size <= filled_size_, "Not enough bytes in buffer for the read");
         std::memcpy(dest, buffer_ + read_head_, size);
         read_head_ += size;
     }
 
+    bool HasMoreRaw() const {
+        return filled_size_ > read_head_ || in_ != -1;
+    }
+
+    // Reads bytes from the log file as they are, like Read() does for a log without frames
+    bool ReadRaw(void *dest, uint32_t size);
+
+    // Skips ahead to the next multiple of common::Constants::LOG_BLOCK_SIZE in the log file, unless the read head is at
+    // one already. Used to skip the padding that AsyncLogWriter puts at the end of a persisted block.
+    void SkipToBlockBoundary();
+
+    // Reads the rest of the frame whose marker was just read, and decodes its contents
+    void ReadFrame();
+
+    // Moves on to the next frame once the current one is fully read. Skips padding, and stops reading from frames if
+    // the log continues without them.
+    void NextFrame();
+
     void RefillBuffer();
 };
 
@@ -253,6 +341,7 @@ struct CommitCallback {
     void                    *arg_;               ///< The argument to invoke the commit callback with.
     transaction::timestamp_t txn_start_time_;    ///< (Metadata) The transaction ID that generated this commit callback.
     bool                     is_from_read_only_; ///< True if the commit callback was from a read only commit record.
+    transaction::timestamp_t commit_time_;       ///< (Metadata) The commit timestamp of the transaction.
 };
 
 /**
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <deque>
 #include <memory>
 #include <queue>
 #include <string>
@@ -14,6 +16,7 @@
 #include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 #include "storage/record_buffer.h"
+#include "storage/write_ahead_log/commit_watermark.h"
 #include "storage/write_ahead_log/log_io.h"
 #include "storage/write_ahead_log/log_record.h"
 
@@ -42,6 +45,14 @@ class DiskLogConsumerTask;
  *          c) A sufficient amount of data has been written since the last persist
  *      5. When the persist is done, the `DiskLogConsumerTask` will call the commit callbacks for any CommitRecords that
  * were just persisted.
+ *
+ * The log can be split into several independent streams, each with its own serializer task, buffers, consumer task and
+ * log file, so that serialization and writes scale with the number of concurrent transactions. All records of a
+ * transaction go to the same stream, chosen by the transaction's start timestamp, so that they are in order within its
+ * file. There is no order between records in different streams; recovery merges the streams by commit timestamp (see
+ * DiskLogProvider) and stops where the first stream ends, since a later commit may depend on one that stream lost. A
+ * commit is therefore only acknowledged once every stream has persisted its log up to it (see CommitWatermark).
+ * Stream 0 writes to the log file path itself, stream i to StreamFilePath(log_file_path, i).
  */
 class LogManager : public common::DedicatedThreadOwner {
 public:
@@ -61,6 +72,14 @@ public:
      * @param primary_replication_manager     The replication manager that handles shipping logs over the network.
      *                                        Currently only the primary does this.
      * @param thread_registry                 DedicatedThreadRegistry dependency injection
+     * @param num_streams                     Number of independent log streams. Replication ships a single ordered
+     *                                        stream, so this is ignored if a replication manager is given.
+     * @param async_io_depth                  Number of writes to the log file of every stream that are kept in flight
+     *                                        through an AsyncLogWriter, or 0 to write and fsync synchronously
+     * @param group_commit_target_latency     Target for the 99th percentile commit latency that every stream batches
+     *                                        its persists for, or 0 to persist at the persist interval
+     * @param compress_records                Whether serialized log buffers are compressed before they are written
+     *                                        out and replicated
      */
     LogManager(std::string                                                                  log_file_path,
                uint64_t                                                                     num_buffers,
@@ -70,7 +89,11 @@ public:
                common::ManagedPointer<RecordBufferSegmentPool>                              buffer_pool,
                common::ManagedPointer<common::ConcurrentBlockingQueue<BufferedLogWriter *>> empty_buffer_queue,
                common::ManagedPointer<replication::PrimaryReplicationManager>               primary_replication_manager,
-               common::ManagedPointer<common::DedicatedThreadRegistry>                      thread_registry)
+               common::ManagedPointer<common::DedicatedThreadRegistry>                      thread_registry,
+               uint32_t                                                                     num_streams = 1,
+               uint32_t                                                                     async_io_depth = 0,
+               std::chrono::microseconds group_commit_target_latency = std::chrono::microseconds(0),
+               bool                      compress_records = false)
         : DedicatedThreadOwner(thread_registry)
         , run_log_manager_(false)
         , log_file_path_(std::move(log_file_path))
@@ -80,10 +103,14 @@ public:
         , serialization_interval_(serialization_interval)
         , persist_interval_(persist_interval)
         , persist_threshold_(persist_threshold)
-        , primary_replication_manager_(primary_replication_manager) {}
+        , primary_replication_manager_(primary_replication_manager)
+        , num_streams_(primary_replication_manager == DISABLED ? std::max(num_streams, 1U) : 1)
+        , async_io_depth_(async_io_depth)
+        , group_commit_target_latency_(group_commit_target_latency)
+        , compress_records_(compress_records) {}
 
     /**
-     * Starts log manager. Does the following in order:
+     * Starts log manager. Does the following in order, for every stream:
      *    1. Initialize buffers to pass serialized logs to log consumers
      *    2. Starts up DiskLogConsumerTask
      *    3. Starts up LogSerializerTask
@@ -99,7 +126,8 @@ public:
     void ForceFlush();
 
     /**
-     * Persists all unpersisted logs and stops the log manager. Does what Start() does in reverse order:
+     * Persists all unpersisted logs and stops the log manager. Does what Start() does in reverse order, for every
+     * stream:
      *    1. Stops LogSerializerTask
      *    2. Stops DiskLogConsumerTask
      *    3. Closes all open buffers
@@ -119,15 +147,20 @@ public:
 
     /**
      * For testing only
-     * @return number of buffers used for logging
+     * @return number of buffers used for logging, per stream
      */
     uint64_t TestGetNumBuffers() {
         return num_buffers_;
     }
 
+    /** @return number of independent log streams */
+    uint32_t GetNumStreams() const {
+        return num_streams_;
+    }
+
     /**
-     * Set the number of buffers used for buffering logs. The operation fails if the LogManager has already allocated
-     * more buffers than the new size
+     * Set the number of buffers used for buffering logs, per stream. The operation fails if the LogManager has already
+     * allocated more buffers than the new size
      *
      * @param new_num_buffers the new number of buffers the log manager can use
      * @return true if new_num_buffers is successfully set and false the operation fails
@@ -135,9 +168,11 @@ public:
     bool SetNumBuffers(uint64_t new_num_buffers) {
         if (new_num_buffers >= num_buffers_) {
             // Add in new buffers
-            for (size_t i = 0; i < new_num_buffers - num_buffers_; i++) {
-                buffers_.emplace_back(log_file_path_.c_str());
-                empty_buffer_queue_->Enqueue(&buffers_[num_buffers_ + i]);
+            for (auto &stream : streams_) {
+                for (size_t i = 0; i < new_num_buffers - num_buffers_; i++) {
+                    stream->buffers_.emplace_back(stream->log_file_path_.c_str());
+                    stream->empty_buffer_queue_->Enqueue(&stream->buffers_.back());
+                }
             }
             num_buffers_ = new_num_buffers;
             return true;
@@ -159,43 +194,147 @@ public:
     /** Stop performing actions related to replication. Currently works around circular DBMain dependencies. */
     void EndReplication();
 
+    /**
+     * Persists all serialized logs and archives the active log file of every stream as a new log segment, so that the
+     * log can later be truncated at that point. Logs serialized afterwards go to fresh log files. The serializers are
+     * paused for the duration of the rotation, which guarantees that no log record straddles two files, and that the
+     * segments of all streams with the same id cover the same transactions.
+     * @warning Beware the performance consequences, this forces a persist of the log file
+     * @return id of the segment that the active log file was archived as
+     */
+    uint64_t RotateLogFile();
+
+    /** @return path of the active log file of stream 0 */
+    const std::string &GetLogFilePath() const {
+        return log_file_path_;
+    }
+
+    /**
+     * @param log_file_path path of the active log file of stream 0
+     * @param stream_id id of a log stream
+     * @return path of the active log file of the given stream
+     */
+    static std::string StreamFilePath(const std::string &log_file_path, uint32_t stream_id);
+
+    /**
+     * @param log_file_path path of the active log file of stream 0
+     * @return paths of the active log files of all streams found on disk, by stream id. Stream 0 is always included.
+     */
+    static std::vector<std::string> ListLogStreams(const std::string &log_file_path);
+
+    /**
+     * @param log_file_path path of the active log file
+     * @param segment_id id of an archived log segment
+     * @return path that the given segment of the log file is archived under
+     */
+    static std::string SegmentFilePath(const std::string &log_file_path, uint64_t segment_id);
+
+    /**
+     * @param log_file_path path of the active log file
+     * @return ids of all archived segments of the log file, in ascending order
+     */
+    static std::vector<uint64_t> ListLogSegments(const std::string &log_file_path);
+
+    /**
+     * Lists the files that have to be replayed, in order, to recover from the log. These are all archived segments
+     * starting at first_segment, followed by the active log file. Empty files are skipped.
+     * @param log_file_path path of the active log file
+     * @param first_segment id of the oldest segment that is needed
+     * @return paths of the log files to replay
+     */
+    static std::vector<std::string> LogFilesForRecovery(const std::string &log_file_path, uint64_t first_segment = 0);
+
+    /**
+     * Lists the files that have to be replayed to recover from the log, for every stream found on disk. Streams without
+     * any records are skipped.
+     * @param log_file_path path of the active log file of stream 0
+     * @param first_segment id of the oldest segment that is needed
+     * @return for every stream, the paths of its log files to replay as given by LogFilesForRecovery()
+     */
+    static std::vector<std::vector<std::string>> LogStreamFilesForRecovery(const std::string &log_file_path,
+                                                                           uint64_t           first_segment = 0);
+
+    /**
+     * Deletes all archived segments of the log file that are older than first_segment, in every stream found on disk
+     * @param log_file_path path of the active log file of stream 0
+     * @param first_segment id of the oldest segment that is still needed
+     * @return number of segments deleted
+     */
+    static uint32_t RemoveLogSegmentsBefore(const std::string &log_file_path, uint64_t first_segment);
+
 private:
+    // Everything that is needed to serialize and write out one stream of the log
+    struct LogStream {
+        explicit LogStream(std::string log_file_path)
+            : log_file_path_(std::move(log_file_path)) {}
+
+        // System path for the log file of the stream
+        std::string log_file_path_;
+        // This stores a reference to all the buffers the serializer or the log consumer threads of the stream use. A
+        // deque, because buffers added by SetNumBuffers must not move the ones that are already in use.
+        std::deque<BufferedLogWriter> buffers_;
+        // Queue of empty buffers owned by the stream. Only streams other than stream 0 own their queue, stream 0 uses
+        // the queue that was handed to the log manager, which the replication manager returns buffers to as well.
+        std::unique_ptr<common::ConcurrentBlockingQueue<BufferedLogWriter *>> own_empty_buffer_queue_;
+        // The queue containing empty buffers which the serializer thread of the stream will use
+        common::ManagedPointer<common::ConcurrentBlockingQueue<BufferedLogWriter *>> empty_buffer_queue_;
+        // The queue containing filled buffers pending flush to the disk
+        common::ConcurrentQueue<SerializedLogs> filled_buffer_queue_;
+        // Log serializer task of the stream
+        common::ManagedPointer<LogSerializerTask> log_serializer_task_
+            = common::ManagedPointer<LogSerializerTask>(nullptr);
+        // The log consumer task which flushes filled buffers of the stream to the disk
+        common::ManagedPointer<DiskLogConsumerTask> disk_log_writer_task_
+            = common::ManagedPointer<DiskLogConsumerTask>(nullptr);
+    };
+
+    // Signal the consumer tasks of all streams to persist, archiving the log files of the streams to the given segment
+    // if segment_id is non-zero, and wait for them to finish
+    void PersistStreams(uint64_t segment_id);
+
+    // Persist all streams until no commit callback is held back by a stream that lags behind the others
+    void PersistStreamsToWatermark();
+
     // Flag to tell us when the log manager is running or during termination
     bool run_log_manager_;
 
     // System path for log file
     std::string log_file_path_;
 
-    // Number of buffers to use for buffering and serializing logs
+    // Number of buffers to use for buffering and serializing logs, per stream
     uint64_t num_buffers_;
 
     // TODO(Tianyu): This can be changed later to be include things that are not necessarily backed by a disk
     //  (e.g. logs can be streamed out to the network for remote replication)
     RecordBufferSegmentPool *buffer_pool_;
 
-    // This stores a reference to all the buffers the serializer or the log consumer threads use
-    std::vector<BufferedLogWriter> buffers_;
-    // The queue containing empty buffers which the serializer thread will use. We use a blocking queue because the
-    // serializer thread should block when requesting a new buffer until it receives an empty buffer
+    // The queue containing empty buffers which the serializer thread of stream 0 will use. We use a blocking queue
+    // because the serializer thread should block when requesting a new buffer until it receives an empty buffer
     common::ManagedPointer<common::ConcurrentBlockingQueue<BufferedLogWriter *>> empty_buffer_queue_;
-    // The queue containing filled buffers pending flush to the disk
-    common::ConcurrentQueue<SerializedLogs> filled_buffer_queue_;
 
-    // Log serializer task that processes buffers handed over by transactions and serializes them into consumer buffers
-    common::ManagedPointer<LogSerializerTask> log_serializer_task_ = common::ManagedPointer<LogSerializerTask>(nullptr);
-    // Interval used by log serialization task
+    // Interval used by log serialization tasks
     std::chrono::microseconds serialization_interval_;
 
-    // The log consumer task which flushes filled buffers to the disk
-    common::ManagedPointer<DiskLogConsumerTask> disk_log_writer_task_
-        = common::ManagedPointer<DiskLogConsumerTask>(nullptr);
-    // Interval used by disk consumer task
+    // Interval used by disk consumer tasks
     const std::chrono::microseconds persist_interval_;
     // Threshold used by disk consumer task
     uint64_t persist_threshold_;
 
     common::ManagedPointer<replication::PrimaryReplicationManager> primary_replication_manager_;
 
+    // Number of independent log streams
+    const uint32_t num_streams_;
+    // Number of writes per stream kept in flight by the disk consumer tasks, 0 if they write synchronously
+    const uint32_t async_io_depth_;
+    // Target for the 99th percentile commit latency of the disk consumer tasks, 0 if they persist at the interval
+    const std::chrono::microseconds group_commit_target_latency_;
+    // Whether the serializer tasks compress the buffers they hand over
+    const bool compress_records_;
+    // The log streams, by stream id. Only populated while the log manager is running.
+    std::vector<std::unique_ptr<LogStream>> streams_;
+    // Holds the commit callbacks of a stream until every stream has caught up, if there is more than one stream
+    std::unique_ptr<CommitWatermark> commit_watermark_;
+
     /**
      * If the central registry wants to removes our thread used for the disk log consumer task, we only allow removal if
      * we are in shut down, else we need to keep the task, so we reject the removal
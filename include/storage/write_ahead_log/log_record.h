@@ -1,6 +1,7 @@
 #pragma once
 
 #include "storage/data_table.h"
+#include "storage/projected_columns.h"
 #include "storage/projected_row.h"
 #include "transaction/timestamp_manager.h"
 #include "transaction/transaction_defs.h"
@@ -294,6 +295,95 @@ private:
     TupleSlot            tuple_slot_;
 };
 
+/**
+ * Record body of a block insert. Bulk loads log the tuples they place into a block in batches, one record per batch,
+ * instead of one RedoRecord per tuple. The tuples are stored in columnar format together with the slots they were
+ * inserted into, so that recovery can expand the batch back into individual inserts. The header is stored in the
+ * LogRecord class that would presumably return this object.
+ */
+class BlockInsertRecord {
+public:
+    MEM_REINTERPRETATION_ONLY(BlockInsertRecord)
+
+    /**
+     * @return type of record this type of body holds
+     */
+    static constexpr auto RecordType() -> LogRecordType {
+        return LogRecordType::BLOCK_INSERT;
+    }
+
+    /**
+     * @return Size of the entire record of this type, in bytes, in memory, if the underlying tuples are to have the
+     * same structure as described by the given initializer.
+     */
+    static auto Size(const ProjectedColumnsInitializer &initializer) -> uint32_t {
+        return static_cast<uint32_t>(sizeof(LogRecord) + sizeof(BlockInsertRecord)
+                                     + initializer.ProjectedColumnsSize());
+    }
+
+    /**
+     * Initialize an entire LogRecord (header included) to have an underlying block insert record, using the parameters
+     * supplied. The record initially holds no tuples.
+     * @param head pointer location to initialize, this is also the returned address (reinterpreted)
+     * @param txn_begin begin timestamp of the transaction that generated this log record
+     * @param db_oid database oid of this block insert record
+     * @param table_oid table oid of this block insert record
+     * @param initializer the initializer to use for the underlying tuples
+     * @return pointer to the initialized log record, always equal in value to the given head
+     */
+    static auto Initialize(byte *const                        head,
+                           const transaction::timestamp_t     txn_begin,
+                           const catalog::db_oid_t            db_oid,
+                           const catalog::table_oid_t         table_oid,
+                           const ProjectedColumnsInitializer &initializer) -> LogRecord * {
+        LogRecord *result
+            = LogRecord::InitializeHeader(head, LogRecordType::BLOCK_INSERT, Size(initializer), txn_begin);
+        auto *body = result->GetUnderlyingRecordBodyAs<BlockInsertRecord>();
+        body->db_oid_ = db_oid;
+        body->table_oid_ = table_oid;
+        initializer.Initialize(body->Tuples());
+        return result;
+    }
+
+    /**
+     * @return database oid for this block insert record
+     */
+    auto GetDatabaseOid() const -> catalog::db_oid_t {
+        return db_oid_;
+    }
+
+    /**
+     * @return table oid for this block insert record
+     */
+    auto GetTableOid() const -> catalog::table_oid_t {
+        return table_oid_;
+    }
+
+    /**
+     * @return the inserted tuples, along with the slots they were inserted into
+     */
+    auto Tuples() -> ProjectedColumns * {
+        return reinterpret_cast<ProjectedColumns *>(varlen_contents_);
+    }
+
+    /**
+     * @return const the inserted tuples, along with the slots they were inserted into
+     */
+    auto Tuples() const -> const ProjectedColumns * {
+        return reinterpret_cast<const ProjectedColumns *>(varlen_contents_);
+    }
+
+private:
+    catalog::db_oid_t    db_oid_;
+    catalog::table_oid_t table_oid_;
+    // This needs to be aligned to 8 bytes to ensure the real size of BlockInsertRecord (plus actual ProjectedColumns)
+    // is also a multiple of 8.
+    uint64_t varlen_contents_[0];
+};
+
+static_assert(sizeof(BlockInsertRecord) % 8 == 0,
+              "projected columns inside the block insert record need to be aligned to 8 bytes");
+
 /**
  * Record body of a Commit. The header is stored in the LogRecord class that would presumably return this
  * object.
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#include "storage/data_table.h"
+#include "storage/storage_util.h"
+#include "storage/write_ahead_log/log_record.h"
+
+namespace noisepage::storage {
+
+/**
+ * Serializes in-memory log records into the on-disk log format. The serializer does not know where the bytes end up,
+ * the caller supplies a function that writes them out. This allows the log serializer task and the checkpoint writer to
+ * share a single definition of the format, which is read back in by AbstractLogProvider::ReadNextRecord.
+ * @warning If the serialization format of logs ever changes, AbstractLogProvider::ReadNextRecord must be updated.
+ */
+class LogRecordSerializer {
+public:
+    LogRecordSerializer() = delete;
+
+    /**
+     * Serialize out the record using the provided write function
+     * @tparam WriteFn callable of the form uint32_t(const void *val, uint32_t size) that writes out size bytes of val
+     * @param record the record to serialize
+     * @param write_value function used to write out the serialized bytes
+     * @return bytes serialized, used for metrics
+     */
+    template <class WriteFn>
+    static auto Serialize(const LogRecord &record, WriteFn &&write_value) -> uint64_t {
+        uint64_t num_bytes = 0;
+        // First, serialize out fields common across all LogRecordType's.
+
+        // Note: This is the in-memory size of the log record itself, i.e. inclusive of padding and not considering the
+        // size of any potential varlen entries. It is logically different from the size of the serialized record,
+        // which the log manager generates in this function. In particular, the later value is very likely to be
+        // strictly smaller when the LogRecordType is REDO. On recovery, the goal is to turn the serialized format back
+        // into an in-memory log record of this size.
+        num_bytes += WriteValue(write_value, record.Size());
+
+        num_bytes += WriteValue(write_value, record.RecordType());
+        num_bytes += WriteValue(write_value, record.TxnBegin());
+
+        switch (record.RecordType()) {
+        case LogRecordType::REDO: {
+            auto *record_body = record.GetUnderlyingRecordBodyAs<RedoRecord>();
+            num_bytes += WriteValue(write_value, record_body->GetDatabaseOid());
+            num_bytes += WriteValue(write_value, record_body->GetTableOid());
+            num_bytes += WriteValue(write_value, record_body->GetTupleSlot());
+
+            auto *delta = record_body->Delta();
+            // Write out which column ids this redo record is concerned with. On recovery, we can construct the
+            // appropriate ProjectedRowInitializer from these ids and their corresponding block layout.
+            num_bytes += WriteValue(write_value, delta->NumColumns());
+            num_bytes += write_value(delta->ColumnIds(), static_cast<uint32_t>(sizeof(col_id_t)) * delta->NumColumns());
+
+            // Write out the attr sizes boundaries, this way we can deserialize the records without the need of the
+            // block layout
+            const auto &block_layout = record_body->GetTupleSlot().GetBlock()->data_table_->GetBlockLayout();
+            uint16_t    boundaries[NUM_ATTR_BOUNDARIES];
+            memset(boundaries, 0, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
+            StorageUtil::ComputeAttributeSizeBoundaries(block_layout,
+                                                        delta->ColumnIds(),
+                                                        delta->NumColumns(),
+                                                        boundaries);
+            write_value(boundaries, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
+
+            // Write out the null bitmap.
+            num_bytes += write_value(&(delta->Bitmap()), common::RawBitmap::SizeInBytes(delta->NumColumns()));
+
+            // Write out attribute values
+            num_bytes += WriteAttributes(write_value, *delta, block_layout);
+            break;
+        }
+        case LogRecordType::DELETE: {
+            auto *record_body = record.GetUnderlyingRecordBodyAs<DeleteRecord>();
+            num_bytes += WriteValue(write_value, record_body->GetDatabaseOid());
+            num_bytes += WriteValue(write_value, record_body->GetTableOid());
+            num_bytes += WriteValue(write_value, record_body->GetTupleSlot());
+            break;
+        }
+        case LogRecordType::BLOCK_INSERT: {
+            auto *record_body = record.GetUnderlyingRecordBodyAs<BlockInsertRecord>();
+            num_bytes += WriteValue(write_value, record_body->GetDatabaseOid());
+            num_bytes += WriteValue(write_value, record_body->GetTableOid());
+
+            // The column ids and attr size boundaries are shared by all tuples in the batch, so they are written out
+            // only once. Each tuple is then written out the same way as the delta of a REDO record, which allows
+            // recovery to expand the batch back into individual REDO records.
+            const auto *tuples = record_body->Tuples();
+            num_bytes += WriteValue(write_value, tuples->NumTuples());
+            num_bytes += WriteValue(write_value, tuples->NumColumns());
+            num_bytes
+                += write_value(tuples->ColumnIds(), static_cast<uint32_t>(sizeof(col_id_t)) * tuples->NumColumns());
+
+            NOISEPAGE_ASSERT(tuples->NumTuples() > 0, "Block insert records are never staged empty");
+            const auto &block_layout = tuples->TupleSlots()[0].GetBlock()->data_table_->GetBlockLayout();
+            uint16_t    boundaries[NUM_ATTR_BOUNDARIES];
+            memset(boundaries, 0, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
+            StorageUtil::ComputeAttributeSizeBoundaries(block_layout,
+                                                        tuples->ColumnIds(),
+                                                        tuples->NumColumns(),
+                                                        boundaries);
+            num_bytes += write_value(boundaries, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
+
+            // The null bitmaps of a ProjectedColumns are stored per column, so each tuple's bitmap is assembled here.
+            std::vector<uint8_t> bitmap_buffer(common::RawBitmap::SizeInBytes(tuples->NumColumns()));
+            auto                *bitmap = reinterpret_cast<common::RawBitmap *>(bitmap_buffer.data());
+            for (uint32_t i = 0; i < tuples->NumTuples(); i++) {
+                const auto row = tuples->InterpretAsRow(i);
+                num_bytes += WriteValue(write_value, tuples->TupleSlots()[i]);
+                for (uint16_t j = 0; j < tuples->NumColumns(); j++) {
+                    bitmap->Set(j, !row.IsNull(j));
+                }
+                num_bytes += write_value(bitmap, static_cast<uint32_t>(bitmap_buffer.size()));
+                num_bytes += WriteAttributes(write_value, row, block_layout);
+            }
+            break;
+        }
+        case LogRecordType::COMMIT: {
+            auto *record_body = record.GetUnderlyingRecordBodyAs<CommitRecord>();
+            num_bytes += WriteValue(write_value, record_body->CommitTime());
+            num_bytes += WriteValue(write_value, record_body->OldestActiveTxn());
+            break;
+        }
+        case LogRecordType::ABORT: {
+            // AbortRecord does not hold any additional metadata
+            break;
+        }
+        }
+
+        return num_bytes;
+    }
+
+private:
+    /**
+     * Serialize the non-null attribute values of row using write_value. Varlens are written out as their size followed
+     * by their contents, everything else as exactly AttrSize bytes.
+     */
+    template <class WriteFn, class RowType>
+    static auto WriteAttributes(WriteFn &write_value, const RowType &row, const BlockLayout &block_layout)
+        -> uint64_t {
+        uint64_t num_bytes = 0;
+        for (uint16_t i = 0; i < row.NumColumns(); i++) {
+            const auto *column_value_address = row.AccessWithNullCheck(i);
+            if (column_value_address == nullptr) {
+                // If the column in this REDO record is null, then there's nothing to serialize out. The bitmap
+                // contains all the relevant information.
+                continue;
+            }
+            // Get the column id of the current column in the ProjectedRow.
+            col_id_t col_id = row.ColumnIds()[i];
+
+            if (block_layout.IsVarlen(col_id)) {
+                // Inline column value is a pointer to a VarlenEntry, so reinterpret as such.
+                const auto *varlen_entry = reinterpret_cast<const VarlenEntry *>(column_value_address);
+                // Serialize out length of the varlen entry.
+                num_bytes += WriteValue(write_value, varlen_entry->Size());
+                if (varlen_entry->IsInlined()) {
+                    // Serialize out the prefix of the varlen entry.
+                    num_bytes += write_value(varlen_entry->Prefix(), varlen_entry->Size());
+                } else {
+                    // Serialize out the content field of the varlen entry.
+                    num_bytes += write_value(varlen_entry->Content(), varlen_entry->Size());
+                }
+            } else {
+                // Inline column value is the actual data we want to serialize out.
+                // Note that by writing out AttrSize(col_id) bytes instead of just the difference between successive
+                // offsets of the delta record, we avoid serializing out any potential padding.
+                num_bytes += write_value(column_value_address, block_layout.AttrSize(col_id));
+            }
+        }
+        return num_bytes;
+    }
+
+    /** Serialize the fixed-size value val using write_value. */
+    template <class WriteFn, class T>
+    static auto WriteValue(WriteFn &write_value, const T &val) -> uint32_t {
+        return write_value(&val, static_cast<uint32_t>(sizeof(T)));
+    }
+};
+
+} // namespace noisepage::storage
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable> // NOLINT
 #include <queue>
 #include <thread> // NOLINT
@@ -35,6 +36,7 @@ public:
      * @param disk_log_writer_thread_cv   Pointer to cvar to notify consumer when a new buffer has handed over.
      * @param primary_replication_manager Pointer to replication manager where to-be-replicated serialized logs are
      * sent.
+     * @param compress                    Whether to compress filled buffers before handing them over.
      */
     explicit LogSerializerTask(
         const std::chrono::microseconds                                              serialization_interval,
@@ -42,7 +44,8 @@ public:
         common::ManagedPointer<common::ConcurrentBlockingQueue<BufferedLogWriter *>> empty_buffer_queue,
         common::ConcurrentQueue<storage::SerializedLogs>                            *filled_buffer_queue,
         std::condition_variable                                                     *disk_log_writer_thread_cv,
-        common::ManagedPointer<replication::PrimaryReplicationManager>               primary_replication_manager)
+        common::ManagedPointer<replication::PrimaryReplicationManager>               primary_replication_manager,
+        const bool                                                                   compress = false)
         : run_task_(false)
         , serialization_interval_(serialization_interval)
         , buffer_pool_(buffer_pool)
@@ -51,7 +54,8 @@ public:
         , empty_buffer_queue_(empty_buffer_queue)
         , filled_buffer_queue_(filled_buffer_queue)
         , disk_log_writer_thread_cv_(disk_log_writer_thread_cv)
-        , primary_replication_manager_(primary_replication_manager) {}
+        , primary_replication_manager_(primary_replication_manager)
+        , compress_(compress) {}
 
     /**
      * Runs main disk log writer loop. Called by thread registry upon initialization of thread
@@ -147,6 +151,10 @@ private:
     bool oat_replicas_ = false; ///< True if the replicas may need an update of their OAT.
     bool notify_oat_ = true;    ///< TODO(WAN): A hack to prevent use after free.
 
+    const bool compress_; ///< True if filled buffers are compressed into log frames before they are handed over.
+    /** Bytes compressed, the size of the frames they were compressed to, and the time taken, since last reported. */
+    std::atomic<uint64_t> compressed_bytes_in_ = 0, compressed_bytes_out_ = 0, compression_ns_ = 0;
+
     /**
      * Main serialization loop. Calls Process every interval. Processes all the accumulated log records and
      * serializes them to log consumer tasks.
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "common/macros.h"
+#include "storage/storage_defs.h"
+
+namespace noisepage::storage {
+
+/**
+ * Summary of the values that a fixed-length integer column (including dates and timestamps) holds in a block, kept
+ * in the block header so that scans can skip blocks whose values cannot satisfy their predicates. Values are compared
+ * as their bit patterns sign-extended to 64 bits.
+ *
+ * Writers only ever widen the range, so it covers every version of every tuple that a running transaction could
+ * read, as well as values that have since been overwritten, deleted or rolled back. The null count likewise only
+ * grows, and is an upper bound. The BlockCompactor makes both exact when it freezes the block, as a frozen block has
+ * no older versions left.
+ */
+class ColumnZoneMap {
+public:
+    MEM_REINTERPRETATION_ONLY(ColumnZoneMap)
+
+    /**
+     * @param attr_size size of the column's values in bytes
+     * @return whether columns of values of the given size are summarized
+     */
+    static bool Tracks(const uint16_t attr_size) {
+        return attr_size == 1 || attr_size == 2 || attr_size == 4 || attr_size == 8;
+    }
+
+    /**
+     * @param value location of the value
+     * @param attr_size size of the value in bytes, which must be 1, 2, 4 or 8
+     * @return the value, sign-extended to 64 bits
+     */
+    static int64_t ReadValue(const byte *const value, const uint16_t attr_size) {
+        switch (attr_size) {
+        case 1: {
+            int8_t v;
+            std::memcpy(&v, value, sizeof(v));
+            return v;
+        }
+        case 2: {
+            int16_t v;
+            std::memcpy(&v, value, sizeof(v));
+            return v;
+        }
+        case 4: {
+            int32_t v;
+            std::memcpy(&v, value, sizeof(v));
+            return v;
+        }
+        default: {
+            NOISEPAGE_ASSERT(attr_size == 8, "only 1, 2, 4 and 8 byte values are summarized");
+            int64_t v;
+            std::memcpy(&v, value, sizeof(v));
+            return v;
+        }
+        }
+    }
+
+    /**
+     * Empties the summary, as for a block without any values
+     */
+    void Reset() {
+        Set(std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min(), 0);
+    }
+
+    /**
+     * Overwrites the summary with exact values. Only safe while no one else writes to the block.
+     * @param min smallest non-null value
+     * @param max largest non-null value
+     * @param null_count number of null values
+     */
+    void Set(const int64_t min, const int64_t max, const uint32_t null_count) {
+        min_.store(min);
+        max_.store(max);
+        null_count_.store(null_count);
+    }
+
+    /**
+     * Widens the range to cover the value. Safe to call concurrently.
+     * @param value sign-extended value written to the column
+     */
+    void Widen(const int64_t value) {
+        int64_t current = min_.load();
+        while (value < current && !min_.compare_exchange_weak(current, value)) {
+        }
+        current = max_.load();
+        while (value > current && !max_.compare_exchange_weak(current, value)) {
+        }
+    }
+
+    /**
+     * Counts a null value written to the column. Safe to call concurrently.
+     */
+    void AddNull() {
+        null_count_.fetch_add(1);
+    }
+
+    /**
+     * @return smallest non-null value, or the largest int64_t if there is none
+     */
+    int64_t Min() const {
+        return min_.load();
+    }
+
+    /**
+     * @return largest non-null value, or the smallest int64_t if there is none
+     */
+    int64_t Max() const {
+        return max_.load();
+    }
+
+    /**
+     * @return upper bound on the number of null values
+     */
+    uint32_t NullCount() const {
+        return null_count_.load();
+    }
+
+    /**
+     * @param min smallest value of the range, inclusive
+     * @param max largest value of the range, inclusive
+     * @return false if no non-null value in the block can lie in the range
+     */
+    bool MayContain(const int64_t min, const int64_t max) const {
+        return min_.load() <= max && min <= max_.load();
+    }
+
+private:
+    std::atomic<int64_t>  min_;
+    std::atomic<int64_t>  max_;
+    std::atomic<uint32_t> null_count_;
+};
+
+/**
+ * A range that a scan only needs the tuples of if their value in the given column lies in it. Blocks whose zone map
+ * for the column does not overlap the range are skipped.
+ */
+struct ZoneMapFilter {
+    /** Column whose values are restricted */
+    col_id_t col_id_;
+    /** Smallest sign-extended value of the range, inclusive */
+    int64_t min_;
+    /** Largest sign-extended value of the range, inclusive */
+    int64_t max_;
+};
+
+} // namespace noisepage::storage
@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -9,6 +10,8 @@
 #include "common/managed_pointer.h"
 #include "execution/vm/vm_defs.h"
 #include "network/network_defs.h"
+#include "network/postgres/shared_statement_cache.h"
+#include "optimizer/cost_model/cost_model_util.h"
 #include "taskflow/taskflow_defs.h"
 #include "transaction/transaction_defs.h"
 
@@ -80,6 +83,8 @@ public:
      * @param optimizer_timeout for optimizer calls
      * @param use_query_cache whether to cache physical plans and generated code for Extended Query protocol
      * @param execution_mode how to run executable queries after code generation
+     * @param cost_model_type cost model used by the optimizer
+     * @param shared_statement_cache_size memory (in bytes) of the Statements that are shared across connections
      */
     Taskflow(common::ManagedPointer<transaction::TransactionManager> txn_manager,
              common::ManagedPointer<catalog::Catalog>                catalog,
@@ -89,7 +94,9 @@ public:
              common::ManagedPointer<optimizer::StatsStorage>         stats_storage,
              uint64_t                                                optimizer_timeout,
              bool                                                    use_query_cache,
-             const execution::vm::ExecutionMode                      execution_mode)
+             const execution::vm::ExecutionMode                      execution_mode,
+             const optimizer::CostModelType                          cost_model_type,
+             uint64_t                                                shared_statement_cache_size)
         : txn_manager_(txn_manager)
         , catalog_(catalog)
         , replication_manager_(replication_manager)
@@ -99,7 +106,9 @@ public:
         , optimizer_timeout_(optimizer_timeout)
         , use_query_cache_(use_query_cache)
         , query_cache_timestamp_(transaction::INITIAL_TXN_TIMESTAMP)
-        , execution_mode_(execution_mode) {}
+        , execution_mode_(execution_mode)
+        , cost_model_type_(cost_model_type)
+        , shared_statement_cache_(shared_statement_cache_size) {}
 
     virtual ~Taskflow() = default;
 
@@ -226,6 +235,27 @@ public:
                               common::ManagedPointer<planner::AbstractPlanNode>  physical_plan,
                               noisepage::network::QueryType                      query_type) const -> TaskflowResult;
 
+    /**
+     * Contains the logic to handle COPY ... FROM statements, which bulk load a file into a table.
+     * @param connection_ctx context to be used to access the internal txn
+     * @param statement the COPY ... FROM statement to be executed
+     * @return result of the operation, with the number of rows loaded if it succeeded
+     */
+    auto ExecuteCopyStatement(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                              common::ManagedPointer<network::Statement>         statement) const -> TaskflowResult;
+
+    /**
+     * Contains the logic to handle COPY ... TO statements in the arrow format, which stream a table in the Arrow IPC
+     * streaming format either to a file or, for STDOUT, to the client as CopyData messages.
+     * @param connection_ctx context to be used to access the internal txn
+     * @param out packet writer to stream the table to the client
+     * @param statement the COPY ... TO statement to be executed
+     * @return result of the operation, with the number of rows exported if it succeeded
+     */
+    auto ExecuteCopyToStatement(common::ManagedPointer<network::ConnectionContext>    connection_ctx,
+                                common::ManagedPointer<network::PostgresPacketWriter> out,
+                                common::ManagedPointer<network::Statement> statement) const -> TaskflowResult;
+
     /**
      * Contains the logic to reason about EXPLAIN execution.
      * @param connection_ctx context to be used to access the internal txn
@@ -277,6 +307,16 @@ public:
             = is_compiled ? execution::vm::ExecutionMode::Compiled : execution::vm::ExecutionMode::Interpret;
     }
 
+    /**
+     * Adjust the Taskflow's optimizer cost model (for use by SettingsManager)
+     * @param cost_model_type cost model used to optimize the queries from here on
+     */
+    void SetCostModelType(const optimizer::CostModelType cost_model_type) {
+        cost_model_type_ = cost_model_type;
+        // The cached plans were chosen by the previous cost model
+        UpdateQueryCacheTimestamp();
+    }
+
     /**
      * @return true if query caching enabled, false otherwise
      */
@@ -286,9 +326,23 @@ public:
 
     /**
      * Update the minimum generation timestamp required for the cached ExecutableQuery (resulting re-compilation for the
-     * unsatisfied ExecutableQuery )
+     * unsatisfied ExecutableQuery ), and evict the Statements shared across connections. This is done whenever the
+     * catalog or the statistics change.
+     */
+    void UpdateQueryCacheTimestamp() const;
+
+    /**
+     * @param statement Statement with a cached ExecutableQuery
+     * @return true if the ExecutableQuery was generated before the last UpdateQueryCacheTimestamp, false otherwise
      */
-    void UpdateQueryCacheTimestamp();
+    auto IsQueryCacheStale(common::ManagedPointer<network::Statement> statement) const -> bool;
+
+    /**
+     * @return cache of the Statements shared across connections
+     */
+    auto GetSharedStatementCache() -> common::ManagedPointer<network::SharedStatementCache> {
+        return common::ManagedPointer(&shared_statement_cache_);
+    }
 
 private:
     common::ManagedPointer<transaction::TransactionManager> txn_manager_;
@@ -299,8 +353,11 @@ private:
     common::ManagedPointer<optimizer::StatsStorage>         stats_storage_;
     uint64_t                                                optimizer_timeout_;
     bool                                                    use_query_cache_;
-    transaction::timestamp_t                                query_cache_timestamp_;
+    // Updated by the commit actions of DDL and ANALYZE, which may run on any thread
+    mutable std::atomic<transaction::timestamp_t>           query_cache_timestamp_;
     execution::vm::ExecutionMode                            execution_mode_;
+    optimizer::CostModelType                                cost_model_type_;
+    mutable network::SharedStatementCache                   shared_statement_cache_;
 };
 
 } // namespace noisepage::taskflow
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
 #include <unordered_set>
 #include <vector>
 
+#include "common/constants.h"
 #include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 #include "transaction/transaction_defs.h"
@@ -17,11 +20,35 @@ namespace noisepage::transaction {
 class TransactionManager;
 /**
  * Generates timestamps, and keeps track of the lifetime of transactions (whether they have entered or left the system)
+ *
+ * Running transactions are tracked without a latch. Their start times are kept in an open addressing table that is
+ * probed from the hash of the start time, so that a transaction is removed without a search, and so that transactions
+ * begun on different threads land on different cache lines. A transaction that finds no free slot within
+ * MAX_RUNNING_TXN_PROBES goes to a latched overflow set instead, which only happens if the table is nearly full.
+ *
+ * A transaction cannot be added to the table before it has its start time, but the oldest running transaction must
+ * never be computed as newer than a transaction that already has its start time. So a transaction first announces, in
+ * a begin slot of its own, the current time as a lower bound on its start time, and withdraws the announcement once it
+ * is in the table. Begin slots are scanned before the table, and the time before either.
  */
 class TimestampManager {
 public:
+    /** Number of slots in the table of running transactions is 2 to the power of this */
+    static constexpr uint32_t RUNNING_TXN_SLOT_BITS = 14;
+
+    /** Number of slots in the table of running transactions */
+    static constexpr uint32_t NUM_RUNNING_TXN_SLOTS = 1U << RUNNING_TXN_SLOT_BITS;
+
+    /** Number of slots of the table that are probed for a running transaction before it goes to the overflow set */
+    static constexpr uint32_t MAX_RUNNING_TXN_PROBES = 64;
+
+    /** Number of slots in which transactions that are beginning announce a lower bound on their start time */
+    static constexpr uint32_t NUM_BEGIN_SLOTS = 256;
+
+    TimestampManager();
+
     ~TimestampManager() {
-        NOISEPAGE_ASSERT(curr_running_txns_.empty(),
+        NOISEPAGE_ASSERT(num_running_txns_.load() == 0,
                          "Destroying the TimestampManager while txns are still running. That seems wrong.");
     }
 
@@ -39,21 +66,30 @@ public:
         return time_.load();
     }
 
+    /**
+     * Advances the time to the given timestamp, unless it is already past it
+     * @param timestamp timestamp to advance the time to
+     */
+    void AdvanceTime(const timestamp_t timestamp) {
+        auto current = time_.load();
+        while (current < timestamp && !time_.compare_exchange_weak(current, timestamp)) {
+        }
+    }
+
     /**
      * Get the oldest transaction alive (by start timestamp given out by this timestamp manager at this time)
      * Because of concurrent operations, it is not guaranteed that upon return the txn is still alive. However,
      * it is guaranteed that the return timestamp is older than any transactions live.
-     * @warning If logging is enabled, txns are not removed from the txn set until they are serialized. Thus, the active
-     * txn set can grow greatly in size, making this call expensive. Consider using CachedOldestTransactionStartTime for
-     * better performance at the cost of a more stale timestamp.
+     * @warning This scans every slot of the running txn table without blocking transactions. Consider using
+     * CachedOldestTransactionStartTime for better performance at the cost of a more stale timestamp.
      * @return timestamp that is older than any transactions alive
      */
     timestamp_t OldestTransactionStartTime();
 
     /**
      * Get the cached timestamp of the oldest active txn. The cached timestamp is only refreshed upon every invocation
-     * of OldestTransactionStartTime, so it may be stale. On the other hand, this function does not require taking a
-     * latch or iterating through the running txns set, making it much cheaper than OldestTransactionStartTime. This has
+     * of OldestTransactionStartTime, so it may be stale. On the other hand, this function does not require iterating
+     * through the running txns table, making it much cheaper than OldestTransactionStartTime. This has
      * the same correctness guarantee as OldestTransactionStartTime, but may cause performance degradations for
      * processes that rely on very fresh oldest txn timestamps
      * @return timestamp that is older than any transactions alive
@@ -61,31 +97,16 @@ public:
     timestamp_t CachedOldestTransactionStartTime();
 
 private:
-    // TransactionManager needs to be able to use the curr_running_txns_latch to guard more than just the
-    // duration of the following method calls --- things such as adding to the GC queue needs to be atomic
-    // along with removing a transaction from the table of active transactions. We need this for correctness
-    // in the deferred action framework when dropping tables.
+    // TransactionManager uses the curr_running_txns_latch to guard its queue of completed transactions for the GC.
+    // We need this for correctness in the deferred action framework when dropping tables.
     friend class TransactionManager;
     friend class storage::LogSerializerTask;
-    timestamp_t BeginTransaction() {
-        timestamp_t start_time;
-        {
-            common::SpinLatch::ScopedSpinLatch running_guard(&curr_running_txns_latch_);
-            // There is a three-way race that needs to be prevented.  Specifically, we
-            // cannot allow both a transaction to commit and the GC to poll for the
-            // oldest running transaction in between this transaction acquiring its
-            // begin timestamp and getting inserted into the current running
-            // transactions list.  Using the current running transactions latch
-            // prevents the GC from polling and stops the race.  This allows us to
-            // replace acquiring a shared instance of the commit latch with a
-            // read-only spin-latch and move the allocation out of a critical section.
-            start_time = time_++;
-
-            const auto ret [[maybe_unused]] = curr_running_txns_.emplace(start_time);
-            NOISEPAGE_ASSERT(ret.second, "commit start time should be globally unique");
-        } // Release latch on current running transactions
-        return start_time;
-    }
+
+    /**
+     * Checks out a start timestamp and adds it to the running txns. Wait-free unless the table overflows.
+     * @return start timestamp of the new transaction
+     */
+    timestamp_t BeginTransaction();
 
     /**
      * Remove a timestamp from active txn set
@@ -94,23 +115,39 @@ private:
     void RemoveTransaction(timestamp_t timestamp);
 
     /**
-     * Bulk remove a set of timestamps from the active txn set. Only grabs the curr_running_txns_latch_ once for all the
-     * timestamps.
+     * Bulk remove a set of timestamps from the active txn set.
      * @param timestamps vector of timestamps to remove
      * @return True if there are no more running transactions after removal. False otherwise.
      */
     bool RemoveTransactions(const std::vector<timestamp_t> &timestamps);
 
+    // Removes a timestamp from the running txn table or the overflow set, without updating the count
+    void RemoveRunningTransaction(timestamp_t timestamp);
+
+    static uint32_t RunningTxnSlot(const timestamp_t timestamp) {
+        // Fibonacci hashing, so that consecutive start times land on different cache lines
+        return static_cast<uint32_t>((timestamp.UnderlyingValue() * 0x9E3779B97F4A7C15ULL)
+                                     >> (64 - RUNNING_TXN_SLOT_BITS));
+    }
+
+    // A slot that a beginning transaction announces a lower bound on its start time in
+    struct alignas(common::Constants::CACHELINE_SIZE) BeginSlot {
+        std::atomic<timestamp_t> lower_bound_{INVALID_TXN_TIMESTAMP};
+    };
+
     // TODO(Tianyu): Timestamp generation needs to be more efficient (batches)
     // TODO(Tianyu): We don't handle timestamp wrap-arounds. I doubt this would be an issue any time soon.
     std::atomic<timestamp_t> time_{INITIAL_TXN_TIMESTAMP};
     // We cache the oldest txn start time
     std::atomic<timestamp_t> cached_oldest_txn_start_time_{INITIAL_TXN_TIMESTAMP};
-    // TODO(Matt): consider a different data structure if this becomes a measured bottleneck
-    // TODO(Gus): This data structure initially only held items in the order of # of workers. With the logging change,
-    // it can hold many more, since txns are only removed when serialized. We should consider if there is a possible
-    // better data structure
+    // Start times of running txns, INVALID_TXN_TIMESTAMP in free slots. Txns are only removed when serialized if
+    // logging is enabled, so this can hold many more txns than there are workers.
+    std::unique_ptr<std::atomic<timestamp_t>[]> running_txns_;
+    std::unique_ptr<BeginSlot[]>                begin_slots_;
+    std::atomic<uint64_t>                       num_running_txns_{0};
+    // Running txns that found no free slot in the table, guarded by curr_running_txns_latch_
     std::unordered_set<timestamp_t> curr_running_txns_;
+    std::atomic<uint64_t>           num_overflow_txns_{0};
     mutable common::SpinLatch       curr_running_txns_latch_;
 };
 } // namespace noisepage::transaction
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <vector>
 
 #include "common/macros.h"
@@ -24,6 +25,10 @@ class RecoveryManager;
 class RecoveryTests;
 } // namespace noisepage::storage
 
+namespace noisepage {
+struct GarbageCollectorTests;
+} // namespace noisepage
+
 namespace noisepage::transaction {
 /**
  * A transaction context encapsulates the information kept while the transaction is running
@@ -120,6 +125,20 @@ public:
         return storage::UndoRecord::InitializeInsert(result, finish_time_.load(), slot, table);
     }
 
+    /**
+     * Reserve space on this transaction's undo buffer for a record to log the bulk insert of a range of slots
+     * @param table pointer to the updated DataTable object
+     * @param first_slot the first TupleSlot inserted
+     * @param num_slots number of consecutive slots inserted, starting at first_slot
+     * @return a persistent pointer to the head of a memory chunk large enough to hold the undo record
+     */
+    auto UndoRecordForBlockInsert(storage::DataTable *const table,
+                                  const storage::TupleSlot  first_slot,
+                                  const uint32_t            num_slots) -> storage::UndoRecord * {
+        byte *const result = undo_buffer_.NewEntry(storage::UndoRecord::BlockInsertSize());
+        return storage::UndoRecord::InitializeBlockInsert(result, finish_time_.load(), first_slot, num_slots, table);
+    }
+
     /**
      * Reserve space on this transaction's undo buffer for a record to log the delete given
      * @param table pointer to the updated DataTable object
@@ -175,6 +194,28 @@ public:
                                           slot);
     }
 
+    /**
+     * Initialize a record that logs a batch of tuples bulk loaded into a block, that will be logged out to disk. The
+     * tuples must be copied into the record before it is used to change the SqlTable.
+     * @param db_oid the database oid that this record changes
+     * @param table_oid the table oid that this record changes
+     * @param initializer the initializer to use for the underlying record, must fit in a single buffer segment
+     * @return pointer to the initialized block insert record
+     * @warning the same lifetime caveats as StageWrite apply to the returned record
+     */
+    auto StageBlockInsert(const catalog::db_oid_t                     db_oid,
+                          const catalog::table_oid_t                  table_oid,
+                          const storage::ProjectedColumnsInitializer &initializer) -> storage::BlockInsertRecord * {
+        const uint32_t size = storage::BlockInsertRecord::Size(initializer);
+        auto *const    log_record
+            = storage::BlockInsertRecord::Initialize(redo_buffer_.NewEntry(size, GetTransactionPolicy()),
+                                                     start_time_,
+                                                     db_oid,
+                                                     table_oid,
+                                                     initializer);
+        return log_record->GetUnderlyingRecordBodyAs<storage::BlockInsertRecord>();
+    }
+
     // TODO(Tianyu): We need to discuss what happens to the loose_ptrs field now that we have deferred actions.
     /**
      * @return whether the transaction is read-only
@@ -269,14 +310,16 @@ public:
     }
 
 private:
+    friend class storage::DataTable;
     friend class storage::GarbageCollector;
     friend class TransactionManager;
     friend class storage::BlockCompactor;
     friend class storage::LogSerializerTask;
     friend class storage::SqlTable;
-    friend class storage::WriteAheadLoggingTests; // Needs access to redo buffer
-    friend class storage::RecoveryManager;        // Needs access to StageRecoveryUpdate
-    friend class storage::RecoveryTests;          // Needs access to redo buffer
+    friend class storage::WriteAheadLoggingTests;   // Needs access to redo buffer
+    friend class storage::RecoveryManager;          // Needs access to StageRecoveryUpdate
+    friend class storage::RecoveryTests;            // Needs access to redo buffer
+    friend struct noisepage::GarbageCollectorTests; // Needs access to version chain counters
     const timestamp_t        start_time_;
     std::atomic<timestamp_t> finish_time_;
     storage::UndoBuffer      undo_buffer_;
@@ -289,6 +332,15 @@ private:
     std::forward_list<TransactionEndAction> abort_actions_;
     std::forward_list<TransactionEndAction> commit_actions_;
 
+    // Start time of the oldest running txn when this txn began, as cached by the TimestampManager. No running txn
+    // applies versions older than this, so this txn prunes them from the version chains that it reads and writes.
+    timestamp_t prune_horizon_ = INITIAL_TXN_TIMESTAMP;
+    // Work done on version chains by this txn's reads, reported to the TransactionMetric on commit. A parallel scan reads
+    // from several threads on behalf of the same txn, and the counts need no ordering with anything else.
+    std::atomic<uint64_t> num_reads_ = 0;
+    std::atomic<uint64_t> num_versions_walked_ = 0;
+    std::atomic<uint64_t> num_chains_pruned_ = 0;
+
     // We need to know if the transaction is aborted. Even aborted transactions need an "abort" timestamp in order to
     // eliminate the a-b-a race described in DataTable::Select.
     bool aborted_ = false;
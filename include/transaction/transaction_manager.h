@@ -117,6 +117,14 @@ public:
         return timestamp_manager_->CurrentTime();
     }
 
+    /**
+     * Advances the time so that every transaction that begins from now on is ordered after the given timestamp
+     * @param timestamp timestamp to advance the time past
+     */
+    void AdvanceTimestampPast(const timestamp_t timestamp) {
+        timestamp_manager_->AdvanceTime(timestamp + 1);
+    }
+
 private:
     const common::ManagedPointer<TimestampManager>                 timestamp_manager_;
     const common::ManagedPointer<DeferredActionManager>            deferred_action_manager_;
@@ -149,7 +157,7 @@ private:
                                         const storage::TupleAccessStrategy &accessor) const;
 
     void DeallocateInsertedTupleIfVarlen(TransactionContext                 *txn,
-                                         storage::UndoRecord                *undo,
+                                         storage::TupleSlot                  slot,
                                          const storage::TupleAccessStrategy &accessor) const;
     void GCLastUpdateOnAbort(TransactionContext *txn);
 };
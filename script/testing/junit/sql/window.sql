@@ -0,0 +1,41 @@
+-- Generate tracefile with:
+--     ant generate-trace -Dpath=sql/window.sql -Ddb-url=jdbc:postgresql://localhost/postgres -Ddb-user=postgres -Ddb-password="postgres" -Doutput-name=window.test
+CREATE TABLE win1 (id INTEGER NOT NULL PRIMARY KEY, grp INTEGER, val INTEGER);
+INSERT INTO win1 VALUES (1, 1, 10);
+INSERT INTO win1 VALUES (2, 1, 20);
+INSERT INTO win1 VALUES (3, 1, 20);
+INSERT INTO win1 VALUES (4, 1, 40);
+INSERT INTO win1 VALUES (5, 2, 5);
+INSERT INTO win1 VALUES (6, 2, 15);
+INSERT INTO win1 VALUES (7, 2, 25);
+INSERT INTO win1 VALUES (8, 3, 100);
+
+SELECT id, SUM(val) OVER (ORDER BY id ROWS BETWEEN 1 PRECEDING AND 1 FOLLOWING) FROM win1 ORDER BY id;
+SELECT id, ROW_NUMBER() OVER (PARTITION BY grp ORDER BY id), SUM(val) OVER (PARTITION BY grp ORDER BY id ROWS BETWEEN 2 PRECEDING AND CURRENT ROW) FROM win1 ORDER BY id;
+SELECT id, SUM(val) OVER (PARTITION BY grp ORDER BY id ROWS BETWEEN 2147483647 PRECEDING AND 2147483647 FOLLOWING) FROM win1 ORDER BY id;
+SELECT id, COUNT(val) OVER (PARTITION BY grp ORDER BY id ROWS BETWEEN 1 FOLLOWING AND 2 FOLLOWING) FROM win1 ORDER BY id;
+SELECT id, COUNT(val) OVER (PARTITION BY grp ORDER BY id ROWS BETWEEN 2 PRECEDING AND 1 PRECEDING) FROM win1 ORDER BY id;
+SELECT id, SUM(val) OVER (ORDER BY val) FROM win1 ORDER BY id;
+SELECT id, RANK() OVER (PARTITION BY grp ORDER BY val), DENSE_RANK() OVER (PARTITION BY grp ORDER BY val) FROM win1 ORDER BY id;
+SELECT id, SUM(val) OVER (PARTITION BY grp ORDER BY val RANGE BETWEEN CURRENT ROW AND UNBOUNDED FOLLOWING) FROM win1 ORDER BY id;
+SELECT id, MAX(val) OVER (PARTITION BY grp), MIN(val) OVER (PARTITION BY grp) FROM win1 ORDER BY id;
+
+DROP TABLE win1;
+
+CREATE TABLE win2 (id INTEGER NOT NULL PRIMARY KEY, grp INTEGER, val INTEGER);
+INSERT INTO win2 VALUES (1, 1, 10);
+INSERT INTO win2 VALUES (2, NULL, 20);
+INSERT INTO win2 VALUES (3, 1, NULL);
+INSERT INTO win2 VALUES (4, NULL, 30);
+INSERT INTO win2 VALUES (5, 2, 10);
+INSERT INTO win2 VALUES (6, NULL, NULL);
+INSERT INTO win2 VALUES (7, 2, 10);
+INSERT INTO win2 VALUES (8, 1, 30);
+
+SELECT id, ROW_NUMBER() OVER (PARTITION BY grp ORDER BY id) FROM win2 ORDER BY id;
+SELECT id, COUNT(id) OVER (PARTITION BY grp), MAX(id) OVER (PARTITION BY grp) FROM win2 ORDER BY id;
+SELECT id, RANK() OVER (ORDER BY val), COUNT(id) OVER (ORDER BY val) FROM win2 ORDER BY id;
+SELECT id, RANK() OVER (ORDER BY val DESC), COUNT(id) OVER (ORDER BY val DESC) FROM win2 ORDER BY id;
+SELECT id, RANK() OVER (PARTITION BY grp ORDER BY val), COUNT(val) OVER (PARTITION BY grp ORDER BY val) FROM win2 ORDER BY id;
+
+DROP TABLE win2;
@@ -30,6 +30,7 @@
 #include "parser/expression/subquery_expression.h"
 #include "parser/expression/table_star_expression.h"
 #include "parser/expression/type_cast_expression.h"
+#include "parser/expression/window_expression.h"
 #include "parser/parse_result.h"
 #include "parser/statements.h"
 
@@ -869,6 +870,12 @@ void BindNodeVisitor::Visit([[maybe_unused]] common::ManagedPointer<parser::Type
     SqlNodeVisitor::Visit(expr);
 }
 
+void BindNodeVisitor::Visit(common::ManagedPointer<parser::WindowExpression> expr) {
+    BINDER_LOG_TRACE("Visiting WindowExpression ...");
+    SqlNodeVisitor::Visit(expr);
+    expr->DeriveReturnValueType();
+}
+
 void BindNodeVisitor::Visit(common::ManagedPointer<parser::GroupByDescription> node) {
     BINDER_LOG_TRACE("Visiting GroupByDescription ...");
     SqlNodeVisitor::Visit(node);
@@ -15,6 +15,7 @@
 #include "parser/expression/subquery_expression.h"
 #include "parser/expression/table_star_expression.h"
 #include "parser/expression/type_cast_expression.h"
+#include "parser/expression/window_expression.h"
 
 namespace noisepage {
 void binder::SqlNodeVisitor::Visit(common::ManagedPointer<parser::AggregateExpression> expr) {
@@ -62,5 +63,8 @@ void binder::SqlNodeVisitor::Visit(common::ManagedPointer<parser::SubqueryExpres
 void binder::SqlNodeVisitor::Visit(common::ManagedPointer<parser::TypeCastExpression> expr) {
     expr->AcceptChildren(common::ManagedPointer(this));
 }
+void binder::SqlNodeVisitor::Visit(common::ManagedPointer<parser::WindowExpression> expr) {
+    expr->AcceptChildren(common::ManagedPointer(this));
+}
 
 } // namespace noisepage
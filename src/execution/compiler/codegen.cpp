@@ -702,6 +702,16 @@ auto CodeGen::TableIterGetVPI(ast::Expr *table_iter) -> ast::Expr * {
     return call;
 }
 
+auto CodeGen::TableIterAddBlockFilter(ast::Expr               *table_iter,
+                                      const catalog::col_oid_t col_oid,
+                                      const int64_t            min,
+                                      const int64_t            max) -> ast::Expr * {
+    ast::Expr *call = CallBuiltin(ast::Builtin::TableIterAddBlockFilter,
+                                  {table_iter, ConstU32(col_oid.UnderlyingValue()), Const64(min), Const64(max)});
+    call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+    return call;
+}
+
 auto CodeGen::TableIterClose(ast::Expr *table_iter) -> ast::Expr * {
     ast::Expr *call = CallBuiltin(ast::Builtin::TableIterClose, {table_iter});
     call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
@@ -1128,6 +1138,15 @@ auto CodeGen::AggHashTableMovePartitions(ast::Expr      *agg_ht,
     return call;
 }
 
+auto CodeGen::AggHashTableMergeOverflowPartitions(ast::Expr      *agg_ht,
+                                                  ast::Expr      *query_state,
+                                                  ast::Identifier merge_partitions_fn_name) -> ast::Expr * {
+    ast::Expr *call = CallBuiltin(ast::Builtin::AggHashTableMergeOverflowPartitions,
+                                  {agg_ht, query_state, MakeExpr(merge_partitions_fn_name)});
+    call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+    return call;
+}
+
 auto CodeGen::AggHashTableParallelScan(ast::Expr      *agg_ht,
                                        ast::Expr      *query_state,
                                        ast::Expr      *thread_state_container,
@@ -1305,6 +1324,12 @@ auto CodeGen::SorterFree(ast::Expr *sorter) -> ast::Expr * {
     return call;
 }
 
+auto CodeGen::SorterGetTupleAt(ast::Expr *sorter, ast::Expr *idx, ast::Identifier row_type_name) -> ast::Expr * {
+    ast::Expr *call = CallBuiltin(ast::Builtin::SorterGetTupleAt, {sorter, idx});
+    call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Uint8)->PointerTo());
+    return PtrCast(row_type_name, call);
+}
+
 auto CodeGen::SorterIterInit(ast::Expr *iter, ast::Expr *sorter) -> ast::Expr * {
     ast::Expr *call = CallBuiltin(ast::Builtin::SorterIterInit, {iter, sorter});
     call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
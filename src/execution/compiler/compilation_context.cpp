@@ -36,6 +36,7 @@
 #include "execution/compiler/operator/index_scan_translator.h"
 #include "execution/compiler/operator/insert_translator.h"
 #include "execution/compiler/operator/limit_translator.h"
+#include "execution/compiler/operator/merge_join_translator.h"
 #include "execution/compiler/operator/nested_loop_join_translator.h"
 #include "execution/compiler/operator/operator_translator.h"
 #include "execution/compiler/operator/output_translator.h"
@@ -44,6 +45,7 @@
 #include "execution/compiler/operator/sort_translator.h"
 #include "execution/compiler/operator/static_aggregation_translator.h"
 #include "execution/compiler/operator/update_translator.h"
+#include "execution/compiler/operator/window_translator.h"
 #include "execution/compiler/pipeline.h"
 #include "execution/exec/execution_settings.h"
 #include "parser/expression/abstract_expression.h"
@@ -66,6 +68,7 @@
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
 #include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/plan_meta_data.h"
@@ -73,6 +76,7 @@
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "planner/plannodes/set_op_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
+#include "planner/plannodes/window_plan_node.h"
 #include "self_driving/modeling/operating_unit_recorder.h"
 #include "spdlog/fmt/fmt.h"
 
@@ -268,6 +272,11 @@ void CompilationContext::Prepare(const planner::AbstractPlanNode &plan, Pipeline
         translator = std::make_unique<HashJoinTranslator>(hash_join, this, pipeline);
         break;
     }
+    case planner::PlanNodeType::MERGEJOIN: {
+        const auto &merge_join = dynamic_cast<const planner::MergeJoinPlanNode &>(plan);
+        translator = std::make_unique<MergeJoinTranslator>(merge_join, this, pipeline);
+        break;
+    }
     case planner::PlanNodeType::LIMIT: {
         const auto &limit = dynamic_cast<const planner::LimitPlanNode &>(plan);
         translator = std::make_unique<LimitTranslator>(limit, this, pipeline);
@@ -283,6 +292,11 @@ void CompilationContext::Prepare(const planner::AbstractPlanNode &plan, Pipeline
         translator = std::make_unique<SortTranslator>(sort, this, pipeline);
         break;
     }
+    case planner::PlanNodeType::WINDOW: {
+        const auto &window = dynamic_cast<const planner::WindowPlanNode &>(plan);
+        translator = std::make_unique<WindowTranslator>(window, this, pipeline);
+        break;
+    }
     case planner::PlanNodeType::PROJECTION: {
         const auto &projection = dynamic_cast<const planner::ProjectionPlanNode &>(plan);
         translator = std::make_unique<ProjectionTranslator>(projection, this, pipeline);
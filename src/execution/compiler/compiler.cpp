@@ -107,7 +107,8 @@ void Compiler::Run(Compiler::Callbacks *callbacks) {
         return;
     }
 
-    auto bytecode_module = vm::BytecodeGenerator::Compile(root_, input_.name_);
+    auto bytecode_module
+        = vm::BytecodeGenerator::Compile(root_, input_.name_, input_.GetSettings().ShouldUseSuperinstructions());
     bytecode_module_ = bytecode_module.get();
 
     if (GetErrorReporter()->HasErrors()) {
@@ -63,6 +63,10 @@ auto ExecutableQuery::Fragment::GetModuleMetadata() const -> const vm::ModuleMet
     return module_->GetMetadata();
 }
 
+auto ExecutableQuery::Fragment::GetBytecodeSize() const -> std::size_t {
+    return module_->GetBytecodeModule()->GetBytecodeSize();
+}
+
 //===----------------------------------------------------------------------===//
 //
 // Executable Query
@@ -172,6 +176,14 @@ void ExecutableQuery::Setup(std::vector<std::unique_ptr<Fragment>>             &
                         query_state_size_);
 }
 
+auto ExecutableQuery::GetBytecodeSize() const -> std::size_t {
+    std::size_t size = 0;
+    for (const auto &fragment : fragments_) {
+        size += fragment->GetBytecodeSize();
+    }
+    return size;
+}
+
 void ExecutableQuery::Run(common::ManagedPointer<exec::ExecutionContext> exec_ctx, vm::ExecutionMode mode) {
     // First, allocate the query state and move the execution context into it.
     auto query_state = std::make_unique<byte[]>(query_state_size_);
@@ -273,10 +273,9 @@ auto HashAggregationTranslator::GenerateKeyCheckFunction() -> ast::FunctionDecl
 }
 
 void HashAggregationTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) {
-    if (build_pipeline_.IsParallel()) {
-        decls->push_back(GeneratePartialKeyCheckFunction());
-        decls->push_back(GenerateMergeOverflowPartitionsFunction());
-    }
+    // A serial build merges partial aggregates, too, if it runs over the memory budget and spills.
+    decls->push_back(GeneratePartialKeyCheckFunction());
+    decls->push_back(GenerateMergeOverflowPartitionsFunction());
     decls->push_back(GenerateKeyCheckFunction());
 
     // Generate distinctkey check functions
@@ -730,6 +729,11 @@ void HashAggregationTranslator::FinishPipelineWork(const Pipeline &pipeline, Fun
                 function->Append(codegen->ExecCtxClearHooks(exec_ctx));
             }
         } else {
+            // Merge the partial aggregates back in, in case the table spilled.
+            auto *codegen = GetCodeGen();
+            function->Append(codegen->AggHashTableMergeOverflowPartitions(global_agg_ht_.GetPtr(codegen),
+                                                                          GetQueryStatePtr(),
+                                                                          merge_partitions_fn_));
             RecordCounters(pipeline, function);
         }
     } else if (!pipeline.IsParallel()) {
@@ -199,6 +199,17 @@ void IndexCreateTranslator::PerformPipelineWork(WorkContext *context, FunctionBu
     }
 }
 
+void IndexCreateTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+    // The scan only staged the keys. Any thread's storage interface can build the index from the keys of all threads.
+    // if (!@indexBuildFinish(&local_storage_interface)) { Abort(); }
+    auto *build_call
+        = codegen_->CallBuiltin(ast::Builtin::IndexBuildFinish, {local_storage_interface_.GetPtr(codegen_)});
+    auto *cond = codegen_->UnaryOp(parsing::Token::Type::BANG, build_call);
+    If    success(function, cond);
+    { function->Append(codegen_->AbortTxn(GetExecutionContext())); }
+    success.EndIf();
+}
+
 void IndexCreateTranslator::SetGlobalOids(FunctionBuilder *function, ast::Expr *global_col_oids) const {
     for (uint64_t i = 0; i < all_oids_.size(); i++) {
         // col_oids_var_[i] = col_oid
@@ -0,0 +1,332 @@
+#include "execution/compiler/operator/merge_join_translator.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/compiler/compilation_context.h"
+#include "execution/compiler/function_builder.h"
+#include "execution/compiler/if.h"
+#include "execution/compiler/loop.h"
+#include "execution/compiler/work_context.h"
+#include "planner/plannodes/merge_join_plan_node.h"
+#include "planner/plannodes/output_schema.h"
+
+namespace noisepage::execution::compiler {
+
+namespace {
+    constexpr const char LEFT_ROW_ATTR_PREFIX[] = "attr";
+    constexpr const char RIGHT_KEY_PREFIX[] = "key";
+} // namespace
+
+MergeJoinTranslator::MergeJoinTranslator(const planner::MergeJoinPlanNode &plan,
+                                         CompilationContext               *compilation_context,
+                                         Pipeline                         *pipeline)
+    : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::DUMMY)
+    , left_row_var_(GetCodeGen()->MakeFreshIdentifier("leftRow"))
+    , left_row_type_(GetCodeGen()->MakeFreshIdentifier("LeftRow"))
+    , right_keys_var_(GetCodeGen()->MakeFreshIdentifier("rightKeys"))
+    , right_keys_type_(GetCodeGen()->MakeFreshIdentifier("RightKeys"))
+    , lhs_row_(GetCodeGen()->MakeIdentifier("lhs"))
+    , rhs_row_(GetCodeGen()->MakeIdentifier("rhs"))
+    , sort_compare_func_(GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("Compare")))
+    , merge_compare_func_(GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("CompareKeys")))
+    , left_pipeline_(this, Pipeline::Parallelism::Serial)
+    , current_row_(CurrentRow::Child) {
+    NOISEPAGE_ASSERT(!plan.GetLeftMergeKeys().empty(), "Merge-join must have join keys from left input");
+    NOISEPAGE_ASSERT(plan.GetLeftMergeKeys().size() == plan.GetRightMergeKeys().size(),
+                     "Merge-join must have as many join keys from both inputs");
+    NOISEPAGE_ASSERT(plan.GetJoinPredicate() != nullptr, "Merge-join must have a join predicate!");
+    NOISEPAGE_ASSERT(plan.GetLogicalJoinType() == planner::LogicalJoinType::INNER, "Only inner merge-joins supported");
+
+    // The right rows are merged in the order of the right child.
+    pipeline->UpdateParallelism(Pipeline::Parallelism::Serial);
+
+    // Merge pipeline begins after the left pipeline.
+    pipeline->LinkSourcePipeline(&left_pipeline_);
+    // Register left and right child in their appropriate pipelines.
+    compilation_context->Prepare(*plan.GetChild(0), &left_pipeline_);
+    compilation_context->Prepare(*plan.GetChild(1), pipeline);
+
+    // Prepare join predicate, left, and right merge keys.
+    compilation_context->Prepare(*plan.GetJoinPredicate());
+    for (const auto left_merge_key : plan.GetLeftMergeKeys()) {
+        compilation_context->Prepare(*left_merge_key);
+    }
+    for (const auto right_merge_key : plan.GetRightMergeKeys()) {
+        compilation_context->Prepare(*right_merge_key);
+    }
+
+    // Declare global state.
+    auto      *codegen = GetCodeGen();
+    ast::Expr *sorter_type = codegen->BuiltinType(ast::BuiltinType::Sorter);
+    global_sorter_ = compilation_context->GetQueryState()->DeclareStateEntry(codegen, "sorter", sorter_type);
+
+    // Declare the position of the merge in the left rows.
+    left_idx_ = pipeline->DeclarePipelineStateEntry("leftIdx", codegen->BuiltinType(ast::BuiltinType::Uint32));
+}
+
+void MergeJoinTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) {
+    auto *codegen = GetCodeGen();
+
+    /* Left row declaration */
+    auto fields = codegen->MakeEmptyFieldList();
+    GetAllChildOutputFields(0, LEFT_ROW_ATTR_PREFIX, &fields);
+    decls->push_back(codegen->DeclareStruct(left_row_type_, std::move(fields)));
+
+    /* Right keys declaration */
+    fields = codegen->MakeEmptyFieldList();
+    const auto &right_keys = GetPlanAs<planner::MergeJoinPlanNode>().GetRightMergeKeys();
+    for (uint32_t key_idx = 0; key_idx < right_keys.size(); key_idx++) {
+        auto field_name = codegen->MakeIdentifier(RIGHT_KEY_PREFIX + std::to_string(key_idx));
+        auto type = codegen->TplType(sql::GetTypeId(right_keys[key_idx]->GetReturnValueType()));
+        fields.push_back(codegen->MakeField(field_name, type));
+    }
+    decls->push_back(codegen->DeclareStruct(right_keys_type_, std::move(fields)));
+}
+
+auto MergeJoinTranslator::GenerateSortComparisonFunction() -> ast::FunctionDecl * {
+    auto           *codegen = GetCodeGen();
+    auto            params = codegen->MakeFieldList({
+        codegen->MakeField(lhs_row_, codegen->PointerType(left_row_type_)),
+        codegen->MakeField(rhs_row_, codegen->PointerType(left_row_type_)),
+    });
+    FunctionBuilder builder(codegen, sort_compare_func_, std::move(params), codegen->Int32Type());
+    {
+        WorkContext context(GetCompilationContext(), left_pipeline_);
+        context.SetExpressionCacheEnable(false);
+        for (const auto left_key : GetPlanAs<planner::MergeJoinPlanNode>().GetLeftMergeKeys()) {
+            int32_t ret_value = -1;
+            for (const auto tok : {parsing::Token::Type::LESS, parsing::Token::Type::GREATER}) {
+                current_row_ = CurrentRow::Lhs;
+                ast::Expr *lhs = context.DeriveValue(*left_key, this);
+                current_row_ = CurrentRow::Rhs;
+                ast::Expr *rhs = context.DeriveValue(*left_key, this);
+                If         check_comparison(&builder, codegen->Compare(tok, lhs, rhs));
+                {
+                    builder.Append(codegen->Return(codegen->Const32(ret_value)));
+                }
+                check_comparison.EndIf();
+                ret_value = -ret_value;
+            }
+        }
+        current_row_ = CurrentRow::Child;
+    }
+    return builder.Finish(codegen->Const32(0));
+}
+
+auto MergeJoinTranslator::GenerateMergeComparisonFunction() -> ast::FunctionDecl * {
+    auto           *codegen = GetCodeGen();
+    auto            params = codegen->MakeFieldList({
+        codegen->MakeField(lhs_row_, codegen->PointerType(left_row_type_)),
+        codegen->MakeField(rhs_row_, codegen->PointerType(right_keys_type_)),
+    });
+    FunctionBuilder builder(codegen, merge_compare_func_, std::move(params), codegen->Int32Type());
+    {
+        WorkContext context(GetCompilationContext(), left_pipeline_);
+        context.SetExpressionCacheEnable(false);
+        const auto &left_keys = GetPlanAs<planner::MergeJoinPlanNode>().GetLeftMergeKeys();
+        for (uint32_t key_idx = 0; key_idx < left_keys.size(); key_idx++) {
+            int32_t ret_value = -1;
+            for (const auto tok : {parsing::Token::Type::LESS, parsing::Token::Type::GREATER}) {
+                current_row_ = CurrentRow::Lhs;
+                ast::Expr *lhs = context.DeriveValue(*left_keys[key_idx], this);
+                ast::Expr *rhs = GetRightKey(rhs_row_, key_idx);
+                If         check_comparison(&builder, codegen->Compare(tok, lhs, rhs));
+                {
+                    builder.Append(codegen->Return(codegen->Const32(ret_value)));
+                }
+                check_comparison.EndIf();
+                ret_value = -ret_value;
+            }
+        }
+        current_row_ = CurrentRow::Child;
+    }
+    return builder.Finish(codegen->Const32(0));
+}
+
+void MergeJoinTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) {
+    decls->push_back(GenerateSortComparisonFunction());
+    decls->push_back(GenerateMergeComparisonFunction());
+}
+
+void MergeJoinTranslator::InitializeQueryState(FunctionBuilder *function) const {
+    auto *codegen = GetCodeGen();
+    function->Append(
+        codegen->SorterInit(global_sorter_.GetPtr(codegen), GetExecutionContext(), sort_compare_func_, left_row_type_));
+}
+
+void MergeJoinTranslator::TearDownQueryState(FunctionBuilder *function) const {
+    function->Append(GetCodeGen()->SorterFree(global_sorter_.GetPtr(GetCodeGen())));
+}
+
+void MergeJoinTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+    if (IsRightPipeline(pipeline)) {
+        auto *codegen = GetCodeGen();
+        function->Append(codegen->Assign(left_idx_.Get(codegen), codegen->ConstU32(0)));
+    }
+}
+
+auto MergeJoinTranslator::GetLeftRowAttribute(ast::Identifier left_row, uint32_t attr_idx) const -> ast::Expr * {
+    auto           *codegen = GetCodeGen();
+    ast::Identifier attr_name = codegen->MakeIdentifier(LEFT_ROW_ATTR_PREFIX + std::to_string(attr_idx));
+    return codegen->AccessStructMember(codegen->MakeExpr(left_row), attr_name);
+}
+
+auto MergeJoinTranslator::GetRightKey(ast::Identifier right_keys, uint32_t key_idx) const -> ast::Expr * {
+    auto           *codegen = GetCodeGen();
+    ast::Identifier key_name = codegen->MakeIdentifier(RIGHT_KEY_PREFIX + std::to_string(key_idx));
+    return codegen->AccessStructMember(codegen->MakeExpr(right_keys), key_name);
+}
+
+auto MergeJoinTranslator::KeysNotNull(const std::vector<ast::Expr *> &keys) const -> ast::Expr * {
+    auto      *codegen = GetCodeGen();
+    ast::Expr *result = nullptr;
+    for (auto *key : keys) {
+        // !@isValNull(key)
+        ast::Expr *not_null
+            = codegen->UnaryOp(parsing::Token::Type::BANG, codegen->CallBuiltin(ast::Builtin::IsValNull, {key}));
+        result = result == nullptr ? not_null : codegen->BinaryOp(parsing::Token::Type::AND, result, not_null);
+    }
+    return result;
+}
+
+void MergeJoinTranslator::InsertIntoSorter(WorkContext *ctx, FunctionBuilder *function) const {
+    auto *codegen = GetCodeGen();
+
+    // A left row with a NULL key joins with no right row, and NULL keys have no order in the sorter.
+    std::vector<ast::Expr *> keys;
+    for (const auto left_key : GetPlanAs<planner::MergeJoinPlanNode>().GetLeftMergeKeys()) {
+        keys.push_back(ctx->DeriveValue(*left_key, this));
+    }
+    If check_keys(function, KeysNotNull(keys));
+    {
+        // var leftRow = @ptrCast(*LeftRow, @sorterInsert(&state.sorter))
+        ast::Expr *insert_call = codegen->SorterInsert(global_sorter_.GetPtr(codegen), left_row_type_);
+        function->Append(codegen->DeclareVarWithInit(left_row_var_, insert_call));
+
+        // Fill row.
+        const auto child_schema = GetPlan().GetChild(0)->GetOutputSchema();
+        for (uint32_t attr_idx = 0; attr_idx < child_schema->GetColumns().size(); attr_idx++) {
+            ast::Expr *lhs = GetLeftRowAttribute(left_row_var_, attr_idx);
+            ast::Expr *rhs = GetChildOutput(ctx, 0, attr_idx);
+            function->Append(codegen->Assign(lhs, rhs));
+        }
+    }
+    check_keys.EndIf();
+}
+
+void MergeJoinTranslator::MergeWithLeftRows(WorkContext *ctx, FunctionBuilder *function) const {
+    auto       *codegen = GetCodeGen();
+    ast::Expr  *sorter_ptr = global_sorter_.GetPtr(codegen);
+    const auto &right_keys = GetPlanAs<planner::MergeJoinPlanNode>().GetRightMergeKeys();
+
+    // var rightKeys: RightKeys
+    function->Append(codegen->DeclareVarNoInit(right_keys_var_, codegen->MakeExpr(right_keys_type_)));
+    std::vector<ast::Expr *> keys;
+    for (uint32_t key_idx = 0; key_idx < right_keys.size(); key_idx++) {
+        function->Append(codegen->Assign(GetRightKey(right_keys_var_, key_idx),
+                                         ctx->DeriveValue(*right_keys[key_idx], this)));
+        keys.push_back(GetRightKey(right_keys_var_, key_idx));
+    }
+
+    // A right row with a NULL key joins with no left row, and must not move the merge: NULL keys compare as equal to
+    // any key, because neither of the comparisons holds.
+    If check_keys(function, KeysNotNull(keys));
+    {
+        // var numLeftRows = @sorterGetTupleCount(&state.sorter)
+        auto num_left_rows = codegen->MakeFreshIdentifier("numLeftRows");
+        function->Append(codegen->DeclareVarWithInit(
+            num_left_rows, codegen->CallBuiltin(ast::Builtin::SorterGetTupleCount, {sorter_ptr})));
+
+        // idx < numLeftRows and CompareKeys(@sorterGetTupleAt(&state.sorter, idx), &rightKeys) <op> 0
+        const auto merge_cond = [&](const auto &make_idx, parsing::Token::Type op) {
+            auto in_bounds
+                = codegen->Compare(parsing::Token::Type::LESS, make_idx(), codegen->MakeExpr(num_left_rows));
+            auto left_row = codegen->SorterGetTupleAt(sorter_ptr, make_idx(), left_row_type_);
+            auto right_keys_ptr = codegen->AddressOf(codegen->MakeExpr(right_keys_var_));
+            auto cmp = codegen->Call(merge_compare_func_, {left_row, right_keys_ptr});
+            return codegen->BinaryOp(
+                parsing::Token::Type::AND, in_bounds, codegen->Compare(op, cmp, codegen->Const32(0)));
+        };
+        const auto left_idx = [&]() { return left_idx_.Get(codegen); };
+        const auto match_idx = codegen->MakeFreshIdentifier("matchIdx");
+        const auto match_idx_expr = [&]() { return codegen->MakeExpr(match_idx); };
+        const auto increment = [&](const auto &make_idx) {
+            return codegen->Assign(make_idx(),
+                                   codegen->BinaryOp(parsing::Token::Type::PLUS, make_idx(), codegen->ConstU32(1)));
+        };
+
+        // The left rows with smaller keys cannot join with this right row, nor with any of the following ones.
+        // for (leftIdx < numLeftRows and CompareKeys(...) < 0) { leftIdx = leftIdx + 1 }
+        Loop skip_loop(function, nullptr, merge_cond(left_idx, parsing::Token::Type::LESS), nullptr);
+        {
+            function->Append(increment(left_idx));
+        }
+        skip_loop.EndLoop();
+
+        // The left rows with equal keys are kept for the following right rows, which may have the same keys.
+        // for (var matchIdx = leftIdx; matchIdx < numLeftRows and CompareKeys(...) == 0; matchIdx = matchIdx + 1)
+        function->Append(codegen->DeclareVarWithInit(match_idx, left_idx()));
+        Loop match_loop(function,
+                        nullptr,
+                        merge_cond(match_idx_expr, parsing::Token::Type::EQUAL_EQUAL),
+                        increment(match_idx_expr));
+        {
+            // var leftRow = @ptrCast(*LeftRow, @sorterGetTupleAt(&state.sorter, matchIdx))
+            auto left_row = codegen->SorterGetTupleAt(sorter_ptr, codegen->MakeExpr(match_idx), left_row_type_);
+            function->Append(codegen->DeclareVarWithInit(left_row_var_, left_row));
+            CheckJoinPredicate(ctx, function);
+        }
+        match_loop.EndLoop();
+    }
+    check_keys.EndIf();
+}
+
+void MergeJoinTranslator::CheckJoinPredicate(WorkContext *ctx, FunctionBuilder *function) const {
+    // The join predicate includes the equality of the merge keys, which filters out NULL keys.
+    auto cond = ctx->DeriveValue(*GetPlanAs<planner::MergeJoinPlanNode>().GetJoinPredicate(), this);
+
+    If check_condition(function, cond);
+    {
+        // Just push forward
+        ctx->Push(function);
+    }
+    check_condition.EndIf();
+}
+
+void MergeJoinTranslator::PerformPipelineWork(WorkContext *ctx, FunctionBuilder *function) const {
+    if (IsLeftPipeline(ctx->GetPipeline())) {
+        InsertIntoSorter(ctx, function);
+    } else {
+        NOISEPAGE_ASSERT(IsRightPipeline(ctx->GetPipeline()), "Pipeline is unknown to join translator");
+        MergeWithLeftRows(ctx, function);
+    }
+}
+
+void MergeJoinTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+    if (IsLeftPipeline(pipeline)) {
+        auto *codegen = GetCodeGen();
+        function->Append(codegen->SorterSort(global_sorter_.GetPtr(codegen)));
+    }
+}
+
+auto MergeJoinTranslator::GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const
+    -> ast::Expr * {
+    // While generating the comparison functions, the left child's attributes are read from their parameters. In the
+    // right pipeline, they are read from the materialized left row.
+    switch (current_row_) {
+    case CurrentRow::Lhs:
+        return GetLeftRowAttribute(lhs_row_, attr_idx);
+    case CurrentRow::Rhs:
+        return GetLeftRowAttribute(rhs_row_, attr_idx);
+    case CurrentRow::Child:
+        if (IsRightPipeline(context->GetPipeline()) && child_idx == 0) {
+            return GetLeftRowAttribute(left_row_var_, attr_idx);
+        }
+        return OperatorTranslator::GetChildOutput(context, child_idx, attr_idx);
+    }
+    UNREACHABLE("Impossible output row option");
+}
+
+} // namespace noisepage::execution::compiler
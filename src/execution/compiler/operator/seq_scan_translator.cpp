@@ -1,5 +1,7 @@
 #include "execution/compiler/operator/seq_scan_translator.h"
 
+#include <limits>
+
 #include "catalog/catalog_accessor.h"
 #include "common/error/error_code.h"
 #include "common/error/exception.h"
@@ -12,6 +14,7 @@
 #include "execution/compiler/pipeline.h"
 #include "execution/compiler/work_context.h"
 #include "parser/expression/column_value_expression.h"
+#include "parser/expression/constant_value_expression.h"
 #include "parser/expression_util.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "storage/sql_table.h"
@@ -222,6 +225,83 @@ void SeqScanTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionDe
     }
 }
 
+auto SeqScanTranslator::GetBlockFilterRange(const parser::AbstractExpression &term,
+                                            const sql::SqlTypeId              col_type,
+                                            int64_t *const                    min,
+                                            int64_t *const                    max) -> bool {
+    const auto &constant = *term.GetChild(1).CastTo<parser::ConstantValueExpression>();
+    if (constant.IsNull()) {
+        return false;
+    }
+    const auto is_integer = [](const sql::SqlTypeId type) {
+        return type == sql::SqlTypeId::TinyInt || type == sql::SqlTypeId::SmallInt
+               || type == sql::SqlTypeId::Integer || type == sql::SqlTypeId::BigInt;
+    };
+    int64_t value;
+    if (is_integer(col_type) && is_integer(constant.GetReturnValueType())) {
+        value = constant.Peek<int64_t>();
+    } else if (col_type == sql::SqlTypeId::Date && constant.GetReturnValueType() == sql::SqlTypeId::Date) {
+        value = constant.Peek<sql::Date>().ToNative();
+    } else if (col_type == sql::SqlTypeId::Timestamp
+               && constant.GetReturnValueType() == sql::SqlTypeId::Timestamp) {
+        value = static_cast<int64_t>(constant.Peek<sql::Timestamp>().ToNative());
+    } else {
+        return false;
+    }
+
+    *min = std::numeric_limits<int64_t>::min();
+    *max = std::numeric_limits<int64_t>::max();
+    switch (term.GetExpressionType()) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+        *min = *max = value;
+        return true;
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+        // Nothing is smaller than the smallest value, and subtracting from it would overflow
+        if (value == std::numeric_limits<int64_t>::min()) {
+            return false;
+        }
+        *max = value - 1;
+        return true;
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+        *max = value;
+        return true;
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+        if (value == std::numeric_limits<int64_t>::max()) {
+            return false;
+        }
+        *min = value + 1;
+        return true;
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+        *min = value;
+        return true;
+    default:
+        return false;
+    }
+}
+
+void SeqScanTranslator::AddBlockFilters(FunctionBuilder                                   *function,
+                                        common::ManagedPointer<parser::AbstractExpression> predicate) const {
+    // Every term of a conjunction has to hold, so each of them can rule out blocks on its own
+    if (predicate->GetExpressionType() == parser::ExpressionType::CONJUNCTION_AND) {
+        for (const auto &child : predicate->GetChildren()) {
+            AddBlockFilters(function, child);
+        }
+        return;
+    }
+    if (!parser::ExpressionUtil::IsColumnCompareWithConst(*predicate)) {
+        return;
+    }
+
+    auto       *codegen = GetCodeGen();
+    const auto  col_oid = predicate->GetChild(0).CastTo<parser::ColumnValueExpression>()->GetColumnOid();
+    const auto &schema = codegen->GetCatalogAccessor()->GetSchema(GetTableOid());
+    int64_t     min, max;
+    if (GetBlockFilterRange(*predicate, schema.GetColumn(col_oid).Type(), &min, &max)) {
+        // @tableIterAddBlockFilter(tvi, col_oid, min, max)
+        function->Append(codegen->TableIterAddBlockFilter(codegen->MakeExpr(tvi_var_), col_oid, min, max));
+    }
+}
+
 void SeqScanTranslator::ScanVPI(WorkContext *ctx, FunctionBuilder *function, ast::Expr *vpi) const {
     auto *codegen = GetCodeGen();
 
@@ -337,6 +417,11 @@ void SeqScanTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilde
         function->Append(codegen->Assign(tvi_needs_free_.Get(codegen), codegen->ConstBool(true)));
     }
 
+    // Let the iterator skip blocks that the predicate rules out by their zone maps
+    if (HasPredicate() && !catalog::IsTempOid(GetTableOid())) {
+        AddBlockFilters(function, GetPlanAs<planner::SeqScanPlanNode>().GetScanPredicate());
+    }
+
     auto declare_slot = codegen->DeclareVarNoInit(slot_var_, ast::BuiltinType::TupleSlot);
     function->Append(declare_slot);
 
@@ -93,6 +93,24 @@ void SortTranslator::GenerateComparisonFunction(FunctionBuilder *function) {
         } else {
             ret_value = 1;
         }
+        // NULLs compare neither less nor greater than any value. They go after all values in ascending order and before
+        // them in descending order, as in Postgres, so that rows with equal keys stay next to each other.
+        const auto &sort_key = *expr;
+        const auto  is_null = [&](CurrentRow row, bool expected) {
+            current_row_ = row;
+            ast::Expr *result = codegen->CallBuiltin(ast::Builtin::IsValNull, {context.DeriveValue(sort_key, this)});
+            return expected ? result : codegen->UnaryOp(parsing::Token::Type::BANG, result);
+        };
+        for (const bool lhs_null : {true, false}) {
+            If check_nulls(function,
+                           codegen->BinaryOp(parsing::Token::Type::AND,
+                                             is_null(CurrentRow::Lhs, lhs_null),
+                                             is_null(CurrentRow::Rhs, !lhs_null)));
+            {
+                function->Append(codegen->Return(codegen->Const32(lhs_null ? -ret_value : ret_value)));
+            }
+            check_nulls.EndIf();
+        }
         for (const auto tok : {parsing::Token::Type::LESS, parsing::Token::Type::GREATER}) {
             current_row_ = CurrentRow::Lhs;
             ast::Expr *lhs = context.DeriveValue(*expr, this);
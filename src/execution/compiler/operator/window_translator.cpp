@@ -0,0 +1,583 @@
+#include "execution/compiler/operator/window_translator.h"
+
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "execution/compiler/compilation_context.h"
+#include "execution/compiler/function_builder.h"
+#include "execution/compiler/if.h"
+#include "execution/compiler/loop.h"
+#include "execution/compiler/work_context.h"
+#include "parser/expression/window_expression.h"
+#include "planner/plannodes/output_schema.h"
+#include "planner/plannodes/window_plan_node.h"
+
+namespace noisepage::execution::compiler {
+
+namespace {
+    constexpr const char WINDOW_ROW_ATTR_PREFIX[] = "attr";
+
+    // The sort keys of a window are its PARTITION BY, followed by its ORDER BY.
+    auto GetSortKey(const parser::WindowExpression &window, size_t key_idx)
+        -> common::ManagedPointer<parser::AbstractExpression> {
+        if (key_idx < window.GetNumPartitionBy()) {
+            return window.GetPartitionBy(key_idx);
+        }
+        return window.GetOrderBy(key_idx - window.GetNumPartitionBy());
+    }
+
+    // The aggregate computing a window aggregate over its frame.
+    auto GetAggregateType(parser::ExpressionType window_type) -> parser::ExpressionType {
+        switch (window_type) {
+        case parser::ExpressionType::WINDOW_COUNT:
+            return parser::ExpressionType::AGGREGATE_COUNT;
+        case parser::ExpressionType::WINDOW_SUM:
+            return parser::ExpressionType::AGGREGATE_SUM;
+        case parser::ExpressionType::WINDOW_MIN:
+            return parser::ExpressionType::AGGREGATE_MIN;
+        case parser::ExpressionType::WINDOW_MAX:
+            return parser::ExpressionType::AGGREGATE_MAX;
+        case parser::ExpressionType::WINDOW_AVG:
+            return parser::ExpressionType::AGGREGATE_AVG;
+        default:
+            UNREACHABLE("Not a window aggregate");
+        }
+    }
+} // namespace
+
+WindowTranslator::WindowTranslator(const planner::WindowPlanNode &plan,
+                                   CompilationContext            *compilation_context,
+                                   Pipeline                      *pipeline)
+    : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::DUMMY)
+    , window_row_var_(GetCodeGen()->MakeFreshIdentifier("windowRow"))
+    , frame_row_var_(GetCodeGen()->MakeFreshIdentifier("frameRow"))
+    , window_row_type_(GetCodeGen()->MakeFreshIdentifier("WindowRow"))
+    , lhs_row_(GetCodeGen()->MakeIdentifier("lhs"))
+    , rhs_row_(GetCodeGen()->MakeIdentifier("rhs"))
+    , compare_func_(GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("Compare")))
+    , find_partition_end_func_(
+          GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("FindPartitionEnd")))
+    , find_peer_end_func_(GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("FindPeerEnd")))
+    , row_idx_(GetCodeGen()->MakeFreshIdentifier("rowIdx"))
+    , partition_start_(GetCodeGen()->MakeFreshIdentifier("partitionStart"))
+    , partition_end_(GetCodeGen()->MakeFreshIdentifier("partitionEnd"))
+    , peer_start_(GetCodeGen()->MakeFreshIdentifier("peerStart"))
+    , peer_end_(GetCodeGen()->MakeFreshIdentifier("peerEnd"))
+    , dense_rank_(GetCodeGen()->MakeFreshIdentifier("denseRank"))
+    , build_pipeline_(this, Pipeline::Parallelism::Parallel)
+    , current_row_(CurrentRow::Child) {
+    NOISEPAGE_ASSERT(plan.GetChildrenSize() == 1, "Windows expected to have a single child.");
+    NOISEPAGE_ASSERT(!plan.GetWindowTerms().empty(), "Windows expected to have at least one window term.");
+    // Register this as the source for the pipeline. It must be serial to scan the partitions in sorted order.
+    pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
+
+    // The build pipeline must complete before the produce pipeline.
+    pipeline->LinkSourcePipeline(&build_pipeline_);
+
+    // Prepare the child.
+    compilation_context->Prepare(*plan.GetChild(0), &build_pipeline_);
+
+    // Prepare the arguments and the sort keys of the window terms. The window terms themselves are computed here.
+    CodeGen *codegen = compilation_context->GetCodeGen();
+    for (const auto &term : plan.GetWindowTerms()) {
+        for (const auto &child : term->GetChildren()) {
+            compilation_context->Prepare(*child);
+        }
+        window_values_.push_back(codegen->MakeFreshIdentifier("windowValue"));
+        window_aggs_.push_back(codegen->MakeFreshIdentifier("windowAgg"));
+        window_agg_ends_.push_back(codegen->MakeFreshIdentifier("windowAggEnd"));
+    }
+
+    // Register a Sorter instance in the global query state.
+    ast::Expr *sorter_type = codegen->BuiltinType(ast::BuiltinType::Sorter);
+    global_sorter_ = compilation_context->GetQueryState()->DeclareStateEntry(codegen, "sorter", sorter_type);
+
+    // Register another Sorter instance in the pipeline-local state if the build pipeline is parallel.
+    if (build_pipeline_.IsParallel()) {
+        local_sorter_ = build_pipeline_.DeclarePipelineStateEntry("sorter", sorter_type);
+    }
+}
+
+auto WindowTranslator::GetWindow() const -> const parser::WindowExpression & {
+    // All the window terms of a plan have the same window
+    return *GetPlanAs<planner::WindowPlanNode>().GetWindowTerms()[0];
+}
+
+auto WindowTranslator::IsIncrementalAggregate(const parser::WindowExpression &term) -> bool {
+    return !term.IsRankingFunction() && term.GetFrame().start_ == parser::WindowFrameBoundType::UNBOUNDED_PRECEDING;
+}
+
+void WindowTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) {
+    auto *codegen = GetCodeGen();
+    auto  fields = codegen->MakeEmptyFieldList();
+    GetAllChildOutputFields(0, WINDOW_ROW_ATTR_PREFIX, &fields);
+    decls->push_back(codegen->DeclareStruct(window_row_type_, std::move(fields)));
+}
+
+void WindowTranslator::GenerateComparisonFunction(FunctionBuilder *function) {
+    auto       *codegen = GetCodeGen();
+    const auto &window = GetWindow();
+    WorkContext context(GetCompilationContext(), build_pipeline_);
+    context.SetExpressionCacheEnable(false);
+    const auto num_keys = window.GetNumPartitionBy() + window.GetNumOrderBy();
+    for (size_t key_idx = 0; key_idx < num_keys; key_idx++) {
+        // Partitions may be in any order, so they are sorted ascending
+        const bool is_desc = key_idx >= window.GetNumPartitionBy()
+                          && window.GetOrderByType(key_idx - window.GetNumPartitionBy()) == parser::kOrderDesc;
+        int32_t    ret_value = is_desc ? 1 : -1;
+        const auto key = GetSortKey(window, key_idx);
+        // NULLs go after all values in ascending order and before them in descending order, as in the sort translator
+        for (const bool lhs_null : {true, false}) {
+            If check_nulls(function, KeyIsNullInOneRow(&context, *key, lhs_null));
+            {
+                function->Append(codegen->Return(codegen->Const32(lhs_null ? -ret_value : ret_value)));
+            }
+            check_nulls.EndIf();
+        }
+        for (const auto tok : {parsing::Token::Type::LESS, parsing::Token::Type::GREATER}) {
+            current_row_ = CurrentRow::Lhs;
+            ast::Expr *lhs = context.DeriveValue(*key, this);
+            current_row_ = CurrentRow::Rhs;
+            ast::Expr *rhs = context.DeriveValue(*key, this);
+            If         check_comparison(function, codegen->Compare(tok, lhs, rhs));
+            {
+                // Return the appropriate value based on ordering.
+                function->Append(codegen->Return(codegen->Const32(ret_value)));
+            }
+            check_comparison.EndIf();
+            ret_value = -ret_value;
+        }
+    }
+    current_row_ = CurrentRow::Child;
+}
+
+auto WindowTranslator::KeyIsNullInOneRow(WorkContext                      *context,
+                                         const parser::AbstractExpression &key,
+                                         const bool                        lhs_null) -> ast::Expr * {
+    auto      *codegen = GetCodeGen();
+    const auto is_null = [&](CurrentRow row, bool expected) {
+        current_row_ = row;
+        ast::Expr *result = codegen->CallBuiltin(ast::Builtin::IsValNull, {context->DeriveValue(key, this)});
+        return expected ? result : codegen->UnaryOp(parsing::Token::Type::BANG, result);
+    };
+    ast::Expr *lhs = is_null(CurrentRow::Lhs, lhs_null);
+    ast::Expr *rhs = is_null(CurrentRow::Rhs, !lhs_null);
+    current_row_ = CurrentRow::Child;
+    return codegen->BinaryOp(parsing::Token::Type::AND, lhs, rhs);
+}
+
+auto WindowTranslator::GenerateFindEndFunction(ast::Identifier name, bool include_order_by) -> ast::FunctionDecl * {
+    auto           *codegen = GetCodeGen();
+    const auto     &window = GetWindow();
+    ast::Identifier sorter = codegen->MakeIdentifier("sorter");
+    ast::Identifier start = codegen->MakeIdentifier("start");
+    ast::Identifier end = codegen->MakeIdentifier("end");
+    auto            params = codegen->MakeFieldList({
+        codegen->MakeField(sorter, codegen->PointerType(ast::BuiltinType::Sorter)),
+        codegen->MakeField(start, codegen->BuiltinType(ast::BuiltinType::Uint32)),
+        codegen->MakeField(end, codegen->BuiltinType(ast::BuiltinType::Uint32)),
+    });
+    FunctionBuilder builder(codegen, name, std::move(params), codegen->BuiltinType(ast::BuiltinType::Uint32));
+    const auto      num_keys = window.GetNumPartitionBy() + (include_order_by ? window.GetNumOrderBy() : 0);
+    if (num_keys != 0) {
+        // var lhs = @ptrCast(*WindowRow, @sorterGetTupleAt(sorter, start))
+        auto lhs_row = codegen->SorterGetTupleAt(codegen->MakeExpr(sorter), codegen->MakeExpr(start), window_row_type_);
+        builder.Append(codegen->DeclareVarWithInit(lhs_row_, lhs_row));
+
+        // for (var idx = start + 1; idx < end; idx = idx + 1)
+        ast::Identifier idx = codegen->MakeIdentifier("idx");
+        builder.Append(codegen->DeclareVarWithInit(
+            idx, codegen->BinaryOp(parsing::Token::Type::PLUS, codegen->MakeExpr(start), codegen->ConstU32(1))));
+        Loop loop(&builder,
+                  nullptr,
+                  codegen->Compare(parsing::Token::Type::LESS, codegen->MakeExpr(idx), codegen->MakeExpr(end)),
+                  codegen->Assign(codegen->MakeExpr(idx),
+                                  codegen->BinaryOp(
+                                      parsing::Token::Type::PLUS, codegen->MakeExpr(idx), codegen->ConstU32(1))));
+        {
+            auto rhs_row
+                = codegen->SorterGetTupleAt(codegen->MakeExpr(sorter), codegen->MakeExpr(idx), window_row_type_);
+            builder.Append(codegen->DeclareVarWithInit(rhs_row_, rhs_row));
+            WorkContext context(GetCompilationContext(), build_pipeline_);
+            context.SetExpressionCacheEnable(false);
+            for (size_t key_idx = 0; key_idx < num_keys; key_idx++) {
+                const auto key = GetSortKey(window, key_idx);
+                // A NULL key differs from every value. Two NULL keys are equal, which the comparison below yields, as
+                // a comparison with NULL is never true.
+                If check_nulls(&builder,
+                               codegen->BinaryOp(parsing::Token::Type::OR,
+                                                 KeyIsNullInOneRow(&context, *key, true),
+                                                 KeyIsNullInOneRow(&context, *key, false)));
+                {
+                    builder.Append(codegen->Return(codegen->MakeExpr(idx)));
+                }
+                check_nulls.EndIf();
+                current_row_ = CurrentRow::Lhs;
+                ast::Expr *lhs = context.DeriveValue(*key, this);
+                current_row_ = CurrentRow::Rhs;
+                ast::Expr *rhs = context.DeriveValue(*key, this);
+                If         check_difference(&builder, codegen->Compare(parsing::Token::Type::BANG_EQUAL, lhs, rhs));
+                {
+                    builder.Append(codegen->Return(codegen->MakeExpr(idx)));
+                }
+                check_difference.EndIf();
+            }
+            current_row_ = CurrentRow::Child;
+        }
+        loop.EndLoop();
+    }
+    return builder.Finish(codegen->MakeExpr(end));
+}
+
+void WindowTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) {
+    auto           *codegen = GetCodeGen();
+    auto            params = codegen->MakeFieldList({
+        codegen->MakeField(lhs_row_, codegen->PointerType(window_row_type_)),
+        codegen->MakeField(rhs_row_, codegen->PointerType(window_row_type_)),
+    });
+    FunctionBuilder builder(codegen, compare_func_, std::move(params), codegen->Int32Type());
+    {
+        // Generate body.
+        GenerateComparisonFunction(&builder);
+    }
+    decls->push_back(builder.Finish(codegen->Const32(0)));
+    decls->push_back(GenerateFindEndFunction(find_partition_end_func_, false));
+    decls->push_back(GenerateFindEndFunction(find_peer_end_func_, true));
+}
+
+void WindowTranslator::InitializeQueryState(FunctionBuilder *function) const {
+    auto *codegen = GetCodeGen();
+    function->Append(
+        codegen->SorterInit(global_sorter_.GetPtr(codegen), GetExecutionContext(), compare_func_, window_row_type_));
+}
+
+void WindowTranslator::TearDownQueryState(FunctionBuilder *function) const {
+    function->Append(GetCodeGen()->SorterFree(global_sorter_.GetPtr(GetCodeGen())));
+}
+
+void WindowTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+    if (IsBuildPipeline(pipeline) && build_pipeline_.IsParallel()) {
+        auto *codegen = GetCodeGen();
+        function->Append(
+            codegen->SorterInit(local_sorter_.GetPtr(codegen), GetExecutionContext(), compare_func_, window_row_type_));
+    }
+}
+
+void WindowTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+    if (IsBuildPipeline(pipeline) && pipeline.IsParallel()) {
+        function->Append(GetCodeGen()->SorterFree(local_sorter_.GetPtr(GetCodeGen())));
+    }
+}
+
+auto WindowTranslator::GetWindowRowAttribute(ast::Identifier window_row, uint32_t attr_idx) const -> ast::Expr * {
+    auto           *codegen = GetCodeGen();
+    ast::Identifier attr_name = codegen->MakeIdentifier(WINDOW_ROW_ATTR_PREFIX + std::to_string(attr_idx));
+    return codegen->AccessStructMember(codegen->MakeExpr(window_row), attr_name);
+}
+
+void WindowTranslator::InsertIntoSorter(WorkContext *ctx, FunctionBuilder *function) const {
+    auto *codegen = GetCodeGen();
+
+    // Collect correct sorter instance.
+    const auto sorter = ctx->GetPipeline().IsParallel() ? local_sorter_ : global_sorter_;
+    ast::Expr *insert_call = codegen->SorterInsert(sorter.GetPtr(codegen), window_row_type_);
+    function->Append(codegen->DeclareVarWithInit(window_row_var_, insert_call));
+
+    const auto child_schema = GetPlan().GetChild(0)->GetOutputSchema();
+    for (uint32_t attr_idx = 0; attr_idx < child_schema->GetColumns().size(); attr_idx++) {
+        ast::Expr *lhs = GetWindowRowAttribute(window_row_var_, attr_idx);
+        ast::Expr *rhs = GetChildOutput(ctx, 0, attr_idx);
+        function->Append(codegen->Assign(lhs, rhs));
+    }
+}
+
+void WindowTranslator::AdvanceWindowAggregate(FunctionBuilder *function,
+                                              ast::Expr       *sorter_ptr,
+                                              uint32_t         term_idx,
+                                              ast::Identifier  idx,
+                                              ast::Expr       *end) const {
+    auto       *codegen = GetCodeGen();
+    const auto &term = *GetPlanAs<planner::WindowPlanNode>().GetWindowTerms()[term_idx];
+
+    // for (; idx < end; idx = idx + 1)
+    Loop loop(function,
+              nullptr,
+              codegen->Compare(parsing::Token::Type::LESS, codegen->MakeExpr(idx), end),
+              codegen->Assign(
+                  codegen->MakeExpr(idx),
+                  codegen->BinaryOp(parsing::Token::Type::PLUS, codegen->MakeExpr(idx), codegen->ConstU32(1))));
+    {
+        // var frameRow = @ptrCast(*WindowRow, @sorterGetTupleAt(sorter, idx))
+        auto frame_row = codegen->SorterGetTupleAt(sorter_ptr, codegen->MakeExpr(idx), window_row_type_);
+        function->Append(codegen->DeclareVarWithInit(frame_row_var_, frame_row));
+
+        // The argument is evaluated on the row of the frame, rather than on the row being computed
+        WorkContext context(GetCompilationContext(), *GetPipeline());
+        context.SetExpressionCacheEnable(false);
+        current_row_ = CurrentRow::Frame;
+        auto frame_value = codegen->MakeFreshIdentifier("frameValue");
+        function->Append(codegen->DeclareVarWithInit(frame_value, context.DeriveValue(*term.GetArg(0), this)));
+        current_row_ = CurrentRow::Child;
+
+        function->Append(codegen->AggregatorAdvance(codegen->AddressOf(codegen->MakeExpr(window_aggs_[term_idx])),
+                                                    codegen->AddressOf(codegen->MakeExpr(frame_value))));
+    }
+    loop.EndLoop();
+}
+
+void WindowTranslator::ComputeWindowAggregate(FunctionBuilder *function,
+                                              ast::Expr       *sorter_ptr,
+                                              uint32_t         term_idx) const {
+    auto       *codegen = GetCodeGen();
+    const auto &term = *GetPlanAs<planner::WindowPlanNode>().GetWindowTerms()[term_idx];
+    const auto &frame = term.GetFrame();
+
+    // Declare the bound of the frame, in [partitionStart, partitionEnd]. The end of the frame is exclusive. Offsets are
+    // relative to the current row, and CURRENT ROW includes all of its peers in RANGE mode.
+    const auto declare_bound = [&](parser::WindowFrameBoundType bound, int64_t offset, bool is_end) -> ast::Identifier {
+        NOISEPAGE_ASSERT(offset >= 0 && offset <= std::numeric_limits<int32_t>::max(),
+                         "The parser only allows non-negative integer offsets");
+        auto       bound_var = codegen->MakeFreshIdentifier(is_end ? "frameEnd" : "frameStart");
+        const auto offset_val = static_cast<uint32_t>(offset);
+        const auto row = [&]() -> ast::Expr * {
+            if (!is_end) {
+                return codegen->MakeExpr(row_idx_);
+            }
+            return codegen->BinaryOp(parsing::Token::Type::PLUS, codegen->MakeExpr(row_idx_), codegen->ConstU32(1));
+        };
+        ast::Expr *init;
+        switch (bound) {
+        case parser::WindowFrameBoundType::UNBOUNDED_PRECEDING:
+            init = codegen->MakeExpr(partition_start_);
+            break;
+        case parser::WindowFrameBoundType::UNBOUNDED_FOLLOWING:
+            init = codegen->MakeExpr(partition_end_);
+            break;
+        case parser::WindowFrameBoundType::CURRENT_ROW:
+            if (frame.type_ == parser::WindowFrameType::RANGE) {
+                init = codegen->MakeExpr(is_end ? peer_end_ : peer_start_);
+            } else {
+                init = row();
+            }
+            break;
+        case parser::WindowFrameBoundType::PRECEDING: {
+            // var bound = partitionStart; if (row - partitionStart >= offset) { bound = row - offset }
+            // The row is never before partitionStart, so nothing can overflow.
+            init = codegen->MakeExpr(partition_start_);
+            function->Append(codegen->DeclareVar(bound_var, codegen->BuiltinType(ast::BuiltinType::Uint32), init));
+            auto rows_before
+                = codegen->BinaryOp(parsing::Token::Type::MINUS, row(), codegen->MakeExpr(partition_start_));
+            If in_partition(
+                function,
+                codegen->Compare(parsing::Token::Type::GREATER_EQUAL, rows_before, codegen->ConstU32(offset_val)));
+            {
+                auto value = codegen->BinaryOp(parsing::Token::Type::MINUS, row(), codegen->ConstU32(offset_val));
+                function->Append(codegen->Assign(codegen->MakeExpr(bound_var), value));
+            }
+            in_partition.EndIf();
+            return bound_var;
+        }
+        case parser::WindowFrameBoundType::FOLLOWING: {
+            // var bound = partitionEnd; if (partitionEnd - row > offset) { bound = row + offset }
+            // The row is never after partitionEnd, so nothing can overflow.
+            init = codegen->MakeExpr(partition_end_);
+            function->Append(codegen->DeclareVar(bound_var, codegen->BuiltinType(ast::BuiltinType::Uint32), init));
+            auto rows_after = codegen->BinaryOp(parsing::Token::Type::MINUS, codegen->MakeExpr(partition_end_), row());
+            If   in_partition(function,
+                            codegen->Compare(parsing::Token::Type::GREATER, rows_after, codegen->ConstU32(offset_val)));
+            {
+                auto value = codegen->BinaryOp(parsing::Token::Type::PLUS, row(), codegen->ConstU32(offset_val));
+                function->Append(codegen->Assign(codegen->MakeExpr(bound_var), value));
+            }
+            in_partition.EndIf();
+            return bound_var;
+        }
+        }
+        function->Append(codegen->DeclareVar(bound_var, codegen->BuiltinType(ast::BuiltinType::Uint32), init));
+        return bound_var;
+    };
+
+    const auto frame_end = declare_bound(frame.end_, frame.end_offset_, true);
+    if (IsIncrementalAggregate(term)) {
+        // The frame only grows within a partition, so advance the aggregate with the rows that entered the frame
+        AdvanceWindowAggregate(
+            function, sorter_ptr, term_idx, window_agg_ends_[term_idx], codegen->MakeExpr(frame_end));
+    } else {
+        const auto frame_start = declare_bound(frame.start_, frame.start_offset_, false);
+        function->Append(codegen->AggregatorInit(codegen->AddressOf(codegen->MakeExpr(window_aggs_[term_idx]))));
+        AdvanceWindowAggregate(function, sorter_ptr, term_idx, frame_start, codegen->MakeExpr(frame_end));
+    }
+
+    // var windowValue = @aggResult(&windowAgg)
+    auto result = codegen->AggregatorResult(GetExecutionContext(),
+                                            codegen->AddressOf(codegen->MakeExpr(window_aggs_[term_idx])),
+                                            GetAggregateType(term.GetExpressionType()));
+    function->Append(codegen->DeclareVarWithInit(window_values_[term_idx], result));
+}
+
+void WindowTranslator::ScanSorter(WorkContext *ctx, FunctionBuilder *function) const {
+    auto       *codegen = GetCodeGen();
+    const auto &terms = GetPlanAs<planner::WindowPlanNode>().GetWindowTerms();
+    ast::Expr  *sorter_ptr = global_sorter_.GetPtr(codegen);
+    const auto  uint32_var = [codegen](ast::Identifier name, ast::Expr *init) {
+        return codegen->DeclareVar(name, codegen->BuiltinType(ast::BuiltinType::Uint32), init);
+    };
+
+    // var numRows = @sorterGetTupleCount(&state.sorter)
+    auto num_rows = codegen->MakeFreshIdentifier("numRows");
+    function->Append(codegen->DeclareVarWithInit(num_rows, codegen->CallBuiltin(ast::Builtin::SorterGetTupleCount,
+                                                                                {sorter_ptr})));
+
+    // The bounds of the current partition and peers. Both are empty before the first row, which starts new ones.
+    for (const auto &var : {partition_start_, partition_end_, peer_start_, peer_end_, dense_rank_, row_idx_}) {
+        function->Append(uint32_var(var, codegen->ConstU32(0)));
+    }
+
+    // The aggregates of the window terms are kept across rows, so that they can be computed incrementally.
+    for (uint32_t term_idx = 0; term_idx < terms.size(); term_idx++) {
+        const auto &term = *terms[term_idx];
+        if (term.IsRankingFunction()) {
+            continue;
+        }
+        const auto arg_type = term.GetArg(0)->GetReturnValueType();
+        auto       agg_type = codegen->AggregateType(GetAggregateType(term.GetExpressionType()),
+                                               sql::GetTypeId(term.GetReturnValueType()),
+                                               sql::GetTypeId(arg_type));
+        function->Append(codegen->DeclareVarNoInit(window_aggs_[term_idx], agg_type));
+        if (IsIncrementalAggregate(term)) {
+            function->Append(uint32_var(window_agg_ends_[term_idx], codegen->ConstU32(0)));
+        }
+    }
+
+    // for (; rowIdx < numRows; rowIdx = rowIdx + 1)
+    Loop loop(function,
+              nullptr,
+              codegen->Compare(parsing::Token::Type::LESS, codegen->MakeExpr(row_idx_), codegen->MakeExpr(num_rows)),
+              codegen->Assign(
+                  codegen->MakeExpr(row_idx_),
+                  codegen->BinaryOp(parsing::Token::Type::PLUS, codegen->MakeExpr(row_idx_), codegen->ConstU32(1))));
+    {
+        // var windowRow = @ptrCast(*WindowRow, @sorterGetTupleAt(&state.sorter, rowIdx))
+        auto row = codegen->SorterGetTupleAt(sorter_ptr, codegen->MakeExpr(row_idx_), window_row_type_);
+        function->Append(codegen->DeclareVarWithInit(window_row_var_, row));
+
+        // Start a new partition, and reset the aggregates over it.
+        If new_partition(function,
+                         codegen->Compare(parsing::Token::Type::EQUAL_EQUAL,
+                                          codegen->MakeExpr(row_idx_),
+                                          codegen->MakeExpr(partition_end_)));
+        {
+            function->Append(codegen->Assign(codegen->MakeExpr(partition_start_), codegen->MakeExpr(row_idx_)));
+            auto partition_end = codegen->Call(find_partition_end_func_,
+                                               {sorter_ptr, codegen->MakeExpr(row_idx_), codegen->MakeExpr(num_rows)});
+            function->Append(codegen->Assign(codegen->MakeExpr(partition_end_), partition_end));
+            function->Append(codegen->Assign(codegen->MakeExpr(dense_rank_), codegen->ConstU32(0)));
+            for (uint32_t term_idx = 0; term_idx < terms.size(); term_idx++) {
+                if (IsIncrementalAggregate(*terms[term_idx])) {
+                    auto agg = codegen->AddressOf(codegen->MakeExpr(window_aggs_[term_idx]));
+                    function->Append(codegen->AggregatorInit(agg));
+                    function->Append(
+                        codegen->Assign(codegen->MakeExpr(window_agg_ends_[term_idx]), codegen->MakeExpr(row_idx_)));
+                }
+            }
+        }
+        new_partition.EndIf();
+
+        // Start a new group of peers. The peers never span partitions, so a new partition also starts new peers.
+        If new_peers(function,
+                     codegen->Compare(
+                         parsing::Token::Type::EQUAL_EQUAL, codegen->MakeExpr(row_idx_), codegen->MakeExpr(peer_end_)));
+        {
+            function->Append(codegen->Assign(codegen->MakeExpr(peer_start_), codegen->MakeExpr(row_idx_)));
+            auto peer_end = codegen->Call(find_peer_end_func_,
+                                          {sorter_ptr, codegen->MakeExpr(row_idx_), codegen->MakeExpr(partition_end_)});
+            function->Append(codegen->Assign(codegen->MakeExpr(peer_end_), peer_end));
+            function->Append(codegen->Assign(
+                codegen->MakeExpr(dense_rank_),
+                codegen->BinaryOp(parsing::Token::Type::PLUS, codegen->MakeExpr(dense_rank_), codegen->ConstU32(1))));
+        }
+        new_peers.EndIf();
+
+        // Compute the window terms of the row.
+        for (uint32_t term_idx = 0; term_idx < terms.size(); term_idx++) {
+            const auto rank = [&](ast::Identifier from) {
+                // from - partitionStart + 1
+                auto offset = codegen->BinaryOp(
+                    parsing::Token::Type::MINUS, codegen->MakeExpr(from), codegen->MakeExpr(partition_start_));
+                return codegen->BinaryOp(parsing::Token::Type::PLUS, offset, codegen->ConstU32(1));
+            };
+            ast::Expr *value;
+            switch (terms[term_idx]->GetExpressionType()) {
+            case parser::ExpressionType::WINDOW_ROW_NUMBER:
+                value = rank(row_idx_);
+                break;
+            case parser::ExpressionType::WINDOW_RANK:
+                value = rank(peer_start_);
+                break;
+            case parser::ExpressionType::WINDOW_DENSE_RANK:
+                value = codegen->MakeExpr(dense_rank_);
+                break;
+            default:
+                ComputeWindowAggregate(function, sorter_ptr, term_idx);
+                continue;
+            }
+            auto sql_value = codegen->CallBuiltin(ast::Builtin::IntToSql, {value});
+            function->Append(codegen->DeclareVarWithInit(window_values_[term_idx], sql_value));
+        }
+
+        // Move along
+        ctx->Push(function);
+    }
+    loop.EndLoop();
+}
+
+void WindowTranslator::PerformPipelineWork(WorkContext *ctx, FunctionBuilder *function) const {
+    if (IsScanPipeline(ctx->GetPipeline())) {
+        ScanSorter(ctx, function);
+    } else {
+        NOISEPAGE_ASSERT(IsBuildPipeline(ctx->GetPipeline()), "Pipeline is unknown to window translator");
+        InsertIntoSorter(ctx, function);
+    }
+}
+
+void WindowTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+    if (!IsBuildPipeline(pipeline)) {
+        return;
+    }
+    auto      *codegen = GetCodeGen();
+    ast::Expr *sorter_ptr = global_sorter_.GetPtr(codegen);
+    if (build_pipeline_.IsParallel()) {
+        ast::Expr *offset = local_sorter_.OffsetFromState(codegen);
+        function->Append(codegen->SortParallel(sorter_ptr, GetThreadStateContainer(), offset));
+    } else {
+        function->Append(codegen->SorterSort(sorter_ptr));
+    }
+}
+
+auto WindowTranslator::GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const
+    -> ast::Expr * {
+    if (child_idx == 1) {
+        NOISEPAGE_ASSERT(IsScanPipeline(context->GetPipeline()), "Window terms are only computed in the scan pipeline");
+        return GetCodeGen()->MakeExpr(window_values_[attr_idx]);
+    }
+
+    switch (current_row_) {
+    case CurrentRow::Lhs:
+        return GetWindowRowAttribute(lhs_row_, attr_idx);
+    case CurrentRow::Rhs:
+        return GetWindowRowAttribute(rhs_row_, attr_idx);
+    case CurrentRow::Frame:
+        return GetWindowRowAttribute(frame_row_var_, attr_idx);
+    case CurrentRow::Child: {
+        if (IsScanPipeline(context->GetPipeline())) {
+            return GetWindowRowAttribute(window_row_var_, attr_idx);
+        }
+        NOISEPAGE_ASSERT(IsBuildPipeline(context->GetPipeline()), "Pipeline not known to window");
+        return OperatorTranslator::GetChildOutput(context, child_idx, attr_idx);
+    }
+    }
+    UNREACHABLE("Impossible output row option");
+}
+
+} // namespace noisepage::execution::compiler
@@ -417,6 +417,24 @@ void Sema::CheckBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builti
         call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
         break;
     }
+    case ast::Builtin::AggHashTableMergeOverflowPartitions: {
+        if (!CheckArgCount(call, 3)) {
+            return;
+        }
+        // Second argument is an opaque query state pointer
+        if (!args[1]->GetType()->IsPointerType()) {
+            ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+            return;
+        }
+        // Third argument is the merging function
+        if (!args[2]->GetType()->IsFunctionType()) {
+            ReportIncorrectCallArg(call, 2, GetBuiltinType(ast::BuiltinType::Nil));
+            return;
+        }
+
+        call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+        break;
+    }
     case ast::Builtin::AggHashTableParallelPartitionedScan: {
         if (!CheckArgCount(call, 4)) {
             return;
@@ -1322,6 +1340,34 @@ void Sema::CheckBuiltinTableIterCall(ast::CallExpr *call, ast::Builtin builtin)
         call->SetType(GetBuiltinType(vpi_kind)->PointerTo());
         break;
     }
+    case ast::Builtin::TableIterAddBlockFilter: {
+        if (!CheckArgCount(call, 4)) {
+            return;
+        }
+        // The second argument is a column oid
+        ast::Type *uint_type = GetBuiltinType(ast::BuiltinType::Uint32);
+        if (!call_args[1]->GetType()->IsIntegerType()) {
+            ReportIncorrectCallArg(call, 1, uint_type);
+            return;
+        }
+        if (call_args[1]->GetType() != uint_type) {
+            call->SetArgument(1, ImplCastExprToType(call_args[1], uint_type, ast::CastKind::IntegralCast));
+        }
+        // The third and fourth arguments are the bounds of the range
+        ast::Type *int64_type = GetBuiltinType(ast::BuiltinType::Int64);
+        for (uint32_t arg_idx = 2; arg_idx < 4; arg_idx++) {
+            if (!call_args[arg_idx]->GetType()->IsIntegerType()) {
+                ReportIncorrectCallArg(call, arg_idx, int64_type);
+                return;
+            }
+            if (call_args[arg_idx]->GetType() != int64_type) {
+                call->SetArgument(arg_idx,
+                                  ImplCastExprToType(call_args[arg_idx], int64_type, ast::CastKind::IntegralCast));
+            }
+        }
+        call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+        break;
+    }
     case ast::Builtin::TableIterClose: {
         // A single-arg builtin returning void
         call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
@@ -2193,6 +2239,30 @@ void Sema::CheckBuiltinSorterGetTupleCount(ast::CallExpr *call) {
     call->SetType(GetBuiltinType(ast::BuiltinType::Uint32));
 }
 
+void Sema::CheckBuiltinSorterGetTupleAt(ast::CallExpr *call) {
+    if (!CheckArgCount(call, 2)) {
+        return;
+    }
+
+    const auto &args = call->Arguments();
+
+    // First argument must be a pointer to a Sorter
+    const auto sorter_kind = ast::BuiltinType::Sorter;
+    if (!IsPointerToSpecificBuiltin(args[0]->GetType(), sorter_kind)) {
+        ReportIncorrectCallArg(call, 0, GetBuiltinType(sorter_kind)->PointerTo());
+        return;
+    }
+
+    // Second argument is the index of the tuple
+    const auto uint_kind = ast::BuiltinType::Uint32;
+    if (!args[1]->GetType()->IsIntegerType()) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(uint_kind));
+        return;
+    }
+
+    call->SetType(GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+}
+
 void Sema::CheckBuiltinSorterInsert(ast::CallExpr *call, ast::Builtin builtin) {
     if (!CheckArgCountAtLeast(call, 1)) {
         return;
@@ -3063,7 +3133,8 @@ void Sema::CheckBuiltinStorageInterfaceCall(ast::CallExpr *call, ast::Builtin bu
         call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
         break;
     }
-    case ast::Builtin::IndexInsertUnique: {
+    case ast::Builtin::IndexInsertUnique:
+    case ast::Builtin::IndexBuildFinish: {
         if (!CheckArgCount(call, 1)) {
             return;
         }
@@ -3632,6 +3703,7 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::TableIterAdvance:
     case ast::Builtin::TableIterGetVPINumTuples:
     case ast::Builtin::TableIterGetVPI:
+    case ast::Builtin::TableIterAddBlockFilter:
     case ast::Builtin::TableIterClose: {
         CheckBuiltinTableIterCall(call, builtin);
         break;
@@ -3747,6 +3819,7 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::AggHashTableLookup:
     case ast::Builtin::AggHashTableProcessBatch:
     case ast::Builtin::AggHashTableMovePartitions:
+    case ast::Builtin::AggHashTableMergeOverflowPartitions:
     case ast::Builtin::AggHashTableParallelPartitionedScan:
     case ast::Builtin::AggHashTableFree: {
         CheckBuiltinAggHashTableCall(call, builtin);
@@ -3823,6 +3896,10 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
         CheckBuiltinSorterGetTupleCount(call);
         break;
     }
+    case ast::Builtin::SorterGetTupleAt: {
+        CheckBuiltinSorterGetTupleAt(call);
+        break;
+    }
     case ast::Builtin::SorterInsert:
     case ast::Builtin::SorterInsertTopK:
     case ast::Builtin::SorterInsertTopKFinish: {
@@ -3950,6 +4027,7 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::IndexInsert:
     case ast::Builtin::IndexInsertUnique:
     case ast::Builtin::IndexInsertWithSlot:
+    case ast::Builtin::IndexBuildFinish:
     case ast::Builtin::IndexDelete:
     case ast::Builtin::StorageInterfaceFree: {
         CheckBuiltinStorageInterfaceCall(call, builtin);
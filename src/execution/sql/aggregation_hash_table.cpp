@@ -172,7 +172,8 @@ AggregationHashTable::AggregationHashTable(const exec::ExecutionSettings &exec_s
     , partition_tails_(nullptr)
     , partition_estimates_(nullptr)
     , partition_tables_(nullptr)
-    , partition_shift_bits_(util::BitUtil::CountLeadingZeros(uint64_t(DEFAULT_NUM_PARTITIONS) - 1)) {
+    , partition_shift_bits_(util::BitUtil::CountLeadingZeros(uint64_t(DEFAULT_NUM_PARTITIONS) - 1))
+    , partitioned_mode_(false) {
     hash_table_.SetSize(initial_size, memory_->GetTracker());
     max_fill_ = std::llround(hash_table_.GetCapacity() * hash_table_.GetLoadFactor());
 
@@ -247,6 +248,19 @@ auto AggregationHashTable::AllocateEntryInternal(const hash_t hash) -> HashTable
 }
 
 auto AggregationHashTable::AllocInputTuple(const hash_t hash) -> byte * {
+    if (UNLIKELY(NeedsToSwitchToPartitionedMode())) {
+        SwitchToPartitionedMode();
+    }
+
+    // Once switched, insert like a thread-local table of a partitioned aggregation
+    if (UNLIKELY(partitioned_mode_)) {
+        return AllocInputTuplePartitioned(hash);
+    }
+
+    return AllocInputTupleInternal(hash);
+}
+
+auto AggregationHashTable::AllocInputTupleInternal(const hash_t hash) -> byte * {
     stats_.num_inserts_++;
 
     // Grow if need be
@@ -305,8 +319,78 @@ void AggregationHashTable::FlushToOverflowPartitions() {
     stats_.num_flushes_++;
 }
 
+void AggregationHashTable::SpillOverflowPartitions() {
+    NOISEPAGE_ASSERT(hash_table_.GetElementCount() == 0, "Cannot spill entries that are still in the main table");
+
+    if (spill_file_ == nullptr) {
+        spill_file_ = std::make_unique<SpillFile>(exec_settings_.GetSpillDirectory());
+    }
+
+    // Write out each partition contiguously, so that it can be linked back in
+    // without looking at the hash of its entries.
+    const std::size_t entry_size = entries_.ElementSize();
+    for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
+        uint64_t count = 0;
+        for (const HashTableEntry *entry = partition_heads_[part_idx]; entry != nullptr; entry = entry->next_) {
+            spill_file_->Append(reinterpret_cast<const byte *>(entry), entry_size);
+            count++;
+        }
+        if (count > 0) {
+            spilled_partitions_.emplace_back(part_idx, count);
+        }
+        partition_heads_[part_idx] = partition_tails_[part_idx] = nullptr;
+    }
+
+    EXECUTION_LOG_DEBUG("AHT: spilled {} overflow entries ({} bytes spilled)", entries_.size(), spill_file_->GetSize());
+
+    // All entries are in the overflow partitions, so release them
+    entries_ = decltype(entries_)(entry_size, MemoryPoolAllocator<byte>(memory_));
+
+    // Update stats
+    stats_.num_spills_++;
+}
+
+void AggregationHashTable::SwitchToPartitionedMode() {
+    // Growing re-inserts every entry, including the flushed ones, so the table
+    // must be flushed before it has to grow again.
+    flush_threshold_ = std::min(flush_threshold_, max_fill_);
+    FlushToOverflowPartitions();
+    partitioned_mode_ = true;
+
+    EXECUTION_LOG_DEBUG("AHT: switched to partitioned mode with {} entries over the memory budget", entries_.size());
+}
+
+void AggregationHashTable::LinkSpilledPartitions(AggregationHashTable *source) {
+    // The source's entries may have been moved out already, so don't ask them for
+    // the entry size.
+    const std::size_t entry_size = HashTableEntry::ComputeEntrySize(payload_size_);
+    byte             *spilled = source->spill_file_->Map();
+    for (const auto &[part_idx, count] : source->spilled_partitions_) {
+        // If the partition is only on disk, its estimate hasn't been merged yet.
+        if (source != this && source->partition_heads_[part_idx] == nullptr) {
+            partition_estimates_[part_idx]->Merge(source->partition_estimates_[part_idx]);
+        }
+        for (uint64_t i = 0; i < count; i++, spilled += entry_size) {
+            auto *entry = reinterpret_cast<HashTableEntry *>(spilled);
+            entry->next_ = partition_heads_[part_idx];
+            partition_heads_[part_idx] = entry;
+            if (partition_tails_[part_idx] == nullptr) {
+                partition_tails_[part_idx] = entry;
+            }
+        }
+    }
+    source->spilled_partitions_.clear();
+    owned_spill_files_.emplace_back(std::move(source->spill_file_));
+}
+
 auto AggregationHashTable::AllocInputTuplePartitioned(hash_t hash) -> byte * {
-    byte *ret = AllocInputTuple(hash);
+    // Entries are only complete once the next one is allocated, so spill partitions
+    // flushed by the previous insertion now.
+    if (UNLIKELY(NeedsToSpill())) {
+        SpillOverflowPartitions();
+    }
+
+    byte *ret = AllocInputTupleInternal(hash);
     if (NeedsToFlushToOverflowPartitions()) {
         FlushToOverflowPartitions();
     }
@@ -545,18 +629,26 @@ void AggregationHashTable::ProcessBatch(VectorProjectionIterator
 
     // If the caller requested a partitioned aggregation, drain the main hash
     // table out to the overflow partitions, but only if needed.
-    if (partitioned_aggregation) {
+    if (partitioned_aggregation || partitioned_mode_) {
         if (NeedsToFlushToOverflowPartitions()) {
             FlushToOverflowPartitions();
         }
     } else {
-        if (NeedsToGrow()) {
+        if (UNLIKELY(NeedsToSwitchToPartitionedMode())) {
+            SwitchToPartitionedMode();
+        } else if (NeedsToGrow()) {
             Grow();
         }
     }
 
     // Advance the aggregates for all tuples that found a match.
     AdvanceGroups(input_batch, advance_agg_fn);
+
+    // All entries of the batch are complete, so partitions flushed by this batch
+    // can be spilled.
+    if ((partitioned_aggregation || partitioned_mode_) && NeedsToSpill()) {
+        SpillOverflowPartitions();
+    }
 }
 
 void AggregationHashTable::TransferMemoryAndPartitions(ThreadStateContainer *thread_states,
@@ -581,6 +673,11 @@ void AggregationHashTable::TransferMemoryAndPartitions(ThreadStateContainer *thr
         FlushToOverflowPartitions();
     }
 
+    // Link in the partitions we spilled, if any.
+    if (spill_file_ != nullptr) {
+        LinkSpilledPartitions(this);
+    }
+
     // Okay, now we actually pull out the thread-local aggregation hash tables and
     // move both their main entry data and the overflow partitions to us.
     std::vector<AggregationHashTable *> tl_agg_ht;
@@ -611,11 +708,51 @@ void AggregationHashTable::TransferMemoryAndPartitions(ThreadStateContainer *thr
                 partition_estimates_[part_idx]->Merge(table->partition_estimates_[part_idx]);
             }
         }
+
+        // Link in the partitions the table spilled, if any.
+        if (table->spill_file_ != nullptr) {
+            LinkSpilledPartitions(table);
+        }
     }
 
     exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(tl_agg_ht.size()));
 }
 
+void AggregationHashTable::MergeOverflowPartitions(void *query_state, const MergePartitionFn merge_partition_fn) {
+    // Without the switch, all aggregates are in the main table already.
+    if (!partitioned_mode_) {
+        return;
+    }
+
+    // Flush the aggregates inserted since the last flush, and link in the
+    // partitions we spilled, if any.
+    FlushToOverflowPartitions();
+    if (spill_file_ != nullptr) {
+        LinkSpilledPartitions(this);
+    }
+
+    // Size the main table for all groups up front, as growing it would re-insert
+    // the flushed entries.
+    uint64_t estimated_size = 0;
+    for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
+        if (partition_heads_[part_idx] != nullptr) {
+            estimated_size += partition_estimates_[part_idx]->Estimate();
+        }
+    }
+    hash_table_.SetSize(estimated_size, memory_->GetTracker());
+    max_fill_ = std::llround(hash_table_.GetCapacity() * hash_table_.GetLoadFactor());
+
+    // Merge the partial aggregates back into the main table, one partition at a
+    // time.
+    for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
+        if (partition_heads_[part_idx] != nullptr) {
+            AHTOverflowPartitionIterator iter(partition_heads_ + part_idx, partition_heads_ + part_idx + 1);
+            merge_partition_fn(query_state, this, &iter);
+            partition_heads_[part_idx] = partition_tails_[part_idx] = nullptr;
+        }
+    }
+}
+
 auto AggregationHashTable::GetOrBuildTableOverPartition(void *query_state, const uint32_t partition_idx)
     -> AggregationHashTable * {
     NOISEPAGE_ASSERT(partition_idx < DEFAULT_NUM_PARTITIONS, "Out-of-bounds partition access");
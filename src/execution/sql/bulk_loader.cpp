@@ -0,0 +1,639 @@
+#include "execution/sql/bulk_loader.h"
+
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/info.h>
+#include <tbb/parallel_pipeline.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog_accessor.h"
+#include "catalog/index_schema.h"
+#include "catalog/schema.h"
+#include "common/allocator.h"
+#include "common/error/error_code.h"
+#include "common/error/exception.h"
+#include "execution/sql/runtime_types.h"
+#include "execution/util/csv_reader.h"
+#include "execution/util/file.h"
+#include "fast_float/fast_float.h"
+#include "loggers/execution_logger.h"
+#include "spdlog/fmt/fmt.h"
+#include "storage/index/index.h"
+#include "storage/sql_table.h"
+#include "storage/storage_util.h"
+#include "util/portable_endian.h"
+
+namespace noisepage::execution::sql {
+
+namespace {
+
+// The signature at the start of every binary COPY file.
+constexpr char BINARY_SIGNATURE[] = "PGCOPY\n\377\r\n";
+constexpr std::size_t BINARY_SIGNATURE_SIZE = sizeof(BINARY_SIGNATURE);
+
+// The size of the fixed part of the header of a binary COPY file: the signature, the flags and the length of the
+// header extension area.
+constexpr std::size_t BINARY_HEADER_SIZE = BINARY_SIGNATURE_SIZE + 2 * sizeof(int32_t);
+
+// Read a value stored in network byte order.
+template <typename T>
+auto ReadNetworkValue(const char *const data) -> T {
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "Invalid size for numeric.");
+    T value;
+    if constexpr (sizeof(T) == 1) {
+        std::memcpy(&value, data, sizeof(T));
+    } else if constexpr (sizeof(T) == 2) {
+        uint16_t raw;
+        std::memcpy(&raw, data, sizeof(T));
+        raw = be16toh(raw);
+        std::memcpy(&value, &raw, sizeof(T));
+    } else if constexpr (sizeof(T) == 4) {
+        uint32_t raw;
+        std::memcpy(&raw, data, sizeof(T));
+        raw = be32toh(raw);
+        std::memcpy(&value, &raw, sizeof(T));
+    } else {
+        uint64_t raw;
+        std::memcpy(&raw, data, sizeof(T));
+        raw = be64toh(raw);
+        std::memcpy(&value, &raw, sizeof(T));
+    }
+    return value;
+}
+
+// Find the end of the last complete tuple in data read from a binary COPY file. The data must start at a tuple. If the
+// file trailer is found, its offset is returned and the trailer flag is set.
+auto FindBinaryTuplesEnd(const std::string &data, const std::size_t num_cols, bool *const trailer) -> std::size_t {
+    std::size_t end = 0;
+    while (end + sizeof(int16_t) <= data.size()) {
+        const auto num_fields = ReadNetworkValue<int16_t>(data.data() + end);
+        if (num_fields == -1) {
+            *trailer = true;
+            return end;
+        }
+        if (num_fields != static_cast<int64_t>(num_cols)) {
+            throw EXECUTION_EXCEPTION(fmt::format("row field count is {}, expected {}", num_fields, num_cols),
+                                      common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT);
+        }
+
+        std::size_t pos = end + sizeof(int16_t);
+        for (int16_t i = 0; i < num_fields; i++) {
+            if (pos + sizeof(int32_t) > data.size()) {
+                return end;
+            }
+            const auto field_size = ReadNetworkValue<int32_t>(data.data() + pos);
+            if (field_size < -1) {
+                throw EXECUTION_EXCEPTION("invalid field size", common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT);
+            }
+            pos += sizeof(int32_t) + std::max(field_size, 0);
+        }
+        if (pos > data.size()) {
+            return end;
+        }
+        end = pos;
+    }
+    return end;
+}
+
+[[noreturn]] void ThrowInvalidText(const SqlTypeId type, const std::string_view text) {
+    throw EXECUTION_EXCEPTION(fmt::format("invalid input syntax for type {}: \"{}\"", SqlTypeIdToString(type), text),
+                              common::ErrorCode::ERRCODE_INVALID_TEXT_REPRESENTATION);
+}
+
+template <typename T>
+auto ParseInteger(const SqlTypeId type, const std::string_view text) -> T {
+    T value = 0;
+    const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec == std::errc::result_out_of_range) {
+        throw EXECUTION_EXCEPTION(
+            fmt::format("value \"{}\" is out of range for type {}", text, SqlTypeIdToString(type)),
+            common::ErrorCode::ERRCODE_NUMERIC_VALUE_OUT_OF_RANGE);
+    }
+    if (ec != std::errc() || end != text.data() + text.size()) {
+        ThrowInvalidText(type, text);
+    }
+    return value;
+}
+
+auto ParseBoolean(const std::string_view text) -> bool {
+    std::string lower(text);
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    if (lower == "t" || lower == "true" || lower == "y" || lower == "yes" || lower == "on" || lower == "1") {
+        return true;
+    }
+    if (lower == "f" || lower == "false" || lower == "n" || lower == "no" || lower == "off" || lower == "0") {
+        return false;
+    }
+    ThrowInvalidText(SqlTypeId::Boolean, text);
+}
+
+auto AllColumnOids(const catalog::Schema &schema) -> std::vector<catalog::col_oid_t> {
+    std::vector<catalog::col_oid_t> col_oids;
+    col_oids.reserve(schema.GetColumns().size());
+    for (const auto &col : schema.GetColumns()) {
+        col_oids.push_back(col.Oid());
+    }
+    return col_oids;
+}
+
+} // namespace
+
+//===----------------------------------------------------------------------===//
+//
+// Block Writer
+//
+//===----------------------------------------------------------------------===//
+
+class BulkLoader::BlockWriter {
+public:
+    explicit BlockWriter(BulkLoader *const loader)
+        : loader_(loader)
+        , buffer_(common::AllocationUtil::AllocateAligned(loader->row_initializer_.ProjectedRowSize()))
+        , row_(nullptr)
+        , block_(nullptr) {}
+
+    DISALLOW_COPY_AND_MOVE(BlockWriter);
+
+    ~BlockWriter() {
+        if (block_ != nullptr) {
+            loader_->table_->ReleaseBulkLoadBlock(block_);
+        }
+    }
+
+    // Return an empty row, with every column NULL, to parse the next tuple into.
+    auto NewRow() -> storage::ProjectedRow * {
+        row_ = loader_->row_initializer_.InitializeRow(buffer_.get());
+        return row_;
+    }
+
+    // Append the row returned by the last call to NewRow() to the current block. The block takes over its varlens.
+    void AppendRow() {
+        if (block_ == nullptr) {
+            block_ = loader_->table_->NewBulkLoadBlock();
+        }
+        if (!loader_->table_->BulkLoadInto(block_, *row_)) {
+            Flush();
+            block_ = loader_->table_->NewBulkLoadBlock();
+            [[maybe_unused]] const bool appended = loader_->table_->BulkLoadInto(block_, *row_);
+            NOISEPAGE_ASSERT(appended, "A tuple must fit into an empty block");
+        }
+    }
+
+    // Free the varlens of the row returned by the last call to NewRow(), if it will not be appended.
+    void DiscardRow() {
+        for (const auto &col : loader_->columns_) {
+            if (col.type_ != SqlTypeId::Varchar && col.type_ != SqlTypeId::Varbinary) {
+                continue;
+            }
+            const auto *varlen = reinterpret_cast<const storage::VarlenEntry *>(row_->AccessWithNullCheck(col.offset_));
+            if (varlen != nullptr && varlen->NeedReclaim()) {
+                delete[] varlen->Content();
+            }
+        }
+    }
+
+    // Insert the current block into the table, if there is one.
+    void Flush() {
+        if (block_ != nullptr) {
+            loader_->InsertBlock(block_);
+            block_ = nullptr;
+        }
+    }
+
+private:
+    // The loader this writer belongs to.
+    BulkLoader *loader_;
+    // The buffer rows are parsed into.
+    std::unique_ptr<byte[]> buffer_;
+    // The row currently being parsed.
+    storage::ProjectedRow *row_;
+    // The block being filled, or nullptr if no row was appended since the last flush.
+    storage::RawBlock *block_;
+};
+
+//===----------------------------------------------------------------------===//
+//
+// Bulk Loader
+//
+//===----------------------------------------------------------------------===//
+
+BulkLoader::BulkLoader(const common::ManagedPointer<catalog::CatalogAccessor>         accessor,
+                       const catalog::db_oid_t                                        db_oid,
+                       const catalog::table_oid_t                                     table_oid,
+                       const common::ManagedPointer<transaction::TransactionContext> txn)
+    : accessor_(accessor)
+    , db_oid_(db_oid)
+    , table_oid_(table_oid)
+    , txn_(txn)
+    , table_(accessor->GetTable(table_oid))
+    , row_initializer_(table_->InitializerForProjectedRow(AllColumnOids(accessor->GetSchema(table_oid))))
+    , num_rows_(0) {
+    const auto &schema = accessor->GetSchema(table_oid);
+    const auto  projection_map = table_->ProjectionMapForOids(AllColumnOids(schema));
+    for (const auto &col : schema.GetColumns()) {
+        switch (col.Type()) {
+        case SqlTypeId::Boolean:
+        case SqlTypeId::TinyInt:
+        case SqlTypeId::SmallInt:
+        case SqlTypeId::Integer:
+        case SqlTypeId::BigInt:
+        case SqlTypeId::Double:
+        case SqlTypeId::Date:
+        case SqlTypeId::Timestamp:
+        case SqlTypeId::Varchar:
+        case SqlTypeId::Varbinary:
+            break;
+        default:
+            throw EXECUTION_EXCEPTION(fmt::format("COPY FROM does not support column \"{}\" of type {}",
+                                                  col.Name(),
+                                                  SqlTypeIdToString(col.Type())),
+                                      common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED);
+        }
+        columns_.push_back({col.Name(), col.Type(), col.Nullable(), projection_map.at(col.Oid())});
+    }
+}
+
+auto BulkLoader::LoadCsv(const std::string &path, const char delimiter, const char quote, const char escape)
+    -> uint64_t {
+    util::File file(path, util::File::FLAG_OPEN | util::File::FLAG_READ);
+    if (!file.IsOpen()) {
+        throw EXECUTION_EXCEPTION(fmt::format("could not open file \"{}\" for reading: {}",
+                                              path,
+                                              util::File::ErrorToString(file.GetErrorIndicator())),
+                                  common::ErrorCode::ERRCODE_UNDEFINED_FILE);
+    }
+
+    // Cut chunks after their last line break, the rest is parsed with the next chunk.
+    const auto split = [](const std::string &data, const bool eof, bool *const done) -> std::size_t {
+        *done = eof;
+        if (eof) {
+            return data.size();
+        }
+        const std::size_t last_line_break = data.rfind('\n');
+        return last_line_break == std::string::npos ? 0 : last_line_break + 1;
+    };
+    const auto parse = [this, delimiter, quote, escape](std::string &&chunk, BlockWriter *const writer) {
+        ParseCsvChunk(std::move(chunk), delimiter, quote, escape, writer);
+    };
+    return Load(file, 0, split, parse);
+}
+
+auto BulkLoader::LoadBinary(const std::string &path) -> uint64_t {
+    util::File file(path, util::File::FLAG_OPEN | util::File::FLAG_READ);
+    if (!file.IsOpen()) {
+        throw EXECUTION_EXCEPTION(fmt::format("could not open file \"{}\" for reading: {}",
+                                              path,
+                                              util::File::ErrorToString(file.GetErrorIndicator())),
+                                  common::ErrorCode::ERRCODE_UNDEFINED_FILE);
+    }
+
+    // Check the header. The flags and the header extension area carry nothing we need, so they're skipped.
+    char header[BINARY_HEADER_SIZE];
+    if (file.ReadFullFromPosition(0, reinterpret_cast<std::byte *>(header), BINARY_HEADER_SIZE)
+            != static_cast<int32_t>(BINARY_HEADER_SIZE)
+        || std::memcmp(header, BINARY_SIGNATURE, BINARY_SIGNATURE_SIZE) != 0) {
+        throw EXECUTION_EXCEPTION("COPY file signature not recognized",
+                                  common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT);
+    }
+    const auto extension_size = ReadNetworkValue<int32_t>(header + BINARY_SIGNATURE_SIZE + sizeof(int32_t));
+    if (extension_size < 0) {
+        throw EXECUTION_EXCEPTION("invalid COPY file header (wrong length)",
+                                  common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT);
+    }
+
+    // Cut chunks after their last complete tuple, the rest is parsed with the next chunk.
+    const std::size_t num_cols = columns_.size();
+    const auto        split = [num_cols](const std::string &data, const bool eof, bool *const done) -> std::size_t {
+        const std::size_t end = FindBinaryTuplesEnd(data, num_cols, done);
+        if (eof && !*done) {
+            throw EXECUTION_EXCEPTION("unexpected EOF in COPY data", common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT);
+        }
+        return end;
+    };
+    const auto parse = [this](std::string &&chunk, BlockWriter *const writer) {
+        ParseBinaryChunk(chunk, writer);
+    };
+    return Load(file, BINARY_HEADER_SIZE + extension_size, split, parse);
+}
+
+auto BulkLoader::Load(const util::File &file, uint64_t offset, const SplitFn &split, const ParseFn &parse)
+    -> uint64_t {
+    loaded_blocks_.clear();
+    num_rows_ = 0;
+
+    // One writer per parsing thread. Destroying the writers releases the blocks they did not insert, if loading fails.
+    tbb::enumerable_thread_specific<BlockWriter> writers(this);
+
+    // The data read from the file that was not handed out to a parser yet.
+    std::string pending;
+    bool        done = false;
+
+    // Reading is sequential, only parsing is parallel. The number of chunks in flight is bounded, so that at most a few
+    // chunks per thread are held in memory, however large the file.
+    const auto max_chunks = static_cast<std::size_t>(2 * tbb::info::default_concurrency());
+    tbb::parallel_pipeline(
+        max_chunks,
+        tbb::make_filter<void, std::shared_ptr<std::string>>(
+            tbb::filter_mode::serial_in_order,
+            [&](tbb::flow_control &control) -> std::shared_ptr<std::string> {
+                while (!done) {
+                    const std::size_t pending_size = pending.size();
+                    pending.resize(pending_size + CHUNK_SIZE);
+                    const int32_t num_read = file.ReadFullFromPosition(
+                        offset,
+                        reinterpret_cast<std::byte *>(pending.data() + pending_size),
+                        CHUNK_SIZE);
+                    if (num_read < 0) {
+                        throw EXECUTION_EXCEPTION("could not read from COPY file", common::ErrorCode::ERRCODE_IO_ERROR);
+                    }
+                    pending.resize(pending_size + num_read);
+                    offset += num_read;
+
+                    const std::size_t end = split(pending, static_cast<uint32_t>(num_read) < CHUNK_SIZE, &done);
+                    if (end == 0) {
+                        // Not even a single complete row yet.
+                        continue;
+                    }
+                    auto chunk = std::make_shared<std::string>(std::move(pending));
+                    pending = chunk->substr(end);
+                    chunk->resize(end);
+                    return chunk;
+                }
+                control.stop();
+                return nullptr;
+            })
+            & tbb::make_filter<std::shared_ptr<std::string>, void>(
+                tbb::filter_mode::parallel,
+                [&](const std::shared_ptr<std::string> &chunk) {
+                    parse(std::move(*chunk), &writers.local());
+                }));
+
+    for (auto &writer : writers) {
+        writer.Flush();
+    }
+    PopulateIndexes();
+
+    EXECUTION_LOG_DEBUG("Bulk loaded {} rows into {} blocks", num_rows_, loaded_blocks_.size());
+    return num_rows_;
+}
+
+void BulkLoader::ParseCsvChunk(std::string &&chunk,
+                               const char    delimiter,
+                               const char    quote,
+                               const char    escape,
+                               BlockWriter  *writer) const {
+    util::CSVReader reader(std::make_unique<util::CSVString>(std::move(chunk)), delimiter, quote, escape);
+    if (!reader.Initialize()) {
+        throw EXECUTION_EXCEPTION("could not read COPY data", common::ErrorCode::ERRCODE_IO_ERROR);
+    }
+
+    while (reader.Advance()) {
+        const util::CSVReader::CSVRow *csv_row = reader.GetRow();
+        if (csv_row->count_ < columns_.size()) {
+            throw EXECUTION_EXCEPTION(fmt::format("missing data for column \"{}\"", columns_[csv_row->count_].name_),
+                                      common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT);
+        }
+        if (csv_row->count_ > columns_.size()) {
+            throw EXECUTION_EXCEPTION("extra data after last expected column",
+                                      common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT);
+        }
+
+        storage::ProjectedRow *row = writer->NewRow();
+        try {
+            for (uint16_t i = 0; i < columns_.size(); i++) {
+                const util::CSVReader::CSVCell &cell = csv_row->cells_[i];
+                if (cell.IsEmpty()) {
+                    CheckNullable(i);
+                } else if (cell.escaped_) {
+                    SetFromText(row, i, cell.AsString());
+                } else {
+                    SetFromText(row, i, std::string_view(cell.ptr_, cell.len_));
+                }
+            }
+        } catch (...) {
+            writer->DiscardRow();
+            throw;
+        }
+        writer->AppendRow();
+    }
+}
+
+void BulkLoader::ParseBinaryChunk(const std::string &chunk, BlockWriter *writer) const {
+    const char *pos = chunk.data();
+    const char *end = pos + chunk.size();
+    while (pos != end) {
+        // The field count was checked when the chunk was cut.
+        pos += sizeof(int16_t);
+
+        storage::ProjectedRow *row = writer->NewRow();
+        try {
+            for (uint16_t i = 0; i < columns_.size(); i++) {
+                const auto field_size = ReadNetworkValue<int32_t>(pos);
+                pos += sizeof(int32_t);
+                if (field_size == -1) {
+                    CheckNullable(i);
+                } else {
+                    SetFromBinary(row, i, pos, field_size);
+                    pos += field_size;
+                }
+            }
+        } catch (...) {
+            writer->DiscardRow();
+            throw;
+        }
+        writer->AppendRow();
+    }
+}
+
+void BulkLoader::SetFromText(storage::ProjectedRow *row, const uint16_t col_idx, const std::string_view text) const {
+    const ColumnInfo &col = columns_[col_idx];
+    byte *const       value = row->AccessForceNotNull(col.offset_);
+    switch (col.type_) {
+    case SqlTypeId::Boolean:
+        *reinterpret_cast<bool *>(value) = ParseBoolean(text);
+        break;
+    case SqlTypeId::TinyInt:
+        *reinterpret_cast<int8_t *>(value) = ParseInteger<int8_t>(col.type_, text);
+        break;
+    case SqlTypeId::SmallInt:
+        *reinterpret_cast<int16_t *>(value) = ParseInteger<int16_t>(col.type_, text);
+        break;
+    case SqlTypeId::Integer:
+        *reinterpret_cast<int32_t *>(value) = ParseInteger<int32_t>(col.type_, text);
+        break;
+    case SqlTypeId::BigInt:
+        *reinterpret_cast<int64_t *>(value) = ParseInteger<int64_t>(col.type_, text);
+        break;
+    case SqlTypeId::Double: {
+        double     result = 0;
+        const auto [end, ec] = fast_float::from_chars(text.data(), text.data() + text.size(), result);
+        if (ec != std::errc() || end != text.data() + text.size()) {
+            ThrowInvalidText(col.type_, text);
+        }
+        *reinterpret_cast<double *>(value) = result;
+        break;
+    }
+    case SqlTypeId::Date:
+    case SqlTypeId::Timestamp:
+        try {
+            if (col.type_ == SqlTypeId::Date) {
+                *reinterpret_cast<Date *>(value) = Date::FromString(text);
+            } else {
+                *reinterpret_cast<Timestamp *>(value) = Timestamp::FromString(text);
+            }
+        } catch (const ConversionException &e) {
+            throw EXECUTION_EXCEPTION(
+                fmt::format("invalid input syntax for type {}: \"{}\"", SqlTypeIdToString(col.type_), text),
+                common::ErrorCode::ERRCODE_INVALID_DATETIME_FORMAT);
+        }
+        break;
+    case SqlTypeId::Varchar:
+    case SqlTypeId::Varbinary:
+        *reinterpret_cast<storage::VarlenEntry *>(value) = storage::StorageUtil::CreateVarlen(text);
+        break;
+    default:
+        UNREACHABLE("Column types are checked when the loader is created.");
+    }
+}
+
+void BulkLoader::SetFromBinary(storage::ProjectedRow *row,
+                               const uint16_t         col_idx,
+                               const char            *data,
+                               const int32_t          size) const {
+    const ColumnInfo &col = columns_[col_idx];
+    const auto        check_size = [&](const std::size_t expected) {
+        if (static_cast<std::size_t>(size) != expected) {
+            throw EXECUTION_EXCEPTION(fmt::format("incorrect binary data format in column \"{}\"", col.name_),
+                                      common::ErrorCode::ERRCODE_INVALID_BINARY_REPRESENTATION);
+        }
+    };
+
+    byte *const value = row->AccessForceNotNull(col.offset_);
+    switch (col.type_) {
+    case SqlTypeId::Boolean:
+        check_size(sizeof(int8_t));
+        *reinterpret_cast<bool *>(value) = ReadNetworkValue<int8_t>(data) != 0;
+        break;
+    case SqlTypeId::TinyInt:
+        check_size(sizeof(int8_t));
+        *reinterpret_cast<int8_t *>(value) = ReadNetworkValue<int8_t>(data);
+        break;
+    case SqlTypeId::SmallInt:
+        check_size(sizeof(int16_t));
+        *reinterpret_cast<int16_t *>(value) = ReadNetworkValue<int16_t>(data);
+        break;
+    case SqlTypeId::Integer:
+        check_size(sizeof(int32_t));
+        *reinterpret_cast<int32_t *>(value) = ReadNetworkValue<int32_t>(data);
+        break;
+    case SqlTypeId::BigInt:
+        check_size(sizeof(int64_t));
+        *reinterpret_cast<int64_t *>(value) = ReadNetworkValue<int64_t>(data);
+        break;
+    case SqlTypeId::Double:
+        check_size(sizeof(double));
+        *reinterpret_cast<double *>(value) = ReadNetworkValue<double>(data);
+        break;
+    case SqlTypeId::Date: {
+        // Days since 2000-01-01.
+        static const Date::NativeType PG_EPOCH = Date::FromYMD(2000, 1, 1).ToNative();
+        check_size(sizeof(int32_t));
+        *reinterpret_cast<Date *>(value) = Date::FromNative(PG_EPOCH + ReadNetworkValue<int32_t>(data));
+        break;
+    }
+    case SqlTypeId::Timestamp: {
+        // Microseconds since 2000-01-01 00:00:00.
+        static const Timestamp::NativeType PG_EPOCH = Timestamp::FromYMDHMS(2000, 1, 1, 0, 0, 0).ToNative();
+        check_size(sizeof(int64_t));
+        *reinterpret_cast<Timestamp *>(value) = Timestamp::FromNative(PG_EPOCH + ReadNetworkValue<int64_t>(data));
+        break;
+    }
+    case SqlTypeId::Varchar:
+    case SqlTypeId::Varbinary:
+        *reinterpret_cast<storage::VarlenEntry *>(value)
+            = storage::StorageUtil::CreateVarlen(std::string_view(data, static_cast<std::size_t>(size)));
+        break;
+    default:
+        UNREACHABLE("Column types are checked when the loader is created.");
+    }
+}
+
+void BulkLoader::CheckNullable(const uint16_t col_idx) const {
+    if (!columns_[col_idx].nullable_) {
+        throw EXECUTION_EXCEPTION(
+            fmt::format("null value in column \"{}\" violates not-null constraint", columns_[col_idx].name_),
+            common::ErrorCode::ERRCODE_NOT_NULL_VIOLATION);
+    }
+}
+
+void BulkLoader::InsertBlock(storage::RawBlock *const block) {
+    std::lock_guard<std::mutex> guard(insert_latch_);
+    num_rows_ += table_->InsertBlock(txn_, db_oid_, table_oid_, block);
+    loaded_blocks_.push_back(block);
+}
+
+void BulkLoader::PopulateIndexes() {
+    const auto indexes = accessor_->GetIndexes(table_oid_);
+    if (indexes.empty()) {
+        return;
+    }
+
+    uint32_t max_key_size = 0;
+    for (const auto &index : indexes) {
+        max_key_size = std::max(max_key_size, index.first->GetProjectedRowInitializer().ProjectedRowSize());
+    }
+    const std::unique_ptr<byte[]> key_buffer(common::AllocationUtil::AllocateAligned(max_key_size));
+    const std::unique_ptr<byte[]> row_buffer(
+        common::AllocationUtil::AllocateAligned(row_initializer_.ProjectedRowSize()));
+    const auto projection_map = table_->ProjectionMapForOids(AllColumnOids(accessor_->GetSchema(table_oid_)));
+
+    // Insert the keys of all loaded tuples, block by block. Indexes on expressions are not supported, every key column
+    // must be a column of the table.
+    for (storage::RawBlock *const block : loaded_blocks_) {
+        const uint32_t num_tuples = block->GetInsertHead();
+        for (uint32_t offset = 0; offset < num_tuples; offset++) {
+            const storage::TupleSlot slot(block, offset);
+            storage::ProjectedRow   *row = row_initializer_.InitializeRow(row_buffer.get());
+            [[maybe_unused]] const bool visible = table_->Select(txn_, slot, row);
+            NOISEPAGE_ASSERT(visible, "The loading transaction must see the tuples it loaded");
+
+            for (const auto &[index, schema] : indexes) {
+                const auto &indexed_oids = schema.GetIndexedColOids();
+                NOISEPAGE_ASSERT(schema.GetColumns().size() == indexed_oids.size(),
+                                 "Only support index keys that are a single column oid");
+                storage::ProjectedRow *key = index->GetProjectedRowInitializer().InitializeRow(key_buffer.get());
+                for (uint32_t i = 0; i < indexed_oids.size(); i++) {
+                    const auto     &key_col = schema.GetColumn(i);
+                    const uint16_t  key_offset = index->GetKeyOidToOffsetMap().at(key_col.Oid());
+                    const uint16_t  row_offset = projection_map.at(indexed_oids[i]);
+                    const byte     *attr = row->AccessWithNullCheck(row_offset);
+                    if (attr == nullptr) {
+                        key->SetNull(key_offset);
+                    } else {
+                        std::memcpy(key->AccessForceNotNull(key_offset),
+                                    attr,
+                                    storage::AttrSizeBytes(key_col.AttributeLength()));
+                    }
+                }
+
+                if (schema.Unique()) {
+                    if (!index->InsertUnique(txn_, *key, slot)) {
+                        throw EXECUTION_EXCEPTION("duplicate key value violates unique constraint",
+                                                  common::ErrorCode::ERRCODE_UNIQUE_VIOLATION);
+                    }
+                } else {
+                    index->Insert(txn_, *key, slot);
+                }
+            }
+        }
+    }
+}
+
+} // namespace noisepage::execution::sql
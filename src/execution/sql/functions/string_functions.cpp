@@ -6,6 +6,7 @@
 
 #include "execution/exec/execution_context.h"
 #include "execution/sql/operators/like_operators.h"
+#include "execution/util/string_util.h"
 
 namespace noisepage::execution::sql {
 
@@ -269,7 +270,7 @@ void StringFunctions::Lower(StringVal *result, exec::ExecutionContext *ctx, cons
     }
 
     char *target = ctx->GetStringAllocator()->PreAllocate(str.GetLength());
-    std::transform(str.GetContent(), str.GetContent() + str.GetLength(), target, ::tolower);
+    util::StringUtil::ToLower(str.GetContent(), str.GetLength(), target);
     *result = StringVal(target, str.GetLength());
 }
 
@@ -280,7 +281,7 @@ void StringFunctions::Upper(StringVal *result, exec::ExecutionContext *ctx, cons
     }
 
     char *target = ctx->GetStringAllocator()->PreAllocate(str.GetLength());
-    std::transform(str.GetContent(), str.GetContent() + str.GetLength(), target, ::toupper);
+    util::StringUtil::ToUpper(str.GetContent(), str.GetLength(), target);
     *result = StringVal(target, str.GetLength());
 }
 
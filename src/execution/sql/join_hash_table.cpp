@@ -3,13 +3,16 @@
 #include <llvm/ADT/STLExtras.h>
 
 #include <tbb/info.h>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_for_each.h>
 
 #include <algorithm>
+#include <cstring>
 #include <limits>
 #include <utility>
 #include <vector>
 
+#include "common/math_util.h"
 #include "count/hll.h"
 #include "execution/exec/execution_context.h"
 #include "execution/sql/memory_pool.h"
@@ -31,10 +34,16 @@ JoinHashTable::JoinHashTable(const exec::ExecutionSettings &exec_settings,
     , exec_ctx_(exec_ctx)
     , entries_(HashTableEntry::ComputeEntrySize(tuple_size), MemoryPoolAllocator<byte>(exec_ctx->GetMemoryPool()))
     , owned_(exec_ctx->GetMemoryPool())
+    , num_spilled_(0)
     , concise_hash_table_(0)
     , hll_estimator_(libcount::HLL::Create(DEFAULT_HLL_PRECISION))
     , built_(false)
     , use_concise_ht_(use_concise_ht)
+    , merge_mode_(MergeMode::Automatic)
+    , radix_directory_(exec_ctx->GetMemoryPool())
+    , radix_bits_(0)
+    , radix_bucket_bits_(0)
+    , radix_bucket_mask_(0)
     , tracker_(exec_ctx->GetMemoryPool()->GetTracker()) {}
 
 // Needed because we forward-declared HLL from libcount
@@ -44,6 +53,11 @@ auto JoinHashTable::AllocInputTuple(const hash_t hash) -> byte * {
     // Add to unique_count estimation
     hll_estimator_->Update(hash);
 
+    // Every buffered tuple has been written by now, so it can be spilled.
+    if (UNLIKELY(NeedsToSpill())) {
+        SpillEntries();
+    }
+
     // Allocate space for a new tuple
     auto *entry = reinterpret_cast<HashTableEntry *>(entries_.Append());
     entry->hash_ = hash;
@@ -51,6 +65,57 @@ auto JoinHashTable::AllocInputTuple(const hash_t hash) -> byte * {
     return entry->payload_;
 }
 
+auto JoinHashTable::NeedsToSpill() const -> bool {
+    // Only check the budget when a new chunk is about to be allocated, and only once enough has
+    // been buffered to make the write worthwhile. Concise tables reorder entries in place, so they
+    // must stay in memory.
+    return !use_concise_ht_ && (entries_.size() & decltype(entries_)::K_CHUNK_POSITION_MASK) == 0
+        && GetBufferedTupleMemoryUsage() >= SpillFile::MIN_SPILL_SIZE && exec_ctx_->GetMemoryPool()->IsOverBudget();
+}
+
+void JoinHashTable::SpillEntries() {
+    if (spill_file_ == nullptr) {
+        spill_file_ = std::make_unique<SpillFile>(exec_settings_.GetSpillDirectory());
+    }
+
+    const std::size_t entry_size = entries_.ElementSize();
+    for (const byte *entry : entries_) {
+        spill_file_->Append(entry, entry_size);
+    }
+
+    // The table is still private to its inserting thread, so the latch isn't needed.
+    num_spilled_ += entries_.size();
+    EXECUTION_LOG_DEBUG("JHT: Spilled {} entries, {} spilled in total", entries_.size(), num_spilled_);
+
+    // Clearing the vector keeps its chunks, so replace it to release the memory.
+    entries_ = decltype(entries_)(entry_size, MemoryPoolAllocator<byte>(exec_ctx_->GetMemoryPool()));
+}
+
+void JoinHashTable::TakeSpillFile(JoinHashTable *source) {
+    if (source->spill_file_ == nullptr) {
+        return;
+    }
+    common::SpinLatch::ScopedSpinLatch latch(&owned_latch_);
+    owned_spill_files_.emplace_back(std::move(source->spill_file_));
+    if (source != this) {
+        num_spilled_ += source->num_spilled_;
+    }
+}
+
+namespace {
+
+    // Invoke 'f' on every entry in the given spill file, mapping it if needed.
+    template <typename F>
+    void ForEachSpilledEntry(SpillFile *file, const std::size_t entry_size, F &&f) {
+        byte          *entries = file->Map();
+        const uint64_t num_entries = file->GetSize() / entry_size;
+        for (uint64_t idx = 0; idx < num_entries; idx++) {
+            f(reinterpret_cast<HashTableEntry *>(entries + idx * entry_size));
+        }
+    }
+
+} // namespace
+
 void JoinHashTable::BuildChainingHashTable() {
     // Perfectly size the generic hash table in preparation for bulk-load.
     chaining_hash_table_.SetSize(GetTupleCount(), tracker_);
@@ -58,6 +123,14 @@ void JoinHashTable::BuildChainingHashTable() {
     // Bulk-load the, now correctly sized, generic hash table using a non-concurrent algorithm.
     chaining_hash_table_.InsertBatch<false>(&entries_);
 
+    // Link the spilled entries in place in their mapped spill file.
+    if (spill_file_ != nullptr) {
+        ForEachSpilledEntry(spill_file_.get(), entries_.ElementSize(), [this](HashTableEntry *entry) {
+            chaining_hash_table_.Insert<false>(entry);
+        });
+        TakeSpillFile(this);
+    }
+
 #ifndef NDEBUG
     const auto [min, max, avg] = chaining_hash_table_.GetChainLengthStats();
     (void) min;
@@ -561,9 +634,20 @@ void JoinHashTable::LookupBatchInConciseHashTable(const Vector &hashes, Vector *
                                                                     });
 }
 
+void JoinHashTable::LookupBatchInRadixPartitions(const Vector &hashes, Vector *results) const {
+    UnaryOperationExecutor::Execute<hash_t, const HashTableEntry *>(exec_settings_,
+                                                                    hashes,
+                                                                    results,
+                                                                    [&](const hash_t hash_val) noexcept {
+                                                                        return FindRadixChainHead(hash_val);
+                                                                    });
+}
+
 void JoinHashTable::LookupBatch(const Vector &hashes, Vector *results) const {
     NOISEPAGE_ASSERT(IsBuilt(), "Cannot perform lookup before table is built!");
-    if (UsingConciseHashTable()) {
+    if (UsingRadixPartitions()) {
+        LookupBatchInRadixPartitions(hashes, results);
+    } else if (UsingConciseHashTable()) {
         LookupBatchInConciseHashTable(hashes, results);
     } else {
         LookupBatchInChainingHashTable(hashes, results);
@@ -577,12 +661,197 @@ void JoinHashTable::MergeIncomplete(JoinHashTable *source) {
 
     // First, bulk-load all entries in the source table into our hash table
     chaining_hash_table_.InsertBatch<Concurrent>(&source->entries_);
+    if (source->spill_file_ != nullptr) {
+        ForEachSpilledEntry(source->spill_file_.get(), entries_.ElementSize(), [this](HashTableEntry *entry) {
+            chaining_hash_table_.Insert<Concurrent>(entry);
+        });
+    }
 
     // Next, take ownership of source table's memory
+    TakeSpillFile(source);
     common::SpinLatch::ScopedSpinLatch latch(&owned_latch_);
     owned_.emplace_back(std::move(source->entries_));
 }
 
+namespace {
+
+    // A software write-combine buffer holds one cache line of entries bound for
+    // a single partition. Entries are only written to the partition's output a
+    // full cache line at a time, so the scatter does not touch a different page
+    // for every entry.
+    struct alignas(common::Constants::CACHELINE_SIZE) WriteCombineBuffer {
+        static constexpr uint32_t CAPACITY = common::Constants::CACHELINE_SIZE / sizeof(HashTableEntry *);
+        HashTableEntry           *entries_[CAPACITY];
+    };
+
+    // Compute the partition of the given hash, given the shift and mask of the
+    // radix bits of the current pass.
+    uint64_t RadixPartitionOf(const hash_t hash, const uint32_t shift, const uint64_t mask) {
+        return (hash >> shift) & mask;
+    }
+
+    // Scatter the entries produced by 'for_each_entry' into 'output' by their
+    // partition. 'offsets' holds the next write position of every partition in
+    // 'output', and is advanced past the written entries.
+    template <typename ForEachEntry>
+    void RadixScatter(ForEachEntry    for_each_entry,
+                      const uint32_t  shift,
+                      const uint64_t  mask,
+                      uint64_t       *offsets,
+                      HashTableEntry **output) {
+        std::vector<WriteCombineBuffer> buffers(mask + 1);
+        std::vector<uint32_t>           fill(mask + 1, 0);
+
+        for_each_entry([&](HashTableEntry *entry) {
+            const uint64_t part = RadixPartitionOf(entry->hash_, shift, mask);
+            buffers[part].entries_[fill[part]++] = entry;
+            if (fill[part] == WriteCombineBuffer::CAPACITY) {
+                std::memcpy(output + offsets[part], buffers[part].entries_, sizeof(WriteCombineBuffer::entries_));
+                offsets[part] += WriteCombineBuffer::CAPACITY;
+                fill[part] = 0;
+            }
+        });
+
+        // Flush the partially filled buffers.
+        for (uint64_t part = 0; part <= mask; part++) {
+            std::memcpy(output + offsets[part], buffers[part].entries_, fill[part] * sizeof(HashTableEntry *));
+            offsets[part] += fill[part];
+        }
+    }
+
+} // namespace
+
+void JoinHashTable::MergeRadixPartitioned(ThreadStateContainer         *thread_state_container,
+                                          std::vector<JoinHashTable *> *sources) {
+    constexpr uint32_t hash_bits = sizeof(hash_t) * 8;
+
+    uint64_t num_entries = 0;
+    for (auto *source : *sources) {
+        num_entries += source->entries_.size() + source->num_spilled_;
+    }
+
+    // Invoke 'f' on every entry of the source, buffered or spilled.
+    const std::size_t entry_size = entries_.ElementSize();
+    const auto        for_each_source_entry = [entry_size](JoinHashTable *source, auto &&f) {
+        for (byte *raw : source->entries_) {
+            f(reinterpret_cast<HashTableEntry *>(raw));
+        }
+        if (source->spill_file_ != nullptr) {
+            ForEachSpilledEntry(source->spill_file_.get(), entry_size, f);
+        }
+    };
+
+    // Choose enough partitions for the entries of a partition, their slot in the
+    // partitioned output and their slice of the directory to fit in the L2 cache.
+    const uint64_t l2_cache_size = CpuInfo::Instance()->GetCacheSize(CpuInfo::L2_CACHE);
+    const uint64_t partition_bytes = num_entries * (entries_.ElementSize() + 2 * sizeof(HashTableEntry *));
+    const uint64_t num_partitions
+        = std::clamp(common::MathUtil::PowerOf2Ceil(common::MathUtil::DivRoundUp(partition_bytes, l2_cache_size)),
+                     uint64_t{2},
+                     uint64_t{1} << (2 * MAX_RADIX_BITS_PER_PASS));
+    radix_bits_ = llvm::Log2_64(num_partitions);
+
+    // Size the directory for a load factor of at most one, with at least one
+    // bucket per partition.
+    const uint64_t directory_size = std::max(common::MathUtil::PowerOf2Ceil(num_entries), num_partitions);
+    radix_bucket_bits_ = llvm::Log2_64(directory_size) - radix_bits_;
+    radix_bucket_mask_ = (uint64_t{1} << radix_bucket_bits_) - 1;
+    radix_directory_.assign(directory_size, nullptr);
+
+    // Partition in at most two passes, bounding the fan-out of each.
+    const uint32_t bits1 = std::min(radix_bits_, MAX_RADIX_BITS_PER_PASS);
+    const uint32_t bits2 = radix_bits_ - bits1;
+    const uint64_t fanout1 = uint64_t{1} << bits1, fanout2 = uint64_t{1} << bits2;
+    const uint32_t shift1 = hash_bits - bits1, shift2 = hash_bits - radix_bits_;
+
+    // First pass: histogram every source, then compute where every source
+    // writes into each partition, then scatter all sources in parallel.
+    std::vector<std::vector<uint64_t>> offsets(sources->size(), std::vector<uint64_t>(fanout1, 0));
+    tbb::parallel_for(std::size_t{0}, sources->size(), [&](const std::size_t idx) {
+        for_each_source_entry((*sources)[idx], [&](const HashTableEntry *entry) {
+            offsets[idx][RadixPartitionOf(entry->hash_, shift1, fanout1 - 1)]++;
+        });
+    });
+
+    std::vector<uint64_t> bounds1(fanout1 + 1);
+    for (uint64_t part = 0, pos = 0; part < fanout1; part++) {
+        bounds1[part] = pos;
+        for (auto &source_offsets : offsets) {
+            const uint64_t count = source_offsets[part];
+            source_offsets[part] = pos;
+            pos += count;
+        }
+    }
+    bounds1[fanout1] = num_entries;
+
+    MemPoolVector<HashTableEntry *> pass1(num_entries, exec_ctx_->GetMemoryPool());
+    exec_ctx_->SetNumConcurrentEstimate(std::min<std::size_t>(tbb::info::default_concurrency(), sources->size()));
+    tbb::parallel_for(std::size_t{0}, sources->size(), [&](const std::size_t idx) {
+        auto  pre_hook = static_cast<uint32_t>(HookOffsets::StartHook);
+        auto  post_hook = static_cast<uint32_t>(HookOffsets::EndHook);
+        auto *tls = thread_state_container->AccessCurrentThreadState();
+        exec_ctx_->InvokeHook(pre_hook, tls, nullptr);
+
+        auto *source = (*sources)[idx];
+        auto  for_each_entry = [&for_each_source_entry, source](auto &&f) {
+            for_each_source_entry(source, f);
+        };
+        RadixScatter(for_each_entry, shift1, fanout1 - 1, offsets[idx].data(), pass1.data());
+        exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(source->entries_.size()));
+    });
+    exec_ctx_->SetNumConcurrentEstimate(0);
+
+    // Second pass: sub-partition every first-pass partition on the next bits.
+    MemPoolVector<HashTableEntry *> pass2(bits2 != 0 ? num_entries : 0, exec_ctx_->GetMemoryPool());
+    std::vector<uint64_t>           bounds(num_partitions + 1);
+    if (bits2 == 0) {
+        bounds = bounds1;
+    } else {
+        tbb::parallel_for(uint64_t{0}, fanout1, [&](const uint64_t part1) {
+            const uint64_t        begin = bounds1[part1], end = bounds1[part1 + 1];
+            std::vector<uint64_t> part_offsets(fanout2, 0);
+            for (uint64_t idx = begin; idx < end; idx++) {
+                part_offsets[RadixPartitionOf(pass1[idx]->hash_, shift2, fanout2 - 1)]++;
+            }
+            for (uint64_t part2 = 0, pos = begin; part2 < fanout2; part2++) {
+                bounds[part1 * fanout2 + part2] = pos;
+                const uint64_t count = part_offsets[part2];
+                part_offsets[part2] = pos;
+                pos += count;
+            }
+            auto for_each_entry = [&](auto &&f) {
+                for (uint64_t idx = begin; idx < end; idx++) {
+                    f(pass1[idx]);
+                }
+            };
+            RadixScatter(for_each_entry, shift2, fanout2 - 1, part_offsets.data(), pass2.data());
+        });
+        bounds[num_partitions] = num_entries;
+    }
+
+    // Build every partition's slice of the directory independently. A slice is
+    // only written by its own partition, so no synchronization is needed.
+    const auto &partitioned = (bits2 == 0 ? pass1 : pass2);
+    tbb::parallel_for(uint64_t{0}, num_partitions, [&](const uint64_t part) {
+        HashTableEntry **directory = &radix_directory_[part << radix_bucket_bits_];
+        for (uint64_t idx = bounds[part]; idx < bounds[part + 1]; idx++) {
+            HashTableEntry *entry = partitioned[idx];
+            HashTableEntry *&head = directory[entry->hash_ & radix_bucket_mask_];
+            entry->next_ = head;
+            head = entry;
+        }
+    });
+
+    // Finally, take ownership of the memory of all sources.
+    for (auto *source : *sources) {
+        TakeSpillFile(source);
+    }
+    common::SpinLatch::ScopedSpinLatch latch(&owned_latch_);
+    for (auto *source : *sources) {
+        owned_.emplace_back(std::move(source->entries_));
+    }
+}
+
 void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container, const std::size_t jht_offset) {
     // Collect thread-local hash tables
     std::vector<JoinHashTable *> tl_join_tables;
@@ -593,18 +862,45 @@ void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container,
         hll_estimator_->Merge(jht->hll_estimator_.get());
     }
 
-    // Size the global hash table
-    uint64_t num_elem_estimate = hll_estimator_->Estimate();
-    chaining_hash_table_.SetSize(num_elem_estimate, tracker_);
-
     // Resize the owned entries vector now to avoid resizing concurrently during
     // merge. All the thread-local join table data will get placed into our owned
     // entries vector.
     owned_.reserve(tl_join_tables.size());
 
+    // Map the spill files of the thread-local tables up front, so they're never mapped concurrently.
+    for (auto *jht : tl_join_tables) {
+        if (jht->spill_file_ != nullptr) {
+            jht->spill_file_->Map();
+        }
+    }
+
     util::Timer<std::milli> timer;
     timer.Start();
 
+    // If the build side is not expected to fit in cache, inserting into one
+    // global table misses the cache and TLB on every insertion and probe. Radix
+    // partition it into cache-sized partitions instead.
+    uint64_t   num_elem_estimate = hll_estimator_->Estimate();
+    const bool use_radix_partitions
+        = merge_mode_ == MergeMode::RadixPartitioned
+       || (merge_mode_ == MergeMode::Automatic
+           && num_elem_estimate * entries_.ElementSize() > CpuInfo::Instance()->GetCacheSize(CpuInfo::L3_CACHE));
+    if (use_radix_partitions) {
+        MergeRadixPartitioned(thread_state_container, &tl_join_tables);
+        timer.Stop();
+        EXECUTION_LOG_TRACE("JHT: Radix merged {} JHTs into {} partitions. Estimated {}, actual {}. Time: {:.2f} ms",
+                            tl_join_tables.size(),
+                            GetNumRadixPartitions(),
+                            num_elem_estimate,
+                            GetTupleCount(),
+                            timer.GetElapsed());
+        built_ = true;
+        return;
+    }
+
+    // Size the global hash table
+    chaining_hash_table_.SetSize(num_elem_estimate, tracker_);
+
     const bool use_serial_build = num_elem_estimate < DEFAULT_MIN_SIZE_FOR_PARALLEL_MERGE;
     if (use_serial_build) {
         // TODO(pmenon): Switch to parallel-mode if estimate is wrong.
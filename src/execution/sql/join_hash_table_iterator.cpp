@@ -6,9 +6,14 @@ JoinHashTableIterator::JoinHashTableIterator(const JoinHashTable &table)
     : entry_list_iter_(table.owned_.begin())
     , entry_list_end_(table.owned_.end())
     , entry_iter_(table.entries_.begin())
-    , entry_end_(table.entries_.end()) {
+    , entry_end_(table.entries_.end())
+    , spill_file_iter_(table.owned_spill_files_.begin())
+    , spill_file_end_(table.owned_spill_files_.end())
+    , spilled_entry_(nullptr)
+    , spilled_end_(nullptr)
+    , entry_size_(table.entries_.ElementSize()) {
     NOISEPAGE_ASSERT(table.IsBuilt(), "Cannot iterate over a JoinHashTable that hasn't been built yet!");
-    if (!table.owned_.empty()) {
+    if (entry_iter_ == entry_end_) {
         FindNextNonEmptyList();
     }
 }
@@ -18,6 +23,14 @@ void JoinHashTableIterator::FindNextNonEmptyList() {
         entry_iter_ = entry_list_iter_->begin();
         entry_end_ = entry_list_iter_->end();
     }
+    if (entry_iter_ != entry_end_) {
+        return;
+    }
+    // The spill files were all mapped when the table was built.
+    for (; spill_file_iter_ != spill_file_end_ && spilled_entry_ == spilled_end_; ++spill_file_iter_) {
+        spilled_entry_ = (*spill_file_iter_)->Map();
+        spilled_end_ = spilled_entry_ + (*spill_file_iter_)->GetSize();
+    }
 }
 
 } // namespace noisepage::execution::sql
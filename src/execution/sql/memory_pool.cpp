@@ -62,6 +62,10 @@ void MemoryPool::Deallocate(void *ptr, std::size_t size) {
     }
 }
 
+auto MemoryPool::IsOverBudget() const -> bool {
+    return tracker_ != nullptr && tracker_->IsOverBudget();
+}
+
 void MemoryPool::SetMMapSizeThreshold(const std::size_t size) {
     mmap_threshold = size;
 }
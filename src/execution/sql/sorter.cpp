@@ -33,18 +33,25 @@ Sorter::Sorter(exec::ExecutionContext *exec_ctx, ComparisonFunction cmp_fn, uint
     , owned_tuples_(exec_ctx->GetMemoryPool())
     , cmp_fn_(cmp_fn)
     , tuples_(exec_ctx->GetMemoryPool())
-    , sorted_(false) {}
+    , sorted_(false)
+    , num_spilled_tuples_(0) {}
 
 Sorter::~Sorter() = default;
 
 auto Sorter::AllocInputTuple() -> byte * {
+    if (UNLIKELY(NeedsToSpill())) {
+        SpillRun();
+    }
     byte *ret = tuple_storage_.Append();
     tuples_.push_back(ret);
     return ret;
 }
 
 auto Sorter::AllocInputTupleTopK([[maybe_unused]] uint64_t top_k) -> byte * {
-    return AllocInputTuple();
+    // The heap of the top-K tuples must stay in memory, so never spill.
+    byte *ret = tuple_storage_.Append();
+    tuples_.push_back(ret);
+    return ret;
 }
 
 void Sorter::AllocInputTupleTopKFinish(const uint64_t top_k) {
@@ -112,12 +119,86 @@ void Sorter::HeapSiftDown() {
     tuples_[idx] = top;
 }
 
+void Sorter::SpillRun() {
+    const auto compare = [this](const byte *left, const byte *right) {
+        return cmp_fn_(left, right) < 0;
+    };
+    ips4o::sort(tuples_.begin(), tuples_.end(), compare);
+
+    // Append the run to the run file, in sorted order
+    if (run_file_ == nullptr) {
+        run_file_ = std::make_unique<SpillFile>(exec_ctx_->GetExecutionSettings().GetSpillDirectory());
+    }
+    const std::size_t tuple_size = tuple_storage_.ElementSize();
+    for (const byte *tuple : tuples_) {
+        run_file_->Append(tuple, tuple_size);
+    }
+    run_sizes_.push_back(tuples_.size());
+    num_spilled_tuples_ += tuples_.size();
+
+    EXECUTION_LOG_DEBUG("Spilled sorted run of {} tuples ({} runs, {} tuples spilled)",
+                        tuples_.size(),
+                        run_sizes_.size(),
+                        num_spilled_tuples_);
+
+    // Release the memory of the spilled tuples
+    tuples_.clear();
+    tuple_storage_ = decltype(tuple_storage_)(tuple_size, MemoryPoolAllocator<byte>(memory_));
+}
+
+void Sorter::MergeSpilledRuns() {
+    // The tuples still buffered form the last run
+    if (!tuples_.empty()) {
+        SpillRun();
+    }
+
+    // Merge the runs through a heap over the next tuple of every run. Each run is
+    // read sequentially from the mapped run file. The merged order points into the
+    // mapped runs, so the tuples are never buffered in memory again.
+    using Range = std::pair<const byte *, const byte *>;
+    const auto heap_cmp = [this](const Range &l, const Range &r) {
+        return cmp_fn_(l.first, r.first) >= 0;
+    };
+    std::priority_queue<Range, std::vector<Range>, decltype(heap_cmp)> heap(heap_cmp);
+
+    const std::size_t tuple_size = tuple_storage_.ElementSize();
+    const byte       *run_start = run_file_->Map();
+    for (const uint64_t run_size : run_sizes_) {
+        heap.emplace(run_start, run_start + run_size * tuple_size);
+        run_start += run_size * tuple_size;
+    }
+
+    tuples_.reserve(num_spilled_tuples_);
+    while (!heap.empty()) {
+        auto [next, end] = heap.top();
+        heap.pop();
+        tuples_.push_back(next);
+        if (next + tuple_size != end) {
+            heap.emplace(next + tuple_size, end);
+        }
+    }
+
+    run_sizes_.clear();
+    num_spilled_tuples_ = 0;
+}
+
 void Sorter::Sort() {
     // Exit if the input tuples have already been sorted
     if (IsSorted()) {
         return;
     }
 
+    // If tuples were spilled, this is an external sort: merge the sorted runs
+    if (HasSpilledRuns()) {
+        util::Timer<std::milli> timer;
+        timer.Start();
+        MergeSpilledRuns();
+        timer.Stop();
+        EXECUTION_LOG_DEBUG("Merged {} spilled tuples in {} ms", tuples_.size(), timer.GetElapsed());
+        sorted_ = true;
+        return;
+    }
+
     // Exit if there are no input tuples
     if (tuples_.empty()) {
         return;
@@ -203,12 +284,22 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
         // Reserve room for all tuples
         tuples_.reserve(num_tuples);
         for (auto *tl_sorter : tl_sorters) {
+            // Thread-local sorters that spilled merge their runs first, so that all of their tuples
+            // are in their 'tuples_'
+            if (tl_sorter->HasSpilledRuns()) {
+                tl_sorter->Sort();
+            }
             tuples_.insert(tuples_.end(), tl_sorter->tuples_.begin(), tl_sorter->tuples_.end());
             owned_tuples_.emplace_back(std::move(tl_sorter->tuple_storage_));
+            if (tl_sorter->run_file_ != nullptr) {
+                owned_run_files_.emplace_back(std::move(tl_sorter->run_file_));
+            }
             tl_sorter->tuples_.clear();
         }
 
-        // Single-threaded sort
+        // Single-threaded sort. A single thread-local sorter that merged its spilled runs is sorted
+        // already.
+        sorted_ = (tl_sorters.size() == 1 && tl_sorters[0]->IsSorted());
         Sort();
 
         // Finish
@@ -425,6 +516,9 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
     owned_tuples_.reserve(tl_sorters.size());
     for (auto *tl_sorter : tl_sorters) {
         owned_tuples_.emplace_back(std::move(tl_sorter->tuple_storage_));
+        if (tl_sorter->run_file_ != nullptr) {
+            owned_run_files_.emplace_back(std::move(tl_sorter->run_file_));
+        }
         tl_sorter->tuples_.clear();
     }
 
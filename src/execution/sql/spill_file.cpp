@@ -0,0 +1,100 @@
+#include "execution/sql/spill_file.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "common/error/error_code.h"
+#include "common/error/exception.h"
+#include "loggers/execution_logger.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage::execution::sql {
+
+SpillFile::SpillFile(const std::string &directory)
+    : fd_(-1)
+    , buffer_(std::make_unique<byte[]>(WRITE_BUFFER_SIZE))
+    , buffer_size_(0)
+    , size_(0)
+    , mapping_(nullptr) {
+    std::string path = directory;
+    if (path.empty() || path.back() != '/') {
+        path += '/';
+    }
+    path += "noisepage_spill_XXXXXX";
+
+    fd_ = mkstemp(path.data());
+    if (fd_ == -1) {
+        throw EXECUTION_EXCEPTION(fmt::format("Could not create spill file in {}: {}", directory, strerror(errno)),
+                                  common::ErrorCode::ERRCODE_IO_ERROR);
+    }
+
+    // Nobody opens the file by name, so remove it now. It's deleted when the descriptor is closed.
+    unlink(path.c_str());
+    EXECUTION_LOG_TRACE("Created spill file {}", path);
+}
+
+SpillFile::~SpillFile() {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, size_);
+    }
+    close(fd_);
+}
+
+void SpillFile::Append(const byte *data, std::size_t size) {
+    NOISEPAGE_ASSERT(!IsMapped(), "Cannot append to a mapped spill file");
+    while (size > 0) {
+        const uint64_t num_bytes = std::min<uint64_t>(size, WRITE_BUFFER_SIZE - buffer_size_);
+        std::memcpy(buffer_.get() + buffer_size_, data, num_bytes);
+        buffer_size_ += num_bytes;
+        data += num_bytes;
+        size -= num_bytes;
+        if (buffer_size_ == WRITE_BUFFER_SIZE) {
+            Flush();
+        }
+    }
+}
+
+void SpillFile::Flush() {
+    const byte *data = buffer_.get();
+    while (buffer_size_ > 0) {
+        const ssize_t written = write(fd_, data, buffer_size_);
+        if (written == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            const auto code
+                = (errno == ENOSPC ? common::ErrorCode::ERRCODE_DISK_FULL : common::ErrorCode::ERRCODE_IO_ERROR);
+            throw EXECUTION_EXCEPTION(fmt::format("Could not write to spill file: {}", strerror(errno)), code);
+        }
+        data += written;
+        buffer_size_ -= written;
+        size_ += written;
+    }
+}
+
+auto SpillFile::Map() -> byte * {
+    if (IsMapped()) {
+        return mapping_;
+    }
+
+    Flush();
+    if (size_ == 0) {
+        return nullptr;
+    }
+
+    void *mapping = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+        throw EXECUTION_EXCEPTION(fmt::format("Could not map spill file: {}", strerror(errno)),
+                                  common::ErrorCode::ERRCODE_IO_ERROR);
+    }
+    mapping_ = reinterpret_cast<byte *>(mapping);
+    return mapping_;
+}
+
+} // namespace noisepage::execution::sql
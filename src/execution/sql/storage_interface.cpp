@@ -101,10 +101,13 @@ void StorageInterface::IndexDelete(storage::TupleSlot table_tuple_slot) {
 
 auto StorageInterface::IndexInsertWithTuple(storage::TupleSlot table_tuple_slot, bool unique) -> bool {
     NOISEPAGE_ASSERT(need_indexes_, "Index PR not allocated!");
-    if (unique) {
-        return curr_index_->InsertUnique(exec_ctx_->GetTxn(), *index_pr_, table_tuple_slot);
-    }
-    return curr_index_->Insert(exec_ctx_->GetTxn(), *index_pr_, table_tuple_slot);
+    // Only CREATE INDEX inserts through here, so the key is staged and the index is built in IndexBuildFinish().
+    return curr_index_->BulkBuildInsert(exec_ctx_->GetTxn(), *index_pr_, table_tuple_slot);
+}
+
+auto StorageInterface::IndexBuildFinish() -> bool {
+    NOISEPAGE_ASSERT(need_indexes_, "Index PR not allocated!");
+    return curr_index_->BulkBuildFinish(exec_ctx_->GetTxn());
 }
 
 } // namespace noisepage::execution::sql
@@ -85,6 +85,19 @@ auto TableVectorIterator::InitTempTable(common::ManagedPointer<storage::SqlTable
     return Init(cte_table, schema, 0, storage::DataTable::GetMaxBlocks());
 }
 
+void TableVectorIterator::AddBlockFilter(const uint32_t col_oid, const int64_t min, const int64_t max) {
+    if (!IsInitialized()) {
+        return;
+    }
+    const storage::BlockLayout &layout = table_->table_.layout_;
+    const storage::col_id_t     col_id = table_->GetColumnMap().at(catalog::col_oid_t{col_oid});
+    // Zone maps are only kept for fixed-length columns
+    if (layout.IsVarlen(col_id) || !storage::ColumnZoneMap::Tracks(layout.AttrSize(col_id))) {
+        return;
+    }
+    block_filters_.push_back({col_id, min, max});
+}
+
 auto TableVectorIterator::Advance() -> bool {
     // Cannot advance if not initialized.
     if (!IsInitialized()) {
@@ -97,7 +110,7 @@ auto TableVectorIterator::Advance() -> bool {
     }
 
     // Otherwise, scan the table to set the vector projection.
-    table_->Scan(exec_ctx_->GetTxn(), iter_.get(), &vector_projection_);
+    table_->Scan(exec_ctx_->GetTxn(), iter_.get(), &vector_projection_, block_filters_);
     vector_projection_iterator_.SetVectorProjection(&vector_projection_);
 
     return true;
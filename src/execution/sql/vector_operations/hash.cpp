@@ -1,13 +1,34 @@
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include "common/error/error_code.h"
 #include "common/error/exception.h"
-#include "execution/sql/operators/hash_operators.h"
+#include "common/hash_util.h"
+#include "execution/sql/tuple_id_list.h"
 #include "execution/sql/vector_operations/vector_operations.h"
+#include "execution/util/cpu_info.h"
 #include "spdlog/fmt/fmt.h"
 
 namespace noisepage::execution::sql {
 
 namespace {
 
+    // Batched hashing:
+    // ----------------
+    // Vectorized hashing must produce exactly the hashes of the tuple-at-a-time operators in hash_operators.h, since
+    // both feed the same hash tables. Fixed-width values use HashUtil::HashCrc(), which computes two CRCs of the value,
+    // one from the seed and one from a fixed constant, and mixes them with a multiply. CRC is linear, so
+    // crc(seed, v) == crc(seed, 0) ^ crc(0, v). One CRC of each value is enough, and the fixed constant's part is
+    // computed once. The kernels first write the two CRCs of every value packed in one word, then multiply all words
+    // with SIMD, selected through CpuInfo at runtime.
+    //
+    // Strings are hashed like VarlenEntry::Hash(): inlined strings with CRC over their inlined bytes, longer strings
+    // with XXH3 over their out-of-line contents. Inlined strings are hashed in one pass while collecting the longer
+    // strings, which are hashed in a second pass. This keeps the branch on string length out of the hashing loops.
+
     void CheckHashArguments(const Vector &input, Vector *result) {
         if (result->GetTypeId() != TypeId::Hash) {
             throw EXECUTION_EXCEPTION(fmt::format("Output of Hash() operation must be hash, but is type {}.",
@@ -16,47 +37,244 @@ namespace {
         }
     }
 
-    template <typename InputType>
-    void TemplatedHashOperation(const Vector &input, Vector *result) {
-        auto *RESTRICT input_data = reinterpret_cast<InputType *>(input.GetData());
-        auto *RESTRICT result_data = reinterpret_cast<hash_t *>(result->GetData());
+    // The positions to hash: either all positions below a count, or those in a selection vector.
+    class Positions {
+    public:
+        explicit Positions(const Vector &input) {
+            if (const TupleIdList *tid_list = input.GetFilteredTupleIdList(); tid_list != nullptr) {
+                NOISEPAGE_ASSERT(tid_list->GetCapacity() <= common::Constants::K_DEFAULT_VECTOR_SIZE,
+                                 "TID list too large");
+                count_ = tid_list->ToSelectionVector(sel_vector_);
+                dense_ = false;
+            } else {
+                NOISEPAGE_ASSERT(input.GetSize() <= common::Constants::K_DEFAULT_VECTOR_SIZE, "Vector too large");
+                count_ = input.GetSize();
+                dense_ = true;
+            }
+        }
 
-        result->Resize(input.GetSize());
-        result->GetMutableNullMask()->Reset();
-        result->SetFilteredTupleIdList(input.GetFilteredTupleIdList(), input.GetCount());
+        template <typename F>
+        void ForEach(F f) const {
+            if (dense_) {
+                for (uint32_t i = 0; i < count_; i++) {
+                    f(i);
+                }
+            } else {
+                for (uint32_t k = 0; k < count_; k++) {
+                    f(sel_vector_[k]);
+                }
+            }
+        }
 
-        if (input.GetNullMask().Any()) {
-            VectorOps::Exec(input, [&](uint64_t i, uint64_t k) {
-                result_data[i] = noisepage::execution::sql::Hash<InputType>{}(input_data[i], input.GetNullMask()[i]);
-            });
+        bool IsDense() const {
+            return dense_;
+        }
+
+        uint32_t GetCount() const {
+            return count_;
+        }
+
+    private:
+        alignas(common::Constants::CACHELINE_SIZE) sel_t sel_vector_[common::Constants::K_DEFAULT_VECTOR_SIZE];
+        uint32_t count_;
+        bool     dense_;
+    };
+
+    // ---------------------------------------------------------
+    // Multiply kernels
+    // ---------------------------------------------------------
+
+    using MultiplyFn = void (*)(hash_t *, uint32_t);
+
+    void MultiplyScalar(hash_t *hashes, uint32_t n) {
+        for (uint32_t i = 0; i < n; i++) {
+            hashes[i] *= common::HashUtil::K_CRC_MULTIPLIER;
+        }
+    }
+
+    // There is no 64-bit multiply before AVX-512DQ, so the low 64 bits of each product are assembled from 32-bit
+    // multiplies: (hi:lo) * (mhi:mlo) = lo * mlo + ((hi * mlo + lo * mhi) << 32), modulo 2^64.
+    __attribute__((target("avx2"))) void MultiplyAvx2(hash_t *hashes, uint32_t n) {
+        const __m256i mul_lo = _mm256_set1_epi64x(common::HashUtil::K_CRC_MULTIPLIER);
+        const __m256i mul_hi = _mm256_srli_epi64(mul_lo, 32);
+
+        uint32_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            auto         *ptr = reinterpret_cast<__m256i *>(hashes + i);
+            const __m256i x = _mm256_loadu_si256(ptr);
+            const __m256i lo_lo = _mm256_mul_epu32(x, mul_lo);
+            const __m256i cross
+                = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), mul_lo), _mm256_mul_epu32(x, mul_hi));
+            _mm256_storeu_si256(ptr, _mm256_add_epi64(lo_lo, _mm256_slli_epi64(cross, 32)));
+        }
+
+        // Tail
+        MultiplyScalar(hashes + i, n - i);
+    }
+
+    __attribute__((target("avx512f"))) void MultiplyAvx512(hash_t *hashes, uint32_t n) {
+        const __m512i mul_lo = _mm512_set1_epi64(common::HashUtil::K_CRC_MULTIPLIER);
+        const __m512i mul_hi = _mm512_srli_epi64(mul_lo, 32);
+
+        uint32_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const __m512i x = _mm512_loadu_si512(hashes + i);
+            const __m512i lo_lo = _mm512_mul_epu32(x, mul_lo);
+            const __m512i cross
+                = _mm512_add_epi64(_mm512_mul_epu32(_mm512_srli_epi64(x, 32), mul_lo), _mm512_mul_epu32(x, mul_hi));
+            _mm512_storeu_si512(hashes + i, _mm512_add_epi64(lo_lo, _mm512_slli_epi64(cross, 32)));
+        }
+
+        // Tail
+        MultiplyScalar(hashes + i, n - i);
+    }
+
+    auto SelectMultiply() -> MultiplyFn {
+        const CpuInfo *cpu_info = CpuInfo::Instance();
+        if (cpu_info->HasFeature(CpuInfo::AVX512)) {
+            return MultiplyAvx512;
+        }
+        if (cpu_info->HasFeature(CpuInfo::AVX2)) {
+            return MultiplyAvx2;
+        }
+        return MultiplyScalar;
+    }
+
+    // Multiply the packed CRCs at the given positions, finishing their hashes.
+    void MultiplyHashes(const Positions &positions, hash_t *RESTRICT result_data) {
+        static const MultiplyFn multiply = SelectMultiply();
+        if (positions.IsDense()) {
+            multiply(result_data, positions.GetCount());
         } else {
-            VectorOps::Exec(input, [&](uint64_t i, uint64_t k) {
-                result_data[i] = noisepage::execution::sql::Hash<InputType>{}(input_data[i], false);
+            positions.ForEach([&](uint64_t i) {
+                result_data[i] *= common::HashUtil::K_CRC_MULTIPLIER;
             });
         }
     }
 
-    template <typename InputType>
-    void TemplatedHashCombineOperation(const Vector &input, Vector *result) {
-        auto *RESTRICT input_data = reinterpret_cast<InputType *>(input.GetData());
-        auto *RESTRICT result_data = reinterpret_cast<hash_t *>(result->GetData());
+    // ---------------------------------------------------------
+    // Fixed-width values
+    // ---------------------------------------------------------
 
+    // The value HashUtil::HashCrc() computes the CRCs of.
+    template <typename T>
+    uint64_t CrcInput(const T &val) {
+        if constexpr (std::is_arithmetic_v<T>) { // NOLINT
+            return static_cast<uint64_t>(val);
+        } else {
+            // Dates and timestamps hash their native representation
+            static_assert(sizeof(T) == sizeof(typename T::NativeType), "Unexpected layout");
+            typename T::NativeType native;
+            std::memcpy(&native, &val, sizeof(native));
+            return static_cast<uint64_t>(native);
+        }
+    }
+
+    template <typename InputType, bool Combine>
+    void TemplatedHashFixedWidth(const Vector &input, const Positions &positions, hash_t *RESTRICT result_data) {
+        const auto *RESTRICT input_data = reinterpret_cast<const InputType *>(input.GetData());
+
+        // The CRC of the fixed seed, whose part of every hash is the same
+        static const uint64_t fixed_seed_crc = _mm_crc32_u64(common::HashUtil::K_CRC_SEED, 0);
+
+        positions.ForEach([&](uint64_t i) {
+            const uint64_t value_crc = _mm_crc32_u64(0, CrcInput(input_data[i]));
+            const uint64_t seed_crc = Combine ? _mm_crc32_u64(result_data[i], 0) : 0;
+            result_data[i] = ((value_crc ^ fixed_seed_crc) << 32u) | (value_crc ^ seed_crc);
+        });
+
+        MultiplyHashes(positions, result_data);
+    }
+
+    // ---------------------------------------------------------
+    // Strings
+    // ---------------------------------------------------------
+
+    template <bool Combine>
+    void HashStrings(const Vector &input, const Positions &positions, hash_t *RESTRICT result_data) {
+        const auto *RESTRICT input_data = reinterpret_cast<const storage::VarlenEntry *>(input.GetData());
+        const auto          &null_mask = input.GetNullMask();
+
+        // First pass: hash inlined strings, collecting non-NULL long strings. Long strings also get a CRC over their
+        // prefix, which is never read past the entry, but keep their seed for the second pass.
+        sel_t    long_strings[common::Constants::K_DEFAULT_VECTOR_SIZE];
+        uint32_t num_long_strings = 0;
+        positions.ForEach([&](uint64_t i) {
+            const storage::VarlenEntry &str = input_data[i];
+            const uint32_t inlined_size = std::min(str.Size(), storage::VarlenEntry::InlineThreshold());
+            const hash_t   seed = Combine ? result_data[i] : 0;
+            const bool     is_long = !str.IsInlined() && !null_mask[i];
+            const hash_t   crc
+                = common::HashUtil::HashCrc(reinterpret_cast<const uint8_t *>(str.Prefix()), inlined_size, seed);
+            long_strings[num_long_strings] = i;
+            num_long_strings += static_cast<uint32_t>(is_long);
+            result_data[i] = is_long ? seed : crc;
+        });
+
+        // Second pass: hash long strings
+        for (uint32_t k = 0; k < num_long_strings; k++) {
+            const sel_t                 i = long_strings[k];
+            const storage::VarlenEntry &str = input_data[i];
+            const hash_t                seed = Combine ? result_data[i] : 0;
+            result_data[i]
+                = common::HashUtil::HashXX3(reinterpret_cast<const uint8_t *>(str.Content()), str.Size(), seed);
+        }
+    }
+
+    // ---------------------------------------------------------
+    // Dispatch
+    // ---------------------------------------------------------
+
+    template <bool Combine>
+    void HashOperation(const Vector &input, const Positions &positions, hash_t *RESTRICT result_data) {
+        switch (input.GetTypeId()) {
+        case TypeId::Boolean:
+            TemplatedHashFixedWidth<bool, Combine>(input, positions, result_data);
+            break;
+        case TypeId::TinyInt:
+            TemplatedHashFixedWidth<int8_t, Combine>(input, positions, result_data);
+            break;
+        case TypeId::SmallInt:
+            TemplatedHashFixedWidth<int16_t, Combine>(input, positions, result_data);
+            break;
+        case TypeId::Integer:
+            TemplatedHashFixedWidth<int32_t, Combine>(input, positions, result_data);
+            break;
+        case TypeId::BigInt:
+            TemplatedHashFixedWidth<int64_t, Combine>(input, positions, result_data);
+            break;
+        case TypeId::Float:
+            TemplatedHashFixedWidth<float, Combine>(input, positions, result_data);
+            break;
+        case TypeId::Double:
+            TemplatedHashFixedWidth<double, Combine>(input, positions, result_data);
+            break;
+        case TypeId::Date:
+            TemplatedHashFixedWidth<Date, Combine>(input, positions, result_data);
+            break;
+        case TypeId::Timestamp:
+            TemplatedHashFixedWidth<Timestamp, Combine>(input, positions, result_data);
+            break;
+        case TypeId::Varchar:
+            HashStrings<Combine>(input, positions, result_data);
+            break;
+        default:
+            throw NOT_IMPLEMENTED_EXCEPTION(
+                fmt::format("hashing vector type '{}'", TypeIdToString(input.GetTypeId())).data());
+        }
+
+        // NULLs hash to zero, whatever the seed
+        input.GetNullMask().IterateSetBits([&](uint32_t i) {
+            result_data[i] = hash_t(0);
+        });
+    }
+
+    // Prepare the result vector to hold the hashes of the input, returning its data.
+    hash_t *PrepareResult(const Vector &input, Vector *result) {
         result->Resize(input.GetSize());
         result->GetMutableNullMask()->Reset();
         result->SetFilteredTupleIdList(input.GetFilteredTupleIdList(), input.GetCount());
-
-        if (input.GetNullMask().Any()) {
-            VectorOps::Exec(input, [&](uint64_t i, uint64_t k) {
-                result_data[i] = noisepage::execution::sql::HashCombine<InputType>{}(input_data[i],
-                                                                                     input.GetNullMask()[i],
-                                                                                     result_data[i]);
-            });
-        } else {
-            VectorOps::Exec(input, [&](uint64_t i, uint64_t k) {
-                result_data[i]
-                    = noisepage::execution::sql::HashCombine<InputType>{}(input_data[i], false, result_data[i]);
-            });
-        }
+        return reinterpret_cast<hash_t *>(result->GetData());
     }
 
 } // namespace
@@ -66,41 +284,9 @@ void VectorOps::Hash(const Vector &input, Vector *result) {
     CheckHashArguments(input, result);
 
     // Lift-off
-    switch (input.GetTypeId()) {
-    case TypeId::Boolean:
-        TemplatedHashOperation<bool>(input, result);
-        break;
-    case TypeId::TinyInt:
-        TemplatedHashOperation<int8_t>(input, result);
-        break;
-    case TypeId::SmallInt:
-        TemplatedHashOperation<int16_t>(input, result);
-        break;
-    case TypeId::Integer:
-        TemplatedHashOperation<int32_t>(input, result);
-        break;
-    case TypeId::BigInt:
-        TemplatedHashOperation<int64_t>(input, result);
-        break;
-    case TypeId::Float:
-        TemplatedHashOperation<float>(input, result);
-        break;
-    case TypeId::Double:
-        TemplatedHashOperation<double>(input, result);
-        break;
-    case TypeId::Date:
-        TemplatedHashOperation<Date>(input, result);
-        break;
-    case TypeId::Timestamp:
-        TemplatedHashOperation<Timestamp>(input, result);
-        break;
-    case TypeId::Varchar:
-        TemplatedHashOperation<storage::VarlenEntry>(input, result);
-        break;
-    default:
-        throw NOT_IMPLEMENTED_EXCEPTION(
-            fmt::format("hashing vector type '{}'", TypeIdToString(input.GetTypeId())).data());
-    }
+    hash_t         *result_data = PrepareResult(input, result);
+    const Positions positions(input);
+    HashOperation<false>(input, positions, result_data);
 }
 
 void VectorOps::HashCombine(const Vector &input, Vector *result) {
@@ -108,40 +294,33 @@ void VectorOps::HashCombine(const Vector &input, Vector *result) {
     CheckHashArguments(input, result);
 
     // Lift-off
-    switch (input.GetTypeId()) {
-    case TypeId::Boolean:
-        TemplatedHashCombineOperation<bool>(input, result);
-        break;
-    case TypeId::TinyInt:
-        TemplatedHashCombineOperation<int8_t>(input, result);
-        break;
-    case TypeId::SmallInt:
-        TemplatedHashCombineOperation<int16_t>(input, result);
-        break;
-    case TypeId::Integer:
-        TemplatedHashCombineOperation<int32_t>(input, result);
-        break;
-    case TypeId::BigInt:
-        TemplatedHashCombineOperation<int64_t>(input, result);
-        break;
-    case TypeId::Float:
-        TemplatedHashCombineOperation<float>(input, result);
-        break;
-    case TypeId::Double:
-        TemplatedHashCombineOperation<double>(input, result);
-        break;
-    case TypeId::Date:
-        TemplatedHashCombineOperation<Date>(input, result);
-        break;
-    case TypeId::Timestamp:
-        TemplatedHashCombineOperation<Timestamp>(input, result);
-        break;
-    case TypeId::Varchar:
-        TemplatedHashCombineOperation<storage::VarlenEntry>(input, result);
-        break;
-    default:
-        throw NOT_IMPLEMENTED_EXCEPTION(
-            fmt::format("hashing vector type '{}'", TypeIdToString(input.GetTypeId())).data());
+    hash_t         *result_data = PrepareResult(input, result);
+    const Positions positions(input);
+    HashOperation<true>(input, positions, result_data);
+}
+
+void VectorOps::Hash(const std::vector<const Vector *> &inputs, Vector *result) {
+    NOISEPAGE_ASSERT(!inputs.empty(), "Must provide at least one vector to hash.");
+
+    // Sanity check
+    const Vector &first = *inputs[0];
+    CheckHashArguments(first, result);
+    for (const Vector *input : inputs) {
+        if (input->GetSize() != first.GetSize() || input->GetFilteredTupleIdList() != first.GetFilteredTupleIdList()) {
+            throw EXECUTION_EXCEPTION(
+                fmt::format("Vectors to hash together must have the same size and filter, first size {} other size {}.",
+                            first.GetSize(),
+                            input->GetSize()),
+                common::ErrorCode::ERRCODE_INTERNAL_ERROR);
+        }
+    }
+
+    // Lift-off. The positions to hash are shared by all vectors, so they're collected once.
+    hash_t         *result_data = PrepareResult(first, result);
+    const Positions positions(first);
+    HashOperation<false>(first, positions, result_data);
+    for (uint32_t i = 1; i < inputs.size(); i++) {
+        HashOperation<true>(*inputs[i], positions, result_data);
     }
 }
 
@@ -1,15 +1,69 @@
+#include <cstring>
+#include <string_view>
+
 #include "common/error/error_code.h"
 #include "common/error/exception.h"
 #include "common/macros.h"
 #include "execution/sql/operators/like_operators.h"
 #include "execution/sql/tuple_id_list.h"
 #include "execution/sql/vector_operations/vector_operations.h"
+#include "execution/util/string_util.h"
 #include "spdlog/fmt/fmt.h"
 
 namespace noisepage::execution::sql {
 
 namespace {
 
+    // Most constant patterns are a literal with '%' wildcards only at its ends. These don't need the general matcher:
+    // they reduce to an equality, prefix, suffix or substring test on the literal, the last of which uses the SIMD
+    // substring search.
+    enum class PatternKind : uint8_t { Exact, Prefix, Suffix, Contains, Any, General };
+
+    struct Pattern {
+        PatternKind      kind_;
+        std::string_view literal_;
+    };
+
+    auto AnalyzePattern(std::string_view pattern) -> Pattern {
+        // '_' wildcards and escaped characters need the general matcher
+        if (pattern.find('_') != std::string_view::npos || pattern.find(DEFAULT_ESCAPE) != std::string_view::npos) {
+            return {PatternKind::General, pattern};
+        }
+
+        if (pattern.empty()) {
+            return {PatternKind::Exact, pattern};
+        }
+        const std::size_t begin = pattern.find_first_not_of('%');
+        if (begin == std::string_view::npos) {
+            return {PatternKind::Any, {}};
+        }
+        const std::size_t end = pattern.find_last_not_of('%') + 1;
+        const auto        literal = pattern.substr(begin, end - begin);
+        if (literal.find('%') != std::string_view::npos) {
+            return {PatternKind::General, pattern};
+        }
+
+        const bool leading = begin != 0, trailing = end != pattern.size();
+        if (leading && trailing) {
+            return {PatternKind::Contains, literal};
+        }
+        if (leading) {
+            return {PatternKind::Suffix, literal};
+        }
+        if (trailing) {
+            return {PatternKind::Prefix, literal};
+        }
+        return {PatternKind::Exact, literal};
+    }
+
+    template <typename Op, typename Matcher>
+    void FilterWithMatcher(const storage::VarlenEntry *RESTRICT a_data, TupleIdList *tid_list, Matcher matcher) {
+        constexpr bool negated = std::is_same_v<Op, sql::NotLike>;
+        tid_list->Filter([&](const uint64_t i) {
+            return matcher(a_data[i]) != negated;
+        });
+    }
+
     template <typename Op>
     void TemplatedLikeOperationVectorConstant(const Vector &a, const Vector &b, TupleIdList *tid_list) {
         if (b.IsNull(0)) {
@@ -24,9 +78,43 @@ namespace {
         tid_list->GetMutableBits()->Difference(a.GetNullMask());
 
         // Lift-off
-        tid_list->Filter([&](const uint64_t i) {
-            return Op{}(a_data[i], b_data[0]);
-        });
+        const auto [kind, literal] = AnalyzePattern(b_data[0].StringView());
+        switch (kind) {
+        case PatternKind::Exact:
+            FilterWithMatcher<Op>(a_data, tid_list, [literal = literal](const storage::VarlenEntry &str) {
+                return str.StringView() == literal;
+            });
+            break;
+        case PatternKind::Prefix:
+            FilterWithMatcher<Op>(a_data, tid_list, [literal = literal](const storage::VarlenEntry &str) {
+                return str.Size() >= literal.size() && std::memcmp(str.Content(), literal.data(), literal.size()) == 0;
+            });
+            break;
+        case PatternKind::Suffix:
+            FilterWithMatcher<Op>(a_data, tid_list, [literal = literal](const storage::VarlenEntry &str) {
+                return str.Size() >= literal.size()
+                       && std::memcmp(str.Content() + str.Size() - literal.size(), literal.data(), literal.size())
+                              == 0;
+            });
+            break;
+        case PatternKind::Contains:
+            FilterWithMatcher<Op>(a_data, tid_list, [literal = literal](const storage::VarlenEntry &str) {
+                const auto *content = reinterpret_cast<const char *>(str.Content());
+                return util::StringUtil::Find(content, str.Size(), literal.data(), literal.size()) != nullptr;
+            });
+            break;
+        case PatternKind::Any:
+            // Every non-NULL string matches
+            if constexpr (std::is_same_v<Op, sql::NotLike>) { // NOLINT
+                tid_list->Clear();
+            }
+            break;
+        case PatternKind::General:
+            tid_list->Filter([&](const uint64_t i) {
+                return Op{}(a_data[i], b_data[0]);
+            });
+            break;
+        }
     }
 
     template <typename Op>
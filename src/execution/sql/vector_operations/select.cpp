@@ -6,6 +6,7 @@
 #include "execution/sql/runtime_types.h"
 #include "execution/sql/tuple_id_list.h"
 #include "execution/sql/vector_operations/vector_operations.h"
+#include "execution/util/string_util.h"
 #include "spdlog/fmt/fmt.h"
 
 namespace noisepage::execution::sql {
@@ -77,6 +78,45 @@ namespace {
         }
     }
 
+    // String equality against a constant:
+    // -------------------------------------
+    // Every VarlenEntry stores its size and a four-byte prefix inline, so comparing them is safe on unselected or NULL
+    // entries, and can be done for the whole vector with SIMD. Strings whose size or prefix differ from the constant
+    // are decided by this prefilter alone. So are all strings when the constant is no longer than the prefix. Only the
+    // remaining candidates need their full contents compared. Like the full-compute optimization above, the prefilter
+    // only pays off when enough of the vector is selected.
+
+    template <bool EqualityCheck>
+    void SelectStringEqualityVectorConstant(const storage::VarlenEntry *left_data,
+                                            const storage::VarlenEntry &constant,
+                                            TupleIdList                *tid_list) {
+        uint64_t candidates[common::Constants::K_DEFAULT_VECTOR_SIZE / 64];
+        util::StringUtil::MatchSizeAndPrefix(left_data, tid_list->GetCapacity(), constant, candidates);
+
+        TupleIdList::BitVectorType *bit_vector = tid_list->GetMutableBits();
+        if constexpr (EqualityCheck) { // NOLINT
+            for (uint32_t i = 0; i < bit_vector->GetNumWords(); i++) {
+                bit_vector->SetWord(i, bit_vector->GetWord(i) & candidates[i]);
+            }
+            if (constant.Size() > storage::VarlenEntry::PrefixSize()) {
+                tid_list->Filter([&](uint64_t i) {
+                    return left_data[i] == constant;
+                });
+            }
+        } else {
+            if (constant.Size() > storage::VarlenEntry::PrefixSize()) {
+                tid_list->Filter([&](uint64_t i) {
+                    const bool is_candidate = ((candidates[i / 64] >> (i % 64)) & 1u) != 0;
+                    return !is_candidate || left_data[i] != constant;
+                });
+            } else {
+                for (uint32_t i = 0; i < bit_vector->GetNumWords(); i++) {
+                    bit_vector->SetWord(i, bit_vector->GetWord(i) & ~candidates[i]);
+                }
+            }
+        }
+    }
+
     template <typename T, typename Op>
     void TemplatedSelectOperationVectorConstant(const exec::ExecutionSettings &exec_settings,
                                                 const Vector                  &left,
@@ -108,6 +148,17 @@ namespace {
         // Remove all NULL entries from left input. Right constant is guaranteed non-NULL by this point.
         tid_list->GetMutableBits()->Difference(left.GetNullMask());
 
+        // String (in)equality prefilter. Refer to comment above SelectStringEqualityVectorConstant() for explanation.
+        constexpr bool is_equality = std::is_same_v<Op, Equal<T>>;
+        if constexpr (std::is_same_v<T, storage::VarlenEntry> && (is_equality || std::is_same_v<Op, NotEqual<T>>)) {
+            if (tid_list->GetCapacity() == left.GetSize()
+                && tid_list->GetCapacity() <= common::Constants::K_DEFAULT_VECTOR_SIZE
+                && exec_settings.GetSelectOptThreshold() <= tid_list->ComputeSelectivity()) {
+                SelectStringEqualityVectorConstant<is_equality>(left_data, constant, tid_list);
+                return;
+            }
+        }
+
         // Filter
         tid_list->Filter([&](uint64_t i) {
             return Op{}(left_data[i], constant);
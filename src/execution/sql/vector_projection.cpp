@@ -1,5 +1,6 @@
 #include "execution/sql/vector_projection.h"
 
+#include <algorithm>
 #include <memory>
 #include <numeric>
 #include <string>
@@ -154,10 +155,11 @@ void VectorProjection::ProjectColumns(const std::vector<uint32_t> &cols, VectorP
 
 void VectorProjection::Hash(const std::vector<uint32_t> &cols, Vector *result) const {
     NOISEPAGE_ASSERT(!cols.empty(), "Must provide at least one column to hash.");
-    VectorOps::Hash(*GetColumn(cols[0]), result);
-    for (uint32_t i = 1; i < cols.size(); i++) {
-        VectorOps::HashCombine(*GetColumn(cols[i]), result);
-    }
+    std::vector<const Vector *> inputs(cols.size());
+    std::transform(cols.begin(), cols.end(), inputs.begin(), [this](uint32_t col) {
+        return GetColumn(col);
+    });
+    VectorOps::Hash(inputs, result);
 }
 
 void VectorProjection::Hash(Vector *result) const {
@@ -1,5 +1,5 @@
-// #include "execution/util/csv_reader.h" Fix later.
-#if 0
+#include "execution/util/csv_reader.h"
+
 #include <immintrin.h>
 
 #include <cstring>
@@ -249,4 +249,3 @@ bool CSVReader::Advance() {
 }
 
 }  // namespace noisepage::execution::util
-#endif
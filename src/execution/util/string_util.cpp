@@ -0,0 +1,279 @@
+#include "execution/util/string_util.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+#include "execution/util/bit_util.h"
+#include "execution/util/cpu_info.h"
+
+namespace noisepage::execution::util {
+
+namespace {
+
+    // ---------------------------------------------------------
+    // Substring search
+    // ---------------------------------------------------------
+
+    using FindFn = const char *(*)(const char *, std::size_t, const char *, std::size_t);
+
+    auto FindScalar(const char *haystack, std::size_t haystack_len, const char *needle, std::size_t needle_len)
+        -> const char * {
+        const auto pos = std::string_view(haystack, haystack_len).find(std::string_view(needle, needle_len));
+        return pos == std::string_view::npos ? nullptr : haystack + pos;
+    }
+
+    // Compares the first 16 bytes of the needle against every position of a 16-byte block at once. A candidate is
+    // either a full match of those bytes, or a match of a prefix of them that runs off the end of the block; both are
+    // verified against the whole needle.
+    __attribute__((target("sse4.2"))) auto
+    FindSse42(const char *haystack, std::size_t haystack_len, const char *needle, std::size_t needle_len)
+        -> const char * {
+        if (needle_len <= 1 || needle_len > haystack_len) {
+            return FindScalar(haystack, haystack_len, needle, needle_len);
+        }
+
+        // Copy the needle so the load doesn't read past its end
+        const auto block_needle_len = static_cast<int>(std::min<std::size_t>(needle_len, 16));
+        alignas(16) char needle_block[16] = {0};
+        std::memcpy(needle_block, needle, block_needle_len);
+        const __m128i needle_reg = _mm_load_si128(reinterpret_cast<const __m128i *>(needle_block));
+
+        std::size_t i = 0;
+        while (i + 16 <= haystack_len) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(haystack + i));
+            const int     pos
+                = _mm_cmpestri(needle_reg, block_needle_len, block, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ORDERED);
+            if (pos == 16) {
+                i += 16;
+                continue;
+            }
+            const char *candidate = haystack + i + pos;
+            if (i + pos + needle_len <= haystack_len && std::memcmp(candidate, needle, needle_len) == 0) {
+                return candidate;
+            }
+            i += pos + 1;
+        }
+
+        // Tail
+        return FindScalar(haystack + i, haystack_len - i, needle, needle_len);
+    }
+
+    // Compares the first and the last byte of the needle against 32 consecutive positions at once, and only verifies
+    // the positions where both match.
+    __attribute__((target("avx2"))) auto
+    FindAvx2(const char *haystack, std::size_t haystack_len, const char *needle, std::size_t needle_len)
+        -> const char * {
+        if (needle_len <= 1 || needle_len > haystack_len) {
+            return FindScalar(haystack, haystack_len, needle, needle_len);
+        }
+
+        const __m256i first = _mm256_set1_epi8(needle[0]);
+        const __m256i last = _mm256_set1_epi8(needle[needle_len - 1]);
+
+        std::size_t i = 0;
+        for (; i + needle_len + 31 <= haystack_len; i += 32) {
+            const auto *block_first = reinterpret_cast<const __m256i *>(haystack + i);
+            const auto *block_last = reinterpret_cast<const __m256i *>(haystack + i + needle_len - 1);
+            const auto  eq_first = _mm256_cmpeq_epi8(first, _mm256_loadu_si256(block_first));
+            const auto  eq_last = _mm256_cmpeq_epi8(last, _mm256_loadu_si256(block_last));
+            auto        mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(eq_first, eq_last)));
+            while (mask != 0) {
+                const auto pos = BitUtil::CountTrailingZeros(mask);
+                if (std::memcmp(haystack + i + pos + 1, needle + 1, needle_len - 2) == 0) {
+                    return haystack + i + pos;
+                }
+                mask &= mask - 1;
+            }
+        }
+
+        // Tail
+        return FindScalar(haystack + i, haystack_len - i, needle, needle_len);
+    }
+
+    auto SelectFind() -> FindFn {
+        const CpuInfo *cpu_info = CpuInfo::Instance();
+        if (cpu_info->HasFeature(CpuInfo::AVX2)) {
+            return FindAvx2;
+        }
+        if (cpu_info->HasFeature(CpuInfo::SSE_4_2)) {
+            return FindSse42;
+        }
+        return FindScalar;
+    }
+
+    // ---------------------------------------------------------
+    // Case conversion
+    // ---------------------------------------------------------
+
+    using FlipCaseFn = void (*)(const char *, std::size_t, char *);
+
+    // Flips the case of the letters in [Lo, Hi]. Upper and lower case ASCII letters differ only in bit 5.
+    template <char Lo, char Hi>
+    void FlipCaseScalar(const char *src, std::size_t len, char *dst) {
+        for (std::size_t i = 0; i < len; i++) {
+            const char c = src[i];
+            dst[i] = (c >= Lo && c <= Hi) ? static_cast<char>(c ^ 0x20) : c;
+        }
+    }
+
+    template <char Lo, char Hi>
+    __attribute__((target("avx2"))) void FlipCaseAvx2(const char *src, std::size_t len, char *dst) {
+        // Bytes are compared as signed integers, so non-ASCII bytes are negative and never in range
+        const __m256i lo = _mm256_set1_epi8(Lo - 1);
+        const __m256i hi = _mm256_set1_epi8(Hi + 1);
+        const __m256i flip = _mm256_set1_epi8(0x20);
+
+        std::size_t i = 0;
+        for (; i + 32 <= len; i += 32) {
+            const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+            const __m256i in_range = _mm256_and_si256(_mm256_cmpgt_epi8(chars, lo), _mm256_cmpgt_epi8(hi, chars));
+            const __m256i result = _mm256_xor_si256(chars, _mm256_and_si256(in_range, flip));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), result);
+        }
+
+        // Tail
+        FlipCaseScalar<Lo, Hi>(src + i, len - i, dst + i);
+    }
+
+    template <char Lo, char Hi>
+    auto SelectFlipCase() -> FlipCaseFn {
+        if (CpuInfo::Instance()->HasFeature(CpuInfo::AVX2)) {
+            return FlipCaseAvx2<Lo, Hi>;
+        }
+        return FlipCaseScalar<Lo, Hi>;
+    }
+
+    // ---------------------------------------------------------
+    // Size and prefix matching
+    // ---------------------------------------------------------
+
+    using MatchSizeAndPrefixFn = void (*)(const storage::VarlenEntry *, uint32_t, uint64_t, uint64_t *);
+
+    // The size and the prefix of a VarlenEntry are its first eight bytes. As in VarlenEntry::CompareEqualOrNot(), the
+    // reclaim bit stored in the sign bit of the size is masked off.
+    constexpr uint64_t K_SIZE_AND_PREFIX_MASK = 0xffffffff7fffffff;
+
+    auto LoadSizeAndPrefix(const storage::VarlenEntry &entry) -> uint64_t {
+        uint64_t word;
+        std::memcpy(&word, &entry, sizeof(word));
+        return word & K_SIZE_AND_PREFIX_MASK;
+    }
+
+    // Matches the entries from position begin, which must be a multiple of 64, to the end.
+    void MatchSizeAndPrefixFrom(const storage::VarlenEntry *entries,
+                                uint32_t                    begin,
+                                uint32_t                    num_entries,
+                                uint64_t                    key,
+                                uint64_t                   *bit_vector) {
+        for (uint32_t i = begin; i < num_entries; i += 64) {
+            const uint32_t end = std::min(i + 64, num_entries);
+            uint64_t       word = 0;
+            for (uint32_t j = i; j < end; j++) {
+                word |= static_cast<uint64_t>(LoadSizeAndPrefix(entries[j]) == key) << (j - i);
+            }
+            bit_vector[i / 64] = word;
+        }
+    }
+
+    void MatchSizeAndPrefixScalar(const storage::VarlenEntry *entries,
+                                  uint32_t                    num_entries,
+                                  uint64_t                    key,
+                                  uint64_t                   *bit_vector) {
+        MatchSizeAndPrefixFrom(entries, 0, num_entries, key, bit_vector);
+    }
+
+    // Matches four 16-byte entries per step. Two loads hold the entries, and their leading words are gathered into one
+    // register to be compared against the key.
+    __attribute__((target("avx2"))) void MatchSizeAndPrefixAvx2(const storage::VarlenEntry *entries,
+                                                                uint32_t                    num_entries,
+                                                                uint64_t                    key,
+                                                                uint64_t                   *bit_vector) {
+        const __m256i mask = _mm256_set1_epi64x(K_SIZE_AND_PREFIX_MASK);
+        const __m256i key_reg = _mm256_set1_epi64x(key);
+
+        uint32_t i = 0;
+        for (; i + 64 <= num_entries; i += 64) {
+            uint64_t word = 0;
+            for (uint32_t j = 0; j < 64; j += 4) {
+                const auto   *ptr = reinterpret_cast<const __m256i *>(entries + i + j);
+                const __m256i lo = _mm256_loadu_si256(ptr);
+                const __m256i hi = _mm256_loadu_si256(ptr + 1);
+                // [e0, e2, e1, e3] -> [e0, e1, e2, e3]
+                const __m256i words = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(lo, hi), 0xd8);
+                const __m256i eq = _mm256_cmpeq_epi64(_mm256_and_si256(words, mask), key_reg);
+                word |= static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(eq))) << j;
+            }
+            bit_vector[i / 64] = word;
+        }
+
+        // Tail
+        MatchSizeAndPrefixFrom(entries, i, num_entries, key, bit_vector);
+    }
+
+    // Matches eight 16-byte entries per step, like the AVX2 version.
+    __attribute__((target("avx512f"))) void MatchSizeAndPrefixAvx512(const storage::VarlenEntry *entries,
+                                                                     uint32_t                    num_entries,
+                                                                     uint64_t                    key,
+                                                                     uint64_t                   *bit_vector) {
+        const __m512i mask = _mm512_set1_epi64(K_SIZE_AND_PREFIX_MASK);
+        const __m512i key_reg = _mm512_set1_epi64(key);
+        const __m512i leading_words = _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14);
+
+        uint32_t i = 0;
+        for (; i + 64 <= num_entries; i += 64) {
+            uint64_t word = 0;
+            for (uint32_t j = 0; j < 64; j += 8) {
+                const __m512i lo = _mm512_loadu_si512(entries + i + j);
+                const __m512i hi = _mm512_loadu_si512(entries + i + j + 4);
+                const __m512i words = _mm512_permutex2var_epi64(lo, leading_words, hi);
+                const __mmask8 eq = _mm512_cmpeq_epi64_mask(_mm512_and_si512(words, mask), key_reg);
+                word |= static_cast<uint64_t>(eq) << j;
+            }
+            bit_vector[i / 64] = word;
+        }
+
+        // Tail
+        MatchSizeAndPrefixFrom(entries, i, num_entries, key, bit_vector);
+    }
+
+    auto SelectMatchSizeAndPrefix() -> MatchSizeAndPrefixFn {
+        const CpuInfo *cpu_info = CpuInfo::Instance();
+        if (cpu_info->HasFeature(CpuInfo::AVX512)) {
+            return MatchSizeAndPrefixAvx512;
+        }
+        if (cpu_info->HasFeature(CpuInfo::AVX2)) {
+            return MatchSizeAndPrefixAvx2;
+        }
+        return MatchSizeAndPrefixScalar;
+    }
+
+} // namespace
+
+auto StringUtil::Find(const char *haystack, std::size_t haystack_len, const char *needle, std::size_t needle_len)
+    -> const char * {
+    static const FindFn find = SelectFind();
+    return find(haystack, haystack_len, needle, needle_len);
+}
+
+void StringUtil::ToLower(const char *src, std::size_t len, char *dst) {
+    static const FlipCaseFn to_lower = SelectFlipCase<'A', 'Z'>();
+    to_lower(src, len, dst);
+}
+
+void StringUtil::ToUpper(const char *src, std::size_t len, char *dst) {
+    static const FlipCaseFn to_upper = SelectFlipCase<'a', 'z'>();
+    to_upper(src, len, dst);
+}
+
+void StringUtil::MatchSizeAndPrefix(const storage::VarlenEntry *entries,
+                                    uint32_t                    num_entries,
+                                    const storage::VarlenEntry &key,
+                                    uint64_t                   *bit_vector) {
+    static const MatchSizeAndPrefixFn match = SelectMatchSizeAndPrefix();
+    match(entries, num_entries, LoadSizeAndPrefix(key), bit_vector);
+}
+
+} // namespace noisepage::execution::util
@@ -292,7 +292,7 @@ VectorUtil::BitVectorToSelectionVectorDenseAVX512(const uint64_t *bit_vector, ui
         _mm512_mask_compressstoreu_epi16(sel_vector + k, mask, indexes);
 
         // Bump indexes
-        _mm512_add_epi16(indexes, _32);
+        indexes = _mm512_add_epi16(indexes, _32);
         k += BitUtil::CountPopulation(mask);
 
         // Second word
@@ -300,7 +300,7 @@ VectorUtil::BitVectorToSelectionVectorDenseAVX512(const uint64_t *bit_vector, ui
         _mm512_mask_compressstoreu_epi16(sel_vector + k, mask, indexes);
 
         // Bump indexes again
-        _mm512_add_epi16(indexes, _32);
+        indexes = _mm512_add_epi16(indexes, _32);
         k += BitUtil::CountPopulation(mask);
     }
 
@@ -83,6 +83,9 @@ void BytecodeEmitter::EmitReturn() {
 void BytecodeEmitter::Bind(BytecodeLabel *label) {
     NOISEPAGE_ASSERT(!label->IsBound(), "Cannot rebind labels");
 
+    // A jump may land here, so the next instruction cannot be fused into the one before the label
+    last_instruction_.reset();
+
     std::size_t curr_offset = GetPosition();
 
     if (label->IsForwardTarget()) {
@@ -146,6 +149,22 @@ void BytecodeEmitter::EmitConditionalJump(Bytecode bytecode, LocalVar cond, Byte
     EmitJump(label);
 }
 
+void BytecodeEmitter::EmitImpl(const Bytecode bytecode) {
+    if (Bytecode fused; last_instruction_.has_value() && Bytecodes::Fuse(last_instruction_->first, bytecode, &fused)) {
+        // The superinstruction's operands are those of the pair, in order. Rewrite the previous instruction's opcode
+        // and let the caller append the operands of this one.
+        const std::size_t pos = last_instruction_->second;
+        *reinterpret_cast<std::underlying_type_t<Bytecode> *>(&(*bytecode_)[pos]) = Bytecodes::ToByte(fused);
+        last_instruction_.reset();
+        return;
+    }
+
+    if (use_superinstructions_) {
+        last_instruction_.emplace(bytecode, GetPosition());
+    }
+    EmitScalarValue(Bytecodes::ToByte(bytecode));
+}
+
 void BytecodeEmitter::Emit(Bytecode bytecode, LocalVar operand_1) {
     NOISEPAGE_ASSERT(Bytecodes::NumOperands(bytecode) == 1, "Incorrect operand count for bytecode");
     NOISEPAGE_ASSERT(Bytecodes::GetNthOperandType(bytecode, 0) == OperandType::Local,
@@ -430,6 +449,12 @@ void BytecodeEmitter::EmitAggHashTableMovePartitions(LocalVar   agg_ht,
     EmitAll(Bytecode::AggregationHashTableTransferPartitions, agg_ht, tls, aht_offset, merge_part_fn);
 }
 
+void BytecodeEmitter::EmitAggHashTableMergeOverflowPartitions(LocalVar   agg_ht,
+                                                              LocalVar   context,
+                                                              FunctionId merge_part_fn) {
+    EmitAll(Bytecode::AggregationHashTableMergeOverflowPartitions, agg_ht, context, merge_part_fn);
+}
+
 void BytecodeEmitter::EmitAggHashTableParallelPartitionedScan(LocalVar   agg_ht,
                                                               LocalVar   context,
                                                               LocalVar   tls,
@@ -152,8 +152,8 @@ private:
 // Bytecode Generator begins
 // ---------------------------------------------------------
 
-BytecodeGenerator::BytecodeGenerator() noexcept
-    : emitter_(&code_) {}
+BytecodeGenerator::BytecodeGenerator(bool use_superinstructions) noexcept
+    : emitter_(&code_, use_superinstructions) {}
 
 void BytecodeGenerator::VisitIfStmt(ast::IfStmt *node) {
     IfThenElseBuilder if_builder(this);
@@ -717,6 +717,13 @@ void BytecodeGenerator::VisitBuiltinTableIterCall(ast::CallExpr *call, ast::Buil
         GetExecutionResult()->SetDestination(vpi.ValueOf());
         break;
     }
+    case ast::Builtin::TableIterAddBlockFilter: {
+        LocalVar col_oid = VisitExpressionForRValue(call->Arguments()[1]);
+        LocalVar min = VisitExpressionForRValue(call->Arguments()[2]);
+        LocalVar max = VisitExpressionForRValue(call->Arguments()[3]);
+        GetEmitter()->Emit(Bytecode::TableVectorIteratorAddBlockFilter, iter, col_oid, min, max);
+        break;
+    }
     case ast::Builtin::TableIterClose: {
         GetEmitter()->Emit(Bytecode::TableVectorIteratorFree, iter);
         break;
@@ -1109,6 +1116,13 @@ void BytecodeGenerator::VisitBuiltinAggHashTableCall(ast::CallExpr *call, ast::B
         GetEmitter()->EmitAggHashTableMovePartitions(agg_ht, tls, aht_offset, merge_part_fn);
         break;
     }
+    case ast::Builtin::AggHashTableMergeOverflowPartitions: {
+        LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
+        LocalVar ctx = VisitExpressionForRValue(call->Arguments()[1]);
+        auto     merge_part_fn = LookupFuncIdByName(call->Arguments()[2]->As<ast::IdentifierExpr>()->Name().GetData());
+        GetEmitter()->EmitAggHashTableMergeOverflowPartitions(agg_ht, ctx, merge_part_fn);
+        break;
+    }
     case ast::Builtin::AggHashTableParallelPartitionedScan: {
         LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
         LocalVar ctx = VisitExpressionForRValue(call->Arguments()[1]);
@@ -1725,6 +1739,14 @@ void BytecodeGenerator::VisitBuiltinSorterCall(ast::CallExpr *call, ast::Builtin
         GetExecutionResult()->SetDestination(dest.ValueOf());
         break;
     }
+    case ast::Builtin::SorterGetTupleAt: {
+        LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+        LocalVar sorter = VisitExpressionForRValue(call->Arguments()[0]);
+        LocalVar idx = VisitExpressionForRValue(call->Arguments()[1]);
+        GetEmitter()->Emit(Bytecode::SorterGetTupleAt, dest, sorter, idx);
+        GetExecutionResult()->SetDestination(dest.ValueOf());
+        break;
+    }
     case ast::Builtin::SorterInsert: {
         LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
         LocalVar sorter = VisitExpressionForRValue(call->Arguments()[0]);
@@ -2588,6 +2610,13 @@ void BytecodeGenerator::VisitBuiltinStorageInterfaceCall(ast::CallExpr *call, as
         GetExecutionResult()->SetDestination(cond.ValueOf());
         break;
     }
+    case ast::Builtin::IndexBuildFinish: {
+        LocalVar cond
+            = GetExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Bool));
+        GetEmitter()->Emit(Bytecode::StorageInterfaceIndexBuildFinish, cond, storage_interface);
+        GetExecutionResult()->SetDestination(cond.ValueOf());
+        break;
+    }
     case ast::Builtin::IndexDelete: {
         LocalVar tuple_slot = VisitExpressionForRValue(call->Arguments()[1]);
         GetEmitter()->Emit(Bytecode::StorageInterfaceIndexDelete, storage_interface, tuple_slot);
@@ -2932,6 +2961,7 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::TableIterAdvance:
     case ast::Builtin::TableIterGetVPINumTuples:
     case ast::Builtin::TableIterGetVPI:
+    case ast::Builtin::TableIterAddBlockFilter:
     case ast::Builtin::TableIterClose: {
         VisitBuiltinTableIterCall(call, builtin);
         break;
@@ -3047,6 +3077,7 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::AggHashTableLookup:
     case ast::Builtin::AggHashTableProcessBatch:
     case ast::Builtin::AggHashTableMovePartitions:
+    case ast::Builtin::AggHashTableMergeOverflowPartitions:
     case ast::Builtin::AggHashTableParallelPartitionedScan:
     case ast::Builtin::AggHashTableFree: {
         VisitBuiltinAggHashTableCall(call, builtin);
@@ -3102,6 +3133,7 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     }
     case ast::Builtin::SorterInit:
     case ast::Builtin::SorterGetTupleCount:
+    case ast::Builtin::SorterGetTupleAt:
     case ast::Builtin::SorterInsert:
     case ast::Builtin::SorterInsertTopK:
     case ast::Builtin::SorterInsertTopKFinish:
@@ -3247,6 +3279,7 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::IndexInsert:
     case ast::Builtin::IndexInsertUnique:
     case ast::Builtin::IndexInsertWithSlot:
+    case ast::Builtin::IndexBuildFinish:
     case ast::Builtin::IndexDelete:
     case ast::Builtin::StorageInterfaceFree: {
         VisitBuiltinStorageInterfaceCall(call, builtin);
@@ -4142,8 +4175,9 @@ auto BytecodeGenerator::GetFloatTypedBytecode(Bytecode bytecode, ast::Type *type
 }
 
 // static
-auto BytecodeGenerator::Compile(ast::AstNode *root, const std::string &name) -> std::unique_ptr<BytecodeModule> {
-    BytecodeGenerator generator{};
+auto BytecodeGenerator::Compile(ast::AstNode *root, const std::string &name, bool use_superinstructions)
+    -> std::unique_ptr<BytecodeModule> {
+    BytecodeGenerator generator{use_superinstructions};
     generator.Visit(root);
 
     // Create the bytecode module. Note that we move the bytecode and functions
@@ -382,6 +382,9 @@ void OpStorageInterfaceIndexInsertWithSlot(bool
                                            bool                                         unique) {
     *result = storage_interface->IndexInsertWithTuple(*tuple_slot, unique);
 }
+void OpStorageInterfaceIndexBuildFinish(bool *result, noisepage::execution::sql::StorageInterface *storage_interface) {
+    *result = storage_interface->IndexBuildFinish();
+}
 void OpStorageInterfaceIndexDelete(noisepage::execution::sql::StorageInterface *storage_interface,
                                    noisepage::storage::TupleSlot               *tuple_slot) {
     storage_interface->IndexDelete(*tuple_slot);
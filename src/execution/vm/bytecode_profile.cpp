@@ -0,0 +1,133 @@
+#include "execution/vm/bytecode_profile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+namespace noisepage::execution::vm {
+
+namespace {
+
+    /** The dispatch counts of every bytecode and every pair of bytecodes. */
+    class DispatchCounts {
+    public:
+        DispatchCounts()
+            : counts_(Bytecodes::NumBytecodes())
+            , pair_counts_(Bytecodes::NumBytecodes() * Bytecodes::NumBytecodes()) {}
+
+        auto Count(std::underlying_type_t<Bytecode> bytecode) -> std::atomic<uint64_t> & {
+            return counts_[bytecode];
+        }
+
+        auto PairCount(std::underlying_type_t<Bytecode> first, std::underlying_type_t<Bytecode> second)
+            -> std::atomic<uint64_t> & {
+            return pair_counts_[first * Bytecodes::NumBytecodes() + second];
+        }
+
+        void Reset() {
+            for (auto &count : counts_) {
+                count.store(0, std::memory_order_relaxed);
+            }
+            for (auto &count : pair_counts_) {
+                count.store(0, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        std::vector<std::atomic<uint64_t>> counts_;
+        // Indexed by the first bytecode's value times the number of bytecodes, plus the second bytecode's value
+        std::vector<std::atomic<uint64_t>> pair_counts_;
+    };
+
+    auto GetDispatchCounts() -> DispatchCounts & {
+        static DispatchCounts dispatch_counts;
+        return dispatch_counts;
+    }
+
+} // namespace
+
+// static
+void BytecodeProfile::Record(std::underlying_type_t<Bytecode> prev, std::underlying_type_t<Bytecode> curr) {
+    DispatchCounts &dispatch_counts = GetDispatchCounts();
+    dispatch_counts.Count(curr).fetch_add(1, std::memory_order_relaxed);
+    if (prev != NO_BYTECODE) {
+        dispatch_counts.PairCount(prev, curr).fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// static
+auto BytecodeProfile::GetCount(Bytecode bytecode) -> uint64_t {
+    return GetDispatchCounts().Count(Bytecodes::ToByte(bytecode)).load(std::memory_order_relaxed);
+}
+
+// static
+auto BytecodeProfile::GetPairCount(Bytecode first, Bytecode second) -> uint64_t {
+    return GetDispatchCounts()
+        .PairCount(Bytecodes::ToByte(first), Bytecodes::ToByte(second))
+        .load(std::memory_order_relaxed);
+}
+
+// static
+auto BytecodeProfile::GetTotalCount() -> uint64_t {
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < Bytecodes::NumBytecodes(); i++) {
+        total += GetCount(Bytecodes::FromByte(i));
+    }
+    return total;
+}
+
+// static
+auto BytecodeProfile::GetTopPairs(std::size_t limit) -> std::vector<PairCount> {
+    std::vector<PairCount> pairs;
+    for (uint32_t i = 0; i < Bytecodes::NumBytecodes(); i++) {
+        const Bytecode first = Bytecodes::FromByte(i);
+        // Nothing can be fused after an instruction that leaves the block
+        if (Bytecodes::IsTerminal(first)) {
+            continue;
+        }
+        for (uint32_t j = 0; j < Bytecodes::NumBytecodes(); j++) {
+            // Skip pairs that already have a superinstruction, which show up when fusion is disabled
+            const Bytecode second = Bytecodes::FromByte(j);
+            if (Bytecode fused; Bytecodes::Fuse(first, second, &fused)) {
+                continue;
+            }
+            if (const uint64_t count = GetPairCount(first, second); count != 0) {
+                pairs.push_back({first, second, count});
+            }
+        }
+    }
+
+    const auto by_count = [](const PairCount &a, const PairCount &b) { return a.count_ > b.count_; };
+    if (pairs.size() > limit) {
+        std::partial_sort(pairs.begin(), pairs.begin() + limit, pairs.end(), by_count);
+        pairs.resize(limit);
+    } else {
+        std::sort(pairs.begin(), pairs.end(), by_count);
+    }
+    return pairs;
+}
+
+// static
+void BytecodeProfile::Dump(std::ostream &os, std::size_t limit) {
+    const uint64_t total = GetTotalCount();
+    os << "Bytecode dispatches: " << total << std::endl;
+    if (total == 0) {
+        return;
+    }
+
+    os << "Most frequent bytecode pairs:" << std::endl;
+    for (const auto &[first, second, count] : GetTopPairs(limit)) {
+        const double percent = 100.0 * static_cast<double>(count) / static_cast<double>(total);
+        os << std::setw(14) << count << std::setw(8) << std::fixed << std::setprecision(2) << percent << "%  "
+           << Bytecodes::ToString(first) << " -> " << Bytecodes::ToString(second) << std::endl;
+    }
+}
+
+// static
+void BytecodeProfile::Reset() {
+    GetDispatchCounts().Reset();
+}
+
+} // namespace noisepage::execution::vm
@@ -61,4 +61,22 @@ auto Bytecodes::GetNthOperandOffset(Bytecode bytecode, uint32_t operand_index) -
     return offset;
 }
 
+// static
+auto Bytecodes::Fuse(Bytecode first, Bytecode second, Bytecode *fused) -> bool {
+    // A bytecode starts at most one superinstruction, so the pair is found by switching on the first bytecode alone
+    switch (first) {
+#define ENTRY(name, first_bytecode, second_bytecode)                                                                   \
+    case Bytecode::first_bytecode:                                                                                     \
+        if (second != Bytecode::second_bytecode) {                                                                     \
+            return false;                                                                                              \
+        }                                                                                                              \
+        *fused = Bytecode::name;                                                                                       \
+        return true;
+        SUPERINSTRUCTION_LIST(ENTRY)
+#undef ENTRY
+    default:
+        return false;
+    }
+}
+
 } // namespace noisepage::execution::vm
@@ -0,0 +1,299 @@
+#include "execution/vm/jit_object_cache.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono> // NOLINT
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "loggers/execution_logger.h"
+#include "spdlog/fmt/fmt.h"
+#include "xxHash/xxh3.h"
+
+namespace noisepage::execution::vm {
+
+namespace {
+
+    // "TPLOBJ" followed by two zero bytes, read as a little-endian integer
+    constexpr uint64_t MAGIC = 0x00004a424f4c5054;
+
+    // Temporary files older than this were left behind by a process that died while writing them
+    constexpr std::chrono::minutes STALE_TEMP_FILE_AGE{10};
+
+    /**
+     * The header of a cached object file. It is followed by the symbol names, each as a 32-bit length and the name,
+     * and then by the object code.
+     */
+    struct FileHeader {
+        uint64_t magic_;
+        uint32_t version_;
+        uint32_t num_symbols_;
+        uint64_t compile_us_;
+        // Number of bytes following the header
+        uint64_t payload_size_;
+        // XXH3 hash of the bytes following the header
+        uint64_t checksum_;
+    };
+
+    auto Serialize(const llvm::MemoryBuffer       &object,
+                   const std::vector<std::string> &symbols,
+                   const uint64_t                  compile_us,
+                   uint64_t *const                 object_offset) -> std::string {
+        std::string contents(sizeof(FileHeader), '\0');
+        for (const auto &symbol : symbols) {
+            const auto length = static_cast<uint32_t>(symbol.size());
+            contents.append(reinterpret_cast<const char *>(&length), sizeof(length));
+            contents.append(symbol);
+        }
+        *object_offset = contents.size();
+        contents.append(object.getBufferStart(), object.getBufferSize());
+
+        FileHeader header;
+        header.magic_ = MAGIC;
+        header.version_ = JitObjectCache::FORMAT_VERSION;
+        header.num_symbols_ = static_cast<uint32_t>(symbols.size());
+        header.compile_us_ = compile_us;
+        header.payload_size_ = contents.size() - sizeof(FileHeader);
+        header.checksum_ = XXH3_64bits(contents.data() + sizeof(FileHeader), header.payload_size_);
+        std::memcpy(contents.data(), &header, sizeof(header));
+        return contents;
+    }
+
+    // Returns false if the contents are damaged or of another format
+    auto Parse(const std::string        &contents,
+               uint64_t *const           object_offset,
+               std::vector<std::string> *symbols,
+               uint64_t *const           compile_us) -> bool {
+        if (contents.size() < sizeof(FileHeader)) {
+            return false;
+        }
+        FileHeader header;
+        std::memcpy(&header, contents.data(), sizeof(header));
+        if (header.magic_ != MAGIC || header.version_ != JitObjectCache::FORMAT_VERSION
+            || header.payload_size_ != contents.size() - sizeof(FileHeader)
+            || header.checksum_ != XXH3_64bits(contents.data() + sizeof(FileHeader), header.payload_size_)) {
+            return false;
+        }
+
+        uint64_t offset = sizeof(FileHeader);
+        for (uint32_t i = 0; i < header.num_symbols_; i++) {
+            uint32_t length;
+            if (contents.size() - offset < sizeof(length)) {
+                return false;
+            }
+            std::memcpy(&length, contents.data() + offset, sizeof(length));
+            offset += sizeof(length);
+            if (contents.size() - offset < length) {
+                return false;
+            }
+            symbols->emplace_back(contents, offset, length);
+            offset += length;
+        }
+        *object_offset = offset;
+        *compile_us = header.compile_us_;
+        return true;
+    }
+
+    auto ReadFile(const std::filesystem::path &path, std::string *const contents) -> bool {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return false;
+        }
+        contents->assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        return !in.bad();
+    }
+
+} // namespace
+
+JitObjectCache::JitObjectCache(std::string directory, const uint64_t max_size_bytes, std::string environment)
+    : directory_(std::move(directory))
+    , max_size_bytes_(max_size_bytes)
+    , environment_(std::move(environment)) {}
+
+auto JitObjectCache::Warmup() -> uint32_t {
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+    if (error) {
+        EXECUTION_LOG_WARN("JIT cache: unable to create directory '{}': {}", directory_, error.message());
+        return 0;
+    }
+
+    struct CacheFile {
+        std::filesystem::file_time_type last_used_;
+        std::filesystem::path           path_;
+    };
+    std::vector<CacheFile> files;
+    const auto             stale = std::filesystem::file_time_type::clock::now() - STALE_TEMP_FILE_AGE;
+    for (const auto &dir_entry : std::filesystem::directory_iterator(directory_, error)) {
+        const auto last_write = dir_entry.last_write_time(error);
+        if (error || !dir_entry.is_regular_file(error)) {
+            continue;
+        }
+        if (dir_entry.path().extension() == FILE_EXTENSION) {
+            files.push_back({last_write, dir_entry.path()});
+        } else if (dir_entry.path().extension() == ".tmp" && last_write < stale) {
+            std::filesystem::remove(dir_entry.path(), error);
+        }
+    }
+
+    // Lookups refresh the modification time of their file, so the most recently used objects come first
+    std::sort(files.begin(),
+              files.end(),
+              [](const CacheFile &a, const CacheFile &b) {
+                  return a.last_used_ > b.last_used_;
+              });
+
+    uint32_t                 num_loaded = 0;
+    std::vector<std::string> removed;
+    for (const auto &file : files) {
+        Entry entry;
+        if (!ReadFile(file.path_, &entry.contents_)
+            || !Parse(entry.contents_, &entry.object_offset_, &entry.symbols_, &entry.compile_us_)) {
+            removed.push_back(file.path_.string());
+            continue;
+        }
+
+        const std::string           key = file.path_.stem().string();
+        std::lock_guard<std::mutex> guard(latch_);
+        if (entries_.count(key) != 0) {
+            continue;
+        }
+        if (size_bytes_ + entry.contents_.size() > max_size_bytes_) {
+            removed.push_back(file.path_.string());
+            continue;
+        }
+        size_bytes_ += entry.contents_.size();
+        entry.lru_pos_ = lru_.insert(lru_.end(), key);
+        entries_.emplace(key, std::move(entry));
+        num_loaded++;
+    }
+    RemoveFiles(removed);
+
+    EXECUTION_LOG_INFO("JIT cache: loaded {} objects ({} bytes) from '{}', removed {} files",
+                       num_loaded,
+                       GetSizeInBytes(),
+                       directory_,
+                       removed.size());
+    return num_loaded;
+}
+
+auto JitObjectCache::MakeKey(const std::string_view module_fingerprint) const -> std::string {
+    std::string material;
+    material.reserve(environment_.size() + module_fingerprint.size());
+    material.append(environment_).append(module_fingerprint);
+    const XXH128_hash_t hash = XXH3_128bits(material.data(), material.size());
+    return fmt::format("{:016x}{:016x}", hash.high64, hash.low64);
+}
+
+auto JitObjectCache::Lookup(const std::string &key, CachedObject *const result) -> bool {
+    {
+        std::lock_guard<std::mutex> guard(latch_);
+        auto                        iter = entries_.find(key);
+        if (iter == entries_.end()) {
+            num_misses_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        const Entry &entry = iter->second;
+        lru_.splice(lru_.begin(), lru_, entry.lru_pos_);
+        const llvm::StringRef object = llvm::StringRef(entry.contents_).drop_front(entry.object_offset_);
+        result->object_ = llvm::MemoryBuffer::getMemBufferCopy(object, key);
+        result->symbols_ = entry.symbols_;
+        result->compile_us_ = entry.compile_us_;
+    }
+    num_hits_.fetch_add(1, std::memory_order_relaxed);
+    compile_us_saved_.fetch_add(result->compile_us_, std::memory_order_relaxed);
+
+    // Refresh the file's modification time, so the next warmup prefers it over the objects that were not used
+    std::error_code error;
+    std::filesystem::last_write_time(FilePath(key), std::filesystem::file_time_type::clock::now(), error);
+    return true;
+}
+
+void JitObjectCache::Store(const std::string              &key,
+                           const llvm::MemoryBuffer       &object,
+                           const std::vector<std::string> &symbols,
+                           const uint64_t                  compile_us) {
+    Entry entry;
+    entry.contents_ = Serialize(object, symbols, compile_us, &entry.object_offset_);
+    entry.symbols_ = symbols;
+    entry.compile_us_ = compile_us;
+    const uint64_t size = entry.contents_.size();
+    if (size > max_size_bytes_) {
+        return;
+    }
+
+    // Write the file under a name no other thread or process uses, then move it into place in one step, so readers
+    // never see a partially written object
+    const std::string path = FilePath(key);
+    const std::string temp_path = fmt::format("{}.{}.{}.tmp",
+                                              path,
+                                              ::getpid(),
+                                              num_temp_files_.fetch_add(1, std::memory_order_relaxed));
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        out.write(entry.contents_.data(), static_cast<std::streamsize>(size));
+        out.close();
+        std::error_code error;
+        if (out.fail()) {
+            EXECUTION_LOG_WARN("JIT cache: unable to write '{}'", temp_path);
+            std::filesystem::remove(temp_path, error);
+        } else if (std::filesystem::rename(temp_path, path, error); error) {
+            EXECUTION_LOG_WARN("JIT cache: unable to write '{}': {}", path, error.message());
+            std::filesystem::remove(temp_path, error);
+        }
+    }
+
+    std::vector<std::string> evicted;
+    {
+        std::lock_guard<std::mutex> guard(latch_);
+        // Another thread may have compiled the same module at the same time
+        if (entries_.count(key) != 0) {
+            return;
+        }
+        while (size_bytes_ + size > max_size_bytes_) {
+            const std::string &victim = lru_.back();
+            auto               iter = entries_.find(victim);
+            size_bytes_ -= iter->second.contents_.size();
+            evicted.push_back(FilePath(victim));
+            entries_.erase(iter);
+            lru_.pop_back();
+        }
+        size_bytes_ += size;
+        entry.lru_pos_ = lru_.insert(lru_.begin(), key);
+        entries_.emplace(key, std::move(entry));
+    }
+    RemoveFiles(evicted);
+}
+
+void JitObjectCache::Erase(const std::string &key) {
+    {
+        std::lock_guard<std::mutex> guard(latch_);
+        auto                        iter = entries_.find(key);
+        if (iter == entries_.end()) {
+            return;
+        }
+        size_bytes_ -= iter->second.contents_.size();
+        lru_.erase(iter->second.lru_pos_);
+        entries_.erase(iter);
+    }
+    RemoveFiles({FilePath(key)});
+}
+
+auto JitObjectCache::FilePath(const std::string &key) const -> std::string {
+    return (std::filesystem::path(directory_) / (key + std::string(FILE_EXTENSION))).string();
+}
+
+void JitObjectCache::RemoveFiles(const std::vector<std::string> &files) {
+    for (const auto &file : files) {
+        std::error_code error;
+        std::filesystem::remove(file, error);
+    }
+}
+
+} // namespace noisepage::execution::vm
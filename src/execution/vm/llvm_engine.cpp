@@ -4,6 +4,7 @@
 #include <llvm/Analysis/TargetLibraryInfo.h>
 #include <llvm/Analysis/TargetTransformInfo.h>
 #include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Config/llvm-config.h>
 #include <llvm/ExecutionEngine/RuntimeDyld.h>
 #include <llvm/ExecutionEngine/SectionMemoryManager.h>
 #include <llvm/IR/IRBuilder.h>
@@ -24,6 +25,8 @@
 #include <llvm/Transforms/Scalar.h>
 #include <llvm/Transforms/Scalar/GVN.h>
 
+#include <algorithm>
+#include <chrono> // NOLINT
 #include <map>
 #include <memory>
 #include <string>
@@ -31,10 +34,16 @@
 #include <utility>
 #include <vector>
 
+#include "common/resource_tracker.h"
+#include "common/scoped_timer.h"
+#include "common/thread_context.h"
 #include "execution/ast/type.h"
 #include "execution/vm/bytecode_module.h"
 #include "execution/vm/bytecode_traits.h"
 #include "loggers/execution_logger.h"
+#include "metrics/metrics_store.h"
+#include "spdlog/fmt/fmt.h"
+#include "xxHash/xxh3.h"
 
 extern void *__dso_handle __attribute__((__visibility__("hidden"))); // NOLINT
 
@@ -52,6 +61,65 @@ namespace {
         return (!ret_type->IsNilType() && ret_type->GetSize() <= sizeof(int64_t));
     }
 
+    // Map an optimization level of the compiler options to the code generator's
+    auto CodeGenOptLevel(const uint32_t opt_level) -> llvm::CodeGenOpt::Level {
+        switch (opt_level) {
+        case 0:
+            return llvm::CodeGenOpt::None;
+        case 1:
+            return llvm::CodeGenOpt::Less;
+        case 2:
+            return llvm::CodeGenOpt::Default;
+        default:
+            return llvm::CodeGenOpt::Aggressive;
+        }
+    }
+
+    // Collect the features of the host CPU into a feature string, e.g. "+avx2,+sse4.2,-avx512f". The features are
+    // sorted, so the string is the same in every process on the same CPU.
+    auto HostCpuFeatures(std::string *const features) -> bool {
+        llvm::StringMap<bool> feature_map;
+        if (!llvm::sys::getHostCPUFeatures(feature_map)) {
+            return false;
+        }
+
+        std::vector<std::string> flags;
+        for (const auto &entry : feature_map) {
+            flags.push_back((entry.getValue() ? "+" : "-") + entry.getKey().str());
+        }
+        std::sort(flags.begin(), flags.end());
+
+        llvm::SubtargetFeatures target_features;
+        for (const auto &flag : flags) {
+            target_features.AddFeature(flag);
+        }
+        *features = target_features.getString();
+        return true;
+    }
+
+    // Describe everything other than the bytecode module that JIT-compiled machine code depends on
+    auto HostEnvironment(const std::string &bytecode_handlers_path) -> std::string {
+        std::string cpu_features;
+        HostCpuFeatures(&cpu_features);
+        std::string environment = fmt::format("format={};llvm={};triple={};cpu={};features={};",
+                                              JitObjectCache::FORMAT_VERSION,
+                                              LLVM_VERSION_STRING,
+                                              llvm::sys::getProcessTriple(),
+                                              llvm::sys::getHostCPUName().str(),
+                                              cpu_features);
+
+        // The bytecode handlers are linked into every module
+        auto handlers = llvm::MemoryBuffer::getFile(bytecode_handlers_path);
+        if (handlers) {
+            const auto &buffer = *handlers.get();
+            environment += fmt::format("handlers={:016x};",
+                                       XXH3_64bits(buffer.getBufferStart(), buffer.getBufferSize()));
+        } else {
+            environment += fmt::format("handlers={};", bytecode_handlers_path);
+        }
+        return environment;
+    }
+
 } // namespace
 
 // ---------------------------------------------------------
@@ -486,26 +554,21 @@ LLVMEngine::CompiledModuleBuilder::CompiledModuleBuilder(const CompilerOptions &
         }
 
         // Collect CPU features
-        llvm::StringMap<bool> feature_map;
-        if (bool success = llvm::sys::getHostCPUFeatures(feature_map); !success) {
+        std::string cpu_features;
+        if (bool success = HostCpuFeatures(&cpu_features); !success) {
             EXECUTION_LOG_ERROR("LLVM: Unable to find all CPU features");
             return;
         }
 
-        llvm::SubtargetFeatures target_features;
-        for (const auto &entry : feature_map) {
-            target_features.AddFeature(entry.getKey(), entry.getValue());
-        }
-
-        EXECUTION_LOG_TRACE("LLVM: Discovered CPU features: {}", target_features.getString());
+        EXECUTION_LOG_TRACE("LLVM: Discovered CPU features: {}", cpu_features);
 
         // Both relocation=PIC or JIT=true work. Use the latter for now.
         llvm::TargetOptions                target_options;
         llvm::Optional<llvm::Reloc::Model> reloc;
-        const llvm::CodeGenOpt::Level      opt_level = llvm::CodeGenOpt::Aggressive;
+        const llvm::CodeGenOpt::Level      opt_level = CodeGenOptLevel(options.GetOptLevel());
         target_machine_.reset(target->createTargetMachine(target_triple,
                                                           llvm::sys::getHostCPUName(),
-                                                          target_features.getString(),
+                                                          cpu_features,
                                                           target_options,
                                                           reloc,
                                                           {},
@@ -631,8 +694,10 @@ void LLVMEngine::CompiledModuleBuilder::BuildSimpleCFG(const FunctionInfo
 
             // Unconditional branch?
             if (Bytecodes::IsUnconditionalJump(bytecode)) {
-                std::size_t branch_target_pos
-                    = iter.GetPosition() + Bytecodes::GetNthOperandOffset(bytecode, 0) + iter.GetJumpOffsetOperand(0);
+                const uint32_t offset_index = Bytecodes::GetJumpOffsetOperandIndex(bytecode);
+                std::size_t    branch_target_pos
+                    = iter.GetPosition() + Bytecodes::GetNthOperandOffset(bytecode, offset_index)
+                      + iter.GetJumpOffsetOperand(offset_index);
 
                 if (blocks->find(branch_target_pos) == blocks->end()) {
                     (*blocks)[branch_target_pos] = nullptr;
@@ -651,8 +716,10 @@ void LLVMEngine::CompiledModuleBuilder::BuildSimpleCFG(const FunctionInfo
                     (*blocks)[fallthrough_pos] = nullptr;
                 }
 
-                std::size_t branch_target_pos
-                    = iter.GetPosition() + Bytecodes::GetNthOperandOffset(bytecode, 1) + iter.GetJumpOffsetOperand(1);
+                const uint32_t offset_index = Bytecodes::GetJumpOffsetOperandIndex(bytecode);
+                std::size_t    branch_target_pos
+                    = iter.GetPosition() + Bytecodes::GetNthOperandOffset(bytecode, offset_index)
+                      + iter.GetJumpOffsetOperand(offset_index);
 
                 if (blocks->find(branch_target_pos) == blocks->end()) {
                     bb_begin_positions.push_back(branch_target_pos);
@@ -820,8 +887,20 @@ void LLVMEngine::CompiledModuleBuilder::DefineFunction(const FunctionInfo &func_
             return ir_builder->CreateCall(func, args);
         };
 
+        // A superinstruction runs the two bytecodes it fuses. The operands of the first lead the arguments, so call
+        // its handler with them, then translate the second as though it were a standalone bytecode.
+        Bytecode op = bytecode;
+        if (Bytecodes::IsSuperinstruction(bytecode)) {
+            const Bytecode first = Bytecodes::GetSuperinstructionFirst(bytecode);
+            const auto     first_args_end = args.begin() + Bytecodes::NumOperands(first);
+            llvm::SmallVector<llvm::Value *, 8> first_args(args.begin(), first_args_end);
+            issue_call(LookupBytecodeHandler(first), first_args);
+            args.erase(args.begin(), first_args_end);
+            op = Bytecodes::GetSuperinstructionSecond(bytecode);
+        }
+
         // Handle bytecode
-        switch (bytecode) {
+        switch (op) {
         case Bytecode::Call: {
             // For internal calls, the callee's function ID will be the first operand. We pull it out
             // and lookup the function in the module and remove it from the arguments vector.
@@ -853,8 +932,10 @@ void LLVMEngine::CompiledModuleBuilder::DefineFunction(const FunctionInfo &func_
             // branch to the basic block that starts at the given bytecode position, using the
             // information in the CFG.
 
-            std::size_t branch_target_bb_pos
-                = iter.GetPosition() + Bytecodes::GetNthOperandOffset(bytecode, 0) + iter.GetJumpOffsetOperand(0);
+            const uint32_t offset_index = Bytecodes::GetJumpOffsetOperandIndex(bytecode);
+            std::size_t    branch_target_bb_pos
+                = iter.GetPosition() + Bytecodes::GetNthOperandOffset(bytecode, offset_index)
+                  + iter.GetJumpOffsetOperand(offset_index);
             NOISEPAGE_ASSERT(blocks[branch_target_bb_pos] != nullptr,
                              "Branch target does not point to valid basic block");
             ir_builder->CreateBr(blocks[branch_target_bb_pos]);
@@ -866,9 +947,11 @@ void LLVMEngine::CompiledModuleBuilder::DefineFunction(const FunctionInfo &func_
             // Conditional jumps work almost exactly as unconditional jump except a second fallthrough
             // position is calculated.
 
-            std::size_t fallthrough_bb_pos = iter.GetPosition() + iter.CurrentBytecodeSize();
-            std::size_t branch_target_bb_pos
-                = iter.GetPosition() + Bytecodes::GetNthOperandOffset(bytecode, 1) + iter.GetJumpOffsetOperand(1);
+            const uint32_t offset_index = Bytecodes::GetJumpOffsetOperandIndex(bytecode);
+            std::size_t    fallthrough_bb_pos = iter.GetPosition() + iter.CurrentBytecodeSize();
+            std::size_t    branch_target_bb_pos
+                = iter.GetPosition() + Bytecodes::GetNthOperandOffset(bytecode, offset_index)
+                  + iter.GetJumpOffsetOperand(offset_index);
             NOISEPAGE_ASSERT(blocks[fallthrough_bb_pos] != nullptr,
                              "Branch fallthrough does not point to valid basic block");
             NOISEPAGE_ASSERT(blocks[branch_target_bb_pos] != nullptr,
@@ -877,7 +960,7 @@ void LLVMEngine::CompiledModuleBuilder::DefineFunction(const FunctionInfo &func_
             auto        *check = llvm::ConstantInt::get(type_map_->Int8Type(), 1, false);
             llvm::Value *cond = ir_builder->CreateICmpEQ(args[0], check);
 
-            if (bytecode == Bytecode::JumpIfTrue) {
+            if (op == Bytecode::JumpIfTrue) {
                 ir_builder->CreateCondBr(cond, blocks[branch_target_bb_pos], blocks[fallthrough_bb_pos]);
             } else {
                 ir_builder->CreateCondBr(cond, blocks[fallthrough_bb_pos], blocks[branch_target_bb_pos]);
@@ -952,7 +1035,7 @@ void LLVMEngine::CompiledModuleBuilder::DefineFunction(const FunctionInfo &func_
 
         default: {
             // In the default case, each bytecode makes a function call into its bytecode handler
-            llvm::Function *handler = LookupBytecodeHandler(bytecode);
+            llvm::Function *handler = LookupBytecodeHandler(op);
             issue_call(handler, args);
             break;
         }
@@ -1006,22 +1089,30 @@ void LLVMEngine::CompiledModuleBuilder::Optimize() {
     // Add the appropriate TargetTransformInfo.
     function_passes.add(llvm::createTargetTransformInfoWrapperPass(target_machine_->getTargetIRAnalysis()));
 
+    // Without optimizations, the handlers only need to be inlined, which Simplify() did.
+    const uint32_t opt_level = options_.GetOptLevel();
+    if (opt_level == 0) {
+        return;
+    }
+
     // Build up optimization pipeline.
     llvm::PassManagerBuilder pm_builder;
-    uint32_t                 opt_level = 3;
     uint32_t                 size_opt_level = 0;
     bool                     disable_inline_hot_call_site = false;
     pm_builder.OptLevel = opt_level;
     pm_builder.Inliner = llvm::createFunctionInliningPass(opt_level, size_opt_level, disable_inline_hot_call_site);
     pm_builder.populateFunctionPassManager(function_passes);
 
-    // Add custom passes. Hand-selected based on empirical evaluation.
-    function_passes.add(llvm::createInstructionCombiningPass());
-    function_passes.add(llvm::createReassociatePass());
-    function_passes.add(llvm::createGVNPass());
-    function_passes.add(llvm::createCFGSimplificationPass());
-    function_passes.add(llvm::createAggressiveDCEPass());
-    function_passes.add(llvm::createCFGSimplificationPass());
+    // Add custom passes. Hand-selected based on empirical evaluation. They are expensive, so the quick levels that
+    // favor compile time skip them.
+    if (opt_level >= 2) {
+        function_passes.add(llvm::createInstructionCombiningPass());
+        function_passes.add(llvm::createReassociatePass());
+        function_passes.add(llvm::createGVNPass());
+        function_passes.add(llvm::createCFGSimplificationPass());
+        function_passes.add(llvm::createAggressiveDCEPass());
+        function_passes.add(llvm::createCFGSimplificationPass());
+    }
 
     // Run optimization passes on all functions.
     function_passes.doInitialization();
@@ -1110,6 +1201,13 @@ LLVMEngine::CompiledModule::CompiledModule(std::unique_ptr<llvm::MemoryBuffer> o
     , object_code_(std::move(object_code))
     , memory_manager_(std::make_unique<LLVMEngine::TPLMemoryManager>()) {}
 
+LLVMEngine::CompiledModule::CompiledModule(std::unique_ptr<llvm::MemoryBuffer> object_code,
+                                           std::vector<std::string>            symbols)
+    : loaded_(false)
+    , object_code_(std::move(object_code))
+    , symbols_(std::move(symbols))
+    , memory_manager_(std::make_unique<LLVMEngine::TPLMemoryManager>()) {}
+
 // This destructor is needed to address a bug with LLVM's RuntimeDyldElf.
 // See issue #961 and PR #962 for further information.
 LLVMEngine::CompiledModule::~CompiledModule() {
@@ -1178,14 +1276,17 @@ void LLVMEngine::CompiledModule::Load(const BytecodeModule &module) {
 
     //
     // Now, the object has successfully been loaded and is executable. We pull out
-    // all module functions into a handy cache.
+    // all module functions into a handy cache. Objects loaded from the object
+    // cache were compiled for another query and name their functions after it.
     //
 
+    NOISEPAGE_ASSERT(symbols_.empty() || symbols_.size() == module.GetFunctionCount(), "Missing function symbols");
     for (const auto &func : module.GetFunctionsInfo()) {
-        auto symbol = loader.getSymbol(func.GetName());
+        const std::string &symbol_name = symbols_.empty() ? func.GetName() : symbols_[func.GetId()];
+        auto               symbol = loader.getSymbol(symbol_name);
         if (symbol.getAddress() == 0) {
             // for Mac portability
-            symbol = loader.getSymbol("_" + func.GetName());
+            symbol = loader.getSymbol("_" + symbol_name);
         }
         functions_[func.GetName()] = reinterpret_cast<void *>(symbol.getAddress());
         NOISEPAGE_ASSERT(symbol.getAddress() != 0, "symbol came out to be badly defined or missing");
@@ -1209,36 +1310,145 @@ void LLVMEngine::Initialize(std::unique_ptr<const Settings> &&settings) {
     llvm::sys::DynamicLibrary::LoadLibraryPermanently(nullptr);
 
     engine_settings = std::move(settings);
+
+    // Load the objects compiled by previous processes, so queries they compiled start out JIT-compiled
+    if (!engine_settings->GetJitCacheDirectory().empty()) {
+        object_cache = std::make_unique<JitObjectCache>(engine_settings->GetJitCacheDirectory(),
+                                                        engine_settings->GetJitCacheSize(),
+                                                        HostEnvironment(engine_settings->GetBytecodeHandlersBcPath()));
+        object_cache->Warmup();
+    }
 }
 
 void LLVMEngine::Shutdown() {
+    if (object_cache != nullptr) {
+        EXECUTION_LOG_INFO("JIT cache: {} hits, {} misses, {} ms of compilation saved",
+                           object_cache->GetNumHits(),
+                           object_cache->GetNumMisses(),
+                           object_cache->GetCompileTimeSavedUs() / 1000);
+        object_cache.reset();
+    }
     engine_settings.reset();
     llvm::llvm_shutdown();
 }
 
 std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::Compile(const BytecodeModule  &module,
                                                                 const CompilerOptions &options) {
-    CompiledModuleBuilder builder(options, module);
+    const bool metrics_enabled
+        = common::thread_context.metrics_store_ != nullptr
+          && common::thread_context.metrics_store_->ComponentToRecord(metrics::MetricsComponent::EXECUTION);
+    common::ResourceTracker resource_tracker;
+    if (metrics_enabled) {
+        resource_tracker.Start();
+    }
 
-    builder.DeclareStaticLocals();
+    // Objects that are persisted to the working directory are always compiled afresh
+    const bool use_cache = object_cache != nullptr && !options.ShouldPersistObjectFile();
+
+    std::unique_ptr<CompiledModule> compiled_module;
+    std::string                     cache_key;
+    uint64_t                        compile_time_saved_us = 0;
+    if (use_cache) {
+        cache_key = object_cache->MakeKey(ModuleFingerprint(module, options));
+        JitObjectCache::CachedObject cached;
+        if (object_cache->Lookup(cache_key, &cached)) {
+            compiled_module = std::make_unique<CompiledModule>(std::move(cached.object_), std::move(cached.symbols_));
+            compiled_module->Load(module);
+            if (compiled_module->IsLoaded()) {
+                compile_time_saved_us = cached.compile_us_;
+            } else {
+                EXECUTION_LOG_WARN("JIT cache: unable to load the cached object of module {}", module.GetName());
+                object_cache->Erase(cache_key);
+                compiled_module.reset();
+            }
+        }
+    }
+
+    if (compiled_module == nullptr) {
+        uint64_t compile_us;
+        {
+            common::ScopedTimer<std::chrono::microseconds> timer(&compile_us);
+
+            CompiledModuleBuilder builder(options, module);
+
+            builder.DeclareStaticLocals();
 
-    builder.DeclareFunctions();
+            builder.DeclareFunctions();
 
-    builder.DefineFunctions();
+            builder.DefineFunctions();
 
-    builder.Simplify();
+            builder.Simplify();
 
-    builder.Verify();
+            builder.Verify();
+
+            builder.Optimize();
+
+            compiled_module = builder.Finalize();
+        }
 
-    builder.Optimize();
+        if (use_cache) {
+            std::vector<std::string> symbols;
+            symbols.reserve(module.GetFunctionCount());
+            for (const auto &func : module.GetFunctionsInfo()) {
+                symbols.push_back(func.GetName());
+            }
+            object_cache->Store(cache_key, compiled_module->GetObjectCode(), symbols, compile_us);
+        }
 
-    auto compiled_module = builder.Finalize();
+        compiled_module->Load(module);
+    }
 
-    compiled_module->Load(module);
+    if (metrics_enabled) {
+        resource_tracker.Stop();
+        common::thread_context.metrics_store_->RecordJitCacheData(module.GetName(),
+                                                                  compile_time_saved_us > 0,
+                                                                  compile_time_saved_us,
+                                                                  resource_tracker.GetMetrics());
+    }
 
     return compiled_module;
 }
 
+auto LLVMEngine::ModuleFingerprint(const BytecodeModule &module, const CompilerOptions &options) -> std::string {
+    std::string fingerprint;
+    const auto  append_int = [&](const uint64_t value) {
+        fingerprint.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+    const auto append_bytes = [&](const void *const data, const std::size_t size) {
+        append_int(size);
+        fingerprint.append(static_cast<const char *>(data), size);
+    };
+    const auto append_string = [&](const std::string &value) {
+        append_bytes(value.data(), value.size());
+    };
+    const auto append_local = [&](const LocalInfo &local) {
+        append_string(local.GetType() == nullptr ? "" : ast::Type::ToString(local.GetType()));
+        append_int(local.GetOffset());
+        append_int(local.GetSize());
+        append_int(local.IsParameter() ? 1 : 0);
+    };
+
+    append_bytes(module.code_.data(), module.code_.size());
+    append_bytes(module.data_.data(), module.data_.size());
+    append_int(module.GetFunctionCount());
+    for (const auto &func : module.GetFunctionsInfo()) {
+        const auto [start, end] = func.GetBytecodeRange();
+        append_string(ast::Type::ToString(func.GetFuncType()));
+        append_int(start);
+        append_int(end);
+        append_int(func.GetLocals().size());
+        for (const auto &local : func.GetLocals()) {
+            append_local(local);
+        }
+    }
+    append_int(module.GetStaticLocalsCount());
+    for (const auto &local : module.GetStaticLocalsInfo()) {
+        append_local(local);
+    }
+    append_int(options.GetOptLevel());
+    return fingerprint;
+}
+
 auto LLVMEngine::GetEngineSettings() -> const LLVMEngine::Settings * {
     NOISEPAGE_ASSERT(static_cast<bool>(engine_settings), "LLVMEngine must be initialized before use");
     return engine_settings.get();
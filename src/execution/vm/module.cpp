@@ -2,10 +2,13 @@
 
 #include <tbb/task.h> // NOLINT
 
+#include <algorithm>
 #include <memory>
 #include <mutex> // NOLINT
 #include <string>
+#include <thread> // NOLINT
 #include <utility>
+#include <vector>
 
 #include "loggers/execution_logger.h"
 
@@ -21,21 +24,23 @@ namespace noisepage::execution::vm {
 // This class encapsulates the ability to asynchronously JIT compile a module.
 class Module::AsyncCompileTask : public tbb::task {
 public:
-    // Construct an asynchronous compilation task to compile the the module
-    explicit AsyncCompileTask(Module *module)
-        : module_(module) {}
+    // Construct an asynchronous compilation task to compile the module into the given tier
+    AsyncCompileTask(Module *module, Tier tier)
+        : module_(module)
+        , tier_(tier) {}
 
     // Execute
     // auto execute() override -> tbb::task* {
     tbb::task *execute() override {
-        // This simply invokes Module::CompileToMachineCode() asynchronously.
-        module_->CompileToMachineCode();
+        // This simply invokes Module::TierUp() asynchronously.
+        module_->TierUp(tier_);
         // Done. There's no next task, so return null.
         return nullptr;
     }
 
 private:
     Module *module_;
+    Tier    tier_;
 };
 
 // ---------------------------------------------------------
@@ -52,6 +57,7 @@ Module::Module(std::unique_ptr<BytecodeModule>             bytecode_module,
     , jit_module_(std::move(llvm_module))
     , functions_(std::make_unique<std::atomic<void *>[]>(bytecode_module_->GetFunctionCount()))
     , bytecode_trampolines_(std::make_unique<Trampoline[]>(bytecode_module_->GetFunctionCount()))
+    , profile_counts_(std::make_unique<std::atomic<uint64_t>[]>(bytecode_module_->GetFunctionCount()))
     , metadata_(std::move(metadata)) {
     // Create the trampolines for all bytecode functions
     for (const auto &func : bytecode_module_->GetFunctionsInfo()) {
@@ -71,9 +77,14 @@ Module::Module(std::unique_ptr<BytecodeModule>             bytecode_module,
             auto func_info = bytecode_module_->GetFuncInfoById(idx);
             functions_[idx] = jit_module_->GetFunctionPointer(func_info->GetName());
         }
+        tier_ = Tier::Optimized;
     }
 }
 
+Module::~Module() {
+    WaitForTierUp();
+}
+
 namespace {
 
     // TODO(pmenon): Implement generator for non x86_64 machines
@@ -83,7 +94,7 @@ namespace {
     // TODO(pmenon): **LOTS** of shit to make this fully ABI compliant ....
     class TrampolineGenerator : public Xbyak::CodeGenerator {
     public:
-        TrampolineGenerator(const Module &module, const FunctionInfo &func_info, void *mem)
+        TrampolineGenerator(Module &module, const FunctionInfo &func_info, void *mem)
             : Xbyak::CodeGenerator(Xbyak::DEFAULT_MAX_CODE_SIZE, mem)
             , module_(module)
             , func_(func_info) {}
@@ -235,10 +246,34 @@ namespace {
         }
 
     private:
-        const Module       &module_;
+        Module             &module_;
         const FunctionInfo &func_;
     };
 
+    // Generates the stubs in front of baseline functions. A stub counts an invocation in the function's profile
+    // count and jumps to the function. It only clobbers rax, which carries no arguments, so it works for any
+    // signature.
+    class ProfilingStubGenerator : public Xbyak::CodeGenerator {
+    public:
+        // The space reserved for each stub
+        static constexpr std::size_t STUB_SIZE = 32;
+
+        ProfilingStubGenerator(std::size_t size, void *mem)
+            : Xbyak::CodeGenerator(size, mem) {}
+
+        // Generate a stub and return its address
+        auto Generate(std::atomic<uint64_t> *counter, void *target) -> void * {
+            align(STUB_SIZE);
+            void *stub = const_cast<uint8_t *>(getCurr());
+            mov(rax, reinterpret_cast<std::size_t>(counter));
+            lock();
+            add(qword[rax], 1);
+            mov(rax, reinterpret_cast<std::size_t>(target));
+            jmp(rax);
+            return stub;
+        }
+    };
+
 } // namespace
 
 void Module::CreateFunctionTrampoline(const FunctionInfo &func, Trampoline *trampoline) {
@@ -299,17 +334,122 @@ void Module::CompileToMachineCode() {
         // JIT completed successfully. For each function in the module, pull out its
         // compiled implementation into the function cache, atomically replacing any
         // previous implementation.
-        for (const auto &func_info : bytecode_module_->GetFunctionsInfo()) {
+        InstallTier(Tier::Optimized, [this](const FunctionInfo &func_info) {
             auto *jit_function = jit_module_->GetFunctionPointer(func_info.GetName());
             NOISEPAGE_ASSERT(jit_function != nullptr, "Missing function in compiled module!");
-            functions_[func_info.GetId()].store(jit_function, std::memory_order_relaxed);
-        }
+            return jit_function;
+        });
+    });
+}
+
+void Module::CompileToBaselineCode() {
+    LLVMEngine::CompilerOptions options;
+    options.SetOptLevel(BASELINE_OPT_LEVEL);
+    baseline_module_ = LLVMEngine::Compile(*bytecode_module_, options);
+
+    // Generate a counting stub for every function, all in one block of memory.
+    const std::size_t      code_size = (bytecode_module_->GetFunctionCount() + 1) * ProfilingStubGenerator::STUB_SIZE;
+    std::error_code        error;
+    const int32_t          rw_flags = llvm::sys::Memory::MF_READ | llvm::sys::Memory::MF_WRITE;
+    llvm::sys::MemoryBlock memory = llvm::sys::Memory::allocateMappedMemory(code_size, nullptr, rw_flags, error);
+    if (error) {
+        EXECUTION_LOG_ERROR("There was an error allocating executable memory {}", error.message());
+        return;
+    }
+
+    ProfilingStubGenerator generator(code_size, memory.base());
+    std::vector<void *>    stubs;
+    stubs.reserve(bytecode_module_->GetFunctionCount());
+    for (const auto &func_info : bytecode_module_->GetFunctionsInfo()) {
+        auto *baseline_function = baseline_module_->GetFunctionPointer(func_info.GetName());
+        NOISEPAGE_ASSERT(baseline_function != nullptr, "Missing function in compiled module!");
+        stubs.push_back(generator.Generate(&profile_counts_[func_info.GetId()], baseline_function));
+    }
+
+    const int32_t rx_flags = llvm::sys::Memory::MF_READ | llvm::sys::Memory::MF_EXEC;
+    llvm::sys::Memory::protectMappedMemory(memory, rx_flags);
+    profiling_stubs_ = Trampoline(llvm::sys::OwningMemoryBlock(memory));
+
+    InstallTier(Tier::Baseline, [&stubs](const FunctionInfo &func_info) {
+        return stubs[func_info.GetId()];
     });
 }
 
-void Module::CompileToMachineCodeAsync() {
-    auto *compile_task = new (tbb::task::allocate_root()) AsyncCompileTask(this);
+template <typename F>
+void Module::InstallTier(const Tier tier, F impl) {
+    std::lock_guard<std::mutex> guard(tier_latch_);
+    // A module given its compiled code up front, or compiled on request in compiled mode, never moves down
+    if (tier <= GetTier()) {
+        return;
+    }
+    for (const auto &func_info : bytecode_module_->GetFunctionsInfo()) {
+        functions_[func_info.GetId()].store(impl(func_info), std::memory_order_relaxed);
+    }
+    tier_.store(tier, std::memory_order_release);
+}
+
+void Module::RecordInvocation(const FunctionId func_id, const uint64_t loop_iterations) {
+    if (!tiering_enabled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    const uint64_t count = 1 + loop_iterations;
+    MaybeTierUp(profile_counts_[func_id].fetch_add(count, std::memory_order_relaxed) + count);
+}
+
+auto Module::GetMaxProfileCount() const -> uint64_t {
+    uint64_t max_count = 0;
+    for (uint32_t idx = 0; idx < bytecode_module_->GetFunctionCount(); idx++) {
+        max_count = std::max(max_count, profile_counts_[idx].load(std::memory_order_relaxed));
+    }
+    return max_count;
+}
+
+auto Module::NextTier(const uint64_t profile_count) const -> Tier {
+    const Tier tier = GetTier();
+    if (tier != Tier::Optimized && profile_count >= tier_thresholds_.optimized_) {
+        return Tier::Optimized;
+    }
+    if (tier == Tier::Interpreted && profile_count >= tier_thresholds_.baseline_) {
+        return Tier::Baseline;
+    }
+    return tier;
+}
+
+void Module::MaybeTierUp(const uint64_t profile_count) {
+    const Tier next_tier = NextTier(profile_count);
+    if (next_tier == GetTier() || tier_up_pending_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    bool expected = false;
+    if (!tier_up_pending_.compare_exchange_strong(expected, true)) {
+        return;
+    }
+    auto *compile_task = new (tbb::task::allocate_root()) AsyncCompileTask(this, next_tier);
     tbb::task::enqueue(*compile_task);
 }
 
+void Module::TierUp(Tier tier) {
+    // The profile may reach the next threshold while a tier is compiled. Go on to that tier right away, while still
+    // marked pending, so the module cannot be destroyed under this task.
+    while (true) {
+        if (tier == Tier::Optimized) {
+            CompileToMachineCode();
+        } else if (GetTier() < tier) {
+            CompileToBaselineCode();
+        }
+        const Tier next_tier = NextTier(GetMaxProfileCount());
+        if (next_tier <= tier) {
+            break;
+        }
+        tier = next_tier;
+    }
+    tier_up_pending_.store(false, std::memory_order_release);
+}
+
+void Module::WaitForTierUp() const {
+    while (tier_up_pending_.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
 } // namespace noisepage::execution::vm
@@ -2,11 +2,13 @@
 
 #include <numeric>
 #include <string>
+#include <utility>
 
 #include "execution/sql/value.h"
 #include "execution/util/memory.h"
 #include "execution/vm/bytecode_function_info.h"
 #include "execution/vm/bytecode_handlers.h"
+#include "execution/vm/bytecode_profile.h"
 #include "execution/vm/module.h"
 #include "loggers/execution_logger.h"
 
@@ -83,11 +85,11 @@ static constexpr const uint32_t MAX_STACK_ALLOC_SIZE = 1ull << 14ull;
 // requires less, use the stack.
 static constexpr const uint32_t SOFT_MAX_STACK_ALLOC_SIZE = 1ull << 12ull;
 
-VM::VM(const Module *module)
+VM::VM(Module *module)
     : module_(module) {}
 
 // static
-void VM::InvokeFunction(const Module *module, const FunctionId func_id, const uint8_t args[]) {
+void VM::InvokeFunction(Module *module, const FunctionId func_id, const uint8_t args[]) {
     // The function's info
     const FunctionInfo *func_info = module->GetFuncInfoById(func_id);
     NOISEPAGE_ASSERT(func_info != nullptr, "Function doesn't exist in module!");
@@ -113,6 +115,7 @@ void VM::InvokeFunction(const Module *module, const FunctionId func_id, const ui
     VM    vm(module);
     Frame frame(raw_frame, frame_size);
     vm.Interpret(module->GetBytecodeModule()->AccessBytecodeForFunctionRaw(*func_info), &frame);
+    module->RecordInvocation(func_id, vm.loop_iterations_);
 
     // Done. Now, let's cleanup.
     if (used_heap) {
@@ -160,6 +163,18 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) { // NOLINT
     } while (false)
 #else
 #define DEBUG_TRACE_INSTRUCTIONS(op) (void) op
+#endif
+
+#ifdef NOISEPAGE_PROFILE_BYTECODES
+    // The last bytecode dispatched in this frame, to count the pairs of bytecodes that run back to back
+    auto prev_op = BytecodeProfile::NO_BYTECODE;
+#define PROFILE_DISPATCH(op)                                                                                           \
+    do {                                                                                                               \
+        BytecodeProfile::Record(prev_op, op);                                                                          \
+        prev_op = op;                                                                                                  \
+    } while (false)
+#else
+#define PROFILE_DISPATCH(op) (void) op
 #endif
 
     // TODO(pmenon): Should these READ/PEEK macros take in a vm::OperandType so
@@ -185,6 +200,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) { // NOLINT
     do {                                                                                                               \
         auto op = READ_OP();                                                                                           \
         DEBUG_TRACE_INSTRUCTIONS(op);                                                                                  \
+        PROFILE_DISPATCH(op);                                                                                          \
         goto *kDispatchTable[op];                                                                                      \
     } while (false)
 
@@ -342,6 +358,8 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) { // NOLINT
         : {
         auto skip = PEEK_JMP_OFFSET();
         if (LIKELY(OpJump())) {
+            // Backward jumps close loops. Count them so hot loops promote their function to compiled code.
+            loop_iterations_ += static_cast<uint64_t>(skip < 0);
             ip += skip;
         }
         DISPATCH_NEXT();
@@ -733,6 +751,16 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) { // NOLINT
         DISPATCH_NEXT();
     }
 
+    OP(TableVectorIteratorAddBlockFilter)
+        : {
+        auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
+        auto  col_oid = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+        auto  min = frame->LocalAt<int64_t>(READ_LOCAL_ID());
+        auto  max = frame->LocalAt<int64_t>(READ_LOCAL_ID());
+        OpTableVectorIteratorAddBlockFilter(iter, col_oid, min, max);
+        DISPATCH_NEXT();
+    }
+
     OP(ParallelScanTable)
         : {
         auto  table_oid = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
@@ -1584,6 +1612,17 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) { // NOLINT
         DISPATCH_NEXT();
     }
 
+    OP(AggregationHashTableMergeOverflowPartitions)
+        : {
+        auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
+        auto *query_state = frame->LocalAt<void *>(READ_LOCAL_ID());
+        auto  merge_partition_fn_id = READ_FUNC_ID();
+        auto  merge_partition_fn = reinterpret_cast<sql::AggregationHashTable::MergePartitionFn>(
+            module_->GetRawFunctionImpl(merge_partition_fn_id));
+        OpAggregationHashTableMergeOverflowPartitions(agg_hash_table, query_state, merge_partition_fn);
+        DISPATCH_NEXT();
+    }
+
     OP(AggregationHashTableParallelPartitionedScan)
         : {
         auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
@@ -2045,6 +2084,15 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) { // NOLINT
         DISPATCH_NEXT();
     }
 
+    OP(SorterGetTupleAt)
+        : {
+        const auto **result = frame->LocalAt<const byte **>(READ_LOCAL_ID());
+        auto        *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
+        auto         idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+        OpSorterGetTupleAt(result, sorter, idx);
+        DISPATCH_NEXT();
+    }
+
     OP(SorterAllocTuple)
         : {
         auto *result = frame->LocalAt<byte **>(READ_LOCAL_ID());
@@ -2542,6 +2590,14 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) { // NOLINT
         DISPATCH_NEXT();
     }
 
+    OP(StorageInterfaceIndexBuildFinish)
+        : {
+        auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+        auto *storage_interface = frame->LocalAt<sql::StorageInterface *>(READ_LOCAL_ID());
+        OpStorageInterfaceIndexBuildFinish(result, storage_interface);
+        DISPATCH_NEXT();
+    }
+
     OP(StorageInterfaceIndexDelete)
         : {
         auto *storage_interface = frame->LocalAt<sql::StorageInterface *>(READ_LOCAL_ID());
@@ -3015,6 +3071,114 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) { // NOLINT
         DISPATCH_NEXT();
     }
 
+    // -------------------------------------------------------
+    // Superinstructions
+    // -------------------------------------------------------
+
+    // A superinstruction runs the handlers of the two bytecodes it fuses back to back, without a dispatch in between.
+    // Fused branches usually test the boolean the first half just wrote. That value is still in a register, so it is
+    // used directly instead of being reloaded from the frame.
+
+#define FUSED_JUMP_IF_FALSE(result)                                                                                    \
+    do {                                                                                                               \
+        auto *cond_ptr = static_cast<bool *>(frame->PtrToLocalAt(LocalVar::Decode(READ_LOCAL_ID())));                  \
+        auto  cond = cond_ptr == (result) ? *(result) : *cond_ptr;                                                     \
+        auto skip = PEEK_JMP_OFFSET();                                                                                 \
+        if (OpJumpIfFalse(cond)) {                                                                                     \
+            ip += skip;                                                                                                \
+        } else {                                                                                                       \
+            READ_JMP_OFFSET();                                                                                         \
+        }                                                                                                              \
+    } while (false)
+
+#define FUSED_JUMP()                                                                                                   \
+    do {                                                                                                               \
+        auto skip = PEEK_JMP_OFFSET();                                                                                 \
+        if (LIKELY(OpJump())) {                                                                                        \
+            loop_iterations_ += static_cast<uint64_t>(skip < 0);                                                       \
+            ip += skip;                                                                                                \
+        }                                                                                                              \
+    } while (false)
+
+#define DO_GEN_COMPARISON_JUMP(op, type)                                                                               \
+    OP(op##JumpIfFalse_##type)                                                                                         \
+        : {                                                                                                            \
+        auto *dest = frame->LocalAt<bool *>(READ_LOCAL_ID());                                                          \
+        auto  lhs = frame->LocalAt<type>(READ_LOCAL_ID());                                                             \
+        auto  rhs = frame->LocalAt<type>(READ_LOCAL_ID());                                                             \
+        Op##op##_##type(dest, lhs, rhs);                                                                               \
+        FUSED_JUMP_IF_FALSE(dest);                                                                                     \
+        DISPATCH_NEXT();                                                                                               \
+    }
+#define GEN_COMPARISON_JUMP_TYPES(type, ...)                                                                           \
+    DO_GEN_COMPARISON_JUMP(GreaterThan, type)                                                                          \
+    DO_GEN_COMPARISON_JUMP(GreaterThanEqual, type)                                                                     \
+    DO_GEN_COMPARISON_JUMP(Equal, type)                                                                                \
+    DO_GEN_COMPARISON_JUMP(LessThan, type)                                                                             \
+    DO_GEN_COMPARISON_JUMP(LessThanEqual, type)                                                                        \
+    DO_GEN_COMPARISON_JUMP(NotEqual, type)
+
+    INT_TYPES(GEN_COMPARISON_JUMP_TYPES)
+#undef GEN_COMPARISON_JUMP_TYPES
+#undef DO_GEN_COMPARISON_JUMP
+
+#define GEN_TEST_JUMP(NAME, CPP_TYPE)                                                                                  \
+    OP(NAME##JumpIfFalse)                                                                                              \
+        : {                                                                                                            \
+        auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());                                                        \
+        auto *input = frame->LocalAt<CPP_TYPE *>(READ_LOCAL_ID());                                                     \
+        Op##NAME(result, input);                                                                                       \
+        FUSED_JUMP_IF_FALSE(result);                                                                                   \
+        DISPATCH_NEXT();                                                                                               \
+    }
+
+    GEN_TEST_JUMP(VPIHasNext, sql::VectorProjectionIterator)
+    GEN_TEST_JUMP(VPIHasNextFiltered, sql::VectorProjectionIterator)
+    GEN_TEST_JUMP(AggregationHashTableIteratorHasNext, sql::AHTIterator)
+    GEN_TEST_JUMP(HashTableEntryIteratorHasNext, sql::HashTableEntryIterator)
+    GEN_TEST_JUMP(JoinHashTableIteratorHasNext, sql::JoinHashTableIterator)
+    GEN_TEST_JUMP(ForceBoolTruth, sql::BoolVal)
+#undef GEN_TEST_JUMP
+
+#define GEN_ADVANCE_JUMP(NAME)                                                                                         \
+    OP(NAME##Jump)                                                                                                     \
+        : {                                                                                                            \
+        auto *iter = frame->LocalAt<sql::VectorProjectionIterator *>(READ_LOCAL_ID());                                 \
+        Op##NAME(iter);                                                                                                \
+        FUSED_JUMP();                                                                                                  \
+        DISPATCH_NEXT();                                                                                               \
+    }
+
+    GEN_ADVANCE_JUMP(VPIAdvance)
+    GEN_ADVANCE_JUMP(VPIAdvanceFiltered)
+#undef GEN_ADVANCE_JUMP
+
+#define GEN_VPI_GET_HASH(NAME, CPP_TYPE, HASH)                                                                         \
+    OP(VPIGet##NAME##Hash##HASH)                                                                                       \
+        : {                                                                                                            \
+        auto *result = frame->LocalAt<CPP_TYPE *>(READ_LOCAL_ID());                                                    \
+        auto *vpi = frame->LocalAt<sql::VectorProjectionIterator *>(READ_LOCAL_ID());                                  \
+        auto  col_idx = READ_UIMM4();                                                                                  \
+        OpVPIGet##NAME(result, vpi, col_idx);                                                                          \
+        auto *hash_val = frame->LocalAt<hash_t *>(READ_LOCAL_ID());                                                    \
+        auto *input = frame->LocalAt<CPP_TYPE *>(READ_LOCAL_ID());                                                     \
+        auto  seed = frame->LocalAt<const hash_t>(READ_LOCAL_ID());                                                    \
+        OpHash##HASH(hash_val, input, seed);                                                                           \
+        DISPATCH_NEXT();                                                                                               \
+    }
+
+    GEN_VPI_GET_HASH(Integer, sql::Integer, Int)
+    GEN_VPI_GET_HASH(IntegerNull, sql::Integer, Int)
+    GEN_VPI_GET_HASH(BigInt, sql::Integer, Int)
+    GEN_VPI_GET_HASH(BigIntNull, sql::Integer, Int)
+    GEN_VPI_GET_HASH(Date, sql::DateVal, Date)
+    GEN_VPI_GET_HASH(DateNull, sql::DateVal, Date)
+    GEN_VPI_GET_HASH(String, sql::StringVal, String)
+    GEN_VPI_GET_HASH(StringNull, sql::StringVal, String)
+#undef GEN_VPI_GET_HASH
+#undef FUSED_JUMP
+#undef FUSED_JUMP_IF_FALSE
+
     // -------------------------------------------------------
     // Testing only functions
     // -------------------------------------------------------
@@ -3100,9 +3264,11 @@ auto VM::ExecuteCall(const uint8_t *ip, VM::Frame *caller) -> const uint8_t * {
         }
     }
 
-    // Let's go
-    Frame callee(raw_frame, func_info->GetFrameSize());
+    // Let's go. The callee's loop iterations are profiled separately from the caller's.
+    const uint64_t caller_loop_iterations = std::exchange(loop_iterations_, 0);
+    Frame          callee(raw_frame, func_info->GetFrameSize());
     Interpret(module_->GetBytecodeModule()->AccessBytecodeForFunctionRaw(*func_info), &callee);
+    module_->RecordInvocation(func_id, std::exchange(loop_iterations_, caller_loop_iterations));
 
     // Done. Now, let's cleanup.
     if (used_heap) {
@@ -106,8 +106,10 @@ DBMain::~DBMain() {
     ForceShutdown();
 }
 
-DBMain::ExecutionLayer::ExecutionLayer(const std::string &bytecode_handlers_path) {
-    execution::ExecutionUtil::InitTPL(bytecode_handlers_path);
+DBMain::ExecutionLayer::ExecutionLayer(const std::string &bytecode_handlers_path,
+                                       const std::string &jit_cache_directory,
+                                       const uint64_t     jit_cache_size) {
+    execution::ExecutionUtil::InitTPL(bytecode_handlers_path, jit_cache_directory, jit_cache_size);
 }
 
 DBMain::ExecutionLayer::~ExecutionLayer() {
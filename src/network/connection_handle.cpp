@@ -145,6 +145,7 @@ ConnectionHandle::ConnectionHandle(int
     , taskflow_(taskflow)
     , protocol_interpreter_(std::move(interpreter)) {
     context_.SetCallback(Callback, this);
+    context_.SetFlushCallback(FlushCallback);
     context_.SetConnectionID(static_cast<connection_id_t>(sock_fd));
 }
 
@@ -264,6 +265,11 @@ void ConnectionHandle::Callback(void *callback_args) {
     event_active(handle->workpool_event_, EV_WRITE, 0);
 }
 
+auto ConnectionHandle::FlushCallback(void *callback_args) -> bool {
+    auto *const handle = reinterpret_cast<ConnectionHandle *>(callback_args);
+    return handle->io_wrapper_->FlushAllWritesBlocking();
+}
+
 void ConnectionHandle::ResetForReuse(connection_id_t                               connection_id,
                                      common::ManagedPointer<ConnectionHandlerTask> task,
                                      std::unique_ptr<ProtocolInterpreter>          interpreter) {
@@ -276,6 +282,8 @@ void ConnectionHandle::ResetForReuse(connection_id_t
     network_event_ = nullptr;
     workpool_event_ = nullptr;
     context_.Reset();
+    context_.SetCallback(Callback, this);
+    context_.SetFlushCallback(FlushCallback);
     context_.SetConnectionID(connection_id);
 }
 
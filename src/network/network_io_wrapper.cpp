@@ -2,6 +2,7 @@
 
 #include <fcntl.h>
 #include <netinet/tcp.h>
+#include <poll.h>
 #include <unistd.h>
 
 #include "common/utility.h"
@@ -31,6 +32,29 @@ auto NetworkIoWrapper::FlushAllWrites() -> Transition {
     return Transition::PROCEED;
 }
 
+auto NetworkIoWrapper::FlushAllWritesBlocking() -> bool {
+    // Flushing resets the queue, which must still be flushed once the command completes if it had to be
+    const bool should_flush = out_->ShouldFlush();
+    while (true) {
+        const auto result = FlushAllWrites();
+        if (result == Transition::PROCEED) {
+            break;
+        }
+        if (result != Transition::NEED_WRITE) {
+            return false;
+        }
+        // The socket is non-blocking, so wait until the client has read enough for it to take more
+        pollfd poll_fd{sock_fd_, POLLOUT, 0};
+        if (poll(&poll_fd, 1, -1) < 0 && errno != EINTR) {
+            return false;
+        }
+    }
+    if (should_flush) {
+        out_->ForceFlush();
+    }
+    return true;
+}
+
 auto NetworkIoWrapper::Close() -> Transition {
     TerrierClose(sock_fd_);
     return Transition::PROCEED;
@@ -2,7 +2,9 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <variant>
+#include <vector>
 
 #include "common/thread_context.h"
 #include "metrics/metrics_store.h"
@@ -10,7 +12,9 @@
 #include "network/network_util.h"
 #include "network/postgres/postgres_packet_util.h"
 #include "network/postgres/postgres_protocol_interpreter.h"
+#include "network/postgres/shared_statement_cache.h"
 #include "network/postgres/statement.h"
+#include "parser/copy_statement.h"
 #include "parser/variable_show_statement.h"
 #include "taskflow/taskflow.h"
 
@@ -141,7 +145,7 @@ auto SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpreter>
     }
 
     const auto statement
-        = std::make_unique<network::Statement>(std::move(query_text),
+        = std::make_shared<network::Statement>(std::move(query_text),
                                                std::move(std::get<std::unique_ptr<parser::ParseResult>>(parse_result)));
 
     // TODO(Matt): Clients may send multiple statements in a single SimpleQuery packet/string. Handling that would
@@ -176,7 +180,7 @@ auto SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpreter>
             return FinishSimpleQueryCommand(writer, connection);
         }
 
-        auto set_result = taskflow->ExecuteSetStatement(connection, common::ManagedPointer(statement));
+        auto set_result = taskflow->ExecuteSetStatement(connection, common::ManagedPointer(statement.get()));
         if (set_result.type_ == taskflow::ResultType::ERROR) {
             writer->WriteError(std::get<common::ErrorData>(set_result.extra_));
         } else {
@@ -187,7 +191,7 @@ auto SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpreter>
 
     // TODO(WAN): this is a temporary hack to unblock Ziqi's oltpbench work. #1188
     if (UNLIKELY(query_type == network::QueryType::QUERY_SHOW)) {
-        auto show_result = taskflow->ExecuteShowStatement(connection, writer, common::ManagedPointer(statement));
+        auto show_result = taskflow->ExecuteShowStatement(connection, writer, common::ManagedPointer(statement.get()));
         NOISEPAGE_ASSERT(show_result.type_ == taskflow::ResultType::COMPLETE,
                          "TODO this should be fixed to handle failure.");
         writer->WriteCommandComplete(network::QueryType::QUERY_SHOW, 0);
@@ -218,8 +222,28 @@ auto SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpreter>
         return FinishSimpleQueryCommand(writer, connection);
     }
 
-    // This logic relies on ordering of values in the enum's definition and is documented there as well.
-    if (SqlUtil::UnsupportedQueryType(query_type)) {
+    // COPY ... FROM bulk loads a file and does not go through the binder and optimizer.
+    if (query_type == network::QueryType::QUERY_COPY
+        && statement->RootStatement().CastTo<parser::CopyStatement>()->IsFrom()) {
+        const auto copy_result = taskflow->ExecuteCopyStatement(connection, common::ManagedPointer(statement.get()));
+        if (copy_result.type_ == taskflow::ResultType::COMPLETE) {
+            writer->WriteCommandComplete(query_type, std::get<uint32_t>(copy_result.extra_));
+        } else {
+            writer->WriteError(std::get<common::ErrorData>(copy_result.extra_));
+        }
+    } else if (query_type == network::QueryType::QUERY_COPY
+               && statement->RootStatement().CastTo<parser::CopyStatement>()->GetExternalFileFormat()
+                      == parser::ExternalFileFormat::ARROW) {
+        // COPY ... TO in the arrow format streams the table's blocks rather than running a query.
+        const auto copy_result
+            = taskflow->ExecuteCopyToStatement(connection, writer, common::ManagedPointer(statement.get()));
+        if (copy_result.type_ == taskflow::ResultType::COMPLETE) {
+            writer->WriteCommandComplete(query_type, std::get<uint32_t>(copy_result.extra_));
+        } else {
+            writer->WriteError(std::get<common::ErrorData>(copy_result.extra_));
+        }
+    } else if (SqlUtil::UnsupportedQueryType(query_type)) {
+        // This logic relies on ordering of values in the enum's definition and is documented there as well.
         writer->WriteError({common::ErrorSeverity::NOTICE,
                             "we don't yet support that query type.",
                             common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED});
@@ -227,7 +251,7 @@ auto SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpreter>
     } else {
         // NOTE(x): most case
         // 尝试绑定已解析的语句(parsed statement)
-        const auto bind_result = taskflow->BindQuery(connection, common::ManagedPointer(statement), nullptr);
+        const auto bind_result = taskflow->BindQuery(connection, common::ManagedPointer(statement.get()), nullptr);
 
         // SQL语句执行的核心部分
         if (bind_result.type_ == taskflow::ResultType::COMPLETE) {
@@ -236,7 +260,7 @@ auto SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpreter>
 
             statement->SetOptimizeResult(std::move(optimize_result));
 
-            const auto portal = std::make_unique<Portal>(common::ManagedPointer(statement));
+            const auto portal = std::make_unique<Portal>(statement);
 
             if (query_type == network::QueryType::QUERY_SELECT) {
                 writer->WriteRowDescription(portal->OptimizeResult()->GetPlanNode()->GetOutputSchema()->GetColumns(),
@@ -320,7 +344,7 @@ auto ParseCommand::Exec(const common::ManagedPointer<ProtocolInterpreter>  inter
     auto param_types = PostgresPacketUtil::ReadParamTypes(common::ManagedPointer(&reader_));
 
     auto statement
-        = std::make_unique<network::Statement>(std::move(query_text),
+        = std::make_shared<network::Statement>(std::move(query_text),
                                                std::move(std::get<std::unique_ptr<parser::ParseResult>>(parse_result)),
                                                std::move(param_types));
 
@@ -345,12 +369,19 @@ auto ParseCommand::Exec(const common::ManagedPointer<ProtocolInterpreter>  inter
 
     auto cached_statement = postgres_interpreter->LookupStatementInCache(statement->GetQueryText());
     if (cached_statement == nullptr) {
-        // Not in the cache, add to cache
-        cached_statement = common::ManagedPointer(statement);
-        postgres_interpreter->AddStatementToCache(std::move(statement));
+        // Not in the cache of this connection, see if another connection already compiled it
+        if (taskflow->UseQueryCache() && SqlUtil::DMLQueryType(statement->GetQueryType())) {
+            cached_statement = taskflow->GetSharedStatementCache()->Lookup(connection->GetDatabaseOid(),
+                                                                           statement->GetQueryText(),
+                                                                           statement->ParamTypes());
+        }
+        if (cached_statement == nullptr) {
+            cached_statement = statement;
+        }
+        postgres_interpreter->AddStatementToCache(statement->GetQueryText(), cached_statement);
     }
 
-    postgres_interpreter->SetStatement(statement_name, cached_statement);
+    postgres_interpreter->SetStatement(statement_name, std::move(cached_statement));
 
     writer->WriteParseComplete();
     return Transition::PROCEED;
@@ -375,7 +406,7 @@ auto BindCommand::Exec(const common::ManagedPointer<ProtocolInterpreter>  interp
 
     const auto portal_name = reader_.ReadString();
     const auto statement_name = reader_.ReadString();
-    const auto statement = postgres_interpreter->GetStatement(statement_name);
+    auto       statement = postgres_interpreter->GetStatement(statement_name);
 
     if (statement == nullptr) {
         writer->WriteError({common::ErrorSeverity::ERROR,
@@ -462,8 +493,24 @@ auto BindCommand::Exec(const common::ManagedPointer<ProtocolInterpreter>  interp
         statement->ClearCachedObjects();
     }
 
+    if (UNLIKELY(statement->IsShared() && taskflow->IsQueryCacheStale(common::ManagedPointer(statement.get())))) {
+        // The catalog changed since the shared Statement was compiled, but other connections may still be running it.
+        // Replace it with a private copy that is bound, optimized and compiled again.
+        auto parse_result = taskflow->ParseQuery(statement->GetQueryText(), connection);
+        NOISEPAGE_ASSERT(std::holds_alternative<std::unique_ptr<parser::ParseResult>>(parse_result),
+                         "The query text parsed before, so it should parse again.");
+        auto &parse_tree = std::get<std::unique_ptr<parser::ParseResult>>(parse_result);
+        auto  private_statement
+            = std::make_shared<network::Statement>(std::string(statement->GetQueryText()),
+                                                   std::move(parse_tree),
+                                                   std::vector<execution::sql::SqlTypeId>(statement->ParamTypes()));
+        postgres_interpreter->ReplaceStatement(common::ManagedPointer(statement.get()), private_statement);
+        statement = std::move(private_statement);
+    }
+
     // Bind it, plan it
-    const auto bind_result = taskflow->BindQuery(connection, statement, common::ManagedPointer(&params));
+    const auto bind_result
+        = taskflow->BindQuery(connection, common::ManagedPointer(statement.get()), common::ManagedPointer(&params));
     if (LIKELY(bind_result.type_ == taskflow::ResultType::COMPLETE)) {
         // Binding succeeded, optimize to generate a physical plan
         if (statement->OptimizeResult() == nullptr || !taskflow->UseQueryCache()) {
@@ -481,7 +528,7 @@ auto BindCommand::Exec(const common::ManagedPointer<ProtocolInterpreter>  interp
     } else if (UNLIKELY(bind_result.type_ == taskflow::ResultType::NOTICE)) {
         // Binding generated a NOTICE, i.e. IF EXISTS failed, so we're not going to generate a physical plan of nullptr
         // and handle that case in Execute. In case it previously bound and compiled, we're gonna throw that away for
-        // next execution
+        // next execution. Only DDL can generate a NOTICE, and DDL Statements are never shared.
         statement->ClearCachedObjects();
         NOISEPAGE_ASSERT(std::holds_alternative<common::ErrorData>(bind_result.extra_),
                          "We're expecting a message here.");
@@ -497,8 +544,11 @@ auto BindCommand::Exec(const common::ManagedPointer<ProtocolInterpreter>  interp
                          "We're expecting a message here.");
         // failing to bind fails a transaction in postgres
         connection->Transaction()->SetMustAbort();
-        // clear anything cached related to this statement
-        statement->ClearCachedObjects();
+        // clear anything cached related to this statement, unless other connections may be running it. The parameters
+        // are what failed to bind in that case, since it was checked above that the catalog did not change.
+        if (!statement->IsShared()) {
+            statement->ClearCachedObjects();
+        }
         writer->WriteError(std::get<common::ErrorData>(bind_result.extra_));
         postgres_interpreter->SetWaitingForSync();
     }
@@ -661,6 +711,13 @@ auto ExecuteCommand::Exec(const common::ManagedPointer<ProtocolInterpreter>  int
         ExecutePortal(connection, portal, writer, taskflow, postgres_interpreter->ExplicitTransactionBlock());
         if (connection->TransactionState() == NetworkTransactionStateType::FAIL) {
             postgres_interpreter->SetWaitingForSync();
+        } else if (taskflow->UseQueryCache() && SqlUtil::DMLQueryType(query_type) && !statement->IsShared()) {
+            // Publish the compiled statement so that other connections don't have to compile it again, unless this
+            // connection replaced it in the meantime
+            const auto cached_statement = postgres_interpreter->LookupStatementInCache(statement->GetQueryText());
+            if (cached_statement.get() == statement.Get()) {
+                taskflow->GetSharedStatementCache()->Add(connection->GetDatabaseOid(), cached_statement);
+            }
         }
     } else {
         // This happens in the event of a noop generated earlier (like in binding with an IF EXISTS);
@@ -194,6 +194,9 @@ void PostgresPacketWriter::WriteCommandComplete(const QueryType query_type, cons
     case QueryType::QUERY_ANALYZE:
         WriteCommandComplete("ANALYZE");
         break;
+    case QueryType::QUERY_COPY:
+        WriteCommandComplete("COPY ", num_rows);
+        break;
     default:
         WriteCommandComplete("This QueryType needs a completion message!");
         break;
@@ -303,6 +306,29 @@ void PostgresPacketWriter::WriteDataRow(const byte *const
     EndPacket();
 }
 
+void PostgresPacketWriter::WriteCopyOutResponse(const uint16_t num_columns) {
+    // Overall format, then the format of every column: 1 for binary
+    BeginPacket(NetworkMessageType::PG_COPY_OUT_RESPONSE)
+        .AppendValue<int8_t>(1)
+        .AppendValue<int16_t>(static_cast<int16_t>(num_columns));
+    for (uint16_t i = 0; i < num_columns; i++) {
+        AppendValue<int16_t>(1);
+    }
+    EndPacket();
+}
+
+void PostgresPacketWriter::WriteCopyData(const std::vector<iovec> &buffers) {
+    BeginPacket(NetworkMessageType::PG_COPY_DATA);
+    for (const iovec &buffer : buffers) {
+        AppendRaw(buffer.iov_base, buffer.iov_len);
+    }
+    EndPacket();
+}
+
+void PostgresPacketWriter::WriteCopyDone() {
+    BeginPacket(NetworkMessageType::PG_COPY_DONE).EndPacket();
+}
+
 template <class native_type, class val_type>
 void PostgresPacketWriter::WriteBinaryVal(const execution::sql::Val *const val, const execution::sql::SqlTypeId type) {
     const auto *const casted_val = reinterpret_cast<const val_type *const>(val);
@@ -0,0 +1,149 @@
+#include "network/postgres/shared_statement_cache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/hash_util.h"
+#include "execution/compiler/executable_query.h"
+#include "network/postgres/statement.h"
+#include "xxHash/xxh3.h"
+
+namespace noisepage::network {
+
+auto SharedStatementCache::Lookup(const catalog::db_oid_t                       db_oid,
+                                  const std::string                            &query_text,
+                                  const std::vector<execution::sql::SqlTypeId> &param_types)
+    -> common::SanctionedSharedPtr<Statement>::Ptr {
+    const Key key{db_oid, NormalizeQueryText(query_text), param_types};
+
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    const auto                         it = entries_.find(key);
+    if (it == entries_.end() || IsStale(*it->second.statement_)) {
+        num_misses_++;
+        return nullptr;
+    }
+    num_hits_++;
+    lru_.splice(lru_.begin(), lru_, it->second.lru_position_);
+    return it->second.statement_;
+}
+
+auto SharedStatementCache::Add(const catalog::db_oid_t                            db_oid,
+                               const common::SanctionedSharedPtr<Statement>::Ptr &statement) -> bool {
+    NOISEPAGE_ASSERT(statement->GetExecutableQuery() != nullptr, "Only compiled Statements should be shared.");
+    Key        key{db_oid, NormalizeQueryText(statement->GetQueryText()), statement->ParamTypes()};
+    const auto size = EstimateSize(*statement);
+
+    std::vector<common::SanctionedSharedPtr<Statement>::Ptr> evicted;
+    {
+        common::SpinLatch::ScopedSpinLatch guard(&latch_);
+        if (IsStale(*statement) || size > size_limit_ || entries_.find(key) != entries_.end()) {
+            return false;
+        }
+        // The Statement is visible to the other connections as soon as we release the latch
+        statement->MarkShared();
+        lru_.push_front(key);
+        entries_.emplace(std::move(key), Entry{statement, size, lru_.begin()});
+        size_ += size;
+        num_entries_++;
+        EvictToSizeLimit(&evicted);
+    }
+    return true;
+}
+
+void SharedStatementCache::Invalidate(const transaction::timestamp_t timestamp) {
+    std::unordered_map<Key, Entry, KeyHasher> invalidated;
+    {
+        common::SpinLatch::ScopedSpinLatch guard(&latch_);
+        min_timestamp_ = std::max(min_timestamp_, timestamp);
+        invalidated.swap(entries_);
+        lru_.clear();
+        size_ = 0;
+        num_entries_ = 0;
+    }
+}
+
+void SharedStatementCache::SetSizeLimit(const uint64_t size_limit) {
+    std::vector<common::SanctionedSharedPtr<Statement>::Ptr> evicted;
+    {
+        common::SpinLatch::ScopedSpinLatch guard(&latch_);
+        size_limit_ = size_limit;
+        EvictToSizeLimit(&evicted);
+    }
+}
+
+void SharedStatementCache::EvictToSizeLimit(std::vector<common::SanctionedSharedPtr<Statement>::Ptr> *const evicted) {
+    while (size_.load() > size_limit_) {
+        NOISEPAGE_ASSERT(!lru_.empty(), "Size should be 0 if there are no entries.");
+        const auto it = entries_.find(lru_.back());
+        NOISEPAGE_ASSERT(it != entries_.end(), "Every key in the LRU list should have an entry.");
+        size_ -= it->second.size_;
+        evicted->emplace_back(std::move(it->second.statement_));
+        entries_.erase(it);
+        lru_.pop_back();
+        num_entries_--;
+        num_evictions_++;
+    }
+}
+
+auto SharedStatementCache::IsStale(const Statement &statement) const -> bool {
+    return statement.GetExecutableQuery()->GetTimestamp() < min_timestamp_;
+}
+
+auto SharedStatementCache::NormalizeQueryText(const std::string &query_text) -> std::string {
+    std::string normalized;
+    normalized.reserve(query_text.size());
+    char quote = '\0';
+    for (std::size_t i = 0; i < query_text.size(); i++) {
+        const char c = query_text[i];
+        if (quote != '\0') {
+            // Inside a string literal or a quoted identifier, everything is kept as is. A doubled quote is read as the
+            // end of the literal followed by the start of another one, which keeps it intact as well.
+            if (c == '\\') {
+                return query_text;
+            }
+            if (c == quote) {
+                quote = '\0';
+            }
+            normalized.push_back(c);
+            continue;
+        }
+        const char next = i + 1 < query_text.size() ? query_text[i + 1] : '\0';
+        // Parameters ($1, $2, ...) are the only tokens that start with a dollar sign and are not dollar-quoted strings
+        const bool dollar_quote = c == '$' && std::isdigit(static_cast<unsigned char>(next)) == 0;
+        if ((c == '-' && next == '-') || (c == '/' && next == '*') || dollar_quote) {
+            return query_text;
+        }
+        if (std::isspace(static_cast<unsigned char>(c)) != 0) {
+            // Collapse whitespace between tokens into a single space, and drop it at the start and the end
+            if (!normalized.empty() && normalized.back() != ' ') {
+                normalized.push_back(' ');
+            }
+            continue;
+        }
+        if (c == '\'' || c == '"') {
+            quote = c;
+        }
+        normalized.push_back(c);
+    }
+    if (!normalized.empty() && normalized.back() == ' ') {
+        normalized.pop_back();
+    }
+    return normalized;
+}
+
+auto SharedStatementCache::EstimateSize(const Statement &statement) -> uint64_t {
+    // The bytecode dominates the size of a compiled Statement, and the size of the parse tree and the physical plan
+    // grows with the length of the query text
+    return statement.GetQueryText().size() * 2 + statement.GetExecutableQuery()->GetBytecodeSize();
+}
+
+auto SharedStatementCache::KeyHasher::operator()(const Key &key) const -> std::size_t {
+    common::hash_t hash = XXH3_64bits(key.query_text_.data(), key.query_text_.length());
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(key.db_oid_.UnderlyingValue()));
+    return common::HashUtil::CombineHashInRange(hash, key.param_types_.cbegin(), key.param_types_.cend());
+}
+
+} // namespace noisepage::network
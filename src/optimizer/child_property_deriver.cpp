@@ -92,6 +92,11 @@ void ChildPropertyDeriver::Visit([[maybe_unused]] const Aggregate *op) {
     output_.emplace_back(new PropertySet(), std::vector<PropertySet *>{new PropertySet()});
 }
 
+void ChildPropertyDeriver::Visit([[maybe_unused]] const Window *op) {
+    // The window operator sorts its input itself and does not provide any sort order
+    output_.emplace_back(new PropertySet(), std::vector<PropertySet *>{new PropertySet()});
+}
+
 void ChildPropertyDeriver::Visit(const Limit *op) {
     // Limit fulfill the internal sort property
     std::vector<PropertySet *> child_input_properties{new PropertySet()};
@@ -141,6 +146,18 @@ void ChildPropertyDeriver::Visit([[maybe_unused]] const LeftSemiHashJoin *op) {
     DeriveForJoin();
 }
 
+void ChildPropertyDeriver::Visit(const InnerMergeJoin *op) {
+    // Both children must be sorted on their join keys, and the output keeps the order of the right child
+    std::vector<OrderByOrderingType> left_ascending(op->GetLeftKeys().size(), OrderByOrderingType::ASC);
+    std::vector<OrderByOrderingType> right_ascending(op->GetRightKeys().size(), OrderByOrderingType::ASC);
+
+    auto left_sort = new PropertySort(op->GetLeftKeys(), std::move(left_ascending));
+    auto right_sort = new PropertySort(op->GetRightKeys(), std::move(right_ascending));
+    auto left_prop = new PropertySet(std::vector<Property *>{left_sort});
+    auto right_prop = new PropertySet(std::vector<Property *>{right_sort});
+    output_.emplace_back(right_prop->Copy(), std::vector<PropertySet *>{left_prop, right_prop});
+}
+
 void ChildPropertyDeriver::Visit([[maybe_unused]] const Insert *op) {
     std::vector<PropertySet *> child_input_properties;
     output_.emplace_back(requirements_->Copy(), std::move(child_input_properties));
@@ -0,0 +1,21 @@
+#include "optimizer/cost_model/cost_model_util.h"
+
+#include "common/macros.h"
+#include "execution/util/execution_common.h"
+#include "optimizer/cost_model/stats_cost_model.h"
+#include "optimizer/cost_model/trivial_cost_model.h"
+
+namespace noisepage::optimizer {
+
+auto CostModelUtil::CreateCostModel(const CostModelType type) -> std::unique_ptr<AbstractCostModel> {
+    switch (type) {
+    case CostModelType::TRIVIAL:
+        return std::make_unique<TrivialCostModel>();
+    case CostModelType::STATS:
+        return std::make_unique<StatsCostModel>();
+    default:
+        UNREACHABLE("Unknown cost model type.");
+    }
+}
+
+} // namespace noisepage::optimizer
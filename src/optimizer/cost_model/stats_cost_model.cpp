@@ -0,0 +1,135 @@
+#include "optimizer/cost_model/stats_cost_model.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "optimizer/group.h"
+#include "optimizer/group_expression.h"
+#include "optimizer/memo.h"
+#include "optimizer/physical_operators.h"
+
+namespace noisepage::optimizer {
+
+auto StatsCostModel::CalculateCost(transaction::TransactionContext *txn,
+                                   catalog::CatalogAccessor        *accessor,
+                                   Memo                            *memo,
+                                   GroupExpression                 *gexpr) -> double {
+    gexpr_ = gexpr;
+    memo_ = memo;
+    txn_ = txn;
+    accessor_ = accessor;
+    // Operators that are not visited below (e.g., DDL) have no cost
+    output_cost_ = 0.f;
+    gexpr_->Contents()->Accept(common::ManagedPointer<OperatorVisitor>(this));
+    return output_cost_;
+}
+
+void StatsCostModel::Visit(const SeqScan *op) {
+    // Every tuple of the table is read and has the predicates evaluated on it
+    double     table_rows = OutputRows();
+    const auto table_num_rows = memo_->GetGroupByID(gexpr_->GetGroupID())->GetTableNumRows();
+    if (table_num_rows != Group::UNINITIALIZED_NUM_ROWS) {
+        table_rows = std::max(table_rows, static_cast<double>(table_num_rows));
+    }
+    const auto num_predicates = static_cast<double>(op->GetPredicates().size());
+    output_cost_ = table_rows * (SEQ_ACCESS_COST + num_predicates * CPU_OPERATOR_COST) + OutputRows() * CPU_TUPLE_COST;
+}
+
+void StatsCostModel::Visit(const IndexScan *op) {
+    // An index scan without bounds walks the whole index. Otherwise, we assume that the bounds are what makes the scan
+    // selective, and that the tuples it reads are the ones output by the scan.
+    double scanned_rows = OutputRows();
+    if (op->GetBounds().empty()) {
+        const auto table_rows = memo_->GetGroupByID(gexpr_->GetGroupID())->GetTableNumRows();
+        if (table_rows != Group::UNINITIALIZED_NUM_ROWS) {
+            scanned_rows = std::max(scanned_rows, static_cast<double>(table_rows));
+        }
+    }
+    const auto num_predicates = static_cast<double>(op->GetPredicates().size());
+    output_cost_ = INDEX_LOOKUP_COST + scanned_rows * (RANDOM_ACCESS_COST + num_predicates * CPU_OPERATOR_COST)
+                 + OutputRows() * CPU_TUPLE_COST;
+}
+
+void StatsCostModel::Visit([[maybe_unused]] const QueryDerivedScan *op) {
+    output_cost_ = ChildRows(0) * CPU_TUPLE_COST;
+}
+
+void StatsCostModel::Visit([[maybe_unused]] const OrderBy *op) {
+    // The child is materialized and sorted with n log n comparisons
+    const auto child_rows = ChildRows(0);
+    output_cost_ = child_rows * std::log2(child_rows + 1) * CPU_OPERATOR_COST + child_rows * CPU_TUPLE_COST;
+}
+
+void StatsCostModel::Visit([[maybe_unused]] const Limit *op) {
+    output_cost_ = OutputRows() * CPU_TUPLE_COST;
+}
+
+void StatsCostModel::Visit(const InnerIndexJoin *op) {
+    // Every tuple of the outer child looks up the index, and every match is a random access into the inner table.
+    // Without join keys, every lookup walks the whole index, which we cannot cost without the size of the inner table.
+    const auto outer_rows = ChildRows(0);
+    auto       lookup_cost = INDEX_LOOKUP_COST;
+    if (op->GetJoinKeys().empty()) {
+        lookup_cost *= OutputRows();
+    }
+    output_cost_ = outer_rows * lookup_cost + OutputRows() * (RANDOM_ACCESS_COST + CPU_TUPLE_COST);
+}
+
+void StatsCostModel::Visit(const HashGroupBy *op) {
+    const auto num_having = static_cast<double>(op->GetHaving().size());
+    output_cost_ = ChildRows(0) * HASH_BUILD_COST + OutputRows() * (num_having * CPU_OPERATOR_COST + CPU_TUPLE_COST);
+}
+
+void StatsCostModel::Visit(const SortGroupBy *op) {
+    // The child is required to be sorted on the group by columns, so the sort is costed by the OrderBy below it
+    const auto num_having = static_cast<double>(op->GetHaving().size());
+    output_cost_
+        = ChildRows(0) * CPU_OPERATOR_COST + OutputRows() * (num_having * CPU_OPERATOR_COST + CPU_TUPLE_COST);
+}
+
+void StatsCostModel::Visit([[maybe_unused]] const Aggregate *op) {
+    output_cost_ = ChildRows(0) * CPU_OPERATOR_COST + CPU_TUPLE_COST;
+}
+
+void StatsCostModel::Visit(const Window *op) {
+    // The child is materialized and sorted on the window, then every window function is computed in one pass
+    const auto child_rows = ChildRows(0);
+    const auto num_window_exprs = static_cast<double>(op->GetWindowExprs().size());
+    output_cost_ = child_rows * std::log2(child_rows + 1) * CPU_OPERATOR_COST
+                 + child_rows * (num_window_exprs * CPU_OPERATOR_COST + CPU_TUPLE_COST);
+}
+
+auto StatsCostModel::NumRows(Group *group) -> double {
+    return group->HasNumRows() ? static_cast<double>(group->GetNumRows()) : 0.f;
+}
+
+auto StatsCostModel::OutputRows() const -> double {
+    return NumRows(memo_->GetGroupByID(gexpr_->GetGroupID()));
+}
+
+auto StatsCostModel::ChildRows(const int child_idx) const -> double {
+    return NumRows(memo_->GetGroupByID(gexpr_->GetChildGroupId(child_idx)));
+}
+
+void StatsCostModel::CostNLJoin() {
+    // The right child is scanned again for every tuple of the left child
+    const auto pairs = ChildRows(0) * ChildRows(1);
+    output_cost_ = pairs * (SEQ_ACCESS_COST + CPU_OPERATOR_COST) + OutputRows() * CPU_TUPLE_COST;
+}
+
+void StatsCostModel::CostHashJoin() {
+    // The hash table is built on the left child, so the optimizer prefers the smaller child on the left
+    output_cost_
+        = ChildRows(0) * HASH_BUILD_COST + ChildRows(1) * HASH_PROBE_COST + OutputRows() * CPU_TUPLE_COST;
+}
+
+void StatsCostModel::CostMergeJoin() {
+    // The left child is materialized, and every tuple of both children is compared about once. Sorting the children on
+    // the join keys, if they are not already, is costed by the OrderBy enforced below the join.
+    const auto left_rows = ChildRows(0);
+    const auto right_rows = ChildRows(1);
+    output_cost_ = left_rows * CPU_TUPLE_COST + (left_rows + right_rows) * CPU_OPERATOR_COST
+                 + OutputRows() * CPU_TUPLE_COST;
+}
+
+} // namespace noisepage::optimizer
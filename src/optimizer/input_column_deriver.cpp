@@ -88,11 +88,7 @@ void InputColumnDeriver::Visit(const Limit *op) {
     // sort columns are needed by the child node
     ExprSet input_cols_set;
     for (auto expr : required_cols_) {
-        if (parser::ExpressionUtil::IsAggregateExpression(expr)) {
-            input_cols_set.insert(expr);
-        } else {
-            parser::ExpressionUtil::GetTupleValueExprs(&input_cols_set, expr);
-        }
+        parser::ExpressionUtil::GetTupleAndAggregateExprs(&input_cols_set, expr);
     }
 
     auto sort_expressions = op->GetSortExpressions();
@@ -176,11 +172,7 @@ void InputColumnDeriver::Visit([[maybe_unused]] const OrderBy *op) {
 
     ExprSet input_cols_set;
     for (auto expr : required_cols_) {
-        if (parser::ExpressionUtil::IsAggregateExpression(expr)) {
-            input_cols_set.insert(expr);
-        } else {
-            parser::ExpressionUtil::GetTupleValueExprs(&input_cols_set, expr);
-        }
+        parser::ExpressionUtil::GetTupleAndAggregateExprs(&input_cols_set, expr);
     }
 
     auto   sort_prop = prop->As<PropertySort>();
@@ -210,6 +202,45 @@ void InputColumnDeriver::Visit(const Aggregate *op) {
     AggregateHelper(op);
 }
 
+void InputColumnDeriver::Visit(const Window *op) {
+    // The window functions of this operator are computed here, everything else is passed through from the child
+    ExprSet window_exprs_set;
+    for (const auto &window_expr : op->GetWindowExprs()) {
+        window_exprs_set.insert(window_expr);
+    }
+
+    ExprMap output_cols_map;
+    for (auto expr : required_cols_) {
+        parser::ExpressionUtil::GetTupleAndAggregateExprs(&output_cols_map, expr);
+    }
+
+    ExprSet input_cols_set;
+    for (const auto &entry : output_cols_map) {
+        if (window_exprs_set.count(entry.first) == 0U) {
+            input_cols_set.insert(entry.first);
+        }
+    }
+    // The arguments, PARTITION BY and ORDER BY of the window functions are needed by the child
+    for (const auto &window_expr : op->GetWindowExprs()) {
+        for (const auto &child : window_expr->GetChildren()) {
+            parser::ExpressionUtil::GetTupleAndAggregateExprs(&input_cols_set, child);
+        }
+    }
+
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> output_cols(output_cols_map.size());
+    for (const auto &entry : output_cols_map) {
+        output_cols[entry.second] = entry.first;
+    }
+
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> input_cols;
+    for (const auto &col : input_cols_set) {
+        input_cols.push_back(col);
+    }
+
+    PT2 child_cols = PT2{input_cols};
+    output_input_cols_ = std::make_pair(std::move(output_cols), std::move(child_cols));
+}
+
 void InputColumnDeriver::Visit(const InnerIndexJoin *op) {
     ExprSet input_cols_set;
     for (auto &join_keys : op->GetJoinKeys()) {
@@ -315,6 +346,10 @@ void InputColumnDeriver::Visit([[maybe_unused]] const OuterHashJoin *op) {
     NOISEPAGE_ASSERT(0, "OuterHashJoin not supported");
 }
 
+void InputColumnDeriver::Visit(const InnerMergeJoin *op) {
+    JoinHelper(op);
+}
+
 void InputColumnDeriver::Visit([[maybe_unused]] const Insert *op) {
     auto input = std::vector<std::vector<common::ManagedPointer<parser::AbstractExpression>>>{};
     output_input_cols_ = std::make_pair(std::move(required_cols_), std::move(input));
@@ -477,6 +512,11 @@ void InputColumnDeriver::JoinHelper(const BaseOperatorNodeContents *op) {
         join_conds = join_op->GetJoinPredicates();
         left_keys = join_op->GetLeftKeys();
         right_keys = join_op->GetRightKeys();
+    } else if (op->GetOpType() == OpType::INNERMERGEJOIN) {
+        auto join_op = reinterpret_cast<const InnerMergeJoin *>(op);
+        join_conds = join_op->GetJoinPredicates();
+        left_keys = join_op->GetLeftKeys();
+        right_keys = join_op->GetRightKeys();
     }
 
     ExprSet input_cols_set;
@@ -1574,6 +1574,43 @@ auto LogicalAnalyze::operator==(const BaseOperatorNodeContents &r) -> bool {
     return true;
 }
 
+//===--------------------------------------------------------------------===//
+// LogicalWindow
+//===--------------------------------------------------------------------===//
+auto LogicalWindow::Copy() const -> BaseOperatorNodeContents * {
+    return new LogicalWindow(*this);
+}
+
+auto LogicalWindow::Make(std::vector<common::ManagedPointer<parser::AbstractExpression>> &&window_exprs) -> Operator {
+    auto *window = new LogicalWindow();
+    window->window_exprs_ = std::move(window_exprs);
+    return Operator(common::ManagedPointer<BaseOperatorNodeContents>(window));
+}
+
+auto LogicalWindow::operator==(const BaseOperatorNodeContents &r) -> bool {
+    if (r.GetOpType() != OpType::LOGICALWINDOW) {
+        return false;
+    }
+    const LogicalWindow &node = *static_cast<const LogicalWindow *>(&r);
+    if (window_exprs_.size() != node.window_exprs_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < window_exprs_.size(); i++) {
+        if (*(window_exprs_[i]) != *(node.window_exprs_[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto LogicalWindow::Hash() const -> common::hash_t {
+    common::hash_t hash = BaseOperatorNodeContents::Hash();
+    for (auto &expr : window_exprs_) {
+        hash = common::HashUtil::SumHashes(hash, expr->Hash());
+    }
+    return hash;
+}
+
 //===--------------------------------------------------------------------===//
 // LogicalUnion
 //===--------------------------------------------------------------------===//
@@ -1738,6 +1775,8 @@ template <>
 const char *OperatorNodeContents<LogicalCteScan>::name = "LogicalCteScan";
 template <>
 const char *OperatorNodeContents<LogicalUnion>::name = "LogicalUnion";
+template <>
+const char *OperatorNodeContents<LogicalWindow>::name = "LogicalWindow";
 
 //===--------------------------------------------------------------------===//
 template <>
@@ -1814,5 +1853,7 @@ template <>
 OpType OperatorNodeContents<LogicalCteScan>::type = OpType::LOGICALCTESCAN;
 template <>
 OpType OperatorNodeContents<LogicalUnion>::type = OpType::LOGICALUNION;
+template <>
+OpType OperatorNodeContents<LogicalWindow>::type = OpType::LOGICALWINDOW;
 
 } // namespace noisepage::optimizer
@@ -810,6 +810,64 @@ auto OuterHashJoin::operator==(const BaseOperatorNodeContents &r) -> bool {
     return (*join_predicate_ == *(node.join_predicate_));
 }
 
+//===--------------------------------------------------------------------===//
+// InnerMergeJoin
+//===--------------------------------------------------------------------===//
+auto InnerMergeJoin::Copy() const -> BaseOperatorNodeContents * {
+    return new InnerMergeJoin(*this);
+}
+
+auto InnerMergeJoin::Make(std::vector<AnnotatedExpression>                                &&join_predicates,
+                          std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_keys,
+                          std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_keys) -> Operator {
+    auto *join = new InnerMergeJoin();
+    join->join_predicates_ = std::move(join_predicates);
+    join->left_keys_ = std::move(left_keys);
+    join->right_keys_ = std::move(right_keys);
+    return Operator(common::ManagedPointer<BaseOperatorNodeContents>(join));
+}
+
+auto InnerMergeJoin::Hash() const -> common::hash_t {
+    common::hash_t hash = BaseOperatorNodeContents::Hash();
+    for (auto &expr : left_keys_) {
+        hash = common::HashUtil::CombineHashes(hash, expr->Hash());
+    }
+    for (auto &expr : right_keys_) {
+        hash = common::HashUtil::CombineHashes(hash, expr->Hash());
+    }
+    for (auto &pred : join_predicates_) {
+        auto expr = pred.GetExpr();
+        if (expr) {
+            hash = common::HashUtil::SumHashes(hash, expr->Hash());
+        } else {
+            hash = common::HashUtil::SumHashes(hash, BaseOperatorNodeContents::Hash());
+        }
+    }
+    return hash;
+}
+
+auto InnerMergeJoin::operator==(const BaseOperatorNodeContents &r) -> bool {
+    if (r.GetOpType() != OpType::INNERMERGEJOIN) {
+        return false;
+    }
+    const InnerMergeJoin &node = *dynamic_cast<const InnerMergeJoin *>(&r);
+    if (left_keys_.size() != node.left_keys_.size() || right_keys_.size() != node.right_keys_.size()
+        || join_predicates_ != node.join_predicates_) {
+        return false;
+    }
+    for (size_t i = 0; i < left_keys_.size(); i++) {
+        if (*(left_keys_[i]) != *(node.left_keys_[i])) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < right_keys_.size(); i++) {
+        if (*(right_keys_[i]) != *(node.right_keys_[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
 //===--------------------------------------------------------------------===//
 // Insert
 //===--------------------------------------------------------------------===//
@@ -1132,6 +1190,43 @@ auto SortGroupBy::Hash() const -> common::hash_t {
     return hash;
 }
 
+//===--------------------------------------------------------------------===//
+// Window
+//===--------------------------------------------------------------------===//
+auto Window::Copy() const -> BaseOperatorNodeContents * {
+    return new Window(*this);
+}
+
+auto Window::Make(std::vector<common::ManagedPointer<parser::AbstractExpression>> &&window_exprs) -> Operator {
+    auto *window = new Window();
+    window->window_exprs_ = std::move(window_exprs);
+    return Operator(common::ManagedPointer<BaseOperatorNodeContents>(window));
+}
+
+auto Window::operator==(const BaseOperatorNodeContents &r) -> bool {
+    if (r.GetOpType() != OpType::WINDOW) {
+        return false;
+    }
+    const Window &node = *static_cast<const Window *>(&r);
+    if (window_exprs_.size() != node.window_exprs_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < window_exprs_.size(); i++) {
+        if (*(window_exprs_[i]) != *(node.window_exprs_[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto Window::Hash() const -> common::hash_t {
+    common::hash_t hash = BaseOperatorNodeContents::Hash();
+    for (auto &expr : window_exprs_) {
+        hash = common::HashUtil::SumHashes(hash, expr->Hash());
+    }
+    return hash;
+}
+
 //===--------------------------------------------------------------------===//
 // Aggregate
 //===--------------------------------------------------------------------===//
@@ -1855,6 +1950,8 @@ const char *OperatorNodeContents<RightHashJoin>::name = "RightHashJoin";
 template <>
 const char *OperatorNodeContents<OuterHashJoin>::name = "OuterHashJoin";
 template <>
+const char *OperatorNodeContents<InnerMergeJoin>::name = "InnerMergeJoin";
+template <>
 const char *OperatorNodeContents<Insert>::name = "Insert";
 template <>
 const char *OperatorNodeContents<InsertSelect>::name = "InsertSelect";
@@ -1900,6 +1997,8 @@ template <>
 const char *OperatorNodeContents<Analyze>::name = "Analyze";
 template <>
 const char *OperatorNodeContents<CteScan>::name = "CteScan";
+template <>
+const char *OperatorNodeContents<Window>::name = "Window";
 
 //===--------------------------------------------------------------------===//
 template <>
@@ -1937,6 +2036,8 @@ OpType OperatorNodeContents<RightHashJoin>::type = OpType::RIGHTHASHJOIN;
 template <>
 OpType OperatorNodeContents<OuterHashJoin>::type = OpType::OUTERHASHJOIN;
 template <>
+OpType OperatorNodeContents<InnerMergeJoin>::type = OpType::INNERMERGEJOIN;
+template <>
 OpType OperatorNodeContents<Insert>::type = OpType::INSERT;
 template <>
 OpType OperatorNodeContents<InsertSelect>::type = OpType::INSERTSELECT;
@@ -1982,5 +2083,7 @@ template <>
 OpType OperatorNodeContents<Analyze>::type = OpType::ANALYZE;
 template <>
 OpType OperatorNodeContents<CteScan>::type = OpType::CTESCAN;
+template <>
+OpType OperatorNodeContents<Window>::type = OpType::WINDOW;
 
 } // namespace noisepage::optimizer
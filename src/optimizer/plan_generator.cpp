@@ -42,11 +42,13 @@
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
 #include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/projection_plan_node.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
+#include "planner/plannodes/window_plan_node.h"
 #include "settings/settings_manager.h"
 #include "storage/sql_table.h"
 #include "transaction/transaction_context.h"
@@ -302,6 +304,9 @@ void PlanGenerator::Visit(const ExternalFileScan *op) {
     case parser::ExternalFileFormat::BINARY: {
         NOISEPAGE_ASSERT(0, "Missing BinaryScanPlanNode");
     }
+    case parser::ExternalFileFormat::ARROW: {
+        NOISEPAGE_ASSERT(0, "Arrow streams can only be written by COPY ... TO");
+    }
     }
 }
 
@@ -732,6 +737,44 @@ void PlanGenerator::Visit(const LeftSemiHashJoin *op) {
     output_plan_ = builder.Build();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// A mergejoin B (when both are already sorted on the join keys)
+///////////////////////////////////////////////////////////////////////////////
+
+void PlanGenerator::Visit(const InnerMergeJoin *op) {
+    auto proj_schema = GenerateProjectionForJoin();
+
+    auto comb_pred = parser::ExpressionUtil::JoinAnnotatedExprs(op->GetJoinPredicates());
+    auto eval_pred
+        = parser::ExpressionUtil::EvaluateExpression(children_expr_map_, common::ManagedPointer(comb_pred.get()));
+    auto join_predicate
+        = parser::ExpressionUtil::ConvertExprCVNodes(common::ManagedPointer(eval_pred.get()), children_expr_map_)
+              .release();
+    RegisterPointerCleanup<parser::AbstractExpression>(join_predicate, true, true);
+
+    auto builder = planner::MergeJoinPlanNode::Builder();
+    builder.SetOutputSchema(std::move(proj_schema));
+    builder.SetPlanNodeId(GetNextPlanNodeID());
+
+    for (auto &expr : op->GetLeftKeys()) {
+        auto left_key = parser::ExpressionUtil::EvaluateExpression(children_expr_map_, expr).release();
+        RegisterPointerCleanup<parser::AbstractExpression>(left_key, true, true);
+        builder.AddLeftMergeKey(common::ManagedPointer(left_key));
+    }
+
+    for (auto &expr : op->GetRightKeys()) {
+        auto right_key = parser::ExpressionUtil::EvaluateExpression(children_expr_map_, expr).release();
+        RegisterPointerCleanup<parser::AbstractExpression>(right_key, true, true);
+        builder.AddRightMergeKey(common::ManagedPointer(right_key));
+    }
+
+    builder.AddChild(std::move(children_plans_[0]));
+    builder.AddChild(std::move(children_plans_[1]));
+    builder.SetJoinPredicate(common::ManagedPointer(join_predicate));
+    builder.SetJoinType(planner::LogicalJoinType::INNER);
+    output_plan_ = builder.Build();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Aggregations (when the groups are greater than individuals)
 ///////////////////////////////////////////////////////////////////////////////
@@ -831,6 +874,47 @@ void PlanGenerator::Visit([[maybe_unused]] const Aggregate *op) {
     BuildAggregatePlan(planner::AggregateStrategyType::PLAIN, nullptr, nullptr);
 }
 
+void PlanGenerator::Visit(const Window *op) {
+    NOISEPAGE_ASSERT(children_plans_.size() == 1, "Window needs 1 child plan");
+    NOISEPAGE_ASSERT(children_expr_map_.size() == 1, "Window needs 1 child expr map");
+    auto &child_expr_map = children_expr_map_[0];
+    auto  builder = planner::WindowPlanNode::Builder();
+
+    // The window values are output into the 1st relation, in the order of the window terms
+    ExprMap window_map;
+    for (const auto &window_expr : op->GetWindowExprs()) {
+        window_map[window_expr] = static_cast<unsigned>(window_map.size());
+
+        // We need to evaluate the expression first, convert ColumnValue => DerivedValue
+        auto eval = parser::ExpressionUtil::EvaluateExpression(children_expr_map_, window_expr).release();
+        NOISEPAGE_ASSERT(parser::ExpressionUtil::IsWindowExpression(eval->GetExpressionType()),
+                         "Evaluated WindowExpression should still be a window expression");
+
+        auto window_term = reinterpret_cast<parser::WindowExpression *>(eval);
+        RegisterPointerCleanup<parser::WindowExpression>(window_term, true, true);
+        builder.AddWindowTerm(common::ManagedPointer(window_term));
+    }
+
+    // Everything else is passed through from the child, which is the 0th relation
+    std::vector<planner::OutputSchema::Column> columns;
+    for (const auto &expr : output_cols_) {
+        expr->DeriveReturnValueType();
+        std::unique_ptr<parser::DerivedValueExpression> dve;
+        if (window_map.find(expr) != window_map.end()) {
+            dve = std::make_unique<parser::DerivedValueExpression>(expr->GetReturnValueType(), 1, window_map[expr]);
+        } else {
+            NOISEPAGE_ASSERT(child_expr_map.find(expr) != child_expr_map.end(), "Missing column from the child");
+            dve = std::make_unique<parser::DerivedValueExpression>(expr->GetReturnValueType(), 0, child_expr_map[expr]);
+        }
+        columns.emplace_back(expr->GetExpressionName(), expr->GetReturnValueType(), std::move(dve));
+    }
+
+    builder.SetOutputSchema(std::make_unique<planner::OutputSchema>(std::move(columns)));
+    builder.SetPlanNodeId(GetNextPlanNodeID());
+    builder.AddChild(std::move(children_plans_[0]));
+    output_plan_ = builder.Build();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Insert/Update/Delete
 // To update or delete or select tuples, one must insert them first
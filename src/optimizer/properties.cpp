@@ -32,10 +32,10 @@ auto PropertySort::operator>=(const Property &r) const -> bool {
         return false;
     }
 
-    // Check that the AbstractExpression of sort column match.
+    // Check that the AbstractExpression of sort column match, and that they are sorted in the same direction.
     // This relies on AbstractExpression::operator== working correctly.
     for (size_t idx = 0; idx < r_num_sort_columns; ++idx) {
-        if (*sort_columns_[idx] != *r_sort.sort_columns_[idx]) {
+        if (*sort_columns_[idx] != *r_sort.sort_columns_[idx] || sort_ascending_[idx] != r_sort.sort_ascending_[idx]) {
             return false;
         }
     }
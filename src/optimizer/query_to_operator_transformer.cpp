@@ -19,6 +19,7 @@
 #include "parser/expression/comparison_expression.h"
 #include "parser/expression/operator_expression.h"
 #include "parser/expression/subquery_expression.h"
+#include "parser/expression/window_expression.h"
 #include "parser/expression_util.h"
 #include "parser/postgresparser.h"
 #include "parser/statements.h"
@@ -249,6 +250,18 @@ void QueryToOperatorTransformer::Visit(common::ManagedPointer<parser::SelectStat
             accessor_->GetTxn().Get());
     }
 
+    // Window functions are computed after aggregation, so that they can be applied to the aggregates, and each window
+    // gets its own window operator on top of the previous one
+    for (auto &window_exprs : CollectWindows(common::ManagedPointer(op))) {
+        OPTIMIZER_LOG_DEBUG("Handling window functions in SelectStatement ...");
+        auto window_expr = std::make_unique<OperatorNode>(
+            LogicalWindow::Make(std::move(window_exprs)).RegisterWithTxnContext(txn_context),
+            std::vector<std::unique_ptr<AbstractOptimizerNode>>{},
+            txn_context);
+        window_expr->PushChild(std::move(output_expr_));
+        output_expr_ = std::move(window_expr);
+    }
+
     if (op->GetSelectLimit() != nullptr && op->GetSelectLimit()->GetLimit() != -1) {
         OPTIMIZER_LOG_DEBUG("Handling order by/limit/offset in SelectStatement ...");
         std::vector<common::ManagedPointer<parser::AbstractExpression>> sort_exprs;
@@ -939,6 +952,74 @@ auto QueryToOperatorTransformer::RequireAggregation(common::ManagedPointer<parse
     return has_aggregation;
 }
 
+auto QueryToOperatorTransformer::CollectWindows(common::ManagedPointer<parser::SelectStatement> op)
+    -> std::vector<std::vector<common::ManagedPointer<parser::AbstractExpression>>> {
+    std::vector<common::ManagedPointer<parser::WindowExpression>> window_exprs;
+    for (auto &expr : op->GetSelectColumns()) {
+        parser::ExpressionUtil::GetWindowExprs(&window_exprs, expr);
+    }
+    if (op->GetSelectOrderBy() != nullptr) {
+        for (auto &expr : op->GetSelectOrderBy()->GetOrderByExpressions()) {
+            parser::ExpressionUtil::GetWindowExprs(&window_exprs, expr);
+        }
+    }
+    if (window_exprs.empty()) {
+        return {};
+    }
+
+    // TODO(peloton): Should be handled in the binder
+    const auto contains_window = [](common::ManagedPointer<parser::AbstractExpression> expr) {
+        std::vector<common::ManagedPointer<parser::WindowExpression>> nested;
+        if (expr != nullptr) {
+            parser::ExpressionUtil::GetWindowExprs(&nested, expr);
+        }
+        return !nested.empty();
+    };
+    if (contains_window(op->GetSelectCondition())) {
+        throw OPTIMIZER_EXCEPTION("Window functions are not allowed in WHERE");
+    }
+    if (op->GetSelectGroupBy() != nullptr) {
+        for (auto &expr : op->GetSelectGroupBy()->GetColumns()) {
+            if (contains_window(expr)) {
+                throw OPTIMIZER_EXCEPTION("Window functions are not allowed in GROUP BY");
+            }
+        }
+        if (contains_window(op->GetSelectGroupBy()->GetHaving())) {
+            throw OPTIMIZER_EXCEPTION("Window functions are not allowed in HAVING");
+        }
+    }
+    if (op->IsSelectDistinct()) {
+        throw NOT_IMPLEMENTED_EXCEPTION("SELECT DISTINCT with window functions is not supported");
+    }
+
+    std::vector<std::vector<common::ManagedPointer<parser::AbstractExpression>>> windows;
+    for (auto &window_expr : window_exprs) {
+        for (const auto &child : window_expr->GetChildren()) {
+            if (contains_window(child)) {
+                throw OPTIMIZER_EXCEPTION("Window function calls cannot be nested");
+            }
+        }
+        auto window = std::find_if(
+            windows.begin(),
+            windows.end(),
+            [&](const std::vector<common::ManagedPointer<parser::AbstractExpression>> &exprs) {
+                return window_expr->HasSameWindow(*exprs[0].CastTo<parser::WindowExpression>());
+            });
+        if (window == windows.end()) {
+            windows.push_back({window_expr.CastTo<parser::AbstractExpression>()});
+            continue;
+        }
+        // The same window function can appear several times in the query, but is only computed once
+        const auto is_same = [&](common::ManagedPointer<parser::AbstractExpression> expr) {
+            return *expr == *window_expr;
+        };
+        if (std::none_of(window->begin(), window->end(), is_same)) {
+            window->emplace_back(window_expr.CastTo<parser::AbstractExpression>());
+        }
+    }
+    return windows;
+}
+
 void QueryToOperatorTransformer::CollectPredicates(common::ManagedPointer<parser::AbstractExpression> expr,
                                                    std::vector<AnnotatedExpression>                  *predicates) {
     // First check if all conjunctive predicates are supported before transforming
@@ -479,6 +479,43 @@ void LogicalAggregateToPhysicalAggregate::Transform(common::ManagedPointer<Abstr
     transformed->emplace_back(std::move(result));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// LogicalWindowToPhysicalWindow
+///////////////////////////////////////////////////////////////////////////////
+LogicalWindowToPhysicalWindow::LogicalWindowToPhysicalWindow() {
+    type_ = RuleType::WINDOW_TO_PHYSICAL;
+    match_pattern_ = new Pattern(OpType::LOGICALWINDOW);
+
+    auto child = new Pattern(OpType::LEAF);
+    match_pattern_->AddChild(child);
+}
+
+auto LogicalWindowToPhysicalWindow::Check(common::ManagedPointer<AbstractOptimizerNode> plan,
+                                          OptimizationContext                          *context) const -> bool {
+    (void) context;
+    (void) plan;
+    return true;
+}
+
+void LogicalWindowToPhysicalWindow::Transform(common::ManagedPointer<AbstractOptimizerNode>        input,
+                                              std::vector<std::unique_ptr<AbstractOptimizerNode>> *transformed,
+                                              [[maybe_unused]] OptimizationContext                 *context) const {
+    const auto window_op = input->Contents()->GetContentsAs<LogicalWindow>();
+    NOISEPAGE_ASSERT(input->GetChildren().size() == 1, "LogicalWindow should have 1 child");
+
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> window_exprs = window_op->GetWindowExprs();
+
+    std::vector<std::unique_ptr<AbstractOptimizerNode>> c;
+    auto                                                child = input->GetChildren()[0]->Copy();
+    c.emplace_back(std::move(child));
+
+    auto result = std::make_unique<OperatorNode>(
+        Window::Make(std::move(window_exprs)).RegisterWithTxnContext(context->GetOptimizerContext()->GetTxn()),
+        std::move(c),
+        context->GetOptimizerContext()->GetTxn());
+    transformed->emplace_back(std::move(result));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// LogicalInnerJoinToPhysicalInnerIndexJoin
 ///////////////////////////////////////////////////////////////////////////////
@@ -672,6 +709,61 @@ void LogicalInnerJoinToPhysicalInnerHashJoin::Transform(
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// LogicalInnerJoinToPhysicalInnerMergeJoin
+///////////////////////////////////////////////////////////////////////////////
+LogicalInnerJoinToPhysicalInnerMergeJoin::LogicalInnerJoinToPhysicalInnerMergeJoin() {
+    type_ = RuleType::INNER_JOIN_TO_MERGE_JOIN;
+
+    auto left_child(new Pattern(OpType::LEAF));
+    auto right_child(new Pattern(OpType::LEAF));
+    match_pattern_ = new Pattern(OpType::LOGICALINNERJOIN);
+    match_pattern_->AddChild(left_child);
+    match_pattern_->AddChild(right_child);
+}
+
+auto LogicalInnerJoinToPhysicalInnerMergeJoin::Check(common::ManagedPointer<AbstractOptimizerNode> plan,
+                                                     OptimizationContext *context) const -> bool {
+    (void) context;
+    (void) plan;
+    return true;
+}
+
+void LogicalInnerJoinToPhysicalInnerMergeJoin::Transform(
+    common::ManagedPointer<AbstractOptimizerNode>        input,
+    std::vector<std::unique_ptr<AbstractOptimizerNode>> *transformed,
+    [[maybe_unused]] OptimizationContext                *context) const {
+    const auto inner_join = input->Contents()->GetContentsAs<LogicalInnerJoin>();
+
+    auto children = input->GetChildren();
+    NOISEPAGE_ASSERT(children.size() == 2, "Inner Join should have two children");
+    auto  left_group_id = children[0]->Contents()->GetContentsAs<LeafOperator>()->GetOriginGroup();
+    auto  right_group_id = children[1]->Contents()->GetContentsAs<LeafOperator>()->GetOriginGroup();
+    auto &left_group_alias = context->GetOptimizerContext()->GetMemo().GetGroupByID(left_group_id)->GetTableAliases();
+    auto &right_group_alias = context->GetOptimizerContext()->GetMemo().GetGroupByID(right_group_id)->GetTableAliases();
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> left_keys;
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> right_keys;
+
+    std::vector<AnnotatedExpression> join_preds = inner_join->GetJoinPredicates();
+    OptimizerUtil::ExtractEquiJoinKeys(join_preds, &left_keys, &right_keys, left_group_alias, right_group_alias);
+
+    // Like hash joins, merge joins are only an alternative to nested loop joins when there are equi-join keys to
+    // sort both children on
+    NOISEPAGE_ASSERT(right_keys.size() == left_keys.size(), "# left/right keys should equal");
+    if (left_keys.empty()) {
+        return;
+    }
+    std::vector<std::unique_ptr<AbstractOptimizerNode>> child;
+    child.emplace_back(children[0]->Copy());
+    child.emplace_back(children[1]->Copy());
+    auto result = std::make_unique<OperatorNode>(
+        InnerMergeJoin::Make(std::move(join_preds), std::move(left_keys), std::move(right_keys))
+            .RegisterWithTxnContext(context->GetOptimizerContext()->GetTxn()),
+        std::move(child),
+        context->GetOptimizerContext()->GetTxn());
+    transformed->emplace_back(std::move(result));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// LogicalSemiJoinToPhysicalSemiLeftHashJoin
 ///////////////////////////////////////////////////////////////////////////////
@@ -156,6 +156,13 @@ void StatsCalculator::Visit([[maybe_unused]] const LogicalAggregateAndGroupBy *o
     context_->GetMemo().GetGroupByID(gexpr_->GetGroupID())->SetNumRows(child_group->GetNumRows());
 }
 
+void StatsCalculator::Visit([[maybe_unused]] const LogicalWindow *op) {
+    // A window function computes one value for each row of the child
+    NOISEPAGE_ASSERT(gexpr_->GetChildrenGroupsSize() == 1, "Window must have 1 child");
+    auto *child_group = context_->GetMemo().GetGroupByID(gexpr_->GetChildGroupId(0));
+    context_->GetMemo().GetGroupByID(gexpr_->GetGroupID())->SetNumRows(child_group->GetNumRows());
+}
+
 void StatsCalculator::Visit(const LogicalLimit *op) {
     // TODO(Joe Koshakow) To be more accurate this should probably take into account the limit offset
     NOISEPAGE_ASSERT(gexpr_->GetChildrenGroupsSize() == 1, "Limit must have 1 child");
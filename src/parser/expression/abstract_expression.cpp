@@ -21,6 +21,7 @@
 #include "parser/expression/subquery_expression.h"
 #include "parser/expression/table_star_expression.h"
 #include "parser/expression/type_cast_expression.h"
+#include "parser/expression/window_expression.h"
 
 namespace noisepage::parser {
 
@@ -170,6 +171,18 @@ auto DeserializeExpression(const nlohmann::json &j) -> JSONDeserializeExprInterm
         break;
     }
 
+    case ExpressionType::WINDOW_ROW_NUMBER:
+    case ExpressionType::WINDOW_RANK:
+    case ExpressionType::WINDOW_DENSE_RANK:
+    case ExpressionType::WINDOW_COUNT:
+    case ExpressionType::WINDOW_SUM:
+    case ExpressionType::WINDOW_MIN:
+    case ExpressionType::WINDOW_MAX:
+    case ExpressionType::WINDOW_AVG: {
+        expr = std::make_unique<WindowExpression>();
+        break;
+    }
+
     case ExpressionType::OPERATOR_CASE_EXPR: {
         expr = std::make_unique<CaseExpression>();
         break;
@@ -0,0 +1,174 @@
+#include "parser/expression/window_expression.h"
+
+#include "binder/sql_node_visitor.h"
+#include "common/hash_util.h"
+#include "common/json.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage::parser {
+
+namespace {
+
+// Lays out the children of a WindowExpression as [args][partition by][order by]
+auto ConcatChildren(std::vector<std::unique_ptr<AbstractExpression>> &&args,
+                    std::vector<std::unique_ptr<AbstractExpression>> &&partition_by,
+                    std::vector<std::unique_ptr<AbstractExpression>> &&order_by)
+    -> std::vector<std::unique_ptr<AbstractExpression>> {
+    std::vector<std::unique_ptr<AbstractExpression>> children = std::move(args);
+    children.insert(children.end(),
+                    std::make_move_iterator(partition_by.begin()),
+                    std::make_move_iterator(partition_by.end()));
+    children.insert(children.end(), std::make_move_iterator(order_by.begin()), std::make_move_iterator(order_by.end()));
+    return children;
+}
+
+} // namespace
+
+WindowExpression::WindowExpression(ExpressionType                                     type,
+                                   std::vector<std::unique_ptr<AbstractExpression>> &&args,
+                                   std::vector<std::unique_ptr<AbstractExpression>> &&partition_by,
+                                   std::vector<std::unique_ptr<AbstractExpression>> &&order_by,
+                                   std::vector<OrderType>                             order_types,
+                                   WindowFrame                                        frame)
+    : AbstractExpression(type, execution::sql::SqlTypeId::Invalid, {})
+    , num_args_(args.size())
+    , num_partition_by_(partition_by.size())
+    , order_types_(std::move(order_types))
+    , frame_(frame) {
+    NOISEPAGE_ASSERT(order_by.size() == order_types_.size(), "Every ORDER BY expression should have a direction.");
+    children_ = ConcatChildren(std::move(args), std::move(partition_by), std::move(order_by));
+}
+
+auto WindowExpression::Copy() const -> std::unique_ptr<AbstractExpression> {
+    std::vector<std::unique_ptr<AbstractExpression>> children;
+    for (const auto &child : GetChildren()) {
+        children.emplace_back(child->Copy());
+    }
+    return CopyWithChildren(std::move(children));
+}
+
+auto WindowExpression::CopyWithChildren(std::vector<std::unique_ptr<AbstractExpression>> &&children) const
+    -> std::unique_ptr<AbstractExpression> {
+    NOISEPAGE_ASSERT(children.size() == GetChildrenSize(), "The copy should have the same layout of children.");
+    const auto partition_begin = static_cast<std::ptrdiff_t>(num_args_);
+    const auto order_begin = static_cast<std::ptrdiff_t>(num_args_ + num_partition_by_);
+    std::vector<std::unique_ptr<AbstractExpression>> args(std::make_move_iterator(children.begin()),
+                                                          std::make_move_iterator(children.begin() + partition_begin));
+    std::vector<std::unique_ptr<AbstractExpression>> partition_by(
+        std::make_move_iterator(children.begin() + partition_begin),
+        std::make_move_iterator(children.begin() + order_begin));
+    std::vector<std::unique_ptr<AbstractExpression>> order_by(std::make_move_iterator(children.begin() + order_begin),
+                                                              std::make_move_iterator(children.end()));
+    auto expr = std::make_unique<WindowExpression>(GetExpressionType(),
+                                                   std::move(args),
+                                                   std::move(partition_by),
+                                                   std::move(order_by),
+                                                   order_types_,
+                                                   frame_);
+    expr->SetMutableStateForCopy(*this);
+    return expr;
+}
+
+auto WindowExpression::IsRankingFunction() const -> bool {
+    switch (GetExpressionType()) {
+    case ExpressionType::WINDOW_ROW_NUMBER:
+    case ExpressionType::WINDOW_RANK:
+    case ExpressionType::WINDOW_DENSE_RANK:
+        return true;
+    default:
+        return false;
+    }
+}
+
+auto WindowExpression::HasSameWindow(const WindowExpression &other) const -> bool {
+    if (num_partition_by_ != other.num_partition_by_ || order_types_ != other.order_types_) {
+        return false;
+    }
+    for (size_t i = 0; i < num_partition_by_; i++) {
+        if (*GetPartitionBy(i) != *other.GetPartitionBy(i)) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < order_types_.size(); i++) {
+        if (*GetOrderBy(i) != *other.GetOrderBy(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void WindowExpression::DeriveReturnValueType() {
+    auto expr_type = this->GetExpressionType();
+    switch (expr_type) {
+    case ExpressionType::WINDOW_ROW_NUMBER:
+    case ExpressionType::WINDOW_RANK:
+    case ExpressionType::WINDOW_DENSE_RANK:
+        this->SetReturnValueType(execution::sql::SqlTypeId::BigInt);
+        break;
+    case ExpressionType::WINDOW_COUNT:
+        this->SetReturnValueType(execution::sql::SqlTypeId::Integer);
+        break;
+    // keep the type of the base
+    case ExpressionType::WINDOW_MAX:
+    case ExpressionType::WINDOW_MIN:
+    case ExpressionType::WINDOW_SUM:
+        NOISEPAGE_ASSERT(num_args_ >= 1, "No column name given.");
+        const_cast<parser::AbstractExpression *>(this->GetArg(0).Get())->DeriveReturnValueType();
+        this->SetReturnValueType(this->GetArg(0)->GetReturnValueType());
+        break;
+    case ExpressionType::WINDOW_AVG:
+        this->SetReturnValueType(execution::sql::SqlTypeId::Double);
+        break;
+    default:
+        throw PARSER_EXCEPTION(fmt::format("Not a valid window function type: {}", static_cast<int>(expr_type)));
+    }
+}
+
+auto WindowExpression::ToJson() const -> nlohmann::json {
+    nlohmann::json j = AbstractExpression::ToJson();
+    j["num_args"] = num_args_;
+    j["num_partition_by"] = num_partition_by_;
+    j["order_types"] = order_types_;
+    j["frame_type"] = frame_.type_;
+    j["frame_start"] = frame_.start_;
+    j["frame_start_offset"] = frame_.start_offset_;
+    j["frame_end"] = frame_.end_;
+    j["frame_end_offset"] = frame_.end_offset_;
+    return j;
+}
+
+auto WindowExpression::FromJson(const nlohmann::json &j) -> std::vector<std::unique_ptr<AbstractExpression>> {
+    std::vector<std::unique_ptr<AbstractExpression>> exprs;
+    auto                                             e1 = AbstractExpression::FromJson(j);
+    exprs.insert(exprs.end(), std::make_move_iterator(e1.begin()), std::make_move_iterator(e1.end()));
+    num_args_ = j.at("num_args").get<size_t>();
+    num_partition_by_ = j.at("num_partition_by").get<size_t>();
+    order_types_ = j.at("order_types").get<std::vector<OrderType>>();
+    frame_.type_ = j.at("frame_type").get<WindowFrameType>();
+    frame_.start_ = j.at("frame_start").get<WindowFrameBoundType>();
+    frame_.start_offset_ = j.at("frame_start_offset").get<int64_t>();
+    frame_.end_ = j.at("frame_end").get<WindowFrameBoundType>();
+    frame_.end_offset_ = j.at("frame_end_offset").get<int64_t>();
+    return exprs;
+}
+
+void WindowExpression::Accept(common::ManagedPointer<binder::SqlNodeVisitor> v) {
+    v->Visit(common::ManagedPointer(this));
+}
+
+auto WindowExpression::Hash() const -> common::hash_t {
+    common::hash_t hash = AbstractExpression::Hash();
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(num_args_));
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(num_partition_by_));
+    hash = common::HashUtil::CombineHashInRange(hash, order_types_.begin(), order_types_.end());
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(frame_.type_));
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(frame_.start_));
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(frame_.start_offset_));
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(frame_.end_));
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(frame_.end_offset_));
+    return hash;
+}
+
+DEFINE_JSON_BODY_DECLARATIONS(WindowExpression);
+
+} // namespace noisepage::parser
@@ -30,6 +30,14 @@ auto ExpressionTypeToShortString(ExpressionType type) -> std::string {
     case ExpressionType::AGGREGATE_AVG:                     return "AVG";
     case ExpressionType::AGGREGATE_TOP_K:                   return "TOP_K";
     case ExpressionType::AGGREGATE_HISTOGRAM:               return "HISTOGRAM";
+    case ExpressionType::WINDOW_ROW_NUMBER:                 return "ROW_NUMBER";
+    case ExpressionType::WINDOW_RANK:                       return "RANK";
+    case ExpressionType::WINDOW_DENSE_RANK:                 return "DENSE_RANK";
+    case ExpressionType::WINDOW_COUNT:                      return "COUNT";
+    case ExpressionType::WINDOW_SUM:                        return "SUM";
+    case ExpressionType::WINDOW_MIN:                        return "MIN";
+    case ExpressionType::WINDOW_MAX:                        return "MAX";
+    case ExpressionType::WINDOW_AVG:                        return "AVG";
     default: return ExpressionTypeToString(type);
         // clang-format on
     }
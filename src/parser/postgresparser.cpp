@@ -27,6 +27,7 @@
 #include "parser/expression/subquery_expression.h"
 #include "parser/expression/table_star_expression.h"
 #include "parser/expression/type_cast_expression.h"
+#include "parser/expression/window_expression.h"
 #include "parser/pg_trigger.h"
 #include "parser/statements.h"
 
@@ -373,6 +374,30 @@ auto PostgresParser::StringToExpressionType(const std::string &parser_str) -> Ex
     if (str == "AGGREGATE_HISTOGRAM") {
         return ExpressionType::AGGREGATE_HISTOGRAM;
     }
+    if (str == "WINDOW_ROW_NUMBER") {
+        return ExpressionType::WINDOW_ROW_NUMBER;
+    }
+    if (str == "WINDOW_RANK") {
+        return ExpressionType::WINDOW_RANK;
+    }
+    if (str == "WINDOW_DENSE_RANK") {
+        return ExpressionType::WINDOW_DENSE_RANK;
+    }
+    if (str == "WINDOW_COUNT") {
+        return ExpressionType::WINDOW_COUNT;
+    }
+    if (str == "WINDOW_SUM") {
+        return ExpressionType::WINDOW_SUM;
+    }
+    if (str == "WINDOW_MIN") {
+        return ExpressionType::WINDOW_MIN;
+    }
+    if (str == "WINDOW_MAX") {
+        return ExpressionType::WINDOW_MAX;
+    }
+    if (str == "WINDOW_AVG") {
+        return ExpressionType::WINDOW_AVG;
+    }
     if (str == "FUNCTION") {
         return ExpressionType::FUNCTION;
     }
@@ -634,6 +659,10 @@ auto PostgresParser::ConstTransform(ParseResult *parse_result, A_Const *root) ->
 // Postgres.FuncCall -> noisepage.AbstractExpression
 auto PostgresParser::FuncCallTransform(ParseResult *parse_result, FuncCall *root)
     -> std::unique_ptr<AbstractExpression> {
+    if (root->over_ != nullptr) {
+        return WindowTransform(parse_result, root);
+    }
+
     // TODO(WAN): Check if we need to change the case of this.
     std::string func_name = reinterpret_cast<value *>(root->funcname_->head->data.ptr_value)->val_.str_;
 
@@ -673,6 +702,119 @@ auto PostgresParser::FuncCallTransform(ParseResult *parse_result, FuncCall *root
     return result;
 }
 
+// Postgres.FuncCall with an OVER clause -> noisepage.WindowExpression
+auto PostgresParser::WindowTransform(ParseResult *parse_result, FuncCall *root) -> std::unique_ptr<AbstractExpression> {
+    std::string func_name = reinterpret_cast<value *>(root->funcname_->tail->data.ptr_value)->val_.str_;
+    const bool  is_ranking_function = func_name == "row_number" || func_name == "rank" || func_name == "dense_rank";
+    if (!is_ranking_function && !IsAggregateFunction(func_name)) {
+        PARSER_LOG_AND_THROW("WindowTransform", "Window function", func_name);
+    }
+    if (root->agg_distinct_ || root->agg_filter_ != nullptr || root->agg_order_ != nullptr) {
+        throw PARSER_EXCEPTION("WindowTransform: DISTINCT, FILTER and ORDER BY in window arguments unsupported");
+    }
+
+    std::vector<std::unique_ptr<AbstractExpression>> args;
+    if (root->agg_star_) {
+        args.emplace_back(new StarExpression());
+    } else if (root->args_ != nullptr) {
+        for (auto cell = root->args_->head; cell != nullptr; cell = cell->next) {
+            args.emplace_back(ExprTransform(parse_result, reinterpret_cast<Node *>(cell->data.ptr_value), nullptr));
+        }
+    }
+    if (args.size() != (is_ranking_function ? 0U : 1U)) {
+        throw PARSER_EXCEPTION("WindowTransform: wrong number of window function arguments");
+    }
+
+    auto window = root->over_;
+    if (window->name_ != nullptr || window->refname_ != nullptr) {
+        throw PARSER_EXCEPTION("WindowTransform: named windows unsupported");
+    }
+
+    std::vector<std::unique_ptr<AbstractExpression>> partition_by;
+    if (window->partition_clause_ != nullptr) {
+        for (auto cell = window->partition_clause_->head; cell != nullptr; cell = cell->next) {
+            partition_by.emplace_back(
+                ExprTransform(parse_result, reinterpret_cast<Node *>(cell->data.ptr_value), nullptr));
+        }
+    }
+
+    std::vector<std::unique_ptr<AbstractExpression>> order_by;
+    std::vector<OrderType>                           order_types;
+    if (window->order_clause_ != nullptr) {
+        for (auto cell = window->order_clause_->head; cell != nullptr; cell = cell->next) {
+            auto sort = reinterpret_cast<SortBy *>(cell->data.ptr_value);
+            switch (sort->sortby_dir_) {
+            case SORTBY_DESC: {
+                order_types.emplace_back(kOrderDesc);
+                break;
+            }
+            case SORTBY_ASC: // fall through
+            case SORTBY_DEFAULT: {
+                order_types.emplace_back(kOrderAsc);
+                break;
+            }
+            default: {
+                PARSER_LOG_AND_THROW("WindowTransform", "Sortby type", sort->sortby_dir_);
+            }
+            }
+            order_by.emplace_back(ExprTransform(parse_result, sort->node_, nullptr));
+        }
+    }
+
+    // The number of rows before or after the current row, which Postgres only allows in ROWS mode
+    auto offset_transform = [parse_result](Node *node) -> int64_t {
+        auto offset = ExprTransform(parse_result, node, nullptr);
+        if (offset->GetExpressionType() != ExpressionType::VALUE_CONSTANT
+            || offset->GetReturnValueType() != execution::sql::SqlTypeId::Integer) {
+            throw PARSER_EXCEPTION("WindowTransform: frame offsets must be integer constants");
+        }
+        const auto value = common::ManagedPointer(offset).CastTo<ConstantValueExpression>()->GetInteger();
+        if (value.is_null_ || value.val_ < 0) {
+            throw PARSER_EXCEPTION("WindowTransform: frame offsets must not be null or negative");
+        }
+        return value.val_;
+    };
+
+    // Without a frame clause, frame_options_ holds the default frame: RANGE UNBOUNDED PRECEDING to CURRENT ROW
+    const int   options = window->frame_options_;
+    WindowFrame frame;
+    frame.type_ = (options & FRAMEOPTION_ROWS) != 0 ? WindowFrameType::ROWS : WindowFrameType::RANGE;
+    if ((options & FRAMEOPTION_START_UNBOUNDED_PRECEDING) != 0) {
+        frame.start_ = WindowFrameBoundType::UNBOUNDED_PRECEDING;
+    } else if ((options & FRAMEOPTION_START_CURRENT_ROW) != 0) {
+        frame.start_ = WindowFrameBoundType::CURRENT_ROW;
+    } else if ((options & FRAMEOPTION_START_VALUE_PRECEDING) != 0) {
+        frame.start_ = WindowFrameBoundType::PRECEDING;
+        frame.start_offset_ = offset_transform(window->start_offset_);
+    } else if ((options & FRAMEOPTION_START_VALUE_FOLLOWING) != 0) {
+        frame.start_ = WindowFrameBoundType::FOLLOWING;
+        frame.start_offset_ = offset_transform(window->start_offset_);
+    } else {
+        PARSER_LOG_AND_THROW("WindowTransform", "Frame start", options);
+    }
+    if ((options & FRAMEOPTION_END_UNBOUNDED_FOLLOWING) != 0) {
+        frame.end_ = WindowFrameBoundType::UNBOUNDED_FOLLOWING;
+    } else if ((options & FRAMEOPTION_END_CURRENT_ROW) != 0) {
+        frame.end_ = WindowFrameBoundType::CURRENT_ROW;
+    } else if ((options & FRAMEOPTION_END_VALUE_PRECEDING) != 0) {
+        frame.end_ = WindowFrameBoundType::PRECEDING;
+        frame.end_offset_ = offset_transform(window->end_offset_);
+    } else if ((options & FRAMEOPTION_END_VALUE_FOLLOWING) != 0) {
+        frame.end_ = WindowFrameBoundType::FOLLOWING;
+        frame.end_offset_ = offset_transform(window->end_offset_);
+    } else {
+        PARSER_LOG_AND_THROW("WindowTransform", "Frame end", options);
+    }
+
+    std::transform(func_name.begin(), func_name.end(), func_name.begin(), ::toupper);
+    return std::make_unique<WindowExpression>(StringToExpressionType("WINDOW_" + func_name),
+                                              std::move(args),
+                                              std::move(partition_by),
+                                              std::move(order_by),
+                                              std::move(order_types),
+                                              frame);
+}
+
 // Postgres.NullTest -> noisepage.OperatorExpression
 auto PostgresParser::NullTestTransform(ParseResult *parse_result, NullTest *root)
     -> std::unique_ptr<AbstractExpression> {
@@ -1199,6 +1341,8 @@ auto PostgresParser::CopyTransform(ParseResult *parse_result, CopyStmt *root) ->
                     format = ExternalFileFormat::CSV;
                 } else if (strcmp(format_cstr, "binary") == 0) {
                     format = ExternalFileFormat::BINARY;
+                } else if (strcmp(format_cstr, "arrow") == 0) {
+                    format = ExternalFileFormat::ARROW;
                 }
             }
 
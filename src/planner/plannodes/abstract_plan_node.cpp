@@ -28,6 +28,7 @@
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
 #include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/output_schema.h"
@@ -37,6 +38,7 @@
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "planner/plannodes/set_op_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
+#include "planner/plannodes/window_plan_node.h"
 
 namespace noisepage::planner {
 
@@ -254,6 +256,11 @@ auto DeserializePlanNode(const nlohmann::json &json) -> JSONDeserializeNodeInter
         break;
     }
 
+    case PlanNodeType::MERGEJOIN: {
+        plan_node = std::make_unique<MergeJoinPlanNode>();
+        break;
+    }
+
     case PlanNodeType::NESTLOOP: {
         plan_node = std::make_unique<NestedLoopJoinPlanNode>();
         break;
@@ -269,6 +276,11 @@ auto DeserializePlanNode(const nlohmann::json &json) -> JSONDeserializeNodeInter
         break;
     }
 
+    case PlanNodeType::WINDOW: {
+        plan_node = std::make_unique<WindowPlanNode>();
+        break;
+    }
+
     case PlanNodeType::RESULT: {
         plan_node = std::make_unique<ResultPlanNode>();
         break;
@@ -20,6 +20,8 @@ auto PlanNodeTypeToString(PlanNodeType type) -> std::string {
         return "HashJoin";
     case PlanNodeType::INDEXNLJOIN:
         return "IndexNestedLoopJoin";
+    case PlanNodeType::MERGEJOIN:
+        return "MergeJoin";
     case PlanNodeType::UPDATE:
         return "Update";
     case PlanNodeType::INSERT:
@@ -68,6 +70,8 @@ auto PlanNodeTypeToString(PlanNodeType type) -> std::string {
         return "Hash";
     case PlanNodeType::SETOP:
         return "SetOperation";
+    case PlanNodeType::WINDOW:
+        return "Window";
     case PlanNodeType::EXPORT_EXTERNAL_FILE:
         return "ExportExternalFile";
     case PlanNodeType::RESULT:
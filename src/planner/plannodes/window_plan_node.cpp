@@ -0,0 +1,82 @@
+#include "planner/plannodes/window_plan_node.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "common/hash_util.h"
+#include "common/json.h"
+#include "planner/plannodes/output_schema.h"
+
+namespace noisepage::planner {
+
+auto WindowPlanNode::Builder::Build() -> std::unique_ptr<WindowPlanNode> {
+    return std::unique_ptr<WindowPlanNode>(
+        new WindowPlanNode(std::move(children_), std::move(output_schema_), std::move(window_terms_), plan_node_id_));
+}
+
+WindowPlanNode::WindowPlanNode(std::vector<std::unique_ptr<AbstractPlanNode>> &&children,
+                               std::unique_ptr<OutputSchema>                    output_schema,
+                               std::vector<WindowTerm>                          window_terms,
+                               plan_node_id_t                                   plan_node_id)
+    : AbstractPlanNode(std::move(children), std::move(output_schema), plan_node_id)
+    , window_terms_(std::move(window_terms)) {}
+
+auto WindowPlanNode::Hash() const -> common::hash_t {
+    common::hash_t hash = AbstractPlanNode::Hash();
+    for (const auto &window_term : window_terms_) {
+        hash = common::HashUtil::CombineHashes(hash, window_term->Hash());
+    }
+    return hash;
+}
+
+auto WindowPlanNode::operator==(const AbstractPlanNode &rhs) const -> bool {
+    if (!AbstractPlanNode::operator==(rhs)) {
+        return false;
+    }
+
+    auto &other = static_cast<const WindowPlanNode &>(rhs);
+    if (window_terms_.size() != other.window_terms_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < window_terms_.size(); i++) {
+        if (*window_terms_[i] != *other.window_terms_[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto WindowPlanNode::ToJson() const -> nlohmann::json {
+    nlohmann::json j = AbstractPlanNode::ToJson();
+
+    std::vector<nlohmann::json> window_terms;
+    window_terms.reserve(window_terms_.size());
+    for (const auto &window_term : window_terms_) {
+        window_terms.emplace_back(window_term->ToJson());
+    }
+    j["window_terms"] = window_terms;
+    return j;
+}
+
+auto WindowPlanNode::FromJson(const nlohmann::json &j) -> std::vector<std::unique_ptr<parser::AbstractExpression>> {
+    std::vector<std::unique_ptr<parser::AbstractExpression>> exprs;
+    auto                                                     e1 = AbstractPlanNode::FromJson(j);
+    exprs.insert(exprs.end(), std::make_move_iterator(e1.begin()), std::make_move_iterator(e1.end()));
+
+    // Deserialize window terms
+    auto window_term_jsons = j.at("window_terms").get<std::vector<nlohmann::json>>();
+    for (const auto &json : window_term_jsons) {
+        auto deserialized = parser::DeserializeExpression(json);
+        window_terms_.emplace_back(common::ManagedPointer(deserialized.result_).CastTo<parser::WindowExpression>());
+        exprs.emplace_back(std::move(deserialized.result_));
+        exprs.insert(exprs.end(),
+                     std::make_move_iterator(deserialized.non_owned_exprs_.begin()),
+                     std::make_move_iterator(deserialized.non_owned_exprs_.end()));
+    }
+    return exprs;
+}
+
+DEFINE_JSON_BODY_DECLARATIONS(WindowPlanNode);
+
+} // namespace noisepage::planner
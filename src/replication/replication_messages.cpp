@@ -14,6 +14,7 @@ const char *NotifyOATMsg::key_batch_id = "oat_batch";
 const char *NotifyOATMsg::key_oldest_active_txn = "oat_ts";
 const char *RecordsBatchMsg::key_batch_id = "batch_id";
 const char *RecordsBatchMsg::key_contents = "contents";
+const char *RecordsBatchMsg::key_framed = "framed";
 const char *TxnAppliedMsg::key_applied_txn_id = "applied_txn_id";
 
 // MessageWrapper
@@ -28,6 +29,7 @@ template <typename T>
 void MessageWrapper::Put(const char *key, T value) {
     (*underlying_message_)[key] = value;
 }
+template void MessageWrapper::Put<bool>(const char *key, bool value);
 template void MessageWrapper::Put<std::string>(const char *key, std::string value);
 template void MessageWrapper::Put<std::vector<uint8_t>>(const char *key, std::vector<uint8_t> value);
 template void MessageWrapper::Put<MessageWrapper>(const char *key, MessageWrapper value);
@@ -39,6 +41,7 @@ template <typename T>
 auto MessageWrapper::Get(const char *key) const -> T {
     return underlying_message_->at(key).get<T>();
 }
+template bool                     MessageWrapper::Get<bool>(const char *key) const;
 template std::string              MessageWrapper::Get<std::string>(const char *key) const;
 template std::vector<uint8_t>     MessageWrapper::Get<std::vector<uint8_t>>(const char *key) const;
 template MessageWrapper           MessageWrapper::Get<MessageWrapper>(const char *key) const;
@@ -125,20 +128,24 @@ auto RecordsBatchMsg::ToMessageWrapper() const -> MessageWrapper {
     MessageWrapper message = BaseReplicationMessage::ToMessageWrapper();
     message.Put(key_batch_id, batch_id_);
     message.Put(key_contents, contents_);
+    message.Put(key_framed, framed_);
     return message;
 }
 
 RecordsBatchMsg::RecordsBatchMsg(const MessageWrapper &message)
     : BaseReplicationMessage(message)
     , batch_id_(message.Get<record_batch_id_t>(key_batch_id))
-    , contents_(message.Get<std::string>(key_contents)) {}
+    , contents_(message.Get<std::string>(key_contents))
+    , framed_(message.Get<bool>(key_framed)) {}
 
 RecordsBatchMsg::RecordsBatchMsg(ReplicationMessageMetadata  metadata,
                                  record_batch_id_t           batch_id,
                                  storage::BufferedLogWriter *buffer)
     : BaseReplicationMessage(ReplicationMessageType::RECORDS_BATCH, metadata)
     , batch_id_(batch_id)
-    , contents_(std::string(buffer->buffer_, buffer->buffer_size_)) {}
+    , contents_(buffer->frame_size_ > 0 ? std::string(buffer->frame_, buffer->frame_size_)
+                                        : std::string(buffer->buffer_, buffer->buffer_size_))
+    , framed_(buffer->frame_size_ > 0) {}
 
 // TxnAppliedMsg
 
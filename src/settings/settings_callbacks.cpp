@@ -4,6 +4,7 @@
 
 #include "loggers/loggers_util.h"
 #include "main/db_main.h"
+#include "optimizer/cost_model/cost_model_util.h"
 
 namespace noisepage::settings {
 
@@ -244,6 +245,20 @@ void Callbacks::CompiledQueryExecution(void *const
     action_context->SetState(common::ActionState::SUCCESS);
 }
 
+void Callbacks::OptimizerCostModel(void *const                                   old_value,
+                                   void *const                                   new_value,
+                                   DBMain *const                                 db_main,
+                                   common::ManagedPointer<common::ActionContext> action_context) {
+    action_context->SetState(common::ActionState::IN_PROGRESS);
+    auto cost_model = optimizer::CostModelUtil::FromCostModelString(*static_cast<std::string_view *>(new_value));
+    if (cost_model == std::nullopt) {
+        action_context->SetState(common::ActionState::FAILURE);
+        return;
+    }
+    db_main->GetTaskflow()->SetCostModelType(*cost_model);
+    action_context->SetState(common::ActionState::SUCCESS);
+}
+
 void Callbacks::ClearQueryCache(void                                         *old_value,
                                 void                                         *new_value,
                                 DBMain                                       *db_main,
@@ -253,6 +268,16 @@ void Callbacks::ClearQueryCache(void                                         *ol
     action_context->SetState(common::ActionState::SUCCESS);
 }
 
+void Callbacks::SharedStatementCacheSize(void                                         *old_value,
+                                         void                                         *new_value,
+                                         DBMain                                       *db_main,
+                                         common::ManagedPointer<common::ActionContext> action_context) {
+    action_context->SetState(common::ActionState::IN_PROGRESS);
+    int64_t new_size = *static_cast<int64_t *>(new_value);
+    db_main->GetTaskflow()->GetSharedStatementCache()->SetSizeLimit(static_cast<uint64_t>(new_size));
+    action_context->SetState(common::ActionState::SUCCESS);
+}
+
 void Callbacks::ForecastSampleLimit(void                                         *old_value,
                                     void                                         *new_value,
                                     DBMain                                       *db_main,
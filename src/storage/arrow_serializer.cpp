@@ -1,17 +1,168 @@
 #include "storage/arrow_serializer.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <climits>
 #include <cstring>
 #include <fstream>
 #include <list>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "common/allocator.h"
+#include "execution/sql/runtime_types.h"
+#include "storage/projected_row.h"
+
 namespace noisepage::storage {
 
 constexpr int32_t                  FLATBUF_CONTINUZATION = -1;
 constexpr uint8_t                  ARROW_ALIGNMENT = 8;
 constexpr char                     ALIGNMENT[8] = {0};
 constexpr flatbuf::MetadataVersion METADATA_VERSION = flatbuf::MetadataVersion_V4;
+constexpr int32_t                  END_OF_STREAM[2] = {FLATBUF_CONTINUZATION, 0};
+
+namespace {
+
+    // Dates and timestamps are stored as days and microseconds since the julian epoch, while Arrow counts them from the
+    // Unix epoch
+    int64_t UnixEpochDays() {
+        static const int64_t epoch = execution::sql::Date::FromYMD(1970, 1, 1).ToNative();
+        return epoch;
+    }
+
+    int64_t UnixEpochMicroseconds() {
+        static const auto epoch
+            = static_cast<int64_t>(execution::sql::Timestamp::FromYMDHMS(1970, 1, 1, 0, 0, 0).ToNative());
+        return epoch;
+    }
+
+    iovec Buffer(const void *const src, const size_t len) {
+        return {const_cast<void *>(src), len}; // NOLINT
+    }
+
+    // Body of a RecordBatch message, gathered from buffers that stay where they are
+    struct MessageBody {
+        // Adds a buffer, followed by the padding to arrow alignment
+        void Add(const void *const src, const size_t len) {
+            const size_t padded_len = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, len);
+            iovecs_.push_back(Buffer(src, len));
+            if (padded_len != len) {
+                iovecs_.push_back(Buffer(ALIGNMENT, padded_len - len));
+            }
+            buffers_.emplace_back(length_, padded_len);
+            length_ += padded_len;
+        }
+
+        std::vector<iovec>           iovecs_;
+        std::vector<flatbuf::Buffer> buffers_;
+        size_t                       length_ = 0;
+    };
+
+    // A column of a RecordBatch that is built up value by value rather than sent straight from a block
+    class MaterializedColumn {
+    public:
+        MaterializedColumn(const execution::sql::SqlTypeId type, const bool varlen, const uint16_t attr_size)
+            : type_(type)
+            , varlen_(varlen)
+            , attr_size_(attr_size) {}
+
+        // Appends a value as it is stored in a block, or a null value if value is nullptr
+        void Append(const byte *const value) {
+            if (num_values_ % 8 == 0) {
+                validity_.push_back(0);
+            }
+            if (value == nullptr) {
+                null_count_++;
+            } else {
+                validity_.back() |= static_cast<uint8_t>(1U << (num_values_ % 8));
+            }
+            num_values_++;
+
+            if (varlen_) {
+                if (value != nullptr) {
+                    const auto *entry = reinterpret_cast<const VarlenEntry *>(value);
+                    values_.insert(values_.end(), entry->Content(), entry->Content() + entry->Size());
+                }
+                offsets_.push_back(static_cast<int64_t>(values_.size()));
+            } else if (type_ == execution::sql::SqlTypeId::Date) {
+                int32_t days = 0;
+                if (value != nullptr) {
+                    std::memcpy(&days, value, sizeof(days));
+                    days = static_cast<int32_t>(days - UnixEpochDays());
+                }
+                AppendBytes(&days, sizeof(days));
+            } else if (type_ == execution::sql::SqlTypeId::Timestamp) {
+                uint64_t microseconds = 0;
+                if (value != nullptr) {
+                    std::memcpy(&microseconds, value, sizeof(microseconds));
+                    microseconds -= static_cast<uint64_t>(UnixEpochMicroseconds());
+                }
+                AppendBytes(&microseconds, sizeof(microseconds));
+            } else if (value != nullptr) {
+                AppendBytes(value, attr_size_);
+            } else {
+                values_.resize(values_.size() + attr_size_);
+            }
+        }
+
+        // Adds the buffers of the column to the message body
+        void AddTo(MessageBody *body) const {
+            body->Add(validity_.data(), validity_.size());
+            if (varlen_) {
+                body->Add(offsets_.data(), offsets_.size() * sizeof(int64_t));
+            }
+            body->Add(values_.data(), values_.size());
+        }
+
+        uint32_t NumValues() const {
+            return num_values_;
+        }
+
+        uint32_t NullCount() const {
+            return null_count_;
+        }
+
+    private:
+        void AppendBytes(const void *const src, const size_t len) {
+            const auto *bytes = reinterpret_cast<const byte *>(src);
+            values_.insert(values_.end(), bytes, bytes + len);
+        }
+
+        const execution::sql::SqlTypeId type_;
+        const bool                      varlen_;
+        const uint16_t                  attr_size_;
+        std::vector<uint8_t>            validity_;
+        std::vector<byte>               values_;
+        std::vector<int64_t>            offsets_{0};
+        uint32_t                        num_values_ = 0, null_count_ = 0;
+    };
+
+} // namespace
+
+void FdArrowStreamWriter::Write(const std::vector<iovec> &buffers) {
+    std::vector<iovec> remaining(buffers);
+    size_t             first = 0;
+    while (first < remaining.size()) {
+        const int     count = static_cast<int>(std::min<size_t>(remaining.size() - first, IOV_MAX));
+        const ssize_t written = ::writev(fd_, &remaining[first], count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("failed to write arrow stream: " + std::string(std::strerror(errno)));
+        }
+        // Skip the buffers that were written completely and resume in the middle of the one that was not
+        auto left = static_cast<size_t>(written);
+        while (first < remaining.size() && left >= remaining[first].iov_len) {
+            left -= remaining[first++].iov_len;
+        }
+        if (left != 0) {
+            remaining[first].iov_base = reinterpret_cast<byte *>(remaining[first].iov_base) + left;
+            remaining[first].iov_len -= left;
+        }
+    }
+}
 
 void ArrowSerializer::WriteDataBlock(std::ofstream &outfile, const char *src, size_t len) {
     len = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, len);
@@ -29,17 +180,24 @@ void ArrowSerializer::AssembleMetadataBuffer(std::ofstream                  &out
                                              flatbuffers::Offset<void>       header,
                                              int64_t                         body_len,
                                              flatbuffers::FlatBufferBuilder *flatbuf_builder) {
+    const std::string metadata = EncodeMetadataBuffer(header_type, header, body_len, flatbuf_builder);
+    outfile.write(metadata.data(), metadata.size());
+    outfile.flush();
+}
+
+auto ArrowSerializer::EncodeMetadataBuffer(flatbuf::MessageHeader          header_type,
+                                           flatbuffers::Offset<void>       header,
+                                           int64_t                         body_len,
+                                           flatbuffers::FlatBufferBuilder *flatbuf_builder) -> std::string {
     auto message = flatbuf::CreateMessage(*flatbuf_builder, METADATA_VERSION, header_type, header, body_len);
     flatbuf_builder->Finish(message);
-    int32_t flatbuf_size = flatbuf_builder->GetSize();
-    auto    padded_flatbuf_size = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, flatbuf_size);
-    outfile.write(reinterpret_cast<const char *>(&FLATBUF_CONTINUZATION), sizeof(int32_t));
-    outfile.write(reinterpret_cast<const char *>(&padded_flatbuf_size), sizeof(int32_t));
-    outfile.write(reinterpret_cast<const char *>(flatbuf_builder->GetBufferPointer()), flatbuf_size);
-    if (padded_flatbuf_size != static_cast<uint32_t>(flatbuf_size)) {
-        outfile.write(ALIGNMENT, padded_flatbuf_size - flatbuf_size);
-    }
-    outfile.flush();
+    int32_t     flatbuf_size = flatbuf_builder->GetSize();
+    uint32_t    padded_flatbuf_size = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, flatbuf_size);
+    std::string metadata(2 * sizeof(int32_t) + padded_flatbuf_size, '\0');
+    std::memcpy(&metadata[0], &FLATBUF_CONTINUZATION, sizeof(int32_t));
+    std::memcpy(&metadata[sizeof(int32_t)], &padded_flatbuf_size, sizeof(int32_t));
+    std::memcpy(&metadata[2 * sizeof(int32_t)], flatbuf_builder->GetBufferPointer(), flatbuf_size);
+    return metadata;
 }
 
 void ArrowSerializer::WriteSchemaMessage(std::ofstream                          &outfile,
@@ -305,4 +463,211 @@ void ArrowSerializer::ExportTable(const std::string &file_name, std::vector<exec
     }
     outfile.close();
 }
+
+auto ArrowSerializer::ExportStream(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                   const std::vector<col_id_t>                                  &col_ids,
+                                   const std::vector<execution::sql::SqlTypeId>                 &col_types,
+                                   const std::vector<std::string>                               &col_names,
+                                   ArrowStreamWriter *const                                      writer) -> uint64_t {
+    NOISEPAGE_ASSERT(col_ids.size() == col_types.size() && col_ids.size() == col_names.size(),
+                     "every exported column needs a type and a name");
+    flatbuffers::FlatBufferBuilder flatbuf_builder;
+    const std::string              schema = EncodeStreamSchema(col_types, col_names, &flatbuf_builder);
+    writer->Write({Buffer(schema.data(), schema.size())});
+
+    uint64_t num_tuples = 0;
+    for (RawBlock *block : data_table_.GetBlocks()) {
+        num_tuples += ExportStreamBlock(txn, block, col_ids, col_types, &flatbuf_builder, writer);
+    }
+    writer->Write({Buffer(END_OF_STREAM, sizeof(END_OF_STREAM))});
+    return num_tuples;
+}
+
+auto ArrowSerializer::EncodeStreamSchema(const std::vector<execution::sql::SqlTypeId> &col_types,
+                                         const std::vector<std::string>               &col_names,
+                                         flatbuffers::FlatBufferBuilder *flatbuf_builder) -> std::string {
+    std::vector<flatbuffers::Offset<flatbuf::Field>> fields;
+    for (size_t i = 0; i < col_types.size(); i++) {
+        auto                      name = flatbuf_builder->CreateString(col_names[i]);
+        flatbuf::Type             type;
+        flatbuffers::Offset<void> type_offset;
+        switch (col_types[i]) {
+        case execution::sql::SqlTypeId::Boolean:
+            type = flatbuf::Type_Int;
+            type_offset = flatbuf::CreateInt(*flatbuf_builder, 8, false).Union();
+            break;
+        case execution::sql::SqlTypeId::TinyInt:
+            type = flatbuf::Type_Int;
+            type_offset = flatbuf::CreateInt(*flatbuf_builder, 8, true).Union();
+            break;
+        case execution::sql::SqlTypeId::SmallInt:
+            type = flatbuf::Type_Int;
+            type_offset = flatbuf::CreateInt(*flatbuf_builder, 16, true).Union();
+            break;
+        case execution::sql::SqlTypeId::Integer:
+            type = flatbuf::Type_Int;
+            type_offset = flatbuf::CreateInt(*flatbuf_builder, 32, true).Union();
+            break;
+        case execution::sql::SqlTypeId::BigInt:
+            type = flatbuf::Type_Int;
+            type_offset = flatbuf::CreateInt(*flatbuf_builder, 64, true).Union();
+            break;
+        case execution::sql::SqlTypeId::Double:
+            type = flatbuf::Type_FloatingPoint;
+            type_offset = flatbuf::CreateFloatingPoint(*flatbuf_builder, flatbuf::Precision_DOUBLE).Union();
+            break;
+        case execution::sql::SqlTypeId::Date:
+            type = flatbuf::Type_Date;
+            type_offset = flatbuf::CreateDate(*flatbuf_builder, flatbuf::DateUnit_DAY).Union();
+            break;
+        case execution::sql::SqlTypeId::Timestamp:
+            type = flatbuf::Type_Timestamp;
+            type_offset = flatbuf::CreateTimestamp(*flatbuf_builder, flatbuf::TimeUnit_MICROSECOND).Union();
+            break;
+        case execution::sql::SqlTypeId::Varchar:
+            type = flatbuf::Type_LargeUtf8;
+            type_offset = flatbuf::CreateLargeUtf8(*flatbuf_builder).Union();
+            break;
+        case execution::sql::SqlTypeId::Varbinary:
+            type = flatbuf::Type_LargeBinary;
+            type_offset = flatbuf::CreateLargeBinary(*flatbuf_builder).Union();
+            break;
+        default:
+            throw std::runtime_error("unexpected column type");
+        }
+        std::vector<flatbuffers::Offset<flatbuf::Field>> fake_children;
+        fields.emplace_back(flatbuf::CreateField(*flatbuf_builder,
+                                                 name,
+                                                 true,
+                                                 type,
+                                                 type_offset,
+                                                 0,
+                                                 flatbuf_builder->CreateVector(fake_children)));
+    }
+    auto schema
+        = flatbuf::CreateSchema(*flatbuf_builder, flatbuf::Endianness_Little, flatbuf_builder->CreateVector(fields));
+    std::string message = EncodeMetadataBuffer(flatbuf::MessageHeader_Schema, schema.Union(), 0, flatbuf_builder);
+    flatbuf_builder->Clear();
+    return message;
+}
+
+auto ArrowSerializer::ExportStreamBlock(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                        RawBlock *const                                               block,
+                                        const std::vector<col_id_t>                                  &col_ids,
+                                        const std::vector<execution::sql::SqlTypeId>                 &col_types,
+                                        flatbuffers::FlatBufferBuilder                               *flatbuf_builder,
+                                        ArrowStreamWriter *const                                      writer)
+    -> uint32_t {
+    const TupleAccessStrategy &accessor = data_table_.accessor_;
+    const BlockLayout         &layout = accessor.GetBlockLayout();
+    ArrowBlockMetadata        &metadata = accessor.GetArrowBlockMetadata(block);
+
+    // A frozen block holds no versions, so if all of its records are present, they are exactly what the transaction
+    // sees and its buffers can be sent as they are
+    bool in_place = block->controller_.TryAcquireInPlaceRead();
+    if (in_place) {
+        for (uint32_t offset = 0; offset < metadata.NumRecords() && in_place; offset++) {
+            in_place = data_table_.Visible(TupleSlot(block, offset), accessor);
+        }
+        if (!in_place) {
+            block->controller_.ReleaseInPlaceRead();
+        }
+    }
+
+    std::vector<MaterializedColumn> materialized;
+    materialized.reserve(col_ids.size());
+    for (size_t i = 0; i < col_ids.size(); i++) {
+        materialized.emplace_back(col_types[i], layout.IsVarlen(col_ids[i]), layout.AttrSize(col_ids[i]));
+    }
+
+    uint32_t num_tuples = 0;
+    // Whether each column is sent from the block rather than materialized
+    std::vector<bool> zero_copy(col_ids.size(), false);
+    if (in_place) {
+        num_tuples = metadata.NumRecords();
+        for (size_t i = 0; i < col_ids.size(); i++) {
+            const col_id_t       col_id = col_ids[i];
+            const ArrowColumnType col_type = metadata.GetColumnInfo(layout, col_id).Type();
+            zero_copy[i] = col_types[i] != execution::sql::SqlTypeId::Date
+                           && col_types[i] != execution::sql::SqlTypeId::Timestamp
+                           && (!layout.IsVarlen(col_id) || col_type == ArrowColumnType::GATHERED_VARLEN);
+            if (zero_copy[i]) {
+                continue;
+            }
+            const common::RawConcurrentBitmap *bitmap = accessor.ColumnNullBitmap(block, col_id);
+            const byte                        *values = accessor.ColumnStart(block, col_id);
+            const uint16_t                     attr_size = layout.AttrSize(col_id);
+            for (uint32_t offset = 0; offset < num_tuples; offset++) {
+                materialized[i].Append(bitmap->Test(offset) ? values + offset * attr_size : nullptr);
+            }
+        }
+    } else {
+        const ProjectedRowInitializer initializer = ProjectedRowInitializer::Create(layout, col_ids);
+        byte *const                   buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+        ProjectedRow *const           row = initializer.InitializeRow(buffer);
+        // The projected row orders its columns by size, so find where each exported column ended up
+        std::vector<uint16_t> projection(col_ids.size());
+        for (uint16_t j = 0; j < row->NumColumns(); j++) {
+            for (size_t i = 0; i < col_ids.size(); i++) {
+                if (row->ColumnIds()[j] == col_ids[i]) {
+                    projection[i] = j;
+                }
+            }
+        }
+        const uint32_t insert_head = block->GetInsertHead();
+        for (uint32_t offset = 0; offset < insert_head; offset++) {
+            if (!data_table_.Select(txn, TupleSlot(block, offset), row)) {
+                continue;
+            }
+            num_tuples++;
+            for (size_t i = 0; i < col_ids.size(); i++) {
+                materialized[i].Append(row->AccessWithNullCheck(projection[i]));
+            }
+        }
+        delete[] buffer;
+    }
+
+    if (num_tuples == 0) {
+        if (in_place) {
+            block->controller_.ReleaseInPlaceRead();
+        }
+        return 0;
+    }
+
+    std::vector<flatbuf::FieldNode> field_nodes;
+    MessageBody                     body;
+    for (size_t i = 0; i < col_ids.size(); i++) {
+        const col_id_t col_id = col_ids[i];
+        if (!zero_copy[i]) {
+            field_nodes.emplace_back(num_tuples, materialized[i].NullCount());
+            materialized[i].AddTo(&body);
+            continue;
+        }
+        field_nodes.emplace_back(num_tuples, metadata.NullCount(col_id));
+        body.Add(accessor.ColumnNullBitmap(block, col_id), (num_tuples + 7) / 8);
+        if (layout.IsVarlen(col_id)) {
+            const ArrowVarlenColumn &varlen_col = metadata.GetColumnInfo(layout, col_id).VarlenColumn();
+            body.Add(varlen_col.Offsets(), varlen_col.OffsetsLength() * sizeof(uint64_t));
+            body.Add(varlen_col.Values(), varlen_col.ValuesLength());
+        } else {
+            body.Add(accessor.ColumnStart(block, col_id), num_tuples * layout.AttrSize(col_id));
+        }
+    }
+
+    auto record_batch = flatbuf::CreateRecordBatch(*flatbuf_builder,
+                                                   num_tuples,
+                                                   flatbuf_builder->CreateVectorOfStructs(field_nodes),
+                                                   flatbuf_builder->CreateVectorOfStructs(body.buffers_));
+    const std::string metadata_buffer
+        = EncodeMetadataBuffer(flatbuf::MessageHeader_RecordBatch, record_batch.Union(), body.length_, flatbuf_builder);
+    flatbuf_builder->Clear();
+    body.iovecs_.insert(body.iovecs_.begin(), Buffer(metadata_buffer.data(), metadata_buffer.size()));
+    writer->Write(body.iovecs_);
+
+    if (in_place) {
+        block->controller_.ReleaseInPlaceRead();
+    }
+    return num_tuples;
+}
+
 } // namespace noisepage::storage
@@ -1,6 +1,7 @@
 #include "storage/block_compactor.h"
 
 #include <algorithm>
+#include <limits>
 #include <queue>
 #include <unordered_map>
 #include <utility>
@@ -275,6 +276,16 @@ void BlockCompactor::GatherVarlens(std::vector<const byte *> *loose_ptrs, RawBlo
                     metadata.NullCount(col_id)++;
                 }
             }
+            SummarizeColumn(&metadata.GetZoneMap(layout, col_id),
+                            accessor.ColumnStart(block, col_id),
+                            column_bitmap,
+                            layout.AttrSize(col_id),
+                            metadata.NumRecords());
+            CompressColumn(&metadata.GetColumnInfo(layout, col_id),
+                           accessor.ColumnStart(block, col_id),
+                           column_bitmap,
+                           static_cast<uint8_t>(layout.AttrSize(col_id)),
+                           metadata.NumRecords());
             continue;
         }
 
@@ -287,6 +298,12 @@ void BlockCompactor::GatherVarlens(std::vector<const byte *> *loose_ptrs, RawBlo
             break;
         case ArrowColumnType::DICTIONARY_COMPRESSED:
             BuildDictionary(loose_ptrs, &metadata, col_id, column_bitmap, &col_info, values);
+            // The indices are as wide as the values they replace, so pack them down to what the dictionary needs
+            CompressColumn(&col_info,
+                           reinterpret_cast<byte *>(col_info.Indices()),
+                           column_bitmap,
+                           sizeof(uint64_t),
+                           metadata.NumRecords());
             break;
         default:
             throw std::runtime_error("unexpected control flow");
@@ -414,4 +431,41 @@ void BlockCompactor::BuildDictionary(std::vector<const byte *>   *loose_ptrs,
     *col = std::move(new_col_info);
 }
 
+void BlockCompactor::SummarizeColumn(ColumnZoneMap                     *zone_map,
+                                     const byte                        *values,
+                                     const common::RawConcurrentBitmap *column_bitmap,
+                                     const uint16_t                     attr_size,
+                                     const uint32_t                     num_records) {
+    if (!ColumnZoneMap::Tracks(attr_size)) {
+        return;
+    }
+    // Writers only ever widen the zone map, so narrow it down to the values that are left now that no older version
+    // of them can be read
+    int64_t  min = std::numeric_limits<int64_t>::max(), max = std::numeric_limits<int64_t>::min();
+    uint32_t null_count = 0;
+    for (uint32_t i = 0; i < num_records; i++) {
+        if (!column_bitmap->Test(i)) {
+            null_count++;
+            continue;
+        }
+        const int64_t value = ColumnZoneMap::ReadValue(values + static_cast<uint64_t>(i) * attr_size, attr_size);
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+    zone_map->Set(min, max, null_count);
+}
+
+void BlockCompactor::CompressColumn(ArrowColumnInfo                   *col,
+                                    const byte                        *values,
+                                    const common::RawConcurrentBitmap *column_bitmap,
+                                    const uint8_t                      value_size,
+                                    const uint32_t                     num_records) {
+    // Only integers of the widths that the compression handles. Anything else is read from the block as is.
+    if (!compress_frozen_blocks_ || (value_size != 1 && value_size != 2 && value_size != 4 && value_size != 8)) {
+        col->Compressed().Deallocate();
+        return;
+    }
+    col->Compressed() = CompressedColumn::Compress(values, column_bitmap, value_size, num_records);
+}
+
 } // namespace noisepage::storage
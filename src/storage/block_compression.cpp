@@ -0,0 +1,283 @@
+#include "storage/block_compression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "common/container/concurrent_bitmap.h"
+
+namespace noisepage::storage {
+
+namespace {
+
+// Number of words that num_values codes of the given width are bit-packed into
+uint64_t PackedWords(const uint32_t num_values, const uint8_t bit_width) {
+    return (static_cast<uint64_t>(num_values) * bit_width + 63) / 64;
+}
+
+// Number of bits needed to store every value up to max_value
+uint8_t BitsFor(const uint64_t max_value) {
+    return max_value == 0 ? 0 : static_cast<uint8_t>(64 - __builtin_clzll(max_value));
+}
+
+// Reads the value at the given index, sign-extended to 64 bits
+uint64_t ReadValue(const byte *values, const uint8_t value_size, const uint32_t index) {
+    const byte *value = values + static_cast<uint64_t>(index) * value_size;
+    switch (value_size) {
+    case 1: {
+        int8_t v;
+        std::memcpy(&v, value, sizeof(v));
+        return static_cast<uint64_t>(static_cast<int64_t>(v));
+    }
+    case 2: {
+        int16_t v;
+        std::memcpy(&v, value, sizeof(v));
+        return static_cast<uint64_t>(static_cast<int64_t>(v));
+    }
+    case 4: {
+        int32_t v;
+        std::memcpy(&v, value, sizeof(v));
+        return static_cast<uint64_t>(static_cast<int64_t>(v));
+    }
+    case 8: {
+        uint64_t v;
+        std::memcpy(&v, value, sizeof(v));
+        return v;
+    }
+    default:
+        throw std::runtime_error("unexpected value size for column compression");
+    }
+}
+
+// Orders values by their sign-extended value rather than their bit pattern
+bool SignedLess(const uint64_t a, const uint64_t b) {
+    return static_cast<int64_t>(a) < static_cast<int64_t>(b);
+}
+
+uint64_t *PackCodes(const std::vector<uint64_t> &codes, const uint8_t bit_width) {
+    if (bit_width == 0) {
+        return nullptr;
+    }
+    const uint64_t num_words = PackedWords(static_cast<uint32_t>(codes.size()), bit_width);
+    auto *const    packed = new uint64_t[num_words]();
+    for (uint64_t i = 0; i < codes.size(); i++) {
+        const uint64_t bit = i * bit_width;
+        const uint64_t word = bit / 64, shift = bit % 64;
+        packed[word] |= codes[i] << shift;
+        // The code continues in the next word
+        if (shift + bit_width > 64) {
+            packed[word + 1] |= codes[i] >> (64 - shift);
+        }
+    }
+    return packed;
+}
+
+} // namespace
+
+CompressedColumn::CompressedColumn(CompressedColumn &&other) noexcept
+    : encoding_(other.encoding_)
+    , value_size_(other.value_size_)
+    , bit_width_(other.bit_width_)
+    , num_values_(other.num_values_)
+    , num_entries_(other.num_entries_)
+    , base_(other.base_)
+    , codes_(other.codes_)
+    , entries_(other.entries_)
+    , run_ends_(other.run_ends_) {
+    other.codes_ = nullptr;
+    other.entries_ = nullptr;
+    other.run_ends_ = nullptr;
+    other.encoding_ = ColumnEncoding::UNCOMPRESSED;
+}
+
+auto CompressedColumn::operator=(CompressedColumn &&other) noexcept -> CompressedColumn & {
+    if (this != &other) {
+        Deallocate();
+        encoding_ = other.encoding_;
+        value_size_ = other.value_size_;
+        bit_width_ = other.bit_width_;
+        num_values_ = other.num_values_;
+        num_entries_ = other.num_entries_;
+        base_ = other.base_;
+        codes_ = other.codes_;
+        entries_ = other.entries_;
+        run_ends_ = other.run_ends_;
+        other.codes_ = nullptr;
+        other.entries_ = nullptr;
+        other.run_ends_ = nullptr;
+        other.encoding_ = ColumnEncoding::UNCOMPRESSED;
+    }
+    return *this;
+}
+
+auto CompressedColumn::Compress(const byte *const                        values,
+                                const common::RawConcurrentBitmap *const null_bitmap,
+                                const uint8_t                            value_size,
+                                const uint32_t                           num_values) -> CompressedColumn {
+    NOISEPAGE_ASSERT(value_size == 1 || value_size == 2 || value_size == 4 || value_size == 8,
+                     "only 1, 2, 4 and 8 byte values can be compressed");
+    CompressedColumn result;
+    result.value_size_ = value_size;
+    result.num_values_ = num_values;
+    if (num_values == 0) {
+        return result;
+    }
+
+    // Read out the values, with every null value replaced by the value before it (or the first non-null value, if it
+    // comes first), and find the frame and the runs on the way
+    std::vector<uint64_t> column(num_values);
+    uint32_t              first_non_null = 0;
+    while (null_bitmap != nullptr && first_non_null < num_values && !null_bitmap->Test(first_non_null)) {
+        first_non_null++;
+    }
+    uint64_t previous = first_non_null < num_values ? ReadValue(values, value_size, first_non_null) : 0;
+    int64_t  min = static_cast<int64_t>(previous), max = min;
+    uint32_t num_runs = 0;
+    for (uint32_t i = 0; i < num_values; i++) {
+        const uint64_t value
+            = null_bitmap == nullptr || null_bitmap->Test(i) ? ReadValue(values, value_size, i) : previous;
+        if (i == 0 || value != previous) {
+            num_runs++;
+        }
+        min = std::min(min, static_cast<int64_t>(value));
+        max = std::max(max, static_cast<int64_t>(value));
+        column[i] = previous = value;
+    }
+
+    std::vector<uint64_t> dictionary(column);
+    std::sort(dictionary.begin(), dictionary.end(), SignedLess);
+    dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+
+    const uint8_t  frame_width = BitsFor(static_cast<uint64_t>(max) - static_cast<uint64_t>(min));
+    const uint8_t  dictionary_width = BitsFor(dictionary.size() - 1);
+    const uint64_t frame_size = PackedWords(num_values, frame_width) * sizeof(uint64_t);
+    const uint64_t run_size = static_cast<uint64_t>(num_runs) * (sizeof(uint64_t) + sizeof(uint32_t));
+    const uint64_t dictionary_size
+        = dictionary.size() * sizeof(uint64_t) + PackedWords(num_values, dictionary_width) * sizeof(uint64_t);
+    const uint64_t smallest = std::min({frame_size, run_size, dictionary_size});
+    if (smallest >= static_cast<uint64_t>(num_values) * value_size) {
+        return result;
+    }
+
+    if (smallest == frame_size) {
+        result.encoding_ = ColumnEncoding::FRAME_OF_REFERENCE;
+        result.base_ = static_cast<uint64_t>(min);
+        result.bit_width_ = frame_width;
+        for (uint64_t &value : column) {
+            value -= result.base_;
+        }
+        result.codes_ = PackCodes(column, frame_width);
+    } else if (smallest == run_size) {
+        result.encoding_ = ColumnEncoding::RUN_LENGTH;
+        result.num_entries_ = num_runs;
+        result.entries_ = new uint64_t[num_runs];
+        result.run_ends_ = new uint32_t[num_runs];
+        for (uint32_t i = 0, run = 0; i < num_values; i++) {
+            if (i + 1 == num_values || column[i + 1] != column[i]) {
+                result.entries_[run] = column[i];
+                result.run_ends_[run] = i + 1;
+                run++;
+            }
+        }
+    } else {
+        result.encoding_ = ColumnEncoding::DICTIONARY;
+        result.num_entries_ = static_cast<uint32_t>(dictionary.size());
+        result.bit_width_ = dictionary_width;
+        result.entries_ = new uint64_t[dictionary.size()];
+        std::copy(dictionary.begin(), dictionary.end(), result.entries_);
+        for (uint64_t &value : column) {
+            value = std::lower_bound(dictionary.begin(), dictionary.end(), value, SignedLess) - dictionary.begin();
+        }
+        result.codes_ = PackCodes(column, dictionary_width);
+    }
+    return result;
+}
+
+void CompressedColumn::Decode(const uint32_t start, const uint32_t count, byte *const out) const {
+    NOISEPAGE_ASSERT(encoding_ != ColumnEncoding::UNCOMPRESSED, "uncompressed columns are read from the block");
+    NOISEPAGE_ASSERT(start + count <= num_values_, "decoded range out of bounds");
+    switch (value_size_) {
+    case 1:
+        DecodeAs(start, count, reinterpret_cast<uint8_t *>(out));
+        break;
+    case 2:
+        DecodeAs(start, count, reinterpret_cast<uint16_t *>(out));
+        break;
+    case 4:
+        DecodeAs(start, count, reinterpret_cast<uint32_t *>(out));
+        break;
+    case 8:
+        DecodeAs(start, count, reinterpret_cast<uint64_t *>(out));
+        break;
+    default:
+        throw std::runtime_error("unexpected value size for column compression");
+    }
+}
+
+template <class T>
+void CompressedColumn::DecodeAs(const uint32_t start, const uint32_t count, T *const out) const {
+    switch (encoding_) {
+    case ColumnEncoding::FRAME_OF_REFERENCE:
+        for (uint32_t i = 0; i < count; i++) {
+            out[i] = static_cast<T>(base_ + Code(start + i));
+        }
+        break;
+    case ColumnEncoding::RUN_LENGTH: {
+        uint32_t run = static_cast<uint32_t>(std::upper_bound(run_ends_, run_ends_ + num_entries_, start) - run_ends_);
+        for (uint32_t i = 0; i < count; i++) {
+            if (start + i == run_ends_[run]) {
+                run++;
+            }
+            out[i] = static_cast<T>(entries_[run]);
+        }
+        break;
+    }
+    case ColumnEncoding::DICTIONARY:
+        for (uint32_t i = 0; i < count; i++) {
+            out[i] = static_cast<T>(entries_[Code(start + i)]);
+        }
+        break;
+    default:
+        throw std::runtime_error("unexpected control flow");
+    }
+}
+
+auto CompressedColumn::Code(const uint32_t index) const -> uint64_t {
+    if (bit_width_ == 0) {
+        return 0;
+    }
+    const uint64_t bit = static_cast<uint64_t>(index) * bit_width_;
+    const uint64_t word = bit / 64, shift = bit % 64;
+    uint64_t       code = codes_[word] >> shift;
+    // The code continues in the next word
+    if (shift + bit_width_ > 64) {
+        code |= codes_[word + 1] << (64 - shift);
+    }
+    return bit_width_ == 64 ? code : code & ((uint64_t{1} << bit_width_) - 1);
+}
+
+auto CompressedColumn::CompressedSize() const -> uint32_t {
+    switch (encoding_) {
+    case ColumnEncoding::FRAME_OF_REFERENCE:
+        return static_cast<uint32_t>(PackedWords(num_values_, bit_width_) * sizeof(uint64_t));
+    case ColumnEncoding::RUN_LENGTH:
+        return num_entries_ * static_cast<uint32_t>(sizeof(uint64_t) + sizeof(uint32_t));
+    case ColumnEncoding::DICTIONARY:
+        return static_cast<uint32_t>((num_entries_ + PackedWords(num_values_, bit_width_)) * sizeof(uint64_t));
+    default:
+        return num_values_ * value_size_;
+    }
+}
+
+void CompressedColumn::Deallocate() {
+    delete[] codes_;
+    codes_ = nullptr;
+    delete[] entries_;
+    entries_ = nullptr;
+    delete[] run_ends_;
+    run_ends_ = nullptr;
+    encoding_ = ColumnEncoding::UNCOMPRESSED;
+}
+
+} // namespace noisepage::storage
@@ -1,10 +1,15 @@
 #include "storage/data_table.h"
 
+#include <algorithm>
+#include <atomic>
 #include <list>
+#include <vector>
 
 #include "common/allocator.h"
 #include "execution/sql/vector_projection.h"
+#include "storage/arrow_block_metadata.h"
 #include "storage/block_access_controller.h"
+#include "storage/block_compression.h"
 #include "storage/storage_util.h"
 #include "transaction/transaction_context.h"
 #include "transaction/transaction_util.h"
@@ -31,7 +36,7 @@ DataTable::~DataTable() {
     common::SharedLatch::ScopedExclusiveLatch latch(&blocks_latch_);
     for (auto block : blocks_) {
         StorageUtil::DeallocateVarlens(block, accessor_);
-        for (col_id_t i : accessor_.GetBlockLayout().Varlens()) {
+        for (col_id_t i : accessor_.GetBlockLayout().AllColumns()) {
             accessor_.GetArrowBlockMetadata(block).GetColumnInfo(accessor_.GetBlockLayout(), i).Deallocate();
         }
         block_store_.operator->()->Release(block);
@@ -66,12 +71,33 @@ void DataTable::Scan(const common::ManagedPointer<transaction::TransactionContex
 
 void DataTable::Scan(const common::ManagedPointer<transaction::TransactionContext> txn,
                      SlotIterator *const                                           start_pos,
-                     execution::sql::VectorProjection *const                       out_buffer) const {
-    uint32_t filled = 0;
+                     execution::sql::VectorProjection *const                       out_buffer,
+                     const std::vector<ZoneMapFilter>                             &block_filters) const {
+    uint32_t  filled = 0;
+    RawBlock *checked_block = nullptr;
     while (filled < out_buffer->GetTupleCapacity() && *start_pos != end()
            && **start_pos != SlotIterator::InvalidTupleSlot()) {
+        const TupleSlot slot = **start_pos;
+        if (slot.GetBlock() != checked_block) {
+            checked_block = slot.GetBlock();
+            // Skip the rest of a block whose values cannot pass the filters
+            if (!MayPassFilters(checked_block, block_filters)) {
+                start_pos->block_index_++;
+                start_pos->UpdateFromNextBlock();
+                continue;
+            }
+            // Frozen blocks have no versions to check, so their tuples are copied, or decoded, in bulk
+            BlockAccessController &controller = checked_block->controller_;
+            if (controller.TryAcquireInPlaceRead()) {
+                const uint32_t filled_before = filled;
+                filled = ScanFrozenBlock(txn, start_pos, out_buffer, filled);
+                controller.ReleaseInPlaceRead();
+                if (filled != filled_before) {
+                    continue;
+                }
+            }
+        }
         execution::sql::VectorProjection::RowView row = out_buffer->InterpretAsRow(filled);
-        const TupleSlot                           slot = **start_pos;
         // Only fill the buffer with valid, visible tuples
         if (SelectIntoBuffer(txn, slot, &row)) {
             row.SetTupleSlot(slot);
@@ -82,6 +108,81 @@ void DataTable::Scan(const common::ManagedPointer<transaction::TransactionContex
     out_buffer->Reset(filled);
 }
 
+auto DataTable::MayPassFilters(RawBlock *const block, const std::vector<ZoneMapFilter> &block_filters) const -> bool {
+    const BlockLayout        &layout = accessor_.GetBlockLayout();
+    const ArrowBlockMetadata &metadata = accessor_.GetArrowBlockMetadata(block);
+    return std::all_of(block_filters.cbegin(), block_filters.cend(), [&](const ZoneMapFilter &filter) {
+        return metadata.GetZoneMap(layout, filter.col_id_).MayContain(filter.min_, filter.max_);
+    });
+}
+
+auto DataTable::ScanFrozenBlock(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                SlotIterator *const                                           start_pos,
+                                execution::sql::VectorProjection *const                       out_buffer,
+                                const uint32_t filled) const -> uint32_t {
+    const BlockLayout  &layout = accessor_.GetBlockLayout();
+    RawBlock *const     block = (*start_pos)->GetBlock();
+    ArrowBlockMetadata &metadata = accessor_.GetArrowBlockMetadata(block);
+    const uint32_t      start = (*start_pos)->GetOffset();
+    if (start >= metadata.NumRecords() || start >= start_pos->max_slot_num_) {
+        return filled;
+    }
+    const auto count = static_cast<uint32_t>(std::min<uint64_t>(
+        {out_buffer->GetTupleCapacity() - filled, metadata.NumRecords() - start, start_pos->max_slot_num_ - start}));
+
+    // The compactor only freezes blocks without gaps below NumRecords(), but read deleted tuples transactionally
+    for (uint32_t i = 0; i < count; i++) {
+        if (!Visible({block, start + i}, accessor_)) {
+            return filled;
+        }
+    }
+
+    for (uint16_t i = 0; i < out_buffer->GetColumnCount(); i++) {
+        const col_id_t                     col_id = out_buffer->ColumnIds()[i];
+        execution::sql::Vector *const      column = out_buffer->GetColumn(i);
+        common::RawConcurrentBitmap *const column_bitmap = accessor_.ColumnNullBitmap(block, col_id);
+        for (uint32_t j = 0; j < count; j++) {
+            column->SetNull(filled + j, !column_bitmap->Test(start + j));
+        }
+
+        const uint16_t          attr_size = layout.AttrSize(col_id);
+        byte *const             out = column->GetData() + static_cast<uint64_t>(filled) * attr_size;
+        ArrowColumnInfo        &col_info = metadata.GetColumnInfo(layout, col_id);
+        const CompressedColumn &compressed = col_info.Compressed();
+        if (compressed.Encoding() == ColumnEncoding::UNCOMPRESSED) {
+            std::memcpy(out, accessor_.ColumnStart(block, col_id) + static_cast<uint64_t>(start) * attr_size,
+                        static_cast<uint64_t>(count) * attr_size);
+        } else if (!layout.IsVarlen(col_id)) {
+            compressed.Decode(start, count, out);
+        } else {
+            // Only the indices of a dictionary-compressed column are compressed, so look the words up in the dictionary
+            std::vector<uint64_t> codes(count);
+            compressed.Decode(start, count, reinterpret_cast<byte *>(codes.data()));
+            const ArrowVarlenColumn &dictionary = col_info.VarlenColumn();
+            auto *const              entries = reinterpret_cast<VarlenEntry *>(out);
+            for (uint32_t j = 0; j < count; j++) {
+                if (!column_bitmap->Test(start + j)) {
+                    continue;
+                }
+                const byte *const word = dictionary.Values() + dictionary.Offsets()[codes[j]];
+                const auto        size = static_cast<uint32_t>(dictionary.Offsets()[codes[j] + 1]
+                                                        - dictionary.Offsets()[codes[j]]);
+                entries[j] = size <= VarlenEntry::InlineThreshold() ? VarlenEntry::CreateInline(word, size)
+                                                                     : VarlenEntry::Create(word, size, false);
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        out_buffer->SetTupleSlot({block, start + i}, filled + i);
+    }
+    txn->num_reads_.fetch_add(count, std::memory_order_relaxed);
+    // Step onto the last slot read, so that the increment moves on to the next block if there are no slots left
+    start_pos->slot_num_ = start + count - 1;
+    ++(*start_pos);
+    return filled + count;
+}
+
 auto DataTable::Update(const common::ManagedPointer<transaction::TransactionContext> txn,
                        const TupleSlot                                               slot,
                        const ProjectedRow                                           &redo) -> bool {
@@ -108,8 +209,9 @@ auto DataTable::Update(const common::ManagedPointer<transaction::TransactionCont
             StorageUtil::CopyAttrIntoProjection(accessor_, slot, undo->Delta(), i);
         }
 
-        // Update the next pointer of the new head of the version chain
-        undo->Next() = version_ptr;
+        // Update the next pointer of the new head of the version chain, leaving out the old head if no running
+        // transaction applies it anymore
+        undo->Next() = IsPrunable(*txn, version_ptr) ? nullptr : version_ptr;
     } while (!CompareAndSwapVersionPtr(slot, accessor_, version_ptr, undo));
 
     // Update in place with the new value.
@@ -121,6 +223,7 @@ auto DataTable::Update(const common::ManagedPointer<transaction::TransactionCont
         // column, but that's difficult with this implementation
         StorageUtil::CopyAttrFromProjection(accessor_, slot, redo, i);
     }
+    WidenZoneMaps(slot.GetBlock(), redo);
 
     return true;
 }
@@ -207,6 +310,7 @@ void DataTable::InsertInto(const common::ManagedPointer<transaction::Transaction
                          "Insert buffer should not change the version pointer column.");
         StorageUtil::CopyAttrFromProjection(accessor_, dest, redo, i);
     }
+    WidenZoneMaps(dest.GetBlock(), redo);
 }
 
 auto DataTable::Delete(const common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot slot)
@@ -225,8 +329,9 @@ auto DataTable::Delete(const common::ManagedPointer<transaction::TransactionCont
             return false;
         }
 
-        // Update the next pointer of the new head of the version chain
-        undo->Next() = version_ptr;
+        // Update the next pointer of the new head of the version chain, leaving out the old head if no running
+        // transaction applies it anymore
+        undo->Next() = IsPrunable(*txn, version_ptr) ? nullptr : version_ptr;
     } while (!CompareAndSwapVersionPtr(slot, accessor_, version_ptr, undo));
 
     // We have the write lock. Go ahead and flip the logically deleted bit to true
@@ -234,12 +339,93 @@ auto DataTable::Delete(const common::ManagedPointer<transaction::TransactionCont
     return true;
 }
 
+void DataTable::WidenZoneMaps(RawBlock *const block, const ProjectedRow &redo) {
+    const BlockLayout  &layout = accessor_.GetBlockLayout();
+    ArrowBlockMetadata &metadata = accessor_.GetArrowBlockMetadata(block);
+    for (uint16_t i = 0; i < redo.NumColumns(); i++) {
+        const col_id_t col_id = redo.ColumnIds()[i];
+        const uint16_t attr_size = layout.AttrSize(col_id);
+        if (layout.IsVarlen(col_id) || !ColumnZoneMap::Tracks(attr_size)) {
+            continue;
+        }
+        ColumnZoneMap    &zone_map = metadata.GetZoneMap(layout, col_id);
+        const byte *const value = redo.AccessWithNullCheck(i);
+        if (value == nullptr) {
+            zone_map.AddNull();
+        } else {
+            zone_map.Widen(ColumnZoneMap::ReadValue(value, attr_size));
+        }
+    }
+}
+
+auto DataTable::NewBulkLoadBlock() -> RawBlock * {
+    return NewBlock();
+}
+
+auto DataTable::BulkLoadInto(RawBlock *const block, const ProjectedRow &redo) -> bool {
+    NOISEPAGE_ASSERT(redo.NumColumns() == accessor_.GetBlockLayout().NumColumns() - NUM_RESERVED_COLUMNS,
+                     "The input buffer never changes the version pointer column, so it should have  exactly 1 fewer "
+                     "attribute than the DataTable's layout.");
+    TupleSlot dest;
+    if (!accessor_.Allocate(block, &dest)) {
+        return false;
+    }
+    // Nobody else can see this block yet, so there is no need to install a version pointer or flip the logically
+    // deleted bit until the whole block is handed to InsertBlock.
+    for (uint16_t i = 0; i < redo.NumColumns(); i++) {
+        StorageUtil::CopyAttrFromProjection(accessor_, dest, redo, i);
+    }
+    WidenZoneMaps(block, redo);
+    return true;
+}
+
+auto DataTable::InsertBlock(const common::ManagedPointer<transaction::TransactionContext> txn, RawBlock *const block)
+    -> UndoRecord * {
+    const uint32_t num_tuples = block->GetInsertHead();
+    NOISEPAGE_ASSERT(num_tuples > 0, "Should not insert an empty block");
+    // Slots are allocated sequentially in a fresh block, so the loaded tuples occupy a contiguous range from slot 0
+    UndoRecord *undo = txn->UndoRecordForBlockInsert(this, TupleSlot(block, 0), num_tuples);
+    for (uint32_t offset = 0; offset < num_tuples; offset++) {
+        const TupleSlot slot(block, offset);
+        AtomicallyWriteVersionPtr(slot, accessor_, undo);
+        accessor_.AccessForceNotNull(slot, VERSION_POINTER_COLUMN_ID);
+    }
+    // Only now can scans reach the block, and they will find every tuple owned by txn
+    common::SharedLatch::ScopedExclusiveLatch latch(&blocks_latch_);
+    blocks_.push_back(block);
+    blocks_size_ = blocks_.size();
+    return undo;
+}
+
+auto DataTable::CopyLoadedTuples(RawBlock *const         block,
+                                 const uint32_t          start_offset,
+                                 const uint32_t          end_offset,
+                                 ProjectedColumns *const out_buffer) const -> uint32_t {
+    NOISEPAGE_ASSERT(start_offset < end_offset, "Should copy at least one tuple");
+    const uint32_t num_tuples = std::min(end_offset - start_offset, out_buffer->MaxTuples());
+    for (uint32_t i = 0; i < num_tuples; i++) {
+        const TupleSlot           slot(block, start_offset + i);
+        ProjectedColumns::RowView row = out_buffer->InterpretAsRow(i);
+        for (uint16_t j = 0; j < row.NumColumns(); j++) {
+            StorageUtil::CopyAttrIntoProjection(accessor_, slot, &row, j);
+        }
+        out_buffer->TupleSlots()[i] = slot;
+    }
+    out_buffer->SetNumTuples(num_tuples);
+    return start_offset + num_tuples;
+}
+
+void DataTable::ReleaseBulkLoadBlock(RawBlock *const block) {
+    StorageUtil::DeallocateVarlens(block, accessor_);
+    block_store_.operator->()->Release(block);
+}
+
 void DataTable::Reset() {
     common::SharedLatch::ScopedExclusiveLatch guard(&blocks_latch_);
     for (RawBlock *block : blocks_) {
         // Deallocate the block and re-initialize it from scratch
         StorageUtil::DeallocateVarlens(block, accessor_);
-        for (col_id_t i : accessor_.GetBlockLayout().Varlens()) {
+        for (col_id_t i : accessor_.GetBlockLayout().AllColumns()) {
             accessor_.GetArrowBlockMetadata(block).GetColumnInfo(accessor_.GetBlockLayout(), i).Deallocate();
         }
         accessor_.InitializeRawBlock(this, block, block->layout_version_);
@@ -272,6 +458,7 @@ bool DataTable::SelectIntoBuffer(const common::ManagedPointer<transaction::Trans
 
     bool        visible = !accessor_.IsNull(slot, VERSION_POINTER_COLUMN_ID);
     UndoRecord *version_ptr = AtomicallyReadVersionPtr(slot, accessor_);
+    txn->num_reads_.fetch_add(1, std::memory_order_relaxed);
 
     // Nullptr in version chain means no other versions visible to any transaction alive at this point.
     // Alternatively, if the current transaction holds the write lock, it should be able to read its own updates.
@@ -280,6 +467,8 @@ bool DataTable::SelectIntoBuffer(const common::ManagedPointer<transaction::Trans
     }
 
     // Apply deltas until we reconstruct a version safe for us to read
+    UndoRecord *newer_version = nullptr;
+    uint64_t    num_versions_walked = 0;
     while (version_ptr != nullptr
            && transaction::TransactionUtil::NewerThan(version_ptr->Timestamp().load(), txn->StartTime())) {
         switch (version_ptr->Type()) {
@@ -288,6 +477,7 @@ bool DataTable::SelectIntoBuffer(const common::ManagedPointer<transaction::Trans
             StorageUtil::ApplyDelta(accessor_.GetBlockLayout(), *(version_ptr->Delta()), out_buffer);
             break;
         case DeltaRecordType::INSERT:
+        case DeltaRecordType::BLOCK_INSERT:
             visible = false;
             break;
         case DeltaRecordType::DELETE:
@@ -296,9 +486,17 @@ bool DataTable::SelectIntoBuffer(const common::ManagedPointer<transaction::Trans
         default:
             throw std::runtime_error("unexpected delta record type");
         }
+        newer_version = version_ptr;
         version_ptr = version_ptr->Next();
+        num_versions_walked++;
+    }
+    if (num_versions_walked > 0) {
+        txn->num_versions_walked_.fetch_add(num_versions_walked, std::memory_order_relaxed);
     }
 
+    if (IsPrunable(*txn, version_ptr) && PruneVersionChain(slot, newer_version, version_ptr)) {
+        txn->num_chains_pruned_.fetch_add(1, std::memory_order_relaxed);
+    }
     return visible;
 }
 
@@ -386,6 +584,7 @@ auto DataTable::IsVisible(const transaction::TransactionContext &txn, const Tupl
     }
 
     // Apply deltas until we determine a version safe for us to read
+    UndoRecord *newer_version = nullptr;
     while (version_ptr != nullptr
            && transaction::TransactionUtil::NewerThan(version_ptr->Timestamp().load(), txn.StartTime())) {
         switch (version_ptr->Type()) {
@@ -393,15 +592,43 @@ auto DataTable::IsVisible(const transaction::TransactionContext &txn, const Tupl
             // Normal delta to be applied. Does not modify the logical delete column.
             break;
         case DeltaRecordType::INSERT:
+        case DeltaRecordType::BLOCK_INSERT:
             visible = false;
             break;
         case DeltaRecordType::DELETE:
             visible = true;
         }
+        newer_version = version_ptr;
         version_ptr = version_ptr->Next();
     }
 
+    if (IsPrunable(txn, version_ptr)) {
+        PruneVersionChain(slot, newer_version, version_ptr);
+    }
     return visible;
 }
 
+auto DataTable::IsPrunable(const transaction::TransactionContext &txn, const UndoRecord *const version) const -> bool {
+    // Every running transaction started after the prune horizon of this one, so none of them applies a version that
+    // committed before it. Uncommitted versions compare as newer than any start time.
+    return version != nullptr
+           && transaction::TransactionUtil::NewerThan(txn.prune_horizon_, version->Timestamp().load());
+}
+
+auto DataTable::PruneVersionChain(const TupleSlot   slot,
+                                  UndoRecord *const newer_version,
+                                  UndoRecord *const version) const -> bool {
+    // Like the GC, this only ever cuts a version chain short, so it races benignly with the GC and with other
+    // transactions that prune the same chain. The versions that are cut off stay allocated until the GC deallocates
+    // their transactions, which waits for every transaction that could still be walking them.
+    if (newer_version != nullptr) {
+        newer_version->Next().store(nullptr);
+        return true;
+    }
+    // The head can be replaced by a writer at any time, in which case the pruning is left to the writer or the GC
+    byte *const ptr_location = accessor_.AccessWithoutNullCheck(slot, VERSION_POINTER_COLUMN_ID);
+    UndoRecord *expected = version;
+    return reinterpret_cast<std::atomic<UndoRecord *> *>(ptr_location)->compare_exchange_strong(expected, nullptr);
+}
+
 } // namespace noisepage::storage
@@ -1,9 +1,12 @@
 #include "storage/garbage_collector.h"
 
+#include <atomic>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/macros.h"
+#include "common/scoped_timer.h"
 #include "common/thread_context.h"
 #include "loggers/storage_logger.h"
 #include "metrics/metrics_store.h"
@@ -22,14 +25,22 @@ GarbageCollector::GarbageCollector(
     const common::ManagedPointer<transaction::TimestampManager>      timestamp_manager,
     const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
     const common::ManagedPointer<transaction::TransactionManager>    txn_manager,
-    AccessObserver                                                  *observer)
+    AccessObserver                                                  *observer,
+    const uint32_t                                                   num_workers)
     : timestamp_manager_(timestamp_manager)
     , deferred_action_manager_(deferred_action_manager)
     , txn_manager_(txn_manager)
     , observer_(observer)
-    , last_unlinked_{0} {
+    , last_unlinked_{0}
+    , num_workers_(num_workers)
+    , worker_stats_(num_workers) {
     NOISEPAGE_ASSERT(txn_manager_->GCEnabled(),
                      "The TransactionManager needs to be instantiated with gc_enabled true for GC to work!");
+    NOISEPAGE_ASSERT(num_workers_ > 0, "The GC needs at least one worker.");
+    if (num_workers_ > 1) {
+        worker_pool_ = std::make_unique<common::WorkerPool>(num_workers_, common::TaskQueue());
+        worker_pool_->Startup();
+    }
 }
 
 auto GarbageCollector::PerformGarbageCollection() -> std::pair<uint32_t, uint32_t> {
@@ -40,6 +51,9 @@ auto GarbageCollector::PerformGarbageCollection() -> std::pair<uint32_t, uint32_
     if (observer_ != nullptr) {
         observer_->ObserveGCInvocation();
     }
+    for (auto &stats : worker_stats_) {
+        stats = WorkerStats();
+    }
     timestamp_manager_->CheckOutTimestamp();
     const transaction::timestamp_t oldest_txn = timestamp_manager_->OldestTransactionStartTime();
     uint32_t                       txns_deallocated = ProcessDeallocateQueue(oldest_txn);
@@ -68,6 +82,15 @@ auto GarbageCollector::PerformGarbageCollection() -> std::pair<uint32_t, uint32_
                                                                 readonly_unlinked,
                                                                 gc_interval_,
                                                                 resource_metrics);
+            for (uint32_t worker = 0; worker < num_workers_; worker++) {
+                const WorkerStats &stats = worker_stats_[worker];
+                common::thread_context.metrics_store_->RecordGCWorkerData(worker,
+                                                                          stats.txns_deallocated_,
+                                                                          stats.undo_records_unlinked_,
+                                                                          stats.indexes_processed_,
+                                                                          stats.elapsed_us_,
+                                                                          resource_metrics);
+            }
         }
         common::thread_context.resource_tracker_.Start();
     }
@@ -82,11 +105,18 @@ auto GarbageCollector::ProcessDeallocateQueue(transaction::timestamp_t oldest_tx
         // All of the transactions in my deallocation queue were unlinked before the oldest running txn in the system,
         // and have been serialized by the log manager. We are now safe to deallocate these txns because no running
         // transaction should hold a reference to them anymore
-        for (auto &txn : txns_to_deallocate_) {
-            delete txn;
-            txns_processed++;
-        }
+        const std::vector<transaction::TransactionContext *> txns(txns_to_deallocate_.cbegin(),
+                                                                  txns_to_deallocate_.cend());
         txns_to_deallocate_.clear();
+        if (!txns.empty()) {
+            RunOnWorkers([&](const uint32_t worker) {
+                for (size_t i = worker; i < txns.size(); i += num_workers_) {
+                    delete txns[i];
+                    worker_stats_[worker].txns_deallocated_++;
+                }
+            });
+        }
+        txns_processed = static_cast<uint32_t>(txns.size());
     }
 
     return txns_processed;
@@ -106,10 +136,8 @@ auto GarbageCollector::ProcessUnlinkQueue(transaction::timestamp_t oldest_txn)
     uint32_t txns_processed = 0, buffer_processed = 0, readonly_processed = 0;
     // Certain transactions might not be yet safe to gc. Need to requeue them
     transaction::TransactionQueue requeue;
-    // It is sufficient to truncate each version chain once in a GC invocation because we only read the maximal safe
-    // timestamp once, and the version chain is sorted by timestamp. Here we keep a set of slots to truncate to avoid
-    // wasteful traversals of the version chain.
-    std::unordered_set<TupleSlot> visited_slots;
+    // Transactions whose undo records are unlinked by the workers
+    std::vector<transaction::TransactionContext *> txns_to_unlink;
 
     // Process every transaction in the unlink queue
     while (!txns_to_unlink_.empty()) {
@@ -123,25 +151,7 @@ auto GarbageCollector::ProcessUnlinkQueue(transaction::timestamp_t oldest_txn)
             readonly_processed++;
         } else if (transaction::TransactionUtil::NewerThan(oldest_txn, txn->FinishTime())) {
             // Safe to garbage collect.
-            for (auto &undo_record : txn->undo_buffer_) {
-                // It is possible for the table field to be null, for aborted transaction's last conflicting record
-                DataTable *&table = undo_record.Table();
-                // Each version chain needs to be traversed and truncated at most once every GC period. Check
-                // if we have already visited this tuple slot; if not, proceed to prune the version chain.
-                if (table != nullptr && visited_slots.insert(undo_record.Slot()).second) {
-                    TruncateVersionChain(table, undo_record.Slot(), oldest_txn);
-                }
-                // Regardless of the version chain we will need to reclaim deleted slots and any dangling pointers to
-                // varlens, unless the transaction is aborted, and the record holds a version that is still visible.
-                if (!txn->Aborted()) {
-                    ReclaimBufferIfVarlen(txn, &undo_record);
-                    ReclaimSlotIfDeleted(&undo_record);
-                }
-                if (observer_ != nullptr) {
-                    observer_->ObserveWrite(undo_record.Slot().GetBlock());
-                }
-                buffer_processed++;
-            }
+            txns_to_unlink.push_back(txn);
             txns_to_deallocate_.push_front(txn);
             txns_processed++;
         } else {
@@ -153,9 +163,100 @@ auto GarbageCollector::ProcessUnlinkQueue(transaction::timestamp_t oldest_txn)
     // Requeue any txns that we were still visible to running transactions
     txns_to_unlink_ = transaction::TransactionQueue(std::move(requeue));
 
+    if (!txns_to_unlink.empty()) {
+        std::vector<UnlinkPartition> partitions(num_workers_);
+        RunOnWorkers([&](const uint32_t worker) {
+            worker_stats_[worker].undo_records_unlinked_
+                += UnlinkRecords(txns_to_unlink, oldest_txn, worker, &partitions[worker]);
+        });
+        for (uint32_t worker = 0; worker < num_workers_; worker++) {
+            buffer_processed += static_cast<uint32_t>(worker_stats_[worker].undo_records_unlinked_);
+            for (const auto &[owner, ptr] : partitions[worker].loose_ptrs_) {
+                owner->loose_ptrs_.push_back(ptr);
+            }
+            if (observer_ != nullptr) {
+                for (RawBlock *const block : partitions[worker].written_blocks_) {
+                    observer_->ObserveWrite(block);
+                }
+            }
+        }
+    }
+
     return std::make_tuple(txns_processed, buffer_processed, readonly_processed);
 }
 
+auto GarbageCollector::UnlinkRecords(const std::vector<transaction::TransactionContext *> &txns,
+                                     const transaction::timestamp_t                        oldest_txn,
+                                     const uint32_t                                        worker,
+                                     UnlinkPartition *const                                partition) -> uint32_t {
+    uint32_t records_processed = 0;
+    // It is sufficient to truncate each version chain once in a GC invocation because we only read the maximal safe
+    // timestamp once, and the version chain is sorted by timestamp. Here we keep a set of slots to truncate to avoid
+    // wasteful traversals of the version chain. A slot is only ever visited by the worker that owns its block.
+    std::unordered_set<TupleSlot> visited_slots;
+
+    for (transaction::TransactionContext *const txn : txns) {
+        for (auto &undo_record : txn->undo_buffer_) {
+            RawBlock *const block = undo_record.Slot().GetBlock();
+            if (PartitionOf(block) != worker) {
+                continue;
+            }
+            // It is possible for the table field to be null, for aborted transaction's last conflicting record
+            DataTable *&table = undo_record.Table();
+            // Each version chain needs to be traversed and truncated at most once every GC period. Check
+            // if we have already visited this tuple slot; if not, proceed to prune the version chain.
+            if (table != nullptr && undo_record.Type() == DeltaRecordType::BLOCK_INSERT) {
+                // A block insert record heads the version chain of every slot it loaded. Truncating one of those
+                // chains twice in a GC period is only wasted work, which is cheaper than tracking all of them.
+                for (uint32_t offset = 0; offset < undo_record.NumSlots(); offset++) {
+                    const TupleSlot slot(block, undo_record.Slot().GetOffset() + offset);
+                    TruncateVersionChain(table, slot, oldest_txn);
+                }
+            } else if (table != nullptr && visited_slots.insert(undo_record.Slot()).second) {
+                TruncateVersionChain(table, undo_record.Slot(), oldest_txn);
+            }
+            // Regardless of the version chain we will need to reclaim deleted slots and any dangling pointers to
+            // varlens, unless the transaction is aborted, and the record holds a version that is still visible.
+            if (!txn->Aborted()) {
+                ReclaimBufferIfVarlen(txn, &undo_record, partition);
+                ReclaimSlotIfDeleted(&undo_record);
+            }
+            if (observer_ != nullptr
+                && (partition->written_blocks_.empty() || partition->written_blocks_.back() != block)) {
+                partition->written_blocks_.push_back(block);
+            }
+            records_processed++;
+        }
+    }
+    return records_processed;
+}
+
+void GarbageCollector::RunOnWorkers(const std::function<void(uint32_t)> &task) {
+    auto timed_task = [this, &task](const uint32_t worker) {
+        uint64_t elapsed_us;
+        {
+            common::ScopedTimer<std::chrono::microseconds> timer(&elapsed_us);
+            task(worker);
+        }
+        worker_stats_[worker].elapsed_us_ += elapsed_us;
+    };
+    if (worker_pool_ == nullptr) {
+        timed_task(0);
+        return;
+    }
+    for (uint32_t worker = 0; worker < num_workers_; worker++) {
+        worker_pool_->SubmitTask([&timed_task, worker] {
+            timed_task(worker);
+        });
+    }
+    worker_pool_->WaitUntilAllFinished();
+}
+
+auto GarbageCollector::PartitionOf(const RawBlock *const block) const -> uint32_t {
+    // Blocks are aligned to their size, so the low bits of their address carry no information
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(block) / common::Constants::BLOCK_SIZE % num_workers_);
+}
+
 void GarbageCollector::ProcessDeferredActions(transaction::timestamp_t oldest_txn) {
     if (deferred_action_manager_ != DISABLED) {
         // TODO(Tianyu): Eventually we will remove the GC and implement version chain pruning with deferred actions
@@ -186,8 +287,9 @@ void GarbageCollector::TruncateVersionChain(DataTable *const               table
         return;
     }
 
-    // a version chain is guaranteed to not change when not at the head (assuming single-threaded GC), so we are safe
-    // to traverse and update pointers without CAS
+    // a version chain is guaranteed to not change when not at the head (as only the GC worker that owns its block
+    // truncates it, and transactions pruning it only ever cut it shorter too), so we are safe to traverse and update
+    // pointers without CAS
     UndoRecord *curr = version_ptr;
     UndoRecord *next;
     // Traverse until we find the earliest UndoRecord that can be unlinked.
@@ -221,11 +323,13 @@ void GarbageCollector::ReclaimSlotIfDeleted(UndoRecord *const undo_record) const
 }
 
 void GarbageCollector::ReclaimBufferIfVarlen(transaction::TransactionContext *const txn,
-                                             UndoRecord *const                      undo_record) const {
+                                             UndoRecord *const                      undo_record,
+                                             UnlinkPartition *const                 partition) const {
     const TupleAccessStrategy &accessor = undo_record->Table()->accessor_;
     const BlockLayout         &layout = accessor.GetBlockLayout();
     switch (undo_record->Type()) {
     case DeltaRecordType::INSERT:
+    case DeltaRecordType::BLOCK_INSERT:
         return; // no possibility of outdated varlen to gc
     case DeltaRecordType::DELETE:
         // TODO(Tianyu): Potentially need to be more efficient than linear in column size?
@@ -236,7 +340,7 @@ void GarbageCollector::ReclaimBufferIfVarlen(transaction::TransactionContext *co
                 auto *varlen
                     = reinterpret_cast<VarlenEntry *>(accessor.AccessWithNullCheck(undo_record->Slot(), col_id));
                 if (varlen != nullptr && varlen->NeedReclaim()) {
-                    txn->loose_ptrs_.push_back(varlen->Content());
+                    partition->loose_ptrs_.emplace_back(txn, varlen->Content());
                 }
             }
         }
@@ -248,7 +352,7 @@ void GarbageCollector::ReclaimBufferIfVarlen(transaction::TransactionContext *co
             if (layout.IsVarlen(col_id)) {
                 auto *varlen = reinterpret_cast<VarlenEntry *>(undo_record->Delta()->AccessWithNullCheck(i));
                 if (varlen != nullptr && varlen->NeedReclaim()) {
-                    txn->loose_ptrs_.push_back(varlen->Content());
+                    partition->loose_ptrs_.emplace_back(txn, varlen->Content());
                 }
             }
         }
@@ -274,9 +378,18 @@ void GarbageCollector::UnregisterIndexForGC(const common::ManagedPointer<index::
 
 void GarbageCollector::ProcessIndexes() {
     common::SharedLatch::ScopedSharedLatch guard(&indexes_latch_);
-    for (const auto &index : indexes_) {
-        index->PerformGarbageCollection();
+    if (indexes_.empty()) {
+        return;
     }
+    const std::vector<common::ManagedPointer<index::Index>> indexes(indexes_.cbegin(), indexes_.cend());
+    // Indexes differ widely in how much garbage they hold, so they are handed out one at a time instead of in shares
+    std::atomic<uint32_t> next_index = 0;
+    RunOnWorkers([&](const uint32_t worker) {
+        for (uint32_t i = next_index++; i < indexes.size(); i = next_index++) {
+            indexes[i]->PerformGarbageCollection();
+            worker_stats_[worker].indexes_processed_++;
+        }
+    });
 }
 
 } // namespace noisepage::storage
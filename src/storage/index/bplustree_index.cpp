@@ -1,5 +1,9 @@
 #include "storage/index/bplustree_index.h"
 
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+
 #include "storage/index/bplustree.h"
 #include "storage/index/compact_ints_key.h"
 #include "storage/index/generic_key.h"
@@ -123,6 +127,56 @@ void BPlusTreeIndex<KeyType>::Delete(common::ManagedPointer<transaction::Transac
     });
 }
 
+template <typename KeyType>
+bool BPlusTreeIndex<KeyType>::BulkBuildInsert(common::ManagedPointer<transaction::TransactionContext> txn,
+                                              const ProjectedRow                                     &tuple,
+                                              TupleSlot                                               location) {
+    KeyType index_key;
+    index_key.SetFromProjectedRow(tuple, metadata_, metadata_.GetSchema().GetColumns().size());
+    bulk_build_elements_.local().emplace_back(index_key, location);
+    return true;
+}
+
+template <typename KeyType>
+bool BPlusTreeIndex<KeyType>::BulkBuildFinish(common::ManagedPointer<transaction::TransactionContext> txn) {
+    NOISEPAGE_ASSERT(bplustree_->GetSize() == 0, "A bulk build must start from an empty index.");
+
+    // Gather the pairs staged by all threads and sort them by key
+    std::vector<std::pair<KeyType, TupleSlot>> elements;
+    std::size_t                                num_elements = 0;
+    for (const auto &staged : bulk_build_elements_) {
+        num_elements += staged.size();
+    }
+    elements.reserve(num_elements);
+    for (auto &staged : bulk_build_elements_) {
+        elements.insert(elements.end(), staged.begin(), staged.end());
+    }
+    bulk_build_elements_.clear();
+    tbb::parallel_sort(elements.begin(), elements.end(), [](const auto &lhs, const auto &rhs) {
+        return std::less<KeyType>()(lhs.first, rhs.first);
+    });
+
+    // Every staged tuple is visible to the building txn, so any two equal keys violate the uniqueness constraint
+    if (metadata_.GetSchema().Unique()) {
+        const auto duplicate
+            = std::adjacent_find(elements.begin(), elements.end(), [](const auto &lhs, const auto &rhs) {
+                  return std::equal_to<KeyType>()(lhs.first, rhs.first);
+              });
+        if (duplicate != elements.end()) {
+            txn->SetMustAbort();
+            return false;
+        }
+    }
+
+    bplustree_->BulkLoad(elements);
+
+    // Register a single abort action for the whole build instead of one per key
+    txn->RegisterAbortAction([this]() {
+        bplustree_->Clear();
+    });
+    return true;
+}
+
 template <typename KeyType>
 void BPlusTreeIndex<KeyType>::ScanKey(const transaction::TransactionContext &txn,
                                       const ProjectedRow                    &key,
@@ -1,5 +1,10 @@
 #include "storage/index/hash_index.h"
 
+#include <tbb/parallel_for.h>
+
+#include <atomic>
+#include <unordered_map>
+
 #include "libcuckoo/cuckoohash_map.hh"
 #include "storage/index/generic_key.h"
 #include "storage/index/hash_key.h"
@@ -228,6 +233,82 @@ void HashIndex<KeyType>::Delete(const common::ManagedPointer<transaction::Transa
     });
 }
 template <typename KeyType>
+bool HashIndex<KeyType>::BulkBuildInsert(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                         const ProjectedRow                                           &tuple,
+                                         const TupleSlot                                               location) {
+    KeyType index_key;
+    index_key.SetFromProjectedRow(tuple, metadata_, metadata_.GetSchema().GetColumns().size());
+    bulk_build_elements_.local().emplace_back(index_key, location);
+    return true;
+}
+template <typename KeyType>
+bool HashIndex<KeyType>::BulkBuildFinish(const common::ManagedPointer<transaction::TransactionContext> txn) {
+    NOISEPAGE_ASSERT(hash_map_->size() == 0, "A bulk build must start from an empty index.");
+
+    // Scatter the pairs staged by each thread into partitions by the hash of their key, in parallel across threads
+    std::vector<std::vector<std::pair<KeyType, TupleSlot>> *> staged;
+    std::size_t                                               num_elements = 0;
+    for (auto &elements : bulk_build_elements_) {
+        staged.push_back(&elements);
+        num_elements += elements.size();
+    }
+    std::vector<std::vector<std::vector<std::pair<KeyType, TupleSlot>>>> partitions(
+        staged.size(),
+        std::vector<std::vector<std::pair<KeyType, TupleSlot>>>(BULK_BUILD_PARTITIONS));
+    tbb::parallel_for(std::size_t{0}, staged.size(), [&](const std::size_t thread) {
+        for (const auto &element : *staged[thread]) {
+            partitions[thread][std::hash<KeyType>()(element.first) % BULK_BUILD_PARTITIONS].push_back(element);
+        }
+        staged[thread]->clear();
+        staged[thread]->shrink_to_fit();
+    });
+    bulk_build_elements_.clear();
+
+    // Group the values of each key within a partition, then move the keys into the map. Partitions hold disjoint sets
+    // of keys, so they don't contend on the map's buckets beyond what hashing causes anyway.
+    hash_map_->reserve(num_elements);
+    std::atomic<bool> duplicate = false;
+    const bool        unique = metadata_.GetSchema().Unique();
+    tbb::parallel_for(uint16_t{0}, BULK_BUILD_PARTITIONS, [&](const uint16_t partition) {
+        std::unordered_map<KeyType, ValueType, std::hash<KeyType>, std::equal_to<KeyType>> values;
+        for (auto &thread_partitions : partitions) {
+            for (const auto &[key, location] : thread_partitions[partition]) {
+                auto [it, inserted] = values.try_emplace(key, location);
+                if (inserted) {
+                    continue;
+                }
+                if (unique) {
+                    // Every staged tuple is visible to the building txn, so equal keys violate the constraint
+                    duplicate = true;
+                    return;
+                }
+                if (std::holds_alternative<TupleSlot>(it->second)) {
+                    const auto existing_location = std::get<TupleSlot>(it->second);
+                    it->second = ValueMap({{location}, {existing_location}}, 2);
+                } else {
+                    std::get<ValueMap>(it->second).emplace(location);
+                }
+            }
+            thread_partitions[partition].clear();
+        }
+        for (auto &[key, value] : values) {
+            hash_map_->insert(key, std::move(value));
+        }
+    });
+
+    if (duplicate) {
+        hash_map_->clear();
+        txn->SetMustAbort();
+        return false;
+    }
+
+    // Register a single abort action for the whole build instead of one per key
+    txn->RegisterAbortAction([this]() {
+        hash_map_->clear();
+    });
+    return true;
+}
+template <typename KeyType>
 void HashIndex<KeyType>::ScanKey(const transaction::TransactionContext &txn,
                                  const ProjectedRow                    &key,
                                  std::vector<TupleSlot>                *value_list) {
@@ -5,14 +5,19 @@
 
 #include "storage/projected_row.h"
 #include "storage/storage_defs.h"
+#include "storage/write_ahead_log/log_frame.h"
 
 namespace noisepage::storage {
 
 auto AbstractLogProvider::ReadNextRecord() -> std::pair<LogRecord *, std::vector<byte *>> {
     // Pointer to buffers for non-aligned varlen entries so we can clean them up down the road
     std::vector<byte *> varlen_contents;
-    // Read in LogRecord header data
-    auto  size = ReadValue<uint32_t>();
+    // Read in LogRecord header data. No record has this size, it marks the start of a log frame.
+    auto size = ReadValue<uint32_t>();
+    if (size == LogFrameHeader::MARKER) {
+        BeginFrame();
+        size = ReadValue<uint32_t>();
+    }
     byte *buf = common::AllocationUtil::AllocateAligned(size);
     auto  record_type = ReadValue<storage::LogRecordType>();
     auto  txn_begin = ReadValue<transaction::timestamp_t>();
@@ -56,34 +61,9 @@ auto AbstractLogProvider::ReadNextRecord() -> std::pair<LogRecord *, std::vector
         auto table_oid = ReadValue<catalog::table_oid_t>();
         auto tuple_slot = ReadValue<storage::TupleSlot>();
 
-        // TODO(Gus, PR #468): Future addition of checksums should validate these values in case of data corruption.
-        auto num_cols = ReadValue<uint16_t>();
-        if (num_cols > common::Constants::MAX_COL) {
-            throw std::runtime_error("Number of columns deserialized exceeds max columns. possible data corrution");
-        }
-
-        // Read in col_ids
-        // IDs read individually since we can't guarantee memory layout of vector
         std::vector<storage::col_id_t> col_ids;
-        col_ids.reserve(num_cols);
-        for (uint16_t i = 0; i < num_cols; i++) {
-            const auto col_id = ReadValue<storage::col_id_t>();
-            col_ids.push_back(col_id);
-        }
-
-        // Read in attribute size boundaries
-        std::vector<uint16_t> attr_size_boundaries;
-        attr_size_boundaries.reserve(NUM_ATTR_BOUNDARIES);
-        for (uint16_t i = 0; i < NUM_ATTR_BOUNDARIES; i++) {
-            attr_size_boundaries.push_back(ReadValue<uint16_t>());
-        }
-
-        // Compute attr sizes
-        std::vector<uint16_t> attr_sizes;
-        attr_sizes.reserve(num_cols);
-        for (uint16_t attr_idx = 0; attr_idx < num_cols; attr_idx++) {
-            attr_sizes.push_back(StorageUtil::AttrSizeFromBoundaries(attr_size_boundaries, attr_idx));
-        }
+        std::vector<uint16_t>          attr_sizes;
+        ReadColumns(&col_ids, &attr_sizes);
 
         // Initialize the redo record.
         auto  initializer = storage::ProjectedRowInitializer::Create(attr_sizes, col_ids);
@@ -91,67 +71,133 @@ auto AbstractLogProvider::ReadNextRecord() -> std::pair<LogRecord *, std::vector
         auto *record_body = result->GetUnderlyingRecordBodyAs<RedoRecord>();
         record_body->SetTupleSlot(tuple_slot);
         auto *delta = record_body->Delta();
-        NOISEPAGE_ASSERT(delta->NumColumns() == num_cols,
+        NOISEPAGE_ASSERT(delta->NumColumns() == col_ids.size(),
                          "ProjectedRow must have same number of columns as what was serialized.");
 
-        // Get an in memory copy of the record's null bitmap. Note: this is used to guide how the rest of the log file
-        // is read in. It doesn't populate the delta's bitmap yet. This will happen naturally as we proceed
-        // column-by-column.
-        auto  bitmap_num_bytes = common::RawBitmap::SizeInBytes(num_cols);
-        auto *bitmap_buffer = new uint8_t[bitmap_num_bytes];
-        Read(bitmap_buffer, bitmap_num_bytes);
-        auto *bitmap = reinterpret_cast<common::RawBitmap *>(bitmap_buffer);
-
-        for (uint16_t i = 0; i < num_cols; i++) {
-            if (!bitmap->Test(i)) {
-                // Recall that 0 means null in our definition of a ProjectedRow's null bitmap.
-                delta->SetNull(i);
-                continue;
-            }
-
-            // The column is not null, so set the bitmap accordingly and get access to the column value.
-            auto *column_value_address = delta->AccessForceNotNull(i);
-            // Need to mask off sign bit from VARLEN_COLUMN to get the varlen size
-            if (attr_sizes[i] == AttrSizeBytes(VARLEN_COLUMN)) {
-                // Read how many bytes this varlen actually is.
-                const auto varlen_attribute_size = ReadValue<uint32_t>();
-
-                // Create the varlen entry depending on whether it can be inlined or not
-                storage::VarlenEntry varlen_entry;
-                if (varlen_attribute_size <= storage::VarlenEntry::InlineThreshold()) {
-                    // Because it's inline, we can just read it into a stack object, as the varlen constructor will
-                    // memcpy it
-                    byte varlen_attribute_content[varlen_attribute_size];
-                    Read(&varlen_attribute_content, varlen_attribute_size);
-                    varlen_entry = storage::VarlenEntry::CreateInline(varlen_attribute_content, varlen_attribute_size);
-                } else {
-                    // Allocate a varlen buffer of this many bytes.
-                    auto *varlen_attribute_content = common::AllocationUtil::AllocateAligned(varlen_attribute_size);
-                    // Fill the entry with the next bytes from the log file.
-                    Read(varlen_attribute_content, varlen_attribute_size);
-
-                    varlen_entry = storage::VarlenEntry::Create(varlen_attribute_content, varlen_attribute_size, true);
-                    varlen_contents.push_back(varlen_attribute_content);
-                }
-                // The attribute value in the ProjectedRow will be a pointer to this varlen entry.
-                auto *dest = reinterpret_cast<storage::VarlenEntry *>(column_value_address);
-                // Set the value to be the address of the varlen_entry.
-                *dest = varlen_entry;
-                // Store reference to varlen content to clean up incase of abort
-            } else {
-                // For inlined attributes, just directly read into the ProjectedRow.
-                Read(column_value_address, attr_sizes[i]);
-            }
-        }
-
-        // Free the memory allocated for the bitmap.
-        delete[] bitmap_buffer;
+        ReadDelta(delta, attr_sizes, &varlen_contents);
         return {result, std::move(varlen_contents)};
     }
 
+    case (storage::LogRecordType::BLOCK_INSERT): {
+        // The batch is handed out as one REDO record per tuple, so the buffer sized for the whole batch is not needed
+        delete[] buf;
+        block_insert_db_oid_ = ReadValue<catalog::db_oid_t>();
+        block_insert_table_oid_ = ReadValue<catalog::table_oid_t>();
+        block_insert_txn_begin_ = txn_begin;
+        block_insert_tuples_left_ = ReadValue<uint32_t>();
+        ReadColumns(&block_insert_col_ids_, &block_insert_attr_sizes_);
+        return ReadBlockInsertTuple();
+    }
+
     default:
         throw std::runtime_error("Unknown log record type during deserialization: "
                                  + std::to_string(static_cast<uint8_t>(record_type)));
     }
 }
+
+void AbstractLogProvider::ReadColumns(std::vector<col_id_t> *const col_ids, std::vector<uint16_t> *const attr_sizes) {
+    // TODO(Gus, PR #468): Future addition of checksums should validate these values in case of data corruption.
+    auto num_cols = ReadValue<uint16_t>();
+    if (num_cols > common::Constants::MAX_COL) {
+        throw std::runtime_error("Number of columns deserialized exceeds max columns. possible data corrution");
+    }
+
+    // Read in col_ids
+    // IDs read individually since we can't guarantee memory layout of vector
+    col_ids->clear();
+    col_ids->reserve(num_cols);
+    for (uint16_t i = 0; i < num_cols; i++) {
+        const auto col_id = ReadValue<storage::col_id_t>();
+        col_ids->push_back(col_id);
+    }
+
+    // Read in attribute size boundaries
+    std::vector<uint16_t> attr_size_boundaries;
+    attr_size_boundaries.reserve(NUM_ATTR_BOUNDARIES);
+    for (uint16_t i = 0; i < NUM_ATTR_BOUNDARIES; i++) {
+        attr_size_boundaries.push_back(ReadValue<uint16_t>());
+    }
+
+    // Compute attr sizes
+    attr_sizes->clear();
+    attr_sizes->reserve(num_cols);
+    for (uint16_t attr_idx = 0; attr_idx < num_cols; attr_idx++) {
+        attr_sizes->push_back(StorageUtil::AttrSizeFromBoundaries(attr_size_boundaries, attr_idx));
+    }
+}
+
+auto AbstractLogProvider::ReadBlockInsertTuple() -> std::pair<LogRecord *, std::vector<byte *>> {
+    NOISEPAGE_ASSERT(block_insert_tuples_left_ > 0, "No tuples left to expand out of the block insert record");
+    block_insert_tuples_left_--;
+    std::vector<byte *> varlen_contents;
+    auto  initializer = storage::ProjectedRowInitializer::Create(block_insert_attr_sizes_, block_insert_col_ids_);
+    byte *buf = common::AllocationUtil::AllocateAligned(storage::RedoRecord::Size(initializer));
+    auto *result = storage::RedoRecord::Initialize(buf,
+                                                   block_insert_txn_begin_,
+                                                   block_insert_db_oid_,
+                                                   block_insert_table_oid_,
+                                                   initializer);
+    auto *record_body = result->GetUnderlyingRecordBodyAs<RedoRecord>();
+    record_body->SetTupleSlot(ReadValue<storage::TupleSlot>());
+    ReadDelta(record_body->Delta(), block_insert_attr_sizes_, &varlen_contents);
+    return {result, std::move(varlen_contents)};
+}
+
+void AbstractLogProvider::ReadDelta(ProjectedRow *const          delta,
+                                    const std::vector<uint16_t> &attr_sizes,
+                                    std::vector<byte *> *const   varlen_contents) {
+    const uint16_t num_cols = delta->NumColumns();
+    // Get an in memory copy of the record's null bitmap. Note: this is used to guide how the rest of the log file
+    // is read in. It doesn't populate the delta's bitmap yet. This will happen naturally as we proceed
+    // column-by-column.
+    auto  bitmap_num_bytes = common::RawBitmap::SizeInBytes(num_cols);
+    auto *bitmap_buffer = new uint8_t[bitmap_num_bytes];
+    Read(bitmap_buffer, bitmap_num_bytes);
+    auto *bitmap = reinterpret_cast<common::RawBitmap *>(bitmap_buffer);
+
+    for (uint16_t i = 0; i < num_cols; i++) {
+        if (!bitmap->Test(i)) {
+            // Recall that 0 means null in our definition of a ProjectedRow's null bitmap.
+            delta->SetNull(i);
+            continue;
+        }
+
+        // The column is not null, so set the bitmap accordingly and get access to the column value.
+        auto *column_value_address = delta->AccessForceNotNull(i);
+        // Need to mask off sign bit from VARLEN_COLUMN to get the varlen size
+        if (attr_sizes[i] == AttrSizeBytes(VARLEN_COLUMN)) {
+            // Read how many bytes this varlen actually is.
+            const auto varlen_attribute_size = ReadValue<uint32_t>();
+
+            // Create the varlen entry depending on whether it can be inlined or not
+            storage::VarlenEntry varlen_entry;
+            if (varlen_attribute_size <= storage::VarlenEntry::InlineThreshold()) {
+                // Because it's inline, we can just read it into a stack object, as the varlen constructor will
+                // memcpy it
+                byte varlen_attribute_content[varlen_attribute_size];
+                Read(&varlen_attribute_content, varlen_attribute_size);
+                varlen_entry = storage::VarlenEntry::CreateInline(varlen_attribute_content, varlen_attribute_size);
+            } else {
+                // Allocate a varlen buffer of this many bytes.
+                auto *varlen_attribute_content = common::AllocationUtil::AllocateAligned(varlen_attribute_size);
+                // Fill the entry with the next bytes from the log file.
+                Read(varlen_attribute_content, varlen_attribute_size);
+
+                varlen_entry = storage::VarlenEntry::Create(varlen_attribute_content, varlen_attribute_size, true);
+                // Store reference to varlen content to clean up incase of abort
+                varlen_contents->push_back(varlen_attribute_content);
+            }
+            // The attribute value in the ProjectedRow will be a pointer to this varlen entry.
+            auto *dest = reinterpret_cast<storage::VarlenEntry *>(column_value_address);
+            // Set the value to be the address of the varlen_entry.
+            *dest = varlen_entry;
+        } else {
+            // For inlined attributes, just directly read into the ProjectedRow.
+            Read(column_value_address, attr_sizes[i]);
+        }
+    }
+
+    // Free the memory allocated for the bitmap.
+    delete[] bitmap_buffer;
+}
 } // namespace noisepage::storage
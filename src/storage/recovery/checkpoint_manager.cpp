@@ -0,0 +1,414 @@
+#include "storage/recovery/checkpoint_manager.h"
+
+#include <chrono> // NOLINT
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <thread> // NOLINT
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/database_catalog.h"
+#include "catalog/postgres/pg_attribute.h"
+#include "catalog/postgres/pg_class.h"
+#include "catalog/postgres/pg_database.h"
+#include "catalog/postgres/pg_index.h"
+#include "catalog/schema.h"
+#include "common/allocator.h"
+#include "loggers/storage_logger.h"
+#include "storage/sql_table.h"
+#include "storage/write_ahead_log/log_io.h"
+#include "storage/write_ahead_log/log_manager.h"
+#include "storage/write_ahead_log/log_record.h"
+#include "storage/write_ahead_log/log_record_serializer.h"
+#include "transaction/timestamp_manager.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace noisepage::storage {
+
+namespace {
+/** @return oids of all columns of the schema */
+std::vector<catalog::col_oid_t> AllColumnOids(const catalog::Schema &schema) {
+    std::vector<catalog::col_oid_t> col_oids;
+    for (const auto &col : schema.GetColumns()) {
+        col_oids.push_back(col.Oid());
+    }
+    return col_oids;
+}
+} // namespace
+
+/**
+ * Writes a checkpoint file. Records are grouped into transactions of CHECKPOINT_TXN_NUM_RECORDS records, that all begin
+ * and commit at the checkpoint timestamp, so that recovery replays the checkpoint in bounded memory.
+ */
+class CheckpointManager::CheckpointWriter {
+public:
+    CheckpointWriter(const std::string &path, const transaction::timestamp_t checkpoint_timestamp)
+        : out_(std::make_unique<BufferedLogWriter>(path.c_str()))
+        , checkpoint_timestamp_(checkpoint_timestamp) {}
+
+    ~CheckpointWriter() {
+        // The file is only still open if writing the checkpoint failed, in which case it is discarded anyway
+        if (out_ != nullptr) {
+            try {
+                out_->Close();
+            } catch (const std::runtime_error &) {
+            }
+        }
+    }
+
+    /** @return the snapshot timestamp of the checkpoint */
+    transaction::timestamp_t CheckpointTimestamp() const {
+        return checkpoint_timestamp_;
+    }
+
+    /** Writes the header of the checkpoint file. Must be called before any record is written. */
+    void WriteHeader(const uint64_t first_log_segment) {
+        const CheckpointHeader header{CheckpointHeader::CHECKPOINT_MAGIC, checkpoint_timestamp_, first_log_segment};
+        WriteValue(&header, sizeof(CheckpointHeader));
+    }
+
+    /** Writes a redo record, and ends the current transaction if it is large enough. */
+    void WriteRecord(const LogRecord &record) {
+        LogRecordSerializer::Serialize(record, [this](const void *val, const uint32_t size) {
+            return WriteValue(val, size);
+        });
+        if (++num_records_in_txn_ == CHECKPOINT_TXN_NUM_RECORDS) {
+            WriteCommit();
+        }
+    }
+
+    /** Ends the current transaction, and persists and closes the checkpoint file. */
+    void Finish() {
+        WriteCommit();
+        out_->FlushBuffer();
+        out_->Persist();
+        out_->Close();
+        out_ = nullptr;
+    }
+
+private:
+    std::unique_ptr<BufferedLogWriter> out_;
+    const transaction::timestamp_t     checkpoint_timestamp_;
+    uint32_t                           num_records_in_txn_ = 0;
+
+    void WriteCommit() {
+        if (num_records_in_txn_ == 0) {
+            return;
+        }
+        // The oldest active transaction is the checkpoint transaction itself, so that recovery replays each group of
+        // records as soon as it reaches the commit record
+        alignas(8) byte buffer[sizeof(LogRecord) + sizeof(CommitRecord)];
+        const auto *record = CommitRecord::Initialize(buffer,
+                                                      checkpoint_timestamp_,
+                                                      checkpoint_timestamp_,
+                                                      nullptr,
+                                                      nullptr,
+                                                      checkpoint_timestamp_,
+                                                      false,
+                                                      nullptr,
+                                                      nullptr);
+        LogRecordSerializer::Serialize(*record, [this](const void *val, const uint32_t size) {
+            return WriteValue(val, size);
+        });
+        num_records_in_txn_ = 0;
+    }
+
+    uint32_t WriteValue(const void *val, const uint32_t size) {
+        uint32_t size_written = 0;
+        while (size_written < size) {
+            const byte *val_byte = reinterpret_cast<const byte *>(val) + size_written;
+            size_written += out_->BufferWrite(val_byte, size - size_written);
+            if (out_->IsBufferFull()) {
+                out_->FlushBuffer();
+            }
+        }
+        return size;
+    }
+};
+
+CheckpointManager::CheckpointManager(std::string                                             checkpoint_file_path,
+                                     common::ManagedPointer<catalog::Catalog>                catalog,
+                                     common::ManagedPointer<transaction::TransactionManager> txn_manager,
+                                     common::ManagedPointer<transaction::TimestampManager>   timestamp_manager,
+                                     common::ManagedPointer<LogManager>                      log_manager)
+    : checkpoint_file_path_(std::move(checkpoint_file_path))
+    , catalog_(catalog)
+    , txn_manager_(txn_manager)
+    , timestamp_manager_(timestamp_manager)
+    , log_manager_(log_manager) {
+    NOISEPAGE_ASSERT(log_manager_ != DISABLED, "Checkpoints are only meaningful with logging enabled");
+}
+
+transaction::timestamp_t CheckpointManager::TakeCheckpoint() {
+    std::lock_guard<std::mutex> guard(checkpoint_latch_);
+
+    // Step 1: Rotate the log. Records serialized from now on are in segments newer than the archived one.
+    const uint64_t archived_segment = log_manager_->RotateLogFile();
+    const auto     rotation_time = timestamp_manager_->CurrentTime();
+
+    // Step 2: Wait for every transaction that began before the rotation to finish. With logging enabled, a transaction
+    // is only removed from the timestamp manager once its logs are serialized.
+    while (timestamp_manager_->OldestTransactionStartTime() < rotation_time) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Step 3: Write the snapshot of a read-only transaction to a temporary file. Every transaction that commits after
+    // its snapshot began after the rotation, so the log segments after the archived one have all of their records.
+    auto *const txn = txn_manager_->BeginTransaction();
+    const auto  checkpoint_timestamp = txn->StartTime();
+    const auto  tmp_file_path = checkpoint_file_path_ + ".tmp";
+    // The writer appends to the file, so get rid of anything left behind by an earlier checkpoint that did not finish
+    std::remove(tmp_file_path.c_str());
+    try {
+        CheckpointWriter writer(tmp_file_path, checkpoint_timestamp);
+        writer.WriteHeader(archived_segment + 1);
+        WriteCheckpoint(txn, &writer);
+        writer.Finish();
+    } catch (const std::runtime_error &) {
+        // The transaction has to finish, or it would hold back the GC and every later checkpoint
+        txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+        std::remove(tmp_file_path.c_str());
+        throw;
+    }
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // Step 4: Atomically replace the previous checkpoint, which makes the archived segments obsolete. We keep the
+    // newest archived segment, so that segment ids keep increasing even if the system restarts. If any step fails,
+    // the previous checkpoint and every segment after it are left in place.
+    if (std::rename(tmp_file_path.c_str(), checkpoint_file_path_.c_str()) != 0) {
+        std::remove(tmp_file_path.c_str());
+        throw std::runtime_error("Failed to install checkpoint " + checkpoint_file_path_);
+    }
+    const auto num_removed = LogManager::RemoveLogSegmentsBefore(log_manager_->GetLogFilePath(), archived_segment);
+
+    last_checkpoint_timestamp_ = checkpoint_timestamp;
+    STORAGE_LOG_INFO("Checkpoint taken at timestamp {}, removed {} log segments",
+                     checkpoint_timestamp.UnderlyingValue(),
+                     num_removed);
+    return checkpoint_timestamp;
+}
+
+void CheckpointManager::StartCheckpointThread(const std::chrono::seconds checkpoint_interval) {
+    NOISEPAGE_ASSERT(!run_checkpoint_thread_, "Checkpoint thread should not already be running.");
+    checkpoint_interval_ = checkpoint_interval;
+    run_checkpoint_thread_ = true;
+    checkpoint_thread_ = std::thread([this] {
+        CheckpointThreadLoop();
+    });
+}
+
+void CheckpointManager::StopCheckpointThread() {
+    NOISEPAGE_ASSERT(run_checkpoint_thread_, "Checkpoint thread should already be running.");
+    {
+        std::unique_lock<std::mutex> lock(checkpoint_thread_latch_);
+        run_checkpoint_thread_ = false;
+    }
+    checkpoint_thread_cv_.notify_all();
+    checkpoint_thread_.join();
+}
+
+void CheckpointManager::CheckpointThreadLoop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(checkpoint_thread_latch_);
+            checkpoint_thread_cv_.wait_for(lock, checkpoint_interval_, [this] {
+                return !run_checkpoint_thread_;
+            });
+            if (!run_checkpoint_thread_) {
+                return;
+            }
+        }
+        try {
+            TakeCheckpoint();
+        } catch (const std::runtime_error &e) {
+            // A failed checkpoint only leaves more log to replay on recovery, so we try again at the next interval
+            STORAGE_LOG_ERROR("Failed to take a checkpoint: {}", e.what());
+        }
+    }
+}
+
+std::vector<std::vector<std::string>>
+CheckpointManager::LogFilesForCheckpoint(const CheckpointLogProvider &checkpoint, const std::string &log_file_path) {
+    return LogManager::LogStreamFilesForRecovery(log_file_path, checkpoint.GetFirstLogSegment());
+}
+
+void CheckpointManager::WriteCheckpoint(transaction::TransactionContext *const txn, CheckpointWriter *const writer) {
+    // Every database is checkpointed after its entry in pg_database, whose replay recreates the database catalog
+    const auto pg_database = common::ManagedPointer(catalog_->databases_);
+    const std::vector<catalog::col_oid_t> col_oids(catalog::postgres::PgDatabase::PG_DATABASE_ALL_COL_OIDS.cbegin(),
+                                                   catalog::postgres::PgDatabase::PG_DATABASE_ALL_COL_OIDS.cend());
+    const auto initializer = pg_database->InitializerForProjectedRow(col_oids);
+    auto       pr_map = pg_database->ProjectionMapForOids(col_oids);
+    auto      *buffer = common::AllocationUtil::AllocateAligned(RedoRecord::Size(initializer));
+
+    for (const auto &slot : *pg_database) {
+        auto *record = RedoRecord::Initialize(buffer,
+                                              writer->CheckpointTimestamp(),
+                                              catalog::INVALID_DATABASE_OID,
+                                              catalog::postgres::PgDatabase::DATABASE_TABLE_OID,
+                                              initializer);
+        auto *redo = record->GetUnderlyingRecordBodyAs<RedoRecord>();
+        if (!pg_database->Select(common::ManagedPointer(txn), slot, redo->Delta())) {
+            continue;
+        }
+        redo->SetTupleSlot(slot);
+        const auto db_oid = *catalog::postgres::PgDatabase::DATOID.Get(common::ManagedPointer(redo->Delta()), pr_map);
+        writer->WriteRecord(*record);
+        WriteDatabase(txn, writer, db_oid);
+    }
+
+    delete[] buffer;
+}
+
+void CheckpointManager::WriteDatabase(transaction::TransactionContext *const txn,
+                                      CheckpointWriter *const                writer,
+                                      const catalog::db_oid_t                db_oid) {
+    auto db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+    NOISEPAGE_ASSERT(db_catalog != nullptr, "Database in pg_database should have a catalog");
+
+    // Recovery recreates a table or index from its entries in pg_class, pg_attribute, and pg_index. These have
+    // hardcoded schemas on recovery, so they go first.
+    std::vector<ClassEntry> entries;
+    WriteClassTable(txn, writer, db_oid, db_catalog, &entries);
+    for (const auto table_oid : {catalog::postgres::PgAttribute::COLUMN_TABLE_OID,
+                                 catalog::postgres::PgIndex::INDEX_TABLE_OID}) {
+        WriteTable(txn,
+                   writer,
+                   db_oid,
+                   table_oid,
+                   db_catalog->GetTable(common::ManagedPointer(txn), table_oid),
+                   AllColumnOids(db_catalog->GetSchema(common::ManagedPointer(txn), table_oid)));
+    }
+
+    // Recreate the catalog tables and indexes, then fill in the remaining catalog tables
+    const auto pg_class
+        = db_catalog->GetTable(common::ManagedPointer(txn), catalog::postgres::PgClass::CLASS_TABLE_OID);
+    for (const auto &entry : entries) {
+        if (entry.class_oid_ < catalog::START_OID) {
+            WriteClassPointer(writer, db_oid, pg_class, entry);
+        }
+    }
+    for (const auto &entry : entries) {
+        const catalog::table_oid_t table_oid(entry.class_oid_);
+        if (entry.class_oid_ < catalog::START_OID && entry.is_table_
+            && table_oid != catalog::postgres::PgClass::CLASS_TABLE_OID
+            && table_oid != catalog::postgres::PgAttribute::COLUMN_TABLE_OID
+            && table_oid != catalog::postgres::PgIndex::INDEX_TABLE_OID) {
+            WriteTable(txn,
+                       writer,
+                       db_oid,
+                       table_oid,
+                       entry.object_,
+                       AllColumnOids(db_catalog->GetSchema(common::ManagedPointer(txn), table_oid)));
+        }
+    }
+
+    // Recreate the user tables and indexes, then fill in the user tables
+    for (const auto &entry : entries) {
+        if (entry.class_oid_ >= catalog::START_OID) {
+            WriteClassPointer(writer, db_oid, pg_class, entry);
+        }
+    }
+    for (const auto &entry : entries) {
+        const catalog::table_oid_t table_oid(entry.class_oid_);
+        if (entry.class_oid_ >= catalog::START_OID && entry.is_table_) {
+            WriteTable(txn,
+                       writer,
+                       db_oid,
+                       table_oid,
+                       entry.object_,
+                       AllColumnOids(db_catalog->GetSchema(common::ManagedPointer(txn), table_oid)));
+        }
+    }
+}
+
+void CheckpointManager::WriteTable(transaction::TransactionContext *const txn,
+                                   CheckpointWriter *const                writer,
+                                   const catalog::db_oid_t                db_oid,
+                                   const catalog::table_oid_t             table_oid,
+                                   const common::ManagedPointer<SqlTable> table,
+                                   const std::vector<catalog::col_oid_t> &col_oids) {
+    NOISEPAGE_ASSERT(table != nullptr, "Checkpointed table should exist");
+    const auto initializer = table->InitializerForProjectedRow(col_oids);
+    auto      *buffer = common::AllocationUtil::AllocateAligned(RedoRecord::Size(initializer));
+
+    for (const auto &slot : *table) {
+        auto *record = RedoRecord::Initialize(buffer, writer->CheckpointTimestamp(), db_oid, table_oid, initializer);
+        auto *redo = record->GetUnderlyingRecordBodyAs<RedoRecord>();
+        if (table->Select(common::ManagedPointer(txn), slot, redo->Delta())) {
+            redo->SetTupleSlot(slot);
+            writer->WriteRecord(*record);
+        }
+    }
+
+    delete[] buffer;
+}
+
+void CheckpointManager::WriteClassTable(transaction::TransactionContext *const                 txn,
+                                        CheckpointWriter *const                                writer,
+                                        const catalog::db_oid_t                                db_oid,
+                                        const common::ManagedPointer<catalog::DatabaseCatalog> db_catalog,
+                                        std::vector<ClassEntry> *const                         entries) {
+    using catalog::postgres::PgClass;
+    const auto pg_class = db_catalog->GetTable(common::ManagedPointer(txn), PgClass::CLASS_TABLE_OID);
+    const std::vector<catalog::col_oid_t> col_oids(PgClass::PG_CLASS_ALL_COL_OIDS.cbegin(),
+                                                   PgClass::PG_CLASS_ALL_COL_OIDS.cend());
+    const auto initializer = pg_class->InitializerForProjectedRow(col_oids);
+    auto       pr_map = pg_class->ProjectionMapForOids(col_oids);
+    auto      *buffer = common::AllocationUtil::AllocateAligned(RedoRecord::Size(initializer));
+
+    for (const auto &slot : *pg_class) {
+        auto *record = RedoRecord::Initialize(buffer,
+                                              writer->CheckpointTimestamp(),
+                                              db_oid,
+                                              PgClass::CLASS_TABLE_OID,
+                                              initializer);
+        auto *redo = record->GetUnderlyingRecordBodyAs<RedoRecord>();
+        auto  pr = common::ManagedPointer(redo->Delta());
+        if (!pg_class->Select(common::ManagedPointer(txn), slot, redo->Delta())) {
+            continue;
+        }
+        redo->SetTupleSlot(slot);
+
+        // Remember the tables and indexes, whose objects are recreated on recovery
+        const auto  kind = static_cast<PgClass::RelKind>(*PgClass::RELKIND.Get(pr, pr_map));
+        const auto *ptr = PgClass::REL_PTR.Get(pr, pr_map);
+        if (ptr != nullptr && *ptr != nullptr
+            && (kind == PgClass::RelKind::REGULAR_TABLE || kind == PgClass::RelKind::INDEX)) {
+            entries->push_back({slot,
+                                PgClass::RELOID.Get(pr, pr_map)->UnderlyingValue(),
+                                kind == PgClass::RelKind::REGULAR_TABLE,
+                                common::ManagedPointer(*ptr)});
+        }
+
+        // Pointers are only valid in this process, so we write the entry as it was originally inserted
+        PgClass::REL_SCHEMA.Set(pr, pr_map, nullptr);
+        PgClass::REL_PTR.SetNull(pr, pr_map);
+        writer->WriteRecord(*record);
+    }
+
+    delete[] buffer;
+}
+
+void CheckpointManager::WriteClassPointer(CheckpointWriter *const                writer,
+                                          const catalog::db_oid_t                db_oid,
+                                          const common::ManagedPointer<SqlTable> pg_class,
+                                          const ClassEntry                      &entry) {
+    using catalog::postgres::PgClass;
+    // The pointer written here is meaningless on recovery, which creates a new object when it replays the update
+    const auto initializer = pg_class->InitializerForProjectedRow({PgClass::REL_PTR.oid_});
+    auto      *buffer = common::AllocationUtil::AllocateAligned(RedoRecord::Size(initializer));
+    auto      *record
+        = RedoRecord::Initialize(buffer, writer->CheckpointTimestamp(), db_oid, PgClass::CLASS_TABLE_OID, initializer);
+    auto *redo = record->GetUnderlyingRecordBodyAs<RedoRecord>();
+    PgClass::REL_PTR.Set(common::ManagedPointer(redo->Delta()), 0, entry.object_.Get());
+    redo->SetTupleSlot(entry.slot_);
+    writer->WriteRecord(*record);
+    delete[] buffer;
+}
+
+} // namespace noisepage::storage
@@ -0,0 +1,139 @@
+#include "storage/recovery/disk_log_provider.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "storage/write_ahead_log/commit_watermark.h"
+
+namespace noisepage::storage {
+
+namespace {
+
+bool IsWatermarkRecord(const LogRecord *const record) {
+    if (record == nullptr || record->RecordType() != LogRecordType::COMMIT) {
+        return false;
+    }
+    return CommitWatermark::IsWatermarkRecord(*record->GetUnderlyingRecordBodyAs<CommitRecord>(), record->TxnBegin());
+}
+
+void FreeRecord(const std::pair<LogRecord *, std::vector<byte *>> &record) {
+    delete[] reinterpret_cast<byte *>(record.first);
+    for (auto *varlen_entry : record.second) {
+        delete[] varlen_entry;
+    }
+}
+
+} // namespace
+
+DiskLogProvider::DiskLogProvider(const std::vector<std::vector<std::string>> &log_stream_file_paths)
+    : DiskLogProvider(log_stream_file_paths.size() == 1 ? log_stream_file_paths[0] : std::vector<std::string>()) {
+    if (log_stream_file_paths.size() > 1) {
+        streams_.resize(log_stream_file_paths.size());
+        for (uint32_t i = 0; i < streams_.size(); i++) {
+            streams_[i].provider_ = std::make_unique<DiskLogProvider>(log_stream_file_paths[i]);
+        }
+    }
+}
+
+auto DiskLogProvider::GetNextRecord() -> std::pair<LogRecord *, std::vector<byte *>> {
+    if (streams_.empty()) {
+        auto record = AbstractLogProvider::GetNextRecord();
+        while (IsWatermarkRecord(record.first)) {
+            FreeRecord(record);
+            record = AbstractLogProvider::GetNextRecord();
+        }
+        return record;
+    }
+
+    while (true) {
+        if (curr_stream_ == nullptr) {
+            curr_stream_ = NextStream();
+            if (curr_stream_ == nullptr) {
+                return {nullptr, std::vector<byte *>()};
+            }
+        }
+        auto record = std::move(curr_stream_->records_.front());
+        curr_stream_->records_.pop_front();
+        if (curr_stream_->records_.empty()) {
+            curr_stream_ = nullptr;
+        }
+        if (!IsWatermarkRecord(record.first)) {
+            return record;
+        }
+        FreeRecord(record);
+    }
+}
+
+auto DiskLogProvider::NextStream() -> LogStream * {
+    LogStream *next = nullptr;
+    int64_t    next_key = 0;
+    int64_t    cutoff = std::numeric_limits<int64_t>::max();
+    for (auto &stream : streams_) {
+        if (stream.records_.empty() && !stream.exhausted_) {
+            // Read ahead up to the next commit or abort record, or up to the end of the stream. The stream's provider
+            // is read past its own GetNextRecord(), which would skip the watermark records.
+            while (true) {
+                auto record = stream.provider_->AbstractLogProvider::GetNextRecord();
+                if (record.first == nullptr) {
+                    stream.exhausted_ = true;
+                    break;
+                }
+                const auto type = record.first->RecordType();
+                if (type == LogRecordType::COMMIT) {
+                    const auto commit_time = static_cast<int64_t>(
+                        record.first->GetUnderlyingRecordBodyAs<CommitRecord>()->CommitTime().UnderlyingValue());
+                    stream.last_commit_ = std::max(stream.last_commit_, commit_time);
+                }
+                stream.records_.emplace_back(std::move(record));
+                if (type == LogRecordType::COMMIT || type == LogRecordType::ABORT) {
+                    break;
+                }
+            }
+        }
+        if (stream.exhausted_) {
+            cutoff = std::min(cutoff, stream.last_commit_);
+        }
+        if (stream.records_.empty()) {
+            continue;
+        }
+
+        // Streams are merged in the order of their next commit. An abort does not need to be ordered with respect to
+        // other transactions, so it goes right away. The records at the end of a stream without a commit or abort
+        // record belong to transactions that never finished, so they go last.
+        const auto *last = stream.records_.back().first;
+        int64_t     key = std::numeric_limits<int64_t>::max();
+        if (last->RecordType() == LogRecordType::COMMIT) {
+            key = static_cast<int64_t>(last->GetUnderlyingRecordBodyAs<CommitRecord>()->CommitTime().UnderlyingValue());
+        } else if (last->RecordType() == LogRecordType::ABORT) {
+            key = std::numeric_limits<int64_t>::min();
+        }
+        if (next == nullptr || key < next_key) {
+            next = &stream;
+            next_key = key;
+        }
+    }
+
+    // Commits after the last commit of a stream that ended may depend on commits that the stream lost
+    if (next != nullptr && next_key > cutoff) {
+        DropRemainingRecords();
+        return nullptr;
+    }
+    return next;
+}
+
+void DiskLogProvider::DropRemainingRecords() {
+    for (auto &stream : streams_) {
+        for (const auto &record : stream.records_) {
+            FreeRecord(record);
+        }
+        stream.records_.clear();
+        stream.exhausted_ = true;
+    }
+    curr_stream_ = nullptr;
+}
+
+} // namespace noisepage::storage
@@ -1,6 +1,7 @@
 #include "storage/recovery/recovery_manager.h"
 
 #include <algorithm>
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -103,6 +104,7 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
         if (log_record == nullptr) {
             break;
         }
+        max_recovered_timestamp_ = std::max(max_recovered_timestamp_, log_record->TxnBegin());
 
         switch (log_record->RecordType()) {
         case (LogRecordType::ABORT): {
@@ -120,12 +122,38 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
         case (LogRecordType::COMMIT): {
             NOISEPAGE_ASSERT(pair.second.empty(), "Commit records should not have any varlen pointers");
             auto *commit_record = log_record->GetUnderlyingRecordBodyAs<CommitRecord>();
+            max_recovered_timestamp_ = std::max(max_recovered_timestamp_, commit_record->CommitTime());
+
+            // Changes of transactions that committed before the checkpoint are already reflected in the checkpoint, so
+            // we discard them as if the transaction aborted
+            if (commit_record->CommitTime() < checkpoint_timestamp_) {
+                DeferRecordDeletes(log_record->TxnBegin(), true);
+                buffered_changes_map_.erase(log_record->TxnBegin());
+                deferred_action_manager_->RegisterDeferredAction([=] {
+                    delete[] reinterpret_cast<byte *>(log_record);
+                });
+                num_records++;
+                break;
+            }
 
             // We defer all transactions initially
             deferred_txns_.insert(log_record->TxnBegin());
-            // Process any deferred transactions that are safe to execute
-            std::tie(num_txns, num_records) = ProcessDeferredTransactions(commit_record->OldestActiveTxn());
-            recovered_txns_ += num_txns;
+            // Process any deferred transactions that are safe to execute. When replaying concurrently, we let them pile
+            // up first so that there are enough of them to keep the replay threads busy. This is only done when
+            // recovering from the log, as replicas have to apply transactions as soon as possible, and the transactions
+            // of a checkpoint share a start timestamp.
+            const auto oldest_active_txn = commit_record->OldestActiveTxn();
+            replay_upper_bound_ = std::max(replay_upper_bound_, oldest_active_txn);
+            if (replay_pool_ == nullptr || oldest_active_txn == transaction::INVALID_TXN_TIMESTAMP
+                || log_provider->GetType() != AbstractLogProvider::LogProviderType::DISK
+                || deferred_txns_.size() >= REPLAY_BATCH_SIZE_PER_THREAD * replay_pool_->NumWorkers()) {
+                const auto upper_bound = oldest_active_txn == transaction::INVALID_TXN_TIMESTAMP
+                                             ? transaction::INVALID_TXN_TIMESTAMP
+                                             : replay_upper_bound_;
+                std::tie(num_txns, num_records) = ProcessDeferredTransactions(upper_bound);
+                recovered_txns_ += num_txns;
+                replay_upper_bound_ = transaction::INVALID_TXN_TIMESTAMP;
+            }
             // Record the current commit txn
             num_records++;
 
@@ -145,6 +173,7 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
     }
     // Process all deferred txns
     ProcessDeferredTransactions(transaction::INVALID_TXN_TIMESTAMP);
+    replay_upper_bound_ = transaction::INVALID_TXN_TIMESTAMP;
     NOISEPAGE_ASSERT(deferred_txns_.empty(),
                      "We should have no unprocessed deferred transactions at the end of recovery");
 
@@ -156,22 +185,43 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
         }
         buffered_changes_map_.clear();
     }
+
+    // The timestamp manager starts over whenever the system starts, while the log is appended to. Transactions that
+    // begin from now on must be ordered after every recovered one, or a later recovery would replay them in the wrong
+    // order, or skip them as if the checkpoint covered them.
+    txn_manager_->AdvanceTimestampPast(max_recovered_timestamp_);
+}
+
+void RecoveryManager::RecoverFromCheckpoint(const common::ManagedPointer<CheckpointLogProvider> checkpoint_provider) {
+    NOISEPAGE_ASSERT(checkpoint_timestamp_ == transaction::INITIAL_TXN_TIMESTAMP, "Can only recover one checkpoint");
+    RecoverFromLogs(checkpoint_provider.CastTo<AbstractLogProvider>());
+    checkpoint_timestamp_ = checkpoint_provider->GetCheckpointTimestamp();
+    checkpoint_recovered_ = true;
+    STORAGE_LOG_INFO("Recovered checkpoint taken at timestamp {}", checkpoint_timestamp_.UnderlyingValue());
 }
 
 auto RecoveryManager::ProcessCommittedTransaction(noisepage::transaction::timestamp_t txn_id) -> uint32_t {
+    auto buffered_changes = std::move(buffered_changes_map_[txn_id]);
+    buffered_changes_map_.erase(txn_id);
+    const auto records_processed = ReplayCommittedTransaction(&buffered_changes);
+    FinishCommittedTransaction(txn_id);
+    return records_processed;
+}
+
+auto RecoveryManager::ReplayCommittedTransaction(BufferedChanges *const buffered_changes) -> uint32_t {
     auto records_processed = 0;
     // Begin a txn to replay changes with.
     auto *txn = txn_manager_->BeginTransaction();
 
     // Apply all buffered changes. They should all succeed. After applying we can safely delete the record
-    for (uint32_t idx = 0; idx < buffered_changes_map_[txn_id].size(); idx++) {
-        auto *buffered_record = buffered_changes_map_[txn_id][idx].first;
+    for (uint32_t idx = 0; idx < buffered_changes->size(); idx++) {
+        auto *buffered_record = (*buffered_changes)[idx].first;
         NOISEPAGE_ASSERT(buffered_record->RecordType() == LogRecordType::REDO
                              || buffered_record->RecordType() == LogRecordType::DELETE,
                          "Buffered record must be a redo or delete.");
 
         if (IsSpecialCaseCatalogRecord(buffered_record)) {
-            idx += ProcessSpecialCaseCatalogRecord(txn, &buffered_changes_map_[txn_id], idx);
+            idx += ProcessSpecialCaseCatalogRecord(txn, buffered_changes, idx);
         } else if (buffered_record->RecordType() == LogRecordType::REDO) {
             ReplayRedoRecord(txn, buffered_record);
         } else {
@@ -181,12 +231,48 @@ auto RecoveryManager::ProcessCommittedTransaction(noisepage::transaction::timest
     }
 
     // Defer deletes of the log records
-    DeferRecordDeletes(txn_id, false);
-    buffered_changes_map_.erase(txn_id);
+    DeferRecordDeletes(std::move(*buffered_changes), false);
 
     // Commit the txn
     txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    return records_processed;
+}
+
+auto RecoveryManager::ProcessCommittedTransactionBatch(std::vector<transaction::timestamp_t> *const batch)
+    -> uint32_t {
+    if (batch->empty()) {
+        return 0;
+    }
+    if (batch->size() == 1) {
+        const auto records_processed = ProcessCommittedTransaction(batch->front());
+        batch->clear();
+        return records_processed;
+    }
 
+    // Take the changes out of the map before handing them to the replay threads, which must not touch the map
+    std::vector<BufferedChanges> batch_changes;
+    batch_changes.reserve(batch->size());
+    for (const auto txn_id : *batch) {
+        batch_changes.emplace_back(std::move(buffered_changes_map_[txn_id]));
+        buffered_changes_map_.erase(txn_id);
+    }
+
+    std::atomic<uint32_t> records_processed{0};
+    for (auto &buffered_changes : batch_changes) {
+        replay_pool_->SubmitTask([this, &buffered_changes, &records_processed] {
+            records_processed += ReplayCommittedTransaction(&buffered_changes);
+        });
+    }
+    replay_pool_->WaitUntilAllFinished();
+
+    for (const auto txn_id : *batch) {
+        FinishCommittedTransaction(txn_id);
+    }
+    batch->clear();
+    return records_processed;
+}
+
+void RecoveryManager::FinishCommittedTransaction(const transaction::timestamp_t txn_id) {
     last_applied_txn_id_ = std::max(last_applied_txn_id_, txn_id);
     if (replication_manager_ != DISABLED) {
         // Replicas have to send back their list of deferred transactions that were processed, periodically.
@@ -197,13 +283,11 @@ auto RecoveryManager::ProcessCommittedTransaction(noisepage::transaction::timest
             replication_manager_->GetAsReplica()->NotifyPrimaryTransactionApplied(txn_id);
         }
     }
-
-    return records_processed;
 }
 
-void RecoveryManager::DeferRecordDeletes(noisepage::transaction::timestamp_t txn_id, bool delete_varlens) {
+void RecoveryManager::DeferRecordDeletes(BufferedChanges &&buffered_changes, const bool delete_varlens) {
     // Capture the changes by value except for changes which we can move
-    deferred_action_manager_->RegisterDeferredAction([=, buffered_changes{std::move(buffered_changes_map_[txn_id])}]() {
+    deferred_action_manager_->RegisterDeferredAction([=, buffered_changes{std::move(buffered_changes)}]() {
         for (auto &buffered_pair : buffered_changes) {
             delete[] reinterpret_cast<byte *>(buffered_pair.first);
             if (delete_varlens) {
@@ -225,9 +309,33 @@ auto RecoveryManager::ProcessDeferredTransactions(noisepage::transaction::timest
         = (upper_bound_ts == transaction::INVALID_TXN_TIMESTAMP) ? transaction::timestamp_t(INT64_MAX) : upper_bound_ts;
     auto upper_bound_it = deferred_txns_.upper_bound(upper_bound_ts);
 
-    for (auto it = deferred_txns_.begin(); it != upper_bound_it; it++) {
-        records_processed += ProcessCommittedTransaction(*it);
-        txns_processed++;
+    if (replay_pool_ == nullptr) {
+        for (auto it = deferred_txns_.begin(); it != upper_bound_it; it++) {
+            records_processed += ProcessCommittedTransaction(*it);
+            txns_processed++;
+        }
+    } else {
+        // Greedily grow a batch of non-conflicting transactions in serial order. A transaction that conflicts with the
+        // batch has to observe its changes, so the batch is replayed before the transaction starts the next one.
+        std::vector<transaction::timestamp_t> batch;
+        ReplayBatchFootprint                  footprint;
+        for (auto it = deferred_txns_.begin(); it != upper_bound_it; it++) {
+            const auto &buffered_changes = buffered_changes_map_[*it];
+            if (RequiresSerialReplay(buffered_changes)) {
+                records_processed += ProcessCommittedTransactionBatch(&batch);
+                footprint.Clear();
+                records_processed += ProcessCommittedTransaction(*it);
+            } else {
+                if (!footprint.TryAdd(*this, buffered_changes)) {
+                    records_processed += ProcessCommittedTransactionBatch(&batch);
+                    footprint.Clear();
+                    footprint.TryAdd(*this, buffered_changes);
+                }
+                batch.push_back(*it);
+            }
+            txns_processed++;
+        }
+        records_processed += ProcessCommittedTransactionBatch(&batch);
     }
 
     // If we actually processed some txns, remove them from the set
@@ -238,6 +346,54 @@ auto RecoveryManager::ProcessDeferredTransactions(noisepage::transaction::timest
     return {txns_processed, records_processed};
 }
 
+bool RecoveryManager::RequiresSerialReplay(const BufferedChanges &buffered_changes) {
+    return std::any_of(buffered_changes.cbegin(),
+                       buffered_changes.cend(),
+                       [](const BufferedChanges::value_type &buffered_change) {
+                           const auto *record = buffered_change.first;
+                           const auto  table_oid
+                               = record->RecordType() == LogRecordType::REDO
+                                     ? record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetTableOid()
+                                     : record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTableOid();
+                           return IsCatalogTable(table_oid);
+                       });
+}
+
+bool RecoveryManager::ReplayBatchFootprint::TryAdd(const RecoveryManager &recovery_manager,
+                                                   const BufferedChanges &buffered_changes) {
+    const auto table_key = [](const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid) {
+        return static_cast<uint64_t>(db_oid.UnderlyingValue()) << 32 | table_oid.UnderlyingValue();
+    };
+
+    // Check for conflicts before adding anything, so that a conflicting transaction leaves the batch unchanged
+    for (const auto &buffered_change : buffered_changes) {
+        const auto *record = buffered_change.first;
+        if (record->RecordType() == LogRecordType::REDO) {
+            const auto *redo_record = record->GetUnderlyingRecordBodyAs<RedoRecord>();
+            if (tuple_slots_.count(redo_record->GetTupleSlot()) > 0
+                || (recovery_manager.IsInsertRecord(redo_record)
+                    && deleted_tables_.count(table_key(redo_record->GetDatabaseOid(), redo_record->GetTableOid()))
+                           > 0)) {
+                return false;
+            }
+        } else if (tuple_slots_.count(record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTupleSlot()) > 0) {
+            return false;
+        }
+    }
+
+    for (const auto &buffered_change : buffered_changes) {
+        const auto *record = buffered_change.first;
+        if (record->RecordType() == LogRecordType::REDO) {
+            tuple_slots_.insert(record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetTupleSlot());
+        } else {
+            const auto *delete_record = record->GetUnderlyingRecordBodyAs<DeleteRecord>();
+            tuple_slots_.insert(delete_record->GetTupleSlot());
+            deleted_tables_.insert(table_key(delete_record->GetDatabaseOid(), delete_record->GetTableOid()));
+        }
+    }
+    return true;
+}
+
 void RecoveryManager::ReplayRedoRecord(transaction::TransactionContext *txn, LogRecord *record) {
     auto *redo_record = record->GetUnderlyingRecordBodyAs<RedoRecord>();
     auto  sql_table_ptr = GetSqlTable(txn, redo_record->GetDatabaseOid(), redo_record->GetTableOid());
@@ -263,9 +419,9 @@ void RecoveryManager::ReplayRedoRecord(transaction::TransactionContext *txn, Log
         NOISEPAGE_ASSERT(staged_record->GetTupleSlot() == new_tuple_slot,
                          "Insert should update redo record with new tuple slot");
         // Create a mapping of the old to new tuple. The new tuple slot should be used for future updates and deletes.
-        tuple_slot_map_[old_tuple_slot] = new_tuple_slot;
+        SetTupleSlotMapping(old_tuple_slot, new_tuple_slot);
     } else {
-        auto new_tuple_slot = tuple_slot_map_[redo_record->GetTupleSlot()];
+        auto new_tuple_slot = GetTupleSlotMapping(redo_record->GetTupleSlot());
         redo_record->SetTupleSlot(new_tuple_slot);
         // Stage the write. This way the recovery operation is logged if logging is enabled
         auto staged_record = txn->StageRecoveryWrite(record);
@@ -280,7 +436,9 @@ void RecoveryManager::ReplayDeleteRecord(transaction::TransactionContext *txn, L
     auto *delete_record = record->GetUnderlyingRecordBodyAs<DeleteRecord>();
     // Get tuple slot
     auto        new_tuple_slot = GetTupleSlotMapping(delete_record->GetTupleSlot());
-    auto        db_catalog_ptr = GetDatabaseCatalog(txn, delete_record->GetDatabaseOid());
+    auto        db_catalog_ptr = GetDatabaseCatalog(txn,
+                                             delete_record->GetDatabaseOid(),
+                                             IsCatalogTable(delete_record->GetTableOid()));
     auto        sql_table_ptr = db_catalog_ptr->GetTable(common::ManagedPointer(txn), delete_record->GetTableOid());
     const auto &schema = GetTableSchema(txn, db_catalog_ptr, delete_record->GetTableOid());
 
@@ -310,7 +468,7 @@ void RecoveryManager::ReplayDeleteRecord(transaction::TransactionContext *txn, L
                          pr,
                          false /* delete */);
     // We can delete the TupleSlot from the map
-    tuple_slot_map_.erase(delete_record->GetTupleSlot());
+    EraseTupleSlotMapping(delete_record->GetTupleSlot());
     delete[] buffer;
 }
 
@@ -321,7 +479,7 @@ void RecoveryManager::UpdateIndexesOnTable(transaction::TransactionContext
                                            const TupleSlot                          &tuple_slot,
                                            ProjectedRow                             *table_pr,
                                            const bool                                insert) {
-    auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid);
+    auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid, IsCatalogTable(table_oid));
 
     // Stores index objects and schemas
     std::vector<std::pair<common::ManagedPointer<index::Index>, const catalog::IndexSchema &>> index_objects;
@@ -971,7 +1129,7 @@ auto RecoveryManager::GetSqlTable(transaction::TransactionContext *txn,
         return common::ManagedPointer(catalog_->databases_);
     }
 
-    auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid);
+    auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid, IsCatalogTable(table_oid));
 
     common::ManagedPointer<storage::SqlTable> table_ptr = nullptr;
 
@@ -6,6 +6,7 @@
 
 #include "catalog/schema.h"
 #include "common/macros.h"
+#include "storage/arrow_serializer.h"
 #include "storage/storage_util.h"
 
 namespace noisepage::storage {
@@ -50,6 +51,15 @@ auto SqlTable::ColIdsForOids(const std::vector<catalog::col_oid_t> &col_oids) co
     return col_ids;
 }
 
+auto SqlTable::ExportArrowStream(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                 const std::vector<catalog::col_oid_t>                        &col_oids,
+                                 const std::vector<execution::sql::SqlTypeId>                 &col_types,
+                                 const std::vector<std::string>                               &col_names,
+                                 ArrowStreamWriter *const writer) const -> uint64_t {
+    ArrowSerializer serializer(*table_.data_table_);
+    return serializer.ExportStream(txn, ColIdsForOids(col_oids), col_types, col_names, writer);
+}
+
 auto SqlTable::ProjectionMapForOids(const std::vector<catalog::col_oid_t> &col_oids) -> ProjectionMap {
     // Resolve OIDs to storage IDs
     auto col_ids = ColIdsForOids(col_oids);
@@ -70,6 +80,39 @@ auto SqlTable::ProjectionMapForOids(const std::vector<catalog::col_oid_t> &col_o
     return projection_map;
 }
 
+auto SqlTable::InsertBlock(const common::ManagedPointer<transaction::TransactionContext> txn,
+                           const catalog::db_oid_t                                       db_oid,
+                           const catalog::table_oid_t                                    table_oid,
+                           RawBlock *const                                               block) const -> uint32_t {
+    // Read the number of loaded tuples while the block is still private. Once it is inserted, concurrent inserts can
+    // allocate its remaining slots, and their tuples must not be logged as part of this transaction.
+    const uint32_t num_tuples = block->GetInsertHead();
+    table_.data_table_->InsertBlock(txn, block);
+
+    // Log the tuples in batches as large as a single redo buffer segment can hold. The size of a record grows with the
+    // number of tuples it holds, so we can binary search for the largest batch that still fits.
+    const std::vector<col_id_t> col_ids = table_.layout_.AllColumns();
+    uint32_t                    lo = 1;
+    uint32_t                    hi = num_tuples;
+    while (lo < hi) {
+        const uint32_t mid = lo + (hi - lo + 1) / 2;
+        if (BlockInsertRecord::Size(ProjectedColumnsInitializer(table_.layout_, col_ids, mid))
+            <= common::Constants::BUFFER_SEGMENT_SIZE) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    const ProjectedColumnsInitializer initializer(table_.layout_, col_ids, lo);
+    NOISEPAGE_ASSERT(BlockInsertRecord::Size(initializer) <= common::Constants::BUFFER_SEGMENT_SIZE,
+                     "A block insert record of a single tuple does not fit into a redo buffer segment");
+    for (uint32_t offset = 0; offset < num_tuples;) {
+        BlockInsertRecord *const record = txn->StageBlockInsert(db_oid, table_oid, initializer);
+        offset = table_.data_table_->CopyLoadedTuples(block, offset, num_tuples, record->Tuples());
+    }
+    return num_tuples;
+}
+
 void SqlTable::Reset() {
     table_.data_table_->Reset();
 }
@@ -0,0 +1,644 @@
+#include "storage/write_ahead_log/async_log_writer.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if __linux__
+#include <linux/io_uring.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable> // NOLINT
+#include <cstring>
+#include <memory>
+#include <mutex> // NOLINT
+#include <queue>
+#include <string>
+#include <thread> // NOLINT
+#include <utility>
+#include <vector>
+
+#include "common/posix_io_wrappers.h"
+#include "loggers/storage_logger.h"
+
+#if defined(__linux__) && defined(__NR_io_uring_setup) && defined(IORING_FEAT_RW_CUR_POS)
+#define NOISEPAGE_HAS_IO_URING 1
+#endif
+
+namespace noisepage::storage {
+
+namespace {
+// Marks the tags of syncs, the tags of writes are the ids of their buffers
+constexpr uint64_t SYNC_TAG = 1ULL << 63U;
+// Maximum number of threads the thread pool backend uses
+constexpr uint32_t MAX_IO_THREADS = 8;
+constexpr uint64_t LOG_BLOCK_SIZE = common::Constants::LOG_BLOCK_SIZE;
+
+uint64_t AlignDown(const uint64_t offset) {
+    return offset - offset % LOG_BLOCK_SIZE;
+}
+
+uint64_t AlignUp(const uint64_t offset) {
+    return AlignDown(offset + LOG_BLOCK_SIZE - 1);
+}
+} // namespace
+
+/** A completed write or sync */
+struct AsyncIoCompletion {
+    /** tag that the request was submitted with */
+    uint64_t tag_;
+    /** number of bytes written, 0 for a sync, or a negated errno if the request failed */
+    int64_t result_;
+};
+
+/**
+ * Submits writes and syncs of a file, and reports their completion. Only used by the thread that owns the
+ * AsyncLogWriter.
+ */
+class AsyncIoBackend {
+public:
+    virtual ~AsyncIoBackend() = default;
+
+    /** Queues a write of the given bytes to the given offset of the file */
+    virtual void PrepareWrite(uint64_t tag, int fd, const void *data, uint32_t size, uint64_t offset) = 0;
+
+    /** Queues an fdatasync of the file */
+    virtual void PrepareSync(uint64_t tag, int fd) = 0;
+
+    /** Submits all queued requests */
+    virtual void Submit() = 0;
+
+    /** Appends the requests that completed since the last call, waiting for at least one if wait is set */
+    virtual void Reap(bool wait, std::vector<AsyncIoCompletion> *completions) = 0;
+};
+
+#ifdef NOISEPAGE_HAS_IO_URING
+/**
+ * Submits requests through an io_uring. Talks to the kernel through the raw system calls, so that it does not need
+ * liburing.
+ */
+class IoUringBackend final : public AsyncIoBackend {
+public:
+    /**
+     * Sets up a ring with room for the given number of requests
+     * @return the backend, or nullptr if io_uring is not available, e.g. because the kernel is older than 5.6 or a
+     * seccomp profile blocks it
+     */
+    static std::unique_ptr<IoUringBackend> Create(const uint32_t entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        const auto ring_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (ring_fd < 0) {
+            return nullptr;
+        }
+        std::unique_ptr<IoUringBackend> backend(new IoUringBackend(ring_fd));
+        // IORING_OP_WRITE came with the same kernel version as this feature flag
+        if ((params.features & IORING_FEAT_RW_CUR_POS) == 0 || !backend->MapRings(params)) {
+            return nullptr;
+        }
+        return backend;
+    }
+
+    ~IoUringBackend() override {
+        if (sqes_ != nullptr) {
+            munmap(sqes_, sqes_size_);
+        }
+        if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+            munmap(cq_ring_, cq_ring_size_);
+        }
+        if (sq_ring_ != nullptr) {
+            munmap(sq_ring_, sq_ring_size_);
+        }
+        close(ring_fd_);
+    }
+
+    void PrepareWrite(const uint64_t tag,
+                      const int      fd,
+                      const void    *data,
+                      const uint32_t size,
+                      const uint64_t offset) override {
+        auto *sqe = NextSqe();
+        sqe->opcode = IORING_OP_WRITE;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<uint64_t>(data);
+        sqe->len = size;
+        sqe->off = offset;
+        sqe->user_data = tag;
+        PublishSqe();
+    }
+
+    void PrepareSync(const uint64_t tag, const int fd) override {
+        auto *sqe = NextSqe();
+        sqe->opcode = IORING_OP_FSYNC;
+        sqe->fd = fd;
+        sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+        sqe->user_data = tag;
+        PublishSqe();
+    }
+
+    void Submit() override {
+        while (to_submit_ > 0) {
+            const auto ret = Enter(to_submit_, 0, 0);
+            if (ret < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                    continue;
+                }
+                throw std::runtime_error("io_uring_enter failed with errno " + std::to_string(errno));
+            }
+            to_submit_ -= static_cast<uint32_t>(ret);
+        }
+    }
+
+    void Reap(const bool wait, std::vector<AsyncIoCompletion> *const completions) override {
+        uint32_t head = *cq_head_;
+        uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        while (wait && head == tail) {
+            if (Enter(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                throw std::runtime_error("io_uring_enter failed with errno " + std::to_string(errno));
+            }
+            tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        }
+        for (; head != tail; head++) {
+            const auto &cqe = cqes_[head & cq_mask_];
+            completions->push_back({cqe.user_data, cqe.res});
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    }
+
+private:
+    explicit IoUringBackend(const int ring_fd)
+        : ring_fd_(ring_fd) {}
+
+    // Maps the submission and completion rings, returns false if that fails
+    bool MapRings(const io_uring_params &params) {
+        sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+        }
+        sq_ring_ = Map(sq_ring_size_, IORING_OFF_SQ_RING);
+        if (sq_ring_ == nullptr) {
+            return false;
+        }
+        cq_ring_ = single_mmap ? sq_ring_ : Map(cq_ring_size_, IORING_OFF_CQ_RING);
+        if (cq_ring_ == nullptr) {
+            return false;
+        }
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe *>(Map(sqes_size_, IORING_OFF_SQES));
+        if (sqes_ == nullptr) {
+            return false;
+        }
+
+        auto *sq = static_cast<char *>(sq_ring_);
+        sq_tail_ = reinterpret_cast<uint32_t *>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<uint32_t *>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<uint32_t *>(sq + params.sq_off.array);
+        auto *cq = static_cast<char *>(cq_ring_);
+        cq_head_ = reinterpret_cast<uint32_t *>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<uint32_t *>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<uint32_t *>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    void *Map(const size_t size, const off_t offset) {
+        void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, offset);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    }
+
+    int Enter(const uint32_t to_submit, const uint32_t min_complete, const uint32_t flags) {
+        return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete, flags, nullptr, 0));
+    }
+
+    // The caller never has more requests in flight than the ring has entries, so there is always a free one
+    io_uring_sqe *NextSqe() {
+        const uint32_t index = *sq_tail_ & sq_mask_;
+        auto          *sqe = &sqes_[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sq_array_[index] = index;
+        return sqe;
+    }
+
+    void PublishSqe() {
+        __atomic_store_n(sq_tail_, *sq_tail_ + 1, __ATOMIC_RELEASE);
+        to_submit_++;
+    }
+
+    const int     ring_fd_;
+    void         *sq_ring_ = nullptr;
+    size_t        sq_ring_size_ = 0;
+    void         *cq_ring_ = nullptr;
+    size_t        cq_ring_size_ = 0;
+    io_uring_sqe *sqes_ = nullptr;
+    size_t        sqes_size_ = 0;
+    uint32_t     *sq_tail_ = nullptr;
+    uint32_t      sq_mask_ = 0;
+    uint32_t     *sq_array_ = nullptr;
+    uint32_t     *cq_head_ = nullptr;
+    uint32_t     *cq_tail_ = nullptr;
+    uint32_t      cq_mask_ = 0;
+    io_uring_cqe *cqes_ = nullptr;
+    // Number of requests published to the submission ring but not yet submitted
+    uint32_t to_submit_ = 0;
+};
+#endif
+
+/**
+ * Hands requests to a pool of threads that carry them out with pwrite and fdatasync. Used where io_uring is not
+ * available.
+ */
+class ThreadPoolBackend final : public AsyncIoBackend {
+public:
+    /** @param num_threads number of threads carrying out requests */
+    explicit ThreadPoolBackend(const uint32_t num_threads) {
+        for (uint32_t i = 0; i < num_threads; i++) {
+            threads_.emplace_back([this] {
+                Work();
+            });
+        }
+    }
+
+    ~ThreadPoolBackend() override {
+        {
+            std::lock_guard<std::mutex> lock(latch_);
+            shutdown_ = true;
+        }
+        requests_cv_.notify_all();
+        for (auto &thread : threads_) {
+            thread.join();
+        }
+    }
+
+    void PrepareWrite(const uint64_t tag,
+                      const int      fd,
+                      const void    *data,
+                      const uint32_t size,
+                      const uint64_t offset) override {
+        Enqueue({tag, fd, data, size, offset, false});
+    }
+
+    void PrepareSync(const uint64_t tag, const int fd) override {
+        Enqueue({tag, fd, nullptr, 0, 0, true});
+    }
+
+    void Submit() override {}
+
+    void Reap(const bool wait, std::vector<AsyncIoCompletion> *const completions) override {
+        std::unique_lock<std::mutex> lock(latch_);
+        if (wait) {
+            completions_cv_.wait(lock, [&] {
+                return !completions_.empty();
+            });
+        }
+        completions->insert(completions->end(), completions_.begin(), completions_.end());
+        completions_.clear();
+    }
+
+private:
+    struct Request {
+        uint64_t    tag_;
+        int         fd_;
+        const void *data_;
+        uint32_t    size_;
+        uint64_t    offset_;
+        bool        sync_;
+    };
+
+    void Enqueue(const Request &request) {
+        {
+            std::lock_guard<std::mutex> lock(latch_);
+            requests_.push(request);
+        }
+        requests_cv_.notify_one();
+    }
+
+    void Work() {
+        std::unique_lock<std::mutex> lock(latch_);
+        while (true) {
+            requests_cv_.wait(lock, [&] {
+                return shutdown_ || !requests_.empty();
+            });
+            if (requests_.empty()) {
+                return;
+            }
+            const auto request = requests_.front();
+            requests_.pop();
+            lock.unlock();
+            const int64_t result = request.sync_ ? Sync(request.fd_) : Write(request);
+            lock.lock();
+            completions_.push_back({request.tag_, result});
+            completions_cv_.notify_one();
+        }
+    }
+
+    static int64_t Write(const Request &request) {
+        ssize_t ret;
+        do {
+            ret = pwrite(request.fd_, request.data_, request.size_, static_cast<off_t>(request.offset_));
+        } while (ret == -1 && errno == EINTR);
+        return ret == -1 ? -errno : ret;
+    }
+
+    static int64_t Sync(const int fd) {
+#if __APPLE__
+        const int ret = fsync(fd);
+#else
+        const int ret = fdatasync(fd);
+#endif
+        return ret == -1 ? -errno : 0;
+    }
+
+    std::vector<std::thread>       threads_;
+    std::mutex                     latch_;
+    std::condition_variable        requests_cv_;
+    std::condition_variable        completions_cv_;
+    std::queue<Request>            requests_;
+    std::vector<AsyncIoCompletion> completions_;
+    bool                           shutdown_ = false;
+};
+
+AsyncLogWriter::AsyncLogWriter(const std::string &log_file_path, const uint32_t io_depth)
+    : io_depth_(std::max(io_depth, 1U)) {
+#ifdef NOISEPAGE_HAS_IO_URING
+    // Room for a write and a sync per unit of io depth
+    backend_ = IoUringBackend::Create(2 * io_depth_);
+#endif
+    uses_io_uring_ = backend_ != nullptr;
+    if (!uses_io_uring_) {
+        STORAGE_LOG_INFO("io_uring is not available, writing the log through a thread pool");
+        backend_ = std::make_unique<ThreadPoolBackend>(std::min(io_depth_, MAX_IO_THREADS));
+    }
+
+    // Direct I/O needs buffers aligned to a block. Every buffer has room for a block of padding.
+    const uint64_t buffer_capacity = WRITE_BUFFER_SIZE + LOG_BLOCK_SIZE;
+    buffer_memory_ = std::make_unique<char[]>(io_depth_ * buffer_capacity + LOG_BLOCK_SIZE);
+    auto *memory = reinterpret_cast<char *>(AlignUp(reinterpret_cast<uintptr_t>(buffer_memory_.get())));
+    buffers_.resize(io_depth_);
+    for (uint32_t i = 0; i < io_depth_; i++) {
+        buffers_[i].data_ = memory + i * buffer_capacity;
+        free_buffers_.push_back(i);
+    }
+    groups_.emplace_back();
+
+    Open(log_file_path);
+}
+
+AsyncLogWriter::~AsyncLogWriter() {
+    if (fd_ != -1) {
+        Close();
+    }
+}
+
+void AsyncLogWriter::Open(const std::string &log_file_path) {
+    NOISEPAGE_ASSERT(fd_ == -1 && staged_ == nullptr, "Writer is already open");
+#ifdef O_DIRECT
+    do {
+        fd_ = open(log_file_path.c_str(), O_RDWR | O_CREAT | O_DIRECT, S_IRUSR | S_IWUSR);
+    } while (fd_ == -1 && errno == EINTR);
+    if (fd_ == -1 && errno == EINVAL) {
+        // The file system does not support direct I/O (e.g. tmpfs), so writes go through the page cache instead
+        STORAGE_LOG_WARN("Direct I/O is not supported for log file {}", log_file_path);
+    }
+#endif
+    if (fd_ == -1) {
+        fd_ = PosixIoWrappers::Open(log_file_path.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+    }
+
+    struct stat file_stat;
+    if (fstat(fd_, &file_stat) == -1) {
+        throw std::runtime_error("fstat failed with errno " + std::to_string(errno));
+    }
+    const auto file_size = static_cast<uint64_t>(file_stat.st_size);
+    next_offset_ = AlignDown(file_size);
+    preallocated_end_ = 0;
+    can_preallocate_ = true;
+
+    // The last block of the file is partially filled if the file was written by a BufferedLogWriter. The data in it is
+    // staged again, so that appended data follows it without a gap.
+    const auto tail_size = static_cast<uint32_t>(file_size - next_offset_);
+    if (tail_size > 0) {
+        staged_ = AcquireBuffer();
+        ssize_t ret;
+        do {
+            ret = pread(fd_, staged_->data_, LOG_BLOCK_SIZE, static_cast<off_t>(next_offset_));
+        } while (ret == -1 && errno == EINTR);
+        if (ret < static_cast<ssize_t>(tail_size)) {
+            throw std::runtime_error("Failed to read the end of log file " + log_file_path);
+        }
+        staged_->size_ = tail_size;
+    }
+}
+
+void AsyncLogWriter::Close() {
+    NOISEPAGE_ASSERT(fd_ != -1, "Writer is already closed");
+    Flush({});
+    while (HasPendingFlushes()) {
+        Reap(true);
+    }
+#if __linux__
+    // Give back the space preallocated past the end of the log
+    if (preallocated_end_ > next_offset_) {
+        fallocate(fd_,
+                  FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                  static_cast<off_t>(next_offset_),
+                  static_cast<off_t>(preallocated_end_ - next_offset_));
+    }
+#endif
+    PosixIoWrappers::Close(fd_);
+    fd_ = -1;
+}
+
+void AsyncLogWriter::Reopen(const std::string &log_file_path) {
+    Open(log_file_path);
+}
+
+void AsyncLogWriter::Append(const void *const data, const uint32_t size) {
+    const auto *bytes = static_cast<const char *>(data);
+    uint32_t    appended = 0;
+    while (appended < size) {
+        if (staged_ == nullptr) {
+            staged_ = AcquireBuffer();
+        }
+        const uint32_t chunk = std::min(size - appended, WRITE_BUFFER_SIZE - staged_->size_);
+        std::memcpy(staged_->data_ + staged_->size_, bytes + appended, chunk);
+        staged_->size_ += chunk;
+        appended += chunk;
+        if (staged_->size_ == WRITE_BUFFER_SIZE) {
+            SubmitStaged(false);
+        }
+    }
+}
+
+void AsyncLogWriter::Flush(std::vector<CommitCallback> &&callbacks) {
+    if (staged_ == nullptr && !groups_.back().has_writes_ && callbacks.empty()) {
+        return;
+    }
+    if (staged_ != nullptr) {
+        SubmitStaged(true);
+    }
+    const uint64_t group_id = first_group_id_ + groups_.size() - 1;
+    auto          &group = groups_.back();
+    if (group.callbacks_.empty()) {
+        group.callbacks_ = std::move(callbacks);
+    } else {
+        group.callbacks_.insert(group.callbacks_.end(), callbacks.begin(), callbacks.end());
+    }
+    group.flushed_ = true;
+    group.flush_time_ = std::chrono::high_resolution_clock::now();
+    groups_.emplace_back();
+    MaybeSubmitSync(group_id);
+
+    // Bound the number of flushed groups in flight, which also bounds the number of syncs in flight
+    while (groups_.size() > io_depth_ + 1) {
+        Reap(true);
+    }
+}
+
+uint64_t AsyncLogWriter::ProcessCompletions(const bool wait) {
+    Reap(false);
+    while (wait && HasPendingFlushes()) {
+        Reap(true);
+    }
+    return std::exchange(callbacks_invoked_, 0);
+}
+
+auto AsyncLogWriter::AcquireBuffer() -> WriteBuffer * {
+    while (free_buffers_.empty()) {
+        Reap(true);
+    }
+    auto *buffer = &buffers_[free_buffers_.back()];
+    free_buffers_.pop_back();
+    buffer->size_ = 0;
+    buffer->written_ = 0;
+    buffer->offset_ = next_offset_;
+    return buffer;
+}
+
+void AsyncLogWriter::SubmitStaged(const bool pad) {
+    auto *buffer = staged_;
+    staged_ = nullptr;
+    if (pad && buffer->size_ % LOG_BLOCK_SIZE != 0) {
+        // Pad the last block with zeros, at least as many as a frame marker takes, so that a reader sees a marker of 0
+        // and skips to the next block
+        auto padded_size = static_cast<uint32_t>(AlignUp(buffer->size_));
+        if (padded_size - buffer->size_ < sizeof(uint32_t)) {
+            padded_size += LOG_BLOCK_SIZE;
+        }
+        std::memset(buffer->data_ + buffer->size_, 0, padded_size - buffer->size_);
+        buffer->size_ = padded_size;
+    }
+    NOISEPAGE_ASSERT(buffer->size_ % LOG_BLOCK_SIZE == 0, "Writes must cover whole blocks");
+
+    next_offset_ = buffer->offset_ + buffer->size_;
+    Preallocate(next_offset_);
+    buffer->group_id_ = first_group_id_ + groups_.size() - 1;
+    groups_.back().writes_in_flight_++;
+    groups_.back().has_writes_ = true;
+    SubmitWrite(static_cast<uint32_t>(buffer - buffers_.data()));
+}
+
+void AsyncLogWriter::SubmitWrite(const uint32_t buffer_id) {
+    const auto &buffer = buffers_[buffer_id];
+    backend_->PrepareWrite(buffer_id,
+                           fd_,
+                           buffer.data_ + buffer.written_,
+                           buffer.size_ - buffer.written_,
+                           buffer.offset_ + buffer.written_);
+    backend_->Submit();
+    in_flight_++;
+}
+
+void AsyncLogWriter::MaybeSubmitSync(const uint64_t group_id) {
+    auto &group = groups_[group_id - first_group_id_];
+    if (!group.flushed_ || group.sync_submitted_ || group.writes_in_flight_ > 0) {
+        return;
+    }
+    group.sync_submitted_ = true;
+    if (!group.has_writes_) {
+        // Nothing to persist, the callbacks only have to wait for the groups before
+        group.persisted_ = true;
+        return;
+    }
+    backend_->PrepareSync(SYNC_TAG | group_id, fd_);
+    backend_->Submit();
+    in_flight_++;
+}
+
+void AsyncLogWriter::Reap(const bool wait) {
+    std::vector<AsyncIoCompletion> completions;
+    backend_->Reap(wait && in_flight_ > 0, &completions);
+    in_flight_ -= static_cast<uint32_t>(completions.size());
+    for (const auto &completion : completions) {
+        const bool is_sync = (completion.tag_ & SYNC_TAG) != 0;
+        if (completion.result_ < 0) {
+            throw std::runtime_error(std::string(is_sync ? "fdatasync" : "write") + " of the log failed with errno "
+                                     + std::to_string(-completion.result_));
+        }
+        if (is_sync) {
+            auto &group = groups_[(completion.tag_ & ~SYNC_TAG) - first_group_id_];
+            group.persisted_ = true;
+            persist_latencies_.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::high_resolution_clock::now() - group.flush_time_));
+            continue;
+        }
+
+        const auto buffer_id = static_cast<uint32_t>(completion.tag_);
+        auto      &buffer = buffers_[buffer_id];
+        buffer.written_ += static_cast<uint32_t>(completion.result_);
+        if (buffer.written_ < buffer.size_) {
+            // Short write, submit the rest
+            if (completion.result_ == 0) {
+                throw std::runtime_error("write of the log made no progress");
+            }
+            SubmitWrite(buffer_id);
+            continue;
+        }
+        free_buffers_.push_back(buffer_id);
+        groups_[buffer.group_id_ - first_group_id_].writes_in_flight_--;
+        MaybeSubmitSync(buffer.group_id_);
+    }
+
+    // Invoke the callbacks of persisted groups, in the order of the groups
+    while (groups_.size() > 1 && groups_.front().persisted_) {
+        callbacks_invoked_ += groups_.front().callbacks_.size();
+        if (persisted_callback_handler_) {
+            persisted_callback_handler_(&groups_.front().callbacks_);
+        } else {
+            for (const auto &callback : groups_.front().callbacks_) {
+                callback.fn_(callback.arg_);
+            }
+        }
+        groups_.pop_front();
+        first_group_id_++;
+    }
+}
+
+void AsyncLogWriter::Preallocate(const uint64_t end) {
+#if __linux__
+    if (!can_preallocate_ || end <= preallocated_end_) {
+        return;
+    }
+    // The file size is kept, so that it still tells where the log ends
+    const uint64_t new_end = (end / PREALLOCATION_SIZE + 1) * PREALLOCATION_SIZE;
+    if (fallocate(fd_,
+                  FALLOC_FL_KEEP_SIZE,
+                  static_cast<off_t>(preallocated_end_),
+                  static_cast<off_t>(new_end - preallocated_end_))
+        == -1) {
+        if (errno != EOPNOTSUPP) {
+            throw std::runtime_error("fallocate failed with errno " + std::to_string(errno));
+        }
+        can_preallocate_ = false;
+        return;
+    }
+    preallocated_end_ = new_end;
+#endif
+}
+
+} // namespace noisepage::storage
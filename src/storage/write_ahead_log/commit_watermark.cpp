@@ -0,0 +1,52 @@
+#include "storage/write_ahead_log/commit_watermark.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace noisepage::storage {
+
+void CommitWatermark::Persisted(const uint32_t stream_id, std::vector<CommitCallback> *const callbacks) {
+    std::vector<CommitCallback> released;
+    {
+        common::SpinLatch::ScopedSpinLatch guard(&latch_);
+        for (const auto &callback : *callbacks) {
+            if (!callback.is_from_read_only_) {
+                persisted_[stream_id] = std::max(persisted_[stream_id], callback.commit_time_);
+            }
+            const auto key = callback.is_from_read_only_ ? callback.txn_start_time_ : callback.commit_time_;
+            held_.push({key, callback});
+            max_held_key_ = std::max(max_held_key_, key);
+        }
+
+        const auto watermark = *std::min_element(persisted_.cbegin(), persisted_.cend());
+        while (!held_.empty() && held_.top().key_ <= watermark) {
+            released.push_back(held_.top().callback_);
+            held_.pop();
+        }
+
+        // Wake up the streams that hold back the oldest callback left, so that they log a watermark record
+        if (!held_.empty()) {
+            for (uint32_t i = 0; i < persisted_.size(); i++) {
+                if (persisted_[i] < held_.top().key_ && wakeups_[i] != nullptr) {
+                    wakeups_[i]->notify_one();
+                }
+            }
+        }
+    }
+    callbacks->clear();
+
+    for (const auto &callback : released) {
+        callback.fn_(callback.arg_);
+    }
+}
+
+auto CommitWatermark::LagTarget(const uint32_t stream_id) -> transaction::timestamp_t {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    if (held_.empty() || persisted_[stream_id] >= held_.top().key_) {
+        return transaction::INVALID_TXN_TIMESTAMP;
+    }
+    // Catch up to every callback held so far at once
+    return max_held_key_;
+}
+
+} // namespace noisepage::storage
@@ -1,10 +1,17 @@
 #include "storage/write_ahead_log/disk_log_consumer_task.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <string>
 #include <thread> // NOLINT
+#include <utility>
 
 #include "common/scoped_timer.h"
 #include "common/thread_context.h"
 #include "metrics/metrics_store.h"
+#include "storage/write_ahead_log/log_record_serializer.h"
+#include "transaction/transaction_util.h"
 
 namespace noisepage::storage {
 
@@ -33,9 +40,13 @@ void DiskLogConsumerTask::WriteBuffersToLogFile() {
         if (logs.first != nullptr) {
             // Need the nullptr check because read-only txns don't serialize any buffers, but generate callbacks to be
             // invoked
-            current_data_written_ += logs.first->FlushBuffer();
+            current_data_written_ += async_writer_ != nullptr ? logs.first->FlushBuffer(async_writer_.get())
+                                                               : logs.first->FlushBuffer();
         }
         commit_callbacks_.insert(commit_callbacks_.end(), logs.second.begin(), logs.second.end());
+        if (group_commit_ != nullptr) {
+            group_commit_->OnCommitsArrived(logs.second.size(), GroupCommitController::Clock::now());
+        }
         // Enqueue the flushed buffer to the empty buffer queue if all serializers are done with it.
         if (logs.first != nullptr && logs.first->MarkSerialized()) {
             // nullptr check for the same reason as above
@@ -44,7 +55,14 @@ void DiskLogConsumerTask::WriteBuffersToLogFile() {
     }
 }
 
-auto DiskLogConsumerTask::PersistLogFile() -> uint64_t {
+auto DiskLogConsumerTask::PersistLogFile(const bool wait) -> uint64_t {
+    if (async_writer_ != nullptr) {
+        // The writer invokes the callbacks once everything written so far is persisted
+        async_writer_->Flush(std::move(commit_callbacks_));
+        commit_callbacks_.clear();
+        return ProcessAsyncCompletions(wait);
+    }
+
     if (current_data_written_ > 0) {
         // Force the buffers to be written to disk. Because all buffers log to the same file, it suffices to call
         // persist on any buffer.
@@ -52,13 +70,92 @@ auto DiskLogConsumerTask::PersistLogFile() -> uint64_t {
     }
     const auto num_buffers = commit_callbacks_.size();
     // Execute the callbacks for the transactions that have been persisted
-    for (auto &callback : commit_callbacks_) {
+    InvokeCommitCallbacks(&commit_callbacks_);
+    return num_buffers;
+}
+
+void DiskLogConsumerTask::InvokeCommitCallbacks(std::vector<CommitCallback> *const callbacks) {
+    if (commit_watermark_ != nullptr) {
+        commit_watermark_->Persisted(stream_id_, callbacks);
+        return;
+    }
+    for (auto &callback : *callbacks) {
         callback.fn_(callback.arg_);
     }
-    commit_callbacks_.clear();
+    callbacks->clear();
+}
+
+auto DiskLogConsumerTask::WriteWatermarkRecord() -> bool {
+    const transaction::timestamp_t target = WatermarkTarget();
+    if (target == transaction::INVALID_TXN_TIMESTAMP) {
+        return false;
+    }
+    logged_watermark_ = target;
+
+    // A commit record whose start and commit timestamps are the same, which no transaction can write
+    alignas(LogRecord) byte record_buffer[CommitRecord::Size()];
+    const LogRecord        *record = CommitRecord::Initialize(record_buffer,
+                                                       target,
+                                                       target,
+                                                       transaction::TransactionUtil::EmptyCallback,
+                                                       nullptr,
+                                                       target,
+                                                       false,
+                                                       nullptr,
+                                                       nullptr);
+    LogRecordSerializer::Serialize(*record, [this](const void *val, const uint32_t size) {
+        return watermark_buffer_->BufferWrite(val, size);
+    });
+    if (compress_records_) {
+        watermark_buffer_->EncodeFrame();
+    }
+    current_data_written_ += async_writer_ != nullptr ? watermark_buffer_->FlushBuffer(async_writer_.get())
+                                                      : watermark_buffer_->FlushBuffer();
+    commit_callbacks_.push_back(
+        CommitCallback{transaction::TransactionUtil::EmptyCallback, nullptr, target, false, target});
+    return true;
+}
+
+auto DiskLogConsumerTask::ProcessAsyncCompletions(const bool wait) -> uint64_t {
+    const auto num_buffers = async_writer_->ProcessCompletions(wait);
+    async_writer_->TakePersistLatencies(&persist_latencies_);
+    if (group_commit_ != nullptr) {
+        for (const auto latency : persist_latencies_) {
+            group_commit_->RecordPersistLatency(latency);
+        }
+    }
+    persist_latencies_.clear();
     return num_buffers;
 }
 
+void DiskLogConsumerTask::RotateLogFile() {
+    // Every buffer holds its own fd on the active log file, so all of them have to be closed before the file is moved
+    for (auto &buffer : *buffers_) {
+        buffer.Close();
+    }
+    if (watermark_buffer_ != nullptr) {
+        watermark_buffer_->Close();
+    }
+    if (async_writer_ != nullptr) {
+        async_writer_->Close();
+    }
+    if (std::rename(log_file_path_.c_str(), rotate_segment_path_.c_str()) != 0) {
+        throw std::runtime_error("Failed to archive log file " + log_file_path_ + " with errno "
+                                 + std::to_string(errno));
+    }
+    for (auto &buffer : *buffers_) {
+        buffer.Reopen(log_file_path_.c_str());
+    }
+    if (watermark_buffer_ != nullptr) {
+        watermark_buffer_->Reopen(log_file_path_.c_str());
+    }
+    if (async_writer_ != nullptr) {
+        async_writer_->Reopen(log_file_path_);
+    }
+    STORAGE_LOG_INFO("Archived log file to {}", rotate_segment_path_);
+    rotate_segment_path_.clear();
+}
+
 void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
     // input for this operating unit
     uint64_t num_bytes = 0, num_buffers = 0;
@@ -95,9 +192,15 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
             // 2) There is a filled buffer to write to the disk
             // 3) LogManager has shut down the task
             // 4) Our persist interval timed out
-
-            bool signaled = disk_log_writer_thread_cv_.wait_for(lock, curr_sleep, [&] {
-                return force_flush_ || !filled_buffer_queue_->Empty() || !run_task_;
+            // 5) The group commit controller wants the pending commits persisted
+            // 6) The stream holds back the commit callbacks of other streams
+            auto wait_time = curr_sleep;
+            if (group_commit_ != nullptr && group_commit_->HasPendingCommits()) {
+                wait_time = std::min(wait_time,
+                                     group_commit_->TimeUntilPersist(GroupCommitController::Clock::now()));
+            }
+            bool signaled = disk_log_writer_thread_cv_.wait_for(lock, wait_time, [&] {
+                return force_flush_ || !filled_buffer_queue_->Empty() || !run_task_ || IsLagging();
             });
             next_sleep = signaled ? persist_interval_ : curr_sleep * 2;
             next_sleep = std::min(next_sleep, max_sleep);
@@ -106,19 +209,53 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
         // Flush all the buffers to the log file
         WriteBuffersToLogFile();
 
+        if (async_writer_ != nullptr) {
+            // Invoke the callbacks of the persists that completed in the meantime. Nothing signals us when a persist
+            // completes, so we keep checking at the persist interval while any are in flight.
+            num_buffers += ProcessAsyncCompletions(false);
+            if (async_writer_->HasPendingFlushes()) {
+                next_sleep = persist_interval_;
+            }
+        }
+
         // We persist the log file if the following conditions are met
-        // 1) The persist interval amount of time has passed since the last persist
+        // 1) The persist interval amount of time has passed since the last persist, or the group commit controller
+        //    wants the pending commits persisted if there are any
         // 2) We have written more data since the last persist than the threshold
         // 3) We are signaled to persist
         // 4) We are shutting down this task
-        bool timeout = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now()
-                                                                             - last_persist)
-                       > curr_sleep;
+        // 5) The stream holds back the commit callbacks of other streams
+        const auto now = std::chrono::high_resolution_clock::now();
+        bool       timeout = std::chrono::duration_cast<std::chrono::microseconds>(now - last_persist) > curr_sleep;
+        if (group_commit_ != nullptr && group_commit_->HasPendingCommits()) {
+            timeout = group_commit_->ShouldPersist(now);
+        }
 
-        if (timeout || current_data_written_ > persist_threshold_ || force_flush_ || !run_task_) {
+        if (timeout || current_data_written_ > persist_threshold_ || force_flush_ || !run_task_ || IsLagging()) {
             std::unique_lock<std::mutex> lock(persist_lock_);
-            num_buffers = PersistLogFile();
+            const bool rotate = !rotate_segment_path_.empty();
+            if (rotate) {
+                // Buffers may have been handed over since we last wrote to the log file. The serializer is paused
+                // during a rotation, so draining the queue now ensures that the archived file ends on a record
+                // boundary.
+                WriteBuffersToLogFile();
+            }
+            if (group_commit_ != nullptr) {
+                group_commit_->OnBatchClosed(GroupCommitController::Clock::now());
+            }
+            WriteWatermarkRecord();
+            // A persist that was asked for has to be done before we signal that it is
+            const auto persist_start = std::chrono::high_resolution_clock::now();
+            num_buffers += PersistLogFile(force_flush_ || rotate || !run_task_);
+            if (group_commit_ != nullptr && async_writer_ == nullptr && current_data_written_ > 0) {
+                // The AsyncLogWriter reports the latencies of its persists as they complete
+                group_commit_->RecordPersistLatency(std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::high_resolution_clock::now() - persist_start));
+            }
             num_bytes = current_data_written_;
+            if (rotate) {
+                RotateLogFile();
+            }
             // Reset meta data
             last_persist = std::chrono::high_resolution_clock::now();
             current_data_written_ = 0;
@@ -133,10 +270,21 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
                 // Stop the resource tracker for this operating unit
                 common::thread_context.resource_tracker_.Stop();
                 auto &resource_metrics = common::thread_context.resource_tracker_.GetMetrics();
+                // With group commit, the wait budget takes the place of the persist interval
+                const auto interval = group_commit_ != nullptr ? group_commit_->WaitBudget() : persist_interval_;
                 common::thread_context.metrics_store_->RecordConsumerData(num_bytes,
                                                                           num_buffers,
-                                                                          persist_interval_.count(),
+                                                                          interval.count(),
                                                                           resource_metrics);
+                if (group_commit_ != nullptr) {
+                    common::thread_context.metrics_store_->RecordGroupCommitData(
+                        group_commit_->LastBatchSize(),
+                        group_commit_->TargetBatchSize(),
+                        group_commit_->WaitBudget().count(),
+                        group_commit_->PersistLatencyP99().count(),
+                        static_cast<uint64_t>(group_commit_->ArrivalRate()),
+                        resource_metrics);
+                }
             }
             num_bytes = num_buffers = 0;
             // Update whether to collect metrics only if we did work (starting a new event) so as not to count each loop
@@ -149,5 +297,11 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
     // Be extra sure we processed everything
     WriteBuffersToLogFile();
     PersistLogFile();
+    if (async_writer_ != nullptr) {
+        async_writer_->Close();
+    }
+    if (watermark_buffer_ != nullptr) {
+        watermark_buffer_->Close();
+    }
 }
 } // namespace noisepage::storage
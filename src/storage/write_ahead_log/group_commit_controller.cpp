@@ -0,0 +1,76 @@
+#include "storage/write_ahead_log/group_commit_controller.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace noisepage::storage {
+
+GroupCommitController::GroupCommitController(const std::chrono::microseconds target_latency)
+    : target_latency_(target_latency)
+    , wait_budget_(target_latency) {}
+
+void GroupCommitController::OnCommitsArrived(const uint64_t num_commits, const Clock::time_point now) {
+    if (num_commits == 0) {
+        return;
+    }
+    if (pending_commits_ == 0) {
+        oldest_pending_ = now;
+    }
+    pending_commits_ += num_commits;
+}
+
+bool GroupCommitController::ShouldPersist(const Clock::time_point now) const {
+    return pending_commits_ > 0 && (pending_commits_ >= target_batch_size_ || now - oldest_pending_ >= wait_budget_);
+}
+
+std::chrono::microseconds GroupCommitController::TimeUntilPersist(const Clock::time_point now) const {
+    if (pending_commits_ == 0) {
+        return std::chrono::microseconds::max();
+    }
+    if (ShouldPersist(now)) {
+        return std::chrono::microseconds(0);
+    }
+    return wait_budget_ - std::chrono::duration_cast<std::chrono::microseconds>(now - oldest_pending_);
+}
+
+void GroupCommitController::OnBatchClosed(const Clock::time_point now) {
+    if (any_batch_closed_ && now > last_batch_closed_) {
+        // Everything in the batch arrived since the previous batch was closed
+        const double elapsed_s = std::chrono::duration<double>(now - last_batch_closed_).count();
+        const double batch_rate = static_cast<double>(pending_commits_) / elapsed_s;
+        arrival_rate_ = ARRIVAL_RATE_WEIGHT * batch_rate + (1.0 - ARRIVAL_RATE_WEIGHT) * arrival_rate_;
+    }
+    last_batch_size_ = pending_commits_;
+    last_batch_closed_ = now;
+    any_batch_closed_ = true;
+    pending_commits_ = 0;
+    UpdateTargets();
+}
+
+void GroupCommitController::RecordPersistLatency(const std::chrono::microseconds latency) {
+    latency_samples_[next_latency_sample_] = static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0));
+    next_latency_sample_ = (next_latency_sample_ + 1) % NUM_LATENCY_SAMPLES;
+    num_latency_samples_ = std::min(num_latency_samples_ + 1, NUM_LATENCY_SAMPLES);
+
+    std::array<uint64_t, NUM_LATENCY_SAMPLES> samples = latency_samples_;
+    const auto                                end = samples.begin() + num_latency_samples_;
+    uint64_t                                  sum = 0;
+    for (auto it = samples.begin(); it != end; ++it) {
+        sum += *it;
+    }
+    // Rank of the 99th percentile, rounded up so that a few samples yield their maximum
+    const auto rank = static_cast<uint32_t>(std::ceil(0.99 * num_latency_samples_)) - 1;
+    std::nth_element(samples.begin(), samples.begin() + rank, end);
+    persist_latency_p99_ = std::chrono::microseconds(samples[rank]);
+    persist_latency_mean_ = std::chrono::microseconds(sum / num_latency_samples_);
+    UpdateTargets();
+}
+
+void GroupCommitController::UpdateTargets() {
+    wait_budget_ = std::max(target_latency_ - persist_latency_p99_, std::chrono::microseconds(0));
+    // Commits expected to arrive while a persist is in progress
+    const double expected = arrival_rate_ * std::chrono::duration<double>(persist_latency_mean_).count();
+    target_batch_size_ = std::max<uint64_t>(static_cast<uint64_t>(expected), 1);
+}
+
+} // namespace noisepage::storage
@@ -0,0 +1,214 @@
+#include "storage/write_ahead_log/log_compression.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace noisepage::storage {
+
+namespace {
+
+// Shortest copy that is encoded, the copy lengths in a sequence are stored relative to it
+constexpr uint32_t MIN_MATCH = 4;
+// The last bytes of a block are always literals, and no copy starts within the last MATCH_LIMIT bytes
+constexpr uint32_t LAST_LITERALS = 5;
+constexpr uint32_t MATCH_LIMIT = 12;
+// Farthest back that a copy can reach
+constexpr uint32_t MAX_OFFSET = 65535;
+// Run lengths of up to RUN_MASK - 1 fit in the sequence token, longer ones are continued in extra bytes
+constexpr uint32_t RUN_MASK = 15;
+
+constexpr uint32_t HASH_BITS = 12;
+constexpr uint32_t NO_POSITION = UINT32_MAX;
+
+uint32_t Read32(const uint8_t *p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t Hash(const uint32_t sequence) {
+    return (sequence * 2654435761U) >> (32 - HASH_BITS);
+}
+
+// Writes the part of a run length that does not fit in the token
+void WriteLength(uint32_t length, uint8_t *out, uint32_t *op) {
+    while (length >= 255) {
+        out[(*op)++] = 255;
+        length -= 255;
+    }
+    out[(*op)++] = static_cast<uint8_t>(length);
+}
+
+// Upper bound on the bytes that WriteLength() writes for the given run length
+uint32_t LengthBytes(const uint32_t length) {
+    return length >= RUN_MASK ? (length - RUN_MASK) / 255 + 1 : 0;
+}
+
+// Writes a sequence of the given literals, followed by a copy unless match_length is 0. Returns false if the sequence
+// does not fit in the capacity.
+bool WriteSequence(const uint8_t *literals,
+                   const uint32_t literal_length,
+                   const uint32_t offset,
+                   const uint32_t match_length,
+                   uint8_t       *out,
+                   uint32_t      *op,
+                   const uint32_t capacity) {
+    const uint32_t match_code = match_length > 0 ? match_length - MIN_MATCH : 0;
+    const uint64_t needed = 1 + LengthBytes(literal_length) + literal_length
+                            + (match_length > 0 ? 2 + LengthBytes(match_code) : 0);
+    if (*op + needed > capacity) {
+        return false;
+    }
+    out[(*op)++] = static_cast<uint8_t>((std::min(literal_length, RUN_MASK) << 4) | std::min(match_code, RUN_MASK));
+    if (literal_length >= RUN_MASK) {
+        WriteLength(literal_length - RUN_MASK, out, op);
+    }
+    std::memcpy(out + *op, literals, literal_length);
+    *op += literal_length;
+    if (match_length > 0) {
+        out[(*op)++] = static_cast<uint8_t>(offset & 0xFF);
+        out[(*op)++] = static_cast<uint8_t>(offset >> 8);
+        if (match_code >= RUN_MASK) {
+            WriteLength(match_code - RUN_MASK, out, op);
+        }
+    }
+    return true;
+}
+
+// Reads the rest of a run length whose token part is RUN_MASK. Returns false if the input ends first.
+bool ReadLength(const uint8_t *in, const uint32_t size, uint32_t *ip, uint32_t *length) {
+    uint8_t byte;
+    do {
+        if (*ip >= size) {
+            return false;
+        }
+        byte = in[(*ip)++];
+        *length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+} // namespace
+
+uint32_t LogCompression::Compress(const char *src, const uint32_t src_size, char *dst, const uint32_t dst_capacity) {
+    const auto *const in = reinterpret_cast<const uint8_t *>(src);
+    auto *const       out = reinterpret_cast<uint8_t *>(dst);
+    uint32_t          op = 0;
+    // Start of the literals that were not written yet
+    uint32_t anchor = 0;
+
+    if (src_size > MATCH_LIMIT) {
+        std::array<uint32_t, 1U << HASH_BITS> table;
+        table.fill(NO_POSITION);
+        const uint32_t match_limit = src_size - MATCH_LIMIT;
+        const uint32_t end_limit = src_size - LAST_LITERALS;
+
+        uint32_t ip = 0;
+        while (ip < match_limit) {
+            const uint32_t sequence = Read32(in + ip);
+            const uint32_t hash = Hash(sequence);
+            const uint32_t candidate = table[hash];
+            table[hash] = ip;
+            if (candidate == NO_POSITION || ip - candidate > MAX_OFFSET || Read32(in + candidate) != sequence) {
+                ip++;
+                continue;
+            }
+
+            uint32_t match_length = MIN_MATCH;
+            while (ip + match_length < end_limit && in[candidate + match_length] == in[ip + match_length]) {
+                match_length++;
+            }
+            if (!WriteSequence(in + anchor, ip - anchor, ip - candidate, match_length, out, &op, dst_capacity)) {
+                return 0;
+            }
+            ip += match_length;
+            anchor = ip;
+            // Let later data copy from right before where the match ended
+            if (ip - 2 < match_limit) {
+                table[Hash(Read32(in + ip - 2))] = ip - 2;
+            }
+        }
+    }
+
+    if (!WriteSequence(in + anchor, src_size - anchor, 0, 0, out, &op, dst_capacity)) {
+        return 0;
+    }
+    return op;
+}
+
+bool LogCompression::Decompress(const char *src, const uint32_t src_size, char *dst, const uint32_t dst_size) {
+    const auto *const in = reinterpret_cast<const uint8_t *>(src);
+    auto *const       out = reinterpret_cast<uint8_t *>(dst);
+    uint32_t          ip = 0, op = 0;
+
+    while (ip < src_size) {
+        const uint8_t token = in[ip++];
+
+        uint32_t literal_length = token >> 4;
+        if (literal_length == RUN_MASK && !ReadLength(in, src_size, &ip, &literal_length)) {
+            return false;
+        }
+        if (literal_length > src_size - ip || literal_length > dst_size - op) {
+            return false;
+        }
+        std::memcpy(out + op, in + ip, literal_length);
+        ip += literal_length;
+        op += literal_length;
+        if (ip == src_size) {
+            // The last sequence has no copy
+            break;
+        }
+
+        if (src_size - ip < 2) {
+            return false;
+        }
+        const uint32_t offset = in[ip] | (static_cast<uint32_t>(in[ip + 1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > op) {
+            return false;
+        }
+        uint32_t match_length = token & RUN_MASK;
+        if (match_length == RUN_MASK && !ReadLength(in, src_size, &ip, &match_length)) {
+            return false;
+        }
+        match_length += MIN_MATCH;
+        if (match_length > dst_size - op) {
+            return false;
+        }
+        // The copy may overlap its own output, so copy byte by byte
+        for (uint32_t i = 0; i < match_length; i++) {
+            out[op + i] = out[op - offset + i];
+        }
+        op += match_length;
+    }
+    return op == dst_size;
+}
+
+uint32_t LogCompression::EncodeFrame(const char *src, const uint32_t size, const bool compress, char *frame) {
+    LogFrameHeader header;
+    header.raw_size_ = size;
+    char *const payload = frame + sizeof(LogFrameHeader);
+    // Compressed contents are only kept if they are smaller, so that equal sizes mean stored uncompressed
+    header.stored_size_ = compress && size > 0 ? Compress(src, size, payload, size - 1) : 0;
+    if (header.stored_size_ == 0 && size > 0) {
+        std::memcpy(payload, src, size);
+        header.stored_size_ = size;
+    }
+    std::memcpy(frame, &header, sizeof(LogFrameHeader));
+    return static_cast<uint32_t>(sizeof(LogFrameHeader)) + header.stored_size_;
+}
+
+void LogCompression::DecodeFrame(const LogFrameHeader &header, const char *payload, char *dst) {
+    if (header.marker_ != LogFrameHeader::MARKER || header.stored_size_ > header.raw_size_) {
+        throw std::runtime_error("Malformed log frame header");
+    }
+    if (header.stored_size_ == header.raw_size_) {
+        std::memcpy(dst, payload, header.raw_size_);
+    } else if (!Decompress(payload, header.stored_size_, dst, header.raw_size_)) {
+        throw std::runtime_error("Malformed compressed log frame");
+    }
+}
+
+} // namespace noisepage::storage
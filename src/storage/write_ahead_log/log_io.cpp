@@ -1,9 +1,95 @@
 #include "storage/write_ahead_log/log_io.h"
 
 #include <algorithm>
+#include <cstring>
+
+#include "storage/write_ahead_log/async_log_writer.h"
+
 namespace noisepage::storage {
 
+auto BufferedLogWriter::FlushBuffer(AsyncLogWriter *const writer) -> uint64_t {
+    // The writer pads the log at every flush, which may split a record. Only frames tell a reader where padding is.
+    if (frame_size_ == 0 && buffer_size_ > 0) {
+        frame_size_ = LogCompression::EncodeFrame(buffer_, buffer_size_, false, frame_);
+    }
+    const uint64_t size = frame_size_;
+    writer->Append(frame_, frame_size_);
+    buffer_size_ = 0;
+    frame_size_ = 0;
+    return size;
+}
+
 auto BufferedLogReader::Read(void *dest, uint32_t size) -> bool {
+    auto *out = reinterpret_cast<char *>(dest);
+    while (size > 0) {
+        if (frame_head_ < frame_size_) {
+            const auto read_size = std::min(size, frame_size_ - frame_head_);
+            std::memcpy(out, frame_contents_ + frame_head_, read_size);
+            frame_head_ += read_size;
+            out += read_size;
+            size -= read_size;
+        } else if (framed_) {
+            NextFrame();
+        } else {
+            return ReadRaw(out, size);
+        }
+    }
+    return true;
+}
+
+void BufferedLogReader::BeginFrame() {
+    NOISEPAGE_ASSERT(frame_head_ == frame_size_, "A frame cannot start within another one");
+    framed_ = true;
+    ReadFrame();
+}
+
+void BufferedLogReader::ReadFrame() {
+    frame_head_ = frame_size_ = 0;
+    LogFrameHeader header;
+    if (!ReadRaw(&header.raw_size_, sizeof(header.raw_size_))
+        || !ReadRaw(&header.stored_size_, sizeof(header.stored_size_))) {
+        // A frame torn at the end of the log was never persisted, so the log ends before it
+        framed_ = false;
+        return;
+    }
+    if (header.raw_size_ > common::Constants::LOG_BUFFER_SIZE || header.stored_size_ > header.raw_size_) {
+        throw std::runtime_error("Malformed log frame header");
+    }
+    // A stored frame is read right into place
+    char *const payload = header.stored_size_ == header.raw_size_ ? frame_contents_ : frame_payload_;
+    if (!ReadRaw(payload, header.stored_size_)) {
+        framed_ = false;
+        return;
+    }
+    if (payload == frame_payload_) {
+        LogCompression::DecodeFrame(header, payload, frame_contents_);
+    }
+    frame_head_ = 0;
+    frame_size_ = header.raw_size_;
+}
+
+void BufferedLogReader::NextFrame() {
+    frame_head_ = frame_size_ = 0;
+    uint32_t marker;
+    while (ReadRaw(&marker, sizeof(marker))) {
+        if (marker == 0) {
+            SkipToBlockBoundary();
+        } else if (marker == LogFrameHeader::MARKER) {
+            ReadFrame();
+            return;
+        } else {
+            // The log continues without frames, so the bytes just read are its next bytes
+            framed_ = false;
+            std::memcpy(frame_contents_, &marker, sizeof(marker));
+            frame_size_ = sizeof(marker);
+            return;
+        }
+    }
+    // The log ended. A torn marker at its end is dropped.
+    framed_ = false;
+}
+
+auto BufferedLogReader::ReadRaw(void *dest, uint32_t size) -> bool {
     if (read_head_ + size <= filled_size_) {
         // bytes to read are already buffered.
         ReadFromBuffer(dest, size);
@@ -12,7 +98,7 @@ auto BufferedLogReader::Read(void *dest, uint32_t size) -> bool {
     // Not enough left in the buffer.
     uint32_t bytes_read = 0;
     while (bytes_read < size) {
-        if (!HasMore()) {
+        if (!HasMoreRaw()) {
             return false;
         }
         uint32_t read_size = std::min(size - bytes_read, filled_size_ - read_head_);
@@ -25,11 +111,27 @@ auto BufferedLogReader::Read(void *dest, uint32_t size) -> bool {
     return true;
 }
 
+void BufferedLogReader::SkipToBlockBoundary() {
+    const auto offset = buffer_offset_ + read_head_;
+    auto       padding = static_cast<uint32_t>((common::Constants::LOG_BLOCK_SIZE
+                                          - offset % common::Constants::LOG_BLOCK_SIZE)
+                                         % common::Constants::LOG_BLOCK_SIZE);
+    while (padding > 0 && HasMoreRaw()) {
+        if (read_head_ == filled_size_) {
+            RefillBuffer();
+        }
+        const auto skipped = std::min(padding, filled_size_ - read_head_);
+        read_head_ += skipped;
+        padding -= skipped;
+    }
+}
+
 void BufferedLogReader::RefillBuffer() {
     NOISEPAGE_ASSERT(read_head_ == filled_size_, "Refilling a buffer that is not fully read results in loss of data");
     if (in_ == -1) {
         throw std::runtime_error("No more bytes left in the log file");
     }
+    buffer_offset_ += filled_size_;
     read_head_ = 0;
     filled_size_ = PosixIoWrappers::ReadFully(in_, buffer_, common::Constants::LOG_BUFFER_SIZE);
     if (filled_size_ < common::Constants::LOG_BUFFER_SIZE) {
@@ -1,5 +1,13 @@
 #include "storage/write_ahead_log/log_manager.h"
 
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "common/dedicated_thread_registry.h"
 #include "storage/write_ahead_log/disk_log_consumer_task.h"
 #include "storage/write_ahead_log/log_serializer_task.h"
@@ -9,47 +17,98 @@ namespace noisepage::storage {
 
 void LogManager::Start() {
     NOISEPAGE_ASSERT(!run_log_manager_, "Can't call Start on already started LogManager");
-    // Initialize buffers for logging
-    for (size_t i = 0; i < num_buffers_; i++) {
-        buffers_.emplace_back(log_file_path_.c_str());
-    }
-    for (size_t i = 0; i < num_buffers_; i++) {
-        empty_buffer_queue_->Enqueue(&buffers_[i]);
+    for (uint32_t stream_id = 0; stream_id < num_streams_; stream_id++) {
+        auto &stream = streams_.emplace_back(std::make_unique<LogStream>(StreamFilePath(log_file_path_, stream_id)));
+        if (stream_id == 0) {
+            stream->empty_buffer_queue_ = empty_buffer_queue_;
+        } else {
+            stream->own_empty_buffer_queue_ = std::make_unique<common::ConcurrentBlockingQueue<BufferedLogWriter *>>();
+            stream->empty_buffer_queue_ = common::ManagedPointer(stream->own_empty_buffer_queue_);
+        }
+
+        // Initialize buffers for logging
+        for (size_t i = 0; i < num_buffers_; i++) {
+            stream->buffers_.emplace_back(stream->log_file_path_.c_str());
+        }
+        for (auto &buffer : stream->buffers_) {
+            stream->empty_buffer_queue_->Enqueue(&buffer);
+        }
     }
 
     run_log_manager_ = true;
 
-    // Register DiskLogConsumerTask
-    disk_log_writer_task_ = thread_registry_->RegisterDedicatedThread<DiskLogConsumerTask>(this /* requester */,
-                                                                                           persist_interval_,
-                                                                                           persist_threshold_,
-                                                                                           &buffers_,
-                                                                                           empty_buffer_queue_.Get(),
-                                                                                           &filled_buffer_queue_);
-
-    // Register LogSerializerTask
-    log_serializer_task_ = thread_registry_->RegisterDedicatedThread<LogSerializerTask>(
-        this /* requester */,
-        serialization_interval_,
-        buffer_pool_,
-        empty_buffer_queue_,
-        &filled_buffer_queue_,
-        &disk_log_writer_task_->disk_log_writer_thread_cv_,
-        primary_replication_manager_);
+    if (num_streams_ > 1) {
+        commit_watermark_ = std::make_unique<CommitWatermark>(num_streams_);
+    }
+    for (uint32_t stream_id = 0; stream_id < num_streams_; stream_id++) {
+        auto &stream = streams_[stream_id];
+        // Register DiskLogConsumerTask
+        stream->disk_log_writer_task_
+            = thread_registry_->RegisterDedicatedThread<DiskLogConsumerTask>(this /* requester */,
+                                                                             stream->log_file_path_,
+                                                                             persist_interval_,
+                                                                             persist_threshold_,
+                                                                             &stream->buffers_,
+                                                                             stream->empty_buffer_queue_.Get(),
+                                                                             &stream->filled_buffer_queue_,
+                                                                             async_io_depth_,
+                                                                             group_commit_target_latency_,
+                                                                             commit_watermark_.get(),
+                                                                             stream_id,
+                                                                             compress_records_);
+
+        // Register LogSerializerTask
+        stream->log_serializer_task_ = thread_registry_->RegisterDedicatedThread<LogSerializerTask>(
+            this /* requester */,
+            serialization_interval_,
+            buffer_pool_,
+            stream->empty_buffer_queue_,
+            &stream->filled_buffer_queue_,
+            &stream->disk_log_writer_task_->disk_log_writer_thread_cv_,
+            primary_replication_manager_,
+            compress_records_);
+    }
 }
 
 void LogManager::ForceFlush() {
-    // Force the serializer task to serialize buffers
-    log_serializer_task_->Process();
-    // Signal the disk log consumer task thread to persist the buffers to disk
-    std::unique_lock<std::mutex> lock(disk_log_writer_task_->persist_lock_);
-    disk_log_writer_task_->force_flush_ = true;
-    disk_log_writer_task_->disk_log_writer_thread_cv_.notify_one();
+    // Force the serializer tasks to serialize buffers
+    for (auto &stream : streams_) {
+        stream->log_serializer_task_->Process();
+    }
+    // Persist all streams at once, so that their fsyncs overlap
+    PersistStreamsToWatermark();
+}
 
-    // Wait for the disk log consumer task thread to persist the logs
-    disk_log_writer_task_->persist_cv_.wait(lock, [&] {
-        return !disk_log_writer_task_->force_flush_;
-    });
+void LogManager::PersistStreamsToWatermark() {
+    PersistStreams(0);
+    // A stream that lagged behind the commits that the others persisted in the same round logs a watermark record in
+    // the next one
+    while (commit_watermark_ != nullptr && commit_watermark_->HasHeldCallbacks()) {
+        PersistStreams(0);
+    }
+}
+
+void LogManager::PersistStreams(const uint64_t segment_id) {
+    // Signal the disk log consumer task threads to persist the buffers to disk
+    for (auto &stream : streams_) {
+        auto                        *task = stream->disk_log_writer_task_.Get();
+        std::unique_lock<std::mutex> lock(task->persist_lock_);
+        if (segment_id != 0) {
+            task->rotate_segment_path_ = SegmentFilePath(stream->log_file_path_, segment_id);
+        }
+        task->force_flush_ = true;
+        task->disk_log_writer_thread_cv_.notify_one();
+    }
+
+    // Wait for the disk log consumer task threads to persist the logs
+    for (auto &stream : streams_) {
+        auto                        *task = stream->disk_log_writer_task_.Get();
+        std::unique_lock<std::mutex> lock(task->persist_lock_);
+        task->persist_cv_.wait(lock, [&] {
+            return !task->force_flush_;
+        });
+        NOISEPAGE_ASSERT(task->rotate_segment_path_.empty(), "Log file should have been rotated");
+    }
 }
 
 void LogManager::PersistAndStop() {
@@ -59,40 +118,170 @@ void LogManager::PersistAndStop() {
     // Signal all tasks to stop. The shutdown of the tasks will trigger any remaining logs to be serialized, writen to
     // the log file, and persisted. The order in which we shut down the tasks is important, we must first serialize,
     // then shutdown the disk consumer task (reverse order of Start())
-    auto result [[maybe_unused]]
-    = thread_registry_->StopTask(this, log_serializer_task_.CastTo<common::DedicatedThreadTask>());
-    NOISEPAGE_ASSERT(result, "LogSerializerTask should have been stopped");
+    for (auto &stream : streams_) {
+        auto result [[maybe_unused]]
+        = thread_registry_->StopTask(this, stream->log_serializer_task_.CastTo<common::DedicatedThreadTask>());
+        NOISEPAGE_ASSERT(result, "LogSerializerTask should have been stopped");
+    }
 
-    result = thread_registry_->StopTask(this, disk_log_writer_task_.CastTo<common::DedicatedThreadTask>());
-    NOISEPAGE_ASSERT(result, "DiskLogConsumerTask should have been stopped");
-    NOISEPAGE_ASSERT(filled_buffer_queue_.Empty(), "disk log consumer task should have processed all filled buffers\n");
+    // A stream has to catch up with the others to release their commit callbacks, which it can only do while its disk
+    // consumer task is running
+    PersistStreamsToWatermark();
 
-    // Close the buffers corresponding to the log file
-    for (auto &buf : buffers_) {
-        buf.Close();
+    for (auto &stream : streams_) {
+        auto result [[maybe_unused]]
+        = thread_registry_->StopTask(this, stream->disk_log_writer_task_.CastTo<common::DedicatedThreadTask>());
+        NOISEPAGE_ASSERT(result, "DiskLogConsumerTask should have been stopped");
+        NOISEPAGE_ASSERT(stream->filled_buffer_queue_.Empty(),
+                         "disk log consumer task should have processed all filled buffers\n");
+
+        // Close the buffers corresponding to the log file
+        for (auto &buf : stream->buffers_) {
+            buf.Close();
+        }
     }
     // Clear buffer queues
     empty_buffer_queue_->Clear();
-    filled_buffer_queue_.Clear();
-    buffers_.clear();
+    streams_.clear();
+    commit_watermark_.reset();
 }
 
 void LogManager::AddBufferToFlushQueue(RecordBufferSegment *const            buffer_segment,
                                        const transaction::TransactionPolicy &policy) {
     NOISEPAGE_ASSERT(run_log_manager_, "Must call Start on log manager before handing it buffers");
-    log_serializer_task_->AddBufferToFlushQueue(buffer_segment, policy);
+    // All buffers of a transaction have to go to the same stream, so that its records stay in order. The stream is
+    // picked by the start timestamp of the transaction that the first record in the buffer belongs to.
+    uint32_t stream_id = 0;
+    if (num_streams_ > 1) {
+        IterableBufferSegment<LogRecord> records(buffer_segment);
+        const auto                       first = records.begin();
+        if (first != records.end()) {
+            stream_id = static_cast<uint32_t>(first->TxnBegin().UnderlyingValue() % num_streams_);
+        }
+    }
+    streams_[stream_id]->log_serializer_task_->AddBufferToFlushQueue(buffer_segment, policy);
 }
 
 void LogManager::SetSerializationInterval(int32_t interval) {
     NOISEPAGE_ASSERT(interval > 0, "Log serialization interval should be greater than 0");
     serialization_interval_ = std::chrono::microseconds(interval);
-    if (log_serializer_task_ != nullptr) {
-        log_serializer_task_->SetSerializationInterval(interval);
+    for (auto &stream : streams_) {
+        stream->log_serializer_task_->SetSerializationInterval(interval);
     }
 }
 
 void LogManager::EndReplication() {
-    log_serializer_task_->EndReplication();
+    for (auto &stream : streams_) {
+        stream->log_serializer_task_->EndReplication();
+    }
+}
+
+uint64_t LogManager::RotateLogFile() {
+    NOISEPAGE_ASSERT(run_log_manager_, "Can't rotate the log file of an un-started LogManager");
+    const auto     segments = ListLogSegments(log_file_path_);
+    const uint64_t segment_id = segments.empty() ? 1 : segments.back() + 1;
+
+    // Holding the serialization latches keeps the serializers out of Process(). Every call to Process() ends by handing
+    // over its last buffer, so at this point every handed over buffer ends on a record boundary.
+    for (auto &stream : streams_) {
+        stream->log_serializer_task_->serialization_latch_.Lock();
+    }
+
+    // Signal the disk log consumer task threads to persist and archive the log files, and wait for them to do so
+    PersistStreams(segment_id);
+
+    for (auto &stream : streams_) {
+        stream->log_serializer_task_->serialization_latch_.Unlock();
+    }
+    return segment_id;
+}
+
+std::string LogManager::StreamFilePath(const std::string &log_file_path, const uint32_t stream_id) {
+    return stream_id == 0 ? log_file_path : log_file_path + "-" + std::to_string(stream_id);
+}
+
+std::vector<std::string> LogManager::ListLogStreams(const std::string &log_file_path) {
+    std::vector<std::string> streams{log_file_path};
+    while (true) {
+        const auto stream_file_path = StreamFilePath(log_file_path, streams.size());
+        if (!std::filesystem::exists(stream_file_path) && ListLogSegments(stream_file_path).empty()) {
+            break;
+        }
+        streams.emplace_back(stream_file_path);
+    }
+    return streams;
+}
+
+std::string LogManager::SegmentFilePath(const std::string &log_file_path, const uint64_t segment_id) {
+    return log_file_path + "." + std::to_string(segment_id);
+}
+
+std::vector<uint64_t> LogManager::ListLogSegments(const std::string &log_file_path) {
+    const std::filesystem::path log_path(log_file_path);
+    const auto                  prefix = log_path.filename().string() + ".";
+    const auto                  directory = log_path.has_parent_path() ? log_path.parent_path() : ".";
+
+    std::vector<uint64_t> segments;
+    std::error_code       ec;
+    for (const auto &entry : std::filesystem::directory_iterator(directory, ec)) {
+        const auto name = entry.path().filename().string();
+        if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        const auto suffix = name.substr(prefix.size());
+        if (std::all_of(suffix.cbegin(), suffix.cend(), [](const char c) { return std::isdigit(c) != 0; })) {
+            segments.emplace_back(std::stoull(suffix));
+        }
+    }
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+
+std::vector<std::string> LogManager::LogFilesForRecovery(const std::string &log_file_path,
+                                                         const uint64_t     first_segment) {
+    std::vector<std::string> files;
+    for (const auto segment_id : ListLogSegments(log_file_path)) {
+        if (segment_id >= first_segment) {
+            files.emplace_back(SegmentFilePath(log_file_path, segment_id));
+        }
+    }
+    files.emplace_back(log_file_path);
+
+    // An empty file carries no records, and the log reader expects every file it opens to contain at least one
+    std::error_code ec;
+    files.erase(std::remove_if(files.begin(),
+                               files.end(),
+                               [&](const std::string &file) {
+                                   const auto size = std::filesystem::file_size(file, ec);
+                                   return ec || size == 0;
+                               }),
+                files.end());
+    return files;
+}
+
+std::vector<std::vector<std::string>> LogManager::LogStreamFilesForRecovery(const std::string &log_file_path,
+                                                                            const uint64_t     first_segment) {
+    std::vector<std::vector<std::string>> stream_files;
+    for (const auto &stream_file_path : ListLogStreams(log_file_path)) {
+        auto files = LogFilesForRecovery(stream_file_path, first_segment);
+        if (!files.empty()) {
+            stream_files.emplace_back(std::move(files));
+        }
+    }
+    return stream_files;
+}
+
+uint32_t LogManager::RemoveLogSegmentsBefore(const std::string &log_file_path, const uint64_t first_segment) {
+    uint32_t num_removed = 0;
+    for (const auto &stream_file_path : ListLogStreams(log_file_path)) {
+        for (const auto segment_id : ListLogSegments(stream_file_path)) {
+            if (segment_id < first_segment
+                && std::filesystem::remove(SegmentFilePath(stream_file_path, segment_id))) {
+                num_removed++;
+            }
+        }
+    }
+    return num_removed;
 }
 
 } // namespace noisepage::storage
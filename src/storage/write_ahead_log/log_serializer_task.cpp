@@ -7,6 +7,7 @@
 #include "common/thread_context.h"
 #include "metrics/metrics_store.h"
 #include "replication/primary_replication_manager.h"
+#include "storage/write_ahead_log/log_record_serializer.h"
 #include "transaction/transaction_context.h"
 #include "transaction/transaction_manager.h"
 
@@ -50,6 +51,9 @@ void LogSerializerTask::LogSerializerTaskLoop() {
         curr_sleep = std::min(num_records > 0 ? serialization_interval_ : curr_sleep * 2, max_sleep);
 
         if (num_records > 0) {
+            const uint64_t compressed_in = compressed_bytes_in_.exchange(0);
+            const uint64_t compressed_out = compressed_bytes_out_.exchange(0);
+            const uint64_t compression_us = compression_ns_.exchange(0) / 1000;
             if (common::thread_context.resource_tracker_.IsRunning()) {
                 // Stop the resource tracker for this operating unit
                 common::thread_context.resource_tracker_.Stop();
@@ -59,6 +63,12 @@ void LogSerializerTask::LogSerializerTaskLoop() {
                                                                             num_txns,
                                                                             serialization_interval_.count(),
                                                                             resource_metrics);
+                if (compressed_in > 0) {
+                    common::thread_context.metrics_store_->RecordCompressionData(compressed_in,
+                                                                                 compressed_out,
+                                                                                 compression_us,
+                                                                                 resource_metrics);
+                }
             }
             num_bytes = num_records = num_txns = 0;
             // Update whether to collect metrics only if we did work (starting a new event) so as not to count each loop
@@ -193,6 +203,17 @@ void LogSerializerTask::HandFilledBufferToWriter() {
     if (filled_buffer_ != nullptr) {
         // Prepare the buffer for serialization. This initializes a reference count on the batch of logs within.
         filled_buffer_->PrepareForSerialization(txn_policy);
+        // Compress before any serializer sees the buffer, so that the disk and the replicas get the same frame
+        if (compress_) {
+            uint64_t elapsed_ns = 0, frame_size;
+            {
+                common::ScopedTimer<std::chrono::nanoseconds> timer(&elapsed_ns);
+                frame_size = filled_buffer_->EncodeFrame();
+            }
+            compressed_bytes_in_ += filled_buffer_->GetBufferSize();
+            compressed_bytes_out_ += frame_size;
+            compression_ns_ += elapsed_ns;
+        }
     }
     // Replicate the buffer if the buffer exists.
     // However, even if the buffer doesn't exist, the commit callback needs to be invoked.
@@ -234,7 +255,8 @@ auto LogSerializerTask::SerializeBuffer(IterableBufferSegment<LogRecord> *buffer
             commits_in_buffer_.emplace_back(CommitCallback{commit_record->CommitCallback(),
                                                            commit_record->CommitCallbackArg(),
                                                            record.TxnBegin(),
-                                                           commit_record->IsReadOnly()});
+                                                           commit_record->IsReadOnly(),
+                                                           commit_record->CommitTime()});
             // Once serialization is done, we notify the txn manager to let GC know this txn is ready to clean up
             serialized_txns_[commit_record->TimestampManager()].push_back(record.TxnBegin());
             num_txns++;
@@ -261,95 +283,9 @@ auto LogSerializerTask::SerializeBuffer(IterableBufferSegment<LogRecord> *buffer
 }
 
 auto LogSerializerTask::SerializeRecord(const noisepage::storage::LogRecord &record) -> uint64_t {
-    uint64_t num_bytes = 0;
-    // First, serialize out fields common across all LogRecordType's.
-
-    // Note: This is the in-memory size of the log record itself, i.e. inclusive of padding and not considering the size
-    // of any potential varlen entries. It is logically different from the size of the serialized record, which the log
-    // manager generates in this function. In particular, the later value is very likely to be strictly smaller when the
-    // LogRecordType is REDO. On recovery, the goal is to turn the serialized format back into an in-memory log record
-    // of this size.
-    num_bytes += WriteValue(record.Size());
-
-    num_bytes += WriteValue(record.RecordType());
-    num_bytes += WriteValue(record.TxnBegin());
-
-    switch (record.RecordType()) {
-    case LogRecordType::REDO: {
-        auto *record_body = record.GetUnderlyingRecordBodyAs<RedoRecord>();
-        num_bytes += WriteValue(record_body->GetDatabaseOid());
-        num_bytes += WriteValue(record_body->GetTableOid());
-        num_bytes += WriteValue(record_body->GetTupleSlot());
-
-        auto *delta = record_body->Delta();
-        // Write out which column ids this redo record is concerned with. On recovery, we can construct the appropriate
-        // ProjectedRowInitializer from these ids and their corresponding block layout.
-        num_bytes += WriteValue(delta->NumColumns());
-        num_bytes += WriteValue(delta->ColumnIds(), static_cast<uint32_t>(sizeof(col_id_t)) * delta->NumColumns());
-
-        // Write out the attr sizes boundaries, this way we can deserialize the records without the need of the block
-        // layout
-        const auto &block_layout = record_body->GetTupleSlot().GetBlock()->data_table_->GetBlockLayout();
-        uint16_t    boundaries[NUM_ATTR_BOUNDARIES];
-        memset(boundaries, 0, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
-        StorageUtil::ComputeAttributeSizeBoundaries(block_layout, delta->ColumnIds(), delta->NumColumns(), boundaries);
-        WriteValue(boundaries, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
-
-        // Write out the null bitmap.
-        num_bytes += WriteValue(&(delta->Bitmap()), common::RawBitmap::SizeInBytes(delta->NumColumns()));
-
-        // Write out attribute values
-        for (uint16_t i = 0; i < delta->NumColumns(); i++) {
-            const auto *column_value_address = delta->AccessWithNullCheck(i);
-            if (column_value_address == nullptr) {
-                // If the column in this REDO record is null, then there's nothing to serialize out. The bitmap contains
-                // all the relevant information.
-                continue;
-            }
-            // Get the column id of the current column in the ProjectedRow.
-            col_id_t col_id = delta->ColumnIds()[i];
-
-            if (block_layout.IsVarlen(col_id)) {
-                // Inline column value is a pointer to a VarlenEntry, so reinterpret as such.
-                const auto *varlen_entry = reinterpret_cast<const VarlenEntry *>(column_value_address);
-                // Serialize out length of the varlen entry.
-                num_bytes += WriteValue(varlen_entry->Size());
-                if (varlen_entry->IsInlined()) {
-                    // Serialize out the prefix of the varlen entry.
-                    num_bytes += WriteValue(varlen_entry->Prefix(), varlen_entry->Size());
-                } else {
-                    // Serialize out the content field of the varlen entry.
-                    num_bytes += WriteValue(varlen_entry->Content(), varlen_entry->Size());
-                }
-            } else {
-                // Inline column value is the actual data we want to serialize out.
-                // Note that by writing out AttrSize(col_id) bytes instead of just the difference between successive
-                // offsets of the delta record, we avoid serializing out any potential padding.
-                num_bytes += WriteValue(column_value_address, block_layout.AttrSize(col_id));
-            }
-        }
-        break;
-    }
-    case LogRecordType::DELETE: {
-        auto *record_body = record.GetUnderlyingRecordBodyAs<DeleteRecord>();
-        num_bytes += WriteValue(record_body->GetDatabaseOid());
-        num_bytes += WriteValue(record_body->GetTableOid());
-        num_bytes += WriteValue(record_body->GetTupleSlot());
-        break;
-    }
-    case LogRecordType::COMMIT: {
-        auto *record_body = record.GetUnderlyingRecordBodyAs<CommitRecord>();
-        num_bytes += WriteValue(record_body->CommitTime());
-        num_bytes += WriteValue(record_body->OldestActiveTxn());
-        break;
-    }
-    case LogRecordType::ABORT: {
-        // AbortRecord does not hold any additional metadata
-        break;
-    }
-    }
-
-    return num_bytes;
+    return LogRecordSerializer::Serialize(record, [this](const void *val, const uint32_t size) {
+        return WriteValue(val, size);
+    });
 }
 
 auto LogSerializerTask::WriteValue(const void *val, const uint32_t size) -> uint32_t {
@@ -1,5 +1,8 @@
 #include "taskflow/taskflow.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <future> // NOLINT
 #include <memory>
 #include <string>
@@ -17,6 +20,7 @@
 #include "execution/exec/execution_context.h"
 #include "execution/exec/execution_settings.h"
 #include "execution/exec/output.h"
+#include "execution/sql/bulk_loader.h"
 #include "execution/sql/ddl_executors.h"
 #include "execution/sql/value.h"
 #include "execution/vm/module.h"
@@ -25,8 +29,9 @@
 #include "network/postgres/portal.h"
 #include "network/postgres/postgres_packet_writer.h"
 #include "network/postgres/statement.h"
-#include "optimizer/cost_model/trivial_cost_model.h"
+#include "optimizer/cost_model/abstract_cost_model.h"
 #include "optimizer/statistics/stats_storage.h"
+#include "parser/copy_statement.h"
 #include "parser/drop_statement.h"
 #include "parser/explain_statement.h"
 #include "parser/expression/constant_value_expression.h"
@@ -45,6 +50,8 @@
 #include "planner/plannodes/drop_table_plan_node.h"
 #include "settings/settings_manager.h"
 #include "settings/settings_param.h"
+#include "storage/arrow_serializer.h"
+#include "storage/sql_table.h"
 #include "taskflow/taskflow_defs.h"
 #include "taskflow/taskflow_util.h"
 #include "transaction/transaction_manager.h"
@@ -102,6 +109,27 @@ namespace {
             cb_arg->ready_to_commit_.set_value(true);
         }
     }
+
+    // Sends every message of an Arrow stream to the client as a CopyData message, and writes it out before the next one
+    // so that the connection's write queue holds at most one record batch instead of the whole table
+    class CopyDataArrowStreamWriter : public storage::ArrowStreamWriter {
+    public:
+        CopyDataArrowStreamWriter(const common::ManagedPointer<network::PostgresPacketWriter> out,
+                                  const common::ManagedPointer<network::ConnectionContext>    connection_ctx)
+            : out_(out)
+            , connection_ctx_(connection_ctx) {}
+
+        void Write(const std::vector<iovec> &buffers) override {
+            out_->WriteCopyData(buffers);
+            if (!connection_ctx_->FlushWrites()) {
+                throw std::runtime_error("could not send COPY data to the client");
+            }
+        }
+
+    private:
+        const common::ManagedPointer<network::PostgresPacketWriter> out_;
+        const common::ManagedPointer<network::ConnectionContext>    connection_ctx_;
+    };
 } // namespace
 
 void Taskflow::BeginTransaction(const common::ManagedPointer<network::ConnectionContext> connection_ctx) const {
@@ -201,7 +229,7 @@ auto Taskflow::OptimizeBoundQuery(const common::ManagedPointer<network::Connecti
                                   query,
                                   connection_ctx->GetDatabaseOid(),
                                   stats_storage_,
-                                  std::make_unique<optimizer::TrivialCostModel>(),
+                                  optimizer::CostModelUtil::CreateCostModel(cost_model_type_),
                                   optimizer_timeout_,
                                   parameters);
 }
@@ -270,6 +298,10 @@ auto Taskflow::ExecuteCreateStatement(const common::ManagedPointer<network::Conn
             || query_type == network::QueryType::QUERY_CREATE_VIEW
             || query_type == network::QueryType::QUERY_CREATE_TRIGGER,
         "ExecuteCreateStatement called with invalid QueryType.");
+    // Cached plans may miss the new objects (e.g., indexes) once the change commits
+    connection_ctx->Transaction()->RegisterCommitAction([this]() {
+        UpdateQueryCacheTimestamp();
+    });
     switch (query_type) {
     case network::QueryType::QUERY_CREATE_TABLE: {
         if (execution::sql::DDLExecutors::CreateTableExecutor(physical_plan.CastTo<planner::CreateTablePlanNode>(),
@@ -330,6 +362,10 @@ auto Taskflow::ExecuteDropStatement(const common::ManagedPointer<network::Connec
             || query_type == network::QueryType::QUERY_DROP_VIEW
             || query_type == network::QueryType::QUERY_DROP_TRIGGER,
         "ExecuteDropStatement called with invalid QueryType.");
+    // Cached plans may refer to the dropped objects once the change commits
+    connection_ctx->Transaction()->RegisterCommitAction([this]() {
+        UpdateQueryCacheTimestamp();
+    });
     switch (query_type) {
     case network::QueryType::QUERY_DROP_TABLE: {
         if (execution::sql::DDLExecutors::DropTableExecutor(physical_plan.CastTo<planner::DropTablePlanNode>(),
@@ -377,6 +413,129 @@ auto Taskflow::ExecuteDropStatement(const common::ManagedPointer<network::Connec
                               common::ErrorCode::ERRCODE_DATA_EXCEPTION)};
 }
 
+auto Taskflow::ExecuteCopyStatement(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                                    const common::ManagedPointer<network::Statement>         statement) const
+    -> TaskflowResult {
+    NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
+                     "Not in a valid txn. This should have been caught before calling this function.");
+    const auto copy_stmt = statement->RootStatement().CastTo<parser::CopyStatement>();
+    NOISEPAGE_ASSERT(copy_stmt->IsFrom() && copy_stmt->GetCopyTable() != nullptr,
+                     "ExecuteCopyStatement only handles COPY ... FROM into a table.");
+
+    const auto  accessor = connection_ctx->CatalogAccessor();
+    const auto  table_ref = copy_stmt->GetCopyTable();
+    const auto &namespace_name = table_ref->GetNamespaceName();
+    const auto  table_oid
+        = namespace_name.empty()
+              ? accessor->GetTableOid(table_ref->GetTableName())
+              : accessor->GetTableOid(accessor->GetNamespaceOid(namespace_name), table_ref->GetTableName());
+    if (table_oid == catalog::INVALID_TABLE_OID) {
+        connection_ctx->Transaction()->SetMustAbort();
+        return {ResultType::ERROR,
+                common::ErrorData(common::ErrorSeverity::ERROR,
+                                  "relation \"" + table_ref->GetTableName() + "\" does not exist",
+                                  common::ErrorCode::ERRCODE_UNDEFINED_TABLE)};
+    }
+
+    try {
+        execution::sql::BulkLoader loader(accessor,
+                                          connection_ctx->GetDatabaseOid(),
+                                          table_oid,
+                                          connection_ctx->Transaction());
+        const uint64_t num_rows
+            = copy_stmt->GetExternalFileFormat() == parser::ExternalFileFormat::BINARY
+                  ? loader.LoadBinary(copy_stmt->GetFilePath())
+                  : loader.LoadCsv(copy_stmt->GetFilePath(),
+                                   copy_stmt->GetDelimiter(),
+                                   copy_stmt->GetQuoteChar(),
+                                   copy_stmt->GetEscapeChar());
+        return {ResultType::COMPLETE, static_cast<uint32_t>(num_rows)};
+    } catch (ExecutionException &e) {
+        // The rows loaded before the failure are part of the transaction, so it has to be aborted.
+        connection_ctx->Transaction()->SetMustAbort();
+        auto error = common::ErrorData(common::ErrorSeverity::ERROR, e.what(), e.code_);
+        error.AddField(common::ErrorField::LINE, std::to_string(e.GetLine()));
+        error.AddField(common::ErrorField::FILE, e.GetFile());
+        return {ResultType::ERROR, error};
+    }
+}
+
+auto Taskflow::ExecuteCopyToStatement(const common::ManagedPointer<network::ConnectionContext>    connection_ctx,
+                                      const common::ManagedPointer<network::PostgresPacketWriter> out,
+                                      const common::ManagedPointer<network::Statement>            statement) const
+    -> TaskflowResult {
+    NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
+                     "Not in a valid txn. This should have been caught before calling this function.");
+    const auto copy_stmt = statement->RootStatement().CastTo<parser::CopyStatement>();
+    NOISEPAGE_ASSERT(!copy_stmt->IsFrom() && copy_stmt->GetExternalFileFormat() == parser::ExternalFileFormat::ARROW,
+                     "ExecuteCopyToStatement only handles COPY ... TO in the arrow format.");
+    if (copy_stmt->GetCopyTable() == nullptr) {
+        return {ResultType::ERROR,
+                common::ErrorData(common::ErrorSeverity::ERROR,
+                                  "COPY ... TO in the arrow format only supports tables",
+                                  common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED)};
+    }
+
+    const auto  accessor = connection_ctx->CatalogAccessor();
+    const auto  table_ref = copy_stmt->GetCopyTable();
+    const auto &namespace_name = table_ref->GetNamespaceName();
+    const auto  table_oid
+        = namespace_name.empty()
+              ? accessor->GetTableOid(table_ref->GetTableName())
+              : accessor->GetTableOid(accessor->GetNamespaceOid(namespace_name), table_ref->GetTableName());
+    if (table_oid == catalog::INVALID_TABLE_OID) {
+        connection_ctx->Transaction()->SetMustAbort();
+        return {ResultType::ERROR,
+                common::ErrorData(common::ErrorSeverity::ERROR,
+                                  "relation \"" + table_ref->GetTableName() + "\" does not exist",
+                                  common::ErrorCode::ERRCODE_UNDEFINED_TABLE)};
+    }
+
+    std::vector<catalog::col_oid_t>        col_oids;
+    std::vector<execution::sql::SqlTypeId> col_types;
+    std::vector<std::string>               col_names;
+    for (const auto &column : accessor->GetSchema(table_oid).GetColumns()) {
+        col_oids.push_back(column.Oid());
+        col_types.push_back(column.Type());
+        col_names.push_back(column.Name());
+    }
+    const auto table = accessor->GetTable(table_oid);
+    const auto txn = common::ManagedPointer(connection_ctx->Transaction());
+
+    // Frozen blocks are handed to the kernel in place when writing to a file. Over the wire, they are copied into the
+    // connection's write queue one record batch at a time.
+    const std::string file_path = copy_stmt->GetFilePath();
+    uint64_t          num_rows;
+    try {
+        if (file_path.empty()) {
+            CopyDataArrowStreamWriter writer(out, connection_ctx);
+            out->WriteCopyOutResponse(static_cast<uint16_t>(col_oids.size()));
+            num_rows = table->ExportArrowStream(txn, col_oids, col_types, col_names, &writer);
+            out->WriteCopyDone();
+        } else {
+            const int fd = ::open(file_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) {
+                return {ResultType::ERROR,
+                        common::ErrorData(common::ErrorSeverity::ERROR,
+                                          "could not open file \"" + file_path + "\" for writing",
+                                          common::ErrorCode::ERRCODE_UNDEFINED_FILE)};
+            }
+            storage::FdArrowStreamWriter writer(fd);
+            try {
+                num_rows = table->ExportArrowStream(txn, col_oids, col_types, col_names, &writer);
+            } catch (std::runtime_error &) {
+                ::close(fd);
+                throw;
+            }
+            ::close(fd);
+        }
+    } catch (std::runtime_error &e) {
+        return {ResultType::ERROR,
+                common::ErrorData(common::ErrorSeverity::ERROR, e.what(), common::ErrorCode::ERRCODE_IO_ERROR)};
+    }
+    return {ResultType::COMPLETE, static_cast<uint32_t>(num_rows)};
+}
+
 auto Taskflow::ExecuteExplainStatement(const common::ManagedPointer<network::ConnectionContext>    connection_ctx,
                                        const common::ManagedPointer<network::PostgresPacketWriter> out,
                                        const common::ManagedPointer<network::Portal> portal) const -> TaskflowResult {
@@ -566,7 +725,9 @@ auto Taskflow::RunExecutableQuery(const common::ManagedPointer<network::Connecti
             || query_type == network::QueryType::QUERY_DELETE || query_type == network::QueryType::QUERY_ANALYZE,
         "CodegenAndRunPhysicalPlan called with invalid QueryType.");
 
-    if (query_cache_timestamp_ > portal->GetStatement()->GetExecutableQuery()->GetTimestamp()) {
+    // A shared Statement cannot be re-generated in place. It was checked when it was bound in this transaction, so it
+    // is consistent with the snapshot of the transaction even if the catalog changed since then.
+    if (!portal->GetStatement()->IsShared() && IsQueryCacheStale(portal->GetStatement())) {
         // ExecutableQuery is outdated. Re-generate it
         auto statement = portal->GetStatement();
         statement->SetExecutableQuery(nullptr);
@@ -582,7 +743,8 @@ auto Taskflow::RunExecutableQuery(const common::ManagedPointer<network::Connecti
 
     /*
      * ANALYZE will update the statistics held in the pg_statistic catalog table. These statistics are also cached in
-     * StatsStorage. So once ANALYZE commits, we need to mark the columns updated as dirty in StatsStorage.
+     * StatsStorage. So once ANALYZE commits, we need to mark the columns updated as dirty in StatsStorage. Cached plans
+     * were chosen with the old statistics, so they are invalidated as well.
      */
     if (query_type == network::QueryType::QUERY_ANALYZE) {
         const auto                      analyze_plan = physical_plan.CastTo<planner::AnalyzePlanNode>();
@@ -591,6 +753,7 @@ auto Taskflow::RunExecutableQuery(const common::ManagedPointer<network::Connecti
         std::vector<catalog::col_oid_t> col_oids = analyze_plan->GetColumnOids();
         connection_ctx->Transaction()->RegisterCommitAction([this, db_oid, table_oid, col_oids]() {
             stats_storage_->MarkStatsStale(db_oid, table_oid, col_oids);
+            UpdateQueryCacheTimestamp();
         });
     }
 
@@ -725,8 +888,17 @@ auto Taskflow::DropTempNamespace(const catalog::db_oid_t db_oid, const catalog::
     return result;
 }
 
-void Taskflow::UpdateQueryCacheTimestamp() {
-    query_cache_timestamp_ = txn_manager_->GetCurrentTimestamp();
+void Taskflow::UpdateQueryCacheTimestamp() const {
+    const auto timestamp = txn_manager_->GetCurrentTimestamp();
+    // Commit actions may race with each other, so make sure that the timestamp never goes back
+    auto current = query_cache_timestamp_.load();
+    while (current < timestamp && !query_cache_timestamp_.compare_exchange_weak(current, timestamp)) {
+    }
+    shared_statement_cache_.Invalidate(timestamp);
+}
+
+auto Taskflow::IsQueryCacheStale(const common::ManagedPointer<network::Statement> statement) const -> bool {
+    return query_cache_timestamp_.load() > statement->GetExecutableQuery()->GetTimestamp();
 }
 
 } // namespace noisepage::taskflow
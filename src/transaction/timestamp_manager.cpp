@@ -5,10 +5,71 @@
 
 namespace noisepage::transaction {
 
+namespace {
+// Source of the begin slot that each thread tries first, so that threads do not contend on their begin slots
+std::atomic<uint32_t> next_home_begin_slot{0};
+thread_local const uint32_t home_begin_slot = next_home_begin_slot++;
+} // namespace
+
+TimestampManager::TimestampManager()
+    : running_txns_(new std::atomic<timestamp_t>[NUM_RUNNING_TXN_SLOTS])
+    , begin_slots_(new BeginSlot[NUM_BEGIN_SLOTS]) {
+    for (uint32_t i = 0; i < NUM_RUNNING_TXN_SLOTS; i++) {
+        running_txns_[i].store(INVALID_TXN_TIMESTAMP, std::memory_order_relaxed);
+    }
+}
+
+auto TimestampManager::BeginTransaction() -> timestamp_t {
+    // There is a three-way race that needs to be prevented. Specifically, we cannot allow both a transaction to commit
+    // and the GC to poll for the oldest running transaction in between this transaction acquiring its begin timestamp
+    // and getting inserted into the running transactions table. The begin slot holds a timestamp no newer than the
+    // start time until then, and the GC takes it into account.
+    BeginSlot *begin_slot;
+    for (uint32_t i = home_begin_slot;; i++) {
+        begin_slot = &begin_slots_[i % NUM_BEGIN_SLOTS];
+        timestamp_t free = INVALID_TXN_TIMESTAMP;
+        if (begin_slot->lower_bound_.load() == INVALID_TXN_TIMESTAMP
+            && begin_slot->lower_bound_.compare_exchange_strong(free, time_.load())) {
+            break;
+        }
+    }
+    const timestamp_t start_time = time_++;
+    num_running_txns_++;
+
+    bool inserted = false;
+    for (uint32_t i = 0; i < MAX_RUNNING_TXN_PROBES && !inserted; i++) {
+        auto       &slot = running_txns_[(RunningTxnSlot(start_time) + i) & (NUM_RUNNING_TXN_SLOTS - 1)];
+        timestamp_t free = INVALID_TXN_TIMESTAMP;
+        inserted = slot.load() == INVALID_TXN_TIMESTAMP && slot.compare_exchange_strong(free, start_time);
+    }
+    if (!inserted) {
+        common::SpinLatch::ScopedSpinLatch running_guard(&curr_running_txns_latch_);
+        num_overflow_txns_++;
+        const auto ret [[maybe_unused]] = curr_running_txns_.emplace(start_time);
+        NOISEPAGE_ASSERT(ret.second, "commit start time should be globally unique");
+    }
+
+    begin_slot->lower_bound_.store(INVALID_TXN_TIMESTAMP);
+    return start_time;
+}
+
 auto TimestampManager::OldestTransactionStartTime() -> timestamp_t {
-    common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-    const auto &oldest_txn = std::min_element(curr_running_txns_.cbegin(), curr_running_txns_.cend());
-    timestamp_t result = (oldest_txn != curr_running_txns_.end()) ? *oldest_txn : time_.load();
+    // The order of the loads matters, see BeginTransaction. A txn that is not in the table yet either checked out its
+    // start time after time_ is read, or is announced in its begin slot.
+    timestamp_t result = time_.load();
+    for (uint32_t i = 0; i < NUM_BEGIN_SLOTS; i++) {
+        result = std::min(result, begin_slots_[i].lower_bound_.load());
+    }
+    for (uint32_t i = 0; i < NUM_RUNNING_TXN_SLOTS; i++) {
+        result = std::min(result, running_txns_[i].load());
+    }
+    if (num_overflow_txns_.load() > 0) {
+        common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
+        const auto &oldest_txn = std::min_element(curr_running_txns_.cbegin(), curr_running_txns_.cend());
+        if (oldest_txn != curr_running_txns_.cend()) {
+            result = std::min(result, *oldest_txn);
+        }
+    }
     cached_oldest_txn_start_time_.store(result); // Cache the timestamp
     return result;
 }
@@ -18,18 +79,30 @@ auto TimestampManager::CachedOldestTransactionStartTime() -> timestamp_t {
 }
 
 void TimestampManager::RemoveTransaction(timestamp_t timestamp) {
-    common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-    const size_t                       ret [[maybe_unused]] = curr_running_txns_.erase(timestamp);
-    NOISEPAGE_ASSERT(ret == 1, "erased timestamp did not exist");
+    RemoveRunningTransaction(timestamp);
+    num_running_txns_--;
 }
 
 auto TimestampManager::RemoveTransactions(const std::vector<noisepage::transaction::timestamp_t> &timestamps) -> bool {
-    common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
     for (const auto &timestamp : timestamps) {
-        const size_t ret [[maybe_unused]] = curr_running_txns_.erase(timestamp);
-        NOISEPAGE_ASSERT(ret == 1, "erased timestamp did not exist");
+        RemoveRunningTransaction(timestamp);
     }
-    return curr_running_txns_.empty();
+    return (num_running_txns_ -= timestamps.size()) == 0;
+}
+
+void TimestampManager::RemoveRunningTransaction(const timestamp_t timestamp) {
+    // Only this txn ever puts its start time in a slot, so there is no race on the slot that holds it
+    for (uint32_t i = 0; i < MAX_RUNNING_TXN_PROBES; i++) {
+        auto &slot = running_txns_[(RunningTxnSlot(timestamp) + i) & (NUM_RUNNING_TXN_SLOTS - 1)];
+        if (slot.load() == timestamp) {
+            slot.store(INVALID_TXN_TIMESTAMP);
+            return;
+        }
+    }
+    common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
+    const size_t                       ret [[maybe_unused]] = curr_running_txns_.erase(timestamp);
+    NOISEPAGE_ASSERT(ret == 1, "erased timestamp did not exist");
+    num_overflow_txns_--;
 }
 
 } // namespace noisepage::transaction
@@ -23,6 +23,7 @@ auto TransactionManager::BeginTransaction() -> TransactionContext * {
     }
     start_time = timestamp_manager_->BeginTransaction();
     result = new TransactionContext(start_time, start_time + INT64_MIN, buffer_pool_, log_manager_);
+    result->prune_horizon_ = timestamp_manager_->CachedOldestTransactionStartTime();
     // Set the current default policies for durability and replication.
     result->SetDurabilityPolicy(default_txn_policy_.durability_);
     result->SetReplicationPolicy(default_txn_policy_.replication_);
@@ -151,6 +152,12 @@ auto TransactionManager::Commit(TransactionContext *const txn, transaction::call
         txn->commit_actions_.pop_front();
     }
 
+    // The txn can be deallocated by the GC as soon as it is handed off below, so read out what the metrics need first
+    const bool     is_readonly = txn->IsReadOnly();
+    const uint64_t num_reads = txn->num_reads_.load(std::memory_order_relaxed);
+    const uint64_t num_versions_walked = txn->num_versions_walked_.load(std::memory_order_relaxed);
+    const uint64_t num_chains_pruned = txn->num_chains_pruned_.load(std::memory_order_relaxed);
+
     // If logging is enabled and our txn is not read only, we need to persist the oldest active txn at the time we
     // committed. This will allow us to correctly order and execute transactions during recovery.
     timestamp_t oldest_active_txn = INVALID_TXN_TIMESTAMP;
@@ -194,8 +201,11 @@ auto TransactionManager::Commit(TransactionContext *const txn, transaction::call
     if (txn_metrics_enabled) {
         common::thread_context.resource_tracker_.Stop();
         auto &resource_metrics = common::thread_context.resource_tracker_.GetMetrics();
-        common::thread_context.metrics_store_->RecordCommitData(static_cast<uint64_t>(txn->IsReadOnly()),
-                                                                resource_metrics);
+        common::thread_context.metrics_store_->RecordCommitData(static_cast<uint64_t>(is_readonly), resource_metrics);
+        common::thread_context.metrics_store_->RecordVersionChainData(num_reads,
+                                                                      num_versions_walked,
+                                                                      num_chains_pruned,
+                                                                      resource_metrics);
     }
 
     return result;
@@ -330,36 +340,54 @@ void TransactionManager::Rollback(TransactionContext *txn, const storage::UndoRe
         // This UndoRecord was never installed in the version chain, so we can skip it
         return;
     }
-    const storage::TupleSlot            slot = record.Slot();
     const storage::TupleAccessStrategy &accessor = table->accessor_;
-    storage::UndoRecord                *undo_record = table->AtomicallyReadVersionPtr(slot, accessor);
-    // In a loop, we will need to undo all updates belonging to this transaction. Because we do not unlink undo records,
-    // otherwise this ends up being a quadratic operation to rollback the first record not yet rolled back in the chain.
-    NOISEPAGE_ASSERT(undo_record != nullptr && undo_record->Timestamp().load() == txn->finish_time_.load(),
-                     "Attempting to rollback on a TupleSlot where this txn does not hold the write lock!");
-    while (undo_record != nullptr && undo_record->Timestamp().load() == txn->finish_time_.load()) {
-        switch (undo_record->Type()) {
-        case storage::DeltaRecordType::UPDATE:
-            // Re-apply the before image
-            for (uint16_t i = 0; i < undo_record->Delta()->NumColumns(); i++) {
-                // Need to deallocate any possible varlen.
-                DeallocateColumnUpdateIfVarlen(txn, undo_record, i, accessor);
-                storage::StorageUtil::CopyAttrFromProjection(accessor, slot, *(undo_record->Delta()), i);
+    // A block insert record heads the version chains of a whole range of slots, every other record exactly one
+    for (uint32_t offset = 0; offset < record.NumSlots(); offset++) {
+        const storage::TupleSlot slot(record.Slot().GetBlock(), record.Slot().GetOffset() + offset);
+        storage::UndoRecord     *undo_record = table->AtomicallyReadVersionPtr(slot, accessor);
+        if (undo_record == nullptr) {
+            // The tuple was bulk loaded by this txn and has already been rolled back along with the rest of its block
+            NOISEPAGE_ASSERT(accessor.IsNull(slot, storage::VERSION_POINTER_COLUMN_ID),
+                             "Only rolled back bulk loaded tuples can have an empty version chain here");
+            continue;
+        }
+        // In a loop, we will need to undo all updates belonging to this transaction. Because we do not unlink undo
+        // records, otherwise this ends up being a quadratic operation to rollback the first record not yet rolled back
+        // in the chain.
+        NOISEPAGE_ASSERT(undo_record->Timestamp().load() == txn->finish_time_.load(),
+                         "Attempting to rollback on a TupleSlot where this txn does not hold the write lock!");
+        while (undo_record != nullptr && undo_record->Timestamp().load() == txn->finish_time_.load()) {
+            switch (undo_record->Type()) {
+            case storage::DeltaRecordType::UPDATE:
+                // Re-apply the before image
+                for (uint16_t i = 0; i < undo_record->Delta()->NumColumns(); i++) {
+                    // Need to deallocate any possible varlen.
+                    DeallocateColumnUpdateIfVarlen(txn, undo_record, i, accessor);
+                    storage::StorageUtil::CopyAttrFromProjection(accessor, slot, *(undo_record->Delta()), i);
+                }
+                break;
+            case storage::DeltaRecordType::INSERT:
+                // Same as update, need to deallocate possible varlens.
+                DeallocateInsertedTupleIfVarlen(txn, slot, accessor);
+                accessor.SetNull(slot, storage::VERSION_POINTER_COLUMN_ID);
+                accessor.Deallocate(slot);
+                break;
+            case storage::DeltaRecordType::BLOCK_INSERT:
+                // Same as insert, but the record is shared with the rest of the block. Emptying the version chain
+                // marks the slot as rolled back for later records of this txn that touch the same slot.
+                DeallocateInsertedTupleIfVarlen(txn, slot, accessor);
+                accessor.SetNull(slot, storage::VERSION_POINTER_COLUMN_ID);
+                accessor.Deallocate(slot);
+                table->AtomicallyWriteVersionPtr(slot, accessor, nullptr);
+                break;
+            case storage::DeltaRecordType::DELETE:
+                accessor.SetNotNull(slot, storage::VERSION_POINTER_COLUMN_ID);
+                break;
+            default:
+                throw std::runtime_error("unexpected delta record type");
             }
-            break;
-        case storage::DeltaRecordType::INSERT:
-            // Same as update, need to deallocate possible varlens.
-            DeallocateInsertedTupleIfVarlen(txn, undo_record, accessor);
-            accessor.SetNull(slot, storage::VERSION_POINTER_COLUMN_ID);
-            accessor.Deallocate(slot);
-            break;
-        case storage::DeltaRecordType::DELETE:
-            accessor.SetNotNull(slot, storage::VERSION_POINTER_COLUMN_ID);
-            break;
-        default:
-            throw std::runtime_error("unexpected delta record type");
+            undo_record = undo_record->Next();
         }
-        undo_record = undo_record->Next();
     }
 }
 
@@ -382,13 +410,13 @@ void TransactionManager::DeallocateColumnUpdateIfVarlen(TransactionContext
 }
 
 void TransactionManager::DeallocateInsertedTupleIfVarlen(TransactionContext                 *txn,
-                                                         storage::UndoRecord                *undo,
+                                                         const storage::TupleSlot            slot,
                                                          const storage::TupleAccessStrategy &accessor) const {
     const storage::BlockLayout &layout = accessor.GetBlockLayout();
     for (uint16_t i = storage::NUM_RESERVED_COLUMNS; i < layout.NumColumns(); i++) {
         storage::col_id_t col_id(i);
         if (layout.IsVarlen(col_id)) {
-            auto *varlen = reinterpret_cast<storage::VarlenEntry *>(accessor.AccessWithNullCheck(undo->Slot(), col_id));
+            auto *varlen = reinterpret_cast<storage::VarlenEntry *>(accessor.AccessWithNullCheck(slot, col_id));
             if (varlen != nullptr) {
                 if (varlen->NeedReclaim()) {
                     txn->loose_ptrs_.push_back(varlen->Content());
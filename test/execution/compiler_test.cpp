@@ -1,8 +1,12 @@
 #include "execution/compiler/compiler.h"
 
+#include <algorithm>
 #include <functional>
 #include <limits>
+#include <map>
 #include <memory>
+#include <numeric>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -13,6 +17,7 @@
 #include "execution/compiler/compilation_context.h"
 #include "execution/compiler/executable_query.h"
 #include "execution/compiler/expression_maker.h"
+#include "execution/compiler/operator/seq_scan_translator.h"
 #include "execution/compiler/output_checker.h"
 #include "execution/compiler/output_schema_util.h"
 #include "execution/exec/execution_context.h"
@@ -33,12 +38,14 @@
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
 #include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/output_schema.h"
 #include "planner/plannodes/projection_plan_node.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
+#include "storage/sql_table.h"
 
 namespace noisepage::execution::compiler::test {
 class CompilerTest : public SqlBasedTest {
@@ -472,6 +479,169 @@ TEST_F(CompilerTest, SimpleSeqScanWithParamsTest) {
     EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec, exp_vec));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SeqScanBlockFilterRangeTest) {
+    ExpressionMaker expr_maker;
+    const auto      bigint_constant = [&](const int64_t val) {
+        return expr_maker.MakeManaged(
+            std::make_unique<parser::ConstantValueExpression>(sql::SqlTypeId::BigInt, sql::Integer(val)));
+    };
+    auto bigint_col = expr_maker.CVE(catalog::col_oid_t(1), sql::SqlTypeId::BigInt);
+    auto date_col = expr_maker.CVE(catalog::col_oid_t(2), sql::SqlTypeId::Date);
+    auto timestamp_col = expr_maker.CVE(catalog::col_oid_t(3), sql::SqlTypeId::Timestamp);
+    auto double_col = expr_maker.CVE(catalog::col_oid_t(4), sql::SqlTypeId::Double);
+
+    constexpr int64_t int64_min = std::numeric_limits<int64_t>::min();
+    constexpr int64_t int64_max = std::numeric_limits<int64_t>::max();
+    int64_t           min = 0, max = 0;
+    const auto        get_range = [&](ExpressionMaker::ManagedExpression term) {
+        return SeqScanTranslator::GetBlockFilterRange(*term, term->GetChild(0)->GetReturnValueType(), &min, &max);
+    };
+
+    // No value is smaller than the smallest BIGINT or larger than the largest, so there is no range to filter on
+    EXPECT_FALSE(get_range(expr_maker.ComparisonLt(bigint_col, bigint_constant(int64_min))));
+    EXPECT_FALSE(get_range(expr_maker.ComparisonGt(bigint_col, bigint_constant(int64_max))));
+    EXPECT_TRUE(get_range(expr_maker.ComparisonLt(bigint_col, bigint_constant(int64_max))));
+    EXPECT_EQ(int64_min, min);
+    EXPECT_EQ(int64_max - 1, max);
+    EXPECT_TRUE(get_range(expr_maker.ComparisonGt(bigint_col, bigint_constant(int64_min))));
+    EXPECT_EQ(int64_min + 1, min);
+    EXPECT_EQ(int64_max, max);
+    EXPECT_TRUE(get_range(expr_maker.ComparisonLe(bigint_col, bigint_constant(int64_min))));
+    EXPECT_EQ(int64_min, min);
+    EXPECT_EQ(int64_min, max);
+    EXPECT_TRUE(get_range(expr_maker.ComparisonGe(bigint_col, bigint_constant(int64_max))));
+    EXPECT_EQ(int64_max, min);
+    EXPECT_EQ(int64_max, max);
+    // Integer constants of any width apply to integer columns of any width
+    EXPECT_TRUE(get_range(expr_maker.ComparisonEq(bigint_col, expr_maker.Constant(-42))));
+    EXPECT_EQ(-42, min);
+    EXPECT_EQ(-42, max);
+
+    // Dates and timestamps are compared in their native form
+    const auto date = sql::Date::FromYMD(2020, 2, 29);
+    EXPECT_TRUE(get_range(expr_maker.ComparisonGe(date_col, expr_maker.Constant(2020, 2, 29))));
+    EXPECT_EQ(date.ToNative(), min);
+    EXPECT_EQ(int64_max, max);
+    const auto timestamp = sql::Timestamp::FromYMDHMS(2020, 2, 29, 12, 30, 0);
+    auto       timestamp_constant = expr_maker.MakeManaged(
+        std::make_unique<parser::ConstantValueExpression>(sql::SqlTypeId::Timestamp, sql::TimestampVal(timestamp)));
+    EXPECT_TRUE(get_range(expr_maker.ComparisonLt(timestamp_col, timestamp_constant)));
+    EXPECT_EQ(int64_min, min);
+    EXPECT_EQ(static_cast<int64_t>(timestamp.ToNative()) - 1, max);
+
+    // A constant of another kind than the column, a NULL constant or another comparison does not emit a filter
+    EXPECT_FALSE(get_range(expr_maker.ComparisonEq(date_col, expr_maker.Constant(42))));
+    EXPECT_FALSE(get_range(expr_maker.ComparisonEq(bigint_col, expr_maker.Constant(2020, 2, 29))));
+    EXPECT_FALSE(get_range(expr_maker.ComparisonLt(timestamp_col, expr_maker.Constant(2020, 2, 29))));
+    EXPECT_FALSE(get_range(expr_maker.ComparisonLt(date_col, timestamp_constant)));
+    EXPECT_FALSE(get_range(expr_maker.ComparisonLt(bigint_col, expr_maker.Constant(42.5))));
+    EXPECT_FALSE(get_range(expr_maker.ComparisonLt(double_col, expr_maker.Constant(42))));
+    EXPECT_FALSE(get_range(expr_maker.ComparisonEq(bigint_col, expr_maker.Constant("42"))));
+    EXPECT_FALSE(get_range(expr_maker.ComparisonEq(
+        bigint_col,
+        expr_maker.MakeManaged(std::make_unique<parser::ConstantValueExpression>(sql::SqlTypeId::BigInt)))));
+    EXPECT_FALSE(get_range(expr_maker.ComparisonNeq(bigint_col, bigint_constant(42))));
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SeqScanBlockFilterTest) {
+    // CREATE TABLE zone_map_test (id BIGINT NOT NULL, day DATE NOT NULL), with ids and days increasing with the
+    // insertion order so that every block covers its own range of them
+    auto                                 accessor = MakeAccessor();
+    std::vector<catalog::Schema::Column> cols;
+    cols.emplace_back("id", sql::SqlTypeId::BigInt, false, parser::ConstantValueExpression(sql::SqlTypeId::BigInt));
+    cols.emplace_back("day", sql::SqlTypeId::Date, false, parser::ConstantValueExpression(sql::SqlTypeId::Date));
+    const auto  table_oid = accessor->CreateTable(NSOid(), "zone_map_test", catalog::Schema(cols));
+    const auto &table_schema = accessor->GetSchema(table_oid);
+    accessor->SetTablePointer(table_oid, new storage::SqlTable(BlockStore(), table_schema));
+    const auto table = accessor->GetTable(table_oid);
+    const auto id_oid = table_schema.GetColumn("id").Oid();
+    const auto day_oid = table_schema.GetColumn("day").Oid();
+
+    const int64_t num_rows = 200000;
+    const auto    first_day = sql::Date::FromYMD(2000, 1, 1).ToNative();
+    const auto    day_of = [&](const int64_t id) {
+        return static_cast<sql::Date::NativeType>(first_day + id / 1000);
+    };
+    {
+        auto       exec_ctx = MakeExecCtx();
+        const auto initializer = table->InitializerForProjectedRow({id_oid, day_oid});
+        auto       offsets = table->ProjectionMapForOids({id_oid, day_oid});
+        for (int64_t id = 0; id < num_rows; id++) {
+            auto *const redo = exec_ctx->GetTxn()->StageWrite(exec_ctx->DBOid(), table_oid, initializer);
+            *reinterpret_cast<int64_t *>(redo->Delta()->AccessForceNotNull(offsets[id_oid])) = id;
+            *reinterpret_cast<sql::Date *>(redo->Delta()->AccessForceNotNull(offsets[day_oid]))
+                = sql::Date::FromNative(day_of(id));
+            table->Insert(exec_ctx->GetTxn(), redo);
+        }
+    }
+    ASSERT_GT(table->GetNumBlocks(), 2);
+
+    ExpressionMaker expr_maker;
+    const auto      bigint_constant = [&](const int64_t val) {
+        return expr_maker.MakeManaged(
+            std::make_unique<parser::ConstantValueExpression>(sql::SqlTypeId::BigInt, sql::Integer(val)));
+    };
+    auto id = expr_maker.CVE(id_oid, sql::SqlTypeId::BigInt);
+    auto day = expr_maker.CVE(day_oid, sql::SqlTypeId::Date);
+
+    // SELECT id, day FROM zone_map_test WHERE <predicate>, returning the ids in order
+    const auto scan = [&](ExpressionMaker::ManagedExpression predicate) {
+        OutputSchemaHelper seq_scan_out{0, &expr_maker};
+        seq_scan_out.AddOutput("id", id);
+        seq_scan_out.AddOutput("day", day);
+        planner::SeqScanPlanNode::Builder builder;
+
+        auto seq_scan = builder.SetOutputSchema(seq_scan_out.MakeSchema())
+                            .SetColumnOids({id_oid, day_oid})
+                            .SetScanPredicate(predicate)
+                            .SetIsForUpdateFlag(false)
+                            .SetTableOid(table_oid)
+                            .Build();
+
+        std::vector<int64_t> ids;
+        RowChecker           row_checker = [&](const std::vector<sql::Val *> &vals) {
+            auto id_val = static_cast<sql::Integer *>(vals[0]);
+            auto day_val = static_cast<sql::DateVal *>(vals[1]);
+            ASSERT_EQ(day_of(id_val->val_), day_val->val_.ToNative());
+            ids.push_back(id_val->val_);
+        };
+        GenericChecker       checker(row_checker, CorrectnessFn());
+        OutputStore          store{&checker, seq_scan->GetOutputSchema().Get()};
+        MultiOutputCallback  callback{std::vector<exec::OutputCallback>{store}};
+        exec::OutputCallback callback_fn = callback.ConstructOutputCallback();
+        auto                 exec_ctx = MakeExecCtx(&callback_fn, seq_scan->GetOutputSchema().Get());
+        auto                 executable = execution::compiler::CompilationContext::Compile(*seq_scan,
+                                                                               exec_ctx->GetExecutionSettings(),
+                                                                               exec_ctx->GetAccessor());
+        executable->Run(common::ManagedPointer(exec_ctx), MODE);
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    };
+    const auto id_range = [](const int64_t first, const int64_t last) {
+        std::vector<int64_t> ids(last - first);
+        std::iota(ids.begin(), ids.end(), first);
+        return ids;
+    };
+
+    // The ranges of several columns and constant types combine, and the rows of the blocks that are read still go
+    // through the predicate
+    EXPECT_EQ(id_range(70000, 121000),
+              scan(expr_maker.ConjunctionAnd(
+                  expr_maker.ConjunctionAnd(expr_maker.ComparisonGe(id, bigint_constant(70000)),
+                                            expr_maker.ComparisonLt(id, expr_maker.Constant(130000))),
+                  expr_maker.ComparisonLe(day, expr_maker.Constant(2000, 4, 30)))));
+    EXPECT_EQ(id_range(num_rows - 1, num_rows), scan(expr_maker.ComparisonEq(id, bigint_constant(num_rows - 1))));
+    EXPECT_EQ(id_range(0, 1000), scan(expr_maker.ComparisonLt(day, expr_maker.Constant(2000, 1, 2))));
+
+    // No filter is emitted at the limits of BIGINT, and the predicate alone decides
+    EXPECT_EQ(id_range(0, 0), scan(expr_maker.ComparisonLt(id, bigint_constant(std::numeric_limits<int64_t>::min()))));
+    EXPECT_EQ(id_range(0, 0), scan(expr_maker.ComparisonGt(id, bigint_constant(std::numeric_limits<int64_t>::max()))));
+    EXPECT_EQ(id_range(0, num_rows),
+              scan(expr_maker.ComparisonLt(id, bigint_constant(std::numeric_limits<int64_t>::max()))));
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleIndexScanTest) {
     // SELECT colA, colB FROM test_1 WHERE colA = 500;
@@ -2386,6 +2556,135 @@ TEST_F(CompilerTest, SimpleNestedLoopJoinTest) {
     EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec0, exp_vec0));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, MergeJoinWithNullsAndDuplicatesTest) {
+    // SELECT t1.col2, t2.col2, t1.col1, t2.col1 FROM test_2 t1 INNER JOIN (SELECT * FROM test_2 ORDER BY col2) t2
+    // ON t1.col2=t2.col2 WHERE t1.col1 < 500 AND t2.col1 < 500
+    // test_2.col2 has about 10% NULLs and only 10 distinct values, so every key has many duplicates on both sides.
+    auto            accessor = MakeAccessor();
+    ExpressionMaker expr_maker;
+    auto            table_oid = accessor->GetTableOid(NSOid(), "test_2");
+    auto            table_schema = accessor->GetSchema(table_oid);
+    auto            col1_oid = table_schema.GetColumn("col1").Oid();
+    auto            col2_oid = table_schema.GetColumn("col2").Oid();
+
+    // Builds a scan of test_2 WHERE col1 < 500, whose outputs are read as the given child
+    const auto make_seq_scan = [&](OutputSchemaHelper *seq_scan_out) {
+        auto col1 = expr_maker.CVE(col1_oid, execution::sql::SqlTypeId::SmallInt);
+        auto col2 = expr_maker.CVE(col2_oid, execution::sql::SqlTypeId::Integer);
+        seq_scan_out->AddOutput("col1", col1);
+        seq_scan_out->AddOutput("col2", col2);
+        auto                              predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(500));
+        planner::SeqScanPlanNode::Builder builder;
+        return builder.SetOutputSchema(seq_scan_out->MakeSchema())
+            .SetColumnOids({col1_oid, col2_oid})
+            .SetScanPredicate(predicate)
+            .SetIsForUpdateFlag(false)
+            .SetTableOid(table_oid)
+            .Build();
+    };
+
+    // Compiles and runs the given plan, checking its output with the given checker
+    const auto run = [&](const planner::AbstractPlanNode &plan, OutputChecker *checker) {
+        OutputStore          store{checker, plan.GetOutputSchema().Get()};
+        MultiOutputCallback  callback{std::vector<exec::OutputCallback>{store}};
+        exec::OutputCallback callback_fn = callback.ConstructOutputCallback();
+        auto                 exec_ctx = MakeExecCtx(&callback_fn, plan.GetOutputSchema().Get());
+        auto                 executable = execution::compiler::CompilationContext::Compile(plan,
+                                                                               exec_ctx->GetExecutionSettings(),
+                                                                               exec_ctx->GetAccessor());
+        executable->Run(common::ManagedPointer(exec_ctx), MODE);
+        checker->CheckCorrectness();
+    };
+
+    // Count the rows of each key on one side of the join, which are the same on both sides
+    std::map<int64_t, uint32_t> key_counts;
+    uint32_t                    num_null_keys{0};
+    {
+        OutputSchemaHelper seq_scan_out{0, &expr_maker};
+        auto               seq_scan = make_seq_scan(&seq_scan_out);
+        RowChecker         row_checker = [&](const std::vector<sql::Val *> &vals) {
+            auto col2 = static_cast<sql::Integer *>(vals[1]);
+            if (col2->is_null_) {
+                num_null_keys++;
+            } else {
+                key_counts[col2->val_]++;
+            }
+        };
+        GenericChecker checker(row_checker, CorrectnessFn());
+        run(*seq_scan, &checker);
+    }
+    ASSERT_GT(num_null_keys, 0);
+    uint32_t num_expected_rows{0};
+    for (const auto &[key, count] : key_counts) {
+        ASSERT_GT(count, 1);
+        num_expected_rows += count * count;
+    }
+
+    // The left child
+    OutputSchemaHelper seq_scan_out1{0, &expr_maker};
+    auto               seq_scan1 = make_seq_scan(&seq_scan_out1);
+
+    // The right child, sorted on the merge key
+    OutputSchemaHelper                         seq_scan_out2{0, &expr_maker};
+    auto                                       seq_scan2 = make_seq_scan(&seq_scan_out2);
+    std::unique_ptr<planner::AbstractPlanNode> order_by;
+    OutputSchemaHelper                         order_by_out{1, &expr_maker};
+    {
+        auto col1 = seq_scan_out2.GetOutput("col1");
+        auto col2 = seq_scan_out2.GetOutput("col2");
+        order_by_out.AddOutput("col1", col1);
+        order_by_out.AddOutput("col2", col2);
+        planner::OrderByPlanNode::Builder builder;
+        order_by = builder.SetOutputSchema(order_by_out.MakeSchema())
+                       .AddChild(std::move(seq_scan2))
+                       .AddSortKey(col2, optimizer::OrderByOrderingType::ASC)
+                       .Build();
+    }
+
+    // Make merge join
+    std::unique_ptr<planner::AbstractPlanNode> merge_join;
+    OutputSchemaHelper                         merge_join_out{0, &expr_maker};
+    {
+        auto t1_col1 = seq_scan_out1.GetOutput("col1");
+        auto t1_col2 = seq_scan_out1.GetOutput("col2");
+        auto t2_col1 = order_by_out.GetOutput("col1");
+        auto t2_col2 = order_by_out.GetOutput("col2");
+        merge_join_out.AddOutput("t1.col2", t1_col2);
+        merge_join_out.AddOutput("t2.col2", t2_col2);
+        merge_join_out.AddOutput("t1.col1", t1_col1);
+        merge_join_out.AddOutput("t2.col1", t2_col1);
+        auto                                predicate = expr_maker.ComparisonEq(t1_col2, t2_col2);
+        planner::MergeJoinPlanNode::Builder builder;
+        merge_join = builder.AddChild(std::move(seq_scan1))
+                         .AddChild(std::move(order_by))
+                         .SetOutputSchema(merge_join_out.MakeSchema())
+                         .AddLeftMergeKey(t1_col2)
+                         .AddRightMergeKey(t2_col2)
+                         .SetJoinType(planner::LogicalJoinType::INNER)
+                         .SetJoinPredicate(predicate)
+                         .Build();
+    }
+
+    // Every pair of rows with equal non-NULL keys is output exactly once, and no row with a NULL key is
+    uint32_t                              num_output_rows{0};
+    std::set<std::pair<int64_t, int64_t>> output_pairs;
+    RowChecker                            row_checker = [&](const std::vector<sql::Val *> &vals) {
+        auto t1_col2 = static_cast<sql::Integer *>(vals[0]);
+        auto t2_col2 = static_cast<sql::Integer *>(vals[1]);
+        auto t1_col1 = static_cast<sql::Integer *>(vals[2]);
+        auto t2_col1 = static_cast<sql::Integer *>(vals[3]);
+        ASSERT_FALSE(t1_col2->is_null_ || t2_col2->is_null_);
+        ASSERT_EQ(t1_col2->val_, t2_col2->val_);
+        ASSERT_TRUE(output_pairs.emplace(t1_col1->val_, t2_col1->val_).second);
+        num_output_rows++;
+        ASSERT_LE(num_output_rows, num_expected_rows);
+    };
+    CorrectnessFn  correctness_fn = [&]() { ASSERT_EQ(num_output_rows, num_expected_rows); };
+    GenericChecker checker(row_checker, correctness_fn);
+    run(*merge_join, &checker);
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleIndexNestedLoopJoinTest) {
     // SELECT t1.col1, t2.col1, t2.col2, t1.col2 + t2.col2 FROM test_2 AS t2 INNER JOIN test_1 AS t1 ON t1.col1=t2.col1
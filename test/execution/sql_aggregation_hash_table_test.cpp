@@ -462,4 +462,151 @@ TEST_F(AggregationHashTableTest, ParallelAggregationTest) {
     EXPECT_EQ(num_aggs, query_state.row_count_.load(std::memory_order_seq_cst));
 }
 
+
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, ParallelSpillTest) {
+    auto                     exec_ctx = MakeExecCtx();
+    tbb::task_scheduler_init sched;
+
+    // With a tiny budget, the thread-local tables spill their overflow partitions every time they have flushed enough
+    // entries.
+    exec_ctx->GetMemoryPool()->GetTracker()->SetBudget(1);
+
+    // The whole-query state.
+    struct QueryState {
+        std::atomic<uint32_t> row_count_;
+        std::atomic<uint32_t> wrong_count_;
+    };
+
+    QueryState           query_state{{0}, {0}};
+    MemoryPool           memory(nullptr);
+    ThreadStateContainer container(&memory);
+
+    container.Reset(
+        sizeof(AggregationHashTable),
+        [](void *ctx, void *aht) {
+            auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+            new (aht) AggregationHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(AggTuple));
+        },
+        [](void *ctx, void *aht) {
+            std::destroy_at(reinterpret_cast<AggregationHashTable *>(aht));
+        },
+        exec_ctx.get());
+
+    // Every thread aggregates every key once, so each aggregate spans several thread-local tables and spill files.
+    constexpr uint32_t num_threads = 4;
+    constexpr uint32_t num_aggs = 100000;
+    LaunchParallel(num_threads, [&](auto tid) {
+        auto agg_table = container.AccessCurrentThreadStateAs<AggregationHashTable>();
+        for (uint32_t idx = 0; idx < num_aggs; idx++) {
+            InputTuple input(idx, 1);
+            auto      *existing = reinterpret_cast<AggTuple *>(
+                agg_table->Lookup(input.Hash(), AggTupleKeyEq, reinterpret_cast<const void *>(&input)));
+            if (existing != nullptr) {
+                existing->Advance(input);
+            } else {
+                auto *new_agg = agg_table->AllocInputTuplePartitioned(input.Hash());
+                new (new_agg) AggTuple(input);
+            }
+        }
+    });
+
+    uint64_t num_spills = 0;
+    container.ForEach<AggregationHashTable>([&](AggregationHashTable *agg_table) {
+        num_spills += agg_table->GetStatistics()->num_spills_;
+    });
+    EXPECT_GT(num_spills, 0);
+
+    // Spilled partitions are merged just like the ones still in memory.
+    AggregationHashTable main_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(AggTuple));
+    main_table.TransferMemoryAndPartitions(
+        &container,
+        0,
+        [](void *ctx, AggregationHashTable *table, AHTOverflowPartitionIterator *iter) {
+            for (; iter->HasNext(); iter->Next()) {
+                auto *partial_agg = iter->GetRowAs<AggTuple>();
+                auto *existing
+                    = reinterpret_cast<AggTuple *>(table->Lookup(iter->GetRowHash(), AggAggKeyEq, partial_agg));
+                if (existing != nullptr) {
+                    existing->Merge(*partial_agg);
+                } else {
+                    table->Insert(iter->GetEntryForRow());
+                }
+            }
+        });
+
+    container.Clear();
+
+    main_table.ExecuteParallelPartitionedScan(
+        &query_state,
+        &container,
+        [](void *query_state, void *thread_state, const AggregationHashTable *agg_table) {
+            auto *qs = reinterpret_cast<QueryState *>(query_state);
+            for (AHTIterator iter(*agg_table); iter.HasNext(); iter.Next()) {
+                auto *agg = reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow());
+                if (agg->count1_ != num_threads || agg->count2_ != num_threads * 2
+                    || agg->count3_ != num_threads * 10) {
+                    qs->wrong_count_++;
+                }
+                qs->row_count_++;
+            }
+        });
+
+    EXPECT_EQ(num_aggs, query_state.row_count_.load(std::memory_order_seq_cst));
+    EXPECT_EQ(0, query_state.wrong_count_.load(std::memory_order_seq_cst));
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, SerialSpillTest) {
+    auto exec_ctx = MakeExecCtx();
+
+    // With a tiny budget, the table switches to partitioned mode the first time it has to grow with enough entries to
+    // spill, and spills its overflow partitions from then on.
+    exec_ctx->GetMemoryPool()->GetTracker()->SetBudget(1);
+    AggregationHashTable agg_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(AggTuple));
+
+    // Aggregate every key twice, so most aggregates are split across the main table and several spills.
+    constexpr uint32_t num_rounds = 2;
+    constexpr uint32_t num_aggs = 100000;
+    for (uint32_t round = 0; round < num_rounds; round++) {
+        for (uint32_t idx = 0; idx < num_aggs; idx++) {
+            InputTuple input(idx, 1);
+            auto      *existing = reinterpret_cast<AggTuple *>(
+                agg_table.Lookup(input.Hash(), AggTupleKeyEq, reinterpret_cast<const void *>(&input)));
+            if (existing != nullptr) {
+                existing->Advance(input);
+            } else {
+                new (agg_table.AllocInputTuple(input.Hash())) AggTuple(input);
+            }
+        }
+    }
+    EXPECT_GT(agg_table.GetStatistics()->num_spills_, 0);
+
+    // Merging the partitions back in leaves exactly one complete aggregate per key in the main table.
+    agg_table.MergeOverflowPartitions(
+        nullptr,
+        [](void *ctx, AggregationHashTable *table, AHTOverflowPartitionIterator *iter) {
+            for (; iter->HasNext(); iter->Next()) {
+                auto *partial_agg = iter->GetRowAs<AggTuple>();
+                auto *existing
+                    = reinterpret_cast<AggTuple *>(table->Lookup(iter->GetRowHash(), AggAggKeyEq, partial_agg));
+                if (existing != nullptr) {
+                    existing->Merge(*partial_agg);
+                } else {
+                    table->Insert(iter->GetEntryForRow());
+                }
+            }
+        });
+    EXPECT_EQ(num_aggs, agg_table.GetTupleCount());
+
+    uint32_t wrong_count = 0;
+    for (AHTIterator iter(agg_table); iter.HasNext(); iter.Next()) {
+        auto *agg = reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow());
+        if (agg->count1_ != num_rounds || agg->count2_ != num_rounds * 2 || agg->count3_ != num_rounds * 10) {
+            wrong_count++;
+        }
+    }
+    EXPECT_EQ(0, wrong_count);
+}
+
 } // namespace noisepage::execution::sql
@@ -0,0 +1,242 @@
+#include "execution/sql/bulk_loader.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/catalog_accessor.h"
+#include "catalog/catalog_defs.h"
+#include "common/error/exception.h"
+#include "main/db_main.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/constant_value_expression.h"
+#include "storage/index/index.h"
+#include "storage/index/index_builder.h"
+#include "storage/sql_table.h"
+#include "storage/storage_util.h"
+#include "test_util/test_harness.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+#include "util/portable_endian.h"
+
+namespace noisepage::execution::sql::test {
+
+class BulkLoaderTest : public TerrierTest {
+public:
+    void SetUp() override {
+        db_main_ = noisepage::DBMain::Builder().SetUseGC(true).SetUseCatalog(true).Build();
+        txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+        catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+
+        auto *txn = txn_manager_->BeginTransaction();
+        db_ = catalog_->GetDatabaseOid(common::ManagedPointer(txn), catalog::DEFAULT_DATABASE);
+        auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, DISABLED);
+
+        // CREATE TABLE bulk_load_test (id INTEGER NOT NULL PRIMARY KEY, name VARCHAR)
+        std::vector<catalog::Schema::Column> cols;
+        cols.emplace_back("id",
+                          execution::sql::SqlTypeId::Integer,
+                          false,
+                          parser::ConstantValueExpression(execution::sql::SqlTypeId::Integer));
+        cols.emplace_back("name",
+                          execution::sql::SqlTypeId::Varchar,
+                          100,
+                          true,
+                          parser::ConstantValueExpression(execution::sql::SqlTypeId::Varchar));
+        table_oid_ = accessor->CreateTable(accessor->GetDefaultNamespace(), "bulk_load_test", catalog::Schema(cols));
+        const auto &schema = accessor->GetSchema(table_oid_);
+        table_ = new storage::SqlTable(db_main_->GetStorageLayer()->GetBlockStore(), schema);
+        accessor->SetTablePointer(table_oid_, table_);
+
+        std::vector<catalog::IndexSchema::Column> key_cols{catalog::IndexSchema::Column{
+            "id",
+            execution::sql::SqlTypeId::Integer,
+            false,
+            parser::ColumnValueExpression(db_, table_oid_, schema.GetColumn("id").Oid())}};
+        catalog::IndexOptions options;
+        auto                  index_schema
+            = catalog::IndexSchema(key_cols, storage::index::IndexType::BPLUSTREE, true, true, false, true, options);
+        const auto index_oid
+            = accessor->CreateIndex(accessor->GetDefaultNamespace(), table_oid_, "bulk_load_test_pkey", index_schema);
+        storage::index::IndexBuilder index_builder;
+        index_builder.SetKeySchema(accessor->GetIndexSchema(index_oid));
+        index_ = index_builder.Build();
+        accessor->SetIndexPointer(index_oid, index_);
+        txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+        path_ = "bulk_loader_test_" + std::to_string(::getpid()) + ".dat";
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+    }
+
+    void WriteFile(const std::string &contents) {
+        std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+        out.write(contents.data(), contents.size());
+    }
+
+    // Load the file through a new transaction, which is committed if the load succeeds and aborted otherwise.
+    uint64_t Load(const bool binary) {
+        auto *txn = txn_manager_->BeginTransaction();
+        auto  accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, DISABLED);
+        try {
+            BulkLoader loader{common::ManagedPointer(accessor), db_, table_oid_, common::ManagedPointer(txn)};
+            const uint64_t num_rows = binary ? loader.LoadBinary(path_) : loader.LoadCsv(path_, ',', '"', '"');
+            txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+            return num_rows;
+        } catch (...) {
+            txn_manager_->Abort(txn);
+            throw;
+        }
+    }
+
+    // Read the visible rows of the table, as (id, name) pairs with an empty name for NULL.
+    std::vector<std::pair<int32_t, std::string>> ReadRows(transaction::TransactionContext *txn) {
+        const auto initializer = table_->InitializerForProjectedRow({catalog::col_oid_t(1), catalog::col_oid_t(2)});
+        const auto map = table_->ProjectionMapForOids({catalog::col_oid_t(1), catalog::col_oid_t(2)});
+        auto      *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+        auto      *row = initializer.InitializeRow(buffer);
+
+        std::vector<std::pair<int32_t, std::string>> rows;
+        for (auto it = table_->begin(); it != table_->end(); it++) {
+            if (table_->Select(common::ManagedPointer(txn), *it, row)) {
+                const auto *name_ptr = row->AccessWithNullCheck(map.at(catalog::col_oid_t(2)));
+                const auto *name = reinterpret_cast<const storage::VarlenEntry *>(name_ptr);
+                rows.emplace_back(*reinterpret_cast<int32_t *>(row->AccessWithNullCheck(map.at(catalog::col_oid_t(1)))),
+                                  name == nullptr ? "" : std::string(name->StringView()));
+            }
+        }
+        delete[] buffer;
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    // Count the entries of the primary key index with the given key.
+    size_t CountKeys(transaction::TransactionContext *txn, const int32_t id) {
+        auto *buffer = common::AllocationUtil::AllocateAligned(index_->GetProjectedRowInitializer().ProjectedRowSize());
+        auto *key = index_->GetProjectedRowInitializer().InitializeRow(buffer);
+        *reinterpret_cast<int32_t *>(key->AccessForceNotNull(0)) = id;
+        std::vector<storage::TupleSlot> results;
+        index_->ScanKey(*txn, *key, &results);
+        delete[] buffer;
+        return results.size();
+    }
+
+    std::unique_ptr<DBMain>                                 db_main_;
+    common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+    common::ManagedPointer<catalog::Catalog>                catalog_;
+    catalog::db_oid_t                                       db_;
+    catalog::table_oid_t                                    table_oid_;
+    storage::SqlTable                                      *table_;
+    storage::index::Index                                  *index_;
+    std::string                                             path_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(BulkLoaderTest, LoadCsv) {
+    const std::string long_name(100, 'x');
+    WriteFile("1,one\n2,\n3,\"three, quoted\"\n4," + long_name + "\n");
+
+    // A transaction that started before the load does not see the loaded rows, even after it commits.
+    auto *old_txn = txn_manager_->BeginTransaction();
+    EXPECT_EQ(4, Load(false));
+    EXPECT_TRUE(ReadRows(old_txn).empty());
+    txn_manager_->Commit(old_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    auto      *txn = txn_manager_->BeginTransaction();
+    const auto rows = ReadRows(txn);
+    ASSERT_EQ(4, rows.size());
+    EXPECT_EQ(std::make_pair(1, std::string("one")), rows[0]);
+    EXPECT_EQ(std::make_pair(2, std::string()), rows[1]);
+    EXPECT_EQ(std::make_pair(3, std::string("three, quoted")), rows[2]);
+    EXPECT_EQ(std::make_pair(4, long_name), rows[3]);
+    for (int32_t id = 1; id <= 4; id++) {
+        EXPECT_EQ(1, CountKeys(txn, id));
+    }
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+// NOLINTNEXTLINE
+TEST_F(BulkLoaderTest, LoadBinary) {
+    // Header, then two rows and the trailer, all in network byte order.
+    std::string contents("PGCOPY\n\377\r\n\0", 11);
+    const auto  append_int32 = [&](const int32_t value) {
+        const uint32_t raw = htobe32(static_cast<uint32_t>(value));
+        contents.append(reinterpret_cast<const char *>(&raw), sizeof(raw));
+    };
+    const auto append_int16 = [&](const int16_t value) {
+        const uint16_t raw = htobe16(static_cast<uint16_t>(value));
+        contents.append(reinterpret_cast<const char *>(&raw), sizeof(raw));
+    };
+    append_int32(0);
+    append_int32(0);
+
+    append_int16(2);
+    append_int32(sizeof(int32_t));
+    append_int32(7);
+    append_int32(5);
+    contents += "seven";
+
+    append_int16(2);
+    append_int32(sizeof(int32_t));
+    append_int32(8);
+    append_int32(-1);
+
+    append_int16(-1);
+    WriteFile(contents);
+
+    EXPECT_EQ(2, Load(true));
+    auto      *txn = txn_manager_->BeginTransaction();
+    const auto rows = ReadRows(txn);
+    ASSERT_EQ(2, rows.size());
+    EXPECT_EQ(std::make_pair(7, std::string("seven")), rows[0]);
+    EXPECT_EQ(std::make_pair(8, std::string()), rows[1]);
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+// NOLINTNEXTLINE
+TEST_F(BulkLoaderTest, AbortRollsBackLoad) {
+    WriteFile("1,one\n2,two\n");
+
+    auto *txn = txn_manager_->BeginTransaction();
+    auto  accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, DISABLED);
+    {
+        BulkLoader loader{common::ManagedPointer(accessor), db_, table_oid_, common::ManagedPointer(txn)};
+        EXPECT_EQ(2, loader.LoadCsv(path_, ',', '"', '"'));
+    }
+    EXPECT_EQ(2, ReadRows(txn).size());
+    txn_manager_->Abort(txn);
+
+    txn = txn_manager_->BeginTransaction();
+    EXPECT_TRUE(ReadRows(txn).empty());
+    EXPECT_EQ(0, CountKeys(txn, 1));
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // The keys of the rolled back rows can be loaded again.
+    EXPECT_EQ(2, Load(false));
+}
+
+// NOLINTNEXTLINE
+TEST_F(BulkLoaderTest, ConstraintViolations) {
+    WriteFile("1,one\n,two\n");
+    EXPECT_THROW(Load(false), ExecutionException);
+
+    WriteFile("1,one\n2,two\n1,again\n");
+    EXPECT_THROW(Load(false), ExecutionException);
+
+    WriteFile("1,one\nx,two\n");
+    EXPECT_THROW(Load(false), ExecutionException);
+
+    // None of the failed loads left rows behind.
+    auto *txn = txn_manager_->BeginTransaction();
+    EXPECT_TRUE(ReadRows(txn).empty());
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+} // namespace noisepage::execution::sql::test
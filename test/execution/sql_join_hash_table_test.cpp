@@ -223,6 +223,111 @@ TEST_F(JoinHashTableTest, ParallelBuildTest) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, RadixPartitionedParallelBuildTest) {
+    auto                     exec_ctx = MakeExecCtx();
+    exec::ExecutionSettings  exec_settings{};
+    tbb::task_scheduler_init sched;
+
+    const uint32_t num_tuples = 10000;
+    const uint32_t num_thread_local_tables = 4;
+
+    ThreadStateContainer container(exec_ctx->GetMemoryPool());
+
+    struct Context {
+        exec::ExecutionContext  *exec_ctx_;
+        exec::ExecutionSettings *settings_;
+    };
+
+    Context ctx{exec_ctx.get(), &exec_settings};
+
+    container.Reset(
+        sizeof(JoinHashTable),
+        [](auto *ctx, auto *s) {
+            auto context = reinterpret_cast<Context *>(ctx);
+            new (s) JoinHashTable(*context->settings_, context->exec_ctx_, sizeof(Tuple));
+        },
+        [](auto *ctx, auto *s) {
+            reinterpret_cast<JoinHashTable *>(s)->~JoinHashTable();
+        },
+        &ctx);
+
+    LaunchParallel(num_thread_local_tables, [&](auto tid) {
+        auto *jht = container.AccessCurrentThreadStateAs<JoinHashTable>();
+        PopulateJoinHashTable(jht, num_tuples, 1);
+    });
+
+    // The build is small enough to fit in cache, so force radix partitioning.
+    JoinHashTable main_jht(exec_settings, exec_ctx.get(), sizeof(Tuple));
+    main_jht.SetMergeMode(JoinHashTable::MergeMode::RadixPartitioned);
+    main_jht.MergeParallel(&container, 0);
+
+    EXPECT_TRUE(main_jht.UsingRadixPartitions());
+    EXPECT_GE(main_jht.GetNumRadixPartitions(), 2u);
+    EXPECT_EQ(num_tuples * num_thread_local_tables, main_jht.GetTupleCount());
+
+    // Every key has one duplicate per thread-local table.
+    for (uint32_t i = 0; i < num_tuples; i++) {
+        auto     probe = Tuple{i, 1, 2, 3};
+        uint32_t count = 0;
+        for (auto iter = main_jht.Lookup<false>(probe.Hash()); iter.HasNext();) {
+            auto *matched = reinterpret_cast<const Tuple *>(iter.GetMatchPayload());
+            if (matched->a_ == probe.a_) {
+                count++;
+            }
+        }
+        EXPECT_EQ(num_thread_local_tables, count);
+    }
+
+    // Iteration visits every tuple.
+    uint32_t num_iterated = 0;
+    for (JoinHashTableIterator iter(main_jht); iter.HasNext(); iter.Next()) {
+        num_iterated++;
+    }
+    EXPECT_EQ(num_tuples * num_thread_local_tables, num_iterated);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, SpillTest) {
+    auto                    exec_ctx = MakeExecCtx();
+    exec::ExecutionSettings exec_settings{};
+
+    // With a tiny budget, the table spills every time it has buffered enough tuples.
+    exec_ctx->GetMemoryPool()->GetTracker()->SetBudget(1);
+
+    const uint32_t num_tuples = 50000;
+    const uint32_t dup_scale_factor = 2;
+
+    JoinHashTable join_hash_table(exec_settings, exec_ctx.get(), sizeof(Tuple));
+    PopulateJoinHashTable(&join_hash_table, num_tuples, dup_scale_factor);
+    EXPECT_EQ(num_tuples * dup_scale_factor, join_hash_table.GetTupleCount());
+    EXPECT_LT(join_hash_table.GetBufferedTupleMemoryUsage(), num_tuples * dup_scale_factor * sizeof(Tuple));
+
+    join_hash_table.Build();
+    EXPECT_EQ(num_tuples * dup_scale_factor, join_hash_table.GetTupleCount());
+
+    // Spilled tuples are found just like buffered ones.
+    for (uint32_t i = 0; i < num_tuples; i++) {
+        auto     probe = Tuple{i, 1, 2, 3};
+        uint32_t count = 0;
+        for (auto iter = join_hash_table.Lookup<false>(probe.Hash()); iter.HasNext();) {
+            auto *matched = reinterpret_cast<const Tuple *>(iter.GetMatchPayload());
+            if (matched->a_ == probe.a_) {
+                count++;
+            }
+        }
+        EXPECT_EQ(dup_scale_factor, count);
+    }
+
+    // Iteration visits every tuple, buffered or spilled.
+    uint32_t num_iterated = 0;
+    for (JoinHashTableIterator iter(join_hash_table); iter.HasNext(); iter.Next()) {
+        EXPECT_LT(iter.GetCurrentRowAs<Tuple>()->a_, num_tuples);
+        num_iterated++;
+    }
+    EXPECT_EQ(num_tuples * dup_scale_factor, num_iterated);
+}
+
 #if 0
 // NOLINTNEXTLINE
 TEST_F(JoinHashTableTest, PerfTest) {
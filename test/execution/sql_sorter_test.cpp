@@ -273,4 +273,44 @@ TEST_F(SorterTest, UnbalancedParallelSortTest) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(SorterTest, SpillSortTest) {
+    auto exec_ctx = MakeExecCtx();
+
+    // With a tiny budget, sorters spill sorted runs every time they have buffered enough tuples.
+    exec_ctx->GetMemoryPool()->GetTracker()->SetBudget(1);
+
+    const auto cmp_fn = [](const void *left, const void *right) {
+        return reinterpret_cast<const TestTuple<2> *>(left)->Compare(*reinterpret_cast<const TestTuple<2> *>(right));
+    };
+
+    const uint32_t num_tuples = 100000;
+    Sorter         sorter(exec_ctx.get(), cmp_fn, sizeof(TestTuple<2>));
+    for (uint32_t i = 0; i < num_tuples; i++) {
+        auto *elem = reinterpret_cast<TestTuple<2> *>(sorter.AllocInputTuple());
+        elem->key_ = generator_() % 3333;
+    }
+    EXPECT_EQ(num_tuples, sorter.GetTupleCount());
+
+    sorter.Sort();
+    EXPECT_TRUE(sorter.IsSorted());
+    EXPECT_EQ(num_tuples, sorter.GetTupleCount());
+
+    uint32_t            num_iterated = 0;
+    const TestTuple<2> *prev = nullptr;
+    for (SorterIterator iter(sorter); iter.HasNext(); iter.Next()) {
+        auto *curr = iter.GetRowAs<TestTuple<2>>();
+        if (prev != nullptr) {
+            EXPECT_LE(cmp_fn(prev, curr), 0);
+        }
+        prev = curr;
+        num_iterated++;
+    }
+    EXPECT_EQ(num_tuples, num_iterated);
+
+    // Spilled thread-local sorters are merged in parallel, too.
+    TestParallelSort<2>(exec_ctx.get(), {100000, 100000, 100000, 100000});
+    TestParallelSort<2>(exec_ctx.get(), {100000, 0, 10, 100000});
+}
+
 } // namespace noisepage::execution::sql::test
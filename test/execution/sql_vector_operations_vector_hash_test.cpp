@@ -1,6 +1,10 @@
 #include <random>
+#include <string>
+#include <vector>
 
+#include "common/error/exception.h"
 #include "execution/sql/operators/hash_operators.h"
+#include "execution/sql/tuple_id_list.h"
 #include "execution/sql/vector.h"
 #include "execution/sql/vector_operations/vector_operations.h"
 #include "execution/sql_test.h"
@@ -97,4 +101,110 @@ TEST_F(VectorHashTest, StringHash) {
     EXPECT_EQ(Hash<storage::VarlenEntry>{}(raw_input[3], input->IsNull(3)), raw_hash[3]);
 }
 
+// NOLINTNEXTLINE
+TEST_F(VectorHashTest, HashCombineWithFilter) {
+    // Enough rows to use the SIMD multiply and its tail, with strings both inlined and not
+    const uint32_t num_rows = 203;
+    auto           bools = MakeBooleanVector(num_rows);
+    auto           dates = MakeDateVector(num_rows);
+    auto           timestamps = MakeVector(TypeId::Timestamp, num_rows);
+    auto           strings = MakeVarcharVector(num_rows);
+    // Vector::SetValue() doesn't support timestamps, so they're written directly
+    auto raw_timestamps = reinterpret_cast<Timestamp *>(timestamps->GetData());
+    for (uint32_t i = 0; i < num_rows; i++) {
+        if (i % 11 == 0) {
+            bools->SetValue(i, GenericValue::CreateNull(TypeId::Boolean));
+        } else {
+            bools->SetValue(i, GenericValue::CreateBoolean(i % 2 == 0));
+        }
+        dates->SetValue(i, GenericValue::CreateDate(Date::FromYMD(2000 + i % 20, 1 + i % 12, 1 + i % 28)));
+        raw_timestamps[i] = Timestamp::FromYMDHMS(2000 + i % 20, 1 + i % 12, 1 + i % 28, i % 24, 0, 0);
+        if (i % 7 == 0) {
+            strings->SetValue(i, GenericValue::CreateNull(TypeId::Varchar));
+        } else {
+            strings->SetValue(i, GenericValue::CreateVarchar(std::string(i % 40, static_cast<char>('a' + i % 26))));
+        }
+    }
+
+    auto tid_list = TupleIdList(num_rows);
+    for (uint32_t i = 0; i < num_rows; i++) {
+        if (i % 3 != 0) {
+            tid_list.Add(i);
+        }
+    }
+    for (auto *vec : {bools.get(), dates.get(), timestamps.get(), strings.get()}) {
+        vec->SetFilteredTupleIdList(&tid_list, tid_list.GetTupleCount());
+    }
+
+    auto hash = MakeVector(TypeId::Hash, num_rows);
+    VectorOps::Hash(*bools, hash.get());
+    VectorOps::HashCombine(*dates, hash.get());
+    VectorOps::HashCombine(*timestamps, hash.get());
+    VectorOps::HashCombine(*strings, hash.get());
+
+    EXPECT_EQ(num_rows, hash->GetSize());
+    EXPECT_EQ(tid_list.GetTupleCount(), hash->GetCount());
+    EXPECT_EQ(&tid_list, hash->GetFilteredTupleIdList());
+
+    auto raw_bools = reinterpret_cast<const bool *>(bools->GetData());
+    auto raw_dates = reinterpret_cast<const Date *>(dates->GetData());
+    auto raw_strings = reinterpret_cast<const storage::VarlenEntry *>(strings->GetData());
+    auto raw_hash = reinterpret_cast<const hash_t *>(hash->GetData());
+    tid_list.ForEach([&](uint64_t i) {
+        hash_t expected = Hash<bool>{}(raw_bools[i], bools->GetNullMask()[i]);
+        expected = HashCombine<Date>{}(raw_dates[i], false, expected);
+        expected = HashCombine<Timestamp>{}(raw_timestamps[i], false, expected);
+        expected = HashCombine<storage::VarlenEntry>{}(raw_strings[i], strings->GetNullMask()[i], expected);
+        EXPECT_EQ(expected, raw_hash[i]) << "row " << i;
+    });
+}
+
+// NOLINTNEXTLINE
+TEST_F(VectorHashTest, MultiColumnHash) {
+    const uint32_t num_rows = 100;
+    auto           ints = MakeIntegerVector(num_rows);
+    auto           doubles = MakeDoubleVector(num_rows);
+    auto           strings = MakeVarcharVector(num_rows);
+    for (uint32_t i = 0; i < num_rows; i++) {
+        ints->SetValue(i, i % 5 == 0 ? GenericValue::CreateNull(TypeId::Integer) : GenericValue::CreateInteger(i));
+        doubles->SetValue(i, GenericValue::CreateDouble(i * 1.5));
+        strings->SetValue(i, GenericValue::CreateVarchar(std::string(i % 30, 'x')));
+    }
+
+    const auto check = [&] {
+        // Hashing all columns at once must match hashing them one at a time
+        auto expected = MakeVector(TypeId::Hash, num_rows);
+        VectorOps::Hash(*ints, expected.get());
+        VectorOps::HashCombine(*doubles, expected.get());
+        VectorOps::HashCombine(*strings, expected.get());
+
+        auto hash = MakeVector(TypeId::Hash, num_rows);
+        VectorOps::Hash({ints.get(), doubles.get(), strings.get()}, hash.get());
+
+        EXPECT_EQ(expected->GetCount(), hash->GetCount());
+        EXPECT_EQ(expected->GetFilteredTupleIdList(), hash->GetFilteredTupleIdList());
+        auto raw_expected = reinterpret_cast<const hash_t *>(expected->GetData());
+        auto raw_hash = reinterpret_cast<const hash_t *>(hash->GetData());
+        VectorOps::Exec(*hash, [&](uint64_t i, uint64_t k) {
+            EXPECT_EQ(raw_expected[i], raw_hash[i]);
+        });
+    };
+
+    // Unfiltered
+    check();
+
+    // Filtered
+    auto tid_list = TupleIdList(num_rows);
+    tid_list = {1, 2, 3, 10, 20, 33, 50, 97, 99};
+    for (auto *vec : {ints.get(), doubles.get(), strings.get()}) {
+        vec->SetFilteredTupleIdList(&tid_list, tid_list.GetTupleCount());
+    }
+    check();
+
+    // Vectors with different filters can't be hashed together
+    auto hash = MakeVector(TypeId::Hash, num_rows);
+    strings->SetFilteredTupleIdList(nullptr, num_rows);
+    EXPECT_THROW(VectorOps::Hash({ints.get(), strings.get()}, hash.get()), ExecutionException);
+}
+
 } // namespace noisepage::execution::sql::test
@@ -1,5 +1,9 @@
+#include <string_view>
+#include <vector>
+
 #include "common/error/exception.h"
 #include "execution/sql/constant_vector.h"
+#include "execution/sql/operators/like_operators.h"
 #include "execution/sql/tuple_id_list.h"
 #include "execution/sql/vector.h"
 #include "execution/sql/vector_operations/vector_operations.h"
@@ -75,6 +79,59 @@ TEST_F(VectorLikeTest, LikeConstant) {
     EXPECT_EQ(0u, tid_list.GetTupleCount());
 }
 
+// NOLINTNEXTLINE
+TEST_F(VectorLikeTest, LikeConstantSimplePatterns) {
+    exec::ExecutionSettings             exec_settings{};
+    const std::vector<std::string_view> vals = {"",
+                                                "a",
+                                                "abc",
+                                                "xabc",
+                                                "abcx",
+                                                "xxabcxx",
+                                                "ab%c",
+                                                "the quick brown fox jumps over the lazy dog",
+                                                "the quick brown fox jumps over the lazy cat",
+                                                "ABC"};
+    std::vector<bool>                   nulls(vals.size(), false);
+    nulls[3] = true;
+    auto strings = MakeVarcharVector(vals, nulls);
+    auto tid_list = TupleIdList(strings->GetSize());
+
+    // Exact, prefix, suffix, substring and match-all patterns are evaluated without the general matcher; the rest
+    // still go through it
+    for (const std::string_view pattern : {"",
+                                           "abc",
+                                           "abc%",
+                                           "%abc",
+                                           "%abc%",
+                                           "%%abc%%",
+                                           "%",
+                                           "%%",
+                                           "%lazy dog",
+                                           "the quick%",
+                                           "%fox jumps over%",
+                                           "a%c",
+                                           "%b_c%",
+                                           "%b\\%c%"}) {
+        const auto cv = ConstantVector(GenericValue::CreateVarchar(pattern));
+        const auto pattern_entry = storage::VarlenEntry::Create(pattern);
+
+        tid_list.AddAll();
+        VectorOps::SelectLike(exec_settings, *strings, cv, &tid_list);
+        for (uint32_t i = 0; i < vals.size(); i++) {
+            const bool like = Like{}(storage::VarlenEntry::Create(vals[i]), pattern_entry);
+            EXPECT_EQ(!nulls[i] && like, tid_list.Contains(i)) << "'" << vals[i] << "' LIKE '" << pattern << "'";
+        }
+
+        tid_list.AddAll();
+        VectorOps::SelectNotLike(exec_settings, *strings, cv, &tid_list);
+        for (uint32_t i = 0; i < vals.size(); i++) {
+            const bool like = Like{}(storage::VarlenEntry::Create(vals[i]), pattern_entry);
+            EXPECT_EQ(!nulls[i] && !like, tid_list.Contains(i)) << "'" << vals[i] << "' NOT LIKE '" << pattern << "'";
+        }
+    }
+}
+
 // NOLINTNEXTLINE
 TEST_F(VectorLikeTest, LikeVectorOfPatterns) {
     exec::ExecutionSettings exec_settings{};
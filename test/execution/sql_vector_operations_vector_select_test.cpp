@@ -1,3 +1,4 @@
+#include <string_view>
 #include <vector>
 
 #include "common/error/exception.h"
@@ -224,6 +225,56 @@ TEST_F(VectorSelectTest, StringSelection) {
     EXPECT_EQ(4u, tid_list[2]);
 }
 
+// NOLINTNEXTLINE
+TEST_F(VectorSelectTest, StringSelectionConstant) {
+    exec::ExecutionSettings exec_settings{};
+
+    // Strings that share sizes and prefixes, so the prefilter alone can't decide all of them
+    const std::vector<std::string_view> pool
+        = {"", "abc", "abcd", "abcx", "abcde", "abcdefghijklmnop", "abcdefghijklmnoq", "xbcdefghijklmnop"};
+    std::vector<std::string_view> vals;
+    std::vector<bool>             nulls;
+    for (uint32_t i = 0; i < 150; i++) {
+        vals.push_back(pool[(i * 5) % pool.size()]);
+        nulls.push_back(i % 7 == 0);
+    }
+    auto a = MakeVarcharVector(vals, nulls);
+    auto tid_list = TupleIdList(a->GetSize());
+
+    for (const auto &constant : pool) {
+        const auto cv = ConstantVector(GenericValue::CreateVarchar(constant));
+
+        // Both with all TIDs selected, and with too few selected for the prefilter to pay off
+        for (const uint32_t step : {1u, 8u}) {
+            const auto select_every = [&](uint32_t n) {
+                tid_list.Clear();
+                for (uint32_t i = 0; i < a->GetSize(); i += n) {
+                    tid_list.Add(i);
+                }
+            };
+
+            select_every(step);
+            VectorOps::SelectEqual(exec_settings, *a, cv, &tid_list);
+            for (uint32_t i = 0; i < a->GetSize(); i++) {
+                EXPECT_EQ(i % step == 0 && !nulls[i] && vals[i] == constant, tid_list.Contains(i));
+            }
+
+            select_every(step);
+            VectorOps::SelectNotEqual(exec_settings, *a, cv, &tid_list);
+            for (uint32_t i = 0; i < a->GetSize(); i++) {
+                EXPECT_EQ(i % step == 0 && !nulls[i] && vals[i] != constant, tid_list.Contains(i));
+            }
+
+            // The constant on the left
+            select_every(step);
+            VectorOps::SelectEqual(exec_settings, cv, *a, &tid_list);
+            for (uint32_t i = 0; i < a->GetSize(); i++) {
+                EXPECT_EQ(i % step == 0 && !nulls[i] && vals[i] == constant, tid_list.Contains(i));
+            }
+        }
+    }
+}
+
 // NOLINTNEXTLINE
 TEST_F(VectorSelectTest, IsNullAndIsNotNull) {
     auto vec = MakeFloatVector({1.0, 0.0, 1.0, 0.0, 0.0, 1.0, 1.0}, {false, true, false, true, true, false, false});
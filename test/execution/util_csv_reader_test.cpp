@@ -1,9 +1,8 @@
+#include "execution/util/csv_reader.h"
+
 #include "execution/tpl_test.h"
-// #include "execution/util/csv_reader.h" Fix later.
 #include "execution/util/file.h"
 
-// TODO(WAN): csv is broken.
-#if 0
 namespace noisepage::execution::util::test {
 
 class CSVReaderTest : public TplTest {
@@ -139,4 +138,3 @@ TEST_F(CSVReaderTest, CheckUnquoted) {
 }
 
 }  // namespace noisepage::execution::util::test
-#endif
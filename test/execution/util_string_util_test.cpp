@@ -0,0 +1,107 @@
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "execution/tpl_test.h"
+#include "execution/util/string_util.h"
+
+namespace noisepage::execution::util {
+
+class StringUtilTest : public TplTest {};
+
+// NOLINTNEXTLINE
+TEST_F(StringUtilTest, Find) {
+    const std::string_view haystack = "the quick brown fox jumps over the lazy dog, and the quick brown cat naps";
+    const auto             find = [&](std::string_view needle) -> const char * {
+        return StringUtil::Find(haystack.data(), haystack.size(), needle.data(), needle.size());
+    };
+
+    EXPECT_EQ(haystack.data(), find(""));
+    EXPECT_EQ(haystack.data(), find("the"));
+    EXPECT_EQ(haystack.data() + haystack.find("q"), find("q"));
+    EXPECT_EQ(haystack.data() + haystack.find("lazy dog"), find("lazy dog"));
+    EXPECT_EQ(haystack.data() + haystack.find("brown cat"), find("brown cat"));
+    EXPECT_EQ(haystack.data() + haystack.find("naps"), find("naps"));
+    EXPECT_EQ(haystack.data() + haystack.find("quick brown fox jumps over"), find("quick brown fox jumps over"));
+    EXPECT_EQ(nullptr, find("brown dog"));
+    EXPECT_EQ(nullptr, find("napss"));
+    EXPECT_EQ(nullptr, find("!"));
+    EXPECT_EQ(nullptr, StringUtil::Find(haystack.data(), 3, "the quick", 9));
+}
+
+// NOLINTNEXTLINE
+TEST_F(StringUtilTest, FindRandom) {
+    // Small alphabets produce many partial matches, which stress the candidate verification
+    std::mt19937                            gen(std::random_device{}());
+    std::uniform_int_distribution<uint32_t> letter('a', 'c');
+    const auto                              random_string = [&](uint32_t len) {
+        std::string str(len, 'a');
+        for (auto &c : str) {
+            c = static_cast<char>(letter(gen));
+        }
+        return str;
+    };
+
+    for (uint32_t i = 0; i < 10000; i++) {
+        const std::string haystack = random_string(gen() % 100);
+        const std::string needle = random_string(gen() % 20);
+        const auto        pos = haystack.find(needle);
+        const char       *expected = pos == std::string::npos ? nullptr : haystack.data() + pos;
+        EXPECT_EQ(expected, StringUtil::Find(haystack.data(), haystack.size(), needle.data(), needle.size()))
+            << "'" << needle << "' in '" << haystack << "'";
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(StringUtilTest, ChangeCase) {
+    // Long enough to use the vector loop and the scalar tail, with non-ASCII bytes that must be left alone
+    const std::string input
+        = "Hello, World! @[`{ 0123456789 \xC3\x80\xC3\xA0 The Quick Brown Fox Jumps Over The Lazy Dog";
+    std::string       lower = input, upper = input;
+    for (auto &c : lower) {
+        c = (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 'a' - 'A') : c;
+    }
+    for (auto &c : upper) {
+        c = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+
+    std::string result(input.size(), '\0');
+    StringUtil::ToLower(input.data(), input.size(), result.data());
+    EXPECT_EQ(lower, result);
+    StringUtil::ToUpper(input.data(), input.size(), result.data());
+    EXPECT_EQ(upper, result);
+
+    // In place
+    result = input;
+    StringUtil::ToLower(result.data(), result.size(), result.data());
+    EXPECT_EQ(lower, result);
+}
+
+// NOLINTNEXTLINE
+TEST_F(StringUtilTest, MatchSizeAndPrefix) {
+    const std::vector<std::string_view> pool
+        = {"", "abc", "abcd", "abce", "abcde", "abcdefghijklmnop", "abcdefghijklmnoq", "abcxefghijklmnop"};
+
+    // More than one word's worth of entries, and a partial last word
+    std::vector<storage::VarlenEntry> entries;
+    for (uint32_t i = 0; i < 150; i++) {
+        entries.push_back(storage::VarlenEntry::Create(pool[(i * 3) % pool.size()]));
+    }
+
+    for (const auto &key_str : pool) {
+        const auto key = storage::VarlenEntry::Create(key_str);
+        uint64_t   bit_vector[3];
+        StringUtil::MatchSizeAndPrefix(entries.data(), entries.size(), key, bit_vector);
+        for (uint32_t i = 0; i < entries.size(); i++) {
+            const std::string_view str = entries[i].StringView();
+            const bool             expected = str.size() == key_str.size()
+                                  && str.substr(0, storage::VarlenEntry::PrefixSize())
+                                         == key_str.substr(0, storage::VarlenEntry::PrefixSize());
+            EXPECT_EQ(expected, ((bit_vector[i / 64] >> (i % 64)) & 1u) != 0);
+        }
+        EXPECT_EQ(0u, bit_vector[2] >> (entries.size() % 64));
+    }
+}
+
+} // namespace noisepage::execution::util
@@ -325,4 +325,44 @@ TEST_F(BytecodeGeneratorTest, FunctionTest) {
     EXPECT_EQ(20, s.b_);
 }
 
+// NOLINTNEXTLINE
+TEST_F(BytecodeGeneratorTest, SuperinstructionTest) {
+    auto src = R"(
+    fun test(n: int32) -> int32 {
+      var s = 0
+      for (var i = 0; i < n; i = i + 1) {
+        if (i % 3 != 0) {
+          s = s + i
+        }
+      }
+      var j = n
+      while (j >= 10) {
+        j = j - 10
+        s = s + 1
+      }
+      return s
+    })";
+
+    // Fusing the loop conditions and the branch must not change the result
+    for (const bool use_superinstructions : {true, false}) {
+        auto compiler = ModuleCompiler();
+        auto module = compiler.CompileToModule(src, use_superinstructions);
+        ASSERT_TRUE(module != nullptr);
+
+        uint32_t    num_superinstructions = 0;
+        const auto *func_info = module->GetFuncInfoByName("test");
+        for (auto iter = module->GetBytecodeModule()->GetBytecodeForFunction(*func_info); !iter.Done();
+             iter.Advance()) {
+            num_superinstructions += Bytecodes::IsSuperinstruction(iter.CurrentBytecode());
+        }
+        EXPECT_EQ(use_superinstructions ? 3u : 0u, num_superinstructions);
+
+        std::function<int32_t(int32_t)> f;
+        EXPECT_TRUE(module->GetFunction("test", ExecutionMode::Interpret, &f)) << "Function 'test' not found in module";
+        EXPECT_EQ(0, f(0));
+        EXPECT_EQ(28, f(10));
+        EXPECT_EQ(3277, f(100));
+    }
+}
+
 } // namespace noisepage::execution::vm::test
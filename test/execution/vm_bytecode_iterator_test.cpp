@@ -90,4 +90,68 @@ TEST_F(BytecodeIteratorTest, JumpTest) {
     EXPECT_EQ(v1, iter.GetLocalOperand(2));
 }
 
+// NOLINTNEXTLINE
+TEST_F(BytecodeIteratorTest, SuperinstructionTest) {
+    vm::BytecodeEmitter emitter(GetMutableCode());
+
+    LocalVar cond(0, LocalVar::AddressMode::Address);
+    LocalVar lhs(4, LocalVar::AddressMode::Value);
+    LocalVar rhs(8, LocalVar::AddressMode::Value);
+
+    // A comparison followed by a branch on its result is fused. The superinstruction carries the operands of both.
+    vm::BytecodeLabel exit_label;
+    emitter.EmitBinaryOp(Bytecode::LessThan_int32_t, cond, lhs, rhs);
+    emitter.EmitConditionalJump(Bytecode::JumpIfFalse, cond.ValueOf(), &exit_label);
+
+    // A label between the two prevents fusion, since a jump to the label must reach the branch alone
+    vm::BytecodeLabel branch_label;
+    emitter.EmitBinaryOp(Bytecode::LessThan_int32_t, cond, lhs, rhs);
+    emitter.Bind(&branch_label);
+    emitter.EmitConditionalJump(Bytecode::JumpIfFalse, cond.ValueOf(), &exit_label);
+    emitter.Bind(&exit_label);
+
+    vm::BytecodeIterator iter(GetCode(), 0, GetCode().size());
+    EXPECT_FALSE(iter.Done());
+    EXPECT_EQ(Bytecode::LessThanJumpIfFalse_int32_t, iter.CurrentBytecode());
+    EXPECT_EQ(cond, iter.GetLocalOperand(0));
+    EXPECT_EQ(lhs, iter.GetLocalOperand(1));
+    EXPECT_EQ(rhs, iter.GetLocalOperand(2));
+    EXPECT_EQ(cond.ValueOf(), iter.GetLocalOperand(3));
+    // The offset of the jump is relative to the offset operand, which lands at the end of the code
+    EXPECT_EQ(GetCode().size() - Bytecodes::GetNthOperandOffset(iter.CurrentBytecode(), 4),
+              static_cast<std::size_t>(iter.GetJumpOffsetOperand(4)));
+
+    iter.Advance();
+    EXPECT_FALSE(iter.Done());
+    EXPECT_EQ(Bytecode::LessThan_int32_t, iter.CurrentBytecode());
+
+    iter.Advance();
+    EXPECT_FALSE(iter.Done());
+    EXPECT_EQ(Bytecode::JumpIfFalse, iter.CurrentBytecode());
+
+    iter.Advance();
+    EXPECT_TRUE(iter.Done());
+}
+
+// NOLINTNEXTLINE
+TEST_F(BytecodeIteratorTest, NoSuperinstructionTest) {
+    vm::BytecodeEmitter emitter(GetMutableCode(), false);
+
+    LocalVar cond(0, LocalVar::AddressMode::Address);
+    LocalVar lhs(4, LocalVar::AddressMode::Value);
+    LocalVar rhs(8, LocalVar::AddressMode::Value);
+
+    vm::BytecodeLabel label;
+    emitter.EmitBinaryOp(Bytecode::LessThan_int32_t, cond, lhs, rhs);
+    emitter.EmitConditionalJump(Bytecode::JumpIfFalse, cond.ValueOf(), &label);
+    emitter.Bind(&label);
+
+    vm::BytecodeIterator iter(GetCode(), 0, GetCode().size());
+    EXPECT_EQ(Bytecode::LessThan_int32_t, iter.CurrentBytecode());
+    iter.Advance();
+    EXPECT_EQ(Bytecode::JumpIfFalse, iter.CurrentBytecode());
+    iter.Advance();
+    EXPECT_TRUE(iter.Done());
+}
+
 } // namespace noisepage::execution::vm::test
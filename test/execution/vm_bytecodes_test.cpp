@@ -1,4 +1,5 @@
 #include "execution/tpl_test.h"
+#include "execution/vm/bytecode_profile.h"
 #include "execution/vm/bytecodes.h"
 
 namespace noisepage::execution::vm::test {
@@ -101,4 +102,80 @@ TEST_F(BytecodesTest, OperandTypesTest) {
     EXPECT_EQ(OperandType::Local, Bytecodes::GetNthOperandType(Bytecode::Add_int32_t, 2));
 }
 
+// NOLINTNEXTLINE
+TEST_F(BytecodesTest, SuperinstructionTest) {
+#define CHECK_SUPERINSTRUCTION(name, first, second)                                                                    \
+    {                                                                                                                  \
+        Bytecode fused;                                                                                                \
+        EXPECT_TRUE(Bytecodes::Fuse(Bytecode::first, Bytecode::second, &fused));                                       \
+        EXPECT_EQ(Bytecode::name, fused);                                                                              \
+        EXPECT_TRUE(Bytecodes::IsSuperinstruction(Bytecode::name));                                                    \
+        EXPECT_EQ(Bytecode::first, Bytecodes::GetSuperinstructionFirst(Bytecode::name));                               \
+        EXPECT_EQ(Bytecode::second, Bytecodes::GetSuperinstructionSecond(Bytecode::name));                             \
+        EXPECT_EQ(Bytecodes::IsJump(Bytecode::second), Bytecodes::IsJump(Bytecode::name));                             \
+        EXPECT_EQ(Bytecodes::IsConditionalJump(Bytecode::second), Bytecodes::IsConditionalJump(Bytecode::name));       \
+        /* The operands are those of the first bytecode followed by those of the second */                             \
+        const uint32_t num_first_operands = Bytecodes::NumOperands(Bytecode::first);                                   \
+        ASSERT_EQ(num_first_operands + Bytecodes::NumOperands(Bytecode::second),                                       \
+                  Bytecodes::NumOperands(Bytecode::name));                                                             \
+        for (uint32_t i = 0; i < Bytecodes::NumOperands(Bytecode::name); i++) {                                        \
+            const OperandType expected = i < num_first_operands                                                        \
+                                             ? Bytecodes::GetNthOperandType(Bytecode::first, i)                        \
+                                             : Bytecodes::GetNthOperandType(Bytecode::second, i - num_first_operands); \
+            EXPECT_EQ(expected, Bytecodes::GetNthOperandType(Bytecode::name, i));                                      \
+        }                                                                                                              \
+    }
+    SUPERINSTRUCTION_LIST(CHECK_SUPERINSTRUCTION)
+#undef CHECK_SUPERINSTRUCTION
+
+    // Regular bytecodes
+    Bytecode fused;
+    EXPECT_FALSE(Bytecodes::IsSuperinstruction(Bytecode::Add_int32_t));
+    EXPECT_FALSE(Bytecodes::Fuse(Bytecode::Add_int32_t, Bytecode::JumpIfFalse, &fused));
+    EXPECT_FALSE(Bytecodes::Fuse(Bytecode::LessThan_int32_t, Bytecode::JumpIfTrue, &fused));
+
+    // Jump offsets are always the last operand
+    EXPECT_EQ(0u, Bytecodes::GetJumpOffsetOperandIndex(Bytecode::Jump));
+    EXPECT_EQ(1u, Bytecodes::GetJumpOffsetOperandIndex(Bytecode::JumpIfFalse));
+    EXPECT_EQ(4u, Bytecodes::GetJumpOffsetOperandIndex(Bytecode::LessThanJumpIfFalse_int32_t));
+    EXPECT_EQ(1u, Bytecodes::GetJumpOffsetOperandIndex(Bytecode::VPIAdvanceJump));
+}
+
+// NOLINTNEXTLINE
+TEST_F(BytecodesTest, BytecodeProfileTest) {
+    const auto add = Bytecodes::ToByte(Bytecode::Add_int32_t);
+    const auto less_than = Bytecodes::ToByte(Bytecode::LessThan_int32_t);
+    const auto jump_if_false = Bytecodes::ToByte(Bytecode::JumpIfFalse);
+
+    BytecodeProfile::Reset();
+    BytecodeProfile::Record(BytecodeProfile::NO_BYTECODE, add);
+    for (uint32_t i = 0; i < 10; i++) {
+        BytecodeProfile::Record(add, add);
+    }
+    for (uint32_t i = 0; i < 5; i++) {
+        BytecodeProfile::Record(add, less_than);
+        BytecodeProfile::Record(less_than, jump_if_false);
+    }
+
+    EXPECT_EQ(11u, BytecodeProfile::GetCount(Bytecode::Add_int32_t));
+    EXPECT_EQ(21u, BytecodeProfile::GetTotalCount());
+    EXPECT_EQ(10u, BytecodeProfile::GetPairCount(Bytecode::Add_int32_t, Bytecode::Add_int32_t));
+    EXPECT_EQ(0u, BytecodeProfile::GetPairCount(Bytecode::JumpIfFalse, Bytecode::Add_int32_t));
+
+    // The comparison and branch already have a superinstruction, so they're not a candidate
+    auto pairs = BytecodeProfile::GetTopPairs(10);
+    ASSERT_EQ(2u, pairs.size());
+    EXPECT_EQ(Bytecode::Add_int32_t, pairs[0].first_);
+    EXPECT_EQ(Bytecode::Add_int32_t, pairs[0].second_);
+    EXPECT_EQ(10u, pairs[0].count_);
+    EXPECT_EQ(Bytecode::Add_int32_t, pairs[1].first_);
+    EXPECT_EQ(Bytecode::LessThan_int32_t, pairs[1].second_);
+    EXPECT_EQ(5u, pairs[1].count_);
+    EXPECT_EQ(1u, BytecodeProfile::GetTopPairs(1).size());
+
+    BytecodeProfile::Reset();
+    EXPECT_EQ(0u, BytecodeProfile::GetTotalCount());
+    EXPECT_TRUE(BytecodeProfile::GetTopPairs(10).empty());
+}
+
 } // namespace noisepage::execution::vm::test
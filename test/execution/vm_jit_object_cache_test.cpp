@@ -0,0 +1,136 @@
+#include "execution/vm/jit_object_cache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "execution/tpl_test.h"
+#include "execution/util/fast_rand.h"
+
+namespace noisepage::execution::vm::test {
+
+class JitObjectCacheTest : public TplTest {
+public:
+    void SetUp() override {
+        TplTest::SetUp();
+        directory_ = (std::filesystem::temp_directory_path()
+                      / ("noisepage-jit-cache." + std::to_string(util::FastRand().Next())))
+                         .string();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+        TplTest::TearDown();
+    }
+
+    // An object of the given size, filled with the given byte
+    static std::unique_ptr<llvm::MemoryBuffer> MakeObject(const std::size_t size, const char fill) {
+        return llvm::MemoryBuffer::getMemBufferCopy(std::string(size, fill));
+    }
+
+    // The number of cached object files in the directory
+    uint32_t NumFiles() const {
+        uint32_t num_files = 0;
+        for (const auto &entry : std::filesystem::directory_iterator(directory_)) {
+            num_files += entry.path().extension() == JitObjectCache::FILE_EXTENSION ? 1 : 0;
+        }
+        return num_files;
+    }
+
+    std::string directory_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(JitObjectCacheTest, StoreLookupAndWarmup) {
+    const std::vector<std::string> symbols{"Query1_Init", "Query1_Pipeline1"};
+    std::string                    key;
+    {
+        JitObjectCache cache(directory_, 1 << 20, "env");
+        EXPECT_EQ(0, cache.Warmup());
+        key = cache.MakeKey("module");
+        EXPECT_EQ(key, cache.MakeKey("module"));
+        EXPECT_NE(key, cache.MakeKey("other module"));
+
+        JitObjectCache::CachedObject cached;
+        EXPECT_FALSE(cache.Lookup(key, &cached));
+        cache.Store(key, *MakeObject(1000, 'a'), symbols, 5000);
+        EXPECT_EQ(1, NumFiles());
+
+        ASSERT_TRUE(cache.Lookup(key, &cached));
+        EXPECT_EQ(std::string(1000, 'a'), cached.object_->getBuffer().str());
+        EXPECT_EQ(symbols, cached.symbols_);
+        EXPECT_EQ(5000, cached.compile_us_);
+        EXPECT_EQ(1, cache.GetNumHits());
+        EXPECT_EQ(1, cache.GetNumMisses());
+        EXPECT_EQ(5000, cache.GetCompileTimeSavedUs());
+    }
+
+    // A new process finds the object in the directory, but only in the same environment
+    JitObjectCache cache(directory_, 1 << 20, "env");
+    EXPECT_EQ(1, cache.Warmup());
+    EXPECT_EQ(key, cache.MakeKey("module"));
+    JitObjectCache::CachedObject cached;
+    ASSERT_TRUE(cache.Lookup(key, &cached));
+    EXPECT_EQ(std::string(1000, 'a'), cached.object_->getBuffer().str());
+    EXPECT_EQ(symbols, cached.symbols_);
+
+    JitObjectCache other_cpu(directory_, 1 << 20, "other env");
+    EXPECT_NE(key, other_cpu.MakeKey("module"));
+}
+
+// NOLINTNEXTLINE
+TEST_F(JitObjectCacheTest, EvictLeastRecentlyUsed) {
+    JitObjectCache cache(directory_, 2500, "env");
+    cache.Warmup();
+    const std::string a = cache.MakeKey("a"), b = cache.MakeKey("b"), c = cache.MakeKey("c");
+    cache.Store(a, *MakeObject(1000, 'a'), {}, 1);
+    cache.Store(b, *MakeObject(1000, 'b'), {}, 1);
+    EXPECT_EQ(2, cache.GetNumObjects());
+
+    // Using a makes b the least recently used object, which is evicted to make room for c
+    JitObjectCache::CachedObject cached;
+    EXPECT_TRUE(cache.Lookup(a, &cached));
+    cache.Store(c, *MakeObject(1000, 'c'), {}, 1);
+    EXPECT_EQ(2, cache.GetNumObjects());
+    EXPECT_LE(cache.GetSizeInBytes(), 2500);
+    EXPECT_TRUE(cache.Lookup(a, &cached));
+    EXPECT_FALSE(cache.Lookup(b, &cached));
+    EXPECT_TRUE(cache.Lookup(c, &cached));
+    EXPECT_EQ(2, NumFiles());
+
+    // Objects larger than the cache are not cached
+    cache.Store(b, *MakeObject(3000, 'b'), {}, 1);
+    EXPECT_FALSE(cache.Lookup(b, &cached));
+    EXPECT_EQ(2, NumFiles());
+}
+
+// NOLINTNEXTLINE
+TEST_F(JitObjectCacheTest, WarmupRemovesDamagedFiles) {
+    std::string key;
+    {
+        JitObjectCache cache(directory_, 1 << 20, "env");
+        cache.Warmup();
+        key = cache.MakeKey("module");
+        cache.Store(key, *MakeObject(1000, 'a'), {"f"}, 1);
+        cache.Store(cache.MakeKey("other module"), *MakeObject(1000, 'b'), {"g"}, 1);
+    }
+
+    // Flip a byte of the object code of the first file
+    const auto path = std::filesystem::path(directory_) / (key + std::string(JitObjectCache::FILE_EXTENSION));
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-1, std::ios::end);
+        file.put('x');
+    }
+
+    JitObjectCache cache(directory_, 1 << 20, "env");
+    EXPECT_EQ(1, cache.Warmup());
+    JitObjectCache::CachedObject cached;
+    EXPECT_FALSE(cache.Lookup(key, &cached));
+    EXPECT_TRUE(cache.Lookup(cache.MakeKey("other module"), &cached));
+    EXPECT_FALSE(std::filesystem::exists(path));
+    EXPECT_EQ(1, NumFiles());
+}
+
+} // namespace noisepage::execution::vm::test
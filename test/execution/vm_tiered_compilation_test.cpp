@@ -0,0 +1,81 @@
+#include <functional>
+#include <string>
+
+#include "execution/compiled_tpl_test.h"
+#include "execution/vm/module.h"
+#include "execution/vm/module_compiler.h"
+
+namespace noisepage::execution::vm::test {
+
+class TieredCompilationTest : public CompiledTplTest {
+public:
+    // Sums the integers below n in a loop, so interpreting it profiles loop iterations
+    static constexpr const char *SUM_SRC = R"(
+    fun sum(n: int32) -> int32 {
+      var s = 0
+      for (var i = 0; i < n; i = i + 1) {
+        s = s + i
+      }
+      return s
+    })";
+};
+
+// NOLINTNEXTLINE
+TEST_F(TieredCompilationTest, PromoteHotFunctions) {
+    auto compiler = ModuleCompiler();
+    auto module = compiler.CompileToModule(SUM_SRC);
+    ASSERT_FALSE(compiler.HasErrors());
+    module->SetTierThresholds({100, 1000});
+    const FunctionId sum_id = module->GetFuncInfoByName("sum")->GetId();
+
+    std::function<int32_t(int32_t)> sum;
+    ASSERT_TRUE(module->GetFunction("sum", ExecutionMode::Adaptive, &sum));
+    EXPECT_EQ(Module::Tier::Interpreted, module->GetTier());
+
+    // Cold: the invocation and its loop iterations are counted, but stay below the baseline threshold
+    EXPECT_EQ(45, sum(10));
+    module->WaitForTierUp();
+    EXPECT_EQ(Module::Tier::Interpreted, module->GetTier());
+    EXPECT_GE(module->GetProfileCount(sum_id), 11);
+
+    // Warm: a long loop crosses the baseline threshold
+    EXPECT_EQ(4950, sum(100));
+    module->WaitForTierUp();
+    EXPECT_EQ(Module::Tier::Baseline, module->GetTier());
+
+    // Baseline code counts its invocations through the stubs
+    const uint64_t count = module->GetProfileCount(sum_id);
+    EXPECT_EQ(4950, sum(100));
+    EXPECT_EQ(count + 1, module->GetProfileCount(sum_id));
+
+    // Hot: the invocations cross the optimized threshold, which the next retrieval notices
+    for (uint32_t i = 0; i < 1000; i++) {
+        EXPECT_EQ(45, sum(10));
+    }
+    ASSERT_TRUE(module->GetFunction("sum", ExecutionMode::Adaptive, &sum));
+    module->WaitForTierUp();
+    EXPECT_EQ(Module::Tier::Optimized, module->GetTier());
+    EXPECT_EQ(4950, sum(100));
+}
+
+// NOLINTNEXTLINE
+TEST_F(TieredCompilationTest, OnlyAdaptiveModeTiersUp) {
+    auto compiler = ModuleCompiler();
+    auto module = compiler.CompileToModule(SUM_SRC);
+    ASSERT_FALSE(compiler.HasErrors());
+    module->SetTierThresholds({1, 1});
+
+    // Interpreted functions are not promoted, no matter how hot they are
+    std::function<int32_t(int32_t)> sum;
+    ASSERT_TRUE(module->GetFunction("sum", ExecutionMode::Interpret, &sum));
+    EXPECT_EQ(4950, sum(100));
+    module->WaitForTierUp();
+    EXPECT_EQ(Module::Tier::Interpreted, module->GetTier());
+
+    // Compiled functions go straight to the optimized tier
+    ASSERT_TRUE(module->GetFunction("sum", ExecutionMode::Compiled, &sum));
+    EXPECT_EQ(Module::Tier::Optimized, module->GetTier());
+    EXPECT_EQ(4950, sum(100));
+}
+
+} // namespace noisepage::execution::vm::test
@@ -33,11 +33,12 @@ public:
         return ast;
     }
 
-    std::unique_ptr<Module> CompileToModule(const std::string &source) {
+    std::unique_ptr<Module> CompileToModule(const std::string &source, bool use_superinstructions = true) {
         auto *ast = CompileToAst(source);
         if (HasErrors())
             return nullptr;
-        return std::make_unique<Module>(vm::BytecodeGenerator::Compile(ast, "test"), ModuleMetadata{});
+        return std::make_unique<Module>(vm::BytecodeGenerator::Compile(ast, "test", use_superinstructions),
+                                        ModuleMetadata{});
     }
 
     // Does the error reporter have any errors?
@@ -56,7 +56,28 @@ public:
         return query_and_plan_.size();
     }
 
+    /**
+     * Run one query once in the calling thread
+     * @param query_idx 0-indexed query number
+     * @param mode execution mode to run the query with
+     * @return the elapsed time in microseconds
+     */
+    uint64_t ExecuteOnce(uint32_t query_idx, execution::vm::ExecutionMode mode);
+
+    /**
+     * Set the profile counts at which the modules of every query move up a tier in adaptive mode
+     */
+    void SetTierThresholds(const execution::vm::Module::TierThresholds &thresholds);
+
+    /**
+     * Block until no module of any query is being compiled in the background
+     */
+    void WaitForTierUp();
+
 private:
+    // Run the query with the given index in the given transaction
+    void RunQuery(transaction::TransactionContext *txn, uint32_t query_idx, execution::vm::ExecutionMode mode);
+
     void
     GenerateTables(execution::exec::ExecutionContext *exec_ctx, const std::string &dir_name, enum BenchmarkType type);
 
@@ -189,9 +189,11 @@ TEST_F(MetricsTests, TransactionCSVTest) {
     EXPECT_NE(aggregated_data, nullptr);
     EXPECT_GE(aggregated_data->begin_data_.size(), 0);  // 1 txn recorded
     EXPECT_GE(aggregated_data->commit_data_.size(), 0); // 1 txn recorded
+    EXPECT_GE(aggregated_data->version_chain_data_.size(), 0);
     metrics_manager_->ToOutput(DISABLED);
     EXPECT_EQ(aggregated_data->begin_data_.size(), 0);
     EXPECT_EQ(aggregated_data->commit_data_.size(), 0);
+    EXPECT_EQ(aggregated_data->version_chain_data_.size(), 0);
 
     Insert();
     Insert();
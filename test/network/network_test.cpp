@@ -84,7 +84,9 @@ protected:
                                            DISABLED,
                                            0,
                                            false,
-                                           execution::vm::ExecutionMode::Interpret);
+                                           execution::vm::ExecutionMode::Interpret,
+                                           optimizer::CostModelType::TRIVIAL,
+                                           0);
 
         auto txn = txn_manager_->BeginTransaction();
         catalog_->CreateDatabase(common::ManagedPointer(txn), catalog::DEFAULT_DATABASE, true);
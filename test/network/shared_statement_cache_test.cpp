@@ -0,0 +1,270 @@
+#include "network/postgres/shared_statement_cache.h"
+
+#include <memory>
+#include <pqxx/pqxx> // NOLINT
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "common/settings.h"
+#include "main/db_main.h"
+#include "network/postgres/statement.h"
+#include "taskflow/taskflow.h"
+#include "test_util/test_harness.h"
+#include "transaction/transaction_manager.h"
+#include "gtest/gtest.h"
+
+namespace noisepage::network {
+
+class SharedStatementCacheTests : public TerrierTest {};
+
+// NOLINTNEXTLINE
+TEST_F(SharedStatementCacheTests, NormalizeWhitespaceTest) {
+    EXPECT_EQ(SharedStatementCache::NormalizeQueryText("SELECT a FROM foo WHERE b = $1"),
+              SharedStatementCache::NormalizeQueryText("SELECT a\n  FROM foo\n  WHERE b = $1\n"));
+    EXPECT_EQ(SharedStatementCache::NormalizeQueryText("  SELECT  a\n FROM\tfoo  ;  "), "SELECT a FROM foo ;");
+    EXPECT_EQ(SharedStatementCache::NormalizeQueryText("SELECT a FROM foo;"), "SELECT a FROM foo;");
+    EXPECT_EQ(SharedStatementCache::NormalizeQueryText(""), "");
+    EXPECT_EQ(SharedStatementCache::NormalizeQueryText(" \n\t "), "");
+}
+
+// Whitespace inside string literals and quoted identifiers is significant
+// NOLINTNEXTLINE
+TEST_F(SharedStatementCacheTests, NormalizeQuotesTest) {
+    EXPECT_EQ(SharedStatementCache::NormalizeQueryText("SELECT  'a   b'  FROM  \"my  table\""),
+              "SELECT 'a   b' FROM \"my  table\"");
+    EXPECT_EQ(SharedStatementCache::NormalizeQueryText("SELECT  'it''s  '  FROM  foo"), "SELECT 'it''s  ' FROM foo");
+    EXPECT_EQ(SharedStatementCache::NormalizeQueryText("SELECT '--  not a comment'  FROM foo"),
+              "SELECT '--  not a comment' FROM foo");
+}
+
+// Query text that cannot be tokenized without parsing it is left alone
+// NOLINTNEXTLINE
+TEST_F(SharedStatementCacheTests, NormalizeUnchangedTest) {
+    const std::string comment = "SELECT  a -- the  column\nFROM foo";
+    EXPECT_EQ(SharedStatementCache::NormalizeQueryText(comment), comment);
+    const std::string block_comment = "SELECT  a /* the  column */ FROM foo";
+    EXPECT_EQ(SharedStatementCache::NormalizeQueryText(block_comment), block_comment);
+    const std::string dollar_quoted = "SELECT  $$a  b$$";
+    EXPECT_EQ(SharedStatementCache::NormalizeQueryText(dollar_quoted), dollar_quoted);
+    const std::string escape = "SELECT  E'a\\'  b'";
+    EXPECT_EQ(SharedStatementCache::NormalizeQueryText(escape), escape);
+}
+
+
+/**
+ * The cache is filled by the Extended Query protocol of real connections, since only compiled Statements are shared
+ */
+class SharedStatementCacheNetworkTests : public TerrierTest {
+protected:
+    void SetUp() override {
+        TerrierTest::SetUp();
+        std::unordered_map<settings::Param, settings::ParamInfo> param_map;
+        noisepage::settings::SettingsManager::ConstructParamMap(param_map);
+
+        db_main_ = noisepage::DBMain::Builder()
+                       .SetSettingsParameterMap(std::move(param_map))
+                       .SetUseSettingsManager(true)
+                       .SetUseGC(true)
+                       .SetUseCatalog(true)
+                       .SetUseGCThread(true)
+                       .SetUseTaskflow(true)
+                       .SetUseStatsStorage(true)
+                       .SetUseNetwork(true)
+                       .SetUseExecution(true)
+                       .Build();
+
+        db_main_->GetNetworkLayer()->GetServer()->RunServer();
+
+        port_ = static_cast<uint16_t>(db_main_->GetSettingsManager()->GetInt(settings::Param::port));
+        cache_ = db_main_->GetTaskflow()->GetSharedStatementCache();
+
+        const auto txn_manager = db_main_->GetTransactionLayer()->GetTransactionManager();
+        auto      *txn = txn_manager->BeginTransaction();
+        db_oid_ = db_main_->GetCatalogLayer()->GetCatalog()->GetDatabaseOid(common::ManagedPointer(txn),
+                                                                            catalog::DEFAULT_DATABASE);
+        txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+        auto       connection = Connect();
+        pqxx::work txn1(*connection);
+        txn1.exec("CREATE TABLE foo (a INT, b INT);");
+        txn1.exec("INSERT INTO foo VALUES (1, 10), (2, 20), (3, 30);");
+        txn1.commit();
+    }
+
+    auto Connect() const -> std::unique_ptr<pqxx::connection> {
+        return std::make_unique<pqxx::connection>(
+            fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                        port_,
+                        catalog::DEFAULT_DATABASE));
+    }
+
+    // Runs the query with the Extended Query protocol, which publishes its Statement, and returns the single value
+    static auto RunQuery(pqxx::connection *const connection, const std::string &query) -> int {
+        pqxx::work   txn(*connection);
+        pqxx::result r = txn.exec_params(query);
+        txn.commit();
+        EXPECT_EQ(1, r.size());
+        return r[0][0].as<int>();
+    }
+
+    std::unique_ptr<DBMain>                      db_main_;
+    uint16_t                                     port_;
+    common::ManagedPointer<SharedStatementCache> cache_;
+    catalog::db_oid_t                            db_oid_;
+    const std::vector<execution::sql::SqlTypeId> no_params_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(SharedStatementCacheNetworkTests, LookupAddTest) {
+    const std::string query = "SELECT b FROM foo WHERE a = 2";
+    EXPECT_EQ(nullptr, cache_->Lookup(db_oid_, query, no_params_));
+
+    auto connection = Connect();
+    EXPECT_EQ(20, RunQuery(connection.get(), query));
+    EXPECT_EQ(1, cache_->GetNumEntries());
+    EXPECT_GT(cache_->GetSize(), 0);
+
+    // The published Statement is found by its normalized text, in the same database, with the same parameter types
+    const auto statement = cache_->Lookup(db_oid_, "SELECT b\n  FROM foo\n  WHERE a = 2\n", no_params_);
+    ASSERT_NE(nullptr, statement);
+    EXPECT_TRUE(statement->IsShared());
+    EXPECT_EQ(cache_->GetSize(), SharedStatementCache::EstimateSize(*statement));
+    const catalog::db_oid_t other_db_oid(db_oid_.UnderlyingValue() + 1);
+    EXPECT_EQ(nullptr, cache_->Lookup(db_oid_, query, {execution::sql::SqlTypeId::Integer}));
+    EXPECT_EQ(nullptr, cache_->Lookup(other_db_oid, query, no_params_));
+
+    // An equivalent Statement is already cached, and another database gets its own entry
+    EXPECT_FALSE(cache_->Add(db_oid_, statement));
+    EXPECT_EQ(1, cache_->GetNumEntries());
+    EXPECT_TRUE(cache_->Add(other_db_oid, statement));
+    EXPECT_EQ(2, cache_->GetNumEntries());
+    EXPECT_EQ(statement, cache_->Lookup(other_db_oid, query, no_params_));
+}
+
+// NOLINTNEXTLINE
+TEST_F(SharedStatementCacheNetworkTests, EvictionTest) {
+    // The queries only differ in a constant, so their Statements have the same size
+    const std::string query1 = "SELECT b FROM foo WHERE a = 1";
+    const std::string query2 = "SELECT b FROM foo WHERE a = 2";
+    const std::string query3 = "SELECT b FROM foo WHERE a = 3";
+
+    auto connection = Connect();
+    EXPECT_EQ(10, RunQuery(connection.get(), query1));
+    const uint64_t size = cache_->GetSize();
+    ASSERT_GT(size, 0);
+
+    // Room for two Statements
+    cache_->SetSizeLimit(size * 5 / 2);
+    EXPECT_EQ(20, RunQuery(connection.get(), query2));
+    EXPECT_EQ(2, cache_->GetNumEntries());
+    EXPECT_EQ(0, cache_->GetNumEvictions());
+
+    // query1 was used more recently than query2, so query2 is evicted to make room for query3
+    EXPECT_NE(nullptr, cache_->Lookup(db_oid_, query1, no_params_));
+    EXPECT_EQ(30, RunQuery(connection.get(), query3));
+    EXPECT_EQ(2, cache_->GetNumEntries());
+    EXPECT_EQ(1, cache_->GetNumEvictions());
+    EXPECT_NE(nullptr, cache_->Lookup(db_oid_, query1, no_params_));
+    EXPECT_EQ(nullptr, cache_->Lookup(db_oid_, query2, no_params_));
+    EXPECT_NE(nullptr, cache_->Lookup(db_oid_, query3, no_params_));
+
+    // Shrinking the limit evicts right away, least recently used first
+    cache_->SetSizeLimit(size);
+    EXPECT_EQ(1, cache_->GetNumEntries());
+    EXPECT_EQ(2, cache_->GetNumEvictions());
+    EXPECT_EQ(nullptr, cache_->Lookup(db_oid_, query1, no_params_));
+    EXPECT_NE(nullptr, cache_->Lookup(db_oid_, query3, no_params_));
+
+    // A Statement that does not fit at all is not added
+    cache_->SetSizeLimit(size - 1);
+    EXPECT_EQ(0, cache_->GetNumEntries());
+    EXPECT_EQ(10, RunQuery(connection.get(), query1));
+    EXPECT_EQ(0, cache_->GetNumEntries());
+    EXPECT_EQ(0, cache_->GetSize());
+}
+
+// NOLINTNEXTLINE
+TEST_F(SharedStatementCacheNetworkTests, InvalidateAfterDDLTest) {
+    const std::string query = "SELECT b FROM foo WHERE a = 3";
+
+    auto connection = Connect();
+    EXPECT_EQ(30, RunQuery(connection.get(), query));
+    const auto stale = cache_->Lookup(db_oid_, query, no_params_);
+    ASSERT_NE(nullptr, stale);
+
+    // Committing DDL empties the cache, and Statements compiled before it are not accepted anymore
+    {
+        pqxx::work txn(*connection);
+        txn.exec("CREATE TABLE bar (c INT);");
+        txn.commit();
+    }
+    EXPECT_EQ(0, cache_->GetNumEntries());
+    EXPECT_EQ(0, cache_->GetSize());
+    EXPECT_EQ(nullptr, cache_->Lookup(db_oid_, query, no_params_));
+    EXPECT_FALSE(cache_->Add(db_oid_, stale));
+    EXPECT_EQ(0, cache_->GetNumEntries());
+
+    // The query is compiled again, from another connection since this one still holds the stale Statement
+    auto other_connection = Connect();
+    EXPECT_EQ(30, RunQuery(other_connection.get(), query));
+    const auto recompiled = cache_->Lookup(db_oid_, query, no_params_);
+    ASSERT_NE(nullptr, recompiled);
+    EXPECT_NE(stale, recompiled);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SharedStatementCacheNetworkTests, InvalidateAfterCostModelChangeTest) {
+    const std::string query = "SELECT b FROM foo WHERE a = 2";
+
+    auto connection = Connect();
+    EXPECT_EQ(20, RunQuery(connection.get(), query));
+    ASSERT_NE(nullptr, cache_->Lookup(db_oid_, query, no_params_));
+
+    // Changing the cost model empties the cache, since its plans were chosen by the previous model
+    auto action_context = std::make_unique<common::ActionContext>(common::action_id_t(1));
+    db_main_->GetSettingsManager()->SetString(settings::Param::optimizer_cost_model,
+                                              "STATS",
+                                              common::ManagedPointer(action_context),
+                                              [](common::ManagedPointer<common::ActionContext> context) {});
+    EXPECT_EQ(common::ActionState::SUCCESS, action_context->GetState());
+    EXPECT_EQ(0, cache_->GetNumEntries());
+    EXPECT_EQ(nullptr, cache_->Lookup(db_oid_, query, no_params_));
+}
+
+// NOLINTNEXTLINE
+TEST_F(SharedStatementCacheNetworkTests, CrossConnectionTest) {
+    const std::string query = "SELECT b FROM foo WHERE a = 1";
+    auto              connection1 = Connect();
+    auto              connection2 = Connect();
+
+    // The first connection misses, compiles the query and publishes it
+    const uint64_t hits = cache_->GetNumHits();
+    const uint64_t misses = cache_->GetNumMisses();
+    EXPECT_EQ(10, RunQuery(connection1.get(), query));
+    EXPECT_EQ(hits, cache_->GetNumHits());
+    EXPECT_EQ(misses + 1, cache_->GetNumMisses());
+    EXPECT_EQ(1, cache_->GetNumEntries());
+
+    // The second connection reuses it, even with different whitespace
+    EXPECT_EQ(10, RunQuery(connection2.get(), "SELECT b  FROM foo\nWHERE a = 1"));
+    EXPECT_EQ(hits + 1, cache_->GetNumHits());
+    EXPECT_EQ(misses + 1, cache_->GetNumMisses());
+    EXPECT_EQ(1, cache_->GetNumEntries());
+
+    // Both connections keep it in their own cache from now on, and the plan stays correct for both of them
+    EXPECT_EQ(10, RunQuery(connection1.get(), query));
+    EXPECT_EQ(10, RunQuery(connection2.get(), "SELECT b  FROM foo\nWHERE a = 1"));
+    EXPECT_EQ(hits + 1, cache_->GetNumHits());
+    EXPECT_EQ(misses + 1, cache_->GetNumMisses());
+
+    // Lookups through the cache itself count as well
+    EXPECT_NE(nullptr, cache_->Lookup(db_oid_, query, no_params_));
+    EXPECT_EQ(nullptr, cache_->Lookup(db_oid_, "SELECT b FROM foo WHERE a = 42", no_params_));
+    EXPECT_EQ(hits + 2, cache_->GetNumHits());
+    EXPECT_EQ(misses + 2, cache_->GetNumMisses());
+}
+
+} // namespace noisepage::network
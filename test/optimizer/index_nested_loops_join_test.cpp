@@ -36,10 +36,11 @@ namespace noisepage::optimizer {
 struct IdxJoinTest : public TerrierTest {
     const uint64_t optimizer_timeout_ = 1000000;
 
-    void CompileAndRun(std::unique_ptr<optimizer::OptimizeResult> *optimize_result, network::Statement *stmt) {
+    void CompileAndRun(std::unique_ptr<optimizer::OptimizeResult>               *optimize_result,
+                       const common::SanctionedSharedPtr<network::Statement>::Ptr &stmt) {
         network::WriteQueue queue;
         auto                pwriter = network::PostgresPacketWriter(common::ManagedPointer(&queue));
-        auto                portal = network::Portal(common::ManagedPointer(stmt));
+        auto                portal = network::Portal(stmt);
         stmt->SetOptimizeResult(std::move(*optimize_result));
         auto result = taskflow_->CodegenPhysicalPlan(common::ManagedPointer(&context_),
                                                      common::ManagedPointer(&pwriter),
@@ -63,22 +64,23 @@ struct IdxJoinTest : public TerrierTest {
         taskflow_->BeginTransaction(common::ManagedPointer(&context_));
         auto parse = taskflow_->ParseQuery(sql, common::ManagedPointer(&context_));
         auto stmt
-            = network::Statement(std::move(sql), std::move(std::get<std::unique_ptr<parser::ParseResult>>(parse)));
+            = std::make_shared<network::Statement>(std::move(sql),
+                                                   std::move(std::get<std::unique_ptr<parser::ParseResult>>(parse)));
         auto result = taskflow_->BindQuery(common::ManagedPointer(&context_),
-                                           common::ManagedPointer(&stmt),
+                                           common::ManagedPointer(stmt.get()),
                                            common::ManagedPointer(&params));
         NOISEPAGE_ASSERT(result.type_ == taskflow::ResultType::COMPLETE, "Bind should have succeeded");
 
         auto optimize_result = taskflow_->OptimizeBoundQuery(common::ManagedPointer(&context_),
-                                                             stmt.ParseResult(),
+                                                             stmt->ParseResult(),
                                                              common::ManagedPointer(&params));
         if (qtype >= network::QueryType::QUERY_CREATE_TABLE && qtype != network::QueryType::QUERY_CREATE_INDEX) {
             ExecuteCreate(&optimize_result, qtype);
         } else if (qtype == network::QueryType::QUERY_CREATE_INDEX) {
             ExecuteCreate(&optimize_result, qtype);
-            CompileAndRun(&optimize_result, &stmt);
+            CompileAndRun(&optimize_result, stmt);
         } else {
-            CompileAndRun(&optimize_result, &stmt);
+            CompileAndRun(&optimize_result, stmt);
         }
 
         taskflow_->EndTransaction(common::ManagedPointer(&context_), network::QueryType::QUERY_COMMIT);
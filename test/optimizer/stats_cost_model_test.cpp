@@ -0,0 +1,201 @@
+#include "optimizer/cost_model/stats_cost_model.h"
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "binder/bind_node_visitor.h"
+#include "optimizer/cost_model/cost_model_util.h"
+#include "optimizer/cost_model/trivial_cost_model.h"
+#include "parser/postgresparser.h"
+#include "planner/plannodes/abstract_plan_node.h"
+#include "planner/plannodes/index_scan_plan_node.h"
+#include "planner/plannodes/seq_scan_plan_node.h"
+#include "storage/sql_table.h"
+#include "taskflow/taskflow_util.h"
+#include "test_util/end_to_end_test.h"
+#include "test_util/test_harness.h"
+#include "gtest/gtest.h"
+
+namespace noisepage::optimizer {
+
+/**
+ * Checks the plans chosen with the statistics of a scaled down TPC-H database. Only the tables and the integer columns
+ * that the queries below use are created.
+ */
+class StatsCostModelTests : public test::EndToEndTest {
+public:
+    static constexpr uint32_t NUM_CUSTOMERS = 100;
+    static constexpr uint32_t NUM_ORDERS = 1000;
+    static constexpr uint32_t NUM_LINEITEMS_PER_ORDER = 4;
+    static constexpr uint32_t NUM_ROWS_PER_INSERT = 500;
+
+    void SetUp() override {
+        EndToEndTest::SetUp();
+
+        CreateTable("customer", {"c_custkey", "c_mktsegment"});
+        CreateTable("orders", {"o_orderkey", "o_custkey", "o_orderdate", "o_totalprice"});
+        CreateTable("lineitem", {"l_orderkey", "l_linenumber", "l_quantity", "l_extendedprice"});
+
+        InsertRows("customer", NUM_CUSTOMERS, [](uint32_t i) {
+            return std::vector<uint32_t>{i, i % 5};
+        });
+        InsertRows("orders", NUM_ORDERS, [](uint32_t i) {
+            return std::vector<uint32_t>{i, i % NUM_CUSTOMERS, i % 365, i * 7 % 1000};
+        });
+        InsertRows("lineitem", NUM_ORDERS * NUM_LINEITEMS_PER_ORDER, [](uint32_t i) {
+            return std::vector<uint32_t>{i / NUM_LINEITEMS_PER_ORDER, i % NUM_LINEITEMS_PER_ORDER, i % 50, i % 1000};
+        });
+
+        RunQuery("CREATE INDEX customer_pk ON customer (c_custkey);");
+        RunQuery("CREATE INDEX orders_pk ON orders (o_orderkey);");
+        RunQuery("CREATE INDEX lineitem_orderkey ON lineitem (l_orderkey);");
+        RunQuery("ANALYZE customer;");
+        RunQuery("ANALYZE orders;");
+        RunQuery("ANALYZE lineitem;");
+        txn_manager_->Commit(test_txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
+        test_txn_ = txn_manager_->BeginTransaction();
+    }
+
+    void CreateTable(const std::string &name, const std::vector<std::string> &col_names) {
+        auto int_default = parser::ConstantValueExpression(execution::sql::SqlTypeId::Integer);
+        std::vector<catalog::Schema::Column> cols;
+        for (const auto &col_name : col_names) {
+            cols.emplace_back(col_name, execution::sql::SqlTypeId::Integer, false, int_default);
+        }
+        auto table_oid = accessor_->CreateTable(accessor_->GetDefaultNamespace(), name, catalog::Schema(cols));
+        auto table = new storage::SqlTable(BlockStore(), accessor_->GetSchema(table_oid));
+        EXPECT_TRUE(accessor_->SetTablePointer(table_oid, table));
+    }
+
+    template <typename RowGenerator>
+    void InsertRows(const std::string &name, const uint32_t num_rows, RowGenerator row_generator) {
+        for (uint32_t begin = 0; begin < num_rows; begin += NUM_ROWS_PER_INSERT) {
+            std::stringstream query;
+            query << "INSERT INTO " << name << " VALUES ";
+            for (uint32_t i = begin; i < std::min(begin + NUM_ROWS_PER_INSERT, num_rows); i++) {
+                query << (i == begin ? "(" : ", (");
+                const auto row = row_generator(i);
+                for (uint32_t col = 0; col < row.size(); col++) {
+                    query << (col == 0 ? "" : ", ") << row[col];
+                }
+                query << ")";
+            }
+            query << ";";
+            RunQuery(query.str());
+        }
+    }
+
+    std::unique_ptr<planner::AbstractPlanNode> Optimize(const std::string &query, const CostModelType cost_model) {
+        auto stmt_list = parser::PostgresParser::BuildParseTree(query);
+        auto accessor = MakeAccessor();
+        binder::BindNodeVisitor binder(common::ManagedPointer(accessor), test_db_oid_);
+        binder.BindNameToNode(common::ManagedPointer(stmt_list.get()), nullptr, nullptr);
+        return taskflow::TaskflowUtil::Optimize(common::ManagedPointer(test_txn_),
+                                                common::ManagedPointer(accessor),
+                                                common::ManagedPointer(stmt_list),
+                                                test_db_oid_,
+                                                stats_storage_,
+                                                CostModelUtil::CreateCostModel(cost_model),
+                                                1000000,
+                                                nullptr)
+            ->TakePlanNodeOwnership();
+    }
+
+    // Collects the nodes of the plan of a given type in pre-order
+    static void CollectNodes(const planner::AbstractPlanNode                *plan,
+                             const planner::PlanNodeType                     type,
+                             std::vector<const planner::AbstractPlanNode *> *nodes) {
+        if (plan->GetPlanNodeType() == type) {
+            nodes->push_back(plan);
+        }
+        for (const auto child : plan->GetChildren()) {
+            CollectNodes(child.Get(), type, nodes);
+        }
+    }
+
+    // Returns the oid of the table that is scanned in the subtree of the plan, which must scan a single table
+    static catalog::table_oid_t ScannedTable(const planner::AbstractPlanNode *plan) {
+        std::vector<const planner::AbstractPlanNode *> seq_scans;
+        std::vector<const planner::AbstractPlanNode *> index_scans;
+        CollectNodes(plan, planner::PlanNodeType::SEQSCAN, &seq_scans);
+        CollectNodes(plan, planner::PlanNodeType::INDEXSCAN, &index_scans);
+        EXPECT_EQ(seq_scans.size() + index_scans.size(), 1);
+        if (!seq_scans.empty()) {
+            return static_cast<const planner::SeqScanPlanNode *>(seq_scans[0])->GetTableOid();
+        }
+        return static_cast<const planner::IndexScanPlanNode *>(index_scans[0])->GetTableOid();
+    }
+};
+
+// NOLINTNEXTLINE
+TEST_F(StatsCostModelTests, CostModelStringTest) {
+    EXPECT_EQ(CostModelUtil::FromCostModelString("TRIVIAL"), CostModelType::TRIVIAL);
+    EXPECT_EQ(CostModelUtil::FromCostModelString("STATS"), CostModelType::STATS);
+    EXPECT_EQ(CostModelUtil::FromCostModelString("stats"), std::nullopt);
+    EXPECT_NE(dynamic_cast<TrivialCostModel *>(CostModelUtil::CreateCostModel(CostModelType::TRIVIAL).get()), nullptr);
+    EXPECT_NE(dynamic_cast<StatsCostModel *>(CostModelUtil::CreateCostModel(CostModelType::STATS).get()), nullptr);
+}
+
+// A point lookup on the key of orders goes through the index, while a range that covers almost all of orders is read
+// with a sequential scan instead of a random access per tuple
+// NOLINTNEXTLINE
+TEST_F(StatsCostModelTests, IndexScanSelectivityTest) {
+    auto plan = Optimize("SELECT o_totalprice FROM orders WHERE o_orderkey = 5;", CostModelType::STATS);
+    std::vector<const planner::AbstractPlanNode *> index_scans;
+    CollectNodes(plan.get(), planner::PlanNodeType::INDEXSCAN, &index_scans);
+    EXPECT_EQ(index_scans.size(), 1);
+
+    plan = Optimize("SELECT o_totalprice FROM orders WHERE o_orderkey > 10;", CostModelType::STATS);
+    std::vector<const planner::AbstractPlanNode *> seq_scans;
+    CollectNodes(plan.get(), planner::PlanNodeType::SEQSCAN, &seq_scans);
+    EXPECT_EQ(seq_scans.size(), 1);
+}
+
+// An equi-join of two tables without a selective predicate is a hash join that builds on the smaller table
+// NOLINTNEXTLINE
+TEST_F(StatsCostModelTests, HashJoinBuildSideTest) {
+    auto plan = Optimize("SELECT c_mktsegment, o_totalprice FROM customer, orders WHERE c_custkey = o_custkey;",
+                         CostModelType::STATS);
+    std::vector<const planner::AbstractPlanNode *> hash_joins;
+    CollectNodes(plan.get(), planner::PlanNodeType::HASHJOIN, &hash_joins);
+    ASSERT_EQ(hash_joins.size(), 1);
+    EXPECT_EQ(ScannedTable(hash_joins[0]->GetChild(0)), MakeAccessor()->GetTableOid("customer"));
+    EXPECT_EQ(ScannedTable(hash_joins[0]->GetChild(1)), MakeAccessor()->GetTableOid("orders"));
+}
+
+// When few orders qualify, looking up their lineitems through the index is cheaper than hashing all of lineitem
+// NOLINTNEXTLINE
+TEST_F(StatsCostModelTests, IndexJoinSelectiveOuterTest) {
+    auto plan = Optimize(
+        "SELECT o_orderkey, l_quantity FROM orders, lineitem WHERE o_orderkey = l_orderkey AND o_orderdate < 10;",
+        CostModelType::STATS);
+    std::vector<const planner::AbstractPlanNode *> index_joins;
+    CollectNodes(plan.get(), planner::PlanNodeType::INDEXNLJOIN, &index_joins);
+    ASSERT_EQ(index_joins.size(), 1);
+    EXPECT_EQ(ScannedTable(index_joins[0]->GetChild(0)), MakeAccessor()->GetTableOid("orders"));
+}
+
+// TPC-H Q3 (shipping priority) joins customer, orders and lineitem. None of the joins should be a nested loop join,
+// which the trivial cost model prefers regardless of the size of the tables.
+// NOLINTNEXTLINE
+TEST_F(StatsCostModelTests, TpchQ3Test) {
+    const std::string query
+        = "SELECT l_orderkey, SUM(l_extendedprice), o_orderdate FROM customer, orders, lineitem "
+          "WHERE c_mktsegment = 1 AND c_custkey = o_custkey AND l_orderkey = o_orderkey AND o_orderdate < 100 "
+          "GROUP BY l_orderkey, o_orderdate ORDER BY o_orderdate LIMIT 10;";
+    auto plan = Optimize(query, CostModelType::STATS);
+
+    std::vector<const planner::AbstractPlanNode *> nl_joins;
+    CollectNodes(plan.get(), planner::PlanNodeType::NESTLOOP, &nl_joins);
+    EXPECT_TRUE(nl_joins.empty());
+
+    std::vector<const planner::AbstractPlanNode *> joins;
+    CollectNodes(plan.get(), planner::PlanNodeType::HASHJOIN, &joins);
+    CollectNodes(plan.get(), planner::PlanNodeType::INDEXNLJOIN, &joins);
+    EXPECT_EQ(joins.size(), 2);
+}
+
+} // namespace noisepage::optimizer
@@ -14,6 +14,7 @@
 #include "parser/expression/function_expression.h"
 #include "parser/expression/operator_expression.h"
 #include "parser/expression/type_cast_expression.h"
+#include "parser/expression/window_expression.h"
 #include "parser/pg_trigger.h"
 #include "parser/postgresparser.h"
 #include "parser/statements.h"
@@ -740,6 +741,67 @@ TEST_F(ParserTestBase, OldAggTest) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(ParserTestBase, WindowTest) {
+    {
+        std::string query = "SELECT RANK() OVER (PARTITION BY a ORDER BY b DESC, c) FROM foo;";
+        auto        result = parser::PostgresParser::BuildParseTree(query);
+        auto        statement = result->GetStatement(0).CastTo<SelectStatement>();
+        EXPECT_EQ(ExpressionType::WINDOW_RANK, statement->GetSelectColumns()[0]->GetExpressionType());
+
+        auto window = statement->GetSelectColumns()[0].CastTo<WindowExpression>();
+        EXPECT_EQ(0, window->GetNumArgs());
+        EXPECT_EQ(1, window->GetNumPartitionBy());
+        EXPECT_EQ("a", window->GetPartitionBy(0).CastTo<ColumnValueExpression>()->GetColumnName());
+        EXPECT_EQ(2, window->GetNumOrderBy());
+        EXPECT_EQ("b", window->GetOrderBy(0).CastTo<ColumnValueExpression>()->GetColumnName());
+        EXPECT_EQ(kOrderDesc, window->GetOrderByType(0));
+        EXPECT_EQ("c", window->GetOrderBy(1).CastTo<ColumnValueExpression>()->GetColumnName());
+        EXPECT_EQ(kOrderAsc, window->GetOrderByType(1));
+
+        // Without a frame clause, the frame runs from the start of the partition to the peers of the current row
+        EXPECT_EQ(WindowFrameType::RANGE, window->GetFrame().type_);
+        EXPECT_EQ(WindowFrameBoundType::UNBOUNDED_PRECEDING, window->GetFrame().start_);
+        EXPECT_EQ(WindowFrameBoundType::CURRENT_ROW, window->GetFrame().end_);
+    }
+
+    {
+        std::string query = "SELECT SUM(a) OVER (ORDER BY b ROWS BETWEEN 2 PRECEDING AND 1 FOLLOWING) FROM foo;";
+        auto        result = parser::PostgresParser::BuildParseTree(query);
+        auto        statement = result->GetStatement(0).CastTo<SelectStatement>();
+        EXPECT_EQ(ExpressionType::WINDOW_SUM, statement->GetSelectColumns()[0]->GetExpressionType());
+
+        auto window = statement->GetSelectColumns()[0].CastTo<WindowExpression>();
+        EXPECT_EQ(1, window->GetNumArgs());
+        EXPECT_EQ("a", window->GetArg(0).CastTo<ColumnValueExpression>()->GetColumnName());
+        EXPECT_EQ(0, window->GetNumPartitionBy());
+        EXPECT_EQ(1, window->GetNumOrderBy());
+        EXPECT_EQ(WindowFrameType::ROWS, window->GetFrame().type_);
+        EXPECT_EQ(WindowFrameBoundType::PRECEDING, window->GetFrame().start_);
+        EXPECT_EQ(2, window->GetFrame().start_offset_);
+        EXPECT_EQ(WindowFrameBoundType::FOLLOWING, window->GetFrame().end_);
+        EXPECT_EQ(1, window->GetFrame().end_offset_);
+
+        // Copies keep the layout of the children and the frame
+        auto copy = window->Copy();
+        EXPECT_EQ(*window, *copy);
+        EXPECT_EQ(window->Hash(), copy->Hash());
+    }
+
+    {
+        std::string query = "SELECT COUNT(*) OVER () FROM foo;";
+        auto        result = parser::PostgresParser::BuildParseTree(query);
+        auto        statement = result->GetStatement(0).CastTo<SelectStatement>();
+        EXPECT_EQ(ExpressionType::WINDOW_COUNT, statement->GetSelectColumns()[0]->GetExpressionType());
+        EXPECT_EQ(ExpressionType::STAR, statement->GetSelectColumns()[0]->GetChild(0)->GetExpressionType());
+    }
+
+    EXPECT_THROW(parser::PostgresParser::BuildParseTree("SELECT RANK() OVER w FROM foo WINDOW w AS (ORDER BY a);"),
+                 ParserException);
+    EXPECT_THROW(parser::PostgresParser::BuildParseTree("SELECT LOWER(a) OVER () FROM foo;"), ParserException);
+    EXPECT_THROW(parser::PostgresParser::BuildParseTree("SELECT ROW_NUMBER(a) OVER () FROM foo;"), ParserException);
+}
+
 // NOLINTNEXTLINE
 TEST_F(ParserTestBase, OldGroupByTest) {
     // Select with group by clause
@@ -1,9 +1,11 @@
 #include "storage/block_compactor.h"
 
+#include <algorithm>
 #include <unordered_map>
 #include <vector>
 
 #include "common/hash_util.h"
+#include "execution/sql/vector_projection.h"
 #include "storage/block_access_controller.h"
 #include "storage/garbage_collector.h"
 #include "storage/storage_defs.h"
@@ -279,10 +281,10 @@ TEST_F(BlockCompactorTest, GatherTest) {
         gc.PerformGarbageCollection();
         gc.PerformGarbageCollection(); // Second call to deallocate.
         // Deallocate all the leftover gathered varlens
-        // No need to gather the ones still in the block because they are presumably all gathered
+        // No need to gather the ones still in the block because they are presumably all gathered. Fixed-length
+        // columns can have a compressed copy to deallocate as well.
         for (storage::col_id_t col_id : layout.AllColumns())
-            if (layout.IsVarlen(col_id))
-                arrow_metadata.GetColumnInfo(layout, col_id).Deallocate();
+            arrow_metadata.GetColumnInfo(layout, col_id).Deallocate();
         block_store_.Release(block);
     }
 }
@@ -361,6 +363,11 @@ TEST_F(BlockCompactorTest, DictionaryCompressionTest) {
             }
         }
 
+        // Compression of frozen blocks is off by default, so no column keeps a compressed copy next to the block
+        for (storage::col_id_t col_id : StorageTestUtil::ProjectionListAllColumns(layout))
+            EXPECT_EQ(storage::ColumnEncoding::UNCOMPRESSED,
+                      arrow_metadata.GetColumnInfo(layout, col_id).Compressed().Encoding());
+
         // This transaction is guaranteed to start after the compacting one commits
         transaction::TransactionContext *txn = txn_manager.BeginTransaction();
         for (uint32_t i = 0; i < num_tuples; i++) {
@@ -415,12 +422,256 @@ TEST_F(BlockCompactorTest, DictionaryCompressionTest) {
         gc.PerformGarbageCollection();
         gc.PerformGarbageCollection(); // Second call to deallocate.
         // Deallocate all the leftover gathered varlens
-        // No need to gather the ones still in the block because they are presumably all gathered
+        // No need to gather the ones still in the block because they are presumably all gathered. Fixed-length
+        // columns can have a compressed copy to deallocate as well.
         for (storage::col_id_t col_id : layout.AllColumns())
-            if (layout.IsVarlen(col_id))
-                arrow_metadata.GetColumnInfo(layout, col_id).Deallocate();
+            arrow_metadata.GetColumnInfo(layout, col_id).Deallocate();
         block_store_.Release(block);
     }
 }
 
+// This tests freezes a table block whose columns compress well with compression of frozen blocks turned on, and
+// verifies that a sequential scan, which decodes the compressed columns into the vector projection, reads out every
+// tuple unmodified.
+// NOLINTNEXTLINE
+TEST_F(BlockCompactorTest, CompressedScanTest) {
+    // The 8-byte column has long runs, the 4-byte column a narrow range, the 2-byte column a few values far apart, and
+    // the 1-byte column has nulls
+    storage::BlockLayout                 layout({8, 8, 4, 2, 1});
+    storage::DataTable                   table(common::ManagedPointer<storage::BlockStore>(&block_store_),
+                             layout,
+                             storage::layout_version_t(0));
+    const std::vector<storage::col_id_t> col_ids = StorageTestUtil::ProjectionListAllColumns(layout);
+
+    auto value = [](const storage::col_id_t col_id, const uint32_t offset) -> int64_t {
+        switch (col_id.UnderlyingValue()) {
+        case 1:
+            return offset / 100;
+        case 2:
+            return 1000 + offset % 50;
+        case 3:
+            return static_cast<int64_t>(offset % 3) * 10000 - 15000;
+        default:
+            return offset % 2;
+        }
+    };
+    auto is_null = [](const storage::col_id_t col_id, const uint32_t offset) {
+        return col_id == storage::col_id_t(4) && offset % 7 == 0;
+    };
+
+    transaction::TimestampManager      timestamp_manager;
+    transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+    transaction::TransactionManager    txn_manager{common::ManagedPointer(&timestamp_manager),
+                                                common::ManagedPointer(&deferred_action_manager),
+                                                common::ManagedPointer(&buffer_pool_),
+                                                true,
+                                                false,
+                                                DISABLED};
+    storage::GarbageCollector          gc{common::ManagedPointer(&timestamp_manager),
+                                 common::ManagedPointer(&deferred_action_manager),
+                                 common::ManagedPointer(&txn_manager),
+                                 DISABLED};
+
+    // Fill up the first block of the table, so that the compactor can freeze it
+    auto               initializer = storage::ProjectedRowInitializer::Create(layout, col_ids);
+    byte              *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    auto              *txn = txn_manager.BeginTransaction();
+    storage::RawBlock *block = nullptr;
+    for (uint32_t offset = 0; offset < layout.NumSlots(); offset++) {
+        auto *row = initializer.InitializeRow(buffer);
+        for (uint16_t i = 0; i < row->NumColumns(); i++) {
+            const storage::col_id_t col_id = row->ColumnIds()[i];
+            if (is_null(col_id, offset)) {
+                row->SetNull(i);
+                continue;
+            }
+            const int64_t attr = value(col_id, offset);
+            std::memcpy(row->AccessForceNotNull(i), &attr, layout.AttrSize(col_id));
+        }
+        const storage::TupleSlot slot = table.Insert(common::ManagedPointer(txn), *row);
+        EXPECT_EQ(offset, slot.GetOffset());
+        block = slot.GetBlock();
+    }
+    txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    delete[] buffer;
+    gc.PerformGarbageCollection();
+    gc.PerformGarbageCollection();
+
+    storage::BlockCompactor compactor(true);
+    compactor.PutInQueue(block);
+    compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager); // compaction pass
+    gc.PerformGarbageCollection();
+    compactor.PutInQueue(block);
+    compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager); // gathering pass
+    ASSERT_EQ(storage::BlockState::FROZEN, block->controller_.GetBlockState()->load());
+
+    storage::TupleAccessStrategy accessor(layout);
+    auto                        &arrow_metadata = accessor.GetArrowBlockMetadata(block);
+    EXPECT_EQ(storage::ColumnEncoding::RUN_LENGTH,
+              arrow_metadata.GetColumnInfo(layout, storage::col_id_t(1)).Compressed().Encoding());
+    EXPECT_EQ(storage::ColumnEncoding::FRAME_OF_REFERENCE,
+              arrow_metadata.GetColumnInfo(layout, storage::col_id_t(2)).Compressed().Encoding());
+    EXPECT_EQ(storage::ColumnEncoding::DICTIONARY,
+              arrow_metadata.GetColumnInfo(layout, storage::col_id_t(3)).Compressed().Encoding());
+
+    execution::sql::VectorProjection projection;
+    projection.SetStorageColIds(col_ids);
+    std::vector<execution::sql::TypeId> col_types;
+    for (storage::col_id_t col_id : col_ids) {
+        switch (layout.AttrSize(col_id)) {
+        case 8:
+            col_types.push_back(execution::sql::TypeId::BigInt);
+            break;
+        case 4:
+            col_types.push_back(execution::sql::TypeId::Integer);
+            break;
+        case 2:
+            col_types.push_back(execution::sql::TypeId::SmallInt);
+            break;
+        default:
+            col_types.push_back(execution::sql::TypeId::TinyInt);
+        }
+    }
+    projection.Initialize(col_types);
+
+    txn = txn_manager.BeginTransaction();
+    uint32_t num_read = 0;
+    auto     it = table.begin();
+    while (it != table.end() && it->GetBlock() != nullptr) {
+        table.Scan(common::ManagedPointer(txn), &it, &projection);
+        for (uint32_t row = 0; row < projection.GetTotalTupleCount(); row++) {
+            const storage::TupleSlot slot = projection.GetTupleSlot(row);
+            EXPECT_EQ(block, slot.GetBlock());
+            for (uint32_t i = 0; i < col_ids.size(); i++) {
+                const execution::sql::Vector *column = projection.GetColumn(i);
+                const bool                    null = is_null(col_ids[i], slot.GetOffset());
+                EXPECT_EQ(null, column->IsNull(row));
+                if (!null) {
+                    const int64_t  expected = value(col_ids[i], slot.GetOffset());
+                    const uint16_t size = layout.AttrSize(col_ids[i]);
+                    EXPECT_EQ(0, std::memcmp(column->GetData() + row * size, &expected, size));
+                }
+            }
+            num_read++;
+        }
+    }
+    EXPECT_EQ(layout.NumSlots(), num_read);
+    txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    gc.PerformGarbageCollection();
+    gc.PerformGarbageCollection();
+}
+
+
+// Verify that zone maps cover every value written to a block, that scans skip blocks whose zone maps rule out their
+// filters, and that freezing a block makes its zone maps exact
+// NOLINTNEXTLINE
+TEST_F(BlockCompactorTest, ZoneMapTest) {
+    // The 8-byte column counts up through the table and the 4-byte column has nulls
+    storage::BlockLayout                 layout({8, 8, 4});
+    storage::DataTable                   table(common::ManagedPointer<storage::BlockStore>(&block_store_),
+                             layout,
+                             storage::layout_version_t(0));
+    const std::vector<storage::col_id_t> col_ids = StorageTestUtil::ProjectionListAllColumns(layout);
+    const storage::col_id_t              count_col(1), nullable_col(2);
+    const uint32_t                       num_slots = layout.NumSlots();
+
+    transaction::TimestampManager      timestamp_manager;
+    transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+    transaction::TransactionManager    txn_manager{common::ManagedPointer(&timestamp_manager),
+                                                common::ManagedPointer(&deferred_action_manager),
+                                                common::ManagedPointer(&buffer_pool_),
+                                                true,
+                                                false,
+                                                DISABLED};
+    storage::GarbageCollector          gc{common::ManagedPointer(&timestamp_manager),
+                                 common::ManagedPointer(&deferred_action_manager),
+                                 common::ManagedPointer(&txn_manager),
+                                 DISABLED};
+
+    // Fill up two blocks and start a third one
+    auto                            initializer = storage::ProjectedRowInitializer::Create(layout, col_ids);
+    byte                           *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    auto                           *txn = txn_manager.BeginTransaction();
+    std::vector<storage::RawBlock *> blocks;
+    std::vector<storage::TupleSlot>  slots;
+    for (uint32_t i = 0; i < 2 * num_slots + 100; i++) {
+        auto         *row = initializer.InitializeRow(buffer);
+        const int64_t count = i;
+        const int32_t nullable = static_cast<int32_t>(i % 1000) - 500;
+        std::memcpy(row->AccessForceNotNull(0), &count, sizeof(count));
+        if (i % 10 == 0) {
+            row->SetNull(1);
+        } else {
+            std::memcpy(row->AccessForceNotNull(1), &nullable, sizeof(nullable));
+        }
+        slots.push_back(table.Insert(common::ManagedPointer(txn), *row));
+        if (blocks.empty() || blocks.back() != slots.back().GetBlock()) {
+            blocks.push_back(slots.back().GetBlock());
+        }
+    }
+    txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    ASSERT_EQ(3U, blocks.size());
+
+    storage::TupleAccessStrategy accessor(layout);
+    for (uint32_t b = 0; b < blocks.size(); b++) {
+        const auto &metadata = accessor.GetArrowBlockMetadata(blocks[b]);
+        EXPECT_EQ(static_cast<int64_t>(b * num_slots), metadata.GetZoneMap(layout, count_col).Min());
+        EXPECT_EQ(static_cast<int64_t>(std::min(b * num_slots + num_slots, 2 * num_slots + 100) - 1),
+                  metadata.GetZoneMap(layout, count_col).Max());
+        EXPECT_EQ(0U, metadata.GetZoneMap(layout, count_col).NullCount());
+        EXPECT_GT(metadata.GetZoneMap(layout, nullable_col).NullCount(), 0U);
+    }
+
+    // Overwrite the first value and then write it back, so that the first block's zone map stays wider than its values
+    auto update_initializer = storage::ProjectedRowInitializer::Create(layout, {count_col});
+    byte *update_buffer = common::AllocationUtil::AllocateAligned(update_initializer.ProjectedRowSize());
+    for (const int64_t count : {int64_t{-1}, int64_t{0}}) {
+        txn = txn_manager.BeginTransaction();
+        auto *row = update_initializer.InitializeRow(update_buffer);
+        std::memcpy(row->AccessForceNotNull(0), &count, sizeof(count));
+        EXPECT_TRUE(table.Update(common::ManagedPointer(txn), slots[0], *row));
+        txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    }
+    delete[] update_buffer;
+    delete[] buffer;
+    EXPECT_EQ(-1, accessor.GetArrowBlockMetadata(blocks[0]).GetZoneMap(layout, count_col).Min());
+
+    // Only the second block can hold values in the filtered range, so none of the other blocks is read
+    execution::sql::VectorProjection projection;
+    projection.SetStorageColIds(col_ids);
+    projection.Initialize({execution::sql::TypeId::BigInt, execution::sql::TypeId::Integer});
+    const std::vector<storage::ZoneMapFilter> filters{{count_col, num_slots + 10, num_slots + 20}};
+    txn = txn_manager.BeginTransaction();
+    uint32_t num_read = 0;
+    auto     it = table.begin();
+    while (it != table.end() && it->GetBlock() != nullptr) {
+        table.Scan(common::ManagedPointer(txn), &it, &projection, filters);
+        for (uint32_t row = 0; row < projection.GetTotalTupleCount(); row++) {
+            EXPECT_EQ(blocks[1], projection.GetTupleSlot(row).GetBlock());
+            num_read++;
+        }
+    }
+    EXPECT_EQ(num_slots, num_read);
+    txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    gc.PerformGarbageCollection();
+    gc.PerformGarbageCollection();
+
+    // Freezing the first block narrows its zone maps down to the values that are left
+    storage::BlockCompactor compactor;
+    compactor.PutInQueue(blocks[0]);
+    compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager); // compaction pass
+    gc.PerformGarbageCollection();
+    compactor.PutInQueue(blocks[0]);
+    compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager); // gathering pass
+    ASSERT_EQ(storage::BlockState::FROZEN, blocks[0]->controller_.GetBlockState()->load());
+    const auto &metadata = accessor.GetArrowBlockMetadata(blocks[0]);
+    EXPECT_EQ(0, metadata.GetZoneMap(layout, count_col).Min());
+    EXPECT_EQ(static_cast<int64_t>(num_slots - 1), metadata.GetZoneMap(layout, count_col).Max());
+    EXPECT_EQ(metadata.NullCount(nullable_col), metadata.GetZoneMap(layout, nullable_col).NullCount());
+    EXPECT_EQ(-499, metadata.GetZoneMap(layout, nullable_col).Min());
+    EXPECT_EQ(499, metadata.GetZoneMap(layout, nullable_col).Max());
+    gc.PerformGarbageCollection();
+    gc.PerformGarbageCollection();
+}
+
 } // namespace noisepage
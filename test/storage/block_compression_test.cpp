@@ -0,0 +1,135 @@
+#include "storage/block_compression.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "common/container/concurrent_bitmap.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage {
+
+struct BlockCompressionTest : public TerrierTest {
+    std::default_random_engine generator_;
+
+    // Compresses the values, checks the encoding chosen and that every non-null value decodes to itself, whether all
+    // values are decoded at once or a random range of them
+    template <class T>
+    void CheckRoundTrip(const std::vector<T>                &values,
+                        const common::RawConcurrentBitmap *const nulls,
+                        const storage::ColumnEncoding        expected_encoding) {
+        const auto  num_values = static_cast<uint32_t>(values.size());
+        const auto *raw = reinterpret_cast<const byte *>(values.data());
+        auto        compressed = storage::CompressedColumn::Compress(raw, nulls, sizeof(T), num_values);
+        EXPECT_EQ(expected_encoding, compressed.Encoding());
+        EXPECT_EQ(num_values, compressed.NumValues());
+        if (compressed.Encoding() == storage::ColumnEncoding::UNCOMPRESSED) {
+            return;
+        }
+        EXPECT_LT(compressed.CompressedSize(), num_values * sizeof(T));
+
+        std::vector<T> decoded(num_values);
+        compressed.Decode(0, num_values, reinterpret_cast<byte *>(decoded.data()));
+        for (uint32_t i = 0; i < num_values; i++) {
+            if (nulls == nullptr || nulls->Test(i)) {
+                EXPECT_EQ(values[i], decoded[i]);
+            }
+        }
+
+        std::uniform_int_distribution<uint32_t> start_dist(0, num_values - 1);
+        const uint32_t                          start = start_dist(generator_);
+        std::uniform_int_distribution<uint32_t> count_dist(1, num_values - start);
+        const uint32_t                          count = count_dist(generator_);
+        std::vector<T>                          range(count);
+        compressed.Decode(start, count, reinterpret_cast<byte *>(range.data()));
+        for (uint32_t i = 0; i < count; i++) {
+            if (nulls == nullptr || nulls->Test(start + i)) {
+                EXPECT_EQ(values[start + i], range[i]);
+            }
+        }
+    }
+};
+
+// Values in a narrow range, including negative ones, are bit-packed relative to the smallest of them
+// NOLINTNEXTLINE
+TEST_F(BlockCompressionTest, FrameOfReferenceTest) {
+    const uint32_t num_values = 10000;
+    for (uint32_t iteration = 0; iteration < 10; iteration++) {
+        std::uniform_int_distribution<int32_t> dist(-1000, 1000);
+        std::vector<int32_t>                   ints(num_values);
+        for (auto &value : ints) {
+            value = dist(generator_);
+        }
+        CheckRoundTrip(ints, nullptr, storage::ColumnEncoding::FRAME_OF_REFERENCE);
+
+        std::vector<int64_t> bigints(num_values);
+        for (auto &value : bigints) {
+            value = (int64_t{1} << 40) + dist(generator_);
+        }
+        CheckRoundTrip(bigints, nullptr, storage::ColumnEncoding::FRAME_OF_REFERENCE);
+    }
+}
+
+// Long runs of equal values are stored once per run
+// NOLINTNEXTLINE
+TEST_F(BlockCompressionTest, RunLengthTest) {
+    const uint32_t num_values = 10000;
+    for (uint32_t iteration = 0; iteration < 10; iteration++) {
+        std::uniform_int_distribution<int64_t>  value_dist(INT64_MIN, INT64_MAX);
+        std::uniform_int_distribution<uint32_t> run_dist(1, 1000);
+        std::vector<int64_t>                    values;
+        while (values.size() < num_values) {
+            values.insert(values.end(), run_dist(generator_), value_dist(generator_));
+        }
+        values.resize(num_values);
+        CheckRoundTrip(values, nullptr, storage::ColumnEncoding::RUN_LENGTH);
+    }
+}
+
+// A few distinct values spread over a wide range are stored as codes into a dictionary
+// NOLINTNEXTLINE
+TEST_F(BlockCompressionTest, DictionaryTest) {
+    const uint32_t num_values = 10000;
+    for (uint32_t iteration = 0; iteration < 10; iteration++) {
+        std::uniform_int_distribution<int32_t> value_dist(INT16_MIN, INT16_MAX);
+        std::vector<int16_t>                   distinct(16);
+        for (auto &value : distinct) {
+            value = static_cast<int16_t>(value_dist(generator_));
+        }
+        std::uniform_int_distribution<uint32_t> index_dist(0, static_cast<uint32_t>(distinct.size() - 1));
+        std::vector<int16_t>                    values(num_values);
+        for (auto &value : values) {
+            value = distinct[index_dist(generator_)];
+        }
+        CheckRoundTrip(values, nullptr, storage::ColumnEncoding::DICTIONARY);
+    }
+}
+
+// Null values take on the value before them, so they neither break runs nor widen the frame, and random values that do
+// not compress are left alone
+// NOLINTNEXTLINE
+TEST_F(BlockCompressionTest, NullAndIncompressibleTest) {
+    const uint32_t      num_values = 10000;
+    auto               *nulls = common::RawConcurrentBitmap::Allocate(num_values);
+    std::vector<int8_t> values(num_values);
+    for (uint32_t i = 0; i < num_values; i++) {
+        // Nulls have garbage values that would need all 8 bits
+        if (i % 7 == 0) {
+            values[i] = INT8_MIN;
+        } else {
+            nulls->Flip(i, false);
+            values[i] = static_cast<int8_t>(i / 500);
+        }
+    }
+    CheckRoundTrip(values, nulls, storage::ColumnEncoding::RUN_LENGTH);
+    common::RawConcurrentBitmap::Deallocate(nulls);
+
+    std::uniform_int_distribution<int64_t> dist(INT64_MIN, INT64_MAX);
+    std::vector<int64_t>                   random(num_values);
+    for (auto &value : random) {
+        value = dist(generator_);
+    }
+    CheckRoundTrip(random, nullptr, storage::ColumnEncoding::UNCOMPRESSED);
+}
+
+} // namespace noisepage
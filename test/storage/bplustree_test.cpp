@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdlib>
 #include <set>
 #include <unordered_map>
@@ -1756,4 +1757,71 @@ TEST_F(BPlusTreeTests, MultiThreadedIteratorTest) {
     delete tree;
 }
 
+// NOLINTNEXTLINE
+TEST_F(BPlusTreeTests, BulkLoadTest) {
+    /**
+     * Bulk loads sorted keys, some of them with several values, and checks the structure and contents of the tree.
+     * Inserts and deletes must keep working on the bulk loaded tree.
+     */
+    auto predicate = [](const int64_t slot) -> bool {
+        return false;
+    };
+
+    for (const int key_num : {1, 16, 17, 1000, 100 * 1000}) {
+        auto *const tree = new BPlusTree<int64_t, int64_t>;
+        tree->SetInnerNodeSizeUpperThreshold(16);
+        tree->SetLeafNodeSizeUpperThreshold(16);
+        tree->SetInnerNodeSizeLowerThreshold(6);
+        tree->SetLeafNodeSizeLowerThreshold(6);
+
+        // Every third key has a second value
+        std::vector<BPlusTree<int64_t, int64_t>::KeyElementPair> elements;
+        std::set<int64_t>                                        keys;
+        for (int64_t i = 0; i < key_num; i++) {
+            elements.emplace_back(2 * i, i);
+            if (i % 3 == 0) {
+                elements.emplace_back(2 * i, -i);
+            }
+            keys.insert(2 * i);
+        }
+        tree->BulkLoad(elements);
+        EXPECT_EQ(tree->GetSize(), key_num);
+
+        auto keys_copy = keys;
+        EXPECT_TRUE(tree->StructuralIntegrityVerification(*keys.begin(), *keys.rbegin(), &keys_copy, tree->GetRoot()));
+        EXPECT_EQ(keys_copy.size(), 0);
+        keys_copy = keys;
+        EXPECT_TRUE(tree->SiblingForwardCheck(&keys_copy));
+
+        std::vector<int64_t> values;
+        for (int64_t i = 0; i < key_num; i++) {
+            values.clear();
+            tree->FindValueOfKey(2 * i, &values);
+            EXPECT_EQ(values.size(), i % 3 == 0 ? 2 : 1);
+            EXPECT_NE(std::find(values.begin(), values.end(), i), values.end());
+        }
+
+        // Fill the gaps between the loaded keys, then delete the loaded keys again
+        for (int64_t i = 0; i < key_num; i++) {
+            BPlusTree<int64_t, int64_t>::KeyElementPair p1;
+            p1.first = 2 * i + 1;
+            p1.second = i;
+            EXPECT_TRUE(tree->Insert(p1, predicate));
+        }
+        for (const auto &element : elements) {
+            EXPECT_TRUE(tree->DeleteElement(element));
+        }
+        std::set<int64_t> odd_keys;
+        for (int64_t i = 0; i < key_num; i++) {
+            odd_keys.insert(2 * i + 1);
+        }
+        EXPECT_TRUE(
+            tree->StructuralIntegrityVerification(*odd_keys.begin(), *odd_keys.rbegin(), &odd_keys, tree->GetRoot()));
+        EXPECT_EQ(odd_keys.size(), 0);
+        EXPECT_EQ(tree->GetSize(), key_num);
+
+        delete tree;
+    }
+}
+
 } // namespace noisepage::storage::index
@@ -0,0 +1,382 @@
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread> // NOLINT
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/postgres/pg_namespace.h"
+#include "main/db_main.h"
+#include "storage/garbage_collector_thread.h"
+#include "storage/recovery/checkpoint_log_provider.h"
+#include "storage/recovery/checkpoint_manager.h"
+#include "storage/recovery/disk_log_provider.h"
+#include "storage/recovery/recovery_manager.h"
+#include "storage/sql_table.h"
+#include "storage/write_ahead_log/log_manager.h"
+#include "test_util/sql_table_test_util.h"
+#include "test_util/storage_test_util.h"
+#include "test_util/test_harness.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_manager.h"
+#include "gtest/gtest.h"
+
+// As in the recovery tests, every file created here must be removed after the test finishes. Log rotation creates
+// additional segment files next to the log file, which are removed along with it.
+#define CHECKPOINT_TEST_LOG_FILE_NAME "./test_checkpoint_test.log"
+#define CHECKPOINT_TEST_CHECKPOINT_FILE_NAME "./test_checkpoint_test.ckpt"
+
+namespace noisepage::storage {
+class CheckpointTests : public TerrierTest {
+protected:
+    std::default_random_engine generator_;
+
+    // Original Components
+    std::unique_ptr<DBMain>                                 db_main_;
+    common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+    common::ManagedPointer<storage::LogManager>             log_manager_;
+    common::ManagedPointer<storage::BlockStore>             block_store_;
+    common::ManagedPointer<catalog::Catalog>                catalog_;
+    std::unique_ptr<CheckpointManager>                      checkpoint_manager_;
+
+    // Recovery Components
+    std::unique_ptr<DBMain>                                    recovery_db_main_;
+    common::ManagedPointer<transaction::TransactionManager>    recovery_txn_manager_;
+    common::ManagedPointer<transaction::DeferredActionManager> recovery_deferred_action_manager_;
+    common::ManagedPointer<storage::BlockStore>                recovery_block_store_;
+    common::ManagedPointer<catalog::Catalog>                   recovery_catalog_;
+    common::ManagedPointer<common::DedicatedThreadRegistry>    recovery_thread_registry_;
+
+    static void RemoveFiles() {
+        unlink(CHECKPOINT_TEST_LOG_FILE_NAME);
+        LogManager::RemoveLogSegmentsBefore(CHECKPOINT_TEST_LOG_FILE_NAME, std::numeric_limits<uint64_t>::max());
+        unlink(CHECKPOINT_TEST_CHECKPOINT_FILE_NAME);
+    }
+
+    void SetUp() override {
+        // Remove files in case they exist from a previous test iteration
+        RemoveFiles();
+
+        db_main_ = noisepage::DBMain::Builder()
+                       .SetWalFilePath(CHECKPOINT_TEST_LOG_FILE_NAME)
+                       .SetUseLogging(true)
+                       .SetUseGC(true)
+                       .SetUseGCThread(true)
+                       .SetUseCatalog(true)
+                       .Build();
+        txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+        log_manager_ = db_main_->GetLogManager();
+        block_store_ = db_main_->GetStorageLayer()->GetBlockStore();
+        catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+        const auto timestamp_manager = db_main_->GetTransactionLayer()->GetTimestampManager();
+        checkpoint_manager_ = std::make_unique<CheckpointManager>(CHECKPOINT_TEST_CHECKPOINT_FILE_NAME,
+                                                                  catalog_,
+                                                                  txn_manager_,
+                                                                  timestamp_manager,
+                                                                  log_manager_);
+
+        recovery_db_main_ = noisepage::DBMain::Builder()
+                                .SetUseThreadRegistry(true)
+                                .SetUseGC(true)
+                                .SetUseGCThread(true)
+                                .SetUseCatalog(true)
+                                .SetCreateDefaultDatabase(false)
+                                .Build();
+        recovery_txn_manager_ = recovery_db_main_->GetTransactionLayer()->GetTransactionManager();
+        recovery_deferred_action_manager_ = recovery_db_main_->GetTransactionLayer()->GetDeferredActionManager();
+        recovery_block_store_ = recovery_db_main_->GetStorageLayer()->GetBlockStore();
+        recovery_catalog_ = recovery_db_main_->GetCatalogLayer()->GetCatalog();
+        recovery_thread_registry_ = recovery_db_main_->GetThreadRegistry();
+    }
+
+    void TearDown() override {
+        checkpoint_manager_.reset();
+        RemoveFiles();
+    }
+
+    // Simulates the system shutting down and restarting
+    void ShutdownAndRestartSystem() {
+        // Simulate the system "shutting down". Guarantee persist of log records
+        db_main_->GetGarbageCollectorThread()->StopGC();
+        db_main_->GetTransactionLayer()->GetDeferredActionManager()->FullyPerformGC(
+            db_main_->GetStorageLayer()->GetGarbageCollector(),
+            log_manager_);
+        log_manager_->PersistAndStop();
+
+        // We now "boot up" up the system
+        log_manager_->Start();
+        db_main_->GetGarbageCollectorThread()->StartGC();
+    }
+
+    // Boots up a system on the log and checkpoint of the test, which recovers from the checkpoint on startup
+    static std::unique_ptr<DBMain> StartSystemWithCheckpoints() {
+        return noisepage::DBMain::Builder()
+            .SetWalFilePath(CHECKPOINT_TEST_LOG_FILE_NAME)
+            .SetUseLogging(true)
+            .SetUseGC(true)
+            .SetUseGCThread(true)
+            .SetUseCatalog(true)
+            .SetUseCheckpoints(true)
+            .SetCheckpointFilePath(CHECKPOINT_TEST_CHECKPOINT_FILE_NAME)
+            .SetCheckpointInterval(3600)
+            .Build();
+    }
+
+    // Creates a database with a table of a single integer column
+    static std::pair<catalog::db_oid_t, catalog::table_oid_t> CreateTable(DBMain *const db_main) {
+        auto  txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+        auto  catalog = db_main->GetCatalogLayer()->GetCatalog();
+        auto *txn = txn_manager->BeginTransaction();
+        auto  db_oid = catalog->CreateDatabase(common::ManagedPointer(txn), "checkpointdb", true);
+        EXPECT_TRUE(db_oid != catalog::INVALID_DATABASE_OID);
+        auto db_catalog = catalog->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+        auto col = catalog::Schema::Column("attribute",
+                                           execution::sql::SqlTypeId::Integer,
+                                           false,
+                                           parser::ConstantValueExpression(execution::sql::SqlTypeId::Integer));
+        auto table_oid = db_catalog->CreateTable(common::ManagedPointer(txn),
+                                                 catalog::postgres::PgNamespace::NAMESPACE_DEFAULT_NAMESPACE_OID,
+                                                 "checkpointtable",
+                                                 catalog::Schema(std::vector<catalog::Schema::Column>({col})));
+        EXPECT_TRUE(table_oid != catalog::INVALID_TABLE_OID);
+        auto *table = new SqlTable(db_main->GetStorageLayer()->GetBlockStore(),
+                                   db_catalog->GetSchema(common::ManagedPointer(txn), table_oid));
+        EXPECT_TRUE(db_catalog->SetTablePointer(common::ManagedPointer(txn), table_oid, table));
+        txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+        return {db_oid, table_oid};
+    }
+
+    // Inserts a row into the table in a transaction of its own
+    static void InsertRow(DBMain *const              db_main,
+                          const catalog::db_oid_t    db_oid,
+                          const catalog::table_oid_t table_oid,
+                          const int32_t              value) {
+        auto  txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+        auto  catalog = db_main->GetCatalogLayer()->GetCatalog();
+        auto *txn = txn_manager->BeginTransaction();
+        auto  db_catalog = catalog->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+        auto  table = db_catalog->GetTable(common::ManagedPointer(txn), table_oid);
+        auto  col_oid = db_catalog->GetSchema(common::ManagedPointer(txn), table_oid).GetColumns()[0].Oid();
+        auto *redo = txn->StageWrite(db_oid, table_oid, table->InitializerForProjectedRow({col_oid}));
+        *reinterpret_cast<int32_t *>(redo->Delta()->AccessForceNotNull(0)) = value;
+        table->Insert(common::ManagedPointer(txn), redo);
+        txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    }
+
+    // Returns the values of the visible rows of the table in ascending order
+    static std::vector<int32_t>
+    ReadRows(DBMain *const db_main, const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid) {
+        auto  txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+        auto  catalog = db_main->GetCatalogLayer()->GetCatalog();
+        auto *txn = txn_manager->BeginTransaction();
+        auto  db_catalog = catalog->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+        EXPECT_TRUE(db_catalog != nullptr);
+        auto table = db_catalog->GetTable(common::ManagedPointer(txn), table_oid);
+        EXPECT_TRUE(table != nullptr);
+        auto  col_oid = db_catalog->GetSchema(common::ManagedPointer(txn), table_oid).GetColumns()[0].Oid();
+        auto  initializer = table->InitializerForProjectedRow({col_oid});
+        auto *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+        auto *row = initializer.InitializeRow(buffer);
+
+        std::vector<int32_t> values;
+        for (const auto &slot : *table) {
+            if (table->Select(common::ManagedPointer(txn), slot, row)) {
+                values.push_back(*reinterpret_cast<int32_t *>(row->AccessForceNotNull(0)));
+            }
+        }
+        delete[] buffer;
+        txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+
+    // Runs the workload, taking a checkpoint in the middle of it, and recovers from the checkpoint and the log tail
+    void RunTest(const LargeSqlTableTestConfiguration &config, const uint32_t num_checkpoints) {
+        auto *tested
+            = new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
+        for (uint32_t i = 0; i < num_checkpoints; i++) {
+            tested->SimulateOltp(100, 4);
+            checkpoint_manager_->TakeCheckpoint();
+        }
+        tested->SimulateOltp(100, 4);
+
+        ShutdownAndRestartSystem();
+
+        // The log segments covered by all but the last checkpoint are truncated
+        EXPECT_LE(LogManager::ListLogSegments(CHECKPOINT_TEST_LOG_FILE_NAME).size(), 1U);
+
+        // Instantiate recovery manager, and recover the tables from the checkpoint followed by the log tail
+        CheckpointLogProvider checkpoint_provider(CHECKPOINT_TEST_CHECKPOINT_FILE_NAME);
+        EXPECT_EQ(checkpoint_manager_->GetLastCheckpointTimestamp(), checkpoint_provider.GetCheckpointTimestamp());
+        DiskLogProvider log_provider(
+            CheckpointManager::LogFilesForCheckpoint(checkpoint_provider, CHECKPOINT_TEST_LOG_FILE_NAME));
+        RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
+                                         recovery_catalog_,
+                                         recovery_txn_manager_,
+                                         recovery_deferred_action_manager_,
+                                         DISABLED,
+                                         recovery_thread_registry_,
+                                         recovery_block_store_,
+                                         common::ManagedPointer(&checkpoint_provider)};
+        recovery_manager.StartRecovery();
+        recovery_manager.WaitForRecoveryToFinish();
+
+        // Check we recovered all the original tables
+        for (auto &database : tested->GetTables()) {
+            auto database_oid = database.first;
+            for (auto &table_oid : database.second) {
+                // Get original sql table
+                auto original_txn = txn_manager_->BeginTransaction();
+                auto original_sql_table
+                    = catalog_->GetDatabaseCatalog(common::ManagedPointer(original_txn), database_oid)
+                          ->GetTable(common::ManagedPointer(original_txn), table_oid);
+
+                // Get Recovered table
+                auto *recovery_txn = recovery_txn_manager_->BeginTransaction();
+                auto  db_catalog
+                    = recovery_catalog_->GetDatabaseCatalog(common::ManagedPointer(recovery_txn), database_oid);
+                EXPECT_TRUE(db_catalog != nullptr);
+                auto recovered_sql_table = db_catalog->GetTable(common::ManagedPointer(recovery_txn), table_oid);
+                EXPECT_TRUE(recovered_sql_table != nullptr);
+
+                EXPECT_TRUE(StorageTestUtil::SqlTableEqualDeep(original_sql_table->table_.layout_,
+                                                               original_sql_table,
+                                                               recovered_sql_table,
+                                                               tested->GetTupleSlotsForTable(database_oid, table_oid),
+                                                               recovery_manager.tuple_slot_map_,
+                                                               txn_manager_.Get(),
+                                                               recovery_txn_manager_.Get()));
+                txn_manager_->Commit(original_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+                recovery_txn_manager_->Commit(recovery_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+            }
+        }
+        // the table can't be freed until after all GC on it is guaranteed to be done. The easy way to do that is to use
+        // a DeferredAction
+        db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() {
+            delete tested;
+        });
+    }
+};
+
+// This test runs a workload on a single table, checkpoints it, and runs more of the workload. It then recovers the
+// table from the checkpoint and the log written after it, and verifies that it is the same as the original table
+// NOLINTNEXTLINE
+TEST_F(CheckpointTests, SingleTableTest) {
+    LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                                .SetNumDatabases(1)
+                                                .SetNumTables(1)
+                                                .SetMaxColumns(5)
+                                                .SetInitialTableSize(1000)
+                                                .SetTxnLength(5)
+                                                .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                                .SetVarlenAllowed(true)
+                                                .Build();
+    CheckpointTests::RunTest(config, 1);
+}
+
+// This test takes several checkpoints of multiple tables across multiple databases. Only the last checkpoint and the
+// log written after it are recovered, so this also checks that truncating the log does not lose any changes.
+// NOLINTNEXTLINE
+TEST_F(CheckpointTests, MultipleCheckpointsTest) {
+    LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                                .SetNumDatabases(3)
+                                                .SetNumTables(5)
+                                                .SetMaxColumns(5)
+                                                .SetInitialTableSize(100)
+                                                .SetTxnLength(5)
+                                                .SetInsertUpdateSelectDeleteRatio({0.3, 0.4, 0.2, 0.1})
+                                                .SetVarlenAllowed(true)
+                                                .Build();
+    CheckpointTests::RunTest(config, 3);
+}
+
+// This test checks that we recover correctly when no transaction writes after the checkpoint, so that the checkpoint
+// alone holds the state of the tables
+// NOLINTNEXTLINE
+TEST_F(CheckpointTests, CheckpointWithoutLogTailTest) {
+    LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                                .SetNumDatabases(1)
+                                                .SetNumTables(2)
+                                                .SetMaxColumns(5)
+                                                .SetInitialTableSize(100)
+                                                .SetTxnLength(5)
+                                                .SetInsertUpdateSelectDeleteRatio({0.0, 0.0, 1.0, 0.0})
+                                                .SetVarlenAllowed(false)
+                                                .Build();
+    CheckpointTests::RunTest(config, 1);
+}
+
+// This test restarts the system with checkpoints enabled, and checks that it recovers the tables from the checkpoint
+// and the log written after it on startup
+// NOLINTNEXTLINE
+TEST_F(CheckpointTests, StartupRecoveryTest) {
+    const auto [db_oid, table_oid] = CreateTable(db_main_.get());
+    InsertRow(db_main_.get(), db_oid, table_oid, 1);
+    checkpoint_manager_->TakeCheckpoint();
+    InsertRow(db_main_.get(), db_oid, table_oid, 2);
+
+    // Shut down the system, and boot it up again
+    checkpoint_manager_.reset();
+    db_main_.reset();
+    auto restarted_db_main = StartSystemWithCheckpoints();
+    EXPECT_EQ(ReadRows(restarted_db_main.get(), db_oid, table_oid), std::vector<int32_t>({1, 2}));
+}
+
+// This test commits after a restart, and restarts again before another checkpoint is taken. The commit is only in the
+// log tail, so it has to be ordered after the checkpoint even though the time of the restarted system started over.
+// NOLINTNEXTLINE
+TEST_F(CheckpointTests, CommitAfterRestartTest) {
+    const auto [db_oid, table_oid] = CreateTable(db_main_.get());
+    InsertRow(db_main_.get(), db_oid, table_oid, 1);
+    // Move the time well past what the restarted system reaches on its own
+    for (uint32_t i = 0; i < 1000; i++) {
+        auto *txn = txn_manager_->BeginTransaction();
+        txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    }
+    const auto checkpoint_timestamp = checkpoint_manager_->TakeCheckpoint();
+    checkpoint_manager_.reset();
+    db_main_.reset();
+
+    auto restarted_db_main = StartSystemWithCheckpoints();
+    EXPECT_TRUE(restarted_db_main->GetTransactionLayer()->GetTransactionManager()->GetCurrentTimestamp()
+                > checkpoint_timestamp);
+    InsertRow(restarted_db_main.get(), db_oid, table_oid, 2);
+
+    // Shut down without taking another checkpoint, and recover the commit from the log tail
+    restarted_db_main.reset();
+    restarted_db_main = StartSystemWithCheckpoints();
+    EXPECT_EQ(ReadRows(restarted_db_main.get(), db_oid, table_oid), std::vector<int32_t>({1, 2}));
+}
+
+// This test fails to write checkpoints, both directly and from the checkpoint thread, and checks that the system keeps
+// running and still recovers from the previous checkpoint and all of the log written after it
+// NOLINTNEXTLINE
+TEST_F(CheckpointTests, FailedCheckpointTest) {
+    const auto [db_oid, table_oid] = CreateTable(db_main_.get());
+    InsertRow(db_main_.get(), db_oid, table_oid, 1);
+    checkpoint_manager_->TakeCheckpoint();
+    InsertRow(db_main_.get(), db_oid, table_oid, 2);
+
+    // The checkpoint file cannot be created in a directory that does not exist
+    CheckpointManager failing_checkpoint_manager("./nonexistent_directory/test_checkpoint_test.ckpt",
+                                                 catalog_,
+                                                 txn_manager_,
+                                                 db_main_->GetTransactionLayer()->GetTimestampManager(),
+                                                 log_manager_);
+    EXPECT_THROW(failing_checkpoint_manager.TakeCheckpoint(), std::runtime_error);
+    InsertRow(db_main_.get(), db_oid, table_oid, 3);
+    failing_checkpoint_manager.StartCheckpointThread(std::chrono::seconds{1});
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    failing_checkpoint_manager.StopCheckpointThread();
+    InsertRow(db_main_.get(), db_oid, table_oid, 4);
+
+    checkpoint_manager_.reset();
+    db_main_.reset();
+    auto restarted_db_main = StartSystemWithCheckpoints();
+    EXPECT_EQ(ReadRows(restarted_db_main.get(), db_oid, table_oid), std::vector<int32_t>({1, 2, 3, 4}));
+}
+
+} // namespace noisepage::storage
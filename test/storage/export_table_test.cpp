@@ -1,4 +1,7 @@
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -378,4 +381,125 @@ TEST_F(ExportTableTest, ExportVarlenTableTest) {
     gc.PerformGarbageCollection(); // Second call to deallocate.
 }
 
+// Stream a table with a frozen and a hot block. The buffers of the frozen block are handed over in place, while the
+// tuples of the hot block are materialized.
+// NOLINTNEXTLINE
+TEST_F(ExportTableTest, ExportStreamTest) {
+    // Keeps every message of the stream
+    struct RecordingWriter : public storage::ArrowStreamWriter {
+        void Write(const std::vector<iovec> &buffers) override {
+            messages_.push_back(buffers);
+            std::vector<byte> &message = bytes_.emplace_back();
+            for (const iovec &buffer : buffers) {
+                const auto *start = reinterpret_cast<const byte *>(buffer.iov_base);
+                message.insert(message.end(), start, start + buffer.iov_len);
+            }
+        }
+
+        std::vector<std::vector<iovec>> messages_;
+        std::vector<std::vector<byte>>  bytes_;
+    };
+
+    storage::BlockLayout                 layout({8, 8, storage::VARLEN_COLUMN});
+    storage::TupleAccessStrategy         accessor(layout);
+    storage::DataTable                   table(common::ManagedPointer<storage::BlockStore>(&block_store_),
+                             layout,
+                             storage::layout_version_t(0));
+    const std::vector<storage::col_id_t> col_ids = StorageTestUtil::ProjectionListAllColumns(layout);
+    const storage::col_id_t              int_col(1), varlen_col(2);
+    const uint32_t                       num_slots = layout.NumSlots();
+
+    transaction::TimestampManager      timestamp_manager;
+    transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+    transaction::TransactionManager    txn_manager{common::ManagedPointer(&timestamp_manager),
+                                                common::ManagedPointer(&deferred_action_manager),
+                                                common::ManagedPointer(&buffer_pool_),
+                                                true,
+                                                false,
+                                                DISABLED};
+    storage::GarbageCollector          gc{common::ManagedPointer(&timestamp_manager),
+                                 common::ManagedPointer(&deferred_action_manager),
+                                 common::ManagedPointer(&txn_manager),
+                                 DISABLED};
+
+    // Fill up one block and start another one
+    auto                            initializer = storage::ProjectedRowInitializer::Create(layout, col_ids);
+    byte                           *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    auto                           *txn = txn_manager.BeginTransaction();
+    std::vector<storage::RawBlock *> blocks;
+    for (uint32_t i = 0; i < num_slots + 10; i++) {
+        auto             *row = initializer.InitializeRow(buffer);
+        const int64_t     value = i;
+        const std::string str = "v" + std::to_string(i % 100);
+        std::memcpy(row->AccessForceNotNull(0), &value, sizeof(value));
+        if (i % 7 == 0) {
+            row->SetNull(1);
+        } else {
+            *reinterpret_cast<storage::VarlenEntry *>(row->AccessForceNotNull(1))
+                = storage::VarlenEntry::CreateInline(reinterpret_cast<const byte *>(str.data()), str.size());
+        }
+        const storage::TupleSlot slot = table.Insert(common::ManagedPointer(txn), *row);
+        if (blocks.empty() || blocks.back() != slot.GetBlock()) {
+            blocks.push_back(slot.GetBlock());
+        }
+    }
+    txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    delete[] buffer;
+    ASSERT_EQ(2U, blocks.size());
+
+    accessor.GetArrowBlockMetadata(blocks[0]).GetColumnInfo(layout, int_col).Type()
+        = storage::ArrowColumnType::FIXED_LENGTH;
+    accessor.GetArrowBlockMetadata(blocks[0]).GetColumnInfo(layout, varlen_col).Type()
+        = storage::ArrowColumnType::GATHERED_VARLEN;
+    storage::BlockCompactor compactor;
+    compactor.PutInQueue(blocks[0]);
+    compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager); // compaction pass
+    gc.PerformGarbageCollection();
+    compactor.PutInQueue(blocks[0]);
+    compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager); // gathering pass
+    ASSERT_EQ(storage::BlockState::FROZEN, blocks[0]->controller_.GetBlockState()->load());
+
+    RecordingWriter          writer;
+    storage::ArrowSerializer serializer(table);
+    txn = txn_manager.BeginTransaction();
+    EXPECT_EQ(num_slots + 10,
+              serializer.ExportStream(common::ManagedPointer(txn),
+                                      col_ids,
+                                      {execution::sql::SqlTypeId::BigInt, execution::sql::SqlTypeId::Varchar},
+                                      {"value", "str"},
+                                      &writer));
+    txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // Schema, one batch per block and the end-of-stream marker
+    ASSERT_EQ(4U, writer.bytes_.size());
+    for (uint32_t b = 0; b < blocks.size(); b++) {
+        const std::vector<byte> &message = writer.bytes_[b + 1];
+        const auto *metadata = flatbuf::GetMessage(message.data() + 2 * sizeof(int32_t));
+        ASSERT_NE(nullptr, metadata->header_as_RecordBatch());
+        EXPECT_EQ(static_cast<int64_t>(b == 0 ? num_slots : 10), metadata->header_as_RecordBatch()->length());
+        int32_t metadata_size;
+        std::memcpy(&metadata_size, message.data() + sizeof(int32_t), sizeof(metadata_size));
+        const int64_t body_start = static_cast<int64_t>(2 * sizeof(int32_t)) + metadata_size;
+        EXPECT_EQ(static_cast<int64_t>(message.size()), body_start + metadata->bodyLength());
+    }
+    const int32_t end_of_stream[2] = {-1, 0};
+    ASSERT_EQ(sizeof(end_of_stream), writer.bytes_[3].size());
+    EXPECT_EQ(0, std::memcmp(end_of_stream, writer.bytes_[3].data(), sizeof(end_of_stream)));
+
+    // Only the frozen block's buffers are sent from where they are
+    auto points_to = [&](const std::vector<iovec> &buffers, const void *location) {
+        return std::any_of(buffers.begin(), buffers.end(), [&](const iovec &buffer) {
+            return buffer.iov_base == location;
+        });
+    };
+    const auto &varlens = accessor.GetArrowBlockMetadata(blocks[0]).GetColumnInfo(layout, varlen_col).VarlenColumn();
+    EXPECT_TRUE(points_to(writer.messages_[1], accessor.ColumnStart(blocks[0], int_col)));
+    EXPECT_TRUE(points_to(writer.messages_[1], varlens.Values()));
+    EXPECT_TRUE(points_to(writer.messages_[1], varlens.Offsets()));
+    EXPECT_FALSE(points_to(writer.messages_[2], accessor.ColumnStart(blocks[1], int_col)));
+
+    gc.PerformGarbageCollection();
+    gc.PerformGarbageCollection();
+}
+
 } // namespace noisepage
@@ -67,6 +67,11 @@ public:
         return version;
     }
 
+    storage::UndoRecord *VersionPtr(const storage::TupleSlot slot) const {
+        return *reinterpret_cast<storage::UndoRecord *const *>(
+            accessor_.AccessWithoutNullCheck(slot, storage::VERSION_POINTER_COLUMN_ID));
+    }
+
     storage::ProjectedRow *SelectIntoBuffer(transaction::TransactionContext *const txn, const storage::TupleSlot slot) {
         // generate a redo ProjectedRow for Select
         storage::ProjectedRow *select_row = initializer_.InitializeRow(select_buffer_);
@@ -74,8 +79,9 @@ public:
         return select_row;
     }
 
-    storage::BlockLayout layout_;
-    storage::DataTable   table_;
+    storage::BlockLayout         layout_;
+    storage::DataTable           table_;
+    storage::TupleAccessStrategy accessor_{layout_};
     // We want null_bias_ to be zero when testing CC. We already evaluate null correctness in other directed tests, and
     // we don't want the logically deleted field to end up set NULL.
     const double                     null_bias_ = 0;
@@ -92,6 +98,14 @@ struct GarbageCollectorTests : public ::noisepage::TerrierTest {
     std::default_random_engine       generator_;
     const uint32_t                   num_iterations_ = 100;
     const uint16_t                   max_columns_ = 100;
+
+    static uint64_t NumVersionsWalked(const transaction::TransactionContext *txn) {
+        return txn->num_versions_walked_.load();
+    }
+
+    static uint64_t NumChainsPruned(const transaction::TransactionContext *txn) {
+        return txn->num_chains_pruned_.load();
+    }
 };
 
 // Run a single txn that performs an Insert. Confirm that it takes 2 GC cycles to process this tuple.
@@ -714,4 +728,150 @@ TEST_F(GarbageCollectorTests, InsertUpdate1) {
         EXPECT_EQ(std::make_pair(2U, 0U), gc->PerformGarbageCollection());
     }
 }
+
+// Update tuples spread over several blocks with the GC split over workers, which unlink the records of the same
+// transactions concurrently. Every transaction should still be unlinked and deallocated exactly once, and the latest
+// versions should stay visible.
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, ParallelCommitUpdate) {
+    const uint32_t num_tuples = 10000;
+    const uint32_t num_txns = 100;
+    const uint32_t txn_length = 100;
+    for (uint32_t iteration = 0; iteration < 10; ++iteration) {
+        auto db_main = DBMain::Builder().SetUseGC(true).SetGCNumWorkers(4).Build();
+        auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+        auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+        GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(),
+                                                   max_columns_,
+                                                   &generator_);
+
+        std::vector<storage::TupleSlot>     slots;
+        std::vector<storage::ProjectedRow *> versions;
+        auto                                *txn = txn_manager->BeginTransaction();
+        for (uint32_t i = 0; i < num_tuples; i++) {
+            auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+            slots.push_back(tested.table_.Insert(common::ManagedPointer(txn), *insert_tuple));
+            versions.push_back(insert_tuple);
+        }
+        txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+        // Unlink and reclaim the Inserts
+        EXPECT_EQ(std::make_pair(0U, 1U), gc->PerformGarbageCollection());
+        EXPECT_EQ(std::make_pair(1U, 0U), gc->PerformGarbageCollection());
+
+        std::uniform_int_distribution<uint32_t> tuple_dist(0, num_tuples - 1);
+        for (uint32_t i = 0; i < num_txns; i++) {
+            txn = txn_manager->BeginTransaction();
+            for (uint32_t j = 0; j < txn_length; j++) {
+                const uint32_t         tuple = tuple_dist(generator_);
+                storage::ProjectedRow *update = tested.GenerateRandomUpdate(&generator_);
+                EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn), slots[tuple], *update));
+                versions[tuple] = tested.GenerateVersionFromUpdate(*update, *versions[tuple]);
+            }
+            txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+        }
+
+        // Unlink and reclaim the updates
+        EXPECT_EQ(std::make_pair(0U, num_txns), gc->PerformGarbageCollection());
+        EXPECT_EQ(std::make_pair(num_txns, 0U), gc->PerformGarbageCollection());
+
+        txn = txn_manager->BeginTransaction();
+        for (uint32_t i = 0; i < num_tuples; i++) {
+            storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(txn, slots[i]);
+            EXPECT_TRUE(tested.select_result_);
+            EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, versions[i]));
+        }
+        txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+        // Unlink the read-only transaction
+        EXPECT_EQ(std::make_pair(0U, 1U), gc->PerformGarbageCollection());
+        EXPECT_EQ(std::make_pair(0U, 0U), gc->PerformGarbageCollection());
+    }
+}
+
+// A long-running reader keeps the versions that it needs alive while transactions that start after it prune the
+// versions that no one needs anymore, first by writing over them and then by reading past them. Pruning should not
+// change what anyone reads, nor how the GC unlinks and deallocates the transactions that wrote the pruned versions.
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, PruneVersionChain) {
+    for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+        auto db_main = DBMain::Builder().SetUseGC(true).Build();
+        auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+        auto timestamp_manager = db_main->GetTransactionLayer()->GetTimestampManager();
+        auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+        GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(),
+                                                   max_columns_,
+                                                   &generator_);
+
+        auto              *insert_tuple = tested.GenerateRandomTuple(&generator_);
+        auto              *txn = txn_manager->BeginTransaction();
+        storage::TupleSlot slot = tested.table_.Insert(common::ManagedPointer(txn), *insert_tuple);
+        txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+        EXPECT_EQ(std::make_pair(0U, 1U), gc->PerformGarbageCollection());
+        EXPECT_EQ(std::make_pair(1U, 0U), gc->PerformGarbageCollection());
+
+        auto *long_reader = txn_manager->BeginTransaction();
+
+        // Build up a version chain that the long-running reader has to walk
+        storage::ProjectedRow *version = insert_tuple;
+        for (uint32_t i = 0; i < 5; i++) {
+            storage::ProjectedRow *update = tested.GenerateRandomUpdate(&generator_);
+            txn = txn_manager->BeginTransaction();
+            EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn), slot, *update));
+            txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+            version = tested.GenerateVersionFromUpdate(*update, *version);
+        }
+
+        // Transactions that start now have the long-running reader as their prune horizon, so they leave its versions
+        timestamp_manager->OldestTransactionStartTime();
+        txn = txn_manager->BeginTransaction();
+        storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(txn, slot);
+        EXPECT_TRUE(tested.select_result_);
+        EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, version));
+        EXPECT_EQ(0, NumVersionsWalked(txn));
+        EXPECT_EQ(0, NumChainsPruned(txn));
+        txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+        select_tuple = tested.SelectIntoBuffer(long_reader, slot);
+        EXPECT_TRUE(tested.select_result_);
+        EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, insert_tuple));
+        EXPECT_EQ(5, NumVersionsWalked(long_reader));
+        EXPECT_EQ(0, NumChainsPruned(long_reader));
+        txn_manager->Commit(long_reader, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+        // Once the long-running reader is gone, a writer leaves the whole version chain out of its own
+        timestamp_manager->OldestTransactionStartTime();
+        storage::ProjectedRow *update = tested.GenerateRandomUpdate(&generator_);
+        txn = txn_manager->BeginTransaction();
+        EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn), slot, *update));
+        txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+        version = tested.GenerateVersionFromUpdate(*update, *version);
+        ASSERT_NE(nullptr, tested.VersionPtr(slot));
+        EXPECT_EQ(nullptr, tested.VersionPtr(slot)->Next().load());
+
+        // And a reader cuts off the head
+        timestamp_manager->OldestTransactionStartTime();
+        txn = txn_manager->BeginTransaction();
+        select_tuple = tested.SelectIntoBuffer(txn, slot);
+        EXPECT_TRUE(tested.select_result_);
+        EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, version));
+        EXPECT_EQ(0, NumVersionsWalked(txn));
+        EXPECT_EQ(1, NumChainsPruned(txn));
+        EXPECT_EQ(nullptr, tested.VersionPtr(slot));
+        txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+        // Unlink the 6 updating and 3 read-only txns, then deallocate the updating txns
+        EXPECT_EQ(std::make_pair(0U, 9U), gc->PerformGarbageCollection());
+        EXPECT_EQ(std::make_pair(6U, 0U), gc->PerformGarbageCollection());
+
+        txn = txn_manager->BeginTransaction();
+        select_tuple = tested.SelectIntoBuffer(txn, slot);
+        EXPECT_TRUE(tested.select_result_);
+        EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, version));
+        txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+        EXPECT_EQ(std::make_pair(0U, 1U), gc->PerformGarbageCollection());
+    }
+}
 } // namespace noisepage
@@ -9,11 +9,12 @@
 namespace noisepage {
 class LargeGCTests : public TerrierTest {
 public:
-    void RunTest(const LargeDataTableTestConfiguration &config) {
+    void RunTest(const LargeDataTableTestConfiguration &config, const uint32_t gc_num_workers = 1) {
         for (uint32_t iteration = 0; iteration < config.NumIterations(); iteration++) {
             std::default_random_engine generator;
 
-            auto        db_main = DBMain::Builder().SetUseGC(true).SetUseGCThread(true).Build();
+            auto db_main
+                = DBMain::Builder().SetUseGC(true).SetGCNumWorkers(gc_num_workers).SetUseGCThread(true).Build();
             auto *const tested
                 = new LargeDataTableTestObject(config,
                                                db_main->GetStorageLayer()->GetBlockStore().Get(),
@@ -177,4 +178,22 @@ TEST_F(LargeGCTests, TPCCishHighThreadWithGC) {
                       .Build();
     RunTest(config);
 }
+
+// This test duplicates the previous one with the work of the GC spread over several workers, which unlink and
+// deallocate concurrently with each other as well as with the running transactions
+// NOLINTNEXTLINE
+TEST_F(LargeGCTests, TPCCishHighThreadWithParallelGC) {
+    auto config = LargeDataTableTestConfiguration::Builder()
+                      .SetNumIterations(10)
+                      .SetNumTxns(1000)
+                      .SetBatchSize(100)
+                      .SetNumConcurrentTxns(2 * MultiThreadTestUtil::HardwareConcurrency())
+                      .SetUpdateSelectRatio({0.4, 0.6})
+                      .SetTxnLength(5)
+                      .SetInitialTableSize(1000)
+                      .SetMaxColumns(20)
+                      .SetVarlenAllowed(true)
+                      .Build();
+    RunTest(config, 4);
+}
 } // namespace noisepage
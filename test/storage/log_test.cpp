@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
 #include <future> // NOLINT
 #include <memory>
 #include <string>
@@ -10,6 +13,9 @@
 #include "storage/projected_row.h"
 #include "storage/sql_table.h"
 #include "storage/storage_defs.h"
+#include "storage/write_ahead_log/group_commit_controller.h"
+#include "storage/write_ahead_log/log_compression.h"
+#include "storage/write_ahead_log/log_frame.h"
 #include "storage/write_ahead_log/log_manager.h"
 #include "test_util/catalog_test_util.h"
 #include "test_util/data_table_test_util.h"
@@ -20,6 +26,7 @@
 #include "gtest/gtest.h"
 
 #define LOG_TEST_LOG_FILE_NAME "./test_log_test.log"
+#define LOG_TEST_FRAMED_FILE_NAME "./test_log_test_framed.log"
 
 namespace noisepage::storage {
 class WriteAheadLoggingTests : public TerrierTest {
@@ -483,4 +490,199 @@ TEST_F(WriteAheadLoggingTests, ReadOnlyCallbackTest) {
         delete sql_table;
     });
 }
+
+// Verify that the group commit controller persists single commits right away at low load, and sizes batches from the
+// arrival rate and persist latency at high load while keeping the oldest commit within the wait budget.
+// NOLINTNEXTLINE
+TEST_F(WriteAheadLoggingTests, GroupCommitControllerTest) {
+    using std::chrono::microseconds;
+    GroupCommitController controller(microseconds(1000));
+    auto                  now = GroupCommitController::Clock::now();
+
+    // Nothing pending, nothing to persist
+    EXPECT_FALSE(controller.ShouldPersist(now));
+    EXPECT_EQ(microseconds::max(), controller.TimeUntilPersist(now));
+
+    // Without any observations, a single commit is persisted right away
+    controller.OnCommitsArrived(1, now);
+    EXPECT_TRUE(controller.ShouldPersist(now));
+    EXPECT_EQ(microseconds(0), controller.TimeUntilPersist(now));
+    controller.OnBatchClosed(now);
+    controller.RecordPersistLatency(microseconds(200));
+    EXPECT_EQ(microseconds(800), controller.WaitBudget());
+    EXPECT_FALSE(controller.HasPendingCommits());
+
+    // At a low rate (one commit every 10ms), fewer than one commit arrives during a persist
+    for (int i = 0; i < 20; i++) {
+        now += microseconds(10000);
+        controller.OnCommitsArrived(1, now);
+        EXPECT_TRUE(controller.ShouldPersist(now));
+        controller.OnBatchClosed(now);
+        controller.RecordPersistLatency(microseconds(200));
+    }
+    EXPECT_EQ(1, controller.TargetBatchSize());
+
+    // At a high rate (100 commits every 1ms), batches grow to the commits that arrive during a persist
+    for (int i = 0; i < 50; i++) {
+        now += microseconds(1000);
+        controller.OnCommitsArrived(100, now);
+        controller.OnBatchClosed(now);
+        controller.RecordPersistLatency(microseconds(200));
+    }
+    EXPECT_GT(controller.ArrivalRate(), 90000.0);
+    EXPECT_GE(controller.TargetBatchSize(), 18);
+    EXPECT_LE(controller.TargetBatchSize(), 20);
+
+    // A batch below the target is held back until the wait budget of its oldest commit runs out
+    controller.OnCommitsArrived(1, now);
+    EXPECT_FALSE(controller.ShouldPersist(now));
+    EXPECT_EQ(microseconds(800), controller.TimeUntilPersist(now));
+    EXPECT_FALSE(controller.ShouldPersist(now + microseconds(400)));
+    EXPECT_TRUE(controller.ShouldPersist(now + microseconds(800)));
+    // ... or until it reaches the target size
+    controller.OnCommitsArrived(controller.TargetBatchSize(), now + microseconds(100));
+    EXPECT_TRUE(controller.ShouldPersist(now + microseconds(100)));
+
+    // Slow persists eat into the wait budget, which never goes below zero
+    for (uint32_t i = 0; i < GroupCommitController::NUM_LATENCY_SAMPLES; i++) {
+        controller.RecordPersistLatency(microseconds(5000));
+    }
+    EXPECT_EQ(microseconds(5000), controller.PersistLatencyP99());
+    EXPECT_EQ(microseconds(0), controller.WaitBudget());
+    log_manager_->PersistAndStop();
+}
+
+// Verify that compressed and stored log frames are decoded, that padding between frames is skipped, and that the log is
+// read without frames again once it continues without them
+// NOLINTNEXTLINE
+TEST_F(WriteAheadLoggingTests, LogCompressionTest) {
+    // Repetitive contents compress, random ones are stored as they are
+    std::vector<char> compressible(common::Constants::LOG_BUFFER_SIZE);
+    for (uint32_t i = 0; i < compressible.size(); i++) {
+        compressible[i] = static_cast<char>(i % 24 < 8 ? i % 24 : 0);
+    }
+    std::vector<char>                       incompressible(100);
+    std::uniform_int_distribution<uint32_t> byte(0, UINT8_MAX);
+    for (auto &c : incompressible) {
+        c = static_cast<char>(byte(generator_));
+    }
+
+    std::vector<char> frame(sizeof(LogFrameHeader) + common::Constants::LOG_BUFFER_SIZE);
+    const auto        write_frame = [&](std::ofstream *out, const std::vector<char> &contents, bool compresses) {
+        const uint32_t frame_size = LogCompression::EncodeFrame(contents.data(), contents.size(), true, frame.data());
+        EXPECT_EQ(compresses, frame_size < sizeof(LogFrameHeader) + contents.size());
+        out->write(frame.data(), frame_size);
+    };
+    const uint32_t first = 7, last = 9;
+    {
+        std::ofstream out(LOG_TEST_FRAMED_FILE_NAME, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(&first), sizeof(first));
+        write_frame(&out, compressible, true);
+        // Padding up to the next block, as an AsyncLogWriter writes it
+        const auto padding = common::Constants::LOG_BLOCK_SIZE - static_cast<uint32_t>(out.tellp());
+        out.write(std::vector<char>(padding, 0).data(), padding);
+        write_frame(&out, incompressible, false);
+        out.write(reinterpret_cast<const char *>(&last), sizeof(last));
+    }
+
+    BufferedLogReader reader(LOG_TEST_FRAMED_FILE_NAME);
+    EXPECT_EQ(first, reader.ReadValue<uint32_t>());
+    EXPECT_EQ(LogFrameHeader::MARKER, reader.ReadValue<uint32_t>());
+    reader.BeginFrame();
+    std::vector<char> contents(compressible.size());
+    EXPECT_TRUE(reader.Read(contents.data(), contents.size()));
+    EXPECT_EQ(compressible, contents);
+    // Reads continue from the next frame, and then from the log after the frames
+    contents.resize(incompressible.size() + sizeof(last));
+    EXPECT_TRUE(reader.Read(contents.data(), contents.size()));
+    EXPECT_TRUE(std::equal(incompressible.begin(), incompressible.end(), contents.begin()));
+    EXPECT_EQ(0, std::memcmp(&last, contents.data() + incompressible.size(), sizeof(last)));
+    EXPECT_FALSE(reader.HasMore());
+    unlink(LOG_TEST_FRAMED_FILE_NAME);
+    log_manager_->PersistAndStop();
+}
+
+// Verify that commits are persisted and their callbacks invoked with the group commit controller deciding when to
+// persist
+// NOLINTNEXTLINE
+TEST_F(WriteAheadLoggingTests, GroupCommitTest) {
+    db_main_.reset();
+    unlink(LOG_TEST_LOG_FILE_NAME);
+    db_main_ = noisepage::DBMain::Builder()
+                   .SetWalFilePath(LOG_TEST_LOG_FILE_NAME)
+                   .SetUseLogging(true)
+                   .SetWalGroupCommitTargetLatency(2000)
+                   .SetUseGC(true)
+                   .SetUseGCThread(true)
+                   .SetUseCatalog(true)
+                   .Build();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+    log_manager_ = db_main_->GetLogManager();
+    store_ = db_main_->GetStorageLayer()->GetBlockStore();
+
+    auto col = catalog::Schema::Column("attribute",
+                                       execution::sql::SqlTypeId::Integer,
+                                       false,
+                                       parser::ConstantValueExpression(execution::sql::SqlTypeId::Integer));
+    StorageTestUtil::ForceOid(&(col), catalog::col_oid_t(0));
+    auto        table_schema = catalog::Schema(std::vector<catalog::Schema::Column>({col}));
+    auto *const sql_table = new storage::SqlTable(store_, table_schema);
+    const auto  tuple_initializer = sql_table->InitializerForProjectedRow({catalog::col_oid_t(0)});
+
+    // Every commit is persisted without forcing a flush
+    for (uint32_t i = 0; i < 10; i++) {
+        auto *const txn = txn_manager_->BeginTransaction();
+        auto *const redo_record
+            = txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_initializer);
+        *reinterpret_cast<int32_t *>(redo_record->Delta()->AccessForceNotNull(0)) = static_cast<int32_t>(i);
+        sql_table->Insert(common::ManagedPointer(txn), redo_record);
+
+        std::promise<bool> promise;
+        auto               future = promise.get_future();
+        txn_manager_->Commit(txn, TestCommitCallback, &promise);
+        EXPECT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(10)));
+    }
+    log_manager_->PersistAndStop();
+
+    // the table can't be freed until after all GC on it is guaranteed to be done. The easy way to do that is to use a
+    // DeferredAction
+    db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() {
+        delete sql_table;
+    });
+}
+
+// Verify that a value split between two log frames, as an AsyncLogWriter writes them with padding up to the next block
+// in between, is read back whole, and that the log is read without frames again once it continues without them
+// NOLINTNEXTLINE
+TEST_F(WriteAheadLoggingTests, LogFrameTest) {
+    const uint64_t spanning = 0x0123456789abcdefULL;
+    const uint32_t first = 7, last = 9;
+    const auto     write_frame = [](std::ofstream *out, const char *contents, uint32_t size) {
+        LogFrameHeader header;
+        header.raw_size_ = size;
+        header.stored_size_ = size;
+        out->write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out->write(contents, size);
+    };
+    {
+        std::ofstream out(LOG_TEST_FRAMED_FILE_NAME, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(&first), sizeof(first));
+        const auto *bytes = reinterpret_cast<const char *>(&spanning);
+        write_frame(&out, bytes, 3);
+        const auto padding = common::Constants::LOG_BLOCK_SIZE - static_cast<uint32_t>(out.tellp());
+        out.write(std::vector<char>(padding, 0).data(), padding);
+        write_frame(&out, bytes + 3, sizeof(spanning) - 3);
+        out.write(reinterpret_cast<const char *>(&last), sizeof(last));
+    }
+
+    BufferedLogReader reader(LOG_TEST_FRAMED_FILE_NAME);
+    EXPECT_EQ(first, reader.ReadValue<uint32_t>());
+    EXPECT_EQ(LogFrameHeader::MARKER, reader.ReadValue<uint32_t>());
+    reader.BeginFrame();
+    EXPECT_EQ(spanning, reader.ReadValue<uint64_t>());
+    EXPECT_EQ(last, reader.ReadValue<uint32_t>());
+    EXPECT_FALSE(reader.HasMore());
+    unlink(LOG_TEST_FRAMED_FILE_NAME);
+    log_manager_->PersistAndStop();
+}
 } // namespace noisepage::storage
@@ -1,5 +1,9 @@
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
 #include <memory>
 #include <string>
+#include <thread> // NOLINT
 #include <unordered_map>
 #include <vector>
 
@@ -76,8 +80,10 @@ protected:
     }
 
     void TearDown() override {
-        // Delete log file
-        unlink(RECOVERY_TEST_LOG_FILE_NAME);
+        // Delete log files of all streams
+        for (const auto &stream_file_path : LogManager::ListLogStreams(RECOVERY_TEST_LOG_FILE_NAME)) {
+            unlink(stream_file_path.c_str());
+        }
     }
 
     catalog::IndexSchema DummyIndexSchema() {
@@ -200,7 +206,7 @@ protected:
         recovery_manager.WaitForRecoveryToFinish();
     }
 
-    void RunTest(const LargeSqlTableTestConfiguration &config) {
+    void RunTest(const LargeSqlTableTestConfiguration &config, const uint32_t num_replay_threads = 1) {
         // Run workload
         auto *tested
             = new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
@@ -208,15 +214,17 @@ protected:
 
         ShutdownAndRestartSystem();
 
-        // Instantiate recovery manager, and recover the tables.
-        DiskLogProvider log_provider{RECOVERY_TEST_LOG_FILE_NAME};
+        // Instantiate recovery manager, and recover the tables from all streams of the log.
+        DiskLogProvider log_provider{LogManager::LogStreamFilesForRecovery(RECOVERY_TEST_LOG_FILE_NAME)};
         RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
                                          recovery_catalog_,
                                          recovery_txn_manager_,
                                          recovery_deferred_action_manager_,
                                          DISABLED,
                                          recovery_thread_registry_,
-                                         recovery_block_store_};
+                                         recovery_block_store_,
+                                         nullptr,
+                                         num_replay_threads};
         recovery_manager.StartRecovery();
         recovery_manager.WaitForRecoveryToFinish();
 
@@ -273,6 +281,223 @@ TEST_F(RecoveryTests, SingleTableTest) {
     RecoveryTests::RunTest(config);
 }
 
+// This test inserts, updates, and deletes tuples in multiple tables across multiple databases. It then recovers these
+// tables with multiple replay threads, and verifies that the recovered tables are equal to the test tables.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, ParallelReplayTest) {
+    LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                                .SetNumDatabases(2)
+                                                .SetNumTables(4)
+                                                .SetMaxColumns(5)
+                                                .SetInitialTableSize(1000)
+                                                .SetTxnLength(5)
+                                                .SetInsertUpdateSelectDeleteRatio({0.3, 0.4, 0.1, 0.2})
+                                                .SetVarlenAllowed(true)
+                                                .Build();
+    RecoveryTests::RunTest(config, 4);
+}
+
+// This test splits the log into several streams, each written by its own threads. It then recovers the tables from the
+// merged streams, and verifies that the recovered tables are equal to the test tables.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, MultiStreamTest) {
+    db_main_.reset();
+    unlink(RECOVERY_TEST_LOG_FILE_NAME);
+    db_main_ = noisepage::DBMain::Builder()
+                   .SetWalFilePath(RECOVERY_TEST_LOG_FILE_NAME)
+                   .SetWalNumStreams(4)
+                   .SetUseLogging(true)
+                   .SetUseGC(true)
+                   .SetUseGCThread(true)
+                   .SetUseCatalog(true)
+                   .Build();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+    log_manager_ = db_main_->GetLogManager();
+    block_store_ = db_main_->GetStorageLayer()->GetBlockStore();
+    catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+    EXPECT_EQ(4, log_manager_->GetNumStreams());
+
+    LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                                .SetNumDatabases(2)
+                                                .SetNumTables(2)
+                                                .SetMaxColumns(5)
+                                                .SetInitialTableSize(1000)
+                                                .SetTxnLength(5)
+                                                .SetInsertUpdateSelectDeleteRatio({0.3, 0.4, 0.1, 0.2})
+                                                .SetVarlenAllowed(true)
+                                                .Build();
+    RecoveryTests::RunTest(config);
+    EXPECT_EQ(4, LogManager::ListLogStreams(RECOVERY_TEST_LOG_FILE_NAME).size());
+}
+
+// Tests that recovery from a log split into streams does not replay a commit that depends on a commit lost by another
+// stream. One transaction commits in one stream, and a transaction in the other stream reads its row and commits after
+// it. The first stream then loses its commit in a crash, so neither transaction may be recovered.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, MultiStreamCrashTest) {
+    db_main_.reset();
+    unlink(RECOVERY_TEST_LOG_FILE_NAME);
+    db_main_ = noisepage::DBMain::Builder()
+                   .SetWalFilePath(RECOVERY_TEST_LOG_FILE_NAME)
+                   .SetWalNumStreams(2)
+                   .SetUseLogging(true)
+                   .SetUseGC(true)
+                   .SetUseGCThread(true)
+                   .SetUseCatalog(true)
+                   .Build();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+    log_manager_ = db_main_->GetLogManager();
+    block_store_ = db_main_->GetStorageLayer()->GetBlockStore();
+    catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+
+    std::string database_name = "testdb";
+    auto        namespace_oid = catalog::postgres::PgNamespace::NAMESPACE_DEFAULT_NAMESPACE_OID;
+    std::string table_name = "testtable";
+
+    auto *txn = txn_manager_->BeginTransaction();
+    auto  db_oid = CreateDatabase(txn, catalog_, database_name);
+    auto  db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+    auto  table_oid = CreateTable(txn, db_catalog, namespace_oid, table_name);
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    txn = txn_manager_->BeginTransaction();
+    db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+    const auto table = db_catalog->GetTable(common::ManagedPointer(txn), table_oid);
+    const auto col_oid = db_catalog->GetSchema(common::ManagedPointer(txn), table_oid).GetColumns()[0].Oid();
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    const auto initializer = table->InitializerForProjectedRow({col_oid});
+
+    // Everything up to here is acknowledged, so both streams have logged up to it
+    log_manager_->ForceFlush();
+    const auto lost_stream_path = LogManager::StreamFilePath(RECOVERY_TEST_LOG_FILE_NAME, 1);
+    const auto lost_stream_size = std::filesystem::file_size(lost_stream_path);
+    EXPECT_GT(lost_stream_size, 0);
+
+    // Begins a transaction that logs to the given stream
+    const auto begin_in_stream = [&](const uint32_t stream_id) {
+        auto *stream_txn = txn_manager_->BeginTransaction();
+        while (stream_txn->StartTime().UnderlyingValue() % log_manager_->GetNumStreams() != stream_id) {
+            txn_manager_->Commit(stream_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+            stream_txn = txn_manager_->BeginTransaction();
+        }
+        return stream_txn;
+    };
+
+    // The first transaction inserts a row in stream 1
+    txn = begin_in_stream(1);
+    auto *redo = txn->StageWrite(db_oid, table_oid, initializer);
+    *reinterpret_cast<int32_t *>(redo->Delta()->AccessForceNotNull(0)) = 1;
+    const auto slot = table->Insert(common::ManagedPointer(txn), redo);
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // The second transaction reads that row and inserts another one based on it in stream 0
+    txn = begin_in_stream(0);
+    auto *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    auto *row = initializer.InitializeRow(buffer);
+    EXPECT_TRUE(table->Select(common::ManagedPointer(txn), slot, row));
+    redo = txn->StageWrite(db_oid, table_oid, initializer);
+    *reinterpret_cast<int32_t *>(redo->Delta()->AccessForceNotNull(0))
+        = *reinterpret_cast<int32_t *>(row->AccessForceNotNull(0)) + 1;
+    table->Insert(common::ManagedPointer(txn), redo);
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    delete[] buffer;
+
+    ShutdownAndRestartSystem();
+
+    // Crash stream 1 before it persisted the first transaction
+    std::filesystem::resize_file(lost_stream_path, lost_stream_size);
+
+    // Instantiate recovery manager, and recover the table from both streams
+    DiskLogProvider log_provider{LogManager::LogStreamFilesForRecovery(RECOVERY_TEST_LOG_FILE_NAME)};
+    RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
+                                     recovery_catalog_,
+                                     recovery_txn_manager_,
+                                     recovery_deferred_action_manager_,
+                                     DISABLED,
+                                     recovery_thread_registry_,
+                                     recovery_block_store_};
+    recovery_manager.StartRecovery();
+    recovery_manager.WaitForRecoveryToFinish();
+
+    // Assert that the table was recovered without any of the two rows
+    txn = recovery_txn_manager_->BeginTransaction();
+    db_catalog = recovery_catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+    EXPECT_TRUE(db_catalog);
+    const auto recovered_table = db_catalog->GetTable(common::ManagedPointer(txn), table_oid);
+    EXPECT_TRUE(recovered_table != nullptr);
+    buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    row = initializer.InitializeRow(buffer);
+    for (auto it = recovered_table->begin(); it != recovered_table->end(); it++) {
+        EXPECT_FALSE(recovered_table->Select(common::ManagedPointer(txn), *it, row));
+    }
+    delete[] buffer;
+    recovery_txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+// This test writes the log through AsyncLogWriters, whose log files are preallocated and padded to whole blocks at
+// every flush, and verifies that recovery reads past the padding and that the recovered tables are equal to the test
+// tables.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, AsyncWriterTest) {
+    db_main_.reset();
+    unlink(RECOVERY_TEST_LOG_FILE_NAME);
+    db_main_ = noisepage::DBMain::Builder()
+                   .SetWalFilePath(RECOVERY_TEST_LOG_FILE_NAME)
+                   .SetWalNumStreams(2)
+                   .SetWalAsyncIoDepth(4)
+                   .SetUseLogging(true)
+                   .SetUseGC(true)
+                   .SetUseGCThread(true)
+                   .SetUseCatalog(true)
+                   .Build();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+    log_manager_ = db_main_->GetLogManager();
+    block_store_ = db_main_->GetStorageLayer()->GetBlockStore();
+    catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+
+    LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                                .SetNumDatabases(1)
+                                                .SetNumTables(2)
+                                                .SetMaxColumns(5)
+                                                .SetInitialTableSize(1000)
+                                                .SetTxnLength(5)
+                                                .SetInsertUpdateSelectDeleteRatio({0.3, 0.4, 0.1, 0.2})
+                                                .SetVarlenAllowed(true)
+                                                .Build();
+    RecoveryTests::RunTest(config);
+}
+
+// This test compresses the serialized log buffers, and verifies that recovery decodes the log frames and that the
+// recovered tables are equal to the test tables.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, CompressionTest) {
+    db_main_.reset();
+    unlink(RECOVERY_TEST_LOG_FILE_NAME);
+    db_main_ = noisepage::DBMain::Builder()
+                   .SetWalFilePath(RECOVERY_TEST_LOG_FILE_NAME)
+                   .SetWalCompression(true)
+                   .SetUseLogging(true)
+                   .SetUseGC(true)
+                   .SetUseGCThread(true)
+                   .SetUseCatalog(true)
+                   .Build();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+    log_manager_ = db_main_->GetLogManager();
+    block_store_ = db_main_->GetStorageLayer()->GetBlockStore();
+    catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+
+    LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                                .SetNumDatabases(1)
+                                                .SetNumTables(2)
+                                                .SetMaxColumns(5)
+                                                .SetInitialTableSize(1000)
+                                                .SetTxnLength(5)
+                                                .SetInsertUpdateSelectDeleteRatio({0.3, 0.4, 0.1, 0.2})
+                                                .SetVarlenAllowed(true)
+                                                .Build();
+    RecoveryTests::RunTest(config);
+}
+
 // This test checks that we recover correctly in a high abort rate workload. We achieve the high abort rate by having
 // large transaction lengths (number of updates). Further, to ensure that more aborted transactions flush logs before
 // aborting, we have transactions make large updates (by having high number columns). This will cause RedoBuffers to
@@ -805,4 +1030,92 @@ TEST_F(RecoveryTests, DoubleRecoveryTest) {
     });
 }
 
+// Tests that a bulk loaded block logs only the tuples that were loaded into it. Once the block is inserted into the
+// table, concurrent inserts can allocate its remaining slots. Those transactions abort here, so none of their tuples
+// may come back as part of the load after recovery.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, BulkLoadConcurrentInsertTest) {
+    std::string    database_name = "testdb";
+    auto           namespace_oid = catalog::postgres::PgNamespace::NAMESPACE_DEFAULT_NAMESPACE_OID;
+    std::string    table_name = "testtable";
+    const uint32_t num_blocks = 200;
+    const uint32_t tuples_per_block = 10;
+    const uint32_t num_inserters = 4;
+    const int32_t  aborted_value = -1;
+
+    auto *txn = txn_manager_->BeginTransaction();
+    auto  db_oid = CreateDatabase(txn, catalog_, database_name);
+    auto  db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+    auto  table_oid = CreateTable(txn, db_catalog, namespace_oid, table_name);
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    txn = txn_manager_->BeginTransaction();
+    db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+    const auto table = db_catalog->GetTable(common::ManagedPointer(txn), table_oid);
+    const auto col_oid = db_catalog->GetSchema(common::ManagedPointer(txn), table_oid).GetColumns()[0].Oid();
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    const auto initializer = table->InitializerForProjectedRow({col_oid});
+
+    // Insert rows into the table, and abort, until the load is done
+    std::atomic<bool>        loading = true;
+    std::vector<std::thread> inserters;
+    for (uint32_t i = 0; i < num_inserters; i++) {
+        inserters.emplace_back([&] {
+            while (loading) {
+                auto *insert_txn = txn_manager_->BeginTransaction();
+                auto *redo = insert_txn->StageWrite(db_oid, table_oid, initializer);
+                *reinterpret_cast<int32_t *>(redo->Delta()->AccessForceNotNull(0)) = aborted_value;
+                table->Insert(common::ManagedPointer(insert_txn), redo);
+                txn_manager_->Abort(insert_txn);
+            }
+        });
+    }
+
+    // Load blocks that are mostly empty, so that the inserters can fill them as soon as they are inserted
+    auto *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    auto *row = initializer.InitializeRow(buffer);
+    auto *load_txn = txn_manager_->BeginTransaction();
+    for (uint32_t i = 0; i < num_blocks; i++) {
+        auto *block = table->NewBulkLoadBlock();
+        for (uint32_t j = 0; j < tuples_per_block; j++) {
+            *reinterpret_cast<int32_t *>(row->AccessForceNotNull(0)) = static_cast<int32_t>(i * tuples_per_block + j);
+            EXPECT_TRUE(table->BulkLoadInto(block, *row));
+        }
+        EXPECT_EQ(tuples_per_block, table->InsertBlock(common::ManagedPointer(load_txn), db_oid, table_oid, block));
+    }
+    txn_manager_->Commit(load_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    loading = false;
+    for (auto &inserter : inserters) {
+        inserter.join();
+    }
+    delete[] buffer;
+
+    ShutdownAndRestartSystem();
+
+    // Instantiate recovery manager, and recover the table
+    SingleRecovery();
+
+    // Assert that the recovered table holds exactly the loaded tuples
+    txn = recovery_txn_manager_->BeginTransaction();
+    db_catalog = recovery_catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+    EXPECT_TRUE(db_catalog);
+    const auto recovered_table = db_catalog->GetTable(common::ManagedPointer(txn), table_oid);
+    EXPECT_TRUE(recovered_table != nullptr);
+    buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    row = initializer.InitializeRow(buffer);
+    std::vector<int32_t> values;
+    for (auto it = recovered_table->begin(); it != recovered_table->end(); it++) {
+        if (recovered_table->Select(common::ManagedPointer(txn), *it, row)) {
+            values.push_back(*reinterpret_cast<int32_t *>(row->AccessForceNotNull(0)));
+        }
+    }
+    delete[] buffer;
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(num_blocks * tuples_per_block, values.size());
+    for (uint32_t i = 0; i < values.size(); i++) {
+        EXPECT_EQ(static_cast<int32_t>(i), values[i]);
+    }
+    recovery_txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
 } // namespace noisepage::storage
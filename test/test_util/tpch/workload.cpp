@@ -4,6 +4,7 @@
 #include <string>
 
 #include "common/managed_pointer.h"
+#include "common/scoped_timer.h"
 #include "execution/compiler/output_schema_util.h"
 #include "execution/exec/execution_context.h"
 #include "execution/sql/value_util.h"
@@ -153,25 +154,7 @@ void Workload::Execute(int8_t                       worker_id,
     while (metrics::MetricsUtil::Now() < end_time) {
         // Executing all the queries on by one in round robin
         auto txn = txn_manager_->BeginTransaction();
-        auto accessor
-            = catalog_->GetAccessor(common::ManagedPointer<transaction::TransactionContext>(txn), db_oid_, DISABLED);
-
-        auto output_schema = std::get<1>(query_and_plan_[index[counter]])->GetOutputSchema().Get();
-        // Uncomment this line and change output.cpp:90 to EXECUTION_LOG_INFO to print output
-        // execution::exec::OutputPrinter printer(output_schema);
-        execution::exec::NoOpResultConsumer printer;
-        auto                                exec_ctx = execution::exec::ExecutionContext(db_oid_,
-                                                          common::ManagedPointer<transaction::TransactionContext>(txn),
-                                                          printer,
-                                                          output_schema,
-                                                          common::ManagedPointer<catalog::CatalogAccessor>(accessor),
-                                                          exec_settings_,
-                                                          db_main_->GetMetricsManager(),
-                                                          DISABLED,
-                                                          DISABLED);
-
-        std::get<0>(query_and_plan_[index[counter]])
-            ->Run(common::ManagedPointer<execution::exec::ExecutionContext>(&exec_ctx), mode);
+        RunQuery(txn, index[counter], mode);
 
         // Only execute up to query_num number of queries for this thread in round-robin
         counter = counter == query_num - 1 ? 0 : counter + 1;
@@ -186,4 +169,57 @@ void Workload::Execute(int8_t                       worker_id,
     db_main_->GetMetricsManager()->UnregisterThread();
 }
 
+uint64_t Workload::ExecuteOnce(uint32_t query_idx, execution::vm::ExecutionMode mode) {
+    auto     txn = txn_manager_->BeginTransaction();
+    uint64_t elapsed_us;
+    {
+        common::ScopedTimer<std::chrono::microseconds> timer(&elapsed_us);
+        RunQuery(txn, query_idx, mode);
+    }
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    return elapsed_us;
+}
+
+void Workload::SetTierThresholds(const execution::vm::Module::TierThresholds &thresholds) {
+    for (const auto &query_and_plan : query_and_plan_) {
+        for (const auto &fragment : std::get<0>(query_and_plan)->GetFragments()) {
+            if (fragment->IsCompiled()) {
+                fragment->GetModule()->SetTierThresholds(thresholds);
+            }
+        }
+    }
+}
+
+void Workload::WaitForTierUp() {
+    for (const auto &query_and_plan : query_and_plan_) {
+        for (const auto &fragment : std::get<0>(query_and_plan)->GetFragments()) {
+            if (fragment->IsCompiled()) {
+                fragment->GetModule()->WaitForTierUp();
+            }
+        }
+    }
+}
+
+void Workload::RunQuery(transaction::TransactionContext *txn, uint32_t query_idx, execution::vm::ExecutionMode mode) {
+    auto accessor
+        = catalog_->GetAccessor(common::ManagedPointer<transaction::TransactionContext>(txn), db_oid_, DISABLED);
+
+    auto output_schema = std::get<1>(query_and_plan_[query_idx])->GetOutputSchema().Get();
+    // Uncomment this line and change output.cpp:90 to EXECUTION_LOG_INFO to print output
+    // execution::exec::OutputPrinter printer(output_schema);
+    execution::exec::NoOpResultConsumer printer;
+    auto                                exec_ctx = execution::exec::ExecutionContext(db_oid_,
+                                                      common::ManagedPointer<transaction::TransactionContext>(txn),
+                                                      printer,
+                                                      output_schema,
+                                                      common::ManagedPointer<catalog::CatalogAccessor>(accessor),
+                                                      exec_settings_,
+                                                      db_main_->GetMetricsManager(),
+                                                      DISABLED,
+                                                      DISABLED);
+
+    std::get<0>(query_and_plan_[query_idx])
+        ->Run(common::ManagedPointer<execution::exec::ExecutionContext>(&exec_ctx), mode);
+}
+
 } // namespace noisepage::tpch
@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "storage/record_buffer.h"
+#include "test_util/multithread_test_util.h"
+#include "test_util/test_harness.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/timestamp_manager.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace noisepage {
+
+class TimestampManagerTests : public TerrierTest {
+protected:
+    transaction::TimestampManager      timestamp_manager_;
+    transaction::DeferredActionManager deferred_action_manager_{common::ManagedPointer(&timestamp_manager_)};
+    storage::RecordBufferSegmentPool   buffer_pool_{10000, 10000};
+    transaction::TransactionManager    txn_manager_{common::ManagedPointer(&timestamp_manager_),
+                                                 common::ManagedPointer(&deferred_action_manager_),
+                                                 common::ManagedPointer(&buffer_pool_),
+                                                 false,
+                                                 false,
+                                                 DISABLED};
+
+    void Commit(transaction::TransactionContext *const txn) {
+        txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+        delete txn;
+    }
+};
+
+// Verify that the oldest running transaction is tracked when there are more running transactions than the table of
+// running transactions holds, and that they are removed from the overflow as well as from the table
+// NOLINTNEXTLINE
+TEST_F(TimestampManagerTests, OverflowTest) {
+    const uint32_t num_txns = transaction::TimestampManager::NUM_RUNNING_TXN_SLOTS + 1000;
+
+    std::vector<transaction::TransactionContext *> txns;
+    txns.reserve(num_txns);
+    for (uint32_t i = 0; i < num_txns; i++) {
+        txns.push_back(txn_manager_.BeginTransaction());
+    }
+    EXPECT_EQ(txns.front()->StartTime(), timestamp_manager_.OldestTransactionStartTime());
+
+    // Remove the transactions in random order, the oldest one left is always the oldest running one
+    std::default_random_engine generator;
+    std::shuffle(txns.begin(), txns.end(), generator);
+    while (!txns.empty()) {
+        const auto oldest = std::min_element(txns.cbegin(), txns.cend(), [](auto *a, auto *b) {
+            return a->StartTime() < b->StartTime();
+        });
+        EXPECT_EQ((*oldest)->StartTime(), timestamp_manager_.OldestTransactionStartTime());
+        for (uint32_t i = 0; i < 1000 && !txns.empty(); i++) {
+            Commit(txns.back());
+            txns.pop_back();
+        }
+    }
+    EXPECT_EQ(timestamp_manager_.CurrentTime(), timestamp_manager_.OldestTransactionStartTime());
+    EXPECT_EQ(timestamp_manager_.CurrentTime(), timestamp_manager_.CachedOldestTransactionStartTime());
+}
+
+// Verify that a running transaction is never newer than the oldest running transaction while other threads begin and
+// end transactions concurrently
+// NOLINTNEXTLINE
+TEST_F(TimestampManagerTests, ConcurrentBeginEndTest) {
+    const uint32_t     num_threads = MultiThreadTestUtil::HardwareConcurrency();
+    common::WorkerPool thread_pool(num_threads, {});
+
+    auto workload = [&](uint32_t) {
+        for (uint32_t i = 0; i < 10000; i++) {
+            auto *const txn = txn_manager_.BeginTransaction();
+            EXPECT_LE(timestamp_manager_.OldestTransactionStartTime(), txn->StartTime());
+            Commit(txn);
+        }
+    };
+    MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, num_threads, workload);
+    EXPECT_EQ(timestamp_manager_.CurrentTime(), timestamp_manager_.OldestTransactionStartTime());
+}
+
+} // namespace noisepage
@@ -30,6 +30,7 @@
 #include "execution/util/timer.h"
 #include "execution/vm/bytecode_generator.h"
 #include "execution/vm/bytecode_module.h"
+#include "execution/vm/bytecode_profile.h"
 #include "execution/vm/llvm_engine.h"
 #include "execution/vm/module.h"
 #include "execution/vm/module_metadata.h"
@@ -58,6 +59,8 @@ llvm::cl::opt<bool> TPCH("tpch", llvm::cl::desc("Should the TPCH database be loa
 llvm::cl::opt<std::string> DATA_DIR("data", llvm::cl::desc("Where to find data files of tables to load"), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
 llvm::cl::opt<std::string> INPUT_FILE(llvm::cl::Positional, llvm::cl::desc("<input file>"), llvm::cl::init(""), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
 llvm::cl::opt<std::string> OUTPUT_NAME("output-name", llvm::cl::desc("Print the output name"), llvm::cl::init("schema10"), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
+llvm::cl::opt<bool> NO_SUPERINSTRUCTIONS("no-superinstructions", llvm::cl::desc("Don't fuse bytecode pairs into superinstructions"), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
+llvm::cl::opt<bool> PRINT_BYTECODE_PROFILE("print-bytecode-profile", llvm::cl::desc("Print the most frequent bytecode pairs of the interpreted run. Requires NOISEPAGE_PROFILE_BYTECODES."), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
 llvm::cl::opt<std::string> HANDLERS_PATH("handlers-path", llvm::cl::desc("Path to the bytecode handlers bitcode file"), llvm::cl::init("./bytecode_handlers_ir.bc"), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
 // clang-format on
 
@@ -190,7 +193,7 @@ static void CompileAndRun(const std::string &source, const std::string &name = "
     std::unique_ptr<vm::BytecodeModule> bytecode_module;
     {
         util::ScopedTimer<std::milli> timer(&codegen_ms);
-        bytecode_module = vm::BytecodeGenerator::Compile(root, name);
+        bytecode_module = vm::BytecodeGenerator::Compile(root, name, !NO_SUPERINSTRUCTIONS);
     }
 
     // Dump Bytecode
@@ -206,6 +209,9 @@ static void CompileAndRun(const std::string &source, const std::string &name = "
     // Interpret
     //
 
+    if (PRINT_BYTECODE_PROFILE) {
+        vm::BytecodeProfile::Reset();
+    }
     {
         exec_ctx.SetExecutionMode(static_cast<uint8_t>(vm::ExecutionMode::Interpret));
         util::ScopedTimer<std::milli> timer(&interp_exec_ms);
@@ -227,6 +233,15 @@ static void CompileAndRun(const std::string &source, const std::string &name = "
         }
     }
 
+    // Dump the dispatch profile of the interpreted run
+    if (PRINT_BYTECODE_PROFILE) {
+        if (vm::BytecodeProfile::IsEnabled()) {
+            vm::BytecodeProfile::Dump(std::cout, 20); // NOLINT
+        } else {
+            EXECUTION_LOG_ERROR("Bytecode profiling requires building with NOISEPAGE_PROFILE_BYTECODES");
+        }
+    }
+
     //
     // Adaptive
     //